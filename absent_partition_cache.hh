@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <unordered_set>
+
+#include "bytes.hh"
+#include "dht/i_partitioner.hh"
+#include "utils/managed_bytes.hh"
+
+// Remembers partitions which single-partition reads found to be absent from
+// the underlying data source of a row_cache, so that repeated point reads of keys
+// which don't exist don't go to sstables.
+//
+// Caching an empty partition entry in the row_cache serves the same purpose, but an
+// entry here costs only the key and a few words, as opposed to a partition entry with
+// its version and dummy row. Entries live in the standard allocator, so they are
+// bounded by count rather than evicted by LSA; when full, an arbitrary entry is dropped.
+//
+// Entries are scoped by an epoch, which each row_cache takes from the tracker on
+// construction and whenever its absent partitions need to be forgotten at once.
+// Entries of past epochs are never found and are dropped to make room for others.
+class absent_partition_cache {
+public:
+    using epoch_type = uint64_t;
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t insertions = 0;
+        uint64_t drops = 0;
+    };
+private:
+    struct entry {
+        epoch_type epoch;
+        int64_t token;
+        bytes key;
+
+        bool operator==(const entry&) const = default;
+    };
+    struct entry_hash {
+        size_t operator()(const entry& e) const noexcept {
+            return std::hash<int64_t>()(e.token) ^ std::hash<epoch_type>()(e.epoch);
+        }
+    };
+
+    std::unordered_set<entry, entry_hash> _entries;
+    size_t _capacity = 0;
+    epoch_type _next_epoch = 0;
+    stats _stats;
+private:
+    static entry make_entry(epoch_type epoch, const dht::decorated_key& dk) {
+        return entry{epoch, dk.token().raw(), to_bytes(dk.key().representation())};
+    }
+public:
+    // Capacity 0 disables the cache.
+    void set_capacity(size_t capacity) {
+        _capacity = capacity;
+        while (_entries.size() > _capacity) {
+            _entries.erase(_entries.begin());
+            ++_stats.drops;
+        }
+    }
+
+    bool enabled() const noexcept {
+        return _capacity;
+    }
+
+    epoch_type new_epoch() noexcept {
+        return _next_epoch++;
+    }
+
+    bool contains(epoch_type epoch, const dht::decorated_key& dk) {
+        if (_entries.empty()) {
+            return false;
+        }
+        if (_entries.contains(make_entry(epoch, dk))) {
+            ++_stats.hits;
+            return true;
+        }
+        return false;
+    }
+
+    // Failure to allocate is not an error, the partition is just not remembered.
+    void insert(epoch_type epoch, const dht::decorated_key& dk) noexcept {
+        if (!_capacity) {
+            return;
+        }
+        try {
+            if (_entries.size() >= _capacity) {
+                _entries.erase(_entries.begin());
+                ++_stats.drops;
+            }
+            if (_entries.insert(make_entry(epoch, dk)).second) {
+                ++_stats.insertions;
+            }
+        } catch (...) {
+            // Nothing to undo.
+        }
+    }
+
+    // Returns false if the partition couldn't be looked up, in which case
+    // the caller has to forget all partitions of the epoch.
+    [[nodiscard]] bool erase(epoch_type epoch, const dht::decorated_key& dk) noexcept {
+        if (_entries.empty()) {
+            return true;
+        }
+        try {
+            _entries.erase(make_entry(epoch, dk));
+            return true;
+        } catch (...) {
+            return false;
+        }
+    }
+
+    size_t size() const noexcept {
+        return _entries.size();
+    }
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+};
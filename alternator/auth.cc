@@ -52,6 +52,23 @@ static std::string apply_sha256(std::string_view msg) {
     return to_hex(hasher.finalize());
 }
 
+hmac_sha256_digest signing_key_cache::get(std::string_view access_key_id, std::string_view secret_access_key,
+        std::string_view datestamp, std::string_view region, std::string_view service) {
+    key_type key(access_key_id, secret_access_key, datestamp, region, service);
+    auto it = _keys.find(key);
+    if (it != _keys.end()) {
+        return it->second;
+    }
+    // Keys of past dates are never used again, so when the cache fills up
+    // it is simply emptied.
+    if (_keys.size() >= max_entries) {
+        _keys.clear();
+    }
+    auto signing_key = get_signature_key(secret_access_key, datestamp, region, service);
+    _keys.emplace(std::move(key), signing_key);
+    return signing_key;
+}
+
 static std::string apply_sha256(const std::vector<temporary_buffer<char>>& msg) {
     sha256_hasher hasher;
     for (const temporary_buffer<char>& buf : msg) {
@@ -89,7 +106,8 @@ void check_expiry(std::string_view signature_date) {
 
 std::string get_signature(std::string_view access_key_id, std::string_view secret_access_key, std::string_view host, std::string_view method,
         std::string_view orig_datestamp, std::string_view signed_headers_str, const std::map<std::string_view, std::string_view>& signed_headers_map,
-        const std::vector<temporary_buffer<char>>& body_content, std::string_view region, std::string_view service, std::string_view query_string) {
+        const std::vector<temporary_buffer<char>>& body_content, std::string_view region, std::string_view service, std::string_view query_string,
+        signing_key_cache& signing_keys) {
     auto amz_date_it = signed_headers_map.find("x-amz-date");
     if (amz_date_it == signed_headers_map.end()) {
         throw api_error::invalid_signature("X-Amz-Date header is mandatory for signature verification");
@@ -104,19 +122,32 @@ std::string get_signature(std::string_view access_key_id, std::string_view secre
     }
     std::string_view canonical_uri = "/";
 
-    std::stringstream canonical_headers;
+    std::string payload_hash = apply_sha256(body_content);
+
+    // The canonical request is hashed as it is produced, instead of being
+    // assembled in a string first.
+    sha256_hasher canonical_request_hasher;
+    auto update = [&canonical_request_hasher] (std::string_view part) {
+        canonical_request_hasher.update(part.data(), part.size());
+    };
+    for (std::string_view part : {method, std::string_view("\n"), canonical_uri, std::string_view("\n"), query_string, std::string_view("\n")}) {
+        update(part);
+    }
     for (const auto& header : signed_headers_map) {
-        canonical_headers << fmt::format("{}:{}", header.first, header.second) << '\n';
+        update(header.first);
+        update(":");
+        update(header.second);
+        update("\n");
+    }
+    for (std::string_view part : {std::string_view("\n"), signed_headers_str, std::string_view("\n"), std::string_view(payload_hash)}) {
+        update(part);
     }
-
-    std::string payload_hash = apply_sha256(body_content);
-    std::string canonical_request = fmt::format("{}\n{}\n{}\n{}\n{}\n{}", method, canonical_uri, query_string, canonical_headers.str(), signed_headers_str, payload_hash);
 
     std::string_view algorithm = "AWS4-HMAC-SHA256";
     std::string credential_scope = fmt::format("{}/{}/{}/aws4_request", datestamp, region, service);
-    std::string string_to_sign = fmt::format("{}\n{}\n{}\n{}", algorithm, amz_date, credential_scope,  apply_sha256(canonical_request));
+    std::string string_to_sign = fmt::format("{}\n{}\n{}\n{}", algorithm, amz_date, credential_scope, to_hex(canonical_request_hasher.finalize()));
 
-    hmac_sha256_digest signing_key = get_signature_key(secret_access_key, datestamp, region, service);
+    hmac_sha256_digest signing_key = signing_keys.get(access_key_id, secret_access_key, datestamp, region, service);
     hmac_sha256_digest signature = hmac_sha256(std::string_view(signing_key.data(), signing_key.size()), string_to_sign);
 
     return to_hex(bytes_view(reinterpret_cast<const int8_t*>(signature.data()), signature.size()));
@@ -11,6 +11,8 @@
 #include <string>
 #include <string_view>
 #include <array>
+#include <map>
+#include <tuple>
 #include "gc_clock.hh"
 #include "utils/loading_cache.hh"
 
@@ -24,9 +26,25 @@ using hmac_sha256_digest = std::array<char, 32>;
 
 using key_cache = utils::loading_cache<std::string, std::string, 1>;
 
+// Caches the signing keys derived from the secret keys of users. A signing
+// key only depends on the secret key and on the date, region and service of
+// the request's credential scope, so it only changes daily, but deriving it
+// takes a chain of four HMACs.
+class signing_key_cache {
+    // The secret key is part of the key, so a changed secret is never used
+    // with the signing key of the old one.
+    using key_type = std::tuple<std::string, std::string, std::string, std::string, std::string>;
+    static constexpr size_t max_entries = 1024;
+    std::map<key_type, hmac_sha256_digest> _keys;
+public:
+    hmac_sha256_digest get(std::string_view access_key_id, std::string_view secret_access_key,
+            std::string_view datestamp, std::string_view region, std::string_view service);
+};
+
 std::string get_signature(std::string_view access_key_id, std::string_view secret_access_key, std::string_view host, std::string_view method,
         std::string_view orig_datestamp, std::string_view signed_headers_str, const std::map<std::string_view, std::string_view>& signed_headers_map,
-        const std::vector<temporary_buffer<char>>& body_content, std::string_view region, std::string_view service, std::string_view query_string);
+        const std::vector<temporary_buffer<char>>& body_content, std::string_view region, std::string_view service, std::string_view query_string,
+        signing_key_cache& signing_keys);
 
 future<std::string> get_key_from_roles(service::storage_proxy& proxy, std::string username);
 
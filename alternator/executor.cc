@@ -18,6 +18,7 @@
 #include "exceptions/exceptions.hh"
 #include "timestamp.hh"
 #include "types/map.hh"
+#include "types/listlike_partial_deserializing_iterator.hh"
 #include "schema.hh"
 #include "query-request.hh"
 #include "query-result-reader.hh"
@@ -47,6 +48,7 @@
 #include <seastar/core/coroutine.hh>
 #include <boost/range/adaptors.hpp>
 #include <boost/range/algorithm/find_end.hpp>
+#include <boost/range/irange.hpp>
 #include <unordered_set>
 #include "service/storage_proxy.hh"
 #include "gms/gossiper.hh"
@@ -665,8 +667,12 @@ static const std::unordered_set<std::string_view> allowed_write_isolation_values
     "a", "always", "always_use_lwt",
     "o", "only_rmw_uses_lwt",
     "u", "unsafe", "unsafe_rmw",
+    "l", "local_lock",
 };
 
+static const sstring SCAN_PARALLELISM_TAG_KEY("system:scan_parallelism");
+static constexpr unsigned max_scan_parallelism = 64;
+
 static void validate_tags(const std::map<sstring, sstring>& tags) {
     auto it = tags.find(rmw_operation::WRITE_ISOLATION_TAG_KEY);
     if (it != tags.end()) {
@@ -676,6 +682,18 @@ static void validate_tags(const std::map<sstring, sstring>& tags) {
                     format("Incorrect write isolation tag {}. Allowed values: {}", value, allowed_write_isolation_values));
         }
     }
+    it = tags.find(SCAN_PARALLELISM_TAG_KEY);
+    if (it != tags.end()) {
+        unsigned long value = 0;
+        try {
+            value = std::stoul(it->second);
+        } catch (...) {
+        }
+        if (value < 2 || value > max_scan_parallelism) {
+            throw api_error::validation(
+                    format("Incorrect scan parallelism tag {}. Allowed values are 2 to {}", it->second, max_scan_parallelism));
+        }
+    }
 }
 
 static rmw_operation::write_isolation parse_write_isolation(std::string_view value) {
@@ -689,6 +707,8 @@ static rmw_operation::write_isolation parse_write_isolation(std::string_view val
             return rmw_operation::write_isolation::LWT_RMW_ONLY;
         case 'u':
             return rmw_operation::write_isolation::UNSAFE_RMW;
+        case 'l':
+            return rmw_operation::write_isolation::LOCAL_LOCK;
         }
     }
     // Shouldn't happen as validate_tags() / set_default_write_isolation()
@@ -1441,6 +1461,8 @@ rmw_operation::write_isolation rmw_operation::get_write_isolation_for_schema(sch
 // other shard. Running execute() on a specific shard is necessary only if it
 // will use LWT (storage_proxy::cas()). This is because cas() can only be
 // called on the specific shard owning (as per cas_shard()) _pk's token.
+// The LOCAL_LOCK isolation uses the same shard, so that all the operations
+// on an item take the same lock.
 // Knowing if execute() will call cas() or not may depend on whether there is
 // a read-before-write, but not just on it - depending on configuration,
 // execute() may unconditionally use cas() for every write. Unfortunately,
@@ -1498,12 +1520,103 @@ static future<std::unique_ptr<rjson::value>> get_previous_item(
     });
 }
 
+// item_locks are the locks of items written by tables with the LOCAL_LOCK
+// write isolation. All the writes of an item are run on the same shard (see
+// shard_for_execute()), so the locks are per shard. A lock only exists while
+// it is held or waited for.
+class item_locks {
+public:
+    using key = std::tuple<utils::UUID, bytes, bytes>;
+    static key make_key(const schema& s, const partition_key& pk, const clustering_key& ck) {
+        return key(s.id(), to_bytes(pk.representation()), to_bytes(ck.representation()));
+    }
+private:
+    struct lock {
+        db::timeout_semaphore sem{1};
+        unsigned users = 0;
+    };
+    std::map<key, lock> _locks;
+
+    void release(std::map<key, lock>::iterator it, bool locked) {
+        if (locked) {
+            it->second.sem.signal();
+        }
+        if (--it->second.users == 0) {
+            _locks.erase(it);
+        }
+    }
+public:
+    class holder {
+        item_locks* _locks = nullptr;
+        std::vector<std::map<key, lock>::iterator> _locked;
+        friend class item_locks;
+    public:
+        holder() = default;
+        holder(holder&& o) noexcept : _locks(o._locks), _locked(std::move(o._locked)) {
+            o._locked.clear();
+        }
+        holder& operator=(holder&&) = delete;
+        ~holder() {
+            for (auto it : _locked) {
+                _locks->release(it, true);
+            }
+        }
+    };
+
+    // Locks the given items. They are locked in a fixed order, so that
+    // callers locking more than one item can't deadlock.
+    future<holder> lock(std::vector<key> keys, db::timeout_clock::time_point timeout) {
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        holder h;
+        h._locks = this;
+        h._locked.reserve(keys.size());
+        for (auto& k : keys) {
+            auto it = _locks.try_emplace(std::move(k)).first;
+            ++it->second.users;
+            try {
+                co_await it->second.sem.wait(timeout);
+            } catch (...) {
+                release(it, false);
+                throw;
+            }
+            h._locked.push_back(it);
+        }
+        co_return h;
+    }
+};
+
+static thread_local item_locks local_item_locks;
+
+future<executor::request_return_type> rmw_operation::execute_with_local_lock(service::storage_proxy& proxy,
+        service::client_state& client_state,
+        tracing::trace_state_ptr trace_state,
+        service_permit permit,
+        bool needs_read_before_write,
+        stats& stats) {
+    stats.write_using_local_lock++;
+    auto lock = co_await local_item_locks.lock({item_locks::make_key(*schema(), _pk, _ck)}, executor::default_timeout());
+    std::unique_ptr<rjson::value> previous_item;
+    if (needs_read_before_write) {
+        previous_item = co_await get_previous_item(proxy, client_state, schema(), _pk, _ck, permit, stats);
+    }
+    std::optional<mutation> m = apply(std::move(previous_item), api::new_timestamp());
+    if (!m) {
+        co_return api_error::conditional_check_failed("Failed condition.");
+    }
+    co_await proxy.mutate(std::vector<mutation>{std::move(*m)}, db::consistency_level::LOCAL_QUORUM, executor::default_timeout(), trace_state, std::move(permit), db::allow_per_partition_rate_limit::yes);
+    co_return co_await rmw_operation_return(std::move(_return_attributes));
+}
+
 future<executor::request_return_type> rmw_operation::execute(service::storage_proxy& proxy,
         service::client_state& client_state,
         tracing::trace_state_ptr trace_state,
         service_permit permit,
         bool needs_read_before_write,
         stats& stats) {
+    if (_write_isolation == write_isolation::LOCAL_LOCK) {
+        return execute_with_local_lock(proxy, client_state, std::move(trace_state), std::move(permit), needs_read_before_write, stats);
+    }
     if (needs_read_before_write) {
         if (_write_isolation == write_isolation::FORBID_RMW) {
             throw api_error::validation("Read-modify-write operations are disabled by 'forbid_rmw' write isolation policy. Refer to https://github.com/scylladb/scylla/blob/master/docs/alternator/alternator.md#write-isolation-policies for more information.");
@@ -1823,6 +1936,41 @@ static future<> cas_write(service::storage_proxy& proxy, schema_ptr schema, dht:
     // does not need to support conditional updates.
 }
 
+// locked_write() is the equivalent of cas_write() for tables with the
+// LOCAL_LOCK write isolation: the items are written under their locks, so
+// they are isolated from the read-modify-write operations on them.
+static future<> locked_write(service::storage_proxy& proxy, schema_ptr schema, std::vector<put_or_delete_item> mutation_builders,
+        tracing::trace_state_ptr trace_state, service_permit permit) {
+    std::vector<item_locks::key> keys;
+    keys.reserve(mutation_builders.size());
+    for (auto& b : mutation_builders) {
+        keys.push_back(item_locks::make_key(*schema, b.pk(), b.ck()));
+    }
+    auto lock = co_await local_item_locks.lock(std::move(keys), executor::default_timeout());
+    std::vector<mutation> mutations;
+    mutations.reserve(mutation_builders.size());
+    api::timestamp_type now = api::new_timestamp();
+    for (auto& b : mutation_builders) {
+        mutations.push_back(b.build(schema, now));
+    }
+    co_await proxy.mutate(std::move(mutations),
+            db::consistency_level::LOCAL_QUORUM,
+            executor::default_timeout(),
+            std::move(trace_state),
+            std::move(permit),
+            db::allow_per_partition_rate_limit::yes);
+}
+
+// Writes the items of one partition, using LWT or item locks, on the shard
+// which should do it.
+static future<> isolated_write(service::storage_proxy& proxy, schema_ptr schema, const dht::decorated_key& dk, std::vector<put_or_delete_item>&& mutation_builders,
+        service::client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit) {
+    if (rmw_operation::get_write_isolation_for_schema(schema) == rmw_operation::write_isolation::LOCAL_LOCK) {
+        return locked_write(proxy, std::move(schema), std::move(mutation_builders), std::move(trace_state), std::move(permit));
+    }
+    return cas_write(proxy, std::move(schema), dk, std::move(mutation_builders), client_state, std::move(trace_state), std::move(permit));
+}
+
 
 struct schema_decorated_key {
     schema_ptr schema;
@@ -1856,8 +2004,11 @@ static future<> do_batch_write(service::storage_proxy& proxy,
     // likely that a batch will contain both tables which always demand LWT and ones
     // that don't - it's fragile to split a batch into multiple storage proxy requests though.
     // Hence, the decision is conservative - if any table enforces LWT,the whole batch will use it.
+    // Tables with the LOCAL_LOCK isolation are written like LWT tables, each
+    // partition on its LWT shard, but with locks instead of LWT.
     const bool needs_lwt = boost::algorithm::any_of(mutation_builders | boost::adaptors::map_keys, [] (const schema_ptr& schema) {
-        return rmw_operation::get_write_isolation_for_schema(schema) == rmw_operation::write_isolation::LWT_ALWAYS;
+        auto isolation = rmw_operation::get_write_isolation_for_schema(schema);
+        return isolation == rmw_operation::write_isolation::LWT_ALWAYS || isolation == rmw_operation::write_isolation::LOCAL_LOCK;
     });
     if (!needs_lwt) {
         // Do a normal write, without LWT:
@@ -1886,10 +2037,14 @@ static future<> do_batch_write(service::storage_proxy& proxy,
             it->second.push_back(std::move(b.second));
         }
         return parallel_for_each(std::move(key_builders), [&proxy, &client_state, &stats, trace_state, ssg, permit = std::move(permit)] (auto& e) {
-            stats.write_using_lwt++;
+            if (rmw_operation::get_write_isolation_for_schema(e.first.schema) == rmw_operation::write_isolation::LOCAL_LOCK) {
+                stats.write_using_local_lock++;
+            } else {
+                stats.write_using_lwt++;
+            }
             auto desired_shard = service::storage_proxy::cas_shard(*e.first.schema, e.first.dk.token());
             if (desired_shard == this_shard_id()) {
-                return cas_write(proxy, e.first.schema, e.first.dk, std::move(e.second), client_state, trace_state, permit);
+                return isolated_write(proxy, e.first.schema, e.first.dk, std::move(e.second), client_state, trace_state, permit);
             } else {
                 stats.shard_bounce_for_lwt++;
                 return proxy.container().invoke_on(desired_shard, ssg,
@@ -1909,7 +2064,7 @@ static future<> do_batch_write(service::storage_proxy& proxy,
                         // to another shard - once it is solved, this place can use a similar solution. Instead of passing
                         // empty_service_permit() to the background operation, the current permit's lifetime should be prolonged,
                         // so that it's destructed only after all background operations are finished as well.
-                        return cas_write(proxy, schema, dk, std::move(mb), client_state, std::move(trace_state), empty_service_permit());
+                        return isolated_write(proxy, schema, dk, std::move(mb), client_state, std::move(trace_state), empty_service_permit());
                     });
                 });
             }
@@ -2286,12 +2441,17 @@ void executor::describe_single_item(const cql3::selection::selection& selection,
                 rjson::add_with_string_name(field, type_to_string((*column_it)->type), json_key_column_value(*cell, **column_it));
             }
         } else if (cell) {
-            auto deserialized = attrs_type()->deserialize(*cell, cql_serialization_format::latest());
-            auto keys_and_values = value_cast<map_type_impl::native_type>(deserialized);
-            for (auto entry : keys_and_values) {
-                std::string attr_name = value_cast<sstring>(entry.first);
+            // Walk the serialized map in place, instead of deserializing it
+            // into a map of copies, so that with a projection only the
+            // requested attributes are copied and converted to JSON.
+            bytes_view in = *cell;
+            const auto sf = cql_serialization_format::latest();
+            int n = read_collection_size(in, sf);
+            for (int i = 0; i < n; i++) {
+                bytes_view name = read_collection_value(in, sf);
+                bytes_view value = read_collection_value(in, sf);
+                std::string attr_name(reinterpret_cast<const char*>(name.data()), name.size());
                 if (include_all_embedded_attributes || !attrs_to_get || attrs_to_get->contains(attr_name)) {
-                    bytes value = value_cast<bytes>(entry.second);
                     rjson::value v = deserialize_item(value);
                     if (attrs_to_get) {
                         auto it = attrs_to_get->find(attr_name);
@@ -3083,7 +3243,7 @@ future<executor::request_return_type> executor::get_item(client_state& client_st
             service::storage_proxy::coordinator_query_options(executor::default_timeout(), std::move(permit), client_state, trace_state)).then(
             [this, schema, partition_slice = std::move(partition_slice), selection = std::move(selection), attrs_to_get = std::move(attrs_to_get), start_time = std::move(start_time)] (service::storage_proxy::coordinator_query_result qr) mutable {
         _stats.api_operations.get_item_latency.add(std::chrono::steady_clock::now() - start_time);
-        return make_ready_future<executor::request_return_type>(make_jsonable(describe_item(schema, partition_slice, *selection, *qr.query_result, std::move(attrs_to_get))));
+        return make_ready_future<executor::request_return_type>(make_streamed_if_big(describe_item(schema, partition_slice, *selection, *qr.query_result, std::move(attrs_to_get))));
     });
 }
 
@@ -3150,6 +3310,13 @@ static void check_big_object(const rjson::value& val, int& size_left) {
     }
 }
 
+json::json_return_type make_streamed_if_big(rjson::value&& value) {
+    if (is_big(value)) {
+        return make_streamed(std::move(value));
+    }
+    return make_jsonable(std::move(value));
+}
+
 future<executor::request_return_type> executor::batch_get_item(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request) {
     // FIXME: In this implementation, an unbounded batch size can cause
     // unbounded response JSON object to be buffered in memory, unbounded
@@ -3207,39 +3374,62 @@ future<executor::request_return_type> executor::batch_get_item(client_state& cli
         requests.emplace_back(std::move(rs));
     }
 
-    // If we got here, all "requests" are valid, so let's start the
-    // requests for the different partitions all in parallel.
-    std::vector<future<std::vector<rjson::value>>> response_futures;
+    // If we got here, all "requests" are valid, so let's group them into
+    // reads. A read covers the rows of one partition, or, in a table without
+    // a clustering key, up to max_partitions_per_read partitions, which the
+    // coordinator reads in parallel and returns as a single result. This
+    // saves a command, permit and result conversion per key for the common
+    // BatchGetItem of many hash-only keys.
+    static constexpr size_t max_partitions_per_read = 16;
+    struct batch_read {
+        const table_requests& rs;
+        dht::partition_range_vector partition_ranges;
+        std::vector<query::clustering_range> bounds;
+        // The "Key"s read, to be listed in UnprocessedKeys if the read fails.
+        std::vector<rjson::value*> keys;
+        explicit batch_read(const table_requests& rs) : rs(rs) {}
+    };
+    std::vector<batch_read> reads;
     for (const auto& rs : requests) {
-        for (const auto &r : rs.requests) {
-            auto& pk = r.first;
-            auto& cks = r.second;
-            dht::partition_range_vector partition_ranges{dht::partition_range(dht::decorate_key(*rs.schema, pk))};
-            std::vector<query::clustering_range> bounds;
-            if (rs.schema->clustering_key_size() == 0) {
-                bounds.push_back(query::clustering_range::make_open_ended_both_sides());
-            } else {
+        batch_read* current = nullptr;
+        for (const auto& [pk, cks] : rs.requests) {
+            if (rs.schema->clustering_key_size() != 0) {
+                current = &reads.emplace_back(rs);
                 for (auto& ck : cks) {
-                    bounds.push_back(query::clustering_range::make_singular(ck.first));
+                    current->bounds.push_back(query::clustering_range::make_singular(ck.first));
                 }
+            } else if (!current || current->partition_ranges.size() == max_partitions_per_read) {
+                current = &reads.emplace_back(rs);
+                current->bounds.push_back(query::clustering_range::make_open_ended_both_sides());
+            }
+            current->partition_ranges.emplace_back(dht::decorate_key(*rs.schema, pk));
+            for (auto& ck : cks) {
+                current->keys.push_back(ck.second);
             }
-            auto regular_columns = boost::copy_range<query::column_id_vector>(
-                    rs.schema->regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
-            auto selection = cql3::selection::selection::wildcard(rs.schema);
-            auto partition_slice = query::partition_slice(std::move(bounds), {}, std::move(regular_columns), selection->get_query_options());
-            auto command = ::make_lw_shared<query::read_command>(rs.schema->id(), rs.schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice));
-            command->allow_limit = db::allow_per_partition_rate_limit::yes;
-            future<std::vector<rjson::value>> f = _proxy.query(rs.schema, std::move(command), std::move(partition_ranges), rs.cl,
-                    service::storage_proxy::coordinator_query_options(executor::default_timeout(), permit, client_state, trace_state)).then(
-                    [schema = rs.schema, partition_slice = std::move(partition_slice), selection = std::move(selection), attrs_to_get = rs.attrs_to_get] (service::storage_proxy::coordinator_query_result qr) mutable {
-                utils::get_local_injector().inject("alternator_batch_get_item", [] { throw std::runtime_error("batch_get_item injection"); });
-                std::vector<rjson::value> jsons = describe_multi_item(schema, partition_slice, *selection, *qr.query_result, *attrs_to_get);
-                return make_ready_future<std::vector<rjson::value>>(std::move(jsons));
-            });
-            response_futures.push_back(std::move(f));
         }
     }
 
+    // Start all the reads in parallel.
+    std::vector<future<std::vector<rjson::value>>> response_futures;
+    response_futures.reserve(reads.size());
+    for (auto& read : reads) {
+        const auto& rs = read.rs;
+        auto regular_columns = boost::copy_range<query::column_id_vector>(
+                rs.schema->regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
+        auto selection = cql3::selection::selection::wildcard(rs.schema);
+        auto partition_slice = query::partition_slice(std::move(read.bounds), {}, std::move(regular_columns), selection->get_query_options());
+        auto command = ::make_lw_shared<query::read_command>(rs.schema->id(), rs.schema->version(), partition_slice, _proxy.get_max_result_size(partition_slice));
+        command->allow_limit = db::allow_per_partition_rate_limit::yes;
+        future<std::vector<rjson::value>> f = _proxy.query(rs.schema, std::move(command), std::move(read.partition_ranges), rs.cl,
+                service::storage_proxy::coordinator_query_options(executor::default_timeout(), permit, client_state, trace_state)).then(
+                [schema = rs.schema, partition_slice = std::move(partition_slice), selection = std::move(selection), attrs_to_get = rs.attrs_to_get] (service::storage_proxy::coordinator_query_result qr) mutable {
+            utils::get_local_injector().inject("alternator_batch_get_item", [] { throw std::runtime_error("batch_get_item injection"); });
+            std::vector<rjson::value> jsons = describe_multi_item(schema, partition_slice, *selection, *qr.query_result, *attrs_to_get);
+            return make_ready_future<std::vector<rjson::value>>(std::move(jsons));
+        });
+        response_futures.push_back(std::move(f));
+    }
+
     // Wait for all requests to complete, and then return the response.
     // In case of full failure (no reads succeeded), an arbitrary error
     // from one of the operations will be returned.
@@ -3251,44 +3441,41 @@ future<executor::request_return_type> executor::batch_get_item(client_state& cli
     rjson::add(response, "UnprocessedKeys", rjson::empty_object());
 
     auto fut_it = response_futures.begin();
-    for (const auto& rs : requests) {
-        auto table = table_name(*rs.schema);
-        for (const auto &r : rs.requests) {
-            auto& pk = r.first;
-            auto& cks = r.second;
-            auto& fut = *fut_it;
-            ++fut_it;
-            try {
-                std::vector<rjson::value> results = co_await std::move(fut);
-                some_succeeded = true;
-                if (!response["Responses"].HasMember(table)) {
-                    rjson::add_with_string_name(response["Responses"], table, rjson::empty_array());
-                }
-                for (rjson::value& json : results) {
-                    rjson::push_back(response["Responses"][table], std::move(json));
-                }
-            } catch(...) {
-                eptr = std::current_exception();
-                // This read of potentially several rows in one partition,
-                // failed. We need to add the row key(s) to UnprocessedKeys.
-                if (!response["UnprocessedKeys"].HasMember(table)) {
-                    // Add the table's entry in UnprocessedKeys. Need to copy
-                    // all the table's parameters from the request except the
-                    // Keys field, which we start empty and then build below.
-                    rjson::add_with_string_name(response["UnprocessedKeys"], table, rjson::empty_object());
-                    rjson::value& unprocessed_item = response["UnprocessedKeys"][table];
-                    rjson::value& request_item = request_items[table];
-                    for (auto it = request_item.MemberBegin(); it != request_item.MemberEnd(); ++it) {
-                        if (it->name != "Keys") {
-                            rjson::add_with_string_name(unprocessed_item,
-                                rjson::to_string_view(it->name), rjson::copy(it->value));
-                        }
+    for (const auto& read : reads) {
+        auto table = table_name(*read.rs.schema);
+        auto& fut = *fut_it;
+        ++fut_it;
+        try {
+            std::vector<rjson::value> results = co_await std::move(fut);
+            some_succeeded = true;
+            if (!response["Responses"].HasMember(table)) {
+                rjson::add_with_string_name(response["Responses"], table, rjson::empty_array());
+            }
+            for (rjson::value& json : results) {
+                rjson::push_back(response["Responses"][table], std::move(json));
+            }
+        } catch(...) {
+            eptr = std::current_exception();
+            // This read of potentially several rows, in one or several
+            // partitions, failed. We need to add the row key(s) to
+            // UnprocessedKeys.
+            if (!response["UnprocessedKeys"].HasMember(table)) {
+                // Add the table's entry in UnprocessedKeys. Need to copy
+                // all the table's parameters from the request except the
+                // Keys field, which we start empty and then build below.
+                rjson::add_with_string_name(response["UnprocessedKeys"], table, rjson::empty_object());
+                rjson::value& unprocessed_item = response["UnprocessedKeys"][table];
+                rjson::value& request_item = request_items[table];
+                for (auto it = request_item.MemberBegin(); it != request_item.MemberEnd(); ++it) {
+                    if (it->name != "Keys") {
+                        rjson::add_with_string_name(unprocessed_item,
+                            rjson::to_string_view(it->name), rjson::copy(it->value));
                     }
-                    rjson::add_with_string_name(unprocessed_item, "Keys", rjson::empty_array());
-                }
-                for (auto& ck : cks) {
-                    rjson::push_back(response["UnprocessedKeys"][table]["Keys"], std::move(*ck.second));
                 }
+                rjson::add_with_string_name(unprocessed_item, "Keys", rjson::empty_array());
+            }
+            for (rjson::value* key : read.keys) {
+                rjson::push_back(response["UnprocessedKeys"][table]["Keys"], std::move(*key));
             }
         }
     }
@@ -3296,11 +3483,7 @@ future<executor::request_return_type> executor::batch_get_item(client_state& cli
     if (!some_succeeded && eptr) {
         co_await coroutine::return_exception_ptr(std::move(eptr));
     }
-    if (is_big(response)) {
-        co_return make_streamed(std::move(response));
-    } else {
-        co_return make_jsonable(std::move(response));
-    }
+    co_return make_streamed_if_big(std::move(response));
 }
 
 // "filter" represents a condition that can be applied to individual items
@@ -3490,12 +3673,14 @@ class describe_items_visitor {
                     rjson::add_with_string_name(field, type_to_string((*_column_it)->type), json_key_column_value(bv, **_column_it));
                 }
             } else {
-                auto deserialized = attrs_type()->deserialize(bv, cql_serialization_format::latest());
-                auto keys_and_values = value_cast<map_type_impl::native_type>(deserialized);
-                for (auto entry : keys_and_values) {
-                    std::string attr_name = value_cast<sstring>(entry.first);
+                // See describe_single_item() on walking the serialized map.
+                const auto sf = cql_serialization_format::latest();
+                int n = read_collection_size(bv, sf);
+                for (int i = 0; i < n; i++) {
+                    bytes_view name = read_collection_value(bv, sf);
+                    bytes_view value = read_collection_value(bv, sf);
+                    std::string attr_name(reinterpret_cast<const char*>(name.data()), name.size());
                     if (!_attrs_to_get || _attrs_to_get->contains(attr_name) || _extra_filter_attrs.contains(attr_name)) {
-                        bytes value = value_cast<bytes>(entry.second);
                         // Even if _attrs_to_get asked to keep only a part of a
                         // top-level attribute, we keep the entire attribute
                         // at this stage, because the item filter might still
@@ -3547,9 +3732,11 @@ class describe_items_visitor {
     }
 };
 
-static std::tuple<rjson::value, size_t> describe_items(schema_ptr schema, const query::partition_slice& slice, const cql3::selection::selection& selection, std::unique_ptr<cql3::result_set> result_set, std::optional<attrs_to_get>&& attrs_to_get, filter&& filter) {
+static std::tuple<rjson::value, size_t> describe_items(schema_ptr schema, const query::partition_slice& slice, const cql3::selection::selection& selection, std::vector<std::unique_ptr<cql3::result_set>> result_sets, std::optional<attrs_to_get>&& attrs_to_get, filter&& filter) {
     describe_items_visitor visitor(selection.get_columns(), attrs_to_get, filter);
-    result_set->visit(visitor);
+    for (auto& result_set : result_sets) {
+        result_set->visit(visitor);
+    }
     auto scanned_count = visitor.get_scanned_count();
     rjson::value items = std::move(visitor).get_items();
     rjson::value items_descr = rjson::empty_object();
@@ -3604,6 +3791,65 @@ static rjson::value encode_paging_state(const schema& schema, const service::pag
     return last_evaluated_key;
 }
 
+static lw_shared_ptr<service::pager::paging_state> paging_state_from_key(const rjson::value& exclusive_start_key, const schema_ptr& schema) {
+    partition_key pk = pk_from_json(exclusive_start_key, schema);
+    auto pos = position_in_partition(position_in_partition::partition_start_tag_t());
+    if (schema->clustering_key_size() > 0) {
+        pos = pos_from_json(exclusive_start_key, schema);
+    }
+    return make_lw_shared<service::pager::paging_state>(pk, pos, query::max_partitions, utils::UUID(), service::pager::paging_state::replicas_per_token_range{}, std::nullopt, 0);
+}
+
+static query::partition_slice make_query_slice(const schema& schema, const cql3::selection::selection& selection,
+        std::vector<query::clustering_range>&& ck_bounds, query::partition_slice::option_set custom_opts) {
+    auto regular_columns = boost::copy_range<query::column_id_vector>(
+            schema.regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
+    auto static_columns = boost::copy_range<query::column_id_vector>(
+            schema.static_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
+    query::partition_slice::option_set opts = selection.get_query_options();
+    opts.add(custom_opts);
+    return query::partition_slice(std::move(ck_bounds), std::move(static_columns), std::move(regular_columns), opts);
+}
+
+struct query_page {
+    // Has the paging state in its metadata unless the ranges were read to their end.
+    std::unique_ptr<cql3::result_set> result_set;
+    uint64_t rows_read;
+};
+
+// Reads a page of up to limit rows of the partition ranges, starting after
+// the paging state, if given.
+static future<query_page> fetch_query_page(service::storage_proxy& proxy,
+        schema_ptr schema,
+        lw_shared_ptr<service::pager::paging_state> paging_state,
+        dht::partition_range_vector&& partition_ranges,
+        const query::partition_slice& partition_slice,
+        ::shared_ptr<cql3::selection::selection> selection,
+        uint32_t limit,
+        db::consistency_level cl,
+        service::client_state& client_state,
+        tracing::trace_state_ptr trace_state,
+        service_permit permit) {
+    auto command = ::make_lw_shared<query::read_command>(schema->id(), schema->version(), partition_slice, proxy.get_max_result_size(partition_slice));
+
+    auto query_state_ptr = std::make_unique<service::query_state>(client_state, trace_state, std::move(permit));
+
+    // FIXME: should be moved above, set on opts, so get_max_result_size knows it?
+    command->slice.options.set<query::partition_slice::option::allow_short_read>();
+    auto query_options = std::make_unique<cql3::query_options>(cl, std::vector<cql3::raw_value>{});
+    query_options = std::make_unique<cql3::query_options>(std::move(query_options), std::move(paging_state));
+    auto p = service::pager::query_pagers::pager(proxy, schema, selection, *query_state_ptr, *query_options, command, std::move(partition_ranges), nullptr);
+
+    return p->fetch_page(limit, gc_clock::now(), executor::default_timeout()).then(
+            [p = std::move(p), query_state_ptr = std::move(query_state_ptr),
+             query_options = std::move(query_options)] (std::unique_ptr<cql3::result_set> rs) mutable {
+        if (!p->is_exhausted()) {
+            rs->get_metadata().set_paging_state(p->state());
+        }
+        return query_page{std::move(rs), p->stats().rows_read_total};
+    });
+}
+
 static future<executor::request_return_type> do_query(service::storage_proxy& proxy,
         schema_ptr schema,
         const rjson::value* exclusive_start_key,
@@ -3623,57 +3869,32 @@ static future<executor::request_return_type> do_query(service::storage_proxy& pr
     tracing::trace(trace_state, "Performing a database query");
 
     if (exclusive_start_key) {
-        partition_key pk = pk_from_json(*exclusive_start_key, schema);
-        auto pos = position_in_partition(position_in_partition::partition_start_tag_t());
-        if (schema->clustering_key_size() > 0) {
-            pos = pos_from_json(*exclusive_start_key, schema);
-        }
-        paging_state = make_lw_shared<service::pager::paging_state>(pk, pos, query::max_partitions, utils::UUID(), service::pager::paging_state::replicas_per_token_range{}, std::nullopt, 0);
+        paging_state = paging_state_from_key(*exclusive_start_key, schema);
     }
 
-    auto regular_columns = boost::copy_range<query::column_id_vector>(
-            schema->regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
-    auto static_columns = boost::copy_range<query::column_id_vector>(
-            schema->static_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
     auto selection = cql3::selection::selection::wildcard(schema);
-    query::partition_slice::option_set opts = selection->get_query_options();
-    opts.add(custom_opts);
-    auto partition_slice = query::partition_slice(std::move(ck_bounds), std::move(static_columns), std::move(regular_columns), opts);
-    auto command = ::make_lw_shared<query::read_command>(schema->id(), schema->version(), partition_slice, proxy.get_max_result_size(partition_slice));
+    auto partition_slice = make_query_slice(*schema, *selection, std::move(ck_bounds), custom_opts);
 
-    auto query_state_ptr = std::make_unique<service::query_state>(client_state, trace_state, std::move(permit));
-
-    // FIXME: should be moved above, set on opts, so get_max_result_size knows it?
-    command->slice.options.set<query::partition_slice::option::allow_short_read>();
-    auto query_options = std::make_unique<cql3::query_options>(cl, std::vector<cql3::raw_value>{});
-    query_options = std::make_unique<cql3::query_options>(std::move(query_options), std::move(paging_state));
-    auto p = service::pager::query_pagers::pager(proxy, schema, selection, *query_state_ptr, *query_options, command, std::move(partition_ranges), nullptr);
-
-    return p->fetch_page(limit, gc_clock::now(), executor::default_timeout()).then(
-            [p = std::move(p), schema, cql_stats, partition_slice = std::move(partition_slice),
-             selection = std::move(selection), query_state_ptr = std::move(query_state_ptr),
+    auto f = fetch_query_page(proxy, schema, std::move(paging_state), std::move(partition_ranges), partition_slice, selection, limit, cl,
+            client_state, std::move(trace_state), std::move(permit));
+    return f.then([schema, &cql_stats, partition_slice = std::move(partition_slice),
+             selection = std::move(selection),
              attrs_to_get = std::move(attrs_to_get),
-             query_options = std::move(query_options),
-             filter = std::move(filter)] (std::unique_ptr<cql3::result_set> rs) mutable {
-        if (!p->is_exhausted()) {
-            rs->get_metadata().set_paging_state(p->state());
-        }
-        auto paging_state = rs->get_metadata().paging_state();
+             filter = std::move(filter)] (query_page page) mutable {
+        auto paging_state = page.result_set->get_metadata().paging_state();
         bool has_filter = filter;
-        auto [items, size] = describe_items(schema, partition_slice, *selection, std::move(rs), std::move(attrs_to_get), std::move(filter));
+        std::vector<std::unique_ptr<cql3::result_set>> result_sets;
+        result_sets.push_back(std::move(page.result_set));
+        auto [items, size] = describe_items(schema, partition_slice, *selection, std::move(result_sets), std::move(attrs_to_get), std::move(filter));
         if (paging_state) {
             rjson::add(items, "LastEvaluatedKey", encode_paging_state(*schema, *paging_state));
         }
         if (has_filter){
-            cql_stats.filtered_rows_read_total += p->stats().rows_read_total;
+            cql_stats.filtered_rows_read_total += page.rows_read;
             // update our "filtered_row_matched_total" for all the rows matched, despited the filter
             cql_stats.filtered_rows_matched_total += size;
         }
-        // TODO: better threshold
-        if (size > 10) {
-            return make_ready_future<executor::request_return_type>(make_streamed(std::move(items)));
-        }
-        return make_ready_future<executor::request_return_type>(make_jsonable(std::move(items)));
+        return make_ready_future<executor::request_return_type>(make_streamed_if_big(std::move(items)));
     });
 }
 
@@ -3705,6 +3926,169 @@ static dht::partition_range get_range_for_segment(int segment, int total_segment
     }
 }
 
+// Splits the token range of the segment into n consecutive sub-ranges.
+static dht::partition_range_vector split_range_for_segment(int segment, int total_segments, unsigned n) {
+    auto range = get_range_for_segment(segment, total_segments);
+    // Offsets of tokens from the minimum token.
+    uint64_t first = 0;
+    uint64_t width = std::numeric_limits<uint64_t>::max();
+    if (total_segments > 1) {
+        uint64_t delta = std::numeric_limits<uint64_t>::max() / total_segments;
+        first = delta * segment;
+        width = segment == total_segments - 1 ? std::numeric_limits<uint64_t>::max() - first : delta;
+    }
+    dht::partition_range_vector ranges;
+    ranges.reserve(n);
+    auto start = range.start();
+    for (unsigned i = 1; i < n; ++i) {
+        uint64_t offset = first + width / n * i;
+        auto token = dht::token::from_int64(int64_t(uint64_t(std::numeric_limits<int64_t>::min()) + offset));
+        // Unlike the bounds of segments, the bounds of sub-ranges don't
+        // share the keys of the boundary token.
+        ranges.emplace_back(start, dht::partition_range::bound(dht::ring_position::starting_at(token), false));
+        start = dht::partition_range::bound(dht::ring_position::starting_at(token));
+    }
+    ranges.emplace_back(start, range.end());
+    return ranges;
+}
+
+// The number of sub-ranges read in parallel by a Scan of the table, set
+// by the table's system:scan_parallelism tag, or 1.
+static unsigned get_scan_parallelism(const schema_ptr& schema) {
+    auto tag = db::find_tag(*schema, SCAN_PARALLELISM_TAG_KEY);
+    if (!tag) {
+        return 1;
+    }
+    try {
+        return std::clamp<unsigned long>(std::stoul(*tag), 1, max_scan_parallelism);
+    } catch (...) {
+        return 1;
+    }
+}
+
+// Where the read of a sub-range of a parallel scan is at.
+struct scan_cursor {
+    bool done = false;
+    // The key after which the read continues, disengaged before the read starts.
+    std::optional<rjson::value> last_key;
+};
+
+// A parallel scan continues from a LastEvaluatedKey which holds the cursors
+// of all its sub-ranges, in a list of the scylla_parallel_scan attribute:
+// NULL for a sub-range which was read to its end, an empty map for one whose
+// read didn't start, or its last evaluated key.
+static rjson::value encode_scan_cursors(const std::vector<scan_cursor>& cursors) {
+    rjson::value list = rjson::empty_array();
+    for (auto& cursor : cursors) {
+        rjson::value value = rjson::empty_object();
+        if (cursor.done) {
+            rjson::add(value, "NULL", rjson::value(true));
+        } else {
+            rjson::add(value, "M", cursor.last_key ? rjson::copy(*cursor.last_key) : rjson::empty_object());
+        }
+        rjson::push_back(list, std::move(value));
+    }
+    rjson::value last_evaluated_key = rjson::empty_object();
+    rjson::add_with_string_name(last_evaluated_key, scylla_parallel_scan, rjson::empty_object());
+    rjson::add(last_evaluated_key[scylla_parallel_scan.data()], "L", std::move(list));
+    return last_evaluated_key;
+}
+
+static std::vector<scan_cursor> decode_scan_cursors(const rjson::value& cursors_json, const dht::partition_range_vector& ranges, const schema_ptr& schema) {
+    auto invalid = [] {
+        return api_error::validation("The provided starting key is invalid: Invalid ExclusiveStartKey of a parallel scan");
+    };
+    const rjson::value* list = rjson::find(cursors_json, "L");
+    if (!list || !list->IsArray() || list->Size() != ranges.size()) {
+        throw invalid();
+    }
+    std::vector<scan_cursor> cursors(ranges.size());
+    for (unsigned i = 0; i < ranges.size(); ++i) {
+        const rjson::value& value = (*list)[i];
+        if (!value.IsObject() || value.MemberCount() != 1) {
+            throw invalid();
+        }
+        if (rjson::find(value, "NULL")) {
+            cursors[i].done = true;
+            continue;
+        }
+        const rjson::value* key = rjson::find(value, "M");
+        if (!key || !key->IsObject()) {
+            throw invalid();
+        }
+        if (key->MemberCount() == 0) {
+            continue;
+        }
+        auto ring_pos = dht::ring_position{dht::decorate_key(*schema, pk_from_json(*key, schema))};
+        if (!ranges[i].contains(ring_pos, dht::ring_position_comparator(*schema))) {
+            throw invalid();
+        }
+        cursors[i].last_key = rjson::copy(*key);
+    }
+    return cursors;
+}
+
+// Reads the sub-ranges of a scan which weren't read to their end in
+// parallel, each up to its share of the limit, and returns their items
+// one sub-range after another.
+static future<executor::request_return_type> do_parallel_scan(service::storage_proxy& proxy,
+        schema_ptr schema,
+        dht::partition_range_vector ranges,
+        std::vector<scan_cursor> cursors,
+        std::optional<attrs_to_get> attrs_to_get,
+        uint32_t limit,
+        db::consistency_level cl,
+        filter filter,
+        service::client_state& client_state,
+        cql3::cql_stats& cql_stats,
+        tracing::trace_state_ptr trace_state,
+        service_permit permit) {
+    tracing::trace(trace_state, "Performing a parallel scan of {} ranges", ranges.size());
+
+    std::vector<unsigned> reads;
+    for (unsigned i = 0; i < cursors.size() && reads.size() < limit; ++i) {
+        if (!cursors[i].done) {
+            reads.push_back(i);
+        }
+    }
+    auto selection = cql3::selection::selection::wildcard(schema);
+    auto partition_slice = make_query_slice(*schema, *selection, {query::clustering_range::make_open_ended_both_sides()}, query::partition_slice::option_set());
+    std::vector<query_page> pages(reads.size());
+    co_await parallel_for_each(boost::irange(size_t(0), reads.size()), [&] (size_t j) {
+        auto i = reads[j];
+        uint32_t read_limit = limit / reads.size() + (j < limit % reads.size());
+        auto paging_state = cursors[i].last_key ? paging_state_from_key(*cursors[i].last_key, schema) : nullptr;
+        return fetch_query_page(proxy, schema, std::move(paging_state), {ranges[i]}, partition_slice, selection, read_limit, cl,
+                client_state, trace_state, permit).then([&pages, j] (query_page page) {
+            pages[j] = std::move(page);
+        });
+    });
+
+    uint64_t rows_read = 0;
+    std::vector<std::unique_ptr<cql3::result_set>> result_sets;
+    for (unsigned j = 0; j < reads.size(); ++j) {
+        auto& cursor = cursors[reads[j]];
+        auto paging_state = pages[j].result_set->get_metadata().paging_state();
+        if (paging_state) {
+            cursor.last_key = encode_paging_state(*schema, *paging_state);
+        } else {
+            cursor.done = true;
+        }
+        rows_read += pages[j].rows_read;
+        result_sets.push_back(std::move(pages[j].result_set));
+    }
+    bool has_filter = filter;
+    auto [items, size] = describe_items(schema, partition_slice, *selection, std::move(result_sets), std::move(attrs_to_get), std::move(filter));
+    if (!std::ranges::all_of(cursors, [] (const scan_cursor& c) { return c.done; })) {
+        rjson::add(items, "LastEvaluatedKey", encode_scan_cursors(cursors));
+    }
+    if (has_filter) {
+        cql_stats.filtered_rows_read_total += rows_read;
+        cql_stats.filtered_rows_matched_total += size;
+    }
+    co_return make_streamed_if_big(std::move(items));
+}
+
 future<executor::request_return_type> executor::scan(client_state& client_state, tracing::trace_state_ptr trace_state, service_permit permit, rjson::value request) {
     _stats.api_operations.scan++;
     elogger.trace("Scanning {}", request);
@@ -3729,6 +4113,18 @@ future<executor::request_return_type> executor::scan(client_state& client_state,
     }
 
     rjson::value* exclusive_start_key = rjson::find(request, "ExclusiveStartKey");
+    // A scan continued from a page of a parallel scan is parallel too, with
+    // the same number of sub-ranges, even if the table's tag changed since.
+    rjson::value* scan_cursors = exclusive_start_key ? rjson::find(*exclusive_start_key, scylla_parallel_scan) : nullptr;
+    unsigned parallelism = get_scan_parallelism(schema);
+    if (scan_cursors) {
+        const rjson::value* list = rjson::find(*scan_cursors, "L");
+        if (!list || !list->IsArray() || list->Size() < 2 || list->Size() > max_scan_parallelism) {
+            return make_ready_future<request_return_type>(api_error::validation(
+                    "The provided starting key is invalid: Invalid ExclusiveStartKey of a parallel scan"));
+        }
+        parallelism = list->Size();
+    }
 
     db::consistency_level cl = get_read_consistency(request);
     if (table_type == table_or_view_type::gsi && cl != db::consistency_level::LOCAL_ONE) {
@@ -3747,6 +4143,17 @@ future<executor::request_return_type> executor::scan(client_state& client_state,
     std::unordered_set<std::string> used_attribute_values;
     auto attrs_to_get = calculate_attrs_to_get(request, used_attribute_names, select);
 
+    // A scan which started serially, before the table's tag was set, continues serially.
+    if (parallelism > 1 && (scan_cursors || !exclusive_start_key)) {
+        filter filter(request, filter::request_type::SCAN, used_attribute_names, used_attribute_values);
+        verify_all_are_used(request, "ExpressionAttributeNames", used_attribute_names, "Scan");
+        verify_all_are_used(request, "ExpressionAttributeValues", used_attribute_values, "Scan");
+        auto ranges = segment ? split_range_for_segment(*segment, *total_segments, parallelism) : split_range_for_segment(0, 1, parallelism);
+        auto cursors = scan_cursors ? decode_scan_cursors(*scan_cursors, ranges, schema) : std::vector<scan_cursor>(parallelism);
+        return do_parallel_scan(_proxy, schema, std::move(ranges), std::move(cursors), std::move(attrs_to_get), limit, cl,
+                std::move(filter), client_state, _stats.cql_stats, std::move(trace_state), std::move(permit));
+    }
+
     dht::partition_range_vector partition_ranges;
     if (segment) {
         auto range = get_range_for_segment(*segment, *total_segments);
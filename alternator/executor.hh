@@ -13,6 +13,8 @@
 #include "seastarx.hh"
 #include <seastar/json/json_elements.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/core/lowres_clock.hh>
 
 #include "service/migration_manager.hh"
 #include "service/client_state.hh"
@@ -70,6 +72,12 @@ struct make_jsonable : public json::jsonable {
  */ 
 json::json_return_type make_streamed(rjson::value&&);
 
+/**
+ * Make return type for the object, streamed if it is big enough
+ * to need a large contiguous string otherwise.
+ */
+json::json_return_type make_streamed_if_big(rjson::value&&);
+
 struct json_string : public json::jsonable {
     std::string _value;
 public:
@@ -161,6 +169,12 @@ class executor : public peering_sharded_service<executor> {
     // An smp_service_group to be used for limiting the concurrency when
     // forwarding Alternator request between shards - if necessary for LWT.
     smp_service_group _ssg;
+    // The timestamp of the current CDC generation, which GetRecords needs to
+    // find out if a shard it read to the end is closed. A consumer polls every
+    // shard of a stream, so the timestamp is cached for a while instead of
+    // being read from system_distributed by each empty poll.
+    std::optional<shared_future<db_clock::time_point>> _cdc_generation_timestamp;
+    lowres_clock::time_point _cdc_generation_timestamp_expiry;
 
 public:
     using client_state = service::client_state;
@@ -214,6 +228,8 @@ class executor : public peering_sharded_service<executor> {
 
     static void describe_key_schema(rjson::value& parent, const schema&, std::unordered_map<std::string,std::string> * = nullptr);
     static void describe_key_schema(rjson::value& parent, const schema& schema, std::unordered_map<std::string,std::string>&);
+
+    future<db_clock::time_point> current_cdc_generation_timestamp();
     
 public:
     static std::optional<rjson::value> describe_single_item(schema_ptr,
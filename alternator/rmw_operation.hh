@@ -42,8 +42,13 @@ class rmw_operation : public service::cas_request, public enable_shared_from_thi
     // * The UNSAFE_RMW option does read-modify-write operations as separate
     //   read and write. It is unsafe - concurrent RMW operations are not
     //   isolated at all. This option will likely be removed in the future.
+    // * The LOCAL_LOCK option runs every write operation on the shard of
+    //   the coordinator owning the item's token, under a lock of the item
+    //   held from the read until the write completes. This only isolates
+    //   operations coordinated by the same node, so it is only safe if all
+    //   writes to the table are sent to a single node.
     enum class write_isolation {
-        FORBID_RMW, LWT_ALWAYS, LWT_RMW_ONLY, UNSAFE_RMW
+        FORBID_RMW, LWT_ALWAYS, LWT_RMW_ONLY, UNSAFE_RMW, LOCAL_LOCK
     };
     static constexpr auto WRITE_ISOLATION_TAG_KEY = "system:write_isolation";
 
@@ -109,6 +114,13 @@ class rmw_operation : public service::cas_request, public enable_shared_from_thi
             bool needs_read_before_write,
             stats& stats);
     std::optional<shard_id> shard_for_execute(bool needs_read_before_write);
+private:
+    future<executor::request_return_type> execute_with_local_lock(service::storage_proxy& proxy,
+            service::client_state& client_state,
+            tracing::trace_state_ptr trace_state,
+            service_permit permit,
+            bool needs_read_before_write,
+            stats& stats);
 };
 
 } // namespace alternator
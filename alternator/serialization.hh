@@ -37,6 +37,7 @@ struct type_representation {
 
 inline constexpr std::string_view scylla_paging_region(":scylla:paging:region");
 inline constexpr std::string_view scylla_paging_weight(":scylla:paging:weight");
+inline constexpr std::string_view scylla_parallel_scan(":scylla:parallel_scan");
 
 type_info type_info_from_string(std::string_view type);
 type_representation represent_type(alternator_type atype);
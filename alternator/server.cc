@@ -317,7 +317,7 @@ future<std::string> server::verify_signature(const request& req, const chunked_c
                                                     service = std::move(service),
                                                     user_signature = std::move(user_signature)] (key_cache::value_ptr key_ptr) {
         std::string signature = get_signature(user, *key_ptr, std::string_view(host), req._method,
-                datestamp, signed_headers_str, signed_headers_map, content, region, service, "");
+                datestamp, signed_headers_str, signed_headers_map, content, region, service, "", _signing_key_cache);
 
         if (signature != std::string_view(user_signature)) {
             _key_cache.remove(user);
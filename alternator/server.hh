@@ -36,6 +36,7 @@ class server {
     gms::gossiper& _gossiper;
 
     key_cache _key_cache;
+    signing_key_cache _signing_key_cache;
     bool _enforce_authorization;
     utils::small_vector<std::reference_wrapper<seastar::httpd::http_server>, 2> _enabled_servers;
     gate _pending_requests;
@@ -78,6 +78,7 @@ class stats {
     uint64_t reads_before_write = 0;
     uint64_t write_using_lwt = 0;
     uint64_t shard_bounce_for_lwt = 0;
+    uint64_t write_using_local_lock = 0;
     uint64_t requests_blocked_memory = 0;
     uint64_t requests_shed = 0;
     // CQL-derived stats
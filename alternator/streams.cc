@@ -1003,13 +1003,11 @@ future<executor::request_return_type> executor::get_records(client_state& client
             // will notice end end of shard and not return NextShardIterator.
             rjson::add(ret, "NextShardIterator", next_iter);
             _stats.api_operations.get_records_latency.add(std::chrono::steady_clock::now() - start_time);
-            return make_ready_future<executor::request_return_type>(make_jsonable(std::move(ret)));
+            return make_ready_future<executor::request_return_type>(make_streamed_if_big(std::move(ret)));
         }
 
         // ugh. figure out if we are and end-of-shard
-        auto normal_token_owners = _proxy.get_token_metadata_ptr()->count_normal_token_owners();
-
-        return _sdks.cdc_current_generation_timestamp({ normal_token_owners }).then([this, iter, high_ts, start_time, ret = std::move(ret), nrecords](db_clock::time_point ts) mutable {
+        return current_cdc_generation_timestamp().then([this, iter, high_ts, start_time, ret = std::move(ret)](db_clock::time_point ts) mutable {
             auto& shard = iter.shard;            
 
             if (shard.time < ts && ts < high_ts) {
@@ -1026,15 +1024,29 @@ future<executor::request_return_type> executor::get_records(client_state& client
                 rjson::add(ret, "NextShardIterator", iter);
             }
             _stats.api_operations.get_records_latency.add(std::chrono::steady_clock::now() - start_time);
-            // TODO: determine a better threshold...
-            if (nrecords > 10) {
-                return make_ready_future<executor::request_return_type>(make_streamed(std::move(ret)));
-            }
             return make_ready_future<executor::request_return_type>(make_jsonable(std::move(ret)));
         });
     });
 }
 
+// A stale timestamp is never newer than the current one, as generations
+// only move forward, so it can only delay noticing that a shard was closed,
+// never make an open shard look closed.
+static constexpr auto cdc_generation_timestamp_cache_period = std::chrono::seconds(10);
+
+future<db_clock::time_point> executor::current_cdc_generation_timestamp() {
+    if (!_cdc_generation_timestamp || lowres_clock::now() >= _cdc_generation_timestamp_expiry) {
+        auto normal_token_owners = _proxy.get_token_metadata_ptr()->count_normal_token_owners();
+        _cdc_generation_timestamp_expiry = lowres_clock::now() + cdc_generation_timestamp_cache_period;
+        _cdc_generation_timestamp.emplace(_sdks.cdc_current_generation_timestamp({ normal_token_owners }).handle_exception([this] (std::exception_ptr ep) {
+            // Don't keep the failure, let the next call try again.
+            _cdc_generation_timestamp_expiry = lowres_clock::time_point::min();
+            return make_exception_future<db_clock::time_point>(std::move(ep));
+        }));
+    }
+    return _cdc_generation_timestamp->get_future();
+}
+
 void executor::add_stream_options(const rjson::value& stream_specification, schema_builder& builder, service::storage_proxy& sp) {
     auto stream_enabled = rjson::find(stream_specification, "StreamEnabled");
     if (!stream_enabled || !stream_enabled->IsBool()) {
@@ -14,6 +14,7 @@
 #include <seastar/core/sleep.hh>
 #include <seastar/core/future.hh>
 #include <seastar/core/lowres_clock.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 #include <boost/multiprecision/cpp_int.hpp>
 
@@ -34,6 +35,7 @@
 #include "mutation.hh"
 #include "types.hh"
 #include "types/map.hh"
+#include "types/listlike_partial_deserializing_iterator.hh"
 #include "utils/rjson.hh"
 #include "utils/big_decimal.hh"
 #include "utils/fb_utilities.hh"
@@ -495,16 +497,33 @@ struct scan_ranges_context {
         , column_name(column_name)
         , member(member)
     {
-        // FIXME: don't read the entire items - read only parts of it.
         // We must read the key columns (to be able to delete) and also
-        // the requested attribute. If the requested attribute is a map's
-        // member we may be forced to read the entire map - but it would
-        // be good if we can read only the single item of the map - it
-        // should be possible (and a must for issue #7751!).
+        // the requested attribute, but not the rest of the item. If the
+        // requested attribute is a map's member we are forced to read the
+        // entire map - but it would be good if we can read only the single
+        // item of the map - it should be possible (and a must for issue #7751!).
+        // If the attribute is a key column, we read all the regular columns,
+        // as before, so that rows with no row marker are still found.
         lw_shared_ptr<service::pager::paging_state> paging_state = nullptr;
-        auto regular_columns = boost::copy_range<query::column_id_vector>(
-            s->regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
-        selection = cql3::selection::selection::wildcard(s);
+        const column_definition* cd = s->get_column_definition(column_name);
+        query::column_id_vector regular_columns;
+        if (cd && cd->is_regular()) {
+            regular_columns.push_back(cd->id);
+            // The key columns first, as expire_item() expects.
+            std::vector<const column_definition*> columns;
+            for (const auto& key_column : s->partition_key_columns()) {
+                columns.push_back(&key_column);
+            }
+            for (const auto& key_column : s->clustering_key_columns()) {
+                columns.push_back(&key_column);
+            }
+            columns.push_back(cd);
+            selection = cql3::selection::selection::for_columns(s, std::move(columns));
+        } else {
+            regular_columns = boost::copy_range<query::column_id_vector>(
+                s->regular_columns() | boost::adaptors::transformed([] (const column_definition& cdef) { return cdef.id; }));
+            selection = cql3::selection::selection::wildcard(s);
+        }
         query::partition_slice::option_set opts = selection->get_query_options();
         opts.set<query::partition_slice::option::allow_short_read>();
         // It is important that the scan bypass cache to avoid polluting it:
@@ -525,6 +544,9 @@ struct scan_ranges_context {
     }
 };
 
+// The number of expired items of a page which are deleted in parallel.
+static constexpr size_t max_concurrent_deletions = 16;
+
 // Scan data in a list of token ranges in one table, looking for expired
 // items and deleting them.
 // Because of issue #9167, partition_ranges must have a single partition
@@ -566,12 +588,12 @@ static future<> scan_table_ranges(
         if (!expiration_column) {
             continue;
         }
+        std::vector<const std::vector<bytes_opt>*> expired_rows;
         for (const auto& row : rows) {
             const bytes_opt& cell = row[*expiration_column];
             if (!cell) {
                 continue;
             }
-            auto v = meta[*expiration_column]->type->deserialize(*cell);
             bool expired = false;
             // FIXME: don't recalculate "now" all the time
             auto now = gc_clock::now();
@@ -580,13 +602,15 @@ static future<> scan_table_ranges(
                 // looking for is a member in a map, saved serialized
                 // into bytes using Alternator's serialization (basically
                 // a JSON serialized into bytes)
-                // FIXME: is it possible to find a specific member of a map
-                // without iterating through it like we do here and compare
-                // the key?
-                for (const auto& entry : value_cast<map_type_impl::native_type>(v)) {
-                    std::string attr_name = value_cast<sstring>(entry.first);
-                    if (value_cast<sstring>(entry.first) == *scan_ctx.member) {
-                        bytes value = value_cast<bytes>(entry.second);
+                // The serialized map is walked in place, so that the other
+                // members aren't copied.
+                bytes_view in = *cell;
+                const auto sf = cql_serialization_format::latest();
+                int n = read_collection_size(in, sf);
+                for (int i = 0; i < n; i++) {
+                    bytes_view name = read_collection_value(in, sf);
+                    bytes_view value = read_collection_value(in, sf);
+                    if (std::string_view(reinterpret_cast<const char*>(name.data()), name.size()) == *scan_ctx.member) {
                         rjson::value json = deserialize_item(value);
                         expired = is_expired(json, now);
                         break;
@@ -599,17 +623,20 @@ static future<> scan_table_ranges(
                 // what Alternator uses), but other numeric types can be
                 // supported as well to make this feature more useful in CQL.
                 // Note that kind::decimal is also checked above.
-                big_decimal n = value_cast<big_decimal>(v);
+                big_decimal n = value_cast<big_decimal>(meta[*expiration_column]->type->deserialize(*cell));
                 expired = is_expired(n, now);
             }
             if (expired) {
-                expiration_stats.items_deleted++;
-                // FIXME: maybe don't recalculate new_timestamp() all the time
-                // FIXME: if expire_item() throws on timeout, we need to retry it.
-                auto ts = api::new_timestamp();
-                co_await expire_item(proxy, *scan_ctx.query_state_ptr, row, s, ts);
+                expired_rows.push_back(&row);
             }
         }
+        // Delete the page's expired items in parallel, instead of waiting
+        // for each deletion before sending the next one.
+        // FIXME: if expire_item() throws on timeout, we need to retry it.
+        co_await max_concurrent_for_each(expired_rows, max_concurrent_deletions, [&] (const std::vector<bytes_opt>* row) {
+            expiration_stats.items_deleted++;
+            return expire_item(proxy, *scan_ctx.query_state_ptr, *row, s, api::new_timestamp());
+        });
         // FIXME: once in a while, persist p->state(), so on reboot
         // we don't start from scratch.
     }
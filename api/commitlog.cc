@@ -8,6 +8,7 @@
 
 #include "commitlog.hh"
 #include "db/commitlog/commitlog.hh"
+#include "db/commitlog/commitlog_replayer.hh"
 #include "api/api-doc/commitlog.json.hh"
 #include "replica/database.hh"
 #include <vector>
@@ -63,4 +64,50 @@ void set_commitlog(http_context& ctx, routes& r) {
     });
 }
 
+// Registered before the rest of the commitlog API, so that the replay can be followed while the node starts.
+void set_commitlog_replay(http_context& ctx, routes& r) {
+    httpd::commitlog_json::get_replay_progress.set(r, [&ctx](std::unique_ptr<request> req) {
+        using progress = db::commitlog_replayer::progress;
+        return ctx.db.map_reduce0([](replica::database&) {
+            return db::commitlog_replayer::get_progress();
+        }, progress(), [] (progress a, const progress& b) {
+            if (b.started == lowres_clock::time_point()) {
+                return a;
+            }
+            if (a.started == lowres_clock::time_point()) {
+                return b;
+            }
+            a.total_bytes += b.total_bytes;
+            a.replayed_bytes += b.replayed_bytes;
+            a.applied_mutations += b.applied_mutations;
+            a.started = std::min(a.started, b.started);
+            a.finished = std::max(a.finished, b.finished);
+            a.in_progress |= b.in_progress;
+            return a;
+        }).then([](const progress& p) {
+            httpd::commitlog_json::replay_progress res;
+            res.in_progress = p.in_progress;
+            res.total_bytes = p.total_bytes;
+            res.replayed_bytes = p.replayed_bytes;
+            res.applied_mutations = p.applied_mutations;
+            int64_t elapsed_ms = 0;
+            if (p.started != lowres_clock::time_point()) {
+                auto end = p.in_progress ? lowres_clock::now() : p.finished;
+                elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end - p.started).count();
+            }
+            res.elapsed_ms = elapsed_ms;
+            uint64_t bytes_per_second = elapsed_ms > 0 ? p.replayed_bytes * 1000 / elapsed_ms : 0;
+            res.bytes_per_second = bytes_per_second;
+            auto remaining = p.total_bytes - std::min(p.replayed_bytes, p.total_bytes);
+            // Unknown (-1) until something was replayed.
+            int64_t eta_ms = 0;
+            if (p.in_progress) {
+                eta_ms = bytes_per_second ? int64_t(remaining * 1000 / bytes_per_second) : -1;
+            }
+            res.eta_ms = eta_ms;
+            return make_ready_future<json::json_return_type>(res);
+        });
+    });
+}
+
 }
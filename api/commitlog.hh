@@ -13,5 +13,6 @@
 namespace api {
 
 void set_commitlog(http_context& ctx, routes& r);
+void set_commitlog_replay(http_context& ctx, routes& r);
 
 }
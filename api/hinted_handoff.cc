@@ -93,11 +93,15 @@ void set_hinted_handoff(http_context& ctx, routes& r, gms::gossiper& g) {
         });
     });
 
-    hh::list_endpoints_pending_hints.set(r, [] (std::unique_ptr<request> req) {
-        //TBD
-        unimplemented();
-        std::vector<sstring> res;
-        return make_ready_future<json::json_return_type>(res);
+    hh::list_endpoints_pending_hints.set(r, [&ctx] (std::unique_ptr<request> req) {
+        return ctx.sp.local().get_endpoints_with_pending_hints().then([] (std::vector<gms::inet_address> eps) {
+            std::vector<sstring> res;
+            res.reserve(eps.size());
+            for (auto& ep : eps) {
+                res.push_back(ep.to_sstring());
+            }
+            return json::json_return_type(res);
+        });
     });
 
     hh::truncate_all_hints.set(r, [] (std::unique_ptr<request> req) {
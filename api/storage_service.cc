@@ -46,6 +46,7 @@
 #include "locator/abstract_replication_strategy.hh"
 #include "sstables_loader.hh"
 #include "db/view/view_builder.hh"
+#include "tracing/trace_ring_buffer_helper.hh"
 
 extern logging::logger apilog;
 
@@ -251,7 +252,7 @@ void set_repair(http_context& ctx, routes& r, sharded<repair_service>& repair) {
     ss::repair_async.set(r, [&ctx, &repair](std::unique_ptr<request> req) {
         static std::vector<sstring> options = {"primaryRange", "parallelism", "incremental",
                 "jobThreads", "ranges", "columnFamilies", "dataCenters", "hosts", "ignore_nodes", "trace",
-                "startToken", "endToken" };
+                "startToken", "endToken", "tombstone_ranges_only" };
         std::unordered_map<sstring, sstring> options_map;
         for (auto o : options) {
             auto s = req->get_query_param(o);
@@ -370,10 +371,35 @@ void set_sstables_loader(http_context& ctx, routes& r, sharded<sstables_loader>&
             return make_ready_future<json::json_return_type>(json_void());
         });
     });
+
+    ss::get_load_and_stream_progress.set(r, [&sst_loader] (std::unique_ptr<request> req) -> future<json::json_return_type> {
+        auto p = co_await sst_loader.map_reduce0([] (sstables_loader& loader) {
+            return loader.get_progress();
+        }, sstables_loader::progress{}, [] (sstables_loader::progress a, const sstables_loader::progress& b) {
+            // Shards without sstables to load don't count for the start time.
+            if (b.sstables_total && (!a.sstables_total || b.start_time < a.start_time)) {
+                a.start_time = b.start_time;
+            }
+            a.sstables_total += b.sstables_total;
+            a.sstables_processed += b.sstables_processed;
+            a.partitions_processed += b.partitions_processed;
+            a.bytes_processed += b.bytes_processed;
+            return a;
+        });
+        ss::load_and_stream_progress res;
+        res.sstables_total = p.sstables_total;
+        res.sstables_processed = p.sstables_processed;
+        res.partitions_processed = p.partitions_processed;
+        res.bytes_processed = p.bytes_processed;
+        double duration = p.sstables_total ? std::chrono::duration<double>(std::chrono::steady_clock::now() - p.start_time).count() : 0;
+        res.bytes_per_second = duration > 0 ? p.bytes_processed / duration : 0;
+        co_return res;
+    });
 }
 
 void unset_sstables_loader(http_context& ctx, routes& r) {
     ss::load_new_ss_tables.unset(r);
+    ss::get_load_and_stream_progress.unset(r);
 }
 
 void set_view_builder(http_context& ctx, routes& r, sharded<db::view::view_builder>& vb) {
@@ -688,6 +714,17 @@ void set_storage_service(http_context& ctx, routes& r, sharded<service::storage_
         });
     }));
 
+    ss::garbage_collect_sstables.set(r, wrap_ks_cf(ctx, [] (http_context& ctx, std::unique_ptr<request> req, sstring keyspace, std::vector<sstring> column_families) -> future<json::json_return_type> {
+        co_await ctx.db.invoke_on_all([&] (replica::database& db) {
+            return do_for_each(column_families, [&] (sstring cfname) {
+                auto& cm = db.get_compaction_manager();
+                auto& cf = db.find_column_family(keyspace, cfname);
+                return cm.perform_garbage_collection(cf.as_table_state()).discard_result();
+            });
+        });
+        co_return json_void();
+    }));
+
     ss::force_keyspace_flush.set(r, [&ctx](std::unique_ptr<request> req) -> future<json::json_return_type> {
         auto keyspace = validate_keyspace(ctx, req->param);
         auto column_families = parse_tables(keyspace, ctx, req->query_parameters, "cf");
@@ -996,6 +1033,42 @@ void set_storage_service(http_context& ctx, routes& r, sharded<service::storage_
         return make_ready_future<json::json_return_type>(tracing::tracing::get_local_tracing_instance().get_trace_probability());
     });
 
+    ss::get_recent_traced_sessions.set(r, [](std::unique_ptr<request> req) -> future<json::json_return_type> {
+        using sessions_list = std::vector<ss::traced_session>;
+        auto sessions = co_await tracing::tracing::tracing_instance().map_reduce0([] (tracing::tracing& local_tracing) {
+            sessions_list res;
+            auto* helper = local_tracing.started() ? dynamic_cast<tracing::trace_ring_buffer_helper*>(&local_tracing.backend_helper()) : nullptr;
+            if (!helper) {
+                return res;
+            }
+            res.reserve(helper->sessions().size());
+            for (const auto& s : helper->sessions()) {
+                ss::traced_session ts;
+                ts.session_id = s.session_id.to_sstring();
+                ts.parent_id = s.parent_id.get_id();
+                ts.span_id = s.my_span_id.get_id();
+                ts.shard = this_shard_id();
+                ts.command = tracing::type_to_string(s.command);
+                ts.client = s.client.to_sstring();
+                ts.started_at = std::chrono::duration_cast<std::chrono::microseconds>(s.started_at.time_since_epoch()).count();
+                ts.duration = s.duration_us;
+                ts.request = s.request;
+                for (const auto& e : s.events) {
+                    ss::traced_event te;
+                    te.elapsed = e.elapsed_us;
+                    te.activity = e.message;
+                    ts.events.push(std::move(te));
+                }
+                res.push_back(std::move(ts));
+            }
+            return res;
+        }, sessions_list{}, [] (sessions_list a, sessions_list b) {
+            std::move(b.begin(), b.end(), std::back_inserter(a));
+            return a;
+        });
+        co_return json::json_return_type(std::move(sessions));
+    });
+
     ss::get_slow_query_info.set(r, [](const_req req) {
         ss::slow_query_info res;
         res.enable = tracing::tracing::get_local_tracing_instance().slow_query_tracing_enabled();
@@ -10,9 +10,11 @@
 #include "api/api.hh"
 
 #include <seastar/core/reactor.hh>
+#include <seastar/core/coroutine.hh>
 #include <seastar/http/exception.hh>
 #include "log.hh"
 #include "replica/database.hh"
+#include "utils/code_region.hh"
 
 extern logging::logger apilog;
 
@@ -61,6 +63,31 @@ void set_system(http_context& ctx, routes& r) {
         return json::json_void();
     });
 
+    hs::get_stall_sites.set(r, [&ctx](std::unique_ptr<request> req) -> future<json::json_return_type> {
+        using sites_list = std::vector<hs::stall_site>;
+        auto sites = co_await ctx.db.map_reduce0([] (replica::database&) {
+            sites_list res;
+            for (const auto& s : utils::code_region_stats::local().sites()) {
+                hs::stall_site ss;
+                ss.shard = this_shard_id();
+                ss.region = utils::to_string(s->region);
+                ss.scheduling_group = s->sg.name();
+                ss.runs = s->runs;
+                ss.stalls = s->stalls;
+                ss.max_runtime = std::chrono::duration_cast<std::chrono::microseconds>(s->max_runtime).count();
+                res.push_back(std::move(ss));
+            }
+            return res;
+        }, sites_list{}, [] (sites_list a, sites_list b) {
+            std::move(b.begin(), b.end(), std::back_inserter(a));
+            return a;
+        });
+        std::sort(sites.begin(), sites.end(), [] (const hs::stall_site& a, const hs::stall_site& b) {
+            return std::make_pair(a.stalls(), a.max_runtime()) > std::make_pair(b.stalls(), b.max_runtime());
+        });
+        co_return json::json_return_type(std::move(sites));
+    });
+
     hs::drop_sstable_caches.set(r, [&ctx](std::unique_ptr<request> req) {
         apilog.info("Dropping sstable caches");
         return ctx.db.invoke_on_all([] (replica::database& db) {
@@ -17,6 +17,7 @@
 #include <optional>
 
 #include <boost/algorithm/cxx11/all_of.hpp>
+#include <gnutls/crypto.h>
 #include <seastar/core/seastar.hh>
 
 #include "auth/authenticated_user.hh"
@@ -57,6 +58,47 @@ password_authenticator::password_authenticator(cql3::query_processor& qp, ::serv
     : _qp(qp)
     , _migration_manager(mm)
     , _stopped(make_ready_future<>()) {
+    std::random_device rd;
+    std::uniform_int_distribution<unsigned> dist(0, 255);
+    for (auto& b : _password_digest_key) {
+        b = dist(rd);
+    }
+}
+
+// How long a verified password is remembered, and how many of them are.
+static constexpr auto verified_password_validity = std::chrono::seconds(60);
+static constexpr size_t max_verified_passwords = 1024;
+
+password_authenticator::password_digest password_authenticator::digest_password(const sstring& password) const {
+    password_digest digest;
+    int ret = gnutls_hmac_fast(GNUTLS_MAC_SHA256, _password_digest_key.data(), _password_digest_key.size(), password.data(), password.size(), digest.data());
+    if (ret) {
+        throw std::system_error(ret, std::generic_category(), format("Computing HMAC failed: {}", gnutls_strerror(ret)));
+    }
+    return digest;
+}
+
+bool password_authenticator::check_password(const sstring& username, const sstring& password, const sstring& salted_hash) const {
+    auto now = lowres_clock::now();
+    auto digest = digest_password(password);
+    auto it = _verified_passwords.find(username);
+    if (it != _verified_passwords.end()) {
+        if (it->second.expiry > now && it->second.salted_hash == salted_hash && it->second.digest == digest) {
+            return true;
+        }
+        _verified_passwords.erase(it);
+    }
+    if (!passwords::check(password, salted_hash)) {
+        return false;
+    }
+    if (_verified_passwords.size() >= max_verified_passwords) {
+        std::erase_if(_verified_passwords, [now] (const auto& e) { return e.second.expiry <= now; });
+        if (_verified_passwords.size() >= max_verified_passwords) {
+            _verified_passwords.clear();
+        }
+    }
+    _verified_passwords.emplace(username, verified_password{salted_hash, digest, now + verified_password_validity});
+    return true;
 }
 
 static bool has_salted_hash(const cql3::untyped_result_set_row& row) {
@@ -219,7 +261,7 @@ future<authenticated_user> password_authenticator::authenticate(
             if (!res->empty()) {
                 salted_hash = res->one().get_opt<sstring>(SALTED_HASH);
             }
-            if (!salted_hash || !passwords::check(password, *salted_hash)) {
+            if (!salted_hash || !check_password(username, password, *salted_hash)) {
                 throw exceptions::authentication_exception("Username and/or password are incorrect");
             }
             return make_ready_future<authenticated_user>(username);
@@ -10,7 +10,11 @@
 
 #pragma once
 
+#include <array>
+#include <unordered_map>
+
 #include <seastar/core/abort_source.hh>
+#include <seastar/core/lowres_clock.hh>
 
 #include "auth/authenticator.hh"
 
@@ -29,10 +33,27 @@ namespace auth {
 extern const std::string_view password_authenticator_name;
 
 class password_authenticator : public authenticator {
+    using password_digest = std::array<uint8_t, 32>;
+
+    // A password which was recently checked against a role's salted hash.
+    struct verified_password {
+        sstring salted_hash;
+        // HMAC of the password with _password_digest_key, so the password itself isn't kept.
+        password_digest digest;
+        lowres_clock::time_point expiry;
+    };
+
     cql3::query_processor& _qp;
     ::service::migration_manager& _migration_manager;
     future<> _stopped;
     seastar::abort_source _as;
+    // Hashing a password is slow by design, and clients reconnecting all at once
+    // would make the shard hash the same passwords over and over. Passwords which
+    // matched the salted hash of their role are remembered for a short while, so
+    // a new connection only hashes its password if the role's salted hash changed
+    // since, or if the password differs.
+    mutable std::unordered_map<sstring, verified_password> _verified_passwords;
+    password_digest _password_digest_key;
 
 public:
     static db::consistency_level consistency_for_user(std::string_view role_name);
@@ -68,6 +89,10 @@ class password_authenticator : public authenticator {
     virtual ::shared_ptr<sasl_challenge> new_sasl_challenge() const override;
 
 private:
+    password_digest digest_password(const sstring& password) const;
+
+    bool check_password(const sstring& username, const sstring& password, const sstring& salted_hash) const;
+
     bool legacy_metadata_exists() const;
 
     future<> migrate_legacy_metadata() const;
@@ -29,6 +29,12 @@ void permissions_cache::reset() {
     _cache.reset();
 }
 
+void permissions_cache::remove(const role_set& roles, const std::optional<resource>& r) {
+    _cache.remove_if([&] (const key_type& k, const permission_set&) {
+        return k.first.name && roles.contains(*k.first.name) && (!r || k.second == *r);
+    });
+}
+
 future<permission_set> permissions_cache::get(const role_or_anonymous& maybe_role, const resource& r) {
     return do_with(key_type(maybe_role, r), [this](const auto& k) {
         return _cache.get(k);
@@ -22,6 +22,7 @@
 #include "auth/authenticated_user.hh"
 #include "auth/permission.hh"
 #include "auth/resource.hh"
+#include "auth/role_manager.hh"
 #include "auth/role_or_anonymous.hh"
 #include "log.hh"
 #include "utils/hash.hh"
@@ -66,6 +67,8 @@ class permissions_cache final {
 
     bool update_config(utils::loading_cache_config);
     void reset();
+    // Removes the permissions of the given roles, on the given resource or on all of them.
+    void remove(const role_set& roles, const std::optional<resource>& r);
     future<permission_set> get(const role_or_anonymous&, const resource&);
 };
 
@@ -201,11 +201,37 @@ void service::update_cache_config() {
     }
 }
 
-void service::reset_authorization_cache() {
+void service::reset_authorization_cache() const {
     _permissions_cache->reset();
     _qp.reset_cache();
 }
 
+future<> service::invalidate_authorization_caches(std::string_view role_name, std::optional<resource> r) const {
+    auto roles = co_await get_dependent_roles(role_name);
+    co_await invalidate_authorization_caches(std::move(roles), std::move(r));
+}
+
+future<> service::invalidate_authorization_caches(role_set roles, std::optional<resource> r) const {
+    co_await smp::invoke_on_all([&c = container(), &roles, &r] {
+        auto& s = c.local();
+        s._permissions_cache->remove(roles, r);
+        // Statements are authorized against several resources, so those
+        // authorized for the roles are dropped whatever the resource.
+        s._qp.remove_authorized_statements_of(roles);
+    });
+}
+
+future<role_set> service::get_dependent_roles(std::string_view role_name) const {
+    const sstring name(role_name);
+    role_set dependents{name};
+    for (const auto& role : co_await _role_manager->query_all()) {
+        if (role != name && (co_await get_roles(role)).contains(name)) {
+            dependents.insert(role);
+        }
+    }
+    co_return dependents;
+}
+
 future<bool> service::has_existing_legacy_users() const {
     if (!_qp.db().has_schema(meta::AUTH_KS, meta::USERS_CF)) {
         return make_ready_future<bool>(false);
@@ -455,24 +481,32 @@ future<> alter_role(
                 ser.underlying_authenticator().supported_options()).then([&ser, name, &options] {
             return ser.underlying_authenticator().alter(name, options);
         });
+    }).then([&ser, name] {
+        // The role may have become, or stopped being, a superuser.
+        return ser.invalidate_authorization_caches(name);
     });
 }
 
 future<> drop_role(const service& ser, std::string_view name) {
-    return do_with(make_role_resource(name), [&ser, name](const resource& r) {
-        auto& a = ser.underlying_authorizer();
-
-        return when_all_succeed(
-                a.revoke_all(name),
-                a.revoke_all(r))
-                    .discard_result()
-                    .handle_exception_type([](const unsupported_authorization_operation&) {
-            // Nothing.
+    // The roles granted the dropped one can't be found once it's gone.
+    return ser.get_dependent_roles(name).then([&ser, name] (role_set dependents) {
+        return do_with(make_role_resource(name), [&ser, name](const resource& r) {
+            auto& a = ser.underlying_authorizer();
+
+            return when_all_succeed(
+                    a.revoke_all(name),
+                    a.revoke_all(r))
+                        .discard_result()
+                        .handle_exception_type([](const unsupported_authorization_operation&) {
+                // Nothing.
+            });
+        }).then([&ser, name] {
+            return ser.underlying_authenticator().drop(name);
+        }).then([&ser, name] {
+            return ser.underlying_role_manager().drop(name);
+        }).then([&ser, dependents = std::move(dependents)] () mutable {
+            return ser.invalidate_authorization_caches(std::move(dependents));
         });
-    }).then([&ser, name] {
-        return ser.underlying_authenticator().drop(name);
-    }).then([&ser, name] {
-        return ser.underlying_role_manager().drop(name);
     });
 }
 
@@ -498,6 +532,8 @@ future<> grant_permissions(
         const resource& r) {
     return validate_role_exists(ser, role_name).then([&ser, role_name, perms, &r] {
         return ser.underlying_authorizer().grant(role_name, perms, r);
+    }).then([&ser, role_name, &r] {
+        return ser.invalidate_authorization_caches(role_name, r);
     });
 }
 
@@ -519,6 +555,8 @@ future<> revoke_permissions(
         const resource& r) {
     return validate_role_exists(ser, role_name).then([&ser, role_name, perms, &r] {
         return ser.underlying_authorizer().revoke(role_name, perms, r);
+    }).then([&ser, role_name, &r] {
+        return ser.invalidate_authorization_caches(role_name, r);
     });
 }
 
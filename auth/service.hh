@@ -120,7 +120,27 @@ class service final : public seastar::peering_sharded_service<service> {
 
     void update_cache_config();
 
-    void reset_authorization_cache();
+    void reset_authorization_cache() const;
+
+    ///
+    /// Drop what the authorization caches of all shards hold for the roles whose permissions depend on the named
+    /// one, after its roles or permissions were changed through this node. If a resource is given, only the
+    /// permissions on that resource changed, and only those are dropped from the permissions cache.
+    ///
+    /// The change then applies to the following requests to this node. Other nodes apply it once their cached
+    /// permissions are refreshed.
+    ///
+    future<> invalidate_authorization_caches(std::string_view role_name, std::optional<resource> r = {}) const;
+
+    ///
+    /// Like the above, for roles found with \ref get_dependent_roles() already.
+    ///
+    future<> invalidate_authorization_caches(role_set roles, std::optional<resource> r = {}) const;
+
+    ///
+    /// \returns the named role and all the roles which are granted it, directly or not.
+    ///
+    future<role_set> get_dependent_roles(std::string_view role_name) const;
 
     ///
     /// \returns an exceptional future with \ref nonexistant_role if the named role does not exist.
@@ -11,10 +11,13 @@
 #include <seastar/core/timer.hh>
 #include <seastar/core/gate.hh>
 #include <seastar/core/file.hh>
+#include <seastar/core/lowres_clock.hh>
 #include <chrono>
 #include <cmath>
 
 #include "seastarx.hh"
+#include "db/view/view_update_backlog.hh"
+#include "utils/updateable_value.hh"
 
 // Simple proportional controller to adjust shares for processes for which a backlog can be clearly
 // defined.
@@ -125,11 +128,28 @@ class flush_controller : public backlog_controller {
     {}
 };
 
+// Compaction CPU controller.
+//
+// The shares given by the backlog are further scaled by a throttle, driven by the pressure of foreground
+// reads: the ratio of their observed load to its objective. When the objective is breached (pressure
+// above 1), the throttle is decreased multiplicatively, down to min_read_throttle. When reads have
+// headroom, it is increased additively, up to 1, where the backlog alone determines the shares.
 class compaction_controller : public backlog_controller {
 public:
     static constexpr unsigned normalization_factor = 30;
     static constexpr float disable_backlog = std::numeric_limits<double>::infinity();
     static constexpr float backlog_disabled(float backlog) { return std::isinf(backlog); }
+
+    static constexpr float min_read_throttle = 0.1f;
+    static constexpr float read_throttle_decrease = 0.75f;
+    static constexpr float read_throttle_increase = 0.05f;
+    static constexpr float read_pressure_headroom = 0.75f;
+private:
+    std::function<float()> _read_pressure;
+    float _read_throttle = 1.0f;
+protected:
+    virtual void update_controller(float shares) override;
+public:
     compaction_controller(backlog_controller::scheduling_group sg, float static_shares, std::chrono::milliseconds interval, std::function<float()> current_backlog)
         : backlog_controller(std::move(sg), std::move(interval),
           std::vector<backlog_controller::control_point>({{0.0, 50}, {1.5, 100} , {normalization_factor, 1000}}),
@@ -137,4 +157,88 @@ class compaction_controller : public backlog_controller {
           static_shares
         )
     {}
+
+    void set_read_pressure(std::function<float()> read_pressure) {
+        _read_pressure = std::move(read_pressure);
+    }
+
+    float read_throttle() const noexcept {
+        return _read_throttle;
+    }
+
+    // Adjusts the throttle to the given read pressure, as done at every adjustment of the controller.
+    void update_read_throttle(float pressure) noexcept;
+};
+
+// Predictive write throttle.
+//
+// The dirty memory manager only blocks writes once virtual dirty memory reaches its hard limit, so
+// clients which outpace flushes see no backpressure at all until latency falls off a cliff. This
+// throttle instead computes a pressure, between 0 and 1, from which writes can be delayed
+// proportionally, well before the hard limit is reached.
+//
+// Every interval, virtual dirty memory is projected `horizon` ahead at its recent rate of change,
+// which is the rate at which writes dirty memory minus the rate at which flushes release it. The
+// pressure grows linearly from 0 when the projection is at the soft limit to 1 when it reaches the
+// hard limit. A falling rate, when flushes outpace writes, lowers the pressure even above the soft
+// limit.
+//
+// Compaction debt is accounted for separately: once the normalized compaction backlog is beyond the
+// point where the compaction controller gives compaction maximum shares, compaction can't catch up
+// by itself, so the pressure grows linearly up to 1 at twice that backlog.
+class write_throttle {
+public:
+    using clock_type = seastar::lowres_clock;
+    struct config {
+        size_t soft_limit;
+        size_t hard_limit;
+        // 0 disables the throttle.
+        utils::updateable_value<uint32_t> horizon_in_ms;
+    };
+    static constexpr float compaction_backlog_start = compaction_controller::normalization_factor;
+    static constexpr float compaction_backlog_limit = 2 * compaction_controller::normalization_factor;
+    // Weight of the latest sample in the smoothed rate of change of dirty memory.
+    static constexpr double rate_smoothing = 0.25;
+private:
+    config _cfg;
+    std::function<size_t()> _dirty_memory;
+    std::function<float()> _compaction_backlog;
+    timer<clock_type> _update_timer;
+    clock_type::time_point _last_update;
+    size_t _last_dirty = 0;
+    // In bytes per second.
+    double _dirty_rate = 0;
+    float _pressure = 0;
+public:
+    write_throttle(config cfg, std::chrono::milliseconds interval, std::function<size_t()> dirty_memory, std::function<float()> compaction_backlog)
+        : _cfg(std::move(cfg))
+        , _dirty_memory(std::move(dirty_memory))
+        , _compaction_backlog(std::move(compaction_backlog))
+        , _update_timer([this] { update(clock_type::now()); })
+        , _last_update(clock_type::now())
+        , _last_dirty(_dirty_memory())
+    {
+        _update_timer.arm_periodic(interval);
+    }
+
+    void shutdown() noexcept {
+        _update_timer.cancel();
+    }
+
+    // Takes a sample of dirty memory and compaction backlog at `now`.
+    void update(clock_type::time_point now);
+
+    float pressure() const noexcept {
+        return _pressure;
+    }
+
+    double dirty_rate() const noexcept {
+        return _dirty_rate;
+    }
+
+    // The pressure, as a backlog which coordinators delay responses to writes by.
+    db::view::update_backlog backlog() const noexcept {
+        constexpr size_t scale = 1'000'000;
+        return {size_t(_pressure * scale), scale};
+    }
 };
@@ -12,12 +12,20 @@
 #include "exceptions/exceptions.hh"
 #include "utils/rjson.hh"
 
-caching_options::caching_options(sstring k, sstring r, bool enabled)
-        : _key_cache(k), _row_cache(r), _enabled(enabled) {
+caching_options::caching_options(sstring k, sstring r, bool enabled, uint64_t max_memory_in_mb, uint64_t reserved_memory_in_mb,
+        uint64_t results_ttl_in_ms)
+        : _key_cache(k), _row_cache(r), _enabled(enabled)
+        , _max_memory_in_mb(max_memory_in_mb), _reserved_memory_in_mb(reserved_memory_in_mb)
+        , _results_ttl_in_ms(results_ttl_in_ms) {
     if ((k != "ALL") && (k != "NONE")) {
         throw exceptions::configuration_exception("Invalid key value: " + k); 
     }
 
+    if (max_memory_in_mb && reserved_memory_in_mb > max_memory_in_mb) {
+        throw exceptions::configuration_exception(format("reserved_memory_in_mb ({}) must not be greater than max_memory_in_mb ({})",
+                reserved_memory_in_mb, max_memory_in_mb));
+    }
+
     if ((r == "ALL") || (r == "NONE")) {
         return;
     } else {
@@ -40,6 +48,15 @@ caching_options::to_map() const {
     if (!_enabled) {
         res.insert({"enabled", "false"});
     }
+    if (_max_memory_in_mb) {
+        res.insert({"max_memory_in_mb", std::to_string(_max_memory_in_mb)});
+    }
+    if (_reserved_memory_in_mb) {
+        res.insert({"reserved_memory_in_mb", std::to_string(_reserved_memory_in_mb)});
+    }
+    if (_results_ttl_in_ms) {
+        res.insert({"results_ttl_in_ms", std::to_string(_results_ttl_in_ms)});
+    }
     return res;
 }
 
@@ -58,6 +75,17 @@ caching_options::from_map(const std::map<sstring, sstring>& map) {
     sstring k = default_key;
     sstring r = default_row;
     bool e = true;
+    uint64_t max_memory = 0;
+    uint64_t reserved_memory = 0;
+    uint64_t results_ttl = 0;
+
+    auto parse_number = [] (const std::pair<const sstring, sstring>& p) {
+        try {
+            return boost::lexical_cast<uint64_t>(p.second);
+        } catch (boost::bad_lexical_cast& e) {
+            throw exceptions::configuration_exception(format("Invalid value for caching option {}: {}", p.first, p.second));
+        }
+    };
 
     for (auto& p : map) {
         if (p.first == "keys") {
@@ -66,11 +94,17 @@ caching_options::from_map(const std::map<sstring, sstring>& map) {
             r = p.second;
         } else if (p.first == "enabled") {
             e = p.second == "true";
+        } else if (p.first == "max_memory_in_mb") {
+            max_memory = parse_number(p);
+        } else if (p.first == "reserved_memory_in_mb") {
+            reserved_memory = parse_number(p);
+        } else if (p.first == "results_ttl_in_ms") {
+            results_ttl = parse_number(p);
         } else {
             throw exceptions::configuration_exception(format("Invalid caching option: {}", p.first));
         }
     }
-    return caching_options(k, r, e);
+    return caching_options(k, r, e, max_memory, reserved_memory, results_ttl);
 }
 
 caching_options
@@ -81,7 +115,9 @@ caching_options::from_sstring(const sstring& str) {
 bool
 caching_options::operator==(const caching_options& other) const {
     return _key_cache == other._key_cache && _row_cache == other._row_cache
-        && _enabled == other._enabled;
+        && _enabled == other._enabled
+        && _max_memory_in_mb == other._max_memory_in_mb && _reserved_memory_in_mb == other._reserved_memory_in_mb
+        && _results_ttl_in_ms == other._results_ttl_in_ms;
 }
 
 bool
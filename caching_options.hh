@@ -9,6 +9,7 @@
 #pragma once
 #include <seastar/core/sstring.hh>
 #include <map>
+#include <chrono>
 #include "seastarx.hh"
 
 class schema;
@@ -25,7 +26,15 @@ class caching_options {
     sstring _key_cache;
     sstring _row_cache;
     bool _enabled = true;
-    caching_options(sstring k, sstring r, bool enabled);
+    // Cache memory bounds of the table, 0 if not bounded. A bounded table
+    // is cached separately from other tables, see cache_tracker::set_memory_limits().
+    uint64_t _max_memory_in_mb = 0;
+    uint64_t _reserved_memory_in_mb = 0;
+    // How long coordinators may serve results of SELECTs from their
+    // result cache, 0 if results are not cached, see cql3::select_result_cache.
+    uint64_t _results_ttl_in_ms = 0;
+    caching_options(sstring k, sstring r, bool enabled, uint64_t max_memory_in_mb = 0, uint64_t reserved_memory_in_mb = 0,
+            uint64_t results_ttl_in_ms = 0);
 
     friend class schema;
     caching_options();
@@ -34,6 +43,26 @@ class caching_options {
         return _enabled;
     }
 
+    // The cache of the table is not allowed to grow above this, 0 if unlimited.
+    uint64_t max_memory() const {
+        return _max_memory_in_mb << 20;
+    }
+
+    // The cache of the table is not evicted to make room for other tables below this.
+    uint64_t reserved_memory() const {
+        return _reserved_memory_in_mb << 20;
+    }
+
+    bool has_memory_bounds() const {
+        return _max_memory_in_mb || _reserved_memory_in_mb;
+    }
+
+    // Results of SELECTs on the table may be served from the coordinator's
+    // result cache for up to this long, 0 if they are not cached.
+    std::chrono::milliseconds results_ttl() const {
+        return std::chrono::milliseconds(_results_ttl_in_ms);
+    }
+
     std::map<sstring, sstring> to_map() const;
 
     sstring to_sstring() const;
@@ -13,6 +13,8 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <seastar/core/thread.hh>
 #include <seastar/core/metrics.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/core/later.hh>
 
 #include "cdc/log.hh"
 #include "cdc/generation.hh"
@@ -37,6 +39,7 @@
 #include "utils/UUID_gen.hh"
 #include "utils/managed_bytes.hh"
 #include "utils/fragment_range.hh"
+#include "utils/joinable_batches.hh"
 #include "types.hh"
 #include "concrete_types.hh"
 #include "types/listlike_partial_deserializing_iterator.hh"
@@ -60,6 +63,34 @@ logging::logger cdc_log("cdc");
 
 namespace cdc {
 static schema_ptr create_log_schema(const schema&, std::optional<utils::UUID> = {}, schema_ptr = nullptr);
+
+// A preimage select about to be sent, which the selects of the same rows
+// of the partition issued meanwhile wait for instead of sending their own.
+struct preimage_select_batch {
+    schema_ptr schema;
+    dht::decorated_key key;
+    lw_shared_ptr<query::read_command> command;
+    db::consistency_level cl;
+    shared_promise<lw_shared_ptr<cql3::untyped_result_set>> result;
+
+    bool matches(const schema& s, const dht::decorated_key& k, const query::read_command& cmd, db::consistency_level c) const {
+        const auto& slice = command->slice;
+        const auto& other = cmd.slice;
+        const auto ck_cmp = clustering_key_prefix::prefix_equal_tri_compare(s);
+        return schema->version() == s.version()
+                && cl == c
+                && key.equal(s, k)
+                && command->get_row_limit() == cmd.get_row_limit()
+                && slice.static_columns == other.static_columns
+                && slice.regular_columns == other.regular_columns
+                && slice.options.mask() == other.options.mask()
+                && std::ranges::equal(slice.default_row_ranges(), other.default_row_ranges(), [&] (const auto& a, const auto& b) {
+                    return a.equal(b, ck_cmp);
+                });
+    }
+};
+
+using preimage_select_batches = utils::joinable_batches<dht::token, preimage_select_batch>;
 }
 
 static constexpr auto cdc_group_name = "cdc";
@@ -116,6 +147,12 @@ cdc::stats::stats() {
     };
     register_counters(counters_total, "total");
     register_counters(counters_failed, "failed");
+
+    _metrics.add_group(cdc_group_name, {
+            sm::make_total_operations("preimage_selects_coalesced", preimage_selects_coalesced,
+                    sm::description("number of preimage queries which used the result of an identical query sent for a concurrent operation"),
+                    {})
+        });
 }
 
 cdc::operation_result_tracker::~operation_result_tracker() {
@@ -144,6 +181,7 @@ class cdc::cdc_service::impl : service::migration_listener::empty_listener {
     friend cdc_service;
     db_context _ctxt;
     bool _stopped = false;
+    preimage_select_batches _preimage_select_batches;
 public:
     impl(db_context ctxt)
         : _ctxt(std::move(ctxt))
@@ -1573,10 +1611,14 @@ class transformer final : public change_processor {
         return db::timeout_clock::now() + 10s;
     }
 
+    // If batches is not null, the select is sent after the tasks which are ready
+    // to run have run, and other selects of the same rows of the partition
+    // issued meanwhile use its result.
     future<lw_shared_ptr<cql3::untyped_result_set>> pre_image_select(
             service::client_state& client_state,
             db::consistency_level write_cl,
-            const mutation& m)
+            const mutation& m,
+            preimage_select_batches* batches)
     {
         auto& p = m.partition();
         if (p.clustered_rows().empty() && p.static_row().empty()) {
@@ -1659,18 +1701,49 @@ class transformer final : public change_processor {
 
         const auto select_cl = adjust_cl(write_cl);
 
-      try {
-        return _ctx._proxy.query(_schema, std::move(command), std::move(partition_ranges), select_cl, service::storage_proxy::coordinator_query_options(default_timeout(), empty_service_permit(), client_state)).then(
-                [s = _schema, partition_slice = std::move(partition_slice), selection = std::move(selection)] (service::storage_proxy::coordinator_query_result qr) -> lw_shared_ptr<cql3::untyped_result_set> {
-            return make_lw_shared<cql3::untyped_result_set>(*s, std::move(qr.query_result), *selection, partition_slice);
+        // Doesn't refer to the transformer, which is moved while the select waits.
+        auto select = [&proxy = _ctx._proxy, s = _schema, &client_state, command, partition_ranges = std::move(partition_ranges), select_cl,
+                partition_slice = std::move(partition_slice), selection = std::move(selection)] () mutable {
+          try {
+            return proxy.query(s, std::move(command), std::move(partition_ranges), select_cl, service::storage_proxy::coordinator_query_options(default_timeout(), empty_service_permit(), client_state)).then(
+                    [s, partition_slice = std::move(partition_slice), selection = std::move(selection)] (service::storage_proxy::coordinator_query_result qr) -> lw_shared_ptr<cql3::untyped_result_set> {
+                return make_lw_shared<cql3::untyped_result_set>(*s, std::move(qr.query_result), *selection, partition_slice);
+            });
+          } catch (exceptions::unavailable_exception& e) {
+            // `query` can throw `unavailable_exception`, which is seen by clients as ~ "NoHostAvailable". 
+            // So, we'll translate it to a `read_failure_exception` with custom message.
+            cdc_log.debug("Preimage: translating a (read) `unavailable_exception` to `request_execution_exception` - {}", e);
+            throw exceptions::read_failure_exception("CDC preimage query could not achieve the CL.",
+                    e.consistency, e.alive, 0, e.required, false);
+          }
+        };
+        if (!batches) {
+            return select();
+        }
+
+        // The select waits for the writes which are ready to run, so its result
+        // is as recent as the result of the select of any write joining it.
+        auto joined = batches->find(m.token(), [&] (const preimage_select_batch& b) {
+            return b.matches(*_schema, m.decorated_key(), *command, select_cl);
+        });
+        if (joined) {
+            ++_ctx._proxy.get_cdc_stats().preimage_selects_coalesced;
+            return joined->result.get_shared_future();
+        }
+        auto batch = make_lw_shared<preimage_select_batch>(_schema, m.decorated_key(), command, select_cl);
+        return yield().then([registration = batches->add(m.token(), batch), select = std::move(select)] () mutable {
+            registration.release();
+            return futurize_invoke(select);
+        }).then_wrapped([batch] (future<lw_shared_ptr<cql3::untyped_result_set>> f) {
+            if (f.failed()) {
+                auto ex = f.get_exception();
+                batch->result.set_exception(ex);
+                return make_exception_future<lw_shared_ptr<cql3::untyped_result_set>>(std::move(ex));
+            }
+            auto rs = f.get0();
+            batch->result.set_value(rs);
+            return make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>(std::move(rs));
         });
-      } catch (exceptions::unavailable_exception& e) {
-        // `query` can throw `unavailable_exception`, which is seen by clients as ~ "NoHostAvailable". 
-        // So, we'll translate it to a `read_failure_exception` with custom message.
-        cdc_log.debug("Preimage: translating a (read) `unavailable_exception` to `request_execution_exception` - {}", e);
-        throw exceptions::read_failure_exception("CDC preimage query could not achieve the CL.",
-                e.consistency, e.alive, 0, e.required, false);
-      }
     }
 
     // Note: this assumes that the results are from one partition only
@@ -1775,11 +1848,9 @@ cdc::cdc_service::impl::augment_mutation_call(lowres_clock::time_point timeout,
 
             auto f = make_ready_future<lw_shared_ptr<cql3::untyped_result_set>>(nullptr);
             if (s->cdc_options().preimage() || s->cdc_options().postimage()) {
-                // Note: further improvement here would be to coalesce the pre-image selects into one
-                // iff a batch contains several modifications to the same table. Otoh, batch is rare(?)
-                // so this is premature.
                 tracing::trace(tr_state, "CDC: Selecting preimage for {}", m.decorated_key());
-                f = trans.pre_image_select(qs.get_client_state(), write_cl, m).then_wrapped([this] (future<lw_shared_ptr<cql3::untyped_result_set>> f) {
+                auto batches = _ctxt._proxy.get_db().local().get_config().cdc_coalesce_preimage_selects() ? &_preimage_select_batches : nullptr;
+                f = trans.pre_image_select(qs.get_client_state(), write_cl, m, batches).then_wrapped([this] (future<lw_shared_ptr<cql3::untyped_result_set>> f) {
                     auto& cdc_stats = _ctxt._proxy.get_cdc_stats();
                     cdc_stats.counters_total.preimage_selects++;
                     if (f.failed()) {
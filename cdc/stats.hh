@@ -72,6 +72,9 @@ class stats final {
 
     counters counters_total;
     counters counters_failed;
+    // Preimage selects which waited for the result of an identical select
+    // instead of being sent.
+    uint64_t preimage_selects_coalesced = 0;
 
     stats();
 };
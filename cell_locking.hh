@@ -417,7 +417,11 @@ struct cell_locker::locker {
 
     future<> lock_all() {
         // Cannot defer before first call to lock_next().
-        return lock_next().then([this] {
+        auto f = lock_next();
+        if (f.available() && is_done()) {
+            return f;
+        }
+        return f.then([this] {
             return do_until([this] { return is_done(); }, [this] {
                 return lock_next();
             });
@@ -466,6 +470,11 @@ future<std::vector<locked_cell>> cell_locker::lock_cells(const dht::decorated_ke
 
     auto l = std::make_unique<locker>(*_schema, _stats, *it, std::move(range), timeout);
     auto f = l->lock_all();
+    if (f.available() && !f.failed()) {
+        // None of the cells was locked by someone else.
+        f.get();
+        return make_ready_future<std::vector<locked_cell>>(std::move(*l).get());
+    }
     return f.then([l = std::move(l)] {
         return std::move(*l).get();
     });
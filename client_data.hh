@@ -45,6 +45,8 @@ struct client_data {
     std::optional<bool> ssl_enabled;
     std::optional<sstring> ssl_protocol;
     std::optional<sstring> username;
+    /// Number of requests for partitions owned by another shard than shard_id.
+    std::optional<int64_t> requests_for_other_shards;
 
     sstring stage_str() const { return to_string(connection_stage); }
     sstring client_type_str() const { return to_string(ct); }
@@ -301,7 +301,105 @@ merge(collection_mutation_view_description a, collection_mutation_view_descripti
     return merged;
 }
 
+namespace {
+
+// What merge() needs to know about a serialized collection mutation to decide
+// whether its cells can be copied over as they are.
+struct serialized_collection_summary {
+    tombstone tomb;
+    uint32_t count;
+    // The serialized cells, as they follow the header.
+    managed_bytes_view cells;
+    managed_bytes_view first_key;
+    managed_bytes_view last_key;
+    api::timestamp_type min_timestamp = api::max_timestamp;
+};
+
+serialized_collection_summary summarize(const abstract_type& type, managed_bytes_view in) {
+    serialized_collection_summary ret;
+    auto has_tomb = read_simple<uint8_t>(in);
+    if (has_tomb) {
+        auto ts = read_simple<api::timestamp_type>(in);
+        auto ttl = read_simple<gc_clock::duration::rep>(in);
+        ret.tomb = tombstone{ts, gc_clock::time_point(gc_clock::duration(ttl))};
+    }
+    ret.count = read_simple<uint32_t>(in);
+    ret.cells = in;
+    for (uint32_t i = 0; i != ret.count; ++i) {
+        auto ksize = read_simple<uint32_t>(in);
+        auto key = ::read_simple_bytes(in, ksize);
+        if (i == 0) {
+            ret.first_key = key;
+        }
+        ret.last_key = key;
+        auto vsize = read_simple<uint32_t>(in);
+        auto value = atomic_cell_view::from_bytes(type, ::read_simple_bytes(in, vsize));
+        ret.min_timestamp = std::min(ret.min_timestamp, value.timestamp());
+    }
+    return ret;
+}
+
+// Merges a and b without deserializing them if their keys don't overlap and
+// neither tombstone kills a cell of the other side, which is the common case
+// of appending to a list or adding new keys to a map or a set. The cells are
+// then copied as they are, lower keys first, and the result is the same as
+// the one of the general merge.
+template <typename C>
+requires std::is_base_of_v<abstract_type, std::remove_reference_t<C>>
+std::optional<collection_mutation>
+try_concatenate(const abstract_type& type, collection_mutation_view a, collection_mutation_view b, C&& key_type) {
+    auto sa = summarize(type, a.data);
+    auto sb = summarize(type, b.data);
+    // Same rule as cell_killed() in the general merge.
+    if ((sa.count && sb.tomb.timestamp >= sa.min_timestamp)
+            || (sb.count && sa.tomb.timestamp >= sb.min_timestamp)) {
+        return std::nullopt;
+    }
+    auto* lo = &sa;
+    auto* hi = &sb;
+    if (sa.count && sb.count) {
+        if (key_type.compare(sb.last_key, sa.first_key) < 0) {
+            std::swap(lo, hi);
+        } else if (key_type.compare(sa.last_key, sb.first_key) >= 0) {
+            return std::nullopt;
+        }
+    }
+
+    auto tomb = std::max(sa.tomb, sb.tomb);
+    size_t size = 1 + 4 + lo->cells.size() + hi->cells.size();
+    if (tomb) {
+        size += sizeof(int64_t) + sizeof(int64_t);
+    }
+    managed_bytes ret(managed_bytes::initialized_later(), size);
+    managed_bytes_mutable_view out(ret);
+    write<uint8_t>(out, uint8_t(bool(tomb)));
+    if (tomb) {
+        write<int64_t>(out, tomb.timestamp);
+        write<int64_t>(out, tomb.deletion_time.time_since_epoch().count());
+    }
+    write<int32_t>(out, lo->count + hi->count);
+    write_fragmented(out, lo->cells);
+    write_fragmented(out, hi->cells);
+    return collection_mutation(type, std::move(ret));
+}
+
+} // anonymous namespace
+
 collection_mutation merge(const abstract_type& type, collection_mutation_view a, collection_mutation_view b) {
+    auto concatenated = visit(type, make_visitor(
+    [&] (const collection_type_impl& ctype) {
+        return try_concatenate(type, a, b, *ctype.name_comparator());
+    },
+    [&] (const user_type_impl& utype) {
+        return try_concatenate(type, a, b, *short_type);
+    },
+    [] (const abstract_type& o) -> std::optional<collection_mutation> {
+        throw std::runtime_error(format("collection_mutation merge: unknown type: {}", o.name()));
+    }
+    ));
+    if (concatenated) {
+        return std::move(*concatenated);
+    }
     return a.with_deserialized(type, [&] (collection_mutation_view_description a_view) {
         return b.with_deserialized(type, [&] (collection_mutation_view_description b_view) {
             return visit(type, make_visitor(
@@ -19,12 +19,14 @@
 #include <boost/range/algorithm.hpp>
 #include <boost/range/adaptors.hpp>
 #include <boost/range/join.hpp>
+#include <boost/range/irange.hpp>
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/algorithm/string/join.hpp>
 
 #include <seastar/core/future-util.hh>
 #include <seastar/core/scheduling.hh>
 #include <seastar/core/coroutine.hh>
+#include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/util/closeable.hh>
 #include <seastar/core/shared_ptr.hh>
 
@@ -50,6 +52,8 @@
 #include "utils/fmt-compat.hh"
 #include "utils/error_injection.hh"
 #include "readers/filtering.hh"
+#include "readers/multi_range.hh"
+#include "readers/mutation_source.hh"
 #include "readers/compacting.hh"
 #include "tombstone_gc.hh"
 
@@ -70,6 +74,7 @@ static const std::unordered_map<compaction_type, sstring> compaction_types = {
     { compaction_type::Reshard, "RESHARD" },
     { compaction_type::Upgrade, "UPGRADE" },
     { compaction_type::Reshape, "RESHAPE" },
+    { compaction_type::GarbageCollect, "GARBAGE_COLLECT" },
 };
 
 sstring compaction_name(compaction_type type) {
@@ -99,6 +104,7 @@ std::string_view to_string(compaction_type type) {
     case compaction_type::Reshard: return "Reshard";
     case compaction_type::Upgrade: return "Upgrade";
     case compaction_type::Reshape: return "Reshape";
+    case compaction_type::GarbageCollect: return "GarbageCollect";
     }
     on_internal_error_noexcept(clogger, format("Invalid compaction type {}", int(type)));
     return "(invalid)";
@@ -443,12 +449,16 @@ class compaction {
     sstables::compaction_type _type;
     uint64_t _max_sstable_size;
     uint32_t _sstable_level;
+    // Output is repaired only if all input is, as of the oldest repair.
+    uint64_t _repaired_at = 0;
     uint64_t _start_size = 0;
     uint64_t _end_size = 0;
     uint64_t _estimated_partitions = 0;
     db::replay_position _rp;
     encoding_stats_collector _stats_collector;
     bool _contains_multi_fragment_runs = false;
+    // Set if no two input sstables overlap.
+    bool _disjoint_input = false;
     mutation_source_metadata _ms_metadata = {};
     compaction_sstable_replacer_fn _replacer;
     utils::UUID _run_identifier;
@@ -463,6 +473,7 @@ class compaction {
     // Garbage collected sstables that were added to SSTable set and should be eventually removed from it.
     std::vector<shared_sstable> _used_garbage_collected_sstables;
     utils::observable<> _stop_request_observable;
+    std::optional<dht::partition_range> _partition_range;
 private:
     compaction_data& init_compaction_data(compaction_data& cdata, const compaction_descriptor& descriptor) const {
         cdata.compaction_fan_in = descriptor.fan_in();
@@ -485,10 +496,17 @@ class compaction {
         , _sstable_set(std::move(descriptor.all_sstables_snapshot))
         , _selector(_sstable_set ? _sstable_set->make_incremental_selector() : std::optional<sstable_set::incremental_selector>{})
         , _compacting_for_max_purgeable_func(std::unordered_set<shared_sstable>(_sstables.begin(), _sstables.end()))
+        , _partition_range(std::move(descriptor.partition_range))
     {
         for (auto& sst : _sstables) {
             _stats_collector.update(sst->get_encoding_stats_for_compaction());
         }
+        if (!_sstables.empty()) {
+            _repaired_at = std::numeric_limits<uint64_t>::max();
+            for (auto& sst : _sstables) {
+                _repaired_at = std::min(_repaired_at, sst->get_repaired_at());
+            }
+        }
         std::unordered_set<utils::UUID> ssts_run_ids;
         _contains_multi_fragment_runs = std::any_of(_sstables.begin(), _sstables.end(), [&ssts_run_ids] (shared_sstable& sst) {
             return !ssts_run_ids.insert(sst->run_identifier()).second;
@@ -530,6 +548,7 @@ class compaction {
         cfg.run_identifier = _run_identifier;
         cfg.replay_position = _rp;
         cfg.sstable_level = _sstable_level;
+        cfg.repaired_at = _repaired_at;
         return cfg;
     }
 
@@ -601,7 +620,11 @@ class compaction {
     }
 
     bool enable_garbage_collected_sstable_writer() const noexcept {
-        return _contains_multi_fragment_runs && _max_sstable_size != std::numeric_limits<uint64_t>::max();
+        return _contains_multi_fragment_runs && _max_sstable_size != std::numeric_limits<uint64_t>::max() && !_partition_range;
+    }
+
+    const dht::partition_range& input_range() const noexcept {
+        return _partition_range ? *_partition_range : query::full_partition_range;
     }
 public:
     compaction& operator=(const compaction&) = delete;
@@ -668,11 +691,39 @@ class compaction {
         }
 
         _compacting = std::move(ssts);
+        _disjoint_input = is_disjoint(*_compacting->all());
 
         _ms_metadata.min_timestamp = timestamp_tracker.min();
         _ms_metadata.max_timestamp = timestamp_tracker.max();
     }
 
+    bool is_disjoint(const sstable_list& sstables) const {
+        auto sorted = std::vector<shared_sstable>(sstables.begin(), sstables.end());
+        std::sort(sorted.begin(), sorted.end(), [this] (const shared_sstable& a, const shared_sstable& b) {
+            return a->get_first_decorated_key().tri_compare(*_schema, b->get_first_decorated_key()) < 0;
+        });
+        for (size_t i = 1; i < sorted.size(); i++) {
+            if (sorted[i]->get_first_decorated_key().tri_compare(*_schema, sorted[i - 1]->get_last_decorated_key()) <= 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Every partition of disjoint input comes from a single sstable, so there is
+    // nothing to merge, and partitions are written out without going through the
+    // mutation compactor.
+    future<> consume_disjoint_input() {
+        auto consumer = make_interposer_consumer([this] (flat_mutation_reader_v2 reader) mutable {
+            return seastar::async([this, reader = std::move(reader)] () mutable {
+                auto close_reader = deferred_close(reader);
+                auto cfc = compacted_fragments_writer(get_compacted_fragments_writer());
+                reader.consume_in_thread(std::move(cfc));
+            });
+        });
+        return consumer(make_sstable_reader());
+    }
+
     // This consumer will perform mutation compaction on producer side using
     // compacting_reader. It's useful for allowing data from different buckets
     // to be compacted together.
@@ -689,6 +740,10 @@ class compaction {
 
     future<> consume() {
         auto now = gc_clock::now();
+        if (_disjoint_input && can_copy_disjoint_input()) {
+            log_debug("Input sstables are disjoint, copying partitions without compacting them");
+            return consume_disjoint_input();
+        }
         // consume_without_gc_writer(), which uses compacting_reader, is ~3% slower.
         // let's only use it when GC writer is disabled and interposer consumer is enabled, as we
         // wouldn't like others to pay the penalty for something they don't need.
@@ -728,6 +783,12 @@ class compaction {
     virtual bool use_interposer_consumer() const {
         return _table_s.get_compaction_strategy().use_interposer_consumer();
     }
+
+    // Compactions which only reshape their input, without purging anything, can
+    // copy partitions as they are when the input is disjoint.
+    virtual bool can_copy_disjoint_input() const {
+        return false;
+    }
 protected:
     virtual compaction_result finish(std::chrono::time_point<db_clock> started_at, std::chrono::time_point<db_clock> ended_at) {
         compaction_result ret {
@@ -904,6 +965,10 @@ class reshape_compaction : public compaction {
         return sstables::make_partitioned_sstable_set(_schema, false);
     }
 
+    bool can_copy_disjoint_input() const override {
+        return true;
+    }
+
     flat_mutation_reader_v2 make_sstable_reader() const override {
         return _compacting->make_local_shard_sstable_reader(_schema,
                 _permit,
@@ -943,6 +1008,18 @@ class regular_compaction : public compaction {
     // keeps track of monitors for input sstable, which are responsible for adjusting backlog as compaction progresses.
     mutable compaction_read_monitor_generator _monitor_generator;
     seastar::semaphore _replacer_lock = {1};
+protected:
+    flat_mutation_reader_v2 make_input_reader(const dht::partition_range& range, mutation_reader::forwarding fwd_mr) const {
+        return _compacting->make_local_shard_sstable_reader(_schema,
+                _permit,
+                range,
+                _schema->full_slice(),
+                _io_priority,
+                tracing::trace_state_ptr(),
+                ::streamed_mutation::forwarding::no,
+                fwd_mr,
+                _monitor_generator);
+    }
 public:
     regular_compaction(table_state& table_s, compaction_descriptor descriptor, compaction_data& cdata)
         : compaction(table_s, std::move(descriptor), cdata)
@@ -951,15 +1028,7 @@ class regular_compaction : public compaction {
     }
 
     flat_mutation_reader_v2 make_sstable_reader() const override {
-        return _compacting->make_local_shard_sstable_reader(_schema,
-                _permit,
-                query::full_partition_range,
-                _schema->full_slice(),
-                _io_priority,
-                tracing::trace_state_ptr(),
-                ::streamed_mutation::forwarding::no,
-                ::mutation_reader::forwarding::no,
-                _monitor_generator);
+        return make_input_reader(input_range(), ::mutation_reader::forwarding::no);
     }
 
     std::string_view report_start_desc() const override {
@@ -1095,6 +1164,7 @@ class cleanup_compaction final : public regular_compaction {
     };
 
     owned_ranges_ptr _owned_ranges;
+    dht::partition_range_vector _owned_partition_ranges;
     incremental_owned_ranges_checker _owned_ranges_checker;
 private:
     // Called in a seastar thread
@@ -1135,6 +1205,7 @@ class cleanup_compaction final : public regular_compaction {
     cleanup_compaction(table_state& table_s, compaction_descriptor descriptor, compaction_data& cdata, owned_ranges_ptr owned_ranges)
         : regular_compaction(table_s, std::move(descriptor), cdata)
         , _owned_ranges(std::move(owned_ranges))
+        , _owned_partition_ranges(dht::to_partition_ranges(*_owned_ranges))
         , _owned_ranges_checker(*_owned_ranges)
     {
     }
@@ -1145,8 +1216,16 @@ class cleanup_compaction final : public regular_compaction {
     cleanup_compaction(table_state& table_s, compaction_descriptor descriptor, compaction_data& cdata, compaction_type_options::upgrade opts)
         : cleanup_compaction(table_s, std::move(descriptor), cdata, std::move(opts.owned_ranges)) {}
 
+    // Reads only the owned ranges, so the index is used to skip over the unowned data
+    // instead of reading it just to filter it out.
     flat_mutation_reader_v2 make_sstable_reader() const override {
-        return make_filtering_reader(regular_compaction::make_sstable_reader(), make_partition_filter());
+        auto source = mutation_source([this] (schema_ptr, reader_permit, const dht::partition_range& range, const query::partition_slice&,
+                const io_priority_class&, tracing::trace_state_ptr, streamed_mutation::forwarding, mutation_reader::forwarding fwd_mr) {
+            return make_input_reader(range, fwd_mr);
+        });
+        auto reader = make_flat_multi_range_reader(_schema, _permit, std::move(source), _owned_partition_ranges, _schema->full_slice(), _io_priority,
+                tracing::trace_state_ptr(), ::mutation_reader::forwarding::no);
+        return make_filtering_reader(std::move(reader), make_partition_filter());
     }
 
     std::string_view report_start_desc() const override {
@@ -1173,6 +1252,22 @@ class cleanup_compaction final : public regular_compaction {
     }
 };
 
+class garbage_collect_compaction final : public regular_compaction {
+public:
+    garbage_collect_compaction(table_state& table_s, compaction_descriptor descriptor, compaction_data& cdata)
+        : regular_compaction(table_s, std::move(descriptor), cdata)
+    {
+    }
+
+    std::string_view report_start_desc() const override {
+        return "Garbage collecting";
+    }
+
+    std::string_view report_finish_desc() const override {
+        return "Garbage collected";
+    }
+};
+
 class scrub_compaction final : public regular_compaction {
 public:
     static void report_invalid_partition(compaction_type type, mutation_fragment_stream_validator& validator, const dht::decorated_key& new_key,
@@ -1562,6 +1657,10 @@ class resharding_compaction final : public compaction {
         return true;
     }
 
+    bool can_copy_disjoint_input() const override {
+        return true;
+    }
+
     std::string_view report_start_desc() const override {
         return "Resharding";
     }
@@ -1615,6 +1714,7 @@ compaction_type compaction_type_options::type() const {
         compaction_type::Scrub,
         compaction_type::Reshard,
         compaction_type::Reshape,
+        compaction_type::GarbageCollect,
     };
     static_assert(std::variant_size_v<compaction_type_options::options_variant> == std::size(index_to_type));
     return index_to_type[_options.index()];
@@ -1644,6 +1744,9 @@ static std::unique_ptr<compaction> make_compaction(table_state& table_s, sstable
         std::unique_ptr<compaction> operator()(compaction_type_options::scrub scrub_options) {
             return std::make_unique<scrub_compaction>(table_s, std::move(descriptor), cdata, scrub_options);
         }
+        std::unique_ptr<compaction> operator()(compaction_type_options::garbage_collect) {
+            return std::make_unique<garbage_collect_compaction>(table_s, std::move(descriptor), cdata);
+        }
     } visitor_factory{table_s, std::move(descriptor), cdata};
 
     return descriptor.options.visit(visitor_factory);
@@ -1737,12 +1840,82 @@ static future<compaction_result> scrub_sstables_validate_mode(sstables::compacti
     };
 }
 
+dht::partition_range_vector split_token_ring(unsigned count) {
+    dht::token_range_vector ranges;
+    ranges.reserve(count);
+    const uint64_t step = std::numeric_limits<uint64_t>::max() / count;
+    auto split_point = [step] (unsigned i) {
+        return dht::token::from_int64(int64_t(uint64_t(std::numeric_limits<int64_t>::min()) + i * step));
+    };
+    for (unsigned i = 0; i < count; ++i) {
+        auto start = i == 0 ? std::nullopt : std::make_optional(dht::token_range::bound(split_point(i), false));
+        auto end = i == count - 1 ? std::nullopt : std::make_optional(dht::token_range::bound(split_point(i + 1), true));
+        ranges.emplace_back(std::move(start), std::move(end));
+    }
+    return dht::to_partition_ranges(ranges);
+}
+
+// Runs a regular compaction as descriptor.parallelism concurrent compactions of token sub-ranges
+// of the input, and replaces the input by their combined output once all of them are done.
+static future<compaction_result> compact_sstables_in_parallel(sstables::compaction_descriptor descriptor, compaction_data& cdata, table_state& table_s) {
+    auto ranges = split_token_ring(descriptor.parallelism);
+    auto replacer = std::move(descriptor.replacer);
+    cdata.compaction_fan_in = descriptor.fan_in();
+
+    std::vector<compaction_data> sub_cdata(ranges.size());
+    auto stop_subscription = cdata.abort.subscribe([&] () noexcept {
+        for (auto& c : sub_cdata) {
+            c.stop(cdata.stop_requested);
+        }
+    });
+
+    compaction_result result;
+    std::exception_ptr ex;
+    co_await coroutine::parallel_for_each(boost::irange(size_t(0), ranges.size()), [&] (size_t i) -> future<> {
+        auto sub_descriptor = descriptor;
+        sub_descriptor.partition_range = ranges[i];
+        sub_descriptor.parallelism = 1;
+        sub_descriptor.replacer = [] (compaction_completion_desc) {};
+        try {
+            auto res = co_await compaction::run(make_compaction(table_s, std::move(sub_descriptor), sub_cdata[i]));
+            result.new_sstables.insert(result.new_sstables.end(), res.new_sstables.begin(), res.new_sstables.end());
+            result.stats += res.stats;
+        } catch (...) {
+            if (!ex) {
+                ex = std::current_exception();
+            }
+            for (auto& c : sub_cdata) {
+                c.stop("sibling sub-range compaction failed");
+            }
+        }
+    });
+    for (auto& c : sub_cdata) {
+        cdata.total_partitions += c.total_partitions;
+        cdata.total_keys_written += c.total_keys_written;
+    }
+    if (ex) {
+        // Output of the sub-ranges which did complete is not a replacement for the input.
+        for (auto& sst : result.new_sstables) {
+            sst->mark_for_deletion();
+        }
+        std::rethrow_exception(ex);
+    }
+
+    co_await seastar::async([&] {
+        replacer(compaction_completion_desc{descriptor.sstables, result.new_sstables});
+    });
+    co_return result;
+}
+
 future<compaction_result>
 compact_sstables(sstables::compaction_descriptor descriptor, compaction_data& cdata, table_state& table_s) {
     if (descriptor.sstables.empty()) {
         return make_exception_future<compaction_result>(std::runtime_error(format("Called {} compaction with empty set on behalf of {}.{}",
                 compaction_name(descriptor.options.type()), table_s.schema()->ks_name(), table_s.schema()->cf_name())));
     }
+    if (descriptor.parallelism > 1 && descriptor.options.type() == compaction_type::Compaction && !descriptor.partition_range) {
+        return compact_sstables_in_parallel(std::move(descriptor), cdata, table_s);
+    }
     if (descriptor.options.type() == compaction_type::Scrub
             && std::get<compaction_type_options::scrub>(descriptor.options.options()).operation_mode == compaction_type_options::scrub::mode::validate) {
         // Bypass the usual compaction machinery for dry-mode scrub
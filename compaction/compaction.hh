@@ -119,6 +119,9 @@ struct compaction_result {
 // compaction behavior through its available member fields.
 future<compaction_result> compact_sstables(sstables::compaction_descriptor descriptor, compaction_data& cdata, table_state& table_s);
 
+// Splits the token ring into `count` contiguous sub-ranges of equal width.
+dht::partition_range_vector split_token_ring(unsigned count);
+
 // Return list of expired sstables for column family cf.
 // A sstable is fully expired *iff* its max_local_deletion_time precedes gc_before and its
 // max timestamp is lower than any other relevant sstable.
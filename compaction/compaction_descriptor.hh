@@ -41,6 +41,7 @@ enum class compaction_type {
     Reshard = 5,
     Upgrade = 6,
     Reshape = 7,
+    GarbageCollect = 8,
 };
 
 std::ostream& operator<<(std::ostream& os, compaction_type type);
@@ -89,8 +90,12 @@ class compaction_type_options {
     };
     struct reshape {
     };
+    // Rewrites sstables one at a time, without merging them with each other, purging expired data
+    // and tombstones which don't shadow data in the sstables overlapping with them.
+    struct garbage_collect {
+    };
 private:
-    using options_variant = std::variant<regular, cleanup, upgrade, scrub, reshard, reshape>;
+    using options_variant = std::variant<regular, cleanup, upgrade, scrub, reshard, reshape, garbage_collect>;
 
 private:
     options_variant _options;
@@ -124,6 +129,10 @@ class compaction_type_options {
         return compaction_type_options(scrub{mode});
     }
 
+    static compaction_type_options make_garbage_collect() {
+        return compaction_type_options(garbage_collect{});
+    }
+
     template <typename... Visitor>
     auto visit(Visitor&&... visitor) const {
         return std::visit(std::forward<Visitor>(visitor)..., _options);
@@ -143,6 +152,12 @@ std::ostream& operator<<(std::ostream& os, compaction_type_options::scrub::quara
 class dummy_tag {};
 using has_only_fully_expired = seastar::bool_class<dummy_tag>;
 
+// Storage the output of a compaction is written to.
+enum class storage_tier {
+    hot,  // the table's data directory
+    cold, // the table's cold_dir, for old data which is rarely read
+};
+
 struct compaction_descriptor {
     // List of sstables to be compacted.
     std::vector<sstables::shared_sstable> sstables;
@@ -167,6 +182,21 @@ struct compaction_descriptor {
     // Denotes if this compaction task is comprised solely of completely expired SSTables
     sstables::has_only_fully_expired has_only_fully_expired = has_only_fully_expired::no;
 
+    // Restricts compaction to this range of the input. Output of a range-restricted compaction
+    // is not a replacement for its input, so early replacement of exhausted sstables is disabled.
+    std::optional<dht::partition_range> partition_range;
+
+    // Number of token sub-ranges the compaction is split into, which are compacted concurrently.
+    // The input is replaced by the output of all sub-ranges at once, when all of them are done.
+    // Only regular compaction can be split.
+    unsigned parallelism = 1;
+
+    storage_tier output_tier = storage_tier::hot;
+
+    // Set by reshape when the input only has to be moved to `level`. Callers do that by
+    // rewriting the level in the sstables' statistics instead of compacting them.
+    bool relevel_only = false;
+
     compaction_descriptor() = default;
 
     static constexpr int default_level = 0;
@@ -19,6 +19,7 @@
 #include "locator/abstract_replication_strategy.hh"
 #include "utils/fb_utilities.hh"
 #include "utils/UUID_gen.hh"
+#include "utils/code_region.hh"
 #include <cmath>
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include <boost/range/algorithm/remove_if.hpp>
@@ -327,8 +328,8 @@ future<sstables::compaction_result> compaction_manager::task::compact_sstables(s
     if (can_purge) {
         descriptor.enable_garbage_collection(t.main_sstable_set());
     }
-    descriptor.creator = [&t] (shard_id dummy) {
-        auto sst = t.make_sstable();
+    descriptor.creator = [&t, tier = descriptor.output_tier] (shard_id dummy) {
+        auto sst = tier == sstables::storage_tier::cold ? t.make_cold_sstable() : t.make_sstable();
         return sst;
     };
     descriptor.replacer = [this, &t, release_exhausted] (sstables::compaction_completion_desc desc) {
@@ -376,6 +377,7 @@ class compaction_manager::major_compaction_task : public compaction_manager::tas
         compaction::table_state* t = _compacting_table;
         sstables::compaction_strategy cs = t->get_compaction_strategy();
         sstables::compaction_descriptor descriptor = cs.get_major_compaction_job(*t, _cm.get_candidates(*t));
+        descriptor.parallelism = _cm.major_compaction_parallelism();
         auto compacting = compacting_sstable_registration(_cm, descriptor.sstables);
         auto release_exhausted = [&compacting] (const std::vector<sstables::shared_sstable>& exhausted_sstables) {
             compacting.release_compacting(exhausted_sstables);
@@ -658,6 +660,7 @@ compaction_manager::compaction_manager(config cfg, abort_source& as)
     , _compaction_static_shares_observer(_cfg.static_shares.observe(_update_compaction_static_shares_action.make_observer()))
     , _strategy_control(std::make_unique<strategy_control>(*this))
 {
+    _compaction_controller.set_read_pressure([this] { return read_pressure(); });
     register_metrics();
     // Bandwidth throttling is node-wide, updater is needed on single shard
     if (this_shard_id() == 0) {
@@ -720,9 +723,28 @@ void compaction_manager::register_metrics() {
                        sm::description("Holds the sum of normalized compaction backlog for all tables in the system. Backlog is normalized by dividing backlog by shard's available memory.")),
         sm::make_counter("validation_errors", [this] { return _validation_errors; },
                        sm::description("Holds the number of encountered validation errors.")),
+        sm::make_gauge("read_pressure", [this] { return _last_read_pressure; },
+                       sm::description("Holds the ratio of foreground read load to its objective, as last seen by the compaction controller. Above 1 means the objective is breached.")),
+        sm::make_gauge("read_throttle", [this] { return read_throttle(); },
+                       sm::description("Holds the factor by which the compaction controller scales compaction shares down to meet foreground read objectives.")),
     });
 }
 
+float compaction_manager::read_pressure() {
+    float pressure = 0.0f;
+    if (_foreground_read_load) {
+        auto load = _foreground_read_load();
+        if (auto objective = _cfg.read_latency_objective_us()) {
+            pressure = std::max(pressure, float(load.p99_latency.count()) / objective);
+        }
+        if (auto objective = _cfg.read_queue_length_objective()) {
+            pressure = std::max(pressure, float(load.queue_length) / objective);
+        }
+    }
+    _last_read_pressure = pressure;
+    return pressure;
+}
+
 void compaction_manager::enable() {
     assert(_state == state::none || _state == state::disabled);
     _state = state::enabled;
@@ -942,7 +964,10 @@ class compaction_manager::regular_compaction_task : public compaction_manager::t
 
             compaction::table_state& t = *_compacting_table;
             sstables::compaction_strategy cs = t.get_compaction_strategy();
-            sstables::compaction_descriptor descriptor = cs.get_sstables_for_compaction(t, _cm.get_strategy_control(), _cm.get_candidates(t));
+            sstables::compaction_descriptor descriptor = [&] {
+                utils::code_region_timer region_timer(utils::code_region::compaction);
+                return cs.get_sstables_for_compaction(t, _cm.get_strategy_control(), _cm.get_candidates(t));
+            }();
             int weight = calculate_weight(descriptor);
 
             if (descriptor.sstables.empty() || !can_proceed() || t.is_auto_compaction_disabled_by_user()) {
@@ -1102,6 +1127,14 @@ class compaction_manager::offstrategy_compaction_task : public compaction_manage
 
         std::exception_ptr err;
         while (auto desc = get_next_job()) {
+            if (desc->relevel_only) {
+                // The set is not organized by level, so levels can be changed in place.
+                co_await coroutine::parallel_for_each(desc->sstables, [level = desc->level] (const sstables::shared_sstable& sst) {
+                    return sst->mutate_sstable_level(level);
+                });
+                _performed = true;
+                continue;
+            }
             desc->creator = [this, &new_unused_sstables, &t] (shard_id dummy) {
                 auto sst = t.make_sstable();
                 new_unused_sstables.insert(sst);
@@ -1559,6 +1592,17 @@ future<compaction_manager::compaction_stats_opt> compaction_manager::perform_sst
     }, can_purge_tombstones::no);
 }
 
+future<compaction_manager::compaction_stats_opt> compaction_manager::perform_garbage_collection(compaction::table_state& t) {
+    return rewrite_sstables(t, sstables::compaction_type_options::make_garbage_collect(), [this, &t] {
+        auto compaction_time = gc_clock::now();
+        std::vector<sstables::shared_sstable> sstables = boost::copy_range<std::vector<sstables::shared_sstable>>(get_candidates(t)
+                | boost::adaptors::filtered([compaction_time] (const sstables::shared_sstable& sst) {
+            return sst->estimate_droppable_tombstone_ratio(sst->get_gc_before_for_drop_estimation(compaction_time)) > 0;
+        }));
+        return make_ready_future<std::vector<sstables::shared_sstable>>(std::move(sstables));
+    });
+}
+
 void compaction_manager::add(compaction::table_state& t) {
     auto [_, inserted] = _compaction_state.insert({&t, compaction_state{}});
     if (!inserted) {
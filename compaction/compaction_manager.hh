@@ -24,6 +24,7 @@
 #include "utils/serialized_action.hh"
 #include <vector>
 #include <list>
+#include <unordered_set>
 #include <functional>
 #include <algorithm>
 #include "compaction.hh"
@@ -54,6 +55,17 @@ class compaction_manager {
         size_t available_memory = 0;
         utils::updateable_value<float> static_shares = utils::updateable_value<float>(0);
         utils::updateable_value<uint32_t> throughput_mb_per_sec = utils::updateable_value<uint32_t>(0);
+        utils::updateable_value<uint32_t> major_compaction_parallelism = utils::updateable_value<uint32_t>(1);
+        // Objectives for foreground reads, which the compaction controller lowers compaction shares
+        // to meet. Zero disables the respective objective.
+        utils::updateable_value<uint32_t> read_latency_objective_us = utils::updateable_value<uint32_t>(0);
+        utils::updateable_value<uint32_t> read_queue_length_objective = utils::updateable_value<uint32_t>(0);
+    };
+
+    // Load of foreground reads observed since the previous sample.
+    struct foreground_read_load {
+        std::chrono::microseconds p99_latency{0};
+        size_t queue_length = 0;
     };
 private:
     struct compaction_state {
@@ -252,6 +264,8 @@ class compaction_manager {
     stats _stats;
     seastar::metrics::metric_groups _metrics;
     double _last_backlog = 0.0f;
+    float _last_read_pressure = 0.0f;
+    std::function<foreground_read_load()> _foreground_read_load;
 
     // Store sstables that are being compacted at the moment. That's needed to prevent
     // a sstable from being compacted twice.
@@ -386,8 +400,25 @@ class compaction_manager {
         return _cfg.throughput_mb_per_sec.get();
     }
 
+    uint32_t major_compaction_parallelism() const noexcept {
+        return std::max(_cfg.major_compaction_parallelism.get(), 1u);
+    }
+
     void register_metrics();
 
+    // Sets the source of foreground read load the compaction controller reacts to,
+    // sampled at every controller adjustment. An empty function unsets it.
+    void set_foreground_read_load_source(std::function<foreground_read_load()> source) {
+        _foreground_read_load = std::move(source);
+    }
+
+    // Ratio of the foreground read load to its objectives, the highest one when both are set.
+    float read_pressure();
+
+    float read_throttle() const noexcept {
+        return _compaction_controller.read_throttle();
+    }
+
     // enable the compaction manager.
     void enable();
 
@@ -429,6 +460,13 @@ class compaction_manager {
     // Submit a table to be scrubbed and wait for its termination.
     future<compaction_stats_opt> perform_sstable_scrub(compaction::table_state& t, sstables::compaction_type_options::scrub opts);
 
+    // Submit a table to be garbage collected and wait for its termination.
+    //
+    // Rewrites each sstable which may contain expired data or droppable tombstones on its own,
+    // purging what isn't shadowing data in the sstables overlapping with it. Unlike major
+    // compaction, sstables are not merged with each other.
+    future<compaction_stats_opt> perform_garbage_collection(compaction::table_state& t);
+
     // Submit a table for major compaction.
     future<> perform_major_compaction(compaction::table_state& t);
 
@@ -17,12 +17,14 @@
 #include "compaction_strategy.hh"
 #include "compaction_strategy_impl.hh"
 #include "schema.hh"
+#include "exceptions/exceptions.hh"
 #include "sstables/sstable_set.hh"
 #include <boost/range/algorithm/find.hpp>
 #include <boost/range/algorithm/remove_if.hpp>
 #include <boost/range/adaptors.hpp>
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include "size_tiered_compaction_strategy.hh"
+#include "incremental_compaction_strategy.hh"
 #include "date_tiered_compaction_strategy.hh"
 #include "leveled_compaction_strategy.hh"
 #include "time_window_compaction_strategy.hh"
@@ -65,6 +67,55 @@ bool compaction_strategy_impl::worth_dropping_tombstones(const shared_sstable& s
     return sst->estimate_droppable_tombstone_ratio(gc_before) >= _tombstone_threshold;
 }
 
+std::vector<shared_sstable> compaction_strategy_impl::get_tombstone_dense_range_candidates(const std::vector<shared_sstable>& candidates,
+        gc_clock::time_point compaction_time, size_t max_threshold) {
+    auto droppable_bytes = [compaction_time] (const shared_sstable& sst) {
+        auto gc_before = sst->get_gc_before_for_drop_estimation(compaction_time);
+        return sst->estimate_droppable_tombstone_ratio(gc_before) * sst->data_size();
+    };
+
+    std::vector<shared_sstable> best;
+    double best_density = 0;
+    for (auto& sst : candidates) {
+        if (!worth_dropping_tombstones(sst, compaction_time)) {
+            continue;
+        }
+        const schema& s = *sst->get_schema();
+        auto& first = sst->get_first_decorated_key();
+        auto& last = sst->get_last_decorated_key();
+        auto max_timestamp = sst->get_stats_metadata().max_timestamp;
+
+        // Tombstones can only shadow data older than themselves, so newer sstables don't prevent the purge.
+        std::vector<shared_sstable> overlapping;
+        for (auto& other : candidates) {
+            if (other == sst || other->get_stats_metadata().min_timestamp > max_timestamp) {
+                continue;
+            }
+            if (other->get_first_decorated_key().tri_compare(s, last) <= 0 && other->get_last_decorated_key().tri_compare(s, first) >= 0) {
+                overlapping.push_back(other);
+            }
+        }
+        std::sort(overlapping.begin(), overlapping.end(), [] (const shared_sstable& a, const shared_sstable& b) {
+            return a->get_stats_metadata().min_timestamp < b->get_stats_metadata().min_timestamp;
+        });
+        overlapping.resize(std::min(overlapping.size(), max_threshold > 0 ? max_threshold - 1 : 0));
+
+        double droppable = droppable_bytes(sst);
+        uint64_t total = sst->data_size();
+        for (auto& other : overlapping) {
+            droppable += droppable_bytes(other);
+            total += other->data_size();
+        }
+        auto density = total ? droppable / total : 0.0;
+        if (best.empty() || density > best_density) {
+            best_density = density;
+            best = std::move(overlapping);
+            best.insert(best.begin(), sst);
+        }
+    }
+    return best;
+}
+
 uint64_t compaction_strategy_impl::adjust_partition_estimate(const mutation_source_metadata& ms_meta, uint64_t partition_estimate) {
     return partition_estimate;
 }
@@ -96,6 +147,18 @@ compaction_strategy_impl::compaction_strategy_impl(const std::map<sstring, sstri
     auto interval = property_definitions::to_long(TOMBSTONE_COMPACTION_INTERVAL_OPTION, tmp_value, DEFAULT_TOMBSTONE_COMPACTION_INTERVAL().count());
     _tombstone_compaction_interval = db_clock::duration(std::chrono::seconds(interval));
 
+    tmp_value = get_value(options, TOMBSTONE_COMPACTION_SCOPE_OPTION);
+    if (tmp_value) {
+        if (*tmp_value == "sstable") {
+            _tombstone_compaction_scope = tombstone_compaction_scope::sstable;
+        } else if (*tmp_value == "token_range") {
+            _tombstone_compaction_scope = tombstone_compaction_scope::token_range;
+        } else {
+            throw exceptions::configuration_exception(format("Invalid value {} for {}: must be one of sstable, token_range",
+                    *tmp_value, TOMBSTONE_COMPACTION_SCOPE_OPTION));
+        }
+    }
+
     // FIXME: validate options.
 }
 
@@ -464,7 +527,24 @@ leveled_compaction_strategy::leveled_compaction_strategy(const std::map<sstring,
         , _stcs_options(options)
         , _backlog_tracker(std::make_unique<leveled_compaction_backlog_tracker>(_max_sstable_size_in_mb, _stcs_options))
 {
+    using namespace cql3::statements;
+
     _compaction_counter.resize(leveled_manifest::MAX_LEVELS);
+
+    auto tmp_value = compaction_strategy_impl::get_value(options, DYNAMIC_LEVEL_BYTES_OPTION);
+    if (tmp_value) {
+        if (*tmp_value == "true") {
+            _dynamic_level_bytes = true;
+        } else if (*tmp_value != "false") {
+            throw exceptions::configuration_exception(format("Invalid value {} for {}: must be true or false", *tmp_value, DYNAMIC_LEVEL_BYTES_OPTION));
+        }
+    }
+
+    auto l0_subcompactions = property_definitions::to_int(L0_SUBCOMPACTIONS_OPTION, compaction_strategy_impl::get_value(options, L0_SUBCOMPACTIONS_OPTION), 1);
+    if (l0_subcompactions < 1) {
+        throw exceptions::configuration_exception(format("{} must be at least 1, got {}", L0_SUBCOMPACTIONS_OPTION, l0_subcompactions));
+    }
+    _l0_subcompactions = l0_subcompactions;
 }
 
 int32_t
@@ -757,6 +837,10 @@ bool compaction_strategy::use_interposer_consumer() const {
     return _compaction_strategy_impl->use_interposer_consumer();
 }
 
+reader_consumer_v2 compaction_strategy::make_offstrategy_interposer_consumer(reader_consumer_v2 end_consumer) {
+    return _compaction_strategy_impl->make_offstrategy_interposer_consumer(std::move(end_consumer));
+}
+
 compaction_strategy make_compaction_strategy(compaction_strategy_type strategy, const std::map<sstring, sstring>& options) {
     ::shared_ptr<compaction_strategy_impl> impl;
 
@@ -776,6 +860,9 @@ compaction_strategy make_compaction_strategy(compaction_strategy_type strategy,
     case compaction_strategy_type::time_window:
         impl = ::make_shared<time_window_compaction_strategy>(options);
         break;
+    case compaction_strategy_type::incremental:
+        impl = ::make_shared<incremental_compaction_strategy>(options);
+        break;
     default:
         throw std::runtime_error("strategy not supported");
     }
@@ -75,6 +75,8 @@ class compaction_strategy {
             return "DateTieredCompactionStrategy";
         case compaction_strategy_type::time_window:
             return "TimeWindowCompactionStrategy";
+        case compaction_strategy_type::incremental:
+            return "IncrementalCompactionStrategy";
         default:
             throw std::runtime_error("Invalid Compaction Strategy");
         }
@@ -93,6 +95,8 @@ class compaction_strategy {
             return compaction_strategy_type::date_tiered;
         } else if (short_name == "TimeWindowCompactionStrategy") {
             return compaction_strategy_type::time_window;
+        } else if (short_name == "IncrementalCompactionStrategy") {
+            return compaction_strategy_type::incremental;
         } else {
             throw exceptions::configuration_exception(format("Unable to find compaction strategy class '{}'", name));
         }
@@ -115,6 +119,11 @@ class compaction_strategy {
     // Returns whether or not interposer consumer is used by a given strategy.
     bool use_interposer_consumer() const;
 
+    // Interposer for data which is going to be integrated by off-strategy compaction,
+    // such as data streamed in by node operations. It doesn't segregate the data, that
+    // is left to reshape, but may shape it so that reshape can adopt it as it is.
+    reader_consumer_v2 make_offstrategy_interposer_consumer(reader_consumer_v2 end_consumer);
+
     // Informs the caller (usually the compaction manager) about what would it take for this set of
     // SSTables closer to becoming in-strategy. If this returns an empty compaction descriptor, this
     // means that the sstable set is already in-strategy.
@@ -33,11 +33,22 @@ class compaction_strategy_impl {
 protected:
     const sstring TOMBSTONE_THRESHOLD_OPTION = "tombstone_threshold";
     const sstring TOMBSTONE_COMPACTION_INTERVAL_OPTION = "tombstone_compaction_interval";
+    const sstring TOMBSTONE_COMPACTION_SCOPE_OPTION = "tombstone_compaction_scope";
+
+    // Determines what a tombstone compaction rewrites when no compaction is needed the standard way.
+    // With `sstable`, a single sstable worth dropping tombstones for is rewritten, which cannot purge
+    // tombstones shadowing data in other sstables. With `token_range`, the sstables overlapping with the
+    // most tombstone-dense token range are compacted together.
+    enum class tombstone_compaction_scope {
+        sstable,
+        token_range,
+    };
 
     bool _use_clustering_key_filter = false;
     bool _disable_tombstone_compaction = false;
     float _tombstone_threshold = DEFAULT_TOMBSTONE_THRESHOLD;
     db_clock::duration _tombstone_compaction_interval = DEFAULT_TOMBSTONE_COMPACTION_INTERVAL();
+    tombstone_compaction_scope _tombstone_compaction_scope = tombstone_compaction_scope::sstable;
 public:
     static std::optional<sstring> get_value(const std::map<sstring, sstring>& options, const sstring& name);
 protected:
@@ -69,6 +80,13 @@ class compaction_strategy_impl {
     // droppable tombstone histogram and gc_before.
     bool worth_dropping_tombstones(const shared_sstable& sst, gc_clock::time_point compaction_time);
 
+    // Among the token ranges covered by candidates worth dropping tombstones for, picks the one with
+    // the highest ratio of droppable tombstones to data, accounting for the overlapping candidates which
+    // may contain data shadowed by those tombstones. Returns the sstable covering that range along with
+    // those overlapping candidates, oldest first, at most max_threshold in total.
+    std::vector<shared_sstable> get_tombstone_dense_range_candidates(const std::vector<shared_sstable>& candidates,
+            gc_clock::time_point compaction_time, size_t max_threshold);
+
     virtual compaction_backlog_tracker& get_backlog_tracker() = 0;
 
     virtual uint64_t adjust_partition_estimate(const mutation_source_metadata& ms_meta, uint64_t partition_estimate);
@@ -79,6 +97,10 @@ class compaction_strategy_impl {
         return false;
     }
 
+    virtual reader_consumer_v2 make_offstrategy_interposer_consumer(reader_consumer_v2 end_consumer) {
+        return end_consumer;
+    }
+
     virtual compaction_descriptor get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, const ::io_priority_class& iop, reshape_mode mode);
 };
 }
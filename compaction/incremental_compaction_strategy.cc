@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "incremental_compaction_strategy.hh"
+#include "size_tiered_backlog_tracker.hh"
+#include "exceptions/exceptions.hh"
+
+#include <unordered_map>
+
+#include <boost/range/adaptor/reversed.hpp>
+#include <boost/range/algorithm/min_element.hpp>
+
+namespace sstables {
+
+uint64_t incremental_compaction_strategy::calculate_fragment_size(std::optional<sstring> option_value, const sstring& option_name) {
+    using namespace cql3::statements;
+    auto size_in_mb = property_definitions::to_long(option_name, option_value, DEFAULT_MAX_FRAGMENT_SIZE_IN_MB);
+    if (size_in_mb <= 0) {
+        throw exceptions::configuration_exception(format("{} must be greater than 0, but was {}", option_name, size_in_mb));
+    }
+    return uint64_t(size_in_mb) * 1024 * 1024;
+}
+
+incremental_compaction_strategy::incremental_compaction_strategy(const std::map<sstring, sstring>& options)
+    : compaction_strategy_impl(options)
+    , _fragment_size(calculate_fragment_size(compaction_strategy_impl::get_value(options, FRAGMENT_SIZE_OPTION), FRAGMENT_SIZE_OPTION))
+    , _stcs_options(options)
+    , _backlog_tracker(std::make_unique<size_tiered_backlog_tracker>(_stcs_options))
+{}
+
+std::vector<sstable_run> incremental_compaction_strategy::make_runs(const std::vector<shared_sstable>& sstables) {
+    std::vector<sstable_run> runs;
+    std::unordered_map<utils::UUID, size_t> run_index;
+    for (auto& sst : sstables) {
+        auto [it, inserted] = run_index.try_emplace(sst->run_identifier(), runs.size());
+        if (inserted) {
+            runs.emplace_back();
+        }
+        if (!runs[it->second].insert(sst)) {
+            runs.emplace_back();
+            runs.back().insert(sst);
+        }
+    }
+    return runs;
+}
+
+std::vector<std::vector<sstable_run>>
+incremental_compaction_strategy::get_buckets(std::vector<sstable_run> runs, const size_tiered_compaction_strategy_options& options) {
+    std::sort(runs.begin(), runs.end(), [] (const sstable_run& a, const sstable_run& b) {
+        return a.data_size() < b.data_size();
+    });
+
+    std::vector<std::vector<sstable_run>> bucket_list;
+    std::vector<double> bucket_average_size_list;
+
+    // Same grouping as size_tiered_compaction_strategy::get_buckets(), applied to whole runs.
+    for (auto& run : runs) {
+        auto size = run.data_size();
+        if (!bucket_list.empty()) {
+            auto& bucket_average_size = bucket_average_size_list.back();
+
+            if ((size > (bucket_average_size * options.bucket_low) && size < (bucket_average_size * options.bucket_high)) ||
+                    (size < options.min_sstable_size && bucket_average_size < options.min_sstable_size)) {
+                auto& bucket = bucket_list.back();
+                auto total_size = bucket.size() * bucket_average_size;
+                auto new_average_size = (total_size + size) / (bucket.size() + 1);
+                auto smallest_run_in_bucket = bucket[0].data_size();
+
+                if (size < options.min_sstable_size || smallest_run_in_bucket > new_average_size * options.bucket_low) {
+                    bucket.push_back(std::move(run));
+                    bucket_average_size = new_average_size;
+                    continue;
+                }
+            }
+        }
+
+        bucket_list.push_back({std::move(run)});
+        bucket_average_size_list.push_back(size);
+    }
+
+    return bucket_list;
+}
+
+std::vector<sstable_run>
+incremental_compaction_strategy::most_interesting_bucket(std::vector<std::vector<sstable_run>> buckets, size_t min_threshold, size_t max_threshold) const {
+    std::vector<sstable_run>* max = nullptr;
+    for (auto& bucket : buckets) {
+        if (bucket.size() < min_threshold) {
+            continue;
+        }
+        bucket.resize(std::min(bucket.size(), max_threshold));
+        // Pick the bucket with more runs, as efficiency of same-tier compactions increases with the number of runs.
+        if (!max || max->size() < bucket.size()) {
+            max = &bucket;
+        }
+    }
+    return max ? std::move(*max) : std::vector<sstable_run>();
+}
+
+compaction_descriptor incremental_compaction_strategy::make_descriptor(const std::vector<sstable_run>& runs) const {
+    std::vector<shared_sstable> sstables;
+    for (auto& run : runs) {
+        sstables.insert(sstables.end(), run.all().begin(), run.all().end());
+    }
+    return compaction_descriptor(std::move(sstables), service::get_local_compaction_priority(), compaction_descriptor::default_level, _fragment_size);
+}
+
+compaction_descriptor
+incremental_compaction_strategy::get_sstables_for_compaction(table_state& table_s, strategy_control& control, std::vector<sstables::shared_sstable> candidates) {
+    size_t min_threshold = table_s.min_compaction_threshold();
+    size_t max_threshold = table_s.schema()->max_compaction_threshold();
+    auto compaction_time = gc_clock::now();
+
+    auto buckets = get_buckets(make_runs(candidates), _stcs_options);
+
+    auto most_interesting = most_interesting_bucket(buckets, min_threshold, max_threshold);
+    if (most_interesting.empty() && !table_s.compaction_enforce_min_threshold()) {
+        most_interesting = most_interesting_bucket(buckets, 2, max_threshold);
+    }
+    if (!most_interesting.empty()) {
+        return make_descriptor(most_interesting);
+    }
+
+    // Fragments can be compacted independently of the rest of their run, as they don't overlap with it.
+    if (_tombstone_compaction_scope == tombstone_compaction_scope::token_range) {
+        return compaction_descriptor(get_tombstone_dense_range_candidates(candidates, compaction_time, max_threshold),
+                service::get_local_compaction_priority(), compaction_descriptor::default_level, _fragment_size);
+    }
+
+    // If there is nothing to compact in the standard way, rewrite a single run which has a fragment
+    // worth dropping tombstones for, preferring the oldest runs of the biggest tiers like STCS does.
+    for (auto& bucket : buckets | boost::adaptors::reversed) {
+        std::vector<sstable_run*> worth_dropping;
+        for (auto& run : bucket) {
+            if (std::any_of(run.all().begin(), run.all().end(), [&] (const shared_sstable& sst) { return worth_dropping_tombstones(sst, compaction_time); })) {
+                worth_dropping.push_back(&run);
+            }
+        }
+        if (worth_dropping.empty()) {
+            continue;
+        }
+        auto min_timestamp = [] (const sstable_run* run) {
+            return (*boost::min_element(run->all(), [] (const shared_sstable& a, const shared_sstable& b) {
+                return a->get_stats_metadata().min_timestamp < b->get_stats_metadata().min_timestamp;
+            }))->get_stats_metadata().min_timestamp;
+        };
+        auto oldest = *std::min_element(worth_dropping.begin(), worth_dropping.end(), [&] (const sstable_run* a, const sstable_run* b) {
+            return min_timestamp(a) < min_timestamp(b);
+        });
+        return make_descriptor({*oldest});
+    }
+    return compaction_descriptor();
+}
+
+compaction_descriptor
+incremental_compaction_strategy::get_major_compaction_job(table_state& table_s, std::vector<sstables::shared_sstable> candidates) {
+    return make_major_compaction_job(std::move(candidates), compaction_descriptor::default_level, _fragment_size);
+}
+
+int64_t incremental_compaction_strategy::estimated_pending_compactions(table_state& table_s) const {
+    size_t min_threshold = table_s.min_compaction_threshold();
+    size_t max_threshold = table_s.schema()->max_compaction_threshold();
+
+    auto all_sstables = table_s.main_sstable_set().all();
+    auto sstables = std::vector<shared_sstable>(all_sstables->begin(), all_sstables->end());
+
+    int64_t n = 0;
+    for (auto& bucket : get_buckets(make_runs(sstables), _stcs_options)) {
+        if (bucket.size() >= min_threshold) {
+            n += std::ceil(double(bucket.size()) / max_threshold);
+        }
+    }
+    return n;
+}
+
+compaction_descriptor
+incremental_compaction_strategy::get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, const ::io_priority_class& iop, reshape_mode mode) {
+    auto desc = size_tiered_compaction_strategy(_stcs_options).get_reshaping_job(std::move(input), std::move(schema), iop, mode);
+    desc.max_sstable_bytes = _fragment_size;
+    return desc;
+}
+
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "compaction_strategy_impl.hh"
+#include "compaction.hh"
+#include "size_tiered_compaction_strategy.hh"
+#include "sstables/sstable_set.hh"
+
+namespace sstables {
+
+// Size-tiered compaction which works on sstable runs instead of sstables.
+//
+// Compaction output is written as a run of fragments of at most
+// sstable_size_in_mb each, and runs are tiered by their total size.
+// Since a compaction always takes whole runs as input, an input fragment can
+// be released as soon as the output has gone past its last key (see
+// compaction::maybe_replace_exhausted_sstables_by_sst()), so the temporary
+// space overhead is bounded by the fragment size times the number of input
+// runs rather than by the size of the input.
+class incremental_compaction_strategy : public compaction_strategy_impl {
+    static constexpr uint64_t DEFAULT_MAX_FRAGMENT_SIZE_IN_MB = 1000;
+    const sstring FRAGMENT_SIZE_OPTION = "sstable_size_in_mb";
+
+    uint64_t _fragment_size;
+    size_tiered_compaction_strategy_options _stcs_options;
+    compaction_backlog_tracker _backlog_tracker;
+
+    static uint64_t calculate_fragment_size(std::optional<sstring> option_value, const sstring& option_name);
+
+    // Group runs of similar size into buckets.
+    static std::vector<std::vector<sstable_run>> get_buckets(std::vector<sstable_run> runs, const size_tiered_compaction_strategy_options& options);
+
+    std::vector<sstable_run>
+    most_interesting_bucket(std::vector<std::vector<sstable_run>> buckets, size_t min_threshold, size_t max_threshold) const;
+
+    compaction_descriptor make_descriptor(const std::vector<sstable_run>& runs) const;
+public:
+    // Build the runs made of the given sstables. A fragment which would overlap with the
+    // other fragments of its run is placed in a run of its own.
+    static std::vector<sstable_run> make_runs(const std::vector<shared_sstable>& sstables);
+
+    incremental_compaction_strategy(const std::map<sstring, sstring>& options);
+
+    uint64_t fragment_size() const noexcept {
+        return _fragment_size;
+    }
+
+    virtual compaction_descriptor get_sstables_for_compaction(table_state& table_s, strategy_control& control, std::vector<sstables::shared_sstable> candidates) override;
+
+    virtual compaction_descriptor get_major_compaction_job(table_state& table_s, std::vector<sstables::shared_sstable> candidates) override;
+
+    virtual int64_t estimated_pending_compactions(table_state& table_s) const override;
+
+    virtual compaction_strategy_type type() const override {
+        return compaction_strategy_type::incremental;
+    }
+
+    virtual compaction_backlog_tracker& get_backlog_tracker() override {
+        return _backlog_tracker;
+    }
+
+    virtual compaction_descriptor get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, const ::io_priority_class& iop, reshape_mode mode) override;
+};
+
+}
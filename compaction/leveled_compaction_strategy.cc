@@ -8,6 +8,7 @@
 
 #include "leveled_compaction_strategy.hh"
 #include "leveled_manifest.hh"
+#include "mutation_writer/size_based_splitting_writer.hh"
 #include <algorithm>
 
 #include <boost/range/algorithm/remove_if.hpp>
@@ -20,7 +21,8 @@ compaction_descriptor leveled_compaction_strategy::get_sstables_for_compaction(t
     // lists managed by the manifest may become outdated. For example, one
     // sstable in it may be marked for deletion after compacted.
     // Currently, we create a new manifest whenever it's time for compaction.
-    leveled_manifest manifest = leveled_manifest::create(table_s, candidates, _max_sstable_size_in_mb, _stcs_options);
+    leveled_manifest manifest = leveled_manifest::create(table_s, candidates, _max_sstable_size_in_mb, _stcs_options,
+            _dynamic_level_bytes, _l0_subcompactions);
     if (!_last_compacted_keys) {
         generate_last_compacted_keys(manifest);
     }
@@ -130,7 +132,7 @@ int64_t leveled_compaction_strategy::estimated_pending_compactions(table_state&
     for (auto& entry : *all_sstables) {
         sstables.push_back(entry);
     }
-    return leveled_manifest::get_estimated_tasks(leveled_manifest::get_levels(sstables), _max_sstable_size_in_mb * 1024 * 1024);
+    return leveled_manifest::get_estimated_tasks(leveled_manifest::get_levels(sstables), _max_sstable_size_in_mb * 1024 * 1024, _dynamic_level_bytes);
 }
 
 compaction_descriptor
@@ -182,9 +184,25 @@ leveled_compaction_strategy::get_reshaping_job(std::vector<shared_sstable> input
     if (mode == reshape_mode::strict && level_info[0].size() >= offstrategy_threshold && level_info[0].size() == input.size() && l0_disjoint) {
         unsigned ideal_level = ideal_level_for_input(level_info[0], max_sstable_size_in_bytes);
 
-        leveled_manifest::logger.info("Reshaping {} disjoint sstables in level 0 into level {}", level_info[0].size(), ideal_level);
+        // Sstables written through make_offstrategy_interposer_consumer() are already small
+        // enough for a level, and only need to be moved there. They may exceed the maximum
+        // size by their last partition, and sizes are estimated from memory usage, hence the
+        // slack. They must also not be so small that the level would get many more sstables
+        // than compacting into it would write. The sstable ending each streamed range is
+        // smaller than the others, so only their average size is bounded.
+        uint64_t total_size = 0;
+        bool fits_level = ideal_level > 0 && std::ranges::all_of(level_info[0], [&] (const shared_sstable& sst) {
+            total_size += sst->data_size();
+            return sst->data_size() <= 2 * max_sstable_size_in_bytes;
+        }) && total_size >= level_info[0].size() * (max_sstable_size_in_bytes / 2);
+        if (fits_level) {
+            leveled_manifest::logger.info("Moving {} disjoint sstables in level 0 to level {}", level_info[0].size(), ideal_level);
+        } else {
+            leveled_manifest::logger.info("Reshaping {} disjoint sstables in level 0 into level {}", level_info[0].size(), ideal_level);
+        }
         compaction_descriptor desc(std::move(input), iop, ideal_level, max_sstable_size_in_bytes);
         desc.options = compaction_type_options::make_reshape();
+        desc.relevel_only = fits_level;
         return desc;
     }
 
@@ -228,6 +246,12 @@ leveled_compaction_strategy::get_cleanup_compaction_jobs(table_state& table_s, s
     return ret;
 }
 
+reader_consumer_v2 leveled_compaction_strategy::make_offstrategy_interposer_consumer(reader_consumer_v2 end_consumer) {
+    return [max_size = uint64_t(_max_sstable_size_in_mb) * 1024 * 1024, end_consumer = std::move(end_consumer)] (flat_mutation_reader_v2 rd) mutable -> future<> {
+        return mutation_writer::split_by_size(std::move(rd), max_size, std::move(end_consumer));
+    };
+}
+
 unsigned leveled_compaction_strategy::ideal_level_for_input(const std::vector<sstables::shared_sstable>& input, uint64_t max_sstable_size) {
     auto log_fanout = [fanout = leveled_manifest::leveled_fan_out] (double x) {
         double inv_log_fanout = 1.0f / std::log(fanout);
@@ -30,8 +30,12 @@ class sstable_set_impl;
 class leveled_compaction_strategy : public compaction_strategy_impl {
     static constexpr int32_t DEFAULT_MAX_SSTABLE_SIZE_IN_MB = 160;
     const sstring SSTABLE_SIZE_OPTION = "sstable_size_in_mb";
+    const sstring DYNAMIC_LEVEL_BYTES_OPTION = "dynamic_level_bytes";
+    const sstring L0_SUBCOMPACTIONS_OPTION = "l0_subcompactions";
 
     int32_t _max_sstable_size_in_mb = DEFAULT_MAX_SSTABLE_SIZE_IN_MB;
+    bool _dynamic_level_bytes = false;
+    unsigned _l0_subcompactions = 1;
     std::optional<std::vector<std::optional<dht::decorated_key>>> _last_compacted_keys;
     std::vector<int> _compaction_counter;
     size_tiered_compaction_strategy_options _stcs_options;
@@ -68,6 +72,10 @@ class leveled_compaction_strategy : public compaction_strategy_impl {
         return _backlog_tracker;
     }
 
+    // Splits the data into sstables of at most the maximum sstable size, so that
+    // disjoint ones can be moved into a level without being rewritten.
+    virtual reader_consumer_v2 make_offstrategy_interposer_consumer(reader_consumer_v2 end_consumer) override;
+
     virtual compaction_descriptor get_reshaping_job(std::vector<shared_sstable> input, schema_ptr schema, const ::io_priority_class& iop, reshape_mode mode) override;
 };
 
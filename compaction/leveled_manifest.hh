@@ -25,6 +25,10 @@ class leveled_manifest {
     std::vector<std::vector<sstables::shared_sstable>> _generations;
     uint64_t _max_sstable_size_in_bytes;
     const sstables::size_tiered_compaction_strategy_options& _stcs_options;
+    bool _dynamic_level_bytes = false;
+    // Number of concurrent token sub-ranges L0 to L1 compactions are split into.
+    unsigned _l0_subcompactions = 1;
+    std::vector<uint64_t> _level_targets;
 
     struct candidates_info {
         std::vector<sstables::shared_sstable> candidates;
@@ -79,13 +83,16 @@ class leveled_manifest {
     }
 
     static leveled_manifest create(table_state& table_s, std::vector<sstables::shared_sstable>& sstables, int max_sstable_size_in_mb,
-            const sstables::size_tiered_compaction_strategy_options& stcs_options) {
+            const sstables::size_tiered_compaction_strategy_options& stcs_options, bool dynamic_level_bytes = false, unsigned l0_subcompactions = 1) {
         leveled_manifest manifest = leveled_manifest(table_s, max_sstable_size_in_mb, stcs_options);
+        manifest._dynamic_level_bytes = dynamic_level_bytes;
+        manifest._l0_subcompactions = std::max(l0_subcompactions, 1u);
 
         // ensure all SSTables are in the manifest
         // FIXME: there can be tens of thousands of sstables. we can avoid this potentially expensive procedure if
         // partitioned_sstable_set keeps track of a list for each level.
         manifest._generations = get_levels(sstables);
+        manifest._level_targets = level_targets(manifest._generations, manifest._max_sstable_size_in_bytes, dynamic_level_bytes);
 
         return manifest;
     }
@@ -135,8 +142,35 @@ class leveled_manifest {
         return bytes_u64;
     }
 
+    // With dynamic level bytes, targets of the levels below the highest non-empty one are derived
+    // from its actual size rather than from the sstable size, so that each level stays fan-out
+    // times smaller than the next one however little data the highest level holds. This bounds
+    // write amplification, as data doesn't linger in intermediate levels which are too large for
+    // the amount of data. The target of L0 and of the highest level are the static ones.
+    static std::vector<uint64_t> level_targets(const std::vector<std::vector<sstables::shared_sstable>>& levels, uint64_t max_sstable_size_in_bytes,
+            bool dynamic_level_bytes) {
+        std::vector<uint64_t> targets;
+        targets.reserve(levels.size());
+        for (size_t level = 0; level < levels.size(); level++) {
+            targets.push_back(max_bytes_for_level(level, max_sstable_size_in_bytes));
+        }
+        auto last = levels.size() - 1;
+        while (last > 0 && levels[last].empty()) {
+            last--;
+        }
+        if (!dynamic_level_bytes || last <= 1) {
+            return targets;
+        }
+        uint64_t target = std::min(get_total_bytes(levels[last]), targets[last]);
+        for (auto level = last - 1; level > 0; level--) {
+            target /= leveled_fan_out;
+            targets[level] = std::max(target, max_sstable_size_in_bytes);
+        }
+        return targets;
+    }
+
     uint64_t max_bytes_for_level(int level) const {
-        return max_bytes_for_level(level, _max_sstable_size_in_bytes);
+        return _level_targets[level];
     }
 
 
@@ -229,8 +263,13 @@ class leveled_manifest {
             auto info = get_candidates_for(0, last_compacted_keys);
             if (!info.candidates.empty()) {
                 auto next_level = get_next_level(info.candidates, info.can_promote);
-                return sstables::compaction_descriptor(std::move(info.candidates),
+                auto descriptor = sstables::compaction_descriptor(std::move(info.candidates),
                                                        service::get_local_compaction_priority(), next_level, _max_sstable_size_in_bytes);
+                if (next_level > 0) {
+                    // Sub-ranges don't overlap, so neither does their output in the next level.
+                    descriptor.parallelism = _l0_subcompactions;
+                }
+                return descriptor;
             }
         }
 
@@ -490,13 +529,15 @@ class leveled_manifest {
         return _generations[level];
     }
 
-    static int64_t get_estimated_tasks(const std::vector<std::vector<sstables::shared_sstable>>& levels, uint64_t max_sstable_size_in_bytes) {
+    static int64_t get_estimated_tasks(const std::vector<std::vector<sstables::shared_sstable>>& levels, uint64_t max_sstable_size_in_bytes,
+            bool dynamic_level_bytes = false) {
         int64_t tasks = 0;
+        auto targets = level_targets(levels, max_sstable_size_in_bytes, dynamic_level_bytes);
 
         for (int i = static_cast<int>(levels.size()) - 1; i >= 0; i--) {
             const auto& sstables = levels[i];
             uint64_t total_bytes_for_this_level = get_total_bytes(sstables);
-            uint64_t max_bytes_for_this_level = max_bytes_for_level(i, max_sstable_size_in_bytes);
+            uint64_t max_bytes_for_this_level = targets[i];
 
             if (total_bytes_for_this_level < max_bytes_for_this_level) {
                 continue;
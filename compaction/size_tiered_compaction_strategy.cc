@@ -163,6 +163,11 @@ size_tiered_compaction_strategy::get_sstables_for_compaction(table_state& table_
         return sstables::compaction_descriptor(std::move(most_interesting), service::get_local_compaction_priority());
     }
 
+    if (_tombstone_compaction_scope == tombstone_compaction_scope::token_range) {
+        return sstables::compaction_descriptor(get_tombstone_dense_range_candidates(candidates, compaction_time, max_threshold),
+                service::get_local_compaction_priority());
+    }
+
     // if there is no sstable to compact in standard way, try compacting single sstable whose droppable tombstone
     // ratio is greater than threshold.
     // prefer oldest sstables from biggest size tiers because they will be easier to satisfy conditions for
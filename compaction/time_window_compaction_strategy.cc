@@ -62,6 +62,15 @@ time_window_compaction_strategy_options::time_window_compaction_strategy_options
             timestamp_resolution = valid_timestamp_resolutions.at(it->second);
         }
     }
+
+    it = options.find(COLD_STORAGE_AGE_SECONDS_KEY);
+    if (it != options.end()) {
+        try {
+            cold_storage_age = std::chrono::seconds(std::stol(it->second));
+        } catch (const std::exception& e) {
+            throw exceptions::syntax_exception(sstring("Invalid long value ") + it->second + " for " + COLD_STORAGE_AGE_SECONDS_KEY);
+        }
+    }
 }
 
 time_window_compaction_strategy_options::time_window_compaction_strategy_options(time_window_compaction_strategy_options&&) = default;
@@ -239,9 +248,53 @@ time_window_compaction_strategy::get_sstables_for_compaction(table_state& table_
         clogger.debug("[{}] TWCS skipping check for fully expired SSTables", fmt::ptr(this));
     }
 
-    auto compaction_candidates = get_next_non_expired_sstables(table_s, control, std::move(candidates), compaction_time);
+    auto wall_clock_now = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+    auto compaction_candidates = get_next_non_expired_sstables(table_s, control, candidates, compaction_time);
+    if (compaction_candidates.empty()) {
+        return get_cold_storage_job(std::move(candidates), table_s.schema()->max_compaction_threshold(), wall_clock_now);
+    }
     clogger.debug("[{}] Going to compact {} non-expired sstables", fmt::ptr(this), compaction_candidates.size());
-    return compaction_descriptor(std::move(compaction_candidates), service::get_local_compaction_priority());
+    auto desc = compaction_descriptor(std::move(compaction_candidates), service::get_local_compaction_priority());
+    desc.output_tier = output_tier(desc.sstables, wall_clock_now);
+    return desc;
+}
+
+bool time_window_compaction_strategy::is_cold_window(timestamp_type window_lower_bound, timestamp_type now) const {
+    if (_options.cold_storage_age.count() <= 0) {
+        return false;
+    }
+    auto age = std::chrono::duration_cast<std::chrono::microseconds>(_options.cold_storage_age).count();
+    return window_lower_bound + get_window_size(_options) <= now - age;
+}
+
+storage_tier time_window_compaction_strategy::output_tier(const std::vector<shared_sstable>& sstables, timestamp_type now) const {
+    bool all_cold = !sstables.empty() && std::all_of(sstables.begin(), sstables.end(), [&] (const shared_sstable& sst) {
+        return is_cold_window(get_window_for(_options, sst->get_stats_metadata().max_timestamp), now);
+    });
+    return all_cold ? storage_tier::cold : storage_tier::hot;
+}
+
+compaction_descriptor
+time_window_compaction_strategy::get_cold_storage_job(std::vector<shared_sstable> candidates, int max_threshold, timestamp_type now) const {
+    if (_options.cold_storage_age.count() <= 0) {
+        return compaction_descriptor();
+    }
+    // Buckets are ordered from the oldest window.
+    for (auto& [window, bucket] : get_buckets(std::move(candidates), _options).first) {
+        if (!is_cold_window(window, now)) {
+            break;
+        }
+        std::vector<shared_sstable> hot;
+        std::copy_if(bucket.begin(), bucket.end(), std::back_inserter(hot), [] (const shared_sstable& sst) { return !sst->is_cold(); });
+        if (hot.empty()) {
+            continue;
+        }
+        clogger.debug("[{}] Going to move {} sstables of window {} to cold storage", fmt::ptr(this), hot.size(), window);
+        auto desc = compaction_descriptor(trim_to_threshold(std::move(hot), max_threshold), service::get_local_compaction_priority());
+        desc.output_tier = storage_tier::cold;
+        return desc;
+    }
+    return compaction_descriptor();
 }
 
 time_window_compaction_strategy::bucket_compaction_mode
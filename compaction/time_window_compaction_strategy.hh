@@ -36,6 +36,7 @@ class time_window_compaction_strategy_options {
     static constexpr auto COMPACTION_WINDOW_UNIT_KEY = "compaction_window_unit";
     static constexpr auto COMPACTION_WINDOW_SIZE_KEY = "compaction_window_size";
     static constexpr auto EXPIRED_SSTABLE_CHECK_FREQUENCY_SECONDS_KEY = "expired_sstable_check_frequency_seconds";
+    static constexpr auto COLD_STORAGE_AGE_SECONDS_KEY = "cold_storage_age_seconds";
 private:
     const std::unordered_map<sstring, std::chrono::seconds> valid_window_units = { { "MINUTES", 60s }, { "HOURS", 3600s }, { "DAYS", 86400s } };
 
@@ -51,6 +52,8 @@ class time_window_compaction_strategy_options {
     std::chrono::seconds sstable_window_size = DEFAULT_COMPACTION_WINDOW_UNIT * DEFAULT_COMPACTION_WINDOW_SIZE;
     db_clock::duration expired_sstable_check_frequency = DEFAULT_EXPIRED_SSTABLE_CHECK_FREQUENCY_SECONDS();
     timestamp_resolutions timestamp_resolution = timestamp_resolutions::microsecond;
+    // Windows which ended longer than this ago are moved to cold storage. Zero disables it.
+    std::chrono::seconds cold_storage_age = 0s;
 public:
     time_window_compaction_strategy_options(const time_window_compaction_strategy_options&);
     time_window_compaction_strategy_options(time_window_compaction_strategy_options&&);
@@ -113,6 +116,15 @@ class time_window_compaction_strategy : public compaction_strategy_impl {
     get_next_non_expired_sstables(table_state& table_s, strategy_control& control, std::vector<shared_sstable> non_expiring_sstables, gc_clock::time_point compaction_time);
 
     std::vector<shared_sstable> get_compaction_candidates(table_state& table_s, strategy_control& control, std::vector<shared_sstable> candidate_sstables);
+
+    // Returns true if the window starting at window_lower_bound ended longer than cold_storage_age before now.
+    bool is_cold_window(timestamp_type window_lower_bound, timestamp_type now) const;
+
+    // Output of compacting sstables which all belong to cold windows belongs to cold storage too.
+    storage_tier output_tier(const std::vector<shared_sstable>& sstables, timestamp_type now) const;
+
+    // Returns a job moving sstables of the oldest cold window which are still in hot storage to cold storage.
+    compaction_descriptor get_cold_storage_job(std::vector<shared_sstable> candidates, int max_threshold, timestamp_type now) const;
 public:
     // Find the lowest timestamp for window of given size
     static timestamp_type
@@ -209,15 +209,12 @@ class compound_type final {
         return result;
     }
     bool less(managed_bytes_view b1, managed_bytes_view b2) const {
-        return with_linearized(b1, [&] (bytes_view bv1) {
-            return with_linearized(b2, [&] (bytes_view bv2) {
-                return less(bv1, bv2);
-            });
-        });
+        return compare(b1, b2) < 0;
     }
     bool less(bytes_view b1, bytes_view b2) const {
         return compare(b1, b2) < 0;
     }
+    // Linearizes, so that the hash of a fragmented key is the same as the one of a contiguous one.
     size_t hash(managed_bytes_view v) const{
         return with_linearized(v, [&] (bytes_view v) {
             return hash(v);
@@ -235,14 +232,9 @@ class compound_type final {
         }
         return h;
     }
+    // Works on the fragments, the components are compared by the types
+    // without linearizing them either.
     std::strong_ordering compare(managed_bytes_view b1, managed_bytes_view b2) const {
-        return with_linearized(b1, [&] (bytes_view bv1) {
-            return with_linearized(b2, [&] (bytes_view bv2) {
-                return compare(bv1, bv2);
-            });
-        });
-    }
-    std::strong_ordering compare(bytes_view b1, bytes_view b2) const {
         if (_byte_order_comparable) {
             if (_is_reversed) {
                 return compare_unsigned(b2, b1);
@@ -255,6 +247,16 @@ class compound_type final {
                 return type->compare(v1, v2);
             });
     }
+    std::strong_ordering compare(bytes_view b1, bytes_view b2) const {
+        if (_byte_order_comparable) {
+            if (_is_reversed) {
+                return compare_unsigned(b2, b1);
+            } else {
+                return compare_unsigned(b1, b2);
+            }
+        }
+        return compare(managed_bytes_view(b1), managed_bytes_view(b2));
+    }
     // Retruns true iff given prefix has no missing components
     bool is_full(managed_bytes_view v) const {
         assert(AllowPrefixes == allow_prefixes::yes);
@@ -284,11 +286,11 @@ class compound_type final {
         }
     }
     bool equal(managed_bytes_view v1, managed_bytes_view v2) const {
-        return with_linearized(v1, [&] (bytes_view bv1) {
-            return with_linearized(v2, [&] (bytes_view bv2) {
-                return equal(bv1, bv2);
-            });
-        });
+        if (_byte_order_equal) {
+            return equal_unsigned(v1, v2);
+        }
+        // FIXME: call equal() on each component
+        return compare(v1, v2) == 0;
     }
     bool equal(bytes_view v1, bytes_view v2) const {
         if (_byte_order_equal) {
@@ -382,6 +382,8 @@ scylla_tests = set([
     'test/boost/chunked_vector_test',
     'test/boost/chunked_managed_vector_test',
     'test/boost/clustering_ranges_walker_test',
+    'test/boost/coalescing_file_test',
+    'test/boost/code_region_test',
     'test/boost/column_mapping_test',
     'test/boost/commitlog_test',
     'test/boost/compound_test',
@@ -416,6 +418,7 @@ scylla_tests = set([
     'test/boost/hash_test',
     'test/boost/hashers_test',
     'test/boost/hint_test',
+    'test/boost/hw_counters_test',
     'test/boost/idl_test',
     'test/boost/input_stream_test',
     'test/boost/json_cql_query_test',
@@ -427,7 +430,9 @@ scylla_tests = set([
     'test/boost/linearizing_input_stream_test',
     'test/boost/loading_cache_test',
     'test/boost/log_heap_test',
+    'test/boost/lru_test',
     'test/boost/estimated_histogram_test',
+    'test/boost/replica_latency_tracker_test',
     'test/boost/summary_test',
     'test/boost/logalloc_test',
     'test/boost/managed_vector_test',
@@ -435,6 +440,7 @@ scylla_tests = set([
     'test/boost/intrusive_array_test',
     'test/boost/map_difference_test',
     'test/boost/memtable_test',
+    'test/boost/meter_timer_test',
     'test/boost/multishard_mutation_query_test',
     'test/boost/murmur_hash_test',
     'test/boost/mutation_fragment_test',
@@ -489,6 +495,7 @@ scylla_tests = set([
     'test/boost/view_build_test',
     'test/boost/view_complex_test',
     'test/boost/view_schema_test',
+    'test/boost/view_update_queue_test',
     'test/boost/view_schema_pkey_test',
     'test/boost/view_schema_ckey_test',
     'test/boost/vint_serialization_test',
@@ -533,9 +540,11 @@ scylla_tests = set([
     'test/perf/perf_collection',
     'test/perf/perf_row_cache_update',
     'test/perf/perf_row_cache_reads',
+    'test/perf/perf_repair_streaming',
     'test/perf/logalloc',
     'test/perf/perf_simple_query',
     'test/perf/perf_sstable',
+    'test/perf/perf_compaction',
     'test/unit/lsa_async_eviction_test',
     'test/unit/lsa_sync_eviction_test',
     'test/unit/row_cache_alloc_stress_test',
@@ -556,6 +565,8 @@ perf_tests = set([
     'test/perf/perf_idl',
     'test/perf/perf_vint',
     'test/perf/perf_big_decimal',
+    'test/perf/perf_utf8',
+    'test/perf/perf_row_locking',
 ])
 
 raft_tests = set([
@@ -675,6 +686,7 @@ scylla_core = (['replica/database.cc',
                 'replica/table.cc',
                 'replica/distributed_loader.cc',
                 'replica/memtable.cc',
+                'replica/hot_partitions.cc',
                 'replica/exceptions.cc',
                 'dirty_memory_manager.cc',
                 'absl-flat_hash_map.cc',
@@ -701,6 +713,7 @@ scylla_core = (['replica/database.cc',
                 'utils/logalloc.cc',
                 'utils/large_bitset.cc',
                 'utils/buffer_input_stream.cc',
+                'utils/coalescing_file.cc',
                 'utils/limiting_data_source.cc',
                 'utils/updateable_value.cc',
                 'utils/directories.cc',
@@ -708,6 +721,8 @@ scylla_core = (['replica/database.cc',
                 'utils/rjson.cc',
                 'utils/human_readable.cc',
                 'utils/histogram_metrics_helper.cc',
+                'utils/code_region.cc',
+                'utils/hw_counters.cc',
                 'mutation_partition.cc',
                 'mutation_partition_view.cc',
                 'mutation_partition_serializer.cc',
@@ -736,6 +751,7 @@ scylla_core = (['replica/database.cc',
                 'compaction/size_tiered_compaction_strategy.cc',
                 'compaction/leveled_compaction_strategy.cc',
                 'compaction/time_window_compaction_strategy.cc',
+                'compaction/incremental_compaction_strategy.cc',
                 'compaction/compaction_manager.cc',
                 'sstables/integrity_checked_file_impl.cc',
                 'sstables/prepended_input_stream.cc',
@@ -846,6 +862,7 @@ scylla_core = (['replica/database.cc',
                 'service/priority_manager.cc',
                 'service/migration_manager.cc',
                 'service/storage_proxy.cc',
+                'service/replica_latency_tracker.cc',
                 'query_ranges_to_vnodes.cc',
                 'service/forward_service.cc',
                 'service/paxos/proposal.cc',
@@ -857,6 +874,7 @@ scylla_core = (['replica/database.cc',
                 'cql3/constants.cc',
                 'cql3/query_processor.cc',
                 'cql3/query_options.cc',
+                'cql3/select_result_cache.cc',
                 'cql3/column_condition.cc',
                 'cql3/user_types.cc',
                 'cql3/untyped_result_set.cc',
@@ -894,6 +912,7 @@ scylla_core = (['replica/database.cc',
                 'db/tags/utils.cc',
                 'db/view/view.cc',
                 'db/view/view_update_generator.cc',
+                'db/view/view_update_queue.cc',
                 'db/view/row_locking.cc',
                 'db/sstables-format-selector.cc',
                 'db/snapshot-ctl.cc',
@@ -939,6 +958,7 @@ scylla_core = (['replica/database.cc',
                 'locator/network_topology_strategy.cc',
                 'locator/everywhere_replication_strategy.cc',
                 'locator/token_metadata.cc',
+                'locator/replica_lookup_table.cc',
                 'locator/snitch_base.cc',
                 'locator/simple_snitch.cc',
                 'locator/rack_inferring_snitch.cc',
@@ -998,6 +1018,7 @@ scylla_core = (['replica/database.cc',
                 'auth/sasl_challenge.cc',
                 'tracing/tracing.cc',
                 'tracing/trace_keyspace_helper.cc',
+                'tracing/trace_ring_buffer_helper.cc',
                 'tracing/trace_state.cc',
                 'tracing/tracing_backend_registry.cc',
                 'tracing/traced_file.cc',
@@ -1022,6 +1043,7 @@ scylla_core = (['replica/database.cc',
                 'utils/build_id.cc',
                 'mutation_writer/timestamp_based_splitting_writer.cc',
                 'mutation_writer/shard_based_splitting_writer.cc',
+                'mutation_writer/size_based_splitting_writer.cc',
                 'mutation_writer/partition_based_splitting_writer.cc',
                 'mutation_writer/feed_writers.cc',
                 'lang/lua.cc',
@@ -1283,14 +1305,16 @@ deps['test/boost/summary_test'] = ['test/boost/summary_test.cc']
 deps['test/boost/anchorless_list_test'] = ['test/boost/anchorless_list_test.cc']
 deps['test/perf/perf_fast_forward'] += ['seastar/tests/perf/linux_perf_event.cc']
 deps['test/perf/perf_simple_query'] += ['test/perf/perf.cc', 'seastar/tests/perf/linux_perf_event.cc', 'test/lib/alternator_test_env.cc'] + alternator
+deps['test/perf/perf_collection'] += ['test/perf/perf.cc', 'seastar/tests/perf/linux_perf_event.cc']
 deps['test/perf/perf_commitlog'] += ['test/perf/perf.cc', 'seastar/tests/perf/linux_perf_event.cc']
+deps['test/perf/perf_repair_streaming'] += ['test/perf/perf.cc', 'seastar/tests/perf/linux_perf_event.cc']
 deps['test/perf/perf_row_cache_reads'] += ['test/perf/perf.cc', 'seastar/tests/perf/linux_perf_event.cc']
 deps['test/perf/perf_row_cache_update'] += ['test/perf/perf.cc', 'seastar/tests/perf/linux_perf_event.cc']
 deps['test/boost/reusable_buffer_test'] = [
     "test/boost/reusable_buffer_test.cc",
     "test/lib/log.cc",
 ]
-deps['test/boost/utf8_test'] = ['utils/utf8.cc', 'test/boost/utf8_test.cc']
+deps['test/boost/utf8_test'] = ['utils/utf8.cc', 'utils/ascii.cc', 'test/boost/utf8_test.cc']
 deps['test/boost/small_vector_test'] = ['test/boost/small_vector_test.cc']
 deps['test/boost/multishard_mutation_query_test'] += ['test/boost/test_table.cc']
 deps['test/boost/vint_serialization_test'] = ['test/boost/vint_serialization_test.cc', 'vint-serialization.cc', 'bytes.cc']
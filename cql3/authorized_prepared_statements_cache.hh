@@ -166,6 +166,15 @@ class authorized_prepared_statements_cache {
         _cache.reset();
     }
 
+    /// Removes the statements authorized for the users for which the predicate returns true.
+    template <typename Pred>
+    requires std::is_invocable_r_v<bool, Pred, const auth::authenticated_user&>
+    void remove_if(Pred&& pred) {
+        _cache.remove_if([&pred] (const cache_key_type& k, const checked_weak_ptr&) {
+            return pred(k.key().first);
+        });
+    }
+
     future<> stop() {
         return _cache.stop();
     }
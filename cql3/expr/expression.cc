@@ -673,6 +673,104 @@ bool is_satisfied_by(const expression& restr, const evaluation_inputs& inputs) {
         }, restr);
 }
 
+compiled_restriction::compiled_restriction(const expression& restr, const cql3::selection::selection& sel, const query_options& options) {
+    if (!compile(restr, sel, options)) {
+        _steps.clear();
+        _fallback = restr;
+    }
+}
+
+bool compiled_restriction::compile(const expression& e, const cql3::selection::selection& sel, const query_options& options) {
+    return expr::visit(overloaded_functor{
+            [&] (const conjunction& c) {
+                return std::all_of(c.children.begin(), c.children.end(), [&] (const expression& child) {
+                    return compile(child, sel, options);
+                });
+            },
+            [&] (const binary_operator& opr) {
+                return compile(opr, sel, options);
+            },
+            [] (const auto&) {
+                return false;
+            },
+        }, e);
+}
+
+bool compiled_restriction::compile(const binary_operator& opr, const cql3::selection::selection& sel, const query_options& options) {
+    if (is<token>(opr.lhs)) {
+        // Always satisfied, see is_satisfied_by().
+        return true;
+    }
+    auto col = as_if<column_value>(&opr.lhs);
+    if (!col || !(opr.op == oper_t::EQ || opr.op == oper_t::NEQ || is_slice(opr.op))) {
+        return false;
+    }
+    if (!is<constant>(opr.rhs) && !is<bind_variable>(opr.rhs)) {
+        return false;
+    }
+    const column_definition& cdef = *col->col;
+    uint32_t index;
+    switch (cdef.kind) {
+    case column_kind::partition_key:
+    case column_kind::clustering_key:
+        index = cdef.id;
+        break;
+    case column_kind::static_column:
+    case column_kind::regular_column: {
+        auto i = sel.index_of(cdef);
+        if (i == -1) {
+            // Let is_satisfied_by() report it.
+            return false;
+        }
+        index = i;
+        break;
+    }
+    default:
+        return false;
+    }
+    _steps.push_back(step{
+        .kind = cdef.kind,
+        .index = index,
+        .op = opr.op,
+        .type = is_slice(opr.op) ? &cdef.type->without_reversed() : cdef.type.get(),
+        .value = evaluate(opr.rhs, options).to_managed_bytes_opt(),
+    });
+    return true;
+}
+
+bool compiled_restriction::is_satisfied_by(const evaluation_inputs& inputs) const {
+    if (_fallback) {
+        return expr::is_satisfied_by(*_fallback, inputs);
+    }
+    for (const auto& s : _steps) {
+        managed_bytes_view_opt lhs;
+        switch (s.kind) {
+        case column_kind::partition_key:
+            lhs = managed_bytes_view(bytes_view((*inputs.partition_key)[s.index]));
+            break;
+        case column_kind::clustering_key:
+            lhs = managed_bytes_view(bytes_view((*inputs.clustering_key)[s.index]));
+            break;
+        default:
+            if (const auto& v = (*inputs.static_and_regular_columns)[s.index]) {
+                lhs = managed_bytes_view(*v);
+            }
+            break;
+        }
+        // Same null handling as equal() and limits().
+        bool satisfied;
+        if (s.op == oper_t::EQ || s.op == oper_t::NEQ) {
+            satisfied = (lhs && s.value && s.type->equal(*lhs, managed_bytes_view(*s.value))) == (s.op == oper_t::EQ);
+        } else {
+            satisfied = lhs && s.value && limits(*lhs, s.op, managed_bytes_view(*s.value), *s.type);
+        }
+        if (!satisfied) {
+            return false;
+        }
+    }
+    return true;
+}
+
 namespace {
 
 template<typename Range>
@@ -505,6 +505,33 @@ std::vector<managed_bytes_opt> get_non_pk_values(const cql3::selection::selectio
 extern bool is_satisfied_by(
         const expression& restr, const evaluation_inputs& inputs);
 
+/// A restriction prepared for evaluation against many rows of a query.
+///
+/// Conjunctions of comparisons of a single column with a value known before the
+/// query reads any row, the common case for filtering, are compiled into a flat
+/// list of steps, resolving the position of the column in the row and evaluating
+/// the value once. Other restrictions are evaluated with is_satisfied_by().
+class compiled_restriction {
+    struct step {
+        column_kind kind;
+        // Position of the column in the input it's found in.
+        uint32_t index;
+        oper_t op;
+        const abstract_type* type;
+        managed_bytes_opt value;
+    };
+    std::vector<step> _steps;
+    std::optional<expression> _fallback;
+private:
+    bool compile(const expression& e, const cql3::selection::selection& sel, const query_options& options);
+    bool compile(const binary_operator& opr, const cql3::selection::selection& sel, const query_options& options);
+public:
+    compiled_restriction(const expression& restr, const cql3::selection::selection& sel, const query_options& options);
+
+    /// Same as is_satisfied_by(restr, inputs), for inputs of the same selection and options.
+    bool is_satisfied_by(const evaluation_inputs& inputs) const;
+};
+
 
 /// A set of discrete values.
 using value_list = std::vector<managed_bytes>; // Sorted and deduped using value comparator.
@@ -20,9 +20,12 @@
 #include "native_aggregate_function.hh"
 #include "exceptions/exceptions.hh"
 #include "utils/multiprecision_int.hh"
+#include <array>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <span>
 #include <type_traits>
 
 using namespace cql3;
@@ -46,6 +49,9 @@ class impl_count_function : public aggregate_function::aggregate {
     virtual void add_input(cql_serialization_format sf, const std::vector<opt_bytes>& values) override {
         ++_count;
     }
+    virtual void add_inputs(cql_serialization_format sf, const std::vector<std::vector<opt_bytes>>& columns, size_t rows) override {
+        _count += rows;
+    }
     virtual void set_accumulator(const opt_bytes& acc) override {
         if (acc) {
             _count = value_cast<int64_t>(long_type->deserialize(bytes_view(*acc)));
@@ -172,6 +178,97 @@ struct accumulator_for : public std::conditional_t<std::is_integral_v<T>,
                                                    same_type_accumulator_for<T>>
 { };
 
+// Types whose values are serialized with a fixed width, which add_inputs()
+// decodes directly into arrays of native values instead of going through
+// data_value, and then aggregates with loops the compiler can vectorize.
+template <typename T>
+concept fixed_width_type = (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)
+        || std::is_same_v<T, db_clock::time_point>;
+
+template <typename T>
+struct fixed_width_traits {
+    // Values of timestamps are aggregated as their count of milliseconds.
+    using native_type = std::conditional_t<std::is_same_v<T, db_clock::time_point>, int64_t, T>;
+
+    static native_type decode(bytes_view v) {
+        auto p = reinterpret_cast<const char*>(v.data());
+        if constexpr (std::is_floating_point_v<native_type>) {
+            using bits_type = std::conditional_t<sizeof(native_type) == 4, uint32_t, uint64_t>;
+            return std::bit_cast<native_type>(read_be<bits_type>(p));
+        } else {
+            return read_be<native_type>(p);
+        }
+    }
+
+    static native_type from_value(T v) {
+        if constexpr (std::is_same_v<T, db_clock::time_point>) {
+            return v.time_since_epoch().count();
+        } else {
+            return v;
+        }
+    }
+
+    static T to_value(native_type v) {
+        if constexpr (std::is_same_v<T, db_clock::time_point>) {
+            return db_clock::time_point(db_clock::duration(v));
+        } else {
+            return v;
+        }
+    }
+};
+
+// Calls on_chunk with chunks of the decoded non-null values of the column,
+// and on_other with the values which don't have the serialized width of T,
+// in the order of the column.
+template <fixed_width_type T, typename OnChunk, typename OnOther>
+static void for_each_fixed_width_chunk(const std::vector<bytes_opt>& column, size_t rows, OnChunk&& on_chunk, OnOther&& on_other) {
+    using traits = fixed_width_traits<T>;
+    static constexpr size_t chunk_size = 256;
+    std::array<typename traits::native_type, chunk_size> chunk;
+    size_t n = 0;
+    auto flush = [&] {
+        if (n) {
+            on_chunk(std::span<const typename traits::native_type>(chunk.data(), n));
+            n = 0;
+        }
+    };
+    for (size_t row = 0; row < rows; ++row) {
+        auto& v = column[row];
+        if (!v) {
+            continue;
+        }
+        if (v->size() != sizeof(typename traits::native_type)) {
+            flush();
+            on_other(v);
+            continue;
+        }
+        chunk[n++] = traits::decode(*v);
+        if (n == chunk_size) {
+            flush();
+        }
+    }
+    flush();
+}
+
+// Adds to the accumulator of sum and avg. Floating point values are added
+// one by one, in order, so that results don't depend on the chunking.
+template <typename T>
+static void sum_chunk(typename accumulator_for<T>::type& acc, std::span<const T> chunk) {
+    if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(int32_t)) {
+        // A chunk of narrow integers can't overflow a 64-bit sum, whose
+        // loop vectorizes unlike the one adding to a 128-bit accumulator.
+        int64_t sum = 0;
+        for (auto v : chunk) {
+            sum += v;
+        }
+        acc += sum;
+    } else {
+        for (auto v : chunk) {
+            acc += v;
+        }
+    }
+}
+
 class impl_user_aggregate : public aggregate_function::aggregate {
     ::shared_ptr<scalar_function> _sfunc;
     ::shared_ptr<scalar_function> _rfunc;
@@ -227,6 +324,17 @@ class impl_sum_function_for : public aggregate_function::aggregate {
         }
         _sum += value_cast<Type>(data_type_for<Type>()->deserialize(*values[0]));
     }
+    virtual void add_inputs(cql_serialization_format sf, const std::vector<std::vector<opt_bytes>>& columns, size_t rows) override {
+        if constexpr (fixed_width_type<Type>) {
+            for_each_fixed_width_chunk<Type>(columns[0], rows, [this] (std::span<const Type> chunk) {
+                sum_chunk(_sum, chunk);
+            }, [this, sf] (const opt_bytes& v) {
+                add_input(sf, {v});
+            });
+        } else {
+            aggregate::add_inputs(sf, columns, rows);
+        }
+    }
     virtual void set_accumulator(const opt_bytes& acc) override {
         if (acc) {
             _sum = accumulator_for<Type>::deserialize(acc);
@@ -330,6 +438,18 @@ class impl_avg_function_for : public aggregate_function::aggregate {
         ++_count;
         _sum += value_cast<Type>(data_type_for<Type>()->deserialize(*values[0]));
     }
+    virtual void add_inputs(cql_serialization_format sf, const std::vector<std::vector<opt_bytes>>& columns, size_t rows) override {
+        if constexpr (fixed_width_type<Type>) {
+            for_each_fixed_width_chunk<Type>(columns[0], rows, [this] (std::span<const Type> chunk) {
+                _count += chunk.size();
+                sum_chunk(_sum, chunk);
+            }, [this, sf] (const opt_bytes& v) {
+                add_input(sf, {v});
+            });
+        } else {
+            aggregate::add_inputs(sf, columns, rows);
+        }
+    }
     virtual void set_accumulator(const opt_bytes& acc) override {
         if (acc) {
             data_type tuple_type = tuple_type_impl::get_instance({accumulator_for<Type>::data_type(), long_type});
@@ -474,6 +594,22 @@ class impl_max_function_for final : public aggregate_function::aggregate {
             _max = max_wrapper(*_max, val);
         }
     }
+    virtual void add_inputs(cql_serialization_format sf, const std::vector<std::vector<opt_bytes>>& columns, size_t rows) override {
+        if constexpr (fixed_width_type<Type>) {
+            using traits = fixed_width_traits<Type>;
+            for_each_fixed_width_chunk<Type>(columns[0], rows, [this] (std::span<const typename traits::native_type> chunk) {
+                auto m = _max ? traits::from_value(*_max) : chunk[0];
+                for (auto v : chunk) {
+                    m = max_wrapper(m, v);
+                }
+                _max = traits::to_value(m);
+            }, [this, sf] (const opt_bytes& v) {
+                add_input(sf, {v});
+            });
+        } else {
+            aggregate::add_inputs(sf, columns, rows);
+        }
+    }
     virtual void set_accumulator(const opt_bytes& acc) override {
         if (acc) {
             _max = value_cast<typename aggregate_type_for<Type>::type>(data_type_for<Type>()->deserialize(*acc));
@@ -615,6 +751,22 @@ class impl_min_function_for final : public aggregate_function::aggregate {
             _min = min_wrapper(*_min, val);
         }
     }
+    virtual void add_inputs(cql_serialization_format sf, const std::vector<std::vector<opt_bytes>>& columns, size_t rows) override {
+        if constexpr (fixed_width_type<Type>) {
+            using traits = fixed_width_traits<Type>;
+            for_each_fixed_width_chunk<Type>(columns[0], rows, [this] (std::span<const typename traits::native_type> chunk) {
+                auto m = _min ? traits::from_value(*_min) : chunk[0];
+                for (auto v : chunk) {
+                    m = min_wrapper(m, v);
+                }
+                _min = traits::to_value(m);
+            }, [this, sf] (const opt_bytes& v) {
+                add_input(sf, {v});
+            });
+        } else {
+            aggregate::add_inputs(sf, columns, rows);
+        }
+    }
     virtual void set_accumulator(const opt_bytes& acc) override {
         if (acc) {
             _min = value_cast<typename aggregate_type_for<Type>::type>(data_type_for<Type>()->deserialize(*acc));
@@ -729,6 +881,9 @@ class impl_count_function_for final : public aggregate_function::aggregate {
         }
         ++_count;
     }
+    virtual void add_inputs(cql_serialization_format sf, const std::vector<std::vector<opt_bytes>>& columns, size_t rows) override {
+        _count += std::count_if(columns[0].begin(), columns[0].begin() + rows, [] (const opt_bytes& v) { return bool(v); });
+    }
     virtual void set_accumulator(const opt_bytes& acc) override {
         if (acc) {
             _count = value_cast<int64_t>(long_type->deserialize(bytes_view(*acc)));
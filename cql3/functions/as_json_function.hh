@@ -40,9 +40,16 @@ namespace functions {
 class as_json_function : public scalar_function {
     std::vector<sstring> _selector_names;
     std::vector<data_type> _selector_types;
+    // The JSON key of each selector, with the separator which follows it.
+    std::vector<sstring> _selector_keys;
 public:
     as_json_function(std::vector<sstring>&& selector_names, std::vector<data_type> selector_types)
         : _selector_names(std::move(selector_names)), _selector_types(std::move(selector_types)) {
+        _selector_keys.reserve(_selector_names.size());
+        for (const auto& name : _selector_names) {
+            bool has_any_upper = boost::algorithm::any_of(name, [](unsigned char c) { return std::isupper(c); });
+            _selector_keys.push_back(has_any_upper ? format("\"\\\"{}\\\"\": ", name) : format("\"{}\": ", name));
+        }
     }
 
     virtual bool requires_thread() const override;
@@ -54,18 +61,12 @@ class as_json_function : public scalar_function {
             if (i > 0) {
                 encoded_row.write(", ", 2);
             }
-            bool has_any_upper = boost::algorithm::any_of(_selector_names[i], [](unsigned char c) { return std::isupper(c); });
-            encoded_row.write("\"", 1);
-            if (has_any_upper) {
-                encoded_row.write("\\\"", 2);
-            }
-            encoded_row.write(_selector_names[i].c_str(), _selector_names[i].size());
-            if (has_any_upper) {
-                encoded_row.write("\\\"", 2);
+            encoded_row.write(_selector_keys[i].c_str(), _selector_keys[i].size());
+            if (parameters[i]) {
+                write_json(encoded_row, *_selector_types[i], *parameters[i]);
+            } else {
+                encoded_row.write("null", 4);
             }
-            encoded_row.write("\": ", 3);
-            sstring row_sstring = to_json_string(*_selector_types[i], parameters[i]);
-            encoded_row.write(row_sstring.c_str(), row_sstring.size());
         }
         encoded_row.write("}", 1);
         return bytes(encoded_row.linearize());
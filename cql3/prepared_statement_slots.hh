@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+
+#include "cql3/query_processor.hh"
+
+namespace cql3 {
+
+/// \class prepared_statement_slots
+/// \brief A small direct-mapped cache of the prepared statements executed by one connection.
+///
+/// Executing a prepared statement looks it up in the authorized prepared statements cache,
+/// by user and id, and then, if the user wasn't authorized yet, in the prepared statements
+/// cache. Drivers execute the same few statements over and over on a connection, so the
+/// outcome of these lookups is kept in a slot selected by the leading bytes of the statement id.
+/// Those are bytes of an MD5 digest, so they are spread evenly among the slots.
+///
+/// A slot holds on to the entries of both caches and is used only while both are still cached.
+/// The statement is removed from the prepared statements cache when the schema it depends on
+/// changes, and the authorization is removed from the authorized prepared statements cache
+/// whenever permissions are refreshed, so a slot never outlives either. Hits mark both entries
+/// as read, so that hot statements are not evicted from the shared caches.
+///
+/// The slots belong to the shard of the connection and must only be used there.
+class prepared_statement_slots {
+public:
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    static stats& shard_stats() {
+        static thread_local stats _stats;
+        return _stats;
+    }
+
+    struct lookup_result {
+        statements::prepared_statement::checked_weak_ptr statement;
+        bool needs_authorization;
+    };
+
+private:
+    static constexpr size_t slot_count = 64;
+
+    struct slot {
+        cql_prepared_id_type id;
+        std::optional<auth::authenticated_user> user;
+        prepared_statements_cache::value_ptr statement = nullptr;
+        authorized_prepared_statements_cache::value_ptr authorization = nullptr;
+    };
+
+    std::array<slot, slot_count> _slots;
+
+    static size_t slot_index(const cql_prepared_id_type& id) noexcept {
+        if (id.size() < 2) {
+            return 0;
+        }
+        return (uint8_t(id[0]) | uint8_t(id[1]) << 8) % slot_count;
+    }
+
+public:
+    /// Equivalent to looking the statement up with query_processor::get_prepared() for the user,
+    /// and then without it if it's not found. An empty statement means it isn't prepared.
+    lookup_result get_prepared(query_processor& qp, const std::optional<auth::authenticated_user>& user, const prepared_cache_key_type& key) {
+        auto& id = prepared_cache_key_type::cql_id(key);
+        auto& s = _slots[slot_index(id)];
+        if (s.statement.cached() && s.id == id && s.user == user) {
+            if (s.authorization.cached()) {
+                ++shard_stats().hits;
+                s.statement.touch();
+                s.authorization.touch();
+                return {(*s.statement)->checked_weak_from_this(), false};
+            }
+            // The statement hadn't been authorized yet when the slot was filled,
+            // or the authorization expired since.
+            s.authorization = user ? qp.find_authorized_prepared_ptr(*user, key) : nullptr;
+            if (s.authorization && *s.authorization) {
+                ++shard_stats().hits;
+                s.statement.touch();
+                return {(*s.statement)->checked_weak_from_this(), false};
+            }
+            s.authorization = nullptr;
+            ++shard_stats().misses;
+            s.statement.touch();
+            return {(*s.statement)->checked_weak_from_this(), true};
+        }
+
+        ++shard_stats().misses;
+        auto statement = qp.find_prepared_ptr(key);
+        if (!statement) {
+            s = slot{};
+            return {statements::prepared_statement::checked_weak_ptr(), true};
+        }
+        auto authorization = user ? qp.find_authorized_prepared_ptr(*user, key) : nullptr;
+        if (authorization && !*authorization) {
+            // Authorized a version of the statement which has been invalidated since.
+            authorization = nullptr;
+        }
+        s.id = id;
+        s.user = user;
+        s.statement = std::move(statement);
+        s.authorization = std::move(authorization);
+        return {(*s.statement)->checked_weak_from_this(), !s.authorization};
+    }
+};
+
+}
@@ -110,6 +110,7 @@ class prepared_statements_cache {
     using key_type = prepared_cache_key_type;
     using value_type = checked_weak_ptr;
     using statement_is_too_big = typename cache_type::entry_is_too_big;
+    using value_ptr = cache_value_ptr;
 
 private:
     cache_type _cache;
@@ -132,6 +133,10 @@ class prepared_statements_cache {
         _cache.find(key.key());
     }
 
+    value_ptr find_ptr(const key_type& key) {
+        return _cache.find(key.key());
+    }
+
     value_type find(const key_type& key) {
         cache_value_ptr vp = _cache.find(key.key());
         if (vp) {
@@ -9,8 +9,12 @@
  */
 
 #include "cql3/query_processor.hh"
+#include "cql3/prepared_statement_slots.hh"
+#include "cql3/select_result_cache.hh"
 
 #include <seastar/core/metrics.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/coroutine/as_future.hh>
 
 #include "service/storage_proxy.hh"
 #include "cql3/CqlParser.hpp"
@@ -89,6 +93,10 @@ query_processor::query_processor(service::storage_proxy& proxy, service::forward
         "statements_prepared",
         _stats.prepare_invocations,
         sm::description("Counts the total number of parsed CQL requests.")));
+    qp_group.push_back(sm::make_counter(
+        "statements_prepared_on_first_execution",
+        _stats.prepared_on_first_execution,
+        sm::description("Counts the statements prepared by another shard which were prepared by this one when first executed here.")));
     for (auto cl = size_t(clevel::MIN_VALUE); cl <= size_t(clevel::MAX_VALUE); ++cl) {
         qp_group.push_back(
             sm::make_counter(
@@ -418,6 +426,36 @@ query_processor::query_processor(service::storage_proxy& proxy, service::forward
                             [] { return authorized_prepared_statements_cache::shard_stats().authorized_prepared_statements_unprivileged_entries_evictions_on_size; },
                             sm::description("Counts a number of evictions of prepared statements from the authorized prepared statements cache after they have been used only once. An increasing counter suggests the user may be preparing a different statement for each request instead of reusing the same prepared statement with parameters.")),
 
+                    sm::make_counter(
+                            "prepared_statement_slot_hits",
+                            [] { return prepared_statement_slots::shard_stats().hits; },
+                            sm::description("Counts the number of prepared statement executions which found the statement and its authorization in the slots of their connection.")),
+
+                    sm::make_counter(
+                            "prepared_statement_slot_misses",
+                            [] { return prepared_statement_slots::shard_stats().misses; },
+                            sm::description("Counts the number of prepared statement executions which had to look the statement or its authorization up in the shard-wide caches.")),
+
+                    sm::make_counter(
+                            "select_result_cache_hits",
+                            [] { return select_result_cache::shard_stats().hits; },
+                            sm::description("Counts the number of SELECTs whose result was served from the coordinator's result cache.")),
+
+                    sm::make_counter(
+                            "select_result_cache_misses",
+                            [] { return select_result_cache::shard_stats().misses; },
+                            sm::description("Counts the number of SELECTs on tables with cached results which had to be read from replicas.")),
+
+                    sm::make_counter(
+                            "select_result_cache_invalidations",
+                            [] { return select_result_cache::shard_stats().invalidations; },
+                            sm::description("Counts the number of writes which invalidated the cached results of SELECTs on their table.")),
+
+                    sm::make_gauge(
+                            "select_result_cache_memory",
+                            [] { return select_result_cache::shard_stats().memory; },
+                            sm::description("Memory (in bytes) used by the cached results of SELECTs.")),
+
                     sm::make_gauge(
                             "authorized_prepared_statements_cache_size",
                             [this] { return _authorized_prepared_cache.size(); },
@@ -559,6 +597,45 @@ query_processor::prepare(sstring query_string, const service::client_state& clie
     }
 }
 
+void query_processor::note_prepared_elsewhere(const prepared_cache_key_type& key, sstring query_string, sstring keyspace) {
+    if (_prepared_cache.find(key) || _prepared_elsewhere.contains(key)) {
+        return;
+    }
+    _prepared_elsewhere_memory += query_string.size() + keyspace.size();
+    _prepared_elsewhere_lru.push_back(key);
+    _prepared_elsewhere.emplace(key, prepared_elsewhere{std::move(query_string), std::move(keyspace), std::prev(_prepared_elsewhere_lru.end())});
+    while (_prepared_elsewhere_memory > _mcfg.prepared_statment_cache_size && !_prepared_elsewhere_lru.empty()) {
+        auto it = _prepared_elsewhere.find(_prepared_elsewhere_lru.front());
+        _prepared_elsewhere_memory -= it->second.query_string.size() + it->second.keyspace.size();
+        _prepared_elsewhere.erase(it);
+        _prepared_elsewhere_lru.pop_front();
+    }
+}
+
+future<bool> query_processor::prepare_noted(const prepared_cache_key_type& key) {
+    auto it = _prepared_elsewhere.find(key);
+    if (it == _prepared_elsewhere.end()) {
+        co_return false;
+    }
+    auto e = std::move(it->second);
+    _prepared_elsewhere_memory -= e.query_string.size() + e.keyspace.size();
+    _prepared_elsewhere_lru.erase(e.lru_it);
+    _prepared_elsewhere.erase(it);
+
+    // Only the keyspace of the client state is used for preparing.
+    service::client_state client_state(service::client_state::internal_tag{});
+    client_state.set_raw_keyspace(std::move(e.keyspace));
+    auto f = co_await coroutine::as_future(prepare(std::move(e.query_string), client_state, false));
+    if (f.failed()) {
+        // The client prepares the statement again, and gets the error then.
+        log.debug("Failed to prepare a statement prepared by another shard: {}", f.get_exception());
+        co_return false;
+    }
+    f.ignore_ready_future();
+    ++_stats.prepared_on_first_execution;
+    co_return true;
+}
+
 static std::string hash_target(std::string_view query_string, std::string_view keyspace) {
     std::string ret(keyspace);
     ret += query_string;
@@ -998,4 +1075,10 @@ void query_processor::reset_cache() {
     _authorized_prepared_cache.reset();
 }
 
+void query_processor::remove_authorized_statements_of(const auth::role_set& roles) {
+    _authorized_prepared_cache.remove_if([&roles] (const auth::authenticated_user& user) {
+        return user.name && roles.contains(*user.name);
+    });
+}
+
 }
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include <list>
 #include <string_view>
 #include <unordered_map>
 
@@ -101,6 +102,7 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
 
     struct stats {
         uint64_t prepare_invocations = 0;
+        uint64_t prepared_on_first_execution = 0;
         uint64_t queries_by_cl[size_t(db::consistency_level::MAX_VALUE) + 1] = {};
     } _stats;
 
@@ -119,6 +121,18 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
     utils::observer<uint32_t> _authorized_prepared_cache_update_interval_in_ms_observer;
     utils::observer<uint32_t> _authorized_prepared_cache_validity_in_ms_observer;
 
+    // Statements prepared by another shard, which this shard prepares when they are first
+    // executed here. Oldest entries are dropped when they take more memory than the
+    // prepared statements cache may.
+    struct prepared_elsewhere {
+        sstring query_string;
+        sstring keyspace;
+        std::list<prepared_cache_key_type>::iterator lru_it;
+    };
+    std::unordered_map<prepared_cache_key_type, prepared_elsewhere> _prepared_elsewhere;
+    std::list<prepared_cache_key_type> _prepared_elsewhere_lru;
+    size_t _prepared_elsewhere_memory = 0;
+
     // A map for prepared statements used internally (which we don't want to mix with user statement, in particular we
     // don't bother with expiration on those.
     std::unordered_map<sstring, std::unique_ptr<statements::prepared_statement>> _internal_statements;
@@ -202,6 +216,16 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
         return _prepared_cache.find(key);
     }
 
+    // Unlike get_prepared(), return pointers to the cache entries themselves, so that
+    // callers can keep them and check later whether they are still cached.
+    prepared_statements_cache::value_ptr find_prepared_ptr(const prepared_cache_key_type& key) {
+        return _prepared_cache.find_ptr(key);
+    }
+
+    authorized_prepared_statements_cache::value_ptr find_authorized_prepared_ptr(const auth::authenticated_user& user, const prepared_cache_key_type& key) {
+        return _authorized_prepared_cache.find(user, key);
+    }
+
     inline
     future<::shared_ptr<cql_transport::messages::result_message>>
     execute_prepared(
@@ -355,6 +379,14 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
     future<::shared_ptr<cql_transport::messages::result_message::prepared>>
     prepare(sstring query_string, const service::client_state& client_state, bool for_thrift);
 
+    // Remembers a CQL statement prepared by another shard, so that this shard can
+    // prepare it when it's first executed here, instead of when it's prepared.
+    void note_prepared_elsewhere(const prepared_cache_key_type& key, sstring query_string, sstring keyspace);
+
+    // Prepares a statement noted by note_prepared_elsewhere(). Resolves to false if
+    // the statement isn't known to this shard, or fails to prepare here.
+    future<bool> prepare_noted(const prepared_cache_key_type& key);
+
     future<> stop();
 
     inline
@@ -393,6 +425,9 @@ class query_processor : public seastar::peering_sharded_service<query_processor>
 
     void reset_cache();
 
+    // Forgets the statements authorized for users of the given roles.
+    void remove_authorized_statements_of(const auth::role_set& roles);
+
 private:
     query_options make_internal_options(
             const statements::prepared_statement::checked_weak_ptr& p,
@@ -25,13 +25,33 @@ class result_generator {
     template<typename Visitor>
     class query_result_visitor {
         const schema& _schema;
+        // Components of the current partition key, copied since the key passed to
+        // accept_new_partition() doesn't outlive the call, while its rows need it.
         std::vector<bytes> _partition_key;
-        std::vector<bytes> _clustering_key;
+        // Components of the current clustering key, which stays alive while the
+        // row is visited. Fragmented components are linearized into storage
+        // reserved for all of them, so that the views don't move.
+        std::vector<bytes_view> _clustering_key;
+        std::vector<bytes> _linearized_clustering_key;
         uint64_t _partition_row_count = 0;
         uint64_t _total_row_count = 0;
         Visitor& _visitor;
         const selection::selection& _selection;
     private:
+        template<typename Key>
+        static void explode(const Key& key, std::vector<bytes_view>& components, std::vector<bytes>& linearized) {
+            components.clear();
+            linearized.clear();
+            for (managed_bytes_view c : key.components()) {
+                if (c.size_bytes() == c.current_fragment().size()) [[likely]] {
+                    components.push_back(c.current_fragment());
+                } else {
+                    linearized.push_back(to_bytes(c));
+                    components.push_back(linearized.back());
+                }
+            }
+        }
+
         void accept_cell_value(const column_definition& def, query::result_row_view::iterator_type& i) {
             if (def.is_multi_cell()) {
                 _visitor.accept_value(i.next_collection_cell());
@@ -42,10 +62,17 @@ class result_generator {
         }
     public:
         query_result_visitor(const schema& s, Visitor& visitor, const selection::selection& select)
-            : _schema(s), _visitor(visitor), _selection(select) { }
+            : _schema(s), _visitor(visitor), _selection(select) {
+            _partition_key.reserve(s.partition_key_size());
+            _clustering_key.reserve(s.clustering_key_size());
+            _linearized_clustering_key.reserve(s.clustering_key_size());
+        }
 
         void accept_new_partition(const partition_key& key, uint64_t row_count) {
-            _partition_key = key.explode(_schema);
+            _partition_key.clear();
+            for (managed_bytes_view c : key.components()) {
+                _partition_key.push_back(to_bytes(c));
+            }
             accept_new_partition(row_count);
         }
         void accept_new_partition(uint64_t row_count) {
@@ -55,7 +82,7 @@ class result_generator {
 
         void accept_new_row(const clustering_key& key, query::result_row_view static_row,
                             query::result_row_view row) {
-            _clustering_key = key.explode(_schema);
+            explode(key, _clustering_key, _linearized_clustering_key);
             accept_new_row(static_row, row);
         }
         void accept_new_row(query::result_row_view static_row, query::result_row_view row) {
@@ -69,7 +96,7 @@ class result_generator {
                     break;
                 case column_kind::clustering_key:
                     if (_clustering_key.size() > def->component_index()) {
-                        _visitor.accept_value(query::result_bytes_view(bytes_view(_clustering_key[def->component_index()])));
+                        _visitor.accept_value(query::result_bytes_view(_clustering_key[def->component_index()]));
                     } else {
                         _visitor.accept_value(std::nullopt);
                     }
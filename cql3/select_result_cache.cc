@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "cql3/select_result_cache.hh"
+#include "cql3/query_options.hh"
+#include "utils/fragment_range.hh"
+#include "schema.hh"
+
+namespace cql3 {
+
+std::unordered_map<utils::UUID, uint64_t>& select_result_cache::write_generations() {
+    static thread_local std::unordered_map<utils::UUID, uint64_t> generations;
+    return generations;
+}
+
+void select_result_cache::invalidate(const utils::UUID& table) {
+    ++write_generations()[table];
+    ++shard_stats().invalidations;
+}
+
+void select_result_cache::on_write(const schema& s) {
+    if (s.caching_options().results_ttl().count()) {
+        invalidate(s.id());
+    }
+}
+
+void select_result_cache::drop(const utils::UUID& table) {
+    write_generations().erase(table);
+}
+
+select_result_cache::key_type select_result_cache::make_key(const query_options& options) {
+    size_t size = sizeof(int32_t);
+    for (size_t i = 0; i < options.get_values_count(); ++i) {
+        auto value = options.get_value_at(i);
+        size += sizeof(int32_t) + (value.is_value() ? value.size_bytes() : 0);
+    }
+    key_type key(key_type::initialized_later(), size);
+    auto out = key.begin();
+    auto write_int = [&out] (int32_t v) {
+        out = std::copy_n(reinterpret_cast<const int8_t*>(&v), sizeof(v), out);
+    };
+    write_int(int32_t(options.get_consistency()));
+    for (size_t i = 0; i < options.get_values_count(); ++i) {
+        auto value = options.get_value_at(i);
+        if (value.is_null()) {
+            write_int(-1);
+        } else if (value.is_unset_value()) {
+            write_int(-2);
+        } else {
+            write_int(value.size_bytes());
+            value.with_value([&out] (const FragmentedView auto& v) {
+                for (bytes_view frag : fragment_range(v)) {
+                    out = std::copy(frag.begin(), frag.end(), out);
+                }
+            });
+        }
+    }
+    return key;
+}
+
+select_result_cache::~select_result_cache() {
+    for (auto& [key, e] : _entries) {
+        shard_stats().memory -= e.memory;
+    }
+}
+
+uint64_t select_result_cache::generation() const {
+    auto& generations = write_generations();
+    auto it = generations.find(_table);
+    return it == generations.end() ? 0 : it->second;
+}
+
+void select_result_cache::erase(std::unordered_map<key_type, entry>::iterator it) {
+    shard_stats().memory -= it->second.memory;
+    _entries.erase(it);
+}
+
+void select_result_cache::erase_expired(clock_type::time_point now) {
+    auto current = generation();
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (it->second.expires <= now || it->second.generation != current) {
+            auto next = std::next(it);
+            erase(it);
+            it = next;
+        } else {
+            ++it;
+        }
+    }
+}
+
+lw_shared_ptr<query::result> select_result_cache::find(const key_type& key) {
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        ++shard_stats().misses;
+        return nullptr;
+    }
+    if (it->second.expires <= clock_type::now() || it->second.generation != generation()) {
+        erase(it);
+        ++shard_stats().misses;
+        return nullptr;
+    }
+    ++shard_stats().hits;
+    return it->second.result;
+}
+
+void select_result_cache::insert(key_type key, lw_shared_ptr<query::result> result, uint64_t generation,
+        std::chrono::milliseconds ttl, size_t memory_limit) {
+    if (generation != this->generation()) {
+        // The table was written to while the result was being read.
+        return;
+    }
+    auto now = clock_type::now();
+    auto memory = sizeof(entry) + key.size() + result->buf().size();
+    if (_entries.size() >= max_entries || shard_stats().memory + memory > memory_limit) {
+        erase_expired(now);
+        if (_entries.size() >= max_entries || shard_stats().memory + memory > memory_limit) {
+            return;
+        }
+    }
+    if (auto it = _entries.find(key); it != _entries.end()) {
+        erase(it);
+    }
+    _entries.emplace(std::move(key), entry{std::move(result), now + ttl, generation, memory});
+    shard_stats().memory += memory;
+    ++shard_stats().inserts;
+}
+
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <unordered_map>
+
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/shared_ptr.hh>
+
+#include "bytes.hh"
+#include "db/consistency_level_type.hh"
+#include "query-result.hh"
+#include "utils/UUID.hh"
+#include "seastarx.hh"
+
+class schema;
+
+namespace cql3 {
+
+class query_options;
+
+/// \class select_result_cache
+/// \brief Results of a SELECT statement, cached on the coordinator.
+///
+/// Tables opt in by setting the results_ttl_in_ms caching option. Each prepared
+/// select_statement of such a table owns a cache, so its entries are dropped along
+/// with the statement when the schema changes. Entries are keyed by the values bound
+/// to the statement and the consistency level, and hold the query::result, which the
+/// statement still turns into a response on every execution.
+///
+/// An entry is served until its TTL expires, until a write to the table
+/// coordinated by this shard completes, or until the table is truncated,
+/// whichever comes first. Writes coordinated
+/// elsewhere are only seen once the TTL expires, so only reads at consistency
+/// levels which don't promise more than that are cached.
+///
+/// The memory used by the caches of a shard is bounded. Once the bound is
+/// reached, results are not cached until some entries expire.
+class select_result_cache {
+public:
+    using clock_type = seastar::lowres_clock;
+    using key_type = bytes;
+
+    struct stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t inserts = 0;
+        uint64_t invalidations = 0;
+        // Memory used by the entries of all caches of the shard.
+        uint64_t memory = 0;
+    };
+
+    static stats& shard_stats() {
+        static thread_local stats _stats;
+        return _stats;
+    }
+
+    // Reads at these consistency levels may be served from the cache.
+    static bool is_cacheable(db::consistency_level cl) {
+        return cl == db::consistency_level::ONE || cl == db::consistency_level::LOCAL_ONE;
+    }
+
+    // Invalidates the entries of all caches of the shard for the table.
+    // Called when a write to the table coordinated by this shard completes.
+    static void invalidate(const utils::UUID& table);
+
+    // Invalidates the table's entries if its results may be cached.
+    static void on_write(const schema& s);
+
+    // Forgets the write generation of a dropped table. The caches of the
+    // table go away with its prepared statements.
+    static void drop(const utils::UUID& table);
+
+    static key_type make_key(const query_options& options);
+
+private:
+    // Bounds the number of entries of a single statement, so that a statement
+    // executed with ever-changing values doesn't use the shard's whole budget.
+    static constexpr size_t max_entries = 1024;
+
+    struct entry {
+        lw_shared_ptr<query::result> result;
+        clock_type::time_point expires;
+        uint64_t generation;
+        size_t memory;
+    };
+
+    utils::UUID _table;
+    std::unordered_map<key_type, entry> _entries;
+
+    static std::unordered_map<utils::UUID, uint64_t>& write_generations();
+
+    void erase(std::unordered_map<key_type, entry>::iterator it);
+    void erase_expired(clock_type::time_point now);
+public:
+    explicit select_result_cache(utils::UUID table) : _table(table) {}
+    select_result_cache(const select_result_cache&) = delete;
+    ~select_result_cache();
+
+    // The generation of the table's entries. A result read after obtaining it
+    // may be inserted with it, and is ignored if the table was written to since.
+    uint64_t generation() const;
+
+    lw_shared_ptr<query::result> find(const key_type& key);
+
+    void insert(key_type key, lw_shared_ptr<query::result> result, uint64_t generation,
+            std::chrono::milliseconds ttl, size_t memory_limit);
+};
+
+}
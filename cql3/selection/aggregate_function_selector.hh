@@ -18,7 +18,23 @@ namespace cql3 {
 namespace selection {
 
 class aggregate_function_selector : public abstract_function_selector_for<functions::aggregate_function> {
+    // Inputs are passed to the aggregate in batches of that many rows.
+    static constexpr size_t max_buffered_rows = 256;
+
     std::unique_ptr<functions::aggregate_function::aggregate> _aggregate;
+    // Values of each argument of the rows not passed to the aggregate yet.
+    std::vector<std::vector<bytes_opt>> _arg_columns;
+    size_t _buffered_rows = 0;
+
+    void flush(cql_serialization_format sf) {
+        if (_buffered_rows) {
+            _aggregate->add_inputs(sf, _arg_columns, _buffered_rows);
+            for (auto& column : _arg_columns) {
+                column.clear();
+            }
+            _buffered_rows = 0;
+        }
+    }
 public:
     virtual bool is_aggregate() const override {
         return true;
@@ -30,17 +46,24 @@ class aggregate_function_selector : public abstract_function_selector_for<functi
         for (size_t i = 0; i < m; ++i) {
             auto&& s = _arg_selectors[i];
             s->add_input(sf, rs);
-            _args[i] = s->get_output(sf);
+            _arg_columns[i].push_back(s->get_output(sf));
             s->reset();
         }
-        _aggregate->add_input(sf, _args);
+        if (++_buffered_rows == max_buffered_rows) {
+            flush(sf);
+        }
     }
 
     virtual bytes_opt get_output(cql_serialization_format sf) override {
+        flush(sf);
         return _aggregate->compute(sf);
     }
 
     virtual void reset() override {
+        for (auto& column : _arg_columns) {
+            column.clear();
+        }
+        _buffered_rows = 0;
         _aggregate->reset();
     }
 
@@ -48,7 +71,11 @@ class aggregate_function_selector : public abstract_function_selector_for<functi
                 std::vector<shared_ptr<selector>> arg_selectors)
             : abstract_function_selector_for<functions::aggregate_function>(
                     dynamic_pointer_cast<functions::aggregate_function>(func), std::move(arg_selectors))
-            , _aggregate(fun()->new_aggregate()) {
+            , _aggregate(fun()->new_aggregate())
+            , _arg_columns(_arg_selectors.size()) {
+        for (auto& column : _arg_columns) {
+            column.reserve(max_buffered_rows);
+        }
     }
 };
 
@@ -189,6 +189,10 @@ class selection_with_processing : public selection {
         return _factories->get_reductions();
     }
 
+    virtual std::optional<std::vector<std::optional<size_t>>> get_grouped_reduction_layout(const std::vector<sstring>& group_by_columns) const override {
+        return _factories->get_grouped_reduction_layout(group_by_columns);
+    }
+
 protected:
     class selectors_with_processing : public selectors {
     private:
@@ -449,30 +453,27 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
         }
     }
 
-    auto static_row_iterator = static_row.iterator();
-    auto row_iterator = row ? std::optional<query::result_row_view::iterator_type>(row->iterator()) : std::nullopt;
-    const expr::single_column_restrictions_map& non_pk_restrictions_map = _restrictions->get_non_pk_restriction();
-    for (auto&& cdef : selection.get_columns()) {
+    if (!_restrictions_compiled) {
+        compile_restrictions(selection);
+    }
+    // Computed at most once per row, for the first restriction on a static or regular column.
+    std::optional<std::vector<managed_bytes_opt>> static_and_regular_columns;
+    for (auto&& [cdef, restriction] : _compiled_restrictions) {
         switch (cdef->kind) {
         case column_kind::static_column:
             // fallthrough
         case column_kind::regular_column: {
-            if (cdef->kind == column_kind::regular_column && !row_iterator) {
+            if (cdef->kind == column_kind::regular_column && !row) {
                 continue;
             }
-            auto restr_it = non_pk_restrictions_map.find(cdef);
-            if (restr_it == non_pk_restrictions_map.end()) {
-                continue;
+            if (!static_and_regular_columns) {
+                static_and_regular_columns.emplace(expr::get_non_pk_values(selection, static_row, row));
             }
-            const expr::expression& single_col_restriction = restr_it->second;
-            // FIXME: push to upper layer so it happens once per row
-            auto static_and_regular_columns = expr::get_non_pk_values(selection, static_row, row);
-            bool regular_restriction_matches = expr::is_satisfied_by(
-                    single_col_restriction,
+            bool regular_restriction_matches = restriction.is_satisfied_by(
                     expr::evaluation_inputs{
                         .partition_key = &partition_key,
                         .clustering_key = &clustering_key,
-                        .static_and_regular_columns = &static_and_regular_columns,
+                        .static_and_regular_columns = &*static_and_regular_columns,
                         .selection = &selection,
                         .options = &_options,
                     });
@@ -483,17 +484,7 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
             }
             break;
         case column_kind::partition_key: {
-            if (_skip_pk_restrictions) {
-                continue;
-            }
-            auto partition_key_restrictions_map = _restrictions->get_single_column_partition_key_restrictions();
-            auto restr_it = partition_key_restrictions_map.find(cdef);
-            if (restr_it == partition_key_restrictions_map.end()) {
-                continue;
-            }
-            const expr::expression& single_col_restriction = restr_it->second;
-            if (!expr::is_satisfied_by(
-                        single_col_restriction,
+            if (!restriction.is_satisfied_by(
                         expr::evaluation_inputs{
                             .partition_key = &partition_key,
                             .clustering_key = &clustering_key,
@@ -507,21 +498,10 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
             }
             break;
         case column_kind::clustering_key: {
-            if (_skip_ck_restrictions) {
-                continue;
-            }
-            const expr::single_column_restrictions_map& clustering_key_restrictions_map =
-                _restrictions->get_single_column_clustering_key_restrictions();
-            auto restr_it = clustering_key_restrictions_map.find(cdef);
-            if (restr_it == clustering_key_restrictions_map.end()) {
-                continue;
-            }
             if (clustering_key.empty()) {
                 return false;
             }
-            const expr::expression& single_col_restriction = restr_it->second;
-            if (!expr::is_satisfied_by(
-                        single_col_restriction,
+            if (!restriction.is_satisfied_by(
                         expr::evaluation_inputs{
                             .partition_key = &partition_key,
                             .clustering_key = &clustering_key,
@@ -540,6 +520,38 @@ bool result_set_builder::restrictions_filter::do_filter(const selection& selecti
     return true;
 }
 
+void result_set_builder::restrictions_filter::compile_restrictions(const selection& selection) const {
+    const expr::single_column_restrictions_map& non_pk_restrictions_map = _restrictions->get_non_pk_restriction();
+    const expr::single_column_restrictions_map& partition_key_restrictions_map = _restrictions->get_single_column_partition_key_restrictions();
+    const expr::single_column_restrictions_map& clustering_key_restrictions_map = _restrictions->get_single_column_clustering_key_restrictions();
+    for (auto&& cdef : selection.get_columns()) {
+        const expr::single_column_restrictions_map* restrictions_map = nullptr;
+        switch (cdef->kind) {
+        case column_kind::static_column:
+            // fallthrough
+        case column_kind::regular_column:
+            restrictions_map = &non_pk_restrictions_map;
+            break;
+        case column_kind::partition_key:
+            restrictions_map = _skip_pk_restrictions ? nullptr : &partition_key_restrictions_map;
+            break;
+        case column_kind::clustering_key:
+            restrictions_map = _skip_ck_restrictions ? nullptr : &clustering_key_restrictions_map;
+            break;
+        default:
+            break;
+        }
+        if (!restrictions_map) {
+            continue;
+        }
+        auto restr_it = restrictions_map->find(cdef);
+        if (restr_it != restrictions_map->end()) {
+            _compiled_restrictions.emplace_back(cdef, expr::compiled_restriction(restr_it->second, selection, _options));
+        }
+    }
+    _restrictions_compiled = true;
+}
+
 bool result_set_builder::restrictions_filter::operator()(const selection& selection,
                                                          const std::vector<bytes>& partition_key,
                                                          const std::vector<bytes>& clustering_key,
@@ -14,6 +14,7 @@
 #include "schema_fwd.hh"
 #include "query-result-reader.hh"
 #include "cql3/column_specification.hh"
+#include "cql3/expr/expression.hh"
 #include "cql3/selection/selector.hh"
 #include "exceptions/exceptions.hh"
 #include "unimplemented.hh"
@@ -148,6 +149,10 @@ class selection {
 
     virtual query::forward_request::reductions_info get_reductions() const {return {{}, {}};}
 
+    virtual std::optional<std::vector<std::optional<size_t>>> get_grouped_reduction_layout(const std::vector<sstring>& group_by_columns) const {
+        return std::nullopt;
+    }
+
     /**
      * Checks that selectors are either all aggregates or that none of them is.
      *
@@ -229,6 +234,9 @@ class result_set_builder {
         mutable uint64_t _rows_fetched_for_last_partition;
         mutable std::optional<partition_key> _last_pkey;
         mutable bool _is_first_partition_on_page = true;
+        // Restrictions of the columns of the selection, compiled on the first row.
+        mutable std::vector<std::pair<const column_definition*, expr::compiled_restriction>> _compiled_restrictions;
+        mutable bool _restrictions_compiled = false;
     public:
         explicit restrictions_filter(::shared_ptr<const restrictions::statement_restrictions> restrictions,
                 const query_options& options,
@@ -243,6 +251,7 @@ class result_set_builder {
             return _rows_dropped;
         }
     private:
+        void compile_restrictions(const selection& selection) const;
         bool do_filter(const selection& selection, const std::vector<bytes>& pk, const std::vector<bytes>& ck, const query::result_row_view& static_row, const query::result_row_view* row) const;
     };
 
@@ -55,6 +55,29 @@ std::vector<::shared_ptr<selector>> selector_factories::new_instances() const {
     return r;
 }
 
+std::optional<std::vector<std::optional<size_t>>>
+selector_factories::get_grouped_reduction_layout(const std::vector<sstring>& group_by_columns) const {
+    if (!does_aggregation()) {
+        return std::nullopt;
+    }
+    std::vector<std::optional<size_t>> layout;
+    layout.reserve(_factories.size());
+    for (auto&& f : _factories) {
+        if (f->is_simple_selector_factory()) {
+            auto it = std::find(group_by_columns.begin(), group_by_columns.end(), f->column_name());
+            if (it == group_by_columns.end()) {
+                return std::nullopt;
+            }
+            layout.emplace_back(it - group_by_columns.begin());
+        } else if (f->is_reducible_selector_factory() && f->contains_only_simple_arguments()) {
+            layout.emplace_back(std::nullopt);
+        } else {
+            return std::nullopt;
+        }
+    }
+    return layout;
+}
+
 std::vector<sstring> selector_factories::get_column_names() const {
     std::vector<sstring> r;
     r.reserve(_factories.size());
@@ -134,6 +134,10 @@ class selector_factories {
         std::vector<query::forward_request::reduction_type> types;
         std::vector<query::forward_request::aggregation_info> infos;
         for (const auto& factory: _factories) {
+            // Selections of GROUP BY columns are not reduced, see get_grouped_reduction_layout().
+            if (factory->is_simple_selector_factory()) {
+                continue;
+            }
             auto r = factory->get_reduction();
             if (!r) {
                 throw std::runtime_error(format("Column {} doesn't have reduction type", factory->column_name()));
@@ -145,6 +149,18 @@ class selector_factories {
         return {types, infos};
     }
 
+    /**
+     * Describes how the rows of a GROUP BY aggregation are made of the groups and of the results of the
+     * reductions returned by get_reductions(), when the aggregation is parallelized.
+     *
+     * @param group_by_columns the names of the columns the rows are grouped by
+     * @return for each selector, the index in <code>group_by_columns</code> of the column it selects,
+     * or <code>std::nullopt</code> if it is the next of the reductions; <code>std::nullopt</code>
+     * if some selector is neither a reducible aggregate of simple selections nor a selection of a
+     * GROUP BY column
+     */
+    std::optional<std::vector<std::optional<size_t>>> get_grouped_reduction_layout(const std::vector<sstring>& group_by_columns) const;
+
     /**
      * Checks if this <code>SelectorFactories</code> contains at least one factory for writetime selectors.
      *
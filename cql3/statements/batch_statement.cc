@@ -11,6 +11,7 @@
 #include "cql3/util.hh"
 #include "raw/batch_statement.hh"
 #include "db/config.hh"
+#include "cql3/select_result_cache.hh"
 #include "db/consistency_level_validations.hh"
 #include "data_dictionary/data_dictionary.hh"
 #include <seastar/core/execution_stage.hh>
@@ -249,6 +250,12 @@ future<shared_ptr<cql_transport::messages::result_message>> batch_statement::exe
                        seastar::cref(options), false, options.get_timestamp(state));
 }
 
+void batch_statement::invalidate_result_caches() const {
+    for (auto& s : _statements) {
+        select_result_cache::on_write(*s.statement->s);
+    }
+}
+
 future<shared_ptr<cql_transport::messages::result_message>> batch_statement::do_execute(
         query_processor& qp,
         service::query_state& query_state, const query_options& options,
@@ -264,7 +271,9 @@ future<shared_ptr<cql_transport::messages::result_message>> batch_statement::do_
     if (_has_conditions) {
         ++_stats.cas_batches;
         _stats.statements_in_cas_batches += _statements.size();
-        return execute_with_conditions(qp, options, query_state);
+        return execute_with_conditions(qp, options, query_state).finally([this] {
+            invalidate_result_caches();
+        });
     }
 
     ++_stats.batches;
@@ -281,6 +290,9 @@ future<shared_ptr<cql_transport::messages::result_message>> batch_statement::do_
         }
         return make_ready_future<shared_ptr<cql_transport::messages::result_message>>(
                 make_shared<cql_transport::messages::result_message::void_message>());
+    }).finally([this] {
+        // A failed or timed out write may still have been applied on some replicas.
+        invalidate_result_caches();
     });
 }
 
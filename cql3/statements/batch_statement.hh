@@ -143,6 +143,9 @@ class batch_statement : public cql_statement_opt_metadata {
             service::query_state& state) const;
 
     db::timeout_clock::duration get_timeout(const service::client_state& state, const query_options& options) const;
+
+    // Invalidates the cached results of SELECTs on the tables the batch wrote to.
+    void invalidate_result_caches() const;
 public:
     // FIXME: no cql_statement::to_string() yet
 #if 0
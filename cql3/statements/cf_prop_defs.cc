@@ -163,6 +163,14 @@ void cf_prop_defs::validate(const data_dictionary::database db, sstring ks_name,
         }
     }
 
+    if (get_simple(KW_CRC_CHECK_CHANCE)) {
+        double crc_check_chance = get_double(KW_CRC_CHECK_CHANCE, 1.0);
+        if (crc_check_chance < 0.0 || crc_check_chance > 1.0) {
+            throw exceptions::configuration_exception(format(
+                "{} must be between 0.0 and 1.0 (got {})", KW_CRC_CHECK_CHANCE, crc_check_chance));
+        }
+    }
+
     speculative_retry::from_sstring(get_string(KW_SPECULATIVE_RETRY, speculative_retry(speculative_retry::type::NONE, 0).to_sstring()));
 }
 
@@ -329,6 +337,7 @@ void cf_prop_defs::apply_to_builder(schema_builder& builder, schema::extensions_
     }
 
     builder.set_bloom_filter_fp_chance(get_double(KW_BF_FP_CHANCE, builder.get_bloom_filter_fp_chance()));
+    builder.set_crc_check_chance(get_double(KW_CRC_CHECK_CHANCE, builder.get_crc_check_chance()));
     auto compression_options = get_compression_options();
     if (compression_options) {
         builder.set_compressor_params(compression_parameters(*compression_options));
@@ -20,6 +20,7 @@
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/adaptor/indirected.hpp>
 #include "db/config.hh"
+#include "cql3/select_result_cache.hh"
 #include "transport/messages/result_message.hh"
 #include "data_dictionary/data_dictionary.hh"
 #include <seastar/core/execution_stage.hh>
@@ -261,7 +262,9 @@ modification_statement::do_execute(query_processor& qp, service::query_state& qs
     inc_cql_stats(qs.get_client_state().is_internal());
 
     if (has_conditions()) {
-        return execute_with_condition(qp, qs, options);
+        return execute_with_condition(qp, qs, options).finally([this] {
+            select_result_cache::on_write(*s);
+        });
     }
 
     return execute_without_condition(qp, qs, options).then([] (coordinator_result<> res) {
@@ -271,6 +274,9 @@ modification_statement::do_execute(query_processor& qp, service::query_state& qs
         }
         return make_ready_future<::shared_ptr<cql_transport::messages::result_message>>(
                 ::shared_ptr<cql_transport::messages::result_message>{});
+    }).finally([this] {
+        // A failed or timed out write may still have been applied on some replicas.
+        select_result_cache::on_write(*s);
     });
 }
 
@@ -243,8 +243,10 @@ select_statement::make_partition_slice(const query_options& options) const
     }
 
     if (_parameters->is_distinct()) {
-        return query::partition_slice({ query::clustering_range::make_open_ended_both_sides() },
+        auto slice = query::partition_slice({ query::clustering_range::make_open_ended_both_sides() },
             std::move(static_columns), {}, _opts, nullptr, options.get_cql_serialization_format());
+        slice.set_partition_key_filters(make_partition_key_filters(options));
+        return slice;
     }
 
     auto bounds =_restrictions->get_clustering_bounds(options);
@@ -259,8 +261,43 @@ select_statement::make_partition_slice(const query_options& options) const
         std::reverse(bounds.begin(), bounds.end());
         ++_stats.reverse_queries;
     }
-    return query::partition_slice(std::move(bounds),
+    auto slice = query::partition_slice(std::move(bounds),
         std::move(static_columns), std::move(regular_columns), _opts, nullptr, options.get_cql_serialization_format(), get_per_partition_limit(options));
+    slice.set_partition_key_filters(make_partition_key_filters(options));
+    return slice;
+}
+
+std::vector<query::partition_key_filter>
+select_statement::make_partition_key_filters(const query_options& options) const {
+    std::vector<query::partition_key_filter> filters;
+    if (!_restrictions->pk_restrictions_need_filtering()) {
+        return filters;
+    }
+    for (auto&& [cdef, restriction] : _restrictions->get_single_column_partition_key_restrictions()) {
+        // Only comparisons of the column with values, whose possible values are computed exactly.
+        auto unsupported = expr::find_binop(restriction, [cdef = cdef] (const expr::binary_operator& op) {
+            auto col = expr::as_if<expr::column_value>(&op.lhs);
+            return !col || col->col != cdef || !(op.op == expr::oper_t::EQ || op.op == expr::oper_t::IN || expr::is_slice(op.op));
+        });
+        if (unsupported) {
+            continue;
+        }
+        query::partition_key_filter filter{.component = uint32_t(cdef->component_index())};
+        std::visit(overloaded_functor{
+            [&] (const expr::value_list& values) {
+                filter.values.emplace();
+                filter.values->reserve(values.size());
+                for (const auto& v : values) {
+                    filter.values->push_back(to_bytes(v));
+                }
+            },
+            [&] (const nonwrapping_range<managed_bytes>& range) {
+                filter.range = range.transform([] (const managed_bytes& b) { return to_bytes(b); });
+            },
+        }, expr::possible_lhs_values(cdef, restriction, options));
+        filters.push_back(std::move(filter));
+    }
+    return filters;
 }
 
 uint64_t select_statement::do_get_limit(const query_options& options,
@@ -394,6 +431,10 @@ select_statement::do_execute(query_processor& qp,
     if (!aggregate && !_restrictions_need_filtering && (page_size <= 0
             || !service::pager::query_pagers::may_need_paging(*_schema, page_size,
                     *command, key_ranges))) {
+        auto results_ttl = _schema->caching_options().results_ttl();
+        if (results_ttl.count() && select_result_cache::is_cacheable(cl) && !needs_post_query_ordering() && !_parameters->bypass_cache()) {
+            return execute_with_result_cache(qp, command, std::move(key_ranges), state, options, now, results_ttl);
+        }
         return execute_without_checking_exception_message(qp, command, std::move(key_ranges), state, options, now);
     }
 
@@ -648,12 +689,20 @@ indexed_table_select_statement::do_execute_base_query(
     auto cmd = prepare_command_for_base_query(qp, options, state, now, bool(paging_state));
     auto timeout = db::timeout_clock::now() + get_timeout(state.get_client_state(), options);
 
+    using keys_iterator = std::vector<primary_key>::iterator;
+    using batch_result = coordinator_result<foreign_ptr<lw_shared_ptr<query::result>>>;
+    // A range of keys of the same partition, read with a single query.
+    using key_run = std::pair<keys_iterator, keys_iterator>;
     struct base_query_state {
         query::result_merger merger;
         std::vector<primary_key> primary_keys;
-        std::vector<primary_key>::iterator current_primary_key;
+        keys_iterator current_primary_key;
         size_t previous_result_size = 0;
         size_t next_iteration_size = 0;
+        // The read of the keys following the batch being waited for, if it
+        // was started already.
+        std::optional<future<batch_result>> next_batch;
+        keys_iterator next_batch_end;
         base_query_state(uint64_t row_limit, std::vector<primary_key>&& keys)
                 : merger(row_limit, query::max_partitions)
                 , primary_keys(std::move(keys))
@@ -663,41 +712,85 @@ indexed_table_select_statement::do_execute_base_query(
         base_query_state(const base_query_state&) = delete;
     };
 
+    // Reads the base rows of the keys in [begin, end).
+    auto read_batch = [this, &qp, &state, &options, cmd, timeout] (keys_iterator begin, keys_iterator end) -> future<batch_result> {
+        // Keys of the same partition are read together, with one query for all
+        // of their rows. The rows of a partition are returned in clustering order,
+        // so a run of keys is only extended while its clustering keys ascend, to
+        // keep the order of the posting list. For a local index, whose posting
+        // lists are in a single partition, all rows with the same indexed value
+        // are read with one base query instead of one query per row.
+        auto runs = make_lw_shared<std::vector<key_run>>();
+        const clustering_key_prefix::prefix_equal_tri_compare ck_cmp(*_schema);
+        for (auto it = begin; it != end; ++it) {
+            if (!runs->empty() && !cmd->slice.is_reversed() && it->clustering) {
+                auto& prev = *std::prev(it);
+                if (prev.clustering && prev.partition.equal(*_schema, it->partition) && ck_cmp(prev.clustering, it->clustering) < 0) {
+                    runs->back().second = std::next(it);
+                    continue;
+                }
+            }
+            runs->emplace_back(it, std::next(it));
+        }
+
+        query::result_merger oneshot_merger(cmd->get_row_limit(), query::max_partitions);
+        return utils::result_map_reduce(runs->begin(), runs->end(), [this, &qp, &state, &options, cmd, timeout] (const key_run& run) {
+            auto command = ::make_lw_shared<query::read_command>(*cmd);
+            command->slice._row_ranges.clear();
+            for (auto it = run.first; it != run.second; ++it) {
+                if (it->clustering) {
+                    command->slice._row_ranges.push_back(query::clustering_range::make_singular(it->clustering));
+                }
+            }
+            return qp.proxy().query_result(_schema, command, {dht::partition_range::make_singular(run.first->partition)}, options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()})
+            .then(utils::result_wrap([] (service::storage_proxy::coordinator_query_result qr) -> batch_result {
+                return std::move(qr.query_result);
+            }));
+        }, std::move(oneshot_merger)).finally([runs] {});
+    };
+
     base_query_state query_state{cmd->get_row_limit(), std::move(primary_keys)};
     const bool is_paged = bool(paging_state);
-    return do_with(std::move(query_state), [this, is_paged, &qp, &state, &options, cmd, timeout] (auto&& query_state) {
+    return do_with(std::move(query_state), [is_paged, read_batch = std::move(read_batch), cmd] (auto&& query_state) {
         auto &merger = query_state.merger;
         auto &keys = query_state.primary_keys;
         auto &key_it = query_state.current_primary_key;
         auto &previous_result_size = query_state.previous_result_size;
         auto &next_iteration_size = query_state.next_iteration_size;
-        return utils::result_repeat([this, is_paged, &previous_result_size, &next_iteration_size, &keys, &key_it, &merger, &qp, &state, &options, cmd, timeout]() {
-            // Starting with 1 key, we check if the result was a short read, and if not,
-            // we continue exponentially, asking for 2x more key than before
-            auto already_done = std::distance(keys.begin(), key_it);
+        auto &next_batch = query_state.next_batch;
+        auto &next_batch_end = query_state.next_batch_end;
+        // Starting with 1 key, we check if the result was a short read, and if not,
+        // we continue exponentially, asking for 2x more key than before
+        auto batch_end = [&keys, &previous_result_size, &next_iteration_size] (keys_iterator begin) {
+            auto already_done = std::distance(keys.begin(), begin);
             // If the previous result already provided 1MB worth of data,
             // stop increasing the number of fetched partitions
             if (previous_result_size < query::result_memory_limiter::maximum_result_size) {
                 next_iteration_size = already_done + 1;
             }
             next_iteration_size = std::min<size_t>({next_iteration_size, keys.size() - already_done, max_base_table_query_concurrency});
-            auto key_it_end = key_it + next_iteration_size;
-            auto command = ::make_lw_shared<query::read_command>(*cmd);
-
-            query::result_merger oneshot_merger(cmd->get_row_limit(), query::max_partitions);
-            return utils::result_map_reduce(key_it, key_it_end, [this, &qp, &state, &options, cmd, timeout] (auto& key) {
-                auto command = ::make_lw_shared<query::read_command>(*cmd);
-                // for each partition, read just one clustering row (TODO: can
-                // get all needed rows of one partition at once.)
-                command->slice._row_ranges.clear();
-                if (key.clustering) {
-                    command->slice._row_ranges.push_back(query::clustering_range::make_singular(key.clustering));
+            return begin + next_iteration_size;
+        };
+        return utils::result_repeat([is_paged, &previous_result_size, &keys, &key_it, &next_batch, &next_batch_end, &merger, read_batch, batch_end] () {
+            keys_iterator key_it_end;
+            auto current = [&] {
+                if (next_batch) {
+                    key_it_end = next_batch_end;
+                    auto f = std::move(*next_batch);
+                    next_batch.reset();
+                    return f;
                 }
-                return qp.proxy().query_result(_schema, command, {dht::partition_range::make_singular(key.partition)}, options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()})
-                .then(utils::result_wrap([] (service::storage_proxy::coordinator_query_result qr) -> coordinator_result<foreign_ptr<lw_shared_ptr<query::result>>> {
-                    return std::move(qr.query_result);
-                }));
-            }, std::move(oneshot_merger)).then(utils::result_wrap([is_paged, &previous_result_size, &key_it, key_it_end = std::move(key_it_end), &keys, &merger] (foreign_ptr<lw_shared_ptr<query::result>> result) -> coordinator_result<stop_iteration> {
+                key_it_end = batch_end(key_it);
+                return read_batch(key_it, key_it_end);
+            }();
+            // Read the next batch while waiting for this one, so that a page
+            // doesn't take a round trip for each batch. The next batch is wasted
+            // if this one ends the page, which happens at most once per page.
+            if (key_it_end != keys.end() && previous_result_size < query::result_memory_limiter::maximum_result_size) {
+                next_batch_end = batch_end(key_it_end);
+                next_batch = read_batch(key_it_end, next_batch_end);
+            }
+            return current.then(utils::result_wrap([is_paged, &previous_result_size, &key_it, key_it_end, &keys, &merger] (foreign_ptr<lw_shared_ptr<query::result>> result) -> coordinator_result<stop_iteration> {
                 auto is_short_read = result->is_short_read();
                 // Results larger than 1MB should be shipped to the client immediately
                 const bool page_limit_reached = is_paged && result->buf().size() >= query::result_memory_limiter::maximum_result_size;
@@ -706,6 +799,13 @@ indexed_table_select_statement::do_execute_base_query(
                 key_it = key_it_end;
                 return stop_iteration(is_short_read || key_it == keys.end() || page_limit_reached);
             }));
+        }).finally([&next_batch] {
+            if (!next_batch) {
+                return make_ready_future<>();
+            }
+            auto f = std::move(*next_batch);
+            next_batch.reset();
+            return f.discard_result().handle_exception([] (std::exception_ptr) {});
         }).then(utils::result_wrap([&merger, cmd] () mutable {
             return make_ready_future<coordinator_result<value_type>>(value_type(merger.get(), std::move(cmd)));
         }));
@@ -778,6 +878,40 @@ select_statement::execute_without_checking_exception_message(query_processor& qp
     }
 }
 
+future<shared_ptr<cql_transport::messages::result_message>>
+select_statement::execute_with_result_cache(query_processor& qp,
+                          lw_shared_ptr<query::read_command> cmd,
+                          dht::partition_range_vector&& partition_ranges,
+                          service::query_state& state,
+                          const query_options& options,
+                          gc_clock::time_point now,
+                          std::chrono::milliseconds ttl) const
+{
+    if (!_result_cache) {
+        _result_cache = std::make_unique<select_result_cache>(_schema->id());
+    }
+    auto key = select_result_cache::make_key(options);
+    if (auto cached = _result_cache->find(key)) {
+        tracing::trace(state.get_trace_state(), "Serving the result from the coordinator's result cache");
+        return process_results(make_foreign(std::move(cached)), std::move(cmd), options, now);
+    }
+
+    auto generation = _result_cache->generation();
+    auto memory_limit = size_t(qp.db().get_config().select_result_cache_memory_in_mb()) << 20;
+    auto timeout = db::timeout_clock::now() + get_timeout(state.get_client_state(), options);
+    return qp.proxy().query_result(_schema, cmd, std::move(partition_ranges), options.get_consistency(), {timeout, state.get_permit(), state.get_client_state(), state.get_trace_state()})
+        .then(wrap_result_to_error_message([this, &options, now, cmd, key = std::move(key), generation, ttl, memory_limit] (service::storage_proxy::coordinator_query_result qr) mutable {
+            // The result may have been built on another shard, and holds the units of the
+            // result memory limiter until it is processed, so the cache keeps a copy of its
+            // contents which belongs to this shard instead.
+            auto& r = *qr.query_result;
+            auto copy = make_lw_shared<query::result>(bytes_ostream(r.buf()), r.digest(), r.last_modified(), r.is_short_read(),
+                    r.row_count_low_bits(), r.partition_count(), r.row_count_high_bits(), r.last_position());
+            _result_cache->insert(std::move(key), std::move(copy), generation, ttl, memory_limit);
+            return this->process_results(std::move(qr.query_result), cmd, options, now);
+        }));
+}
+
 future<shared_ptr<cql_transport::messages::result_message>>
 indexed_table_select_statement::process_base_query_results(
         foreign_ptr<lw_shared_ptr<query::result>> results,
@@ -1353,6 +1487,29 @@ indexed_table_select_statement::find_index_clustering_rows(query_processor& qp,
     }));
 }
 
+// The columns by which a parallelized GROUP BY aggregation groups rows: the
+// primary key prefix ending with the last GROUP BY column. Key columns which
+// GROUP BY skips are restricted to a single value, so they don't split groups.
+static std::vector<sstring> group_by_key_prefix(const schema& s, const selection::selection& selection, const std::vector<size_t>& group_by_cell_indices) {
+    size_t size = 0;
+    for (auto i : group_by_cell_indices) {
+        auto& def = *selection.get_columns()[i];
+        size = std::max(size, size_t(def.is_partition_key() ? def.id + 1 : s.partition_key_size() + def.id + 1));
+    }
+    std::vector<sstring> names;
+    names.reserve(size);
+    for (auto& def : s.partition_key_columns()) {
+        names.push_back(def.name_as_text());
+    }
+    for (auto& def : s.clustering_key_columns()) {
+        if (names.size() >= size) {
+            break;
+        }
+        names.push_back(def.name_as_text());
+    }
+    return names;
+}
+
 class parallelized_select_statement : public select_statement {
 public:
     static ::shared_ptr<cql3::statements::select_statement> prepare(
@@ -1458,6 +1615,12 @@ parallelized_select_statement::do_execute(
     service::query_state& state,
     const query_options& options
 ) const {
+    // Groups are merged and returned in a single page. Paged GROUP BY
+    // queries are executed by the coordinator, which pages internally.
+    if (has_group_by() && (options.get_page_size() > 0 || options.get_paging_state())) {
+        return select_statement::do_execute(qp, state, options);
+    }
+
     tracing::add_table_name(state.get_trace_state(), keyspace(), column_family());
 
     auto cl = options.get_consistency();
@@ -1501,6 +1664,10 @@ parallelized_select_statement::do_execute(
     auto timeout_duration = get_timeout(state.get_client_state(), options);
     auto timeout = db::timeout_clock::now() + timeout_duration;
     auto reductions = _selection->get_reductions();
+    std::optional<std::vector<sstring>> group_by_columns;
+    if (!_group_by_cell_indices->empty()) {
+        group_by_columns = group_by_key_prefix(*_schema, *_selection, *_group_by_cell_indices);
+    }
 
     query::forward_request req = {
         .reduction_types = reductions.types,
@@ -1509,13 +1676,32 @@ parallelized_select_statement::do_execute(
         .cl = options.get_consistency(),
         .timeout = timeout,
         .aggregation_infos = reductions.infos,
+        .group_by_column_names = group_by_columns,
     };
 
     // dispatch execution of this statement to other nodes
-    return qp.forwarder().dispatch(req, state.get_trace_state()).then([this] (query::forward_result res) {
+    return qp.forwarder().dispatch(req, state.get_trace_state()).then([this, limit = get_limit(options), group_by_columns = std::move(group_by_columns)] (query::forward_result res) {
         auto meta = make_shared<metadata>(*_selection->get_result_metadata());
         auto rs = std::make_unique<result_set>(std::move(meta));
-        rs->add_row(res.query_results);
+        if (!res.grouped_query_results) {
+            rs->add_row(res.query_results);
+        } else {
+            // All groups are returned in a single page; do_execute() only
+            // gets here for unpaged queries.
+            auto layout = *_selection->get_grouped_reduction_layout(*group_by_columns);
+            for (auto& group : *res.grouped_query_results) {
+                if (rs->size() >= limit) {
+                    break;
+                }
+                std::vector<bytes_opt> row;
+                row.reserve(layout.size());
+                auto reduction = group_by_columns->size();
+                for (auto& column : layout) {
+                    row.push_back(column ? group[*column] : std::move(group[reduction++]));
+                }
+                rs->add_row(std::move(row));
+            }
+        }
         update_stats_rows_read(rs->size());
         return shared_ptr<cql_transport::messages::result_message>(
             make_shared<cql_transport::messages::result_message::rows>(result(std::move(rs)))
@@ -1634,14 +1820,22 @@ std::unique_ptr<prepared_statement> select_statement::prepare(data_dictionary::d
     // Used to determine if an execution of this statement can be parallelized
     // using `forward_service`.
     auto can_be_forwarded = [&] {
+        // GROUP BY is merged per group, and only when the selectors are
+        // reductions and the columns rows are grouped by.
+        auto can_group_by_be_forwarded = [&] {
+            return db.features().parallelized_group_by
+                && selection->get_grouped_reduction_layout(group_by_key_prefix(*schema, *selection, *group_by_cell_indices))
+                && _parameters->orderings().empty()
+                && !_per_partition_limit;
+        };
         return selection->is_aggregate()        // Aggregation only
             && ( // SUPPORTED PARALLELIZATION
                  // All potential intermediate coordinators must support forwarding
-                (db.features().parallelized_aggregation && selection->is_count())
-                || (db.features().uda_native_parallelized_aggregation && selection->is_reducible())
+                (group_by_cell_indices->empty() && db.features().parallelized_aggregation && selection->is_count())
+                || (group_by_cell_indices->empty() && db.features().uda_native_parallelized_aggregation && selection->is_reducible())
+                || (!group_by_cell_indices->empty() && can_group_by_be_forwarded())
             )
             && !restrictions->need_filtering()  // No filtering
-            && group_by_cell_indices->empty()   // No GROUP BY
             && db.get_config().enable_parallelized_aggregation();
     };
 
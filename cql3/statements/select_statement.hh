@@ -13,6 +13,7 @@
 #include "cql3/statements/raw/select_statement.hh"
 #include "cql3/cql_statement.hh"
 #include "cql3/stats.hh"
+#include "cql3/select_result_cache.hh"
 #include <seastar/core/shared_ptr.hh>
 #include "transport/messages/result_message.hh"
 #include "index/secondary_index_manager.hh"
@@ -79,6 +80,8 @@ class select_statement : public cql_statement {
     bool _range_scan = false;
     bool _range_scan_no_bypass_cache = false;
     std::unique_ptr<cql3::attributes> _attrs;
+    // Created by the first execution which may use it, see caching_options::results_ttl().
+    mutable std::unique_ptr<select_result_cache> _result_cache;
 protected :
     virtual future<::shared_ptr<cql_transport::messages::result_message>> do_execute(query_processor& qp,
         service::query_state& state, const query_options& options) const;
@@ -117,6 +120,12 @@ protected :
         lw_shared_ptr<query::read_command> cmd, dht::partition_range_vector&& partition_ranges, service::query_state& state,
          const query_options& options, gc_clock::time_point now) const;
 
+    // Like execute_without_checking_exception_message(), but serves the result
+    // from the statement's result cache when possible.
+    future<::shared_ptr<cql_transport::messages::result_message>> execute_with_result_cache(query_processor& qp,
+        lw_shared_ptr<query::read_command> cmd, dht::partition_range_vector&& partition_ranges, service::query_state& state,
+         const query_options& options, gc_clock::time_point now, std::chrono::milliseconds ttl) const;
+
     struct primary_key {
         dht::decorated_key partition;
         clustering_key_prefix clustering;
@@ -131,6 +140,9 @@ protected :
 
     query::partition_slice make_partition_slice(const query_options& options) const;
 
+    // The filtering restrictions on partition key columns which replicas can apply.
+    std::vector<query::partition_key_filter> make_partition_key_filters(const query_options& options) const;
+
     const ::shared_ptr<const restrictions::statement_restrictions> get_restrictions() const;
 
     bool has_group_by() const { return _group_by_cell_indices && !_group_by_cell_indices->empty(); }
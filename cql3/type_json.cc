@@ -17,6 +17,7 @@
 #include "types/user.hh"
 #include "types/listlike_partial_deserializing_iterator.hh"
 #include "utils/managed_bytes.hh"
+#include "bytes_ostream.hh"
 #include "exceptions/exceptions.hh"
 #include <limits>
 #include <utility>
@@ -342,124 +343,118 @@ template <typename T> static T compose_value(const integer_type_impl<T>& t, byte
     return read_be<T>(reinterpret_cast<const char*>(bv.data()));
 }
 
-static sstring to_json_string_aux(const map_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
+static void append(bytes_ostream& out, std::string_view s) {
+    out.write(s.data(), s.size());
+}
+
+static void write_json(bytes_ostream& out, const abstract_type& t, const managed_bytes_view& mbv) {
+    with_linearized(mbv, [&] (bytes_view bv) {
+        write_json(out, t, bv);
+    });
+}
+
+static void write_json_aux(bytes_ostream& out, const map_type_impl& t, bytes_view bv) {
     auto sf = cql_serialization_format::internal();
 
-    out << '{';
+    append(out, "{");
     auto size = read_collection_size(bv, sf);
     for (int i = 0; i < size; ++i) {
         auto kb = read_collection_value(bv, sf);
         auto vb = read_collection_value(bv, sf);
 
         if (i > 0) {
-            out << ", ";
+            append(out, ", ");
         }
 
         // Valid keys in JSON map must be quoted strings
         sstring string_key = to_json_string(*t.get_keys_type(), kb);
         bool is_unquoted = string_key.empty() || string_key[0] != '"';
         if (is_unquoted) {
-            out << '"';
+            append(out, "\"");
         }
-        out << string_key;
+        append(out, string_key);
         if (is_unquoted) {
-            out << '"';
+            append(out, "\"");
         }
-        out << ": ";
-        out << to_json_string(*t.get_values_type(), vb);
+        append(out, ": ");
+        write_json(out, *t.get_values_type(), vb);
     }
-    out << '}';
-    return out.str();
-}
-
-static sstring to_json_string_aux(const set_type_impl& t, bytes_view bv) {
-    using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
-    bool first = true;
-    auto sf = cql_serialization_format::internal();
-    out << '[';
-    managed_bytes_view mbv(bv);
-    std::for_each(llpdi::begin(mbv, sf), llpdi::end(mbv, sf), [&first, &out, &t] (const managed_bytes_view& e) {
-        if (first) {
-            first = false;
-        } else {
-            out << ", ";
-        }
-        out << to_json_string(*t.get_elements_type(), e);
-    });
-    out << ']';
-    return out.str();
+    append(out, "}");
 }
 
-static sstring to_json_string_aux(const list_type_impl& t, bytes_view bv) {
+static void write_json_aux(bytes_ostream& out, const listlike_collection_type_impl& t, bytes_view bv) {
     using llpdi = listlike_partial_deserializing_iterator;
-    std::ostringstream out;
     bool first = true;
     auto sf = cql_serialization_format::internal();
-    out << '[';
+    append(out, "[");
     managed_bytes_view mbv(bv);
     std::for_each(llpdi::begin(mbv, sf), llpdi::end(mbv, sf), [&first, &out, &t] (const managed_bytes_view& e) {
         if (first) {
             first = false;
         } else {
-            out << ", ";
+            append(out, ", ");
         }
-        out << to_json_string(*t.get_elements_type(), e);
+        write_json(out, *t.get_elements_type(), e);
     });
-    out << ']';
-    return out.str();
+    append(out, "]");
 }
 
-static sstring to_json_string_aux(const tuple_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
-    out << '[';
+static void write_json_aux(bytes_ostream& out, const tuple_type_impl& t, bytes_view bv) {
+    append(out, "[");
 
     auto ti = t.all_types().begin();
     auto vi = tuple_deserializing_iterator::start(bv);
     while (ti != t.all_types().end() && vi != tuple_deserializing_iterator::finish(bv)) {
         if (ti != t.all_types().begin()) {
-            out << ", ";
+            append(out, ", ");
         }
         if (*vi) {
             // TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
+            write_json(out, **ti, **vi);
         } else {
-            out << "null";
+            append(out, "null");
         }
         ++ti;
         ++vi;
     }
 
-    out << ']';
-    return out.str();
+    append(out, "]");
 }
 
-static sstring to_json_string_aux(const user_type_impl& t, bytes_view bv) {
-    std::ostringstream out;
-    out << '{';
+static void write_json_aux(bytes_ostream& out, const user_type_impl& t, bytes_view bv) {
+    append(out, "{");
 
     auto ti = t.all_types().begin();
     auto vi = tuple_deserializing_iterator::start(bv);
     int i = 0;
     while (ti != t.all_types().end() && vi != tuple_deserializing_iterator::finish(bv)) {
         if (ti != t.all_types().begin()) {
-            out << ", ";
+            append(out, ", ");
         }
-        out << quote_json_string(t.field_name_as_string(i)) << ": ";
+        append(out, quote_json_string(t.field_name_as_string(i)));
+        append(out, ": ");
         if (*vi) {
             //TODO(sarna): We can avoid copying if to_json_string accepted bytes_view
-            out << to_json_string(**ti, **vi);
+            write_json(out, **ti, **vi);
         } else {
-            out << "null";
+            append(out, "null");
         }
         ++ti;
         ++i;
         ++vi;
     }
 
-    out << '}';
-    return out.str();
+    append(out, "}");
+}
+
+// Collections, tuples and user types are written into a single buffer,
+// instead of building a string for each of their elements.
+template <typename Type>
+static sstring to_json_string_aux(const Type& t, bytes_view bv) {
+    bytes_ostream out;
+    write_json_aux(out, t, bv);
+    auto v = out.linearize();
+    return sstring(reinterpret_cast<const char*>(v.data()), v.size());
 }
 
 namespace {
@@ -521,10 +516,29 @@ struct to_json_string_visitor {
 };
 }
 
+namespace {
+struct write_json_visitor {
+    bytes_ostream& out;
+    bytes_view bv;
+    void operator()(const reversed_type_impl& t) { write_json(out, *t.underlying_type(), bv); }
+    void operator()(const map_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const set_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const list_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const tuple_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const user_type_impl& t) { write_json_aux(out, t, bv); }
+    void operator()(const counter_type_impl& t) { write_json(out, *counter_cell_view::total_value_type(), bv); }
+    template <typename T> void operator()(const T& t) { append(out, to_json_string_visitor{bv}(t)); }
+};
+}
+
 sstring to_json_string(const abstract_type& t, bytes_view bv) {
     return visit(t, to_json_string_visitor{bv});
 }
 
+void write_json(bytes_ostream& out, const abstract_type& t, bytes_view bv) {
+    visit(t, write_json_visitor{out, bv});
+}
+
 sstring to_json_string(const abstract_type& t, const managed_bytes_view& mbv) {
     return visit(t, to_json_string_visitor{linearized(mbv)});
 }
@@ -11,10 +11,16 @@
 #include "types.hh"
 #include "utils/rjson.hh"
 
+class bytes_ostream;
+
 bytes from_json_object(const abstract_type &t, const rjson::value& value, cql_serialization_format sf);
 sstring to_json_string(const abstract_type &t, bytes_view bv);
 sstring to_json_string(const abstract_type &t, const managed_bytes_view& bv);
 
+// Appends the JSON representation of a value to out, like to_json_string()
+// but without building a string for it.
+void write_json(bytes_ostream& out, const abstract_type& t, bytes_view bv);
+
 inline sstring to_json_string(const abstract_type &t, const bytes& b) {
     return to_json_string(t, bytes_view(b));
 }
@@ -42,6 +42,7 @@
 #include "cql3/untyped_result_set.hh"
 #include "service_permit.hh"
 #include "cql3/query_processor.hh"
+#include "replica/database.hh"
 
 static logging::logger blogger("batchlog_manager");
 
@@ -159,8 +160,10 @@ future<> db::batchlog_manager::replay_all_failed_batches() {
     // max rate is scaled by the number of nodes in the cluster (same as for HHOM - see CASSANDRA-5272).
     auto throttle = _replay_rate / _qp.proxy().get_token_metadata_ptr()->count_normal_token_owners();
     auto limiter = make_lw_shared<utils::rate_limiter>(throttle);
+    // The number of batches replayed and deleted.
+    auto deleted = make_lw_shared<size_t>(0);
 
-    auto batch = [this, limiter](const cql3::untyped_result_set::row& row) {
+    auto batch = [this, limiter, deleted](const cql3::untyped_result_set::row& row) {
         auto written_at = row.get_as<db_clock::time_point>("written_at");
         auto id = row.get_as<utils::UUID>("id");
         // enough time for the actual write + batchlog entry mutation delivery (two separate requests).
@@ -247,7 +250,7 @@ future<> db::batchlog_manager::replay_all_failed_batches() {
                 // See below, we use retry on write failure.
                 return _qp.proxy().mutate(mutations, db::consistency_level::ALL, db::no_timeout, nullptr, empty_service_permit(), db::allow_per_partition_rate_limit::no);
             });
-        }).then_wrapped([this, id](future<> batch_result) {
+        }).then_wrapped([this, id, deleted](future<> batch_result) {
             try {
                 batch_result.get();
             } catch (data_dictionary::no_such_keyspace& ex) {
@@ -266,11 +269,13 @@ future<> db::batchlog_manager::replay_all_failed_batches() {
             mutation m(schema, key);
             auto now = service::client_state(service::client_state::internal_tag()).get_timestamp();
             m.partition().apply_delete(*schema, clustering_key_prefix::make_empty(), tombstone(now, gc_clock::now()));
-            return _qp.proxy().mutate_locally(m, tracing::trace_state_ptr(), db::commitlog::force_sync::no);
+            return _qp.proxy().mutate_locally(m, tracing::trace_state_ptr(), db::commitlog::force_sync::no).then([deleted] {
+                ++*deleted;
+            });
         });
     };
 
-    return seastar::with_gate(_gate, [this, batch = std::move(batch)] {
+    return seastar::with_gate(_gate, [this, batch = std::move(batch), deleted] {
         blogger.debug("Started replayAllFailedBatches (cpu {})", this_shard_id());
 
         typedef ::shared_ptr<cql3::untyped_result_set> page_ptr;
@@ -297,19 +302,18 @@ future<> db::batchlog_manager::replay_all_failed_batches() {
                     });
                 });
             });
-        }).then([this] {
-        // TODO FIXME : cleanup()
-#if 0
-            ColumnFamilyStore cfs = Keyspace.open(SystemKeyspace.NAME).getColumnFamilyStore(SystemKeyspace.BATCHLOG);
-            cfs.forceBlockingFlush();
-            Collection<Descriptor> descriptors = new ArrayList<>();
-            for (SSTableReader sstr : cfs.getSSTables())
-            descriptors.add(sstr.descriptor);
-            if (!descriptors.isEmpty()) // don't pollute the logs if there is nothing to compact.
-            CompactionManager.instance.submitUserDefined(cfs, descriptors, Integer.MAX_VALUE).get();
-
-#endif
-
+        }).then([this, deleted] {
+            if (!*deleted) {
+                return make_ready_future<>();
+            }
+            // The batchlog has a gc_grace_seconds of 0, so the tombstones of
+            // the replayed batches can be purged right away. Do it, so that the
+            // next replay doesn't have to scan past them. The batchlog is small,
+            // and compacting it is cheap.
+            blogger.debug("Compacting the batchlog after deleting {} batches", *deleted);
+            return _qp.proxy().get_db().invoke_on_all([] (replica::database& db) {
+                return db.find_column_family(system_keyspace::NAME, system_keyspace::BATCHLOG).compact_all_sstables();
+            });
         }).then([this] {
             blogger.debug("Finished replayAllFailedBatches");
         });
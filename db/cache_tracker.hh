@@ -12,6 +12,7 @@
 #include "utils/logalloc.hh"
 #include "partition_version.hh"
 #include "mutation_cleaner.hh"
+#include "absent_partition_cache.hh"
 
 #include <seastar/core/metrics_registration.hh>
 
@@ -66,6 +67,8 @@ class cache_tracker final {
         uint64_t pinned_dirty_memory_overload;
         uint64_t range_tombstone_reads;
         uint64_t row_tombstone_reads;
+        uint64_t partition_snapshot_reads;
+        uint64_t partition_snapshot_versions;
 
         uint64_t active_reads() const {
             return reads - reads_done;
@@ -79,6 +82,9 @@ class cache_tracker final {
     mutation_cleaner _garbage;
     mutation_cleaner _memtable_cleaner;
     mutation_application_stats& _app_stats;
+    absent_partition_cache _absent_partitions;
+    size_t _reserved_memory = 0;
+    size_t _max_memory = 0;
 private:
     void setup_metrics();
 public:
@@ -110,6 +116,11 @@ class cache_tracker final {
     void on_row_merged_from_memtable() noexcept { ++_stats.rows_merged_from_memtable; }
     void on_range_tombstone_read() noexcept { ++_stats.range_tombstone_reads; }
     void on_row_tombstone_read() noexcept { ++_stats.row_tombstone_reads; }
+    // A read of a partition which has to merge the given number of versions.
+    void on_partition_snapshot_read(unsigned versions) noexcept {
+        ++_stats.partition_snapshot_reads;
+        _stats.partition_snapshot_versions += versions;
+    }
     void pinned_dirty_memory_overload(uint64_t bytes) noexcept;
     allocation_strategy& allocator() noexcept;
     logalloc::region& region() noexcept;
@@ -120,6 +131,15 @@ class cache_tracker final {
     const stats& get_stats() const noexcept { return _stats; }
     void set_compaction_scheduling_group(seastar::scheduling_group);
     lru& get_lru() { return _lru; }
+    absent_partition_cache& absent_partitions() noexcept { return _absent_partitions; }
+    // Bounds the memory used by the cache, 0 meaning unbounded.
+    // Reclamation doesn't evict from the cache once it uses less than
+    // reserved_memory. max_memory is enforced by enforce_memory_limit().
+    // Used for trackers dedicated to a single table.
+    void set_memory_limits(size_t reserved_memory, size_t max_memory) noexcept;
+    // Evicts until the cache uses no more than max_memory.
+    // Must not be called inside an allocating section of the region.
+    void enforce_memory_limit() noexcept;
 };
 
 inline
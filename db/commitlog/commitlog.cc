@@ -33,6 +33,7 @@
 #include <seastar/core/chunked_fifo.hh>
 #include <seastar/core/queue.hh>
 #include <seastar/core/sleep.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/net/byteorder.hh>
@@ -59,6 +60,7 @@
 
 #include "checked-file-impl.hh"
 #include "utils/disk-error-handler.hh"
+#include "compress.hh"
 
 static logging::logger clogger("commitlog");
 
@@ -104,9 +106,17 @@ db::commitlog::config db::commitlog::config::from_db_config(const db::config& cf
     c.commitlog_total_space_in_mb = cfg.commitlog_total_space_in_mb() >= 0 ? cfg.commitlog_total_space_in_mb() : (shard_available_memory * smp::count) >> 20;
     c.commitlog_segment_size_in_mb = cfg.commitlog_segment_size_in_mb();
     c.commitlog_sync_period_in_ms = cfg.commitlog_sync_period_in_ms();
-    c.mode = cfg.commitlog_sync() == "batch" ? sync_mode::BATCH : sync_mode::PERIODIC;
+    c.commitlog_sync_group_window_in_ms = cfg.commitlog_sync_group_window_in_ms();
+    if (cfg.commitlog_sync() == "batch") {
+        c.mode = sync_mode::BATCH;
+    } else if (cfg.commitlog_sync() == "group") {
+        c.mode = sync_mode::GROUP;
+    } else {
+        c.mode = sync_mode::PERIODIC;
+    }
     c.extensions = &cfg.extensions();
     c.use_o_dsync = cfg.commitlog_use_o_dsync();
+    c.use_compression = cfg.commitlog_compression();
     c.allow_going_over_size_limit = !cfg.commitlog_use_hard_size_limit();
 
     if (cfg.commitlog_flush_threshold_in_mb() >= 0) {
@@ -380,6 +390,9 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
         uint64_t requests_blocked_memory = 0;
         uint64_t blocked_on_new_segment = 0;
         uint64_t active_allocations = 0;
+        uint64_t group_syncs = 0;
+        uint64_t compressed_entries = 0;
+        uint64_t bytes_saved_by_compression = 0;
     };
 
     class scope_increment_counter {
@@ -401,6 +414,17 @@ class db::commitlog::segment_manager : public ::enable_shared_from_this<segment_
 
     typename std::chrono::high_resolution_clock::time_point last_time;
 
+    // Moving averages of the latency of GROUP mode syncs and of the interval
+    // between writes waiting for them, see group_window().
+    double group_sync_latency_us = 0;
+    double group_write_interval_us = 0;
+    std::chrono::steady_clock::time_point last_group_write;
+
+    void on_group_write() noexcept;
+    void on_group_sync(std::chrono::steady_clock::duration latency) noexcept;
+    // How long the first write of a group should wait for others before syncing.
+    std::chrono::microseconds group_window() const noexcept;
+
     size_t pending_allocations() const {
         return _request_controller.waiters();
     }
@@ -692,6 +716,8 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
     std::unordered_map<cf_id_type, uint64_t> _cf_dirty;
     time_point _sync_time;
     utils::flush_queue<replay_position, std::less<replay_position>, clock_type> _pending_ops;
+    // The sync which GROUP mode writes join, until it starts.
+    std::optional<shared_future<>> _group_sync;
 
     uint64_t _num_allocs = 0;
 
@@ -731,6 +757,11 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
     static constexpr size_t descriptor_header_size = 5 * sizeof(uint32_t);
     static constexpr uint32_t segment_magic = ('S'<<24) |('C'<< 16) | ('L' << 8) | 'C';
     static constexpr uint32_t multi_entry_size_magic = 0xffffffff;
+    // Set in the size of compressed entries of segment_version_3 segments.
+    static constexpr uint32_t compressed_entry_flag = 0x80000000;
+    // Smaller entries rarely compress, larger ones would need large contiguous buffers.
+    static constexpr size_t min_compressed_entry_size = 256;
+    static constexpr size_t max_compressed_entry_size = 128 * 1024;
 
     // The commit log (chained) sync marker/header size in bytes (int: length + int: checksum [segmentId, position])
     static constexpr size_t sync_marker_size = 2 * sizeof(uint32_t);
@@ -789,7 +820,7 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
     }
 
     bool must_sync() {
-        if (_segment_manager->cfg.mode == sync_mode::BATCH) {
+        if (_segment_manager->cfg.mode != sync_mode::PERIODIC) {
             return false;
         }
         auto now = clock_type::now();
@@ -1111,6 +1142,37 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         co_return me;
     }
 
+    future<sseg_ptr> group_cycle(timeout_clock::time_point timeout) {
+        /**
+         * For group mode, the first write of a group lets others join
+         * for a while, after which a single batch_cycle() writes and
+         * flushes the data of all of them.
+         */
+        auto me = shared_from_this();
+        _segment_manager->on_group_write();
+        if (!_group_sync) {
+            auto window = _segment_manager->group_window();
+            if (timeout != db::no_timeout) {
+                window = std::min(window, std::chrono::duration_cast<std::chrono::microseconds>(timeout - timeout_clock::now()));
+            }
+            ++_segment_manager->totals.group_syncs;
+            _group_sync.emplace(group_sync(window));
+        }
+        co_await _group_sync->get_future(timeout);
+        co_return me;
+    }
+
+    future<> group_sync(std::chrono::microseconds window) {
+        auto me = shared_from_this();
+        // Defers even for an empty window, so that _group_sync is engaged before it is reset below.
+        co_await seastar::sleep(window);
+        // Writes allocated from now on are not guaranteed to make it into this sync.
+        _group_sync.reset();
+        auto start = std::chrono::steady_clock::now();
+        co_await batch_cycle(db::no_timeout);
+        _segment_manager->on_group_sync(std::chrono::steady_clock::now() - start);
+    }
+
     void background_cycle() {
         //FIXME: discarded future
         (void)cycle().discard_result().handle_exception([] (auto ex) {
@@ -1123,8 +1185,43 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         must_sync,
         no_space,
         ok_need_batch_sync,
+        ok_need_group_sync,
+    };
+
+    struct prepared_entry {
+        temporary_buffer<char> data;
+        bool compressed;
     };
 
+    /**
+     * Serialize an entry and compress it if that saves at least an eighth of it.
+     * Entries outside of the compressible size range are not prepared, and are
+     * serialized directly into the segment buffer instead.
+     */
+    std::optional<prepared_entry> prepare_entry(entry_writer& writer, size_t entry, size_t entry_size) {
+        if (entry_size < min_compressed_entry_size || entry_size > max_compressed_entry_size) {
+            return std::nullopt;
+        }
+        temporary_buffer<char> data(entry_size);
+        {
+            std::vector<temporary_buffer<char>> frags;
+            frags.emplace_back(data.share());
+            fragmented_temporary_buffer buf(std::move(frags), entry_size);
+            auto out = buf.get_ostream();
+            writer.write(*this, out, entry);
+        }
+        auto& lz4 = *compressor::lz4;
+        temporary_buffer<char> compressed(lz4.compress_max_size(entry_size));
+        auto compressed_size = lz4.compress(data.get(), entry_size, compressed.get_write(), compressed.size());
+        if (compressed_size > entry_size - entry_size / 8) {
+            return prepared_entry{std::move(data), false};
+        }
+        compressed.trim(compressed_size);
+        ++_segment_manager->totals.compressed_entries;
+        _segment_manager->totals.bytes_saved_by_compression += entry_size - compressed_size;
+        return prepared_entry{std::move(compressed), true};
+    }
+
     /**
      * Add a "mutation" to the segment.
      * Should only be called from "allocate_when_possible". "this" must be secure in a shared_ptr that will not
@@ -1136,14 +1233,14 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
         }
 
         const auto size = writer.size(*this);
-        const auto s = size + writer.num_entries * entry_overhead_size + (writer.num_entries > 1 ? multi_entry_overhead_size : 0u); // total size
+        auto s = size + writer.num_entries * entry_overhead_size + (writer.num_entries > 1 ? multi_entry_overhead_size : 0u); // total size
 
         _segment_manager->sanity_check_size(s);
 
         if (!is_still_allocating() || position() + s > _segment_manager->max_size) { // would we make the file too big?
             return write_result::no_space;
         } else if (!_buffer.empty() && (s > _buffer_ostream.size())) {  // enough data?
-            if (_segment_manager->cfg.mode == sync_mode::BATCH || writer.sync) {
+            if (_segment_manager->cfg.mode != sync_mode::PERIODIC || writer.sync) {
                 // TODO: this could cause starvation if we're really unlucky.
                 // If we run batch mode and find ourselves not fit in a non-empty
                 // buffer, we must force a cycle and wait for it (to keep flush order)
@@ -1163,8 +1260,28 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
             throw std::runtime_error("commitlog: Cannot add data to a closed segment");
         }
 
-        buf_memory -= permit.release();
-        _segment_manager->account_memory_usage(buf_memory);
+        // Entries are serialized up front when compressing, because the multi-entry header
+        // holds the total size. The checks above used the uncompressed size, which is larger.
+        std::vector<std::optional<prepared_entry>> prepared;
+        if (_desc.ver >= descriptor::segment_version_3) {
+            prepared.reserve(writer.num_entries);
+            for (size_t entry = 0; entry < writer.num_entries; ++entry) {
+                auto entry_size = writer.num_entries == 1 ? size : writer.size(*this, entry);
+                prepared.emplace_back(prepare_entry(writer, entry, entry_size));
+                if (prepared.back()) {
+                    s -= entry_size - prepared.back()->data.size();
+                    buf_memory -= entry_size - prepared.back()->data.size();
+                }
+            }
+        }
+
+        // Compression may leave less to write than the permit covers.
+        auto permit_units = permit.release();
+        if (buf_memory >= permit_units) {
+            _segment_manager->account_memory_usage(buf_memory - permit_units);
+        } else {
+            _segment_manager->notify_memory_written(permit_units - buf_memory);
+        }
 
         auto& out = _buffer_ostream;
 
@@ -1200,17 +1317,28 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
 
             crc32_nbo crc;
 
-            write<uint32_t>(out, es);
-            crc.process(uint32_t(es));
-            write<uint32_t>(out, crc.checksum());
-
-            // actual data
-            auto entry_out = out.write_substream(entry_size);
-            auto entry_data = entry_out.to_input_stream();
-            writer.write(*this, entry_out, entry);
-            entry_data.with_stream([&] (auto data_str) {
-                crc.process_fragmented(ser::buffer_view<typename std::vector<temporary_buffer<char>>::iterator>(data_str));
-            });
+            if (!prepared.empty() && prepared[entry]) {
+                auto& p = *prepared[entry];
+                es = p.data.size() + entry_overhead_size;
+                auto size_field = uint32_t(es) | (p.compressed ? compressed_entry_flag : 0);
+                write<uint32_t>(out, size_field);
+                crc.process(size_field);
+                write<uint32_t>(out, crc.checksum());
+                out.write(p.data.get(), p.data.size());
+                crc.process_bytes(p.data.get(), p.data.size());
+            } else {
+                write<uint32_t>(out, es);
+                crc.process(uint32_t(es));
+                write<uint32_t>(out, crc.checksum());
+
+                // actual data
+                auto entry_out = out.write_substream(entry_size);
+                auto entry_data = entry_out.to_input_stream();
+                writer.write(*this, entry_out, entry);
+                entry_data.with_stream([&] (auto data_str) {
+                    crc.process_fragmented(ser::buffer_view<typename std::vector<temporary_buffer<char>>::iterator>(data_str));
+                });
+            }
 
             auto checksum = crc.checksum();
             write<uint32_t>(out, checksum);
@@ -1231,6 +1359,8 @@ class db::commitlog::segment : public enable_shared_from_this<segment>, public c
 
         if (_segment_manager->cfg.mode == sync_mode::BATCH || writer.sync) {
             return write_result::ok_need_batch_sync;
+        } else if (_segment_manager->cfg.mode == sync_mode::GROUP) {
+            return write_result::ok_need_group_sync;
         } else {
             // If this buffer alone is too big, potentially bigger than the maximum allowed size,
             // then no other request will be allowed in to force the cycle()ing of this buffer. We
@@ -1340,6 +1470,9 @@ future<R> db::commitlog::segment_manager::allocate_when_possible(T writer, db::t
             case write_result::ok_need_batch_sync:
                 s = co_await s->batch_cycle(timeout);
                 co_return writer.result();
+            case write_result::ok_need_group_sync:
+                s = co_await s->group_cycle(timeout);
+                co_return writer.result();
         }
     }
 }
@@ -1393,6 +1526,7 @@ db::commitlog::segment_manager::segment_manager(config c)
 {
     assert(max_size > 0);
     assert(max_mutation_size < segment::multi_entry_size_magic);
+    assert(!cfg.use_compression || max_mutation_size + segment::entry_overhead_size < segment::compressed_entry_flag);
 
     clogger.trace("Commitlog {} maximum disk size: {} MB / cpu ({} cpus)",
             cfg.commit_log_location, max_disk_size / (1024 * 1024),
@@ -1513,6 +1647,19 @@ void db::commitlog::segment_manager::create_counters(const sstring& metrics_cate
         sm::make_counter("flush", totals.flush_count,
                        sm::description("Counts number of times the flush() method was called for a file.")),
 
+        sm::make_counter("group_syncs", totals.group_syncs,
+                       sm::description("Counts number of syncs shared by groups of writes in group sync mode. "
+                                       "Divide \"alloc\" by this value to get the average number of mutations per sync.")),
+
+        sm::make_gauge("group_sync_window", [this] { return group_window().count(); },
+                       sm::description("Holds the time in microseconds the first write of a group waits for others to join before syncing, in group sync mode.")),
+
+        sm::make_counter("compressed_entries", totals.compressed_entries,
+                       sm::description("Counts number of entries written compressed.")),
+
+        sm::make_counter("bytes_saved_by_compression", totals.bytes_saved_by_compression,
+                       sm::description("Counts number of bytes by which compression reduced the size of written entries.")),
+
         sm::make_counter("bytes_written", totals.bytes_written,
                        sm::description("Counts number of bytes written to the disk. "
                                        "Divide this value by \"alloc\" to get the average number of bytes per mutation written to the disk.")),
@@ -1752,7 +1899,7 @@ future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager:
 
 future<db::commitlog::segment_manager::sseg_ptr> db::commitlog::segment_manager::allocate_segment() {
     for (;;) {
-        descriptor d(next_id(), cfg.fname_prefix);
+        descriptor d(next_id(), cfg.fname_prefix, cfg.use_compression ? descriptor::segment_version_3 : descriptor::segment_version_2);
         auto dst = filename(d);
         auto flags = open_flags::wo;
         if (cfg.use_o_dsync) {
@@ -2177,6 +2324,28 @@ future<> db::commitlog::segment_manager::clear() {
     }
     co_await orphan_all();
 }
+void db::commitlog::segment_manager::on_group_write() noexcept {
+    auto now = std::chrono::steady_clock::now();
+    auto interval = std::chrono::duration<double, std::micro>(now - std::exchange(last_group_write, now)).count();
+    group_write_interval_us = group_write_interval_us * 0.9 + interval * 0.1;
+}
+
+void db::commitlog::segment_manager::on_group_sync(std::chrono::steady_clock::duration latency) noexcept {
+    auto us = std::chrono::duration<double, std::micro>(latency).count();
+    group_sync_latency_us = group_sync_latency_us ? group_sync_latency_us * 0.9 + us * 0.1 : us;
+}
+
+std::chrono::microseconds db::commitlog::segment_manager::group_window() const noexcept {
+    // Delaying the sync only pays off if other writes are expected to join meanwhile.
+    // Waiting for about as long as a sync takes halves the number of syncs needed by
+    // a steady stream of writes, while adding at most one sync latency to each of them.
+    if (group_write_interval_us >= group_sync_latency_us) {
+        return std::chrono::microseconds(0);
+    }
+    return std::min<std::chrono::microseconds>(std::chrono::milliseconds(cfg.commitlog_sync_group_window_in_ms),
+            std::chrono::microseconds(uint64_t(group_sync_latency_us)));
+}
+
 /**
  * Called by timer in periodic mode.
  */
@@ -2197,7 +2366,7 @@ void db::commitlog::segment_manager::on_timer() {
     // without waiting for them, so segement_manager could be shut down
     // while they are running.
     (void)seastar::with_gate(_gate, [this] {
-        if (cfg.mode != sync_mode::BATCH) {
+        if (cfg.mode == sync_mode::PERIODIC) {
             sync();
         }
 
@@ -2677,6 +2846,28 @@ db::commitlog::read_log_file(sstring filename, sstring pfx, seastar::io_priority
             }
         }
 
+        // The payload of a compressed entry is its uncompressed size (4 bytes, little endian)
+        // followed by an LZ4 block, as produced by the lz4 compressor.
+        static fragmented_temporary_buffer uncompress_entry(const fragmented_temporary_buffer& buf) {
+            return with_linearized(fragmented_temporary_buffer::view(buf), [] (bytes_view in) {
+                if (in.size() < sizeof(uint32_t)) {
+                    throw std::runtime_error("compressed entry too short");
+                }
+                auto uncompressed_size = seastar::read_le<uint32_t>(reinterpret_cast<const char*>(in.data()));
+                if (uncompressed_size > segment::max_compressed_entry_size) {
+                    throw std::runtime_error(format("compressed entry too large: {}", uncompressed_size));
+                }
+                temporary_buffer<char> out(uncompressed_size);
+                auto n = compressor::lz4->uncompress(reinterpret_cast<const char*>(in.data()), in.size(), out.get_write(), out.size());
+                if (n != uncompressed_size) {
+                    throw std::runtime_error(format("compressed entry size mismatch: {} != {}", n, uncompressed_size));
+                }
+                std::vector<temporary_buffer<char>> frags;
+                frags.emplace_back(std::move(out));
+                return fragmented_temporary_buffer(std::move(frags), uncompressed_size);
+            });
+        }
+
         future<> read_entry() {
             return do_read_entry(std::bind(&work::produce, this, std::placeholders::_1));
         }
@@ -2768,6 +2959,13 @@ db::commitlog::read_log_file(sstring filename, sstring pfx, seastar::io_priority
                 co_return;
             }
 
+            bool compressed = false;
+            if (d.ver >= descriptor::segment_version_3 && (size & segment::compressed_entry_flag)) {
+                // The header checksum covers the flag, as computed above.
+                compressed = true;
+                size &= ~segment::compressed_entry_flag;
+            }
+
             if (size < 3 * sizeof(uint32_t) || checksum != crc.checksum()) {
                 auto slack = next - pos;
                 if (size != 0) {
@@ -2800,6 +2998,16 @@ db::commitlog::read_log_file(sstring filename, sstring pfx, seastar::io_priority
                 co_return;
             }
 
+            if (compressed) {
+                try {
+                    buf = uncompress_entry(buf);
+                } catch (...) {
+                    clogger.debug("Segment entry at {} failed to uncompress: {}. Skipping {} bytes", rp, std::current_exception(), size);
+                    corrupt_size += size;
+                    co_return;
+                }
+            }
+
             co_await pf({std::move(buf), rp}, checksum);
         }
 
@@ -49,6 +49,11 @@ class extensions;
  * In BATCH mode, every write to the log will also send the data to disk
  * + issue a flush and wait for both to complete.
  *
+ * In GROUP mode, writes also wait for their data to be flushed, but
+ * concurrent writes share a single flush. The first write of a group delays
+ * the flush by a window which grows with the rate of writes and the latency
+ * of flushes, bounded by commitlog_sync_group_window_in_ms.
+ *
  * In PERIODIC mode, most writes will only add to the internal memory
  * buffers. If the mem buffer is saturated, data is sent to disk, but we
  * don't wait for the write to complete. However, if periodic (timer)
@@ -81,7 +86,7 @@ class commitlog {
     ::shared_ptr<segment_manager> _segment_manager;
 public:
     enum class sync_mode {
-        PERIODIC, BATCH
+        PERIODIC, BATCH, GROUP
     };
     using force_sync = commitlog_entry_writer::force_sync;
     struct config {
@@ -95,6 +100,9 @@ class commitlog {
         std::optional<uint64_t> commitlog_flush_threshold_in_mb = {};
         uint64_t commitlog_segment_size_in_mb = 32;
         uint64_t commitlog_sync_period_in_ms = 10 * 1000; //TODO: verify default!
+        // Upper bound of the time a write waits for other writes to join its
+        // flush in GROUP mode.
+        uint64_t commitlog_sync_group_window_in_ms = 5;
         // Max number of segments to keep in pre-alloc reserve.
         // Not (yet) configurable from scylla.conf.
         uint64_t max_reserve_segments = 12;
@@ -107,6 +115,9 @@ class commitlog {
         std::string fname_prefix = descriptor::FILENAME_PREFIX;
 
         bool use_o_dsync = false;
+        // Compress entries of new segments. Such segments can't be
+        // replayed by versions which don't know segment_version_3.
+        bool use_compression = false;
         bool warn_about_segments_left_on_disk_after_shutdown = true;
         bool allow_going_over_size_limit = true;
 
@@ -133,6 +144,8 @@ class commitlog {
 
         static inline constexpr uint32_t segment_version_1 = 1u;
         static inline constexpr uint32_t segment_version_2 = 2u;
+        // Entries may be LZ4 compressed.
+        static inline constexpr uint32_t segment_version_3 = 3u;
 
         descriptor(descriptor&&) noexcept = default;
         descriptor(const descriptor&) = default;
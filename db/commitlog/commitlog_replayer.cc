@@ -13,8 +13,15 @@
 #include <unordered_map>
 #include <boost/range/adaptor/map.hpp>
 
+#include <seastar/core/coroutine.hh>
 #include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/seastar.hh>
+#include <seastar/core/semaphore.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/coroutine/as_future.hh>
+#include <seastar/util/defer.hh>
 
 #include "commitlog.hh"
 #include "commitlog_replayer.hh"
@@ -33,6 +40,11 @@
 
 static logging::logger rlogger("commitlog_replayer");
 
+static thread_local db::commitlog_replayer::progress local_progress;
+
+// Segments of a shard are replayed concurrently, each with its own read-ahead.
+static constexpr size_t segments_replayed_concurrently = 4;
+
 class db::commitlog_replayer::impl {
     struct column_mappings {
         std::unordered_map<table_schema_version, column_mapping> map;
@@ -81,8 +93,21 @@ class db::commitlog_replayer::impl {
         return _column_mappings.stop();
     }
 
-    future<> process(stats*, commitlog::buffer_and_replay_position buf_rp) const;
+    // A mutation read from a segment, to be applied on the shard owning it.
+    struct entry {
+        commitlog_entry_reader cer;
+        // Belongs to the shard which read the segment, read-only elsewhere.
+        const column_mapping* cm;
+        replay_position rp;
+    };
+    class batcher;
+
+    future<> process(stats*, batcher&, commitlog::buffer_and_replay_position buf_rp) const;
     future<stats> recover(sstring file, const sstring& fname_prefix) const;
+    future<stats> recover_shard(std::vector<sstring> files, const sstring& fname_prefix) const;
+    // Called on the shard owning the mutations.
+    future<stats> apply(replica::database& db, std::vector<entry> entries) const;
+    future<> apply(replica::database& db, entry& e) const;
 
     typedef std::unordered_map<utils::UUID, replay_position> rp_map;
     typedef std::unordered_map<unsigned, rp_map> shard_rpm_map;
@@ -113,6 +138,72 @@ db::commitlog_replayer::impl::impl(seastar::sharded<replica::database>& db)
     : _db(db)
 {}
 
+// Groups the mutations read from a segment by the shard owning them, so that they are
+// sent to the owner and applied there in batches rather than with a cross-shard call
+// each. Reading goes on while batches are applied, up to a limit of batches in flight.
+class db::commitlog_replayer::impl::batcher {
+    static constexpr size_t max_batch_entries = 128;
+    static constexpr size_t max_batch_bytes = 1024 * 1024;
+    static constexpr size_t max_batches_in_flight = 8;
+
+    struct batch {
+        std::vector<entry> entries;
+        size_t bytes = 0;
+    };
+
+    const impl& _impl;
+    stats& _stats;
+    std::vector<batch> _batches;
+    seastar::semaphore _in_flight{max_batches_in_flight};
+    seastar::gate _gate;
+private:
+    future<> send(unsigned shard) {
+        auto entries = std::exchange(_batches[shard], batch{}).entries;
+        auto units = co_await get_units(_in_flight, 1);
+        auto n = entries.size();
+        (void)with_gate(_gate, [this, shard, n, entries = std::move(entries), units = std::move(units)] () mutable {
+            return _impl._db.invoke_on(shard, [&impl = _impl, entries = std::move(entries)] (replica::database& db) mutable {
+                return impl.apply(db, std::move(entries));
+            }).then_wrapped([this, n, units = std::move(units)] (future<stats> f) {
+                if (f.failed()) {
+                    _stats.invalid_mutations += n;
+                    rlogger.warn("error replaying: {}", f.get_exception());
+                    return;
+                }
+                auto s = f.get0();
+                local_progress.applied_mutations += s.applied_mutations;
+                _stats += s;
+            });
+        });
+    }
+public:
+    batcher(const impl& impl, stats& s)
+        : _impl(impl)
+        , _stats(s)
+        , _batches(smp::count)
+    {}
+
+    future<> add(unsigned shard, entry e, size_t size) {
+        auto& b = _batches[shard];
+        b.entries.push_back(std::move(e));
+        b.bytes += size;
+        if (b.entries.size() >= max_batch_entries || b.bytes >= max_batch_bytes) {
+            return send(shard);
+        }
+        return make_ready_future<>();
+    }
+
+    // Sends the remaining batches and waits for all of them to be applied.
+    future<> close() {
+        for (unsigned shard = 0; shard < _batches.size(); ++shard) {
+            if (!_batches[shard].entries.empty()) {
+                co_await send(shard);
+            }
+        }
+        co_await _gate.close();
+    }
+};
+
 future<> db::commitlog_replayer::impl::init() {
     return _db.map_reduce([this](shard_rpm_map map) {
         for (auto& p1 : map) {
@@ -183,33 +274,83 @@ db::commitlog_replayer::impl::recover(sstring file, const sstring& fname_prefix)
     replay_position rp{commitlog::descriptor(file, fname_prefix)};
     auto gp = min_pos(rp.shard_id());
 
+    // Progress is counted by the position of entries read, and the rest of the file once done.
+    uint64_t size = co_await file_size(file);
+    uint64_t done = 0;
+    auto account_rest = defer([&] () noexcept {
+        local_progress.replayed_bytes += size - std::min(done, size);
+    });
+
     if (rp.id < gp.id) {
         rlogger.debug("skipping replay of fully-flushed {}", file);
-        return make_ready_future<stats>();
+        co_return stats();
     }
     position_type p = 0;
     if (rp.id == gp.id) {
         p = gp.pos;
     }
+    done = std::min<uint64_t>(p, size);
+    local_progress.replayed_bytes += done;
 
-    auto s = make_lw_shared<stats>();
+    stats s;
+    batcher b(*this, s);
     auto& exts = _db.local().extensions();
 
-    return db::commitlog::read_log_file(file, fname_prefix, service::get_local_commitlog_priority(),
-            std::bind(&impl::process, this, s.get(), std::placeholders::_1),
-            p, &exts).then_wrapped([s](future<> f) {
+    auto f = co_await coroutine::as_future(db::commitlog::read_log_file(file, fname_prefix, service::get_local_commitlog_priority(),
+            [this, &s, &b, &done, size] (commitlog::buffer_and_replay_position buf_rp) {
+        uint64_t pos = std::min<uint64_t>(buf_rp.position.pos, size);
+        if (pos > done) {
+            local_progress.replayed_bytes += pos - done;
+            done = pos;
+        }
+        return process(&s, b, std::move(buf_rp));
+    }, p, &exts));
+    co_await b.close();
+
+    if (f.failed()) {
         try {
-            f.get();
+            std::rethrow_exception(f.get_exception());
         } catch (commitlog::segment_data_corruption_error& e) {
-            s->corrupt_bytes += e.bytes();
-        } catch (...) {
-            throw;
+            s.corrupt_bytes += e.bytes();
         }
-        return make_ready_future<stats>(*s);
+    }
+    co_return s;
+}
+
+future<db::commitlog_replayer::impl::stats>
+db::commitlog_replayer::impl::recover_shard(std::vector<sstring> files, const sstring& fname_prefix) const {
+    local_progress = {};
+    for (auto& f : files) {
+        local_progress.total_bytes += co_await file_size(f);
+    }
+    local_progress.started = lowres_clock::now();
+    local_progress.in_progress = true;
+    auto finish = defer([] () noexcept {
+        local_progress.finished = lowres_clock::now();
+        local_progress.in_progress = false;
+    });
+
+    // Mutations are commutative, so segments need not be replayed in order.
+    stats total;
+    co_await max_concurrent_for_each(files, segments_replayed_concurrently, [this, &total, &fname_prefix] (const sstring& f) {
+        rlogger.debug("Replaying {}", f);
+        return recover(f, fname_prefix).then([f, &total] (impl::stats stats) {
+            if (stats.corrupt_bytes != 0) {
+                rlogger.warn("Corrupted file: {}. {} bytes skipped.", f, stats.corrupt_bytes);
+            }
+            rlogger.debug("Log replay of {} complete, {} replayed mutations ({} invalid, {} skipped)"
+                            , f
+                            , stats.applied_mutations
+                            , stats.invalid_mutations
+                            , stats.skipped_mutations
+            );
+            total += stats;
+        });
     });
+    co_return total;
 }
 
-future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_replay_position buf_rp) const {
+future<> db::commitlog_replayer::impl::process(stats* s, batcher& b, commitlog::buffer_and_replay_position buf_rp) const {
     auto&& buf = buf_rp.buffer;
     auto&& rp = buf_rp.position;
     try {
@@ -246,51 +387,7 @@ future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_r
 
         const auto& schema = *_db.local().find_column_family(uuid).schema();
         auto shard = fm.shard_of(schema);
-        return _db.invoke_on(shard, [this, cer = std::move(cer), &src_cm, rp, shard, s] (replica::database& db) mutable -> future<> {
-            auto& fm = cer.mutation();
-            // TODO: might need better verification that the deserialized mutation
-            // is schema compatible. My guess is that just applying the mutation
-            // will not do this.
-            auto& cf = db.find_column_family(fm.column_family_id());
-
-            if (rlogger.is_enabled(logging::log_level::debug)) {
-                rlogger.debug("replaying at {} v={} {}:{} at {}", fm.column_family_id(), fm.schema_version(),
-                        cf.schema()->ks_name(), cf.schema()->cf_name(), rp);
-            }
-            if (const auto err = validation::is_cql_key_invalid(*cf.schema(), fm.key()); err) {
-                throw std::runtime_error(fmt::format("found entry with invalid key {} at {} v={} {}:{} at {}: {}.", fm.key(), fm.column_family_id(),
-                        fm.schema_version(), cf.schema()->ks_name(), cf.schema()->cf_name(), rp, *err));
-            }
-            // Removed forwarding "new" RP. Instead give none/empty.
-            // This is what origin does, and it should be fine.
-            // The end result should be that once sstables are flushed out
-            // their "replay_position" attribute will be empty, which is
-            // lower than anything the new session will produce.
-            if (cf.schema()->version() != fm.schema_version()) {
-                auto& local_cm = _column_mappings.local().map;
-                auto cm_it = local_cm.try_emplace(fm.schema_version(), src_cm).first;
-                const column_mapping& cm = cm_it->second;
-                mutation m(cf.schema(), fm.decorated_key(*cf.schema()));
-                converting_mutation_partition_applier v(cm, *cf.schema(), m.partition());
-                fm.partition().accept(cm, v);
-                return do_with(std::move(m), [&db, &cf] (const mutation& m) {
-                    return db.apply_in_memory(m, cf, db::rp_handle(), db::no_timeout);
-                });
-            } else {
-                return do_with(std::move(cer).mutation(), [&](const frozen_mutation& m) {
-                    return db.apply_in_memory(m, cf.schema(), db::rp_handle(), db::no_timeout);
-                });
-            }
-        }).then_wrapped([s] (future<> f) {
-            try {
-                f.get();
-                s->applied_mutations++;
-            } catch (...) {
-                s->invalid_mutations++;
-                // TODO: write mutation to file like origin.
-                rlogger.warn("error replaying: {}", std::current_exception());
-            }
-        });
+        return b.add(shard, entry{std::move(cer), &src_cm, rp}, buf.size_bytes());
     } catch (replica::no_such_column_family&) {
         // No such CF now? Origin just ignores this.
     } catch (...) {
@@ -302,6 +399,58 @@ future<> db::commitlog_replayer::impl::process(stats* s, commitlog::buffer_and_r
     return make_ready_future<>();
 }
 
+future<db::commitlog_replayer::impl::stats>
+db::commitlog_replayer::impl::apply(replica::database& db, std::vector<entry> entries) const {
+    stats s;
+    co_await parallel_for_each(entries, [this, &db, &s] (entry& e) {
+        return apply(db, e).then_wrapped([&s] (future<> f) {
+            try {
+                f.get();
+                s.applied_mutations++;
+            } catch (...) {
+                s.invalid_mutations++;
+                // TODO: write mutation to file like origin.
+                rlogger.warn("error replaying: {}", std::current_exception());
+            }
+        });
+    });
+    co_return s;
+}
+
+future<> db::commitlog_replayer::impl::apply(replica::database& db, entry& e) const {
+    auto& fm = e.cer.mutation();
+    auto rp = e.rp;
+    // TODO: might need better verification that the deserialized mutation
+    // is schema compatible. My guess is that just applying the mutation
+    // will not do this.
+    auto& cf = db.find_column_family(fm.column_family_id());
+
+    if (rlogger.is_enabled(logging::log_level::debug)) {
+        rlogger.debug("replaying at {} v={} {}:{} at {}", fm.column_family_id(), fm.schema_version(),
+                cf.schema()->ks_name(), cf.schema()->cf_name(), rp);
+    }
+    if (const auto err = validation::is_cql_key_invalid(*cf.schema(), fm.key()); err) {
+        throw std::runtime_error(fmt::format("found entry with invalid key {} at {} v={} {}:{} at {}: {}.", fm.key(), fm.column_family_id(),
+                fm.schema_version(), cf.schema()->ks_name(), cf.schema()->cf_name(), rp, *err));
+    }
+    // Removed forwarding "new" RP. Instead give none/empty.
+    // This is what origin does, and it should be fine.
+    // The end result should be that once sstables are flushed out
+    // their "replay_position" attribute will be empty, which is
+    // lower than anything the new session will produce.
+    if (cf.schema()->version() != fm.schema_version()) {
+        auto& local_cm = _column_mappings.local().map;
+        auto cm_it = local_cm.try_emplace(fm.schema_version(), *e.cm).first;
+        const column_mapping& cm = cm_it->second;
+        mutation m(cf.schema(), fm.decorated_key(*cf.schema()));
+        converting_mutation_partition_applier v(cm, *cf.schema(), m.partition());
+        fm.partition().accept(cm, v);
+        co_await db.apply_in_memory(m, cf, db::rp_handle(), db::no_timeout);
+    } else {
+        co_await db.apply_in_memory(fm, cf.schema(), db::rp_handle(), db::no_timeout);
+    }
+}
+
 db::commitlog_replayer::commitlog_replayer(seastar::sharded<replica::database>& db)
     : _impl(std::make_unique<impl>(db))
 {}
@@ -323,45 +472,21 @@ future<db::commitlog_replayer> db::commitlog_replayer::create_replayer(seastar::
 }
 
 future<> db::commitlog_replayer::recover(std::vector<sstring> files, sstring fname_prefix) {
-    typedef std::unordered_multimap<unsigned, sstring> shard_file_map;
-
     rlogger.info("Replaying {}", join(", ", files));
 
     // pre-compute work per shard already.
-    auto map = ::make_lw_shared<shard_file_map>();
+    std::vector<std::vector<sstring>> shard_files(smp::count);
     for (auto& f : files) {
         commitlog::descriptor d(f, fname_prefix);
         replay_position p = d;
-        map->emplace(p.shard_id() % smp::count, std::move(f));
+        shard_files[p.shard_id() % smp::count].push_back(std::move(f));
     }
 
-    return do_with(std::move(fname_prefix), [this, map] (sstring& fname_prefix) {
-        return _impl->start().then([this, map, &fname_prefix] {
-            return map_reduce(smp::all_cpus(), [this, map, &fname_prefix] (unsigned id) {
-                return smp::submit_to(id, [this, id, map, &fname_prefix] () {
-                    auto total = ::make_lw_shared<impl::stats>();
-                    // TODO: or something. For now, we do this serialized per shard,
-                    // to reduce mutation congestion. We could probably (says avi)
-                    // do 2 segments in parallel or something, but lets use this first.
-                    auto range = map->equal_range(id);
-                    return do_for_each(range.first, range.second, [this, total, &fname_prefix] (const std::pair<unsigned, sstring>& p) {
-                        auto&f = p.second;
-                        rlogger.debug("Replaying {}", f);
-                        return _impl->recover(f, fname_prefix).then([f, total](impl::stats stats) {
-                            if (stats.corrupt_bytes != 0) {
-                                rlogger.warn("Corrupted file: {}. {} bytes skipped.", f, stats.corrupt_bytes);
-                            }
-                            rlogger.debug("Log replay of {} complete, {} replayed mutations ({} invalid, {} skipped)"
-                                            , f
-                                            , stats.applied_mutations
-                                            , stats.invalid_mutations
-                                            , stats.skipped_mutations
-                            );
-                            *total += stats;
-                        });
-                    }).then([total] {
-                        return make_ready_future<impl::stats>(*total);
-                    });
+    return do_with(std::move(fname_prefix), std::move(shard_files), [this] (sstring& fname_prefix, std::vector<std::vector<sstring>>& shard_files) {
+        return _impl->start().then([this, &fname_prefix, &shard_files] {
+            return map_reduce(smp::all_cpus(), [this, &fname_prefix, &shard_files] (unsigned id) {
+                return smp::submit_to(id, [this, &fname_prefix, files = shard_files[id]] () mutable {
+                    return _impl->recover_shard(std::move(files), fname_prefix);
                 });
             }, impl::stats(), std::plus<impl::stats>()).then([](impl::stats totals) {
                 rlogger.info("Log replay complete, {} replayed mutations ({} invalid, {} skipped)"
@@ -380,3 +505,6 @@ future<> db::commitlog_replayer::recover(sstring f, sstring fname_prefix) {
     return recover(std::vector<sstring>{ f }, std::move(fname_prefix));
 }
 
+const db::commitlog_replayer::progress& db::commitlog_replayer::get_progress() noexcept {
+    return local_progress;
+}
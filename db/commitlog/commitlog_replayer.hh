@@ -11,6 +11,7 @@
 
 #include <memory>
 #include <seastar/core/future.hh>
+#include <seastar/core/lowres_clock.hh>
 #include <seastar/core/sharded.hh>
 
 #include "seastarx.hh"
@@ -33,6 +34,17 @@ class commitlog_replayer {
     future<> recover(std::vector<sstring> files, sstring fname_prefix);
     future<> recover(sstring file, sstring fname_prefix);
 
+    // Progress of replaying the segments read by this shard.
+    struct progress {
+        uint64_t total_bytes = 0;
+        uint64_t replayed_bytes = 0;
+        uint64_t applied_mutations = 0;
+        lowres_clock::time_point started;
+        lowres_clock::time_point finished;
+        bool in_progress = false;
+    };
+    static const progress& get_progress() noexcept;
+
 private:
     commitlog_replayer(seastar::sharded<replica::database>&);
 
@@ -279,6 +279,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "true: auto-adjust memtable shares for flush processes")
     , memtable_flush_static_shares(this, "memtable_flush_static_shares", liveness::LiveUpdate, value_status::Used, 0,
         "If set to higher than 0, ignore the controller's output and set the memtable shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity")
+    , memtable_flush_parallelism(this, "memtable_flush_parallelism", liveness::LiveUpdate, value_status::Used, 1,
+        "Maximum number of sstables a single memtable flush is split into, by token range, and written concurrently. Only memtables large enough to give each sstable at least 16MB of data are split. 1 (default) disables splitting.")
+    , write_throttle_horizon_in_ms(this, "write_throttle_horizon_in_ms", liveness::LiveUpdate, value_status::Used, 0,
+        "If set to higher than 0, delay responses to writes in proportion to how close dirty memory, projected this far ahead at its recent rate of growth, is to the limit at which writes are blocked, and to how far compaction is behind. 0 (default) disables it, so that writes only block at the dirty memory limit.")
     , compaction_static_shares(this, "compaction_static_shares", liveness::LiveUpdate, value_status::Used, 0,
         "If set to higher than 0, ignore the controller's output and set the compaction shares statically. Do not set this unless you know what you are doing and suspect a problem in the controller. This option will be retired when the controller reaches more maturity")
     , compaction_enforce_min_threshold(this, "compaction_enforce_min_threshold", liveness::LiveUpdate, value_status::Used, false,
@@ -374,6 +378,12 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , compaction_throughput_mb_per_sec(this, "compaction_throughput_mb_per_sec", liveness::LiveUpdate, value_status::Used, 0,
         "Throttles compaction to the specified total throughput across the entire system. The faster you insert data, the faster you need to compact in order to keep the SSTable count down. The recommended Value is 16 to 32 times the rate of write throughput (in MBs/second). Setting the value to 0 disables compaction throttling.\n"
         "Related information: Configuring compaction")
+    , major_compaction_parallelism(this, "major_compaction_parallelism", liveness::LiveUpdate, value_status::Used, 1,
+        "Number of token sub-ranges a major compaction is split into. The sub-ranges are compacted concurrently within the shard, and the input sstables are replaced once all of them are done.")
+    , compaction_read_latency_objective_us(this, "compaction_read_latency_objective_us", liveness::LiveUpdate, value_status::Used, 0,
+        "If set to higher than 0, the compaction controller lowers compaction shares while the p99 latency of local reads exceeds this value in microseconds, and raises them back when reads are comfortably below it. Has no effect when compaction_static_shares is set.")
+    , compaction_read_queue_length_objective(this, "compaction_read_queue_length_objective", liveness::LiveUpdate, value_status::Used, 0,
+        "If set to higher than 0, the compaction controller lowers compaction shares while more reads than this are queued waiting for admission, and raises them back when the queue is comfortably shorter. Has no effect when compaction_static_shares is set.")
     , compaction_large_partition_warning_threshold_mb(this, "compaction_large_partition_warning_threshold_mb", value_status::Used, 1000,
         "Log a warning when writing partitions larger than this value")
     , compaction_large_row_warning_threshold_mb(this, "compaction_large_row_warning_threshold_mb", value_status::Used, 10,
@@ -412,6 +422,7 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "\n"
         "\tperiodic : Used with commitlog_sync_period_in_ms (Default: 10000 - 10 seconds ) to control how often the commit log is synchronized to disk. Periodic syncs are acknowledged immediately.\n"
         "\tbatch : Used with commitlog_sync_batch_window_in_ms (Default: disabled **) to control how long Scylla waits for other writes before performing a sync. When using this method, writes are not acknowledged until fsynced to disk.\n"
+        "\tgroup : Writes are not acknowledged until fsynced to disk, but concurrent writes share one sync. The first write of a group waits for others to join for a time which adapts to the rate of writes and the latency of syncs, at most commitlog_sync_group_window_in_ms.\n"
         "Related information: Durability")
     , commitlog_segment_size_in_mb(this, "commitlog_segment_size_in_mb", value_status::Used, 64,
         "Sets the size of the individual commitlog file segments. A commitlog segment may be archived, deleted, or recycled after all its data has been flushed to SSTables. This amount of data can potentially include commitlog segments from every table in the system. The default size is usually suitable for most commitlog archiving, but if you want a finer granularity, 8 or 16 MB is reasonable. See Commit log archive configuration.\n"
@@ -422,6 +433,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     /* Note: does not exist on the listing page other than in above comment, wtf? */
     , commitlog_sync_batch_window_in_ms(this, "commitlog_sync_batch_window_in_ms", value_status::Used, 10000,
         "Controls how long the system waits for other writes before performing a sync in \"batch\" mode.")
+    , commitlog_sync_group_window_in_ms(this, "commitlog_sync_group_window_in_ms", value_status::Used, 5,
+        "Maximum time a write waits for other writes to share its sync in \"group\" mode. The actual wait adapts to the rate of writes and the latency of syncs, and is 0 when writes are too infrequent to share syncs.")
     , commitlog_total_space_in_mb(this, "commitlog_total_space_in_mb", value_status::Used, -1,
         "Total space used for commitlogs. If the used space goes above this value, Scylla rounds up to the next nearest segment multiple and flushes memtables to disk for the oldest commitlog segments, removing those log segments. This reduces the amount of data to replay on startup, and prevents infrequently-updated tables from indefinitely keeping commitlog segments. A small total commitlog space tends to cause more flush activity on less-active tables.\n"
         "Related information: Configuring memtable throughput")
@@ -432,6 +445,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Threshold for commitlog disk usage. When used disk space goes above this value, Scylla initiates flushes of memtables to disk for the oldest commitlog segments, removing those log segments. Adjusting this affects disk usage vs. write latency. Default is (approximately) commitlog_total_space_in_mb - <num shards>*commitlog_segment_size_in_mb.")
     , commitlog_use_o_dsync(this, "commitlog_use_o_dsync", value_status::Used, true,
         "Whether or not to use O_DSYNC mode for commitlog segments IO. Can improve commitlog latency on some file systems.\n")
+    , commitlog_compression(this, "commitlog_compression", value_status::Used, false,
+        "Whether or not to compress commitlog entries with LZ4. Reduces commitlog disk bandwidth for compressible data at the cost of CPU. Segments written with compression can't be replayed by versions which don't support it.\n")
     , commitlog_use_hard_size_limit(this, "commitlog_use_hard_size_limit", value_status::Used, false,
         "Whether or not to use a hard size limit for commitlog disk usage. Default is false. Enabling this can cause latency spikes, whereas the default can lead to occasional disk usage peaks.\n")
     /* Compaction settings */
@@ -599,6 +614,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "\tall: All traffic is compressed.\n"
         "\tdc : Traffic between data centers is compressed.\n"
         "\tnone : No compression.")
+    , internode_compression_streaming(this, "internode_compression_streaming", value_status::Used, true,
+        "Whether the connections used by streaming and repair are compressed when internode_compression applies to them. Disable it when this traffic compresses poorly, to save the CPU spent on compressing it.")
     , inter_dc_tcp_nodelay(this, "inter_dc_tcp_nodelay", value_status::Used, false,
         "Enable or disable tcp_nodelay for inter-data center communication. When disabled larger, but fewer, network packets are sent. This reduces overhead from the TCP protocol itself. However, if cross data-center responses are blocked, it will increase latency.")
     , streaming_socket_timeout_in_ms(this, "streaming_socket_timeout_in_ms", value_status::Unused, 0,
@@ -652,12 +669,45 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "\tYour own RPC server: You must provide a fully-qualified class name of an o.a.c.t.TServerFactory that can create a server instance.")
     , cache_hit_rate_read_balancing(this, "cache_hit_rate_read_balancing", value_status::Used, true,
         "This boolean controls whether the replicas for read query will be choosen based on cache hit ratio")
+    , coordinator_read_batching(this, "coordinator_read_batching", liveness::LiveUpdate, value_status::Used, false,
+        "Coalesce single-partition data reads which concurrent queries send to the same replica into a single message. "
+        "Reduces per-message overhead for multi-get heavy workloads, at the cost of delaying each read until the reads queued along with it are gathered.")
+    , coordinator_write_batching(this, "coordinator_write_batching", liveness::LiveUpdate, value_status::Used, false,
+        "Coalesce small mutations which concurrent writes, such as the partitions of an unlogged batch, send to the same replica into a single message. "
+        "Each mutation is still applied and acknowledged separately by the replica.")
+    , replica_latency_read_balancing(this, "replica_latency_read_balancing", liveness::LiveUpdate, value_status::Used, false,
+        "Track the latency of the reads each coordinator shard sends to every replica. Within a datacenter, replicas which are slower than the fastest one "
+        "by more than dynamic_snitch_badness_threshold are read from last, and reads speculate once they waited longer than the speculative_retry percentile "
+        "of the latencies of the replicas they wait for, rather than of the table's read latency.")
+    , max_range_scan_concurrency(this, "max_range_scan_concurrency", liveness::LiveUpdate, value_status::Used, 256,
+        "The maximum number of vnode ranges a range scan reads concurrently. A scan reads as many ranges as it expects to need for the requested rows, "
+        "based on the rows per range returned so far, up to this number.")
+    , coalesce_counter_updates(this, "coalesce_counter_updates", liveness::LiveUpdate, value_status::Used, false,
+        "Merge the counter updates a leader replica receives for cells of a partition which are locked by an update in progress into a single update, "
+        "which reads the current counter values and writes the commitlog once for all of them.")
+    , coalesce_partition_writes(this, "coalesce_partition_writes", liveness::LiveUpdate, value_status::Used, false,
+        "Apply concurrent writes to the same partition to the memtable as a single write, saving the per-write memtable and cache update costs. "
+        "A write is held back for one scheduling round to collect the others, which adds to the latency of writes to partitions which are not "
+        "written concurrently. Helps workloads writing in bursts to few partitions.")
+    , batch_view_updates(this, "batch_view_updates", liveness::LiveUpdate, value_status::Used, false,
+        "Generate the view updates of concurrent writes to the same partition of a table with materialized views together, reading the "
+        "existing base rows once for all of them. The writes then also share the locks of the base rows, which are held until all "
+        "of them are applied to the base table.")
+    , coalesce_view_updates(this, "coalesce_view_updates", liveness::LiveUpdate, value_status::Used, false,
+        "Queue asynchronous view updates per view and view replica, sending a bounded number of them at a time, and merge an update "
+        "into a queued update of the same view partition. Reduces the view writes of frequently updated base rows.")
+    , cdc_coalesce_preimage_selects(this, "cdc_coalesce_preimage_selects", liveness::LiveUpdate, value_status::Used, false,
+        "Send a single pre-image select for concurrent writes selecting the same rows of a partition of a table with CDC pre-image or post-image "
+        "enabled, at the same consistency level. All of them see the same pre-image, the state before any of them was applied, as they would "
+        "if they raced with each other.")
+    , select_result_cache_memory_in_mb(this, "select_result_cache_memory_in_mb", liveness::LiveUpdate, value_status::Used, 16,
+        "Memory, per shard, which coordinators may use to cache results of SELECTs on tables with the results_ttl_in_ms caching option.")
     /* Advanced fault detection settings */
     /* Settings to handle poorly performing or failing nodes. */
-    , dynamic_snitch_badness_threshold(this, "dynamic_snitch_badness_threshold", value_status::Unused, 0,
-        "Sets the performance threshold for dynamically routing requests away from a poorly performing node. A value of 0.2 means Cassandra continues to prefer the static snitch values until the node response time is 20% worse than the best performing node. Until the threshold is reached, incoming client requests are statically routed to the closest replica (as determined by the snitch). Having requests consistently routed to a given replica can help keep a working set of data hot when read repair is less than 1.")
-    , dynamic_snitch_reset_interval_in_ms(this, "dynamic_snitch_reset_interval_in_ms", value_status::Unused, 60000,
-        "Time interval in milliseconds to reset all node scores, which allows a bad node to recover.")
+    , dynamic_snitch_badness_threshold(this, "dynamic_snitch_badness_threshold", liveness::LiveUpdate, value_status::Used, 0,
+        "Sets the performance threshold for dynamically routing requests away from a poorly performing node. A value of 0.2 means Scylla continues to prefer the static snitch values until the node response time is 20% worse than the best performing node. Until the threshold is reached, incoming client requests are statically routed to the closest replica (as determined by the snitch). Having requests consistently routed to a given replica can help keep a working set of data hot when read repair is less than 1. Used when replica_latency_read_balancing is enabled.")
+    , dynamic_snitch_reset_interval_in_ms(this, "dynamic_snitch_reset_interval_in_ms", liveness::LiveUpdate, value_status::Used, 60000,
+        "Time interval in milliseconds to reset all node scores, which allows a bad node to recover. Used when replica_latency_read_balancing is enabled.")
     , dynamic_snitch_update_interval_in_ms(this, "dynamic_snitch_update_interval_in_ms", value_status::Unused, 100,
         "The time interval for how often the snitch calculates node scores. Because score calculation is CPU intensive, be careful when reducing this interval.")
     , hinted_handoff_enabled(this, "hinted_handoff_enabled", value_status::Used, db::config::hinted_handoff_enabled_type(db::config::hinted_handoff_enabled_type::enabled_for_all_tag()),
@@ -790,6 +840,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , override_decommission(this, "override_decommission", value_status::Used, false, "Set true to force a decommissioned node to join the cluster")
     , enable_repair_based_node_ops(this, "enable_repair_based_node_ops", liveness::LiveUpdate, value_status::Used, true, "Set true to use enable repair based node operations instead of streaming based")
     , allowed_repair_based_node_ops(this, "allowed_repair_based_node_ops", liveness::LiveUpdate, value_status::Used, "replace", "A comma separated list of node operations which are allowed to enable repair based node operations. The operations can be bootstrap, replace, removenode, decommission and rebuild")
+    , repair_adaptive_parallelism(this, "repair_adaptive_parallelism", liveness::LiveUpdate, value_status::Used, false,
+        "Set true to lower the number of ranges repaired in parallel on each shard while compaction is falling behind or local reads breach compaction_read_latency_objective_us or compaction_read_queue_length_objective, and to raise it back up to the limit given by the repair memory once they recover.")
     , ring_delay_ms(this, "ring_delay_ms", value_status::Used, 30 * 1000, "Time a node waits to hear from other nodes before joining the ring in milliseconds. Same as -Dcassandra.ring_delay_ms in cassandra.")
     , shadow_round_ms(this, "shadow_round_ms", value_status::Used, 300 * 1000, "The maximum gossip shadow round time. Can be used to reduce the gossip feature check time during node boot up.")
     , fd_max_interval_ms(this, "fd_max_interval_ms", value_status::Used, 2 * 1000, "The maximum failure_detector interval time in milliseconds. Interval larger than the maximum will be ignored. Larger cluster may need to increase the default.")
@@ -801,6 +853,8 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , experimental(this, "experimental", value_status::Used, false, "[Deprecated] Set to true to unlock all experimental features (except 'raft' feature, which should be enabled explicitly via 'experimental-features' option). Please use 'experimental-features', instead.")
     , experimental_features(this, "experimental_features", value_status::Used, {}, experimental_features_help_string())
     , lsa_reclamation_step(this, "lsa_reclamation_step", value_status::Used, 1, "Minimum number of segments to reclaim in a single step")
+    , lsa_background_defragmentation(this, "lsa_background_defragmentation", value_status::Used, false, "When set to true, compact sparse LSA segments in the background reclaim scheduling group when free memory gets low, so that memory reclaimed on the allocation path needs less compaction. Requires the cpu scheduler.")
+    , lsa_huge_pages(this, "lsa_huge_pages", value_status::Used, false, "When set to true, ask the kernel to back LSA memory with transparent huge pages, to reduce TLB misses on cache and memtable accesses.")
     , prometheus_port(this, "prometheus_port", value_status::Used, 9180, "Prometheus port, set to zero to disable")
     , prometheus_address(this, "prometheus_address", value_status::Used, {/* listen_address */}, "Prometheus listening address, defaulting to listen_address if not explicitly set")
     , prometheus_prefix(this, "prometheus_prefix", value_status::Used, "scylla", "Set the prefix of the exported Prometheus metrics. Changing this will break Scylla's dashboard compatibility, do not change unless you know what you are doing.")
@@ -809,6 +863,9 @@ db::config::config(std::shared_ptr<db::extensions> exts)
     , virtual_dirty_soft_limit(this, "virtual_dirty_soft_limit", value_status::Used, 0.6, "Soft limit of virtual dirty memory expressed as a portion of the hard limit")
     , sstable_summary_ratio(this, "sstable_summary_ratio", value_status::Used, 0.0005, "Enforces that 1 byte of summary is written for every N (2000 by default) "
         "bytes written to data file. Value must be between 0 and 1.")
+    , components_memory_reclaim_threshold(this, "components_memory_reclaim_threshold", liveness::LiveUpdate, value_status::Used, 0.2,
+        "Ratio of the shard's memory that the bloom filters of its sstables may use. Above it, the largest filters are dropped "
+        "until they use less, and are loaded again once there is room. An sstable without its filter is read even for keys it doesn't have.")
     , large_memory_allocation_warning_threshold(this, "large_memory_allocation_warning_threshold", value_status::Used, size_t(1) << 20, "Warn about memory allocations above this size; set to zero to disable")
     , enable_deprecated_partitioners(this, "enable_deprecated_partitioners", value_status::Used, false, "Enable the byteordered and random partitioners. These partitioners are deprecated and will be removed in a future version.")
     , enable_keyspace_column_family_metrics(this, "enable_keyspace_column_family_metrics", value_status::Used, false, "Enable per keyspace and per column family metrics reporting")
@@ -816,8 +873,26 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
     , enable_sstable_key_validation(this, "enable_sstable_key_validation", value_status::Used, ENABLE_SSTABLE_KEY_VALIDATION, "Enable validation of partition and clustering keys monotonicity"
         " Performance is affected to some extent as a result. Useful to help debugging problems that may arise at another layers.")
+    , coalesce_sstable_data_reads(this, "coalesce_sstable_data_reads", liveness::LiveUpdate, value_status::Used, false,
+        "Merge concurrent reads of nearby ranges of an sstable data file into larger reads. Helps on storage which runs out of IOPS "
+        "before bandwidth. Applies to the sstables opened after it is set.")
+    , cheap_read_fast_lane(this, "cheap_read_fast_lane", liveness::LiveUpdate, value_status::Used, false,
+        "Admit reads of a few rows of a few partitions, which are predicted to be cheap, from a queue of their own ahead of the other "
+        "reads waiting for admission, so that they don't wait behind expensive reads.")
+    , shed_reads_expected_to_time_out(this, "shed_reads_expected_to_time_out", liveness::LiveUpdate, value_status::Used, true,
+        "Fail reads on arrival when other reads wait for admission already and, given the time reads recently spent waiting, "
+        "they are expected to time out before being admitted.")
+    , track_read_costs(this, "track_read_costs", liveness::LiveUpdate, value_status::Used, false,
+        "Track the disk reads, sstables read and active time of reads, summed per table in system.read_costs. "
+        "Only reads started while this is enabled are tracked.")
     , cpu_scheduler(this, "cpu_scheduler", value_status::Used, true, "Enable cpu scheduling")
     , view_building(this, "view_building", value_status::Used, true, "Enable view building; should only be set to false when the node is experience issues due to view building")
+    , view_building_concurrency(this, "view_building_concurrency", liveness::LiveUpdate, value_status::Used, 1,
+        "Number of batches of base rows, per shard, whose view updates are generated and sent at the same time while building views. "
+        "Each build step of the view builder reads this many batches.")
+    , view_update_generator_concurrency(this, "view_update_generator_concurrency", liveness::LiveUpdate, value_status::Used, 1,
+        "Number of partitions of sstables received by streaming or repair, per shard, whose view updates are generated at the same time. "
+        "Each of them reads the existing base rows it affects. The default of 1 generates them one partition at a time.")
     , enable_sstables_mc_format(this, "enable_sstables_mc_format", value_status::Unused, true, "Enable SSTables 'mc' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , enable_sstables_md_format(this, "enable_sstables_md_format", value_status::Unused, true, "Enable SSTables 'md' format to be used as the default file format.  Deprecated, please use \"sstable_format\" instead.")
     , sstable_format(this, "sstable_format", value_status::Used, "me", "Default sstable file format", {"mc", "md", "me"})
@@ -852,11 +927,22 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Time period in seconds after which unused schema versions will be evicted from the local schema registry cache. Default is 1 second.")
     , max_concurrent_requests_per_shard(this, "max_concurrent_requests_per_shard",liveness::LiveUpdate, value_status::Used, std::numeric_limits<uint32_t>::max(),
         "Maximum number of concurrent requests a single shard can handle before it starts shedding extra load. By default, no requests will be shed.")
+    , count_requests_for_other_shards(this, "count_requests_for_other_shards", liveness::LiveUpdate, value_status::Used, false,
+        "Count the prepared statements executed for partitions owned by another shard than the one the connection is on, shown per connection in "
+        "system.clients. Helps finding clients which aren't shard-aware, at the cost of hashing the partition key of every executed statement.")
     , cdc_dont_rewrite_streams(this, "cdc_dont_rewrite_streams", value_status::Used, false,
             "Disable rewriting streams from cdc_streams_descriptions to cdc_streams_descriptions_v2. Should not be necessary, but the procedure is expensive and prone to failures; this config option is left as a backdoor in case some user requires manual intervention.")
     , strict_allow_filtering(this, "strict_allow_filtering", liveness::LiveUpdate, value_status::Used, strict_allow_filtering_default(), "Match Cassandra in requiring ALLOW FILTERING on slow queries. Can be true, false, or warn. When false, Scylla accepts some slow queries even without ALLOW FILTERING that Cassandra rejects. Warn is same as false, but with warning.")
     , reversed_reads_auto_bypass_cache(this, "reversed_reads_auto_bypass_cache", liveness::LiveUpdate, value_status::Used, false,
             "Bypass in-memory data cache (the row cache) when performing reversed queries.")
+    , cache_absent_partitions(this, "cache_absent_partitions", value_status::Used, 0,
+            "Maximum number of partitions, per shard, which the in-memory data cache (the row cache) remembers as absent after single-partition reads didn't find them, so that repeated reads of keys which don't exist don't touch the disk. Such a partition costs a few dozen bytes, compared to a few hundred for caching it as an empty partition, which is what happens when this is 0.")
+    , cache_frequency_admission(this, "cache_frequency_admission", value_status::Used, false,
+            "Make the in-memory data cache (the row cache) resistant to scans. Rows read for the first time enter a probation segment of the cache and are only kept at the expense of frequently read rows if they are estimated to be read more often. Protects the hit ratio of frequently read data from full scans which cannot bypass the cache.")
+    , hot_partition_copies_threshold(this, "hot_partition_copies_threshold", value_status::Used, 0,
+            "Number of reads per second of a single partition above which the shard owning it makes read-only copies of the partition on the other shards of the node, so that queries coordinated by any shard can read it without going to the owning shard. Copies are dropped before a write to the partition completes. Only applies to partitions small enough to be copied cheaply. 0 disables copying.")
+    , hw_counters_sample_cycles(this, "hw_counters_sample_cycles", value_status::Used, 0,
+            "Sample the CPU cycles, instructions, cache misses and branch misses of each shard every this many cycles, and export them as metrics per scheduling group. Needs perf events to be allowed, see kernel.perf_event_paranoid. A few million cycles, a fraction of the task quota, gives accurate attribution at a negligible cost. 0 disables sampling.")
     , enable_optimized_reversed_reads(this, "enable_optimized_reversed_reads", liveness::LiveUpdate, value_status::Used, true,
             "Use a new optimized algorithm for performing reversed reads.")
     , enable_cql_config_updates(this, "enable_cql_config_updates", liveness::LiveUpdate, value_status::Used, true,
@@ -901,6 +987,10 @@ db::config::config(std::shared_ptr<db::extensions> exts)
         "Use separate schema commit log unconditionally rater than after restart following discovery of cluster-wide support for it.")
     , cache_index_pages(this, "cache_index_pages", liveness::LiveUpdate, value_status::Used, true,
         "Keep SSTable index pages in the global cache after a SSTable read. Expected to improve performance for workloads with big partitions, but may degrade performance for workloads with small partitions.")
+    , tracing_backend(this, "tracing_backend", value_status::Used, "trace_keyspace_helper",
+        "Where tracing sessions are recorded: trace_keyspace_helper writes them to the system_traces keyspace, trace_ring_buffer_helper "
+        "keeps the most recent ones of each shard in memory, to be read through the REST API. The latter is cheap enough to keep a low "
+        "tracing probability on at all times.")
     , default_log_level(this, "default_log_level", value_status::Used)
     , logger_log_level(this, "logger_log_level", value_status::Used)
     , log_to_stdout(this, "log_to_stdout", value_status::Used)
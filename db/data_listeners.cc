@@ -13,6 +13,9 @@
 
 #include <tuple>
 
+#include <seastar/core/loop.hh>
+#include <seastar/core/metrics.hh>
+
 extern logging::logger dblog;
 
 namespace db {
@@ -45,6 +48,12 @@ void data_listeners::on_write(const schema_ptr& s, const frozen_mutation& m) {
     }
 }
 
+future<> data_listeners::on_external_update(const schema_ptr& s) {
+    return parallel_for_each(_listeners, [&s] (data_listener* li) {
+        return li->on_external_update(s);
+    });
+}
+
 toppartitions_item_key::operator sstring() const {
     std::ostringstream oss;
     oss << key.key().with_schema(*schema);
@@ -94,6 +103,83 @@ void toppartitions_data_listener::on_write(const schema_ptr& s, const frozen_mut
     }
 }
 
+hot_partition_tracker::hot_partition_tracker(replica::database& db, size_t large_write_threshold)
+    : _db(db)
+    , _large_write_threshold(large_write_threshold)
+    , _timer([this] { rotate(); })
+{
+    namespace sm = seastar::metrics;
+
+    _db.data_listeners().install(this);
+    _timer.arm_periodic(window);
+
+    auto top_count = [] (const top_k::results& r) {
+        return r.empty() ? 0 : r.front().count;
+    };
+    _metrics.add_group("hot_partitions", {
+        sm::make_gauge("top_read_count", [this, top_count] { return top_count(_last.reads); },
+                sm::description("Holds the estimated number of reads of the partition of this shard read the most in the last minute")),
+        sm::make_gauge("top_write_count", [this, top_count] { return top_count(_last.writes); },
+                sm::description("Holds the estimated number of writes of the partition of this shard written the most in the last minute")),
+        sm::make_gauge("top_large_write_count", [this, top_count] { return top_count(_last.large_writes); },
+                sm::description("Holds the number of large writes of the partition of this shard which received the most of them in the last minute")),
+    });
+}
+
+hot_partition_tracker::~hot_partition_tracker() {
+    _db.data_listeners().uninstall(this);
+}
+
+void hot_partition_tracker::rotate() {
+    auto top = [] (top_k& k) {
+        auto old = std::exchange(k, top_k(k.capacity()));
+        return old.valid() ? old.top(results_size) : top_k::results{};
+    };
+    try {
+        _last = results{top(_reads), top(_writes), top(_large_writes)};
+    } catch (...) {
+        dblog.debug("hot_partition_tracker: failed to collect the top partitions: {}", std::current_exception());
+        _last = {};
+    }
+}
+
+flat_mutation_reader_v2 hot_partition_tracker::on_read(const schema_ptr& s, const dht::partition_range& range,
+        const query::partition_slice& slice, flat_mutation_reader_v2&& rd) {
+    if (--_reads_to_skip == 0) {
+        _reads_to_skip = sample_period;
+        if (range.is_singular() && range.start()->value().has_key()) {
+            try {
+                _reads.append(toppartitions_item_key{s, range.start()->value().as_decorated_key()}, sample_period);
+            } catch (...) {
+                // The sketch is invalidated and replaced on the next window.
+            }
+        }
+    }
+    return std::move(rd);
+}
+
+void hot_partition_tracker::on_write(const schema_ptr& s, const frozen_mutation& m) {
+    const bool large = m.representation().size() >= _large_write_threshold;
+    const bool sampled = --_writes_to_skip == 0;
+    if (sampled) {
+        _writes_to_skip = sample_period;
+    }
+    if (!large && !sampled) {
+        return;
+    }
+    try {
+        toppartitions_item_key key{s, m.decorated_key(*s)};
+        if (large) {
+            _large_writes.append(key);
+        }
+        if (sampled) {
+            _writes.append(std::move(key), sample_period);
+        }
+    } catch (...) {
+        // The sketch is invalidated and replaced on the next window.
+    }
+}
+
 toppartitions_data_listener::global_top_k::results
 toppartitions_data_listener::globalize(top_k::results&& r) {
     toppartitions_data_listener::global_top_k::results n;
@@ -12,6 +12,9 @@
 #include <seastar/core/future.hh>
 #include <seastar/core/distributed.hh>
 #include <seastar/core/weak_ptr.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
 
 #include "utils/hash.hh"
 #include "schema_fwd.hh"
@@ -44,6 +47,10 @@ class data_listener {
             const query::partition_slice& slice, flat_mutation_reader_v2&& rd) {
         return std::move(rd);
     }
+
+    // Invoked when data of a table changes other than by writes, e.g. when sstables are
+    // streamed or loaded into it, or when it is truncated.
+    virtual future<> on_external_update(const schema_ptr&) { return make_ready_future<>(); }
 };
 
 class data_listeners {
@@ -56,6 +63,7 @@ class data_listeners {
     flat_mutation_reader_v2 on_read(const schema_ptr& s, const dht::partition_range& range,
             const query::partition_slice& slice, flat_mutation_reader_v2&& rd);
     void on_write(const schema_ptr& s, const frozen_mutation& m);
+    future<> on_external_update(const schema_ptr& s);
 
     bool exists(data_listener* listener) const;
     bool empty() const { return _listeners.empty(); }
@@ -138,6 +146,55 @@ class toppartitions_data_listener : public data_listener, public weakly_referenc
     future<> stop();
 };
 
+// Finds the partitions of the shard which were read or written the most in the
+// last window, unlike toppartitions_data_listener which only runs for the
+// duration of a toppartitions request. To keep the overhead low, only every
+// sample_period-th single-partition read and write is counted, with a weight
+// of sample_period. Writes above large_write_threshold are all counted
+// separately, to find partitions which keep receiving large cells.
+class hot_partition_tracker : public data_listener {
+public:
+    using top_k = toppartitions_data_listener::top_k;
+
+    static constexpr unsigned sample_period = 8;
+    static constexpr std::chrono::seconds window = std::chrono::seconds(60);
+    // Number of partitions reported, of each kind, for each window.
+    static constexpr unsigned results_size = 16;
+
+    struct results {
+        top_k::results reads;
+        top_k::results writes;
+        top_k::results large_writes;
+    };
+private:
+    replica::database& _db;
+    size_t _large_write_threshold;
+    unsigned _reads_to_skip = sample_period;
+    unsigned _writes_to_skip = sample_period;
+    top_k _reads;
+    top_k _writes;
+    top_k _large_writes;
+    // The top partitions of the last complete window.
+    results _last;
+    timer<lowres_clock> _timer;
+    seastar::metrics::metric_groups _metrics;
+public:
+    hot_partition_tracker(replica::database& db, size_t large_write_threshold);
+    ~hot_partition_tracker();
+
+    // Ends the current window, called every window.
+    void rotate();
+
+    virtual flat_mutation_reader_v2 on_read(const schema_ptr& s, const dht::partition_range& range,
+            const query::partition_slice& slice, flat_mutation_reader_v2&& rd) override;
+
+    virtual void on_write(const schema_ptr& s, const frozen_mutation& m) override;
+
+    const results& last_results() const noexcept {
+        return _last;
+    }
+};
+
 class toppartitions_query {
     distributed<replica::database>& _xdb;
     std::unordered_set<std::tuple<sstring, sstring>, utils::tuple_hash> _table_filters;
@@ -68,6 +68,26 @@ class aggregate_function : public virtual function {
          */
         virtual void add_input(cql_serialization_format sf, const std::vector<opt_bytes>& values) = 0;
 
+        /**
+         * Adds the inputs of several rows to this aggregate, in order.
+         *
+         * Aggregates which can process many values at once, faster than one by one,
+         * override it.
+         *
+         * @param sf native protocol version
+         * @param columns the values of each argument, one per row.
+         * @param rows the number of rows.
+         */
+        virtual void add_inputs(cql_serialization_format sf, const std::vector<std::vector<opt_bytes>>& columns, size_t rows) {
+            std::vector<opt_bytes> values(columns.size());
+            for (size_t row = 0; row < rows; ++row) {
+                for (size_t i = 0; i < columns.size(); ++i) {
+                    values[i] = columns[i][row];
+                }
+                add_input(sf, values);
+            }
+        }
+
         /**
          * Computes and returns the aggregate current value.
          *
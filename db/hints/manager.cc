@@ -80,6 +80,9 @@ void manager::register_metrics(const sstring& group_name) {
         sm::make_counter("discarded", _stats.discarded,
                         sm::description("Number of hints that were discarded during sending (too old, schema changed, etc.).")),
 
+        sm::make_counter("merged", _stats.merged,
+                        sm::description("Number of hints that were merged into a hint of the same partition and sent along with it.")),
+
         sm::make_counter("corrupted_files", _stats.corrupted_files,
                         sm::description("Number of hints files that were discarded during sending because the file was corrupted.")),
 
@@ -169,6 +172,16 @@ sync_point::shard_rps manager::calculate_current_sync_point(const std::vector<gm
     return rps;
 }
 
+std::vector<gms::inet_address> manager::endpoints_with_segments_to_replay() const {
+    std::vector<gms::inet_address> eps;
+    for (auto& [ep, ep_man] : _ep_managers) {
+        if (ep_man.have_segments_to_replay()) {
+            eps.push_back(ep);
+        }
+    }
+    return eps;
+}
+
 future<> manager::wait_for_sync_point(abort_source& as, const sync_point::shard_rps& rps) {
     abort_source local_as;
 
@@ -855,52 +868,125 @@ future<> manager::end_point_hints_manager::sender::send_one_mutation(frozen_muta
     return do_send_one_mutation(std::move(m), natural_endpoints);
 }
 
-future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
-    return _resource_manager.get_send_units_for(buf.size_bytes()).then([this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] (auto units) mutable {
+future<> manager::end_point_hints_manager::sender::add_pending_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer& buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname) {
+    try {
+        auto m = this->get_mutation(ctx_ptr, buf);
+        gc_clock::duration gc_grace_sec = m.s->gc_grace_seconds();
+
+        // The hint is too old - drop it.
+        //
+        // Files are aggregated for at most manager::hints_timer_period therefore the oldest hint there is
+        // (last_modification - manager::hints_timer_period) old.
+        if (gc_clock::now().time_since_epoch() - secs_since_file_mod > gc_grace_sec - manager::hints_flush_period) {
+            ctx_ptr->on_hint_send_success(rp);
+            co_return;
+        }
+
+        // Hints of a partition which is written to over and over while the node
+        // is down are sent as one, so each cell is sent only once.
+        auto token = dht::get_token(*m.s, m.fm.key());
+        auto find_pending = [&] {
+            auto [begin, end] = ctx_ptr->pending_hints_by_token.equal_range(token);
+            auto it = std::find_if(begin, end, [&] (const auto& e) {
+                auto& h = ctx_ptr->pending_hints[e.second];
+                return h.m.s == m.s && h.m.fm.key().equal(*m.s, m.fm.key());
+            });
+            return it == end ? nullptr : &ctx_ptr->pending_hints[it->second];
+        };
+
+        // Held back hints take their send units right away, so that they
+        // count towards the memory of hints being sent. A hint which is
+        // merged into another one only takes units for its own size.
+        auto h = find_pending();
+        auto units = h ? _resource_manager.try_get_memory_units_for(buf.size_bytes()) : _resource_manager.try_get_send_units_for(buf.size_bytes());
+        if (!units) {
+            // The budget may be held by the hints held back here, so
+            // send them before waiting.
+            co_await send_pending_hints(ctx_ptr);
+            units = co_await _resource_manager.get_send_units_for(buf.size_bytes());
+            h = nullptr;
+        }
+
         ctx_ptr->mark_hint_as_in_progress(rp);
+        ctx_ptr->pending_hints_size += buf.size_bytes();
 
-        // Future is waited on indirectly in `send_one_file()` (via `ctx_ptr->file_send_gate`).
-        (void)with_gate(ctx_ptr->file_send_gate, [this, secs_since_file_mod, &fname, buf = std::move(buf), rp, ctx_ptr] () mutable {
-            try {
-                auto m = this->get_mutation(ctx_ptr, buf);
-                gc_clock::duration gc_grace_sec = m.s->gc_grace_seconds();
-
-                // The hint is too old - drop it.
-                //
-                // Files are aggregated for at most manager::hints_timer_period therefore the oldest hint there is
-                // (last_modification - manager::hints_timer_period) old.
-                if (gc_clock::now().time_since_epoch() - secs_since_file_mod > gc_grace_sec - manager::hints_flush_period) {
-                    return make_ready_future<>();
-                }
+        if (!h) {
+            ctx_ptr->pending_hints_by_token.emplace(token, ctx_ptr->pending_hints.size());
+            ctx_ptr->pending_hints.push_back({std::move(m), token, std::nullopt, {rp}, buf.size_bytes(), std::move(*units)});
+            co_return;
+        }
+        if (!h->merged) {
+            h->merged = h->m.fm.unfreeze(h->m.s);
+        }
+        h->merged->apply(m.fm.unfreeze(m.s));
+        h->rps.push_back(rp);
+        h->size += buf.size_bytes();
+        h->units.adopt(std::move(*units));
+        ++this->shard_stats().merged;
+
+    // ignore these errors and move on - probably this hint is too old and the KS/CF has been deleted...
+    } catch (replica::no_such_column_family& e) {
+        manager_logger.debug("send_hints(): no_such_column_family: {}", e.what());
+        ++this->shard_stats().discarded;
+        ctx_ptr->on_hint_send_success(rp);
+    } catch (replica::no_such_keyspace& e) {
+        manager_logger.debug("send_hints(): no_such_keyspace: {}", e.what());
+        ++this->shard_stats().discarded;
+        ctx_ptr->on_hint_send_success(rp);
+    } catch (no_column_mapping& e) {
+        manager_logger.debug("send_hints(): {} at {}: {}", fname, rp, e.what());
+        ++this->shard_stats().discarded;
+        ctx_ptr->on_hint_send_success(rp);
+    } catch (...) {
+        manager_logger.debug("send_hints(): unexpected error in file {} at {}: {}", fname, rp, std::current_exception());
+        ctx_ptr->on_hint_send_failure(rp);
+    }
+}
 
-                return this->send_one_mutation(std::move(m)).then([this, rp, ctx_ptr] {
-                    ++this->shard_stats().sent;
-                }).handle_exception([this, ctx_ptr, rp] (auto eptr) {
-                    manager_logger.trace("send_one_hint(): failed to send to {}: {}", end_point_key(), eptr);
-                    return make_exception_future<>(std::move(eptr));
-                });
+future<> manager::end_point_hints_manager::sender::send_pending_hints(lw_shared_ptr<send_one_file_ctx> ctx_ptr) {
+    auto hints = std::exchange(ctx_ptr->pending_hints, {});
+    ctx_ptr->pending_hints_by_token.clear();
+    ctx_ptr->pending_hints_size = 0;
 
-            // ignore these errors and move on - probably this hint is too old and the KS/CF has been deleted...
-            } catch (replica::no_such_column_family& e) {
-                manager_logger.debug("send_hints(): no_such_column_family: {}", e.what());
-                ++this->shard_stats().discarded;
-            } catch (replica::no_such_keyspace& e) {
-                manager_logger.debug("send_hints(): no_such_keyspace: {}", e.what());
-                ++this->shard_stats().discarded;
-            } catch (no_column_mapping& e) {
-                manager_logger.debug("send_hints(): {} at {}: {}", fname, rp, e.what());
-                ++this->shard_stats().discarded;
-            } catch (...) {
-                auto eptr = std::current_exception();
-                manager_logger.debug("send_hints(): unexpected error in file {} at {}: {}", fname, rp, eptr);
-                return make_exception_future<>(std::move(eptr));
+    // Send in token order, so that the destination applies hints of
+    // neighbouring partitions one after another.
+    std::sort(hints.begin(), hints.end(), [] (const auto& a, const auto& b) {
+        return a.token < b.token;
+    });
+    for (auto& h : hints) {
+        if ((!draining() && ctx_ptr->segment_replay_failed) || !can_send()) {
+            for (auto rp : h.rps) {
+                ctx_ptr->on_hint_send_failure(rp);
             }
-            return make_ready_future<>();
-        }).then_wrapped([this, units = std::move(units), rp, ctx_ptr] (future<>&& f) {
+            continue;
+        }
+        co_await send_one_hint(ctx_ptr, std::move(h));
+    }
+}
+
+future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, send_one_file_ctx::pending_hint h) {
+    auto rps = h.rps;
+    // The hint holds the send units it took when it was read from the file.
+    return futurize_invoke([this, h = std::move(h), ctx_ptr] () mutable {
+        auto units = std::move(h.units);
+        auto rps = h.rps;
+        // Future is waited on indirectly in `send_one_file()` (via `ctx_ptr->file_send_gate`).
+        (void)with_gate(ctx_ptr->file_send_gate, [this, h = std::move(h), ctx_ptr] () mutable {
+            auto hints = h.rps.size();
+            auto m = h.merged ? frozen_mutation_and_schema{freeze(*h.merged), h.m.s} : std::move(h.m);
+            return this->send_one_mutation(std::move(m)).then([this, hints] {
+                this->shard_stats().sent += hints;
+            }).handle_exception([this, ctx_ptr] (auto eptr) {
+                manager_logger.trace("send_one_hint(): failed to send to {}: {}", end_point_key(), eptr);
+                return make_exception_future<>(std::move(eptr));
+            });
+        }).then_wrapped([this, units = std::move(units), rps = std::move(rps), ctx_ptr] (future<>&& f) {
             // Information about the error was already printed somewhere higher.
             // We just need to account in the ctx that sending of this hint has failed.
             if (!f.failed()) {
-                ctx_ptr->on_hint_send_success(rp);
+                for (auto rp : rps) {
+                    ctx_ptr->on_hint_send_success(rp);
+                }
                 auto new_bound = ctx_ptr->get_replayed_bound();
                 // Segments from other shards are replayed first and are considered to be "before" replay position 0.
                 // Update the sent upper bound only if it is a local segment.
@@ -909,13 +995,17 @@ future<> manager::end_point_hints_manager::sender::send_one_hint(lw_shared_ptr<s
                     notify_replay_waiters();
                 }
             } else {
-                ctx_ptr->on_hint_send_failure(rp);
+                for (auto rp : rps) {
+                    ctx_ptr->on_hint_send_failure(rp);
+                }
             }
             f.ignore_ready_future();
         });
-    }).handle_exception([this, ctx_ptr, rp] (auto eptr) {
+    }).handle_exception([this, ctx_ptr, rps = std::move(rps)] (auto eptr) {
         manager_logger.trace("send_one_file(): Hmmm. Something bad had happend: {}", eptr);
-        ctx_ptr->on_hint_send_failure(rp);
+        for (auto rp : rps) {
+            ctx_ptr->on_hint_send_failure(rp);
+        }
     });
 }
 
@@ -996,6 +1086,17 @@ void manager::end_point_hints_manager::sender::send_one_file_ctx::on_hint_send_f
     }
 }
 
+void manager::end_point_hints_manager::sender::send_one_file_ctx::fail_pending_hints() noexcept {
+    for (auto& h : pending_hints) {
+        for (auto rp : h.rps) {
+            on_hint_send_failure(rp);
+        }
+    }
+    pending_hints.clear();
+    pending_hints_by_token.clear();
+    pending_hints_size = 0;
+}
+
 db::replay_position manager::end_point_hints_manager::sender::send_one_file_ctx::get_replayed_bound() const noexcept {
     // We are sure that all hints were sent _below_ the position which is the minimum of the following:
     // - Position of the first hint that failed to be sent in this replay (first_failed_rp),
@@ -1063,18 +1164,25 @@ bool manager::end_point_hints_manager::sender::send_one_file(const sstring& fnam
                     co_await sleep(std::chrono::milliseconds(100));
                     continue;
                 } else {
-                    co_await send_one_hint(ctx_ptr, std::move(buf), rp, secs_since_file_mod, fname);
+                    co_await add_pending_hint(ctx_ptr, buf, rp, secs_since_file_mod, fname);
+                    if (ctx_ptr->pending_hints.size() >= max_pending_hints || ctx_ptr->pending_hints_size >= max_pending_hints_size) {
+                        co_await send_pending_hints(ctx_ptr);
+                    }
                     break;
                 }
             };
         }, _last_not_complete_rp.pos, &_db.extensions()).get();
+        send_pending_hints(ctx_ptr).get();
     } catch (db::commitlog::segment_error& ex) {
         manager_logger.error("{}: {}. Dropping...", fname, ex.what());
         ctx_ptr->segment_replay_failed = false;
         ++this->shard_stats().corrupted_files;
+        // Hints read before the corruption are still worth sending.
+        send_pending_hints(ctx_ptr).get();
     } catch (...) {
         manager_logger.trace("sending of {} failed: {}", fname, std::current_exception());
         ctx_ptr->segment_replay_failed = true;
+        ctx_ptr->fail_pending_hints();
     }
 
     // wait till all background hints sending is complete
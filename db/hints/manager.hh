@@ -27,6 +27,8 @@
 #include "db/hints/resource_manager.hh"
 #include "db/hints/host_filter.hh"
 #include "db/hints/sync_point.hh"
+#include "frozen_mutation.hh"
+#include "mutation.hh"
 
 class fragmented_temporary_buffer;
 
@@ -74,6 +76,7 @@ class manager {
         uint64_t dropped = 0;
         uint64_t sent = 0;
         uint64_t discarded = 0;
+        uint64_t merged = 0;
         uint64_t corrupted_files = 0;
     };
 
@@ -108,6 +111,8 @@ class manager {
                 state::ep_state_left_the_ring,
                 state::draining>>;
 
+            using send_units = semaphore_units<named_semaphore::exception_factory>;
+
             struct send_one_file_ctx {
                 send_one_file_ctx(std::unordered_map<table_schema_version, column_mapping>& last_schema_ver_to_column_mapping)
                     : schema_ver_to_column_mapping(last_schema_ver_to_column_mapping)
@@ -119,14 +124,37 @@ class manager {
                 std::set<db::replay_position> in_progress_rps;
                 bool segment_replay_failed = false;
 
+                // A hint read from the file and not sent yet, with the hints of the
+                // same partition read after it merged into it.
+                struct pending_hint {
+                    frozen_mutation_and_schema m;
+                    dht::token token;
+                    std::optional<mutation> merged;
+                    std::vector<db::replay_position> rps;
+                    size_t size;
+                    send_units units;
+                };
+                std::vector<pending_hint> pending_hints;
+                std::unordered_multimap<dht::token, size_t> pending_hints_by_token;
+                size_t pending_hints_size = 0;
+
                 void mark_hint_as_in_progress(db::replay_position rp);
                 void on_hint_send_success(db::replay_position rp) noexcept;
                 void on_hint_send_failure(db::replay_position rp) noexcept;
 
+                // Accounts the pending hints as failed to be sent, and forgets them.
+                void fail_pending_hints() noexcept;
+
                 // Returns a position below which hints were successfully replayed.
                 db::replay_position get_replayed_bound() const noexcept;
             };
 
+            // Hints read from a file are held back until this many of them...
+            static constexpr size_t max_pending_hints = 128;
+            // ...or this many bytes of them were read, so that hints of the same
+            // partition are merged and sent as one.
+            static constexpr size_t max_pending_hints_size = 1024 * 1024;
+
         private:
             std::list<sstring> _segments_to_replay;
             // Segments to replay which were not created on this shard but were moved during rebalancing
@@ -230,19 +258,34 @@ class manager {
                 return _ep_manager.replay_allowed();
             }
 
-            /// \brief Try to send one hint read from the file.
-            ///  - Limit the maximum memory size of hints "in the air" and the maximum total number of hints "in the air".
+            /// \brief Add a hint read from the file to the pending hints of the file.
             ///  - Discard the hints that are older than the grace seconds value of the corresponding table.
-            ///
-            /// If sending fails we are going to set the state::segment_replay_failed in the _state and _first_failed_rp will be updated to min(_first_failed_rp, \ref rp).
+            ///  - Merge the hint into a pending hint of the same partition, if there is one.
+            ///  - Take the send units of the hint, sending the pending hints first if they aren't available.
             ///
             /// \param ctx_ptr shared pointer to the file sending context
             /// \param buf buffer representing the hint
             /// \param rp replay position of this hint in the file (see commitlog for more details on "replay position")
             /// \param secs_since_file_mod last modification time stamp (in seconds since Epoch) of the current hints file
             /// \param fname name of the hints file this hint was read from
+            future<> add_pending_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer& buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname);
+
+            /// \brief Send the pending hints of the file in token order.
+            ///
+            /// \param ctx_ptr shared pointer to the file sending context
+            /// \return future that resolves when the last of them may be sent
+            future<> send_pending_hints(lw_shared_ptr<send_one_file_ctx> ctx_ptr);
+
+            /// \brief Try to send one pending hint.
+            ///  - Limit the maximum memory size of hints "in the air" and the maximum total number of hints "in the air".
+            ///
+            /// If sending fails we are going to set the state::segment_replay_failed in the _state and _first_failed_rp will be updated to min(_first_failed_rp, rp)
+            /// for every replay position of the hints merged into the pending one.
+            ///
+            /// \param ctx_ptr shared pointer to the file sending context
+            /// \param h the pending hint
             /// \return future that resolves when next hint may be sent
-            future<> send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, fragmented_temporary_buffer buf, db::replay_position rp, gc_clock::duration secs_since_file_mod, const sstring& fname);
+            future<> send_one_hint(lw_shared_ptr<send_one_file_ctx> ctx_ptr, send_one_file_ctx::pending_hint h);
 
             /// \brief Send all hint from a single file and delete it after it has been successfully sent.
             /// Send all hints from the given file. If we failed to send the current segment we will pick up in the next
@@ -429,6 +472,11 @@ class manager {
             return _last_written_rp;
         }
 
+        /// \return TRUE if there are hints files waiting to be replayed.
+        bool have_segments_to_replay() const noexcept {
+            return _sender.have_segments();
+        }
+
         /// \brief Waits until hints are replayed up to a given replay position, or given abort source is triggered.
         future<> wait_until_hints_are_replayed_up_to(abort_source& as, db::replay_position up_to_rp) {
             return _sender.wait_until_hints_are_replayed_up_to(as, up_to_rp);
@@ -634,6 +682,9 @@ class manager {
     /// \brief Returns a set of replay positions for hint queues towards endpoints from the `target_hosts`.
     sync_point::shard_rps calculate_current_sync_point(const std::vector<gms::inet_address>& target_hosts) const;
 
+    /// \brief Returns the endpoints towards which hints files are waiting to be replayed.
+    std::vector<gms::inet_address> endpoints_with_segments_to_replay() const;
+
     /// \brief Waits until hint replay reach replay positions described in `rps`.
     future<> wait_for_sync_point(abort_source& as, const sync_point::shard_rps& rps);
 
@@ -39,7 +39,7 @@ future<bool> is_mountpoint(const fs::path& path) {
     });
 }
 
-future<semaphore_units<named_semaphore::exception_factory>> resource_manager::get_send_units_for(size_t buf_size) {
+size_t resource_manager::send_budget_for(size_t buf_size) const {
     // In order to impose a limit on the number of hints being sent concurrently,
     // require each hint to reserve at least 1/(max concurrency) of the shard budget
     const size_t per_node_concurrency_limit = _max_hints_send_queue_length();
@@ -52,7 +52,19 @@ future<semaphore_units<named_semaphore::exception_factory>> resource_manager::ge
     // Allow a very big mutation to be sent out by consuming the whole shard budget
     hint_memory_budget = std::min(hint_memory_budget, _max_send_in_flight_memory);
     resource_manager_logger.trace("memory budget: need {} have {}", hint_memory_budget, _send_limiter.available_units());
-    return get_units(_send_limiter, hint_memory_budget);
+    return hint_memory_budget;
+}
+
+future<semaphore_units<named_semaphore::exception_factory>> resource_manager::get_send_units_for(size_t buf_size) {
+    return get_units(_send_limiter, send_budget_for(buf_size));
+}
+
+std::optional<semaphore_units<named_semaphore::exception_factory>> resource_manager::try_get_send_units_for(size_t buf_size) {
+    return try_get_units(_send_limiter, send_budget_for(buf_size));
+}
+
+std::optional<semaphore_units<named_semaphore::exception_factory>> resource_manager::try_get_memory_units_for(size_t buf_size) {
+    return try_get_units(_send_limiter, std::min(buf_size, _max_send_in_flight_memory));
 }
 
 size_t resource_manager::sending_queue_length() const {
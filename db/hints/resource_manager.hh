@@ -159,6 +159,7 @@ class resource_manager {
     }
 
     future<> prepare_per_device_limits(manager& shard_manager);
+    size_t send_budget_for(size_t buf_size) const;
 
 public:
     static constexpr size_t hint_segment_size_in_mb = 32;
@@ -178,6 +179,11 @@ class resource_manager {
     resource_manager& operator=(resource_manager&&) = delete;
 
     future<semaphore_units<named_semaphore::exception_factory>> get_send_units_for(size_t buf_size);
+    // Like get_send_units_for(), but returns std::nullopt instead of waiting.
+    std::optional<semaphore_units<named_semaphore::exception_factory>> try_get_send_units_for(size_t buf_size);
+    // Units for the memory of a hint which is sent as part of another one,
+    // without the share of the concurrency limit get_send_units_for() takes.
+    std::optional<semaphore_units<named_semaphore::exception_factory>> try_get_memory_units_for(size_t buf_size);
     size_t sending_queue_length() const;
 
     future<> start(shared_ptr<service::storage_proxy> proxy_ptr, shared_ptr<gms::gossiper> gossiper_ptr);
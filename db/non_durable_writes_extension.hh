@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <chrono>
+#include <boost/range/adaptor/map.hpp>
+
+#include "exceptions/exceptions.hh"
+#include "serializer.hh"
+#include "schema.hh"
+
+namespace db {
+
+/**
+ * \brief Schema extension which represents the `non_durable_writes` per-table option.
+ *
+ * Writes to a table with this option skip the commitlog, like writes to a keyspace with
+ * `durable_writes = false`. Instead of losing all data which was not flushed yet on
+ * a crash, the memtables of the table are flushed every `flush_period_in_ms`, so at most
+ * about the writes of the last period, plus the time a flush takes, are lost.
+ *
+ * Meant for tables which can be rebuilt or tolerate loss, like caches and derived data,
+ * where the commitlog only costs write bandwidth.
+ */
+class non_durable_writes_extension : public schema_extension {
+    static constexpr auto flush_period_key = "flush_period_in_ms";
+
+    std::chrono::milliseconds _flush_period = std::chrono::seconds(60);
+public:
+    static constexpr auto NAME = "non_durable_writes";
+
+    non_durable_writes_extension() = default;
+
+    explicit non_durable_writes_extension(std::chrono::milliseconds flush_period)
+        : _flush_period(flush_period)
+    {}
+
+    explicit non_durable_writes_extension(std::map<sstring, sstring> map) {
+        if (auto it = map.find(flush_period_key); it != map.end()) {
+            int64_t ms;
+            try {
+                ms = std::stoll(it->second);
+            } catch (std::logic_error&) {
+                throw exceptions::configuration_exception(format("Invalid value for {} option: expected a number", flush_period_key));
+            }
+            if (ms <= 0) {
+                throw exceptions::configuration_exception(format("Invalid value for {} option: must be positive", flush_period_key));
+            }
+            _flush_period = std::chrono::milliseconds(ms);
+            map.erase(it);
+        }
+        if (!map.empty()) {
+            throw exceptions::configuration_exception(format(
+                    "Unknown keys in map for non_durable_writes extension: {}",
+                    ::join(", ", map | boost::adaptors::map_keys)));
+        }
+    }
+
+    explicit non_durable_writes_extension(const bytes& b) : non_durable_writes_extension(deserialize(b)) {}
+
+    explicit non_durable_writes_extension(const sstring& s) {
+        throw std::logic_error("Cannot create non_durable_writes info from string");
+    }
+
+    bytes serialize() const override {
+        return ser::serialize_to_buffer<bytes>(to_map());
+    }
+
+    static std::map<sstring, sstring> deserialize(const bytes_view& buffer) {
+        return ser::deserialize_from_buffer(buffer, boost::type<std::map<sstring, sstring>>());
+    }
+
+    std::map<sstring, sstring> to_map() const {
+        return {{flush_period_key, std::to_string(_flush_period.count())}};
+    }
+
+    std::chrono::milliseconds flush_period() const {
+        return _flush_period;
+    }
+};
+
+} // namespace db
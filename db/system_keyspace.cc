@@ -34,6 +34,7 @@
 #include "query_context.hh"
 #include "partition_slice_builder.hh"
 #include "db/config.hh"
+#include "db/data_listeners.hh"
 #include "gms/feature_service.hh"
 #include "system_keyspace_view_types.hh"
 #include "schema_builder.hh"
@@ -65,6 +66,7 @@
 #include "idl/frozen_mutation.dist.impl.hh"
 #include <boost/algorithm/cxx11/any_of.hpp>
 #include "client_data.hh"
+#include "utils/error_injection.hh"
 
 using days = std::chrono::duration<int, std::ratio<24 * 3600>>;
 
@@ -2374,6 +2376,158 @@ class runtime_info_table : public memtable_filling_virtual_table {
     }
 };
 
+// The partitions read and written the most in the last window, over all shards,
+// see db::hot_partition_tracker.
+class hot_partitions_table : public memtable_filling_virtual_table {
+private:
+    distributed<replica::database>& _db;
+
+    using global_top_k = toppartitions_data_listener::global_top_k;
+    struct global_results {
+        global_top_k::results reads;
+        global_top_k::results writes;
+        global_top_k::results large_writes;
+    };
+
+public:
+    explicit hot_partitions_table(distributed<replica::database>& db)
+        : memtable_filling_virtual_table(build_schema())
+        , _db(db) {
+        _shard_aware = true;
+    }
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "hot_partitions");
+        return schema_builder(system_keyspace::NAME, "hot_partitions", std::make_optional(id))
+            .with_column("kind", utf8_type, column_kind::partition_key)
+            .with_column("rank", int32_type, column_kind::clustering_key)
+            .with_column("keyspace_name", utf8_type)
+            .with_column("table_name", utf8_type)
+            .with_column("partition_key", utf8_type)
+            .with_column("count", long_type)
+            .with_column("error", long_type)
+            .set_comment("Partitions of this node read or written the most in the last minute, estimated from a sample. "
+                    "Kind is one of read, write and large_write.")
+            .with_version(system_keyspace::generate_schema_version(id))
+            .build();
+    }
+
+    future<> execute(std::function<void(mutation)> mutation_sink) override {
+        using top_k = hot_partition_tracker::top_k;
+        auto res = co_await _db.map_reduce0([] (replica::database& db) {
+            // Lets tests see the partitions of the current window without waiting for it to end.
+            if (utils::get_local_injector().enter("hot_partitions_end_window")) {
+                db.hot_partition_tracker().rotate();
+            }
+            const auto& last = db.hot_partition_tracker().last_results();
+            return make_foreign(std::make_unique<global_results>(global_results{
+                toppartitions_data_listener::globalize(top_k::results(last.reads)),
+                toppartitions_data_listener::globalize(top_k::results(last.writes)),
+                toppartitions_data_listener::globalize(top_k::results(last.large_writes)),
+            }));
+        }, std::array<top_k, 3>{}, [] (std::array<top_k, 3> res, foreign_ptr<std::unique_ptr<global_results>> shard_res) {
+            res[0].append(toppartitions_data_listener::localize(shard_res->reads));
+            res[1].append(toppartitions_data_listener::localize(shard_res->writes));
+            res[2].append(toppartitions_data_listener::localize(shard_res->large_writes));
+            return res;
+        });
+
+        static const std::array<sstring, 3> kinds = {"read", "write", "large_write"};
+        for (size_t i = 0; i < kinds.size(); ++i) {
+            auto dk = dht::decorate_key(*_s, partition_key::from_single_value(*schema(), data_value(kinds[i]).serialize_nonnull()));
+            if (!this_shard_owns(dk)) {
+                continue;
+            }
+            mutation m(schema(), std::move(dk));
+            int32_t rank = 0;
+            for (auto& r : res[i].top(hot_partition_tracker::results_size)) {
+                auto ck = clustering_key::from_single_value(*schema(), data_value(rank++).serialize_nonnull());
+                row& cr = m.partition().clustered_row(*schema(), ck).cells();
+                set_cell(cr, "keyspace_name", r.item.schema->ks_name());
+                set_cell(cr, "table_name", r.item.schema->cf_name());
+                set_cell(cr, "partition_key", sstring(r.item));
+                set_cell(cr, "count", int64_t(r.count));
+                set_cell(cr, "error", int64_t(r.error));
+            }
+            mutation_sink(std::move(m));
+        }
+    }
+};
+
+// The costs of the finished reads of each table, summed over all shards and
+// semaphores of the node. Reads are accounted when their permit is destroyed,
+// so a paged query is accounted once its querier is dropped.
+class read_costs_table : public memtable_filling_virtual_table {
+private:
+    distributed<replica::database>& _db;
+
+    struct read_cost {
+        uint64_t reads = 0;
+        reader_permit::read_cost cost;
+    };
+    using read_costs = std::map<std::pair<sstring, sstring>, read_cost>;
+
+public:
+    explicit read_costs_table(distributed<replica::database>& db)
+        : memtable_filling_virtual_table(build_schema())
+        , _db(db) {
+        _shard_aware = true;
+    }
+
+    static schema_ptr build_schema() {
+        auto id = generate_legacy_id(system_keyspace::NAME, "read_costs");
+        return schema_builder(system_keyspace::NAME, "read_costs", std::make_optional(id))
+            .with_column("keyspace_name", utf8_type, column_kind::partition_key)
+            .with_column("table_name", utf8_type, column_kind::partition_key)
+            .with_column("reads", long_type)
+            .with_column("disk_reads", long_type)
+            .with_column("disk_bytes_read", long_type)
+            .with_column("sstables_read", long_type)
+            .with_column("active_time_us", long_type)
+            .set_comment("Costs of the reads of each table on this node, since it started.")
+            .with_version(system_keyspace::generate_schema_version(id))
+            .build();
+    }
+
+    future<> execute(std::function<void(mutation)> mutation_sink) override {
+        auto costs = co_await _db.map_reduce0([] (replica::database& db) {
+            read_costs res;
+            for (auto* sem : db.get_reader_concurrency_semaphores()) {
+                for (const auto& [_, c] : sem->table_read_costs()) {
+                    auto& rc = res[{c.ks_name, c.cf_name}];
+                    rc.reads += c.reads;
+                    rc.cost += c.cost;
+                }
+            }
+            return res;
+        }, read_costs{}, [] (read_costs a, read_costs b) {
+            for (auto& [key, c] : b) {
+                auto& rc = a[key];
+                rc.reads += c.reads;
+                rc.cost += c.cost;
+            }
+            return a;
+        });
+        for (const auto& [key, c] : costs) {
+            auto dk = dht::decorate_key(*_s, partition_key::from_exploded(*_s, {
+                data_value(key.first).serialize_nonnull(),
+                data_value(key.second).serialize_nonnull()
+            }));
+            if (!this_shard_owns(dk)) {
+                continue;
+            }
+            mutation m(schema(), std::move(dk));
+            row& cr = m.partition().clustered_row(*schema(), clustering_key::make_empty()).cells();
+            set_cell(cr, "reads", int64_t(c.reads));
+            set_cell(cr, "disk_reads", int64_t(c.cost.disk_reads));
+            set_cell(cr, "disk_bytes_read", int64_t(c.cost.disk_bytes_read));
+            set_cell(cr, "sstables_read", int64_t(c.cost.sstables_read));
+            set_cell(cr, "active_time_us", int64_t(std::chrono::duration_cast<std::chrono::microseconds>(c.cost.active_time).count()));
+            mutation_sink(std::move(m));
+        }
+    }
+};
+
 class versions_table : public memtable_filling_virtual_table {
 public:
     explicit versions_table()
@@ -2526,6 +2680,7 @@ class clients_table : public streaming_virtual_table {
             .with_column("ssl_enabled", boolean_type)
             .with_column("ssl_protocol", utf8_type)
             .with_column("username", utf8_type)
+            .with_column("requests_for_other_shards", long_type)
             .with_version(system_keyspace::generate_schema_version(id))
             .build();
     }
@@ -2632,6 +2787,9 @@ class clients_table : public streaming_virtual_table {
                     set_cell(cr.cells(), "ssl_protocol", *cd.ssl_protocol);
                 }
                 set_cell(cr.cells(), "username", cd.username ? *cd.username : sstring("anonymous"));
+                if (cd.requests_for_other_shards) {
+                    set_cell(cr.cells(), "requests_for_other_shards", *cd.requests_for_other_shards);
+                }
                 co_await result.emit_row(std::move(cr));
             }
             co_await result.emit_partition_end();
@@ -2665,6 +2823,8 @@ void register_virtual_tables(distributed<replica::database>& dist_db, distribute
     add_table(std::make_unique<snapshots_table>(dist_db));
     add_table(std::make_unique<protocol_servers_table>(ss));
     add_table(std::make_unique<runtime_info_table>(dist_db, ss));
+    add_table(std::make_unique<read_costs_table>(dist_db));
+    add_table(std::make_unique<hot_partitions_table>(dist_db));
     add_table(std::make_unique<versions_table>());
     add_table(std::make_unique<db_config_table>(cfg));
     add_table(std::make_unique<clients_table>(ss));
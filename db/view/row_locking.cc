@@ -64,6 +64,14 @@ row_locker::lock_pk(const dht::decorated_key& pk, bool exclusive, db::timeout_cl
     // Note: we rely on the fact that &i->first, the pointer to a key, never
     // becomes invalid (as long as the item is actually in the hash table),
     // even in the case of rehashing.
+    if (f.available() && !f.failed()) {
+        // Uncontended, which is the common case: don't pay for a continuation.
+        f.get();
+        single_lock_stats.estimated_waiting_for_lock.add(waiting_latency.stop().latency());
+        single_lock_stats.lock_acquisitions++;
+        single_lock_stats.operations_currently_waiting_for_lock--;
+        return make_ready_future<lock_holder>(this, &i->first, exclusive);
+    }
     return f.then([this, pk = &i->first, exclusive, &single_lock_stats, waiting_latency = std::move(waiting_latency)] () mutable {
         waiting_latency.stop();
         single_lock_stats.estimated_waiting_for_lock.add(waiting_latency.latency());
@@ -103,6 +111,15 @@ row_locker::lock_ck(const dht::decorated_key& pk, const clustering_key_prefix& c
     utils::latency_counter waiting_latency;
     waiting_latency.start();
     future<lock_type::holder> lock_row = exclusive ? j->second.hold_write_lock(timeout) : j->second.hold_read_lock(timeout);
+    if (lock_partition.available() && !lock_partition.failed() && lock_row.available() && !lock_row.failed()) {
+        // Both locks were free, skip when_all_succeed() and its continuation.
+        lock_partition.get0().release();
+        lock_row.get0().release();
+        single_lock_stats.estimated_waiting_for_lock.add(waiting_latency.stop().latency());
+        single_lock_stats.lock_acquisitions++;
+        single_lock_stats.operations_currently_waiting_for_lock--;
+        return make_ready_future<lock_holder>(this, &i->first, &j->first, exclusive);
+    }
     return when_all_succeed(std::move(lock_partition), std::move(lock_row))
     .then_unpack([this, pk = &i->first, cpk = &j->first, exclusive, &single_lock_stats, waiting_latency = std::move(waiting_latency)] (auto lock1, auto lock2) mutable {
         lock1.release();
@@ -34,6 +34,7 @@
 #include "db/view/view.hh"
 #include "db/view/view_builder.hh"
 #include "db/view/view_updating_consumer.hh"
+#include "db/view/view_update_queue.hh"
 #include "db/system_keyspace_view_types.hh"
 #include "db/system_keyspace.hh"
 #include "db/system_distributed_keyspace.hh"
@@ -54,6 +55,7 @@
 #include "utils/error_injection.hh"
 #include "utils/exponential_backoff_retry.hh"
 #include "utils/fb_utilities.hh"
+#include "utils/code_region.hh"
 #include "query-result-writer.hh"
 #include "readers/from_fragments_v2.hh"
 #include "readers/evictable.hh"
@@ -121,6 +123,36 @@ const column_definition* view_info::view_column(const column_definition& base_de
     return _schema.get_column_definition(base_def.name());
 }
 
+const std::vector<bool>& view_info::regular_columns_affecting_view(const schema& base) const {
+    if (_affecting_columns_version == base.version()) {
+        return _affecting_columns;
+    }
+    std::vector<bool> affecting(base.regular_columns_count(), false);
+    bool all = false;
+    for (const column_definition& cdef : base.regular_columns()) {
+        if (view_column(cdef)) {
+            affecting[cdef.id] = true;
+        } else if (!has_base_non_pk_columns_in_view_pk()) {
+            // Views whose primary key is the base's include unselected columns
+            // as virtual columns, which keep view rows alive. Views created
+            // before virtual columns existed lack them, and the liveness of
+            // their rows depends on any of the base row's columns.
+            all = true;
+        }
+    }
+    for (const auto& [cdef, restriction] : select_statement().get_restrictions()->get_non_pk_restriction()) {
+        if (auto* base_cdef = base.get_column_definition(cdef->name()); base_cdef && base_cdef->is_regular()) {
+            affecting[base_cdef->id] = true;
+        }
+    }
+    if (all) {
+        std::fill(affecting.begin(), affecting.end(), true);
+    }
+    _affecting_columns = std::move(affecting);
+    _affecting_columns_version = base.version();
+    return _affecting_columns;
+}
+
 void view_info::set_base_info(db::view::base_info_ptr base_info) {
     _base_info = std::move(base_info);
 }
@@ -289,6 +321,28 @@ bool may_be_affected_by(const schema& base, const view_info& view, const dht::de
     return clustering_prefix_matches(base, view, key.key(), update.key());
 }
 
+bool columns_may_affect_view(const schema& base, const view_info& view, const mutation& update) {
+    const auto& p = update.partition();
+    if (p.partition_tombstone() || !p.row_tombstones().empty() || !p.static_row().empty()) {
+        return true;
+    }
+    const auto& affecting = view.regular_columns_affecting_view(base);
+    for (const rows_entry& e : p.clustered_rows()) {
+        const deletable_row& row = e.row();
+        if (!row.marker().is_missing() || row.deleted_at()) {
+            return true;
+        }
+        bool affects = false;
+        row.cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection&) {
+            affects |= affecting[id];
+        });
+        if (affects) {
+            return true;
+        }
+    }
+    return false;
+}
+
 static bool update_requires_read_before_write(const schema& base,
         const std::vector<view_and_base>& views,
         const dht::decorated_key& key,
@@ -968,7 +1022,23 @@ future<utils::chunked_vector<frozen_mutation_and_schema>> view_update_builder::b
         co_await advance_existings();
     }
 
-    while (co_await on_results() == stop_iteration::no) {};
+    // Rows are generated without yielding until a reader has to fill its
+    // buffer or the task quota runs out, so the timer covers such a
+    // stretch of rows rather than a single row.
+    std::optional<utils::code_region_timer> region_timer;
+    while (true) {
+        if (!region_timer) {
+            region_timer.emplace(utils::code_region::view_update);
+        }
+        auto f = on_results();
+        if (!f.available() || need_preempt()) {
+            region_timer.reset();
+        }
+        if (co_await std::move(f) == stop_iteration::yes) {
+            break;
+        }
+    }
+    region_timer.reset();
 
     utils::chunked_vector<frozen_mutation_and_schema> mutations;
     for (auto& update : _view_updates) {
@@ -1248,6 +1318,40 @@ static future<> apply_to_remote_endpoints(gms::inet_address target, inet_address
             allow_hints);
 }
 
+static future<> send_queued_view_update(view_update_queue::update& u) {
+    size_t updates_pushed_remote = (u.pending_endpoints.size() + 1) * u.merged;
+    auto s = u.mut.s;
+    return apply_to_remote_endpoints(u.target, std::move(u.pending_endpoints), std::move(u.mut), u.base_token, u.view_token, u.allow_hints, u.tr_state).then_wrapped(
+            [&u, s = std::move(s), updates_pushed_remote] (future<>&& f) {
+        if (f.failed()) {
+            u.stats->view_updates_failed_remote += updates_pushed_remote;
+            u.cf_stats->total_view_updates_failed_remote += updates_pushed_remote;
+            auto ep = f.get_exception();
+            tracing::trace(u.tr_state, "Failed to apply view update for {} and {} remote endpoints",
+                    u.target, updates_pushed_remote);
+            vlogger.error("Error applying view update to {} (view: {}.{}, base token: {}, view token: {}): {}",
+                    u.target, s->ks_name(), s->cf_name(), u.base_token, u.view_token, ep);
+            return;
+        }
+        tracing::trace(u.tr_state, "Successfully applied view update for {} and {} remote endpoints",
+                u.target, updates_pushed_remote);
+    });
+}
+
+// Asynchronous updates to remote view replicas, when coalesce_view_updates is set.
+static view_update_queue& remote_view_update_queue() {
+    static thread_local view_update_queue queue(send_queued_view_update);
+    return queue;
+}
+
+size_t queued_remote_view_updates() {
+    return remote_view_update_queue().queued();
+}
+
+future<> stop_remote_view_update_queue() {
+    return remote_view_update_queue().stop();
+}
+
 static bool should_update_synchronously(const schema& s) {
     auto tag_opt = db::find_tag(s, db::SYNCHRONOUS_VIEW_UPDATES_TAG_KEY);
     if (!tag_opt.has_value()) {
@@ -1361,6 +1465,26 @@ future<> mutate_MV(
             stats.view_updates_pushed_remote += updates_pushed_remote;
             cf_stats.total_view_updates_pushed_remote += updates_pushed_remote;
             schema_ptr s = mut.s;
+            if (!apply_update_synchronously && service::get_local_storage_proxy().get_db().local().get_config().coalesce_view_updates()) {
+                auto merged = remote_view_update_queue().push(view_update_queue::update{
+                        .mut = std::move(mut),
+                        .target = *target_endpoint,
+                        .pending_endpoints = std::move(remote_endpoints),
+                        .base_token = base_token,
+                        .view_token = view_token,
+                        .allow_hints = allow_hints,
+                        .tr_state = tr_state,
+                        .units = sem_units.split(sem_units.count()),
+                        .stats = &stats,
+                        .cf_stats = &cf_stats,
+                });
+                if (merged) {
+                    ++cf_stats.coalesced_view_updates;
+                    tracing::trace(tr_state, "View update for {}.{} merged into a queued update; base token = {}; view token = {}",
+                            s->ks_name(), s->cf_name(), base_token, view_token);
+                }
+                return when_all_succeed(std::move(local_view_update), std::move(remote_view_update)).discard_result();
+            }
             future<> view_update = apply_to_remote_endpoints(*target_endpoint, std::move(remote_endpoints), std::move(mut), base_token, view_token, allow_hints, tr_state).then_wrapped(
                     [s = std::move(s), &stats, &cf_stats, tr_state, base_token, view_token, target_endpoint, updates_pushed_remote,
                             units = sem_units.split(sem_units.count()), apply_update_synchronously] (future<>&& f) mutable {
@@ -1925,17 +2049,51 @@ class view_builder::consumer {
     // used to build it, and we cannot allow its serialized size to grow
     // beyond our limit on mutation size (by default 32 MB).
     size_t _fragments_memory_usage = 0;
+    // View updates of flushed batches which are still being generated and sent.
+    // At most _max_populating batches are in flight; all of them complete before
+    // the step ends, so that the progress recorded by the step covers them.
+    std::deque<future<>> _populating;
+    size_t _max_populating;
 public:
-    consumer(view_builder& builder, build_step& step, gc_clock::time_point now)
+    consumer(view_builder& builder, build_step& step, gc_clock::time_point now, size_t max_populating)
             : _builder(builder)
             , _step(step)
             , _built_views{step}
-            , _now(now) {
+            , _now(now)
+            , _max_populating(std::max(max_populating, size_t(1))) {
         if (!step.current_key.key().is_empty(*_step.reader.schema())) {
             load_views_to_build();
         }
     }
 
+    consumer(consumer&&) = default;
+
+    ~consumer() {
+        // Only non-empty if the step failed.
+        while (!_populating.empty()) {
+            _populating.front().handle_exception([] (std::exception_ptr) { }).get();
+            _populating.pop_front();
+        }
+    }
+
+    // Waits until at most max batches are in flight, and rethrows the first failure.
+    void wait_for_populating(size_t max) {
+        std::exception_ptr ex;
+        while (_populating.size() > max) {
+            try {
+                _populating.front().get();
+            } catch (...) {
+                if (!ex) {
+                    ex = std::current_exception();
+                }
+            }
+            _populating.pop_front();
+        }
+        if (ex) {
+            std::rethrow_exception(std::move(ex));
+        }
+    }
+
     void load_views_to_build() {
         inject_failure("view_builder_load_views");
         for (auto&& vs : _step.build_status) {
@@ -1999,7 +2157,7 @@ class view_builder::consumer {
 
         _fragments_memory_usage += cr.memory_usage(*_step.reader.schema());
         _fragments.emplace_back(*_step.reader.schema(), _builder._permit, std::move(cr));
-        if (_fragments_memory_usage > batch_memory_max) {
+        if (_fragments_memory_usage > batch_memory_max || _fragments.size() >= batch_size) {
             // Although we have not yet completed the batch of base rows that
             // compact_for_query<> planned for us (view_builder::batchsize),
             // we've still collected enough rows to reach sizeable memory use,
@@ -2024,11 +2182,12 @@ class view_builder::consumer {
             auto reader = make_flat_mutation_reader_from_fragments(_step.reader.schema(), _builder._permit, std::move(_fragments));
             auto close_reader = defer([&reader] { reader.close().get(); });
             reader.upgrade_schema(base_schema);
-            _step.base->populate_views(
+            wait_for_populating(_max_populating - 1);
+            _populating.push_back(_step.base->populate_views(
                     std::move(views),
                     _step.current_token(),
                     std::move(reader),
-                    _now).get();
+                    _now));
             close_reader.cancel();
             _fragments.clear();
             _fragments_memory_usage = 0;
@@ -2044,6 +2203,7 @@ class view_builder::consumer {
     // Must be called in a seastar thread.
     built_views consume_end_of_stream() {
         inject_failure("view_builder_consume_end_of_stream");
+        wait_for_populating(0);
         if (vlogger.is_enabled(log_level::debug)) {
             auto view_names = boost::copy_range<std::vector<sstring>>(
                     _views_to_build | boost::adaptors::transformed([](auto v) {
@@ -2067,13 +2227,16 @@ class view_builder::consumer {
 // Called in the context of a seastar::thread.
 void view_builder::execute(build_step& step, exponential_backoff_retry r) {
     gc_clock::time_point now = gc_clock::now();
+    // Each batch of rows has its view updates generated and sent while the
+    // following batches are read, so a step reads a batch for each of them.
+    size_t concurrency = std::max(_db.get_config().view_building_concurrency(), 1u);
     auto compaction_state = make_lw_shared<compact_for_query_state_v2>(
             *step.reader.schema(),
             now,
             step.pslice,
-            batch_size,
+            batch_size * concurrency,
             query::max_partitions);
-    auto consumer = compact_for_query_v2<view_builder::consumer>(compaction_state, view_builder::consumer{*this, step, now});
+    auto consumer = compact_for_query_v2<view_builder::consumer>(compaction_state, view_builder::consumer{*this, step, now, concurrency});
     auto built = step.reader.consume_in_thread(std::move(consumer));
     if (auto ds = std::move(*compaction_state).detach_state()) {
         if (ds->current_tombstone) {
@@ -2197,14 +2360,20 @@ void view_updating_consumer::do_flush_buffer() {
         _buffer.pop_front();
     }
 
-    while (!_buffer.empty()) {
-        try {
-            auto lock_holder = _view_update_pusher(std::move(_buffer.front())).get();
-        } catch (...) {
-            vlogger.warn("Failed to push replica updates for table {}.{}: {}", _schema->ks_name(), _schema->cf_name(), std::current_exception());
-        }
-        _buffer.pop_front();
-    }
+    // The buffered mutations are sorted and don't overlap, so their base reads
+    // and view updates are independent of each other. Pushing several at a
+    // time overlaps the base reads, which otherwise bound the throughput.
+    max_concurrent_for_each(_buffer, _concurrency, [this] (mutation& m) {
+        return _view_update_pusher(std::move(m)).then_wrapped([this] (future<row_locker::lock_holder> f) {
+            if (f.failed()) {
+                vlogger.warn("Failed to push replica updates for table {}.{}: {}", _schema->ks_name(), _schema->cf_name(), f.get_exception());
+            } else {
+                // Release the lock right away.
+                f.get();
+            }
+        });
+    }).get();
+    _buffer.clear();
 
     _buffer_size = 0;
 }
@@ -2227,12 +2396,12 @@ void view_updating_consumer::maybe_flush_buffer_mid_partition() {
 }
 
 view_updating_consumer::view_updating_consumer(schema_ptr schema, reader_permit permit, replica::table& table, std::vector<sstables::shared_sstable> excluded_sstables, const seastar::abort_source& as,
-        evictable_reader_handle_v2& staging_reader_handle)
+        evictable_reader_handle_v2& staging_reader_handle, size_t concurrency)
     : view_updating_consumer(std::move(schema), std::move(permit), as, staging_reader_handle,
             [table = table.shared_from_this(), excluded_sstables = std::move(excluded_sstables)] (mutation m) mutable {
         auto s = m.schema();
         return table->stream_view_replica_updates(std::move(s), std::move(m), db::no_timeout, excluded_sstables);
-    })
+    }, concurrency)
 { }
 
 std::vector<db::view::view_and_base> with_base_info_snapshot(std::vector<view_ptr> vs) {
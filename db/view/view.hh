@@ -102,6 +102,21 @@ bool partition_key_matches(const schema& base, const view_info& view, const dht:
  */
 bool may_be_affected_by(const schema& base, const view_info& view, const dht::decorated_key& key, const rows_entry& update);
 
+/**
+ * Whether the view might be affected by the columns the update writes.
+ *
+ * An update which only writes cells of regular columns that are neither in the
+ * view nor restricted by its filter, and deletes nothing, can't change the view,
+ * so there is no need to read the existing rows to generate its view updates.
+ *
+ * @param base the base table schema, which the update must be upgraded to.
+ * @param view_info the view info.
+ * @param update the base table update being applied.
+ * @return false if we can guarantee that the update won't affect the view
+ * in any way, true otherwise.
+ */
+bool columns_may_affect_view(const schema& base, const view_info& view, const mutation& update);
+
 /**
  * Whether a given base row matches the view filter (and thus if the view should have a corresponding entry).
  *
@@ -225,6 +240,12 @@ future<> mutate_MV(
         service::allow_hints allow_hints,
         wait_for_all_updates wait_for_all);
 
+// Number of asynchronous view updates of this shard waiting to be sent, see view_update_queue.
+size_t queued_remote_view_updates();
+
+// Waits for the queued asynchronous view updates of this shard to be sent.
+future<> stop_remote_view_update_queue();
+
 /**
  * create_virtual_column() adds a "virtual column" to a schema builder.
  * The definition of a "virtual column" is based on the given definition
@@ -61,7 +61,9 @@ namespace db::view {
  *
  * We aim to be resource-conscious. On a given shard, at any given moment, we consume at most
  * from one reader. We also strive for fairness, in that each build step inserts entries for
- * the views of a different base. Each build step reads and generates updates for batch_size rows.
+ * the views of a different base. Each build step reads view_building_concurrency batches of up to
+ * batch_size rows; the updates of a batch are generated and sent while the following ones are read,
+ * and all of them are sent before the step records its progress.
  *
  * We lack a controller, which could potentially allow us to go faster (to execute multiple steps at
  * the same time, or consume more rows per batch), and also which would apply backpressure, so we
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/gate.hh>
+
+#include "db/view/view_update_queue.hh"
+#include "mutation.hh"
+
+namespace db::view {
+
+view_update_queue::view_update_queue(sender_type sender, unsigned max_sends)
+    : _sender(std::move(sender))
+    , _max_sends(std::max(max_sends, 1u))
+{}
+
+bool view_update_queue::try_merge(queue& q, update& u) {
+    auto [begin, end] = q.by_token.equal_range(u.view_token);
+    for (auto it = begin; it != end; ++it) {
+        auto& queued = *it->second;
+        if (queued.mut.s != u.mut.s
+                || queued.allow_hints != u.allow_hints
+                || queued.pending_endpoints != u.pending_endpoints
+                || !queued.mut.fm.key().equal(*u.mut.s, u.mut.fm.key())) {
+            continue;
+        }
+        auto m = queued.mut.fm.unfreeze(queued.mut.s);
+        m.apply(u.mut.fm.unfreeze(u.mut.s));
+        queued.mut.fm = freeze(m);
+        queued.units.adopt(std::move(u.units));
+        queued.merged += u.merged;
+        return true;
+    }
+    return false;
+}
+
+bool view_update_queue::push(update u) {
+    _gate.check();
+    auto key = queue_key(u.mut.s->id(), u.target);
+    auto& q = _queues[key];
+    try {
+        if (try_merge(q, u)) {
+            ++_coalesced;
+            return true;
+        }
+    } catch (...) {
+        // Merging is an optimization, queue the update on its own.
+    }
+    auto token = u.view_token;
+    auto ptr = make_lw_shared<update>(std::move(u));
+    q.updates.push_back(ptr);
+    q.by_token.emplace(token, std::move(ptr));
+    ++_queued;
+    if (q.sending < _max_sends) {
+        ++q.sending;
+        // Bounded by the units of the view update concurrency semaphore held by the updates.
+        (void)with_gate(_gate, [this, key = std::move(key)] () mutable {
+            return send_queued(std::move(key));
+        });
+    }
+    return false;
+}
+
+future<> view_update_queue::stop() {
+    co_await _gate.close();
+    // The queue is per shard, not per database, so it may be used again.
+    _gate = seastar::gate();
+}
+
+future<> view_update_queue::send_queued(queue_key key) {
+    // Queues are erased only once nothing sends from them, so the reference stays valid.
+    auto& q = _queues[key];
+    while (!q.updates.empty()) {
+        auto u = std::move(q.updates.front());
+        q.updates.pop_front();
+        auto [begin, end] = q.by_token.equal_range(u->view_token);
+        q.by_token.erase(std::find_if(begin, end, [&] (const auto& e) { return e.second == u; }));
+        --_queued;
+        try {
+            co_await _sender(*u);
+        } catch (...) {
+            // The sender is expected to handle its errors, keep sending the rest.
+        }
+    }
+    if (--q.sending == 0) {
+        _queues.erase(key);
+    }
+}
+
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <deque>
+#include <map>
+#include <unordered_map>
+
+#include <seastar/core/future.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/shared_ptr.hh>
+#include <seastar/util/bool_class.hh>
+#include <seastar/util/noncopyable_function.hh>
+
+#include "db/timeout_clock.hh"
+#include "dht/token.hh"
+#include "frozen_mutation.hh"
+#include "gms/inet_address.hh"
+#include "inet_address_vectors.hh"
+#include "tracing/trace_state.hh"
+#include "utils/UUID.hh"
+#include "seastarx.hh"
+
+namespace replica {
+struct cf_stats;
+}
+
+namespace service {
+struct allow_hints_tag;
+using allow_hints = bool_class<allow_hints_tag>;
+}
+
+namespace db::view {
+
+class stats;
+
+/// \class view_update_queue
+/// \brief Asynchronous view updates waiting to be sent to remote view replicas.
+///
+/// Updates are queued per view and target replica, and each queue sends at most
+/// max_sends updates at a time. An update of a view partition which already has
+/// an update waiting in the queue is merged into it, so a hot base row whose view
+/// updates are produced faster than they are sent results in fewer view writes.
+///
+/// Queued updates keep their units of the view update concurrency semaphore,
+/// which bounds the memory they use.
+class view_update_queue {
+public:
+    struct update {
+        frozen_mutation_and_schema mut;
+        gms::inet_address target;
+        inet_address_vector_topology_change pending_endpoints;
+        dht::token base_token;
+        dht::token view_token;
+        service::allow_hints allow_hints;
+        tracing::trace_state_ptr tr_state;
+        db::timeout_semaphore_units units;
+        db::view::stats* stats = nullptr;
+        replica::cf_stats* cf_stats = nullptr;
+        // Number of updates merged into this one, including itself.
+        size_t merged = 1;
+    };
+    // Sends an update. Must not fail; errors are the sender's to handle.
+    using sender_type = noncopyable_function<future<> (update&)>;
+
+    static constexpr unsigned default_max_sends = 16;
+
+private:
+    struct queue {
+        std::deque<lw_shared_ptr<update>> updates;
+        // The queued updates by their view token, to find the ones to merge into.
+        std::unordered_multimap<dht::token, lw_shared_ptr<update>> by_token;
+        unsigned sending = 0;
+    };
+    using queue_key = std::pair<utils::UUID, gms::inet_address>;
+
+    sender_type _sender;
+    unsigned _max_sends;
+    std::map<queue_key, queue> _queues;
+    size_t _queued = 0;
+    uint64_t _coalesced = 0;
+    // Held by the sending fibers.
+    seastar::gate _gate;
+
+public:
+    explicit view_update_queue(sender_type sender, unsigned max_sends = default_max_sends);
+
+    // Queues the update, or merges it into a queued update of the same view partition.
+    // Returns true if the update was merged.
+    // Throws gate_closed_exception while the queue is being stopped.
+    bool push(update u);
+
+    // Waits for the queued updates to be sent, rejecting new ones meanwhile.
+    future<> stop();
+
+    // Number of updates waiting to be sent.
+    size_t queued() const {
+        return _queued;
+    }
+
+    // Number of updates merged into a queued update.
+    uint64_t coalesced() const {
+        return _coalesced;
+    }
+
+private:
+    bool try_merge(queue& q, update& u);
+    future<> send_queued(queue_key key);
+};
+
+}
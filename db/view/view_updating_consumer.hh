@@ -35,6 +35,9 @@ class view_updating_consumer {
     // data. We flush mid-partition if we reach the hard limit.
     static const size_t buffer_size_soft_limit;
     static const size_t buffer_size_hard_limit;
+    // The number of buffered mutations whose view updates are generated
+    // at the same time, each reading the base rows it affects.
+    static constexpr size_t default_concurrency = 1;
 
 private:
     schema_ptr _schema;
@@ -45,6 +48,7 @@ class view_updating_consumer {
     std::optional<mutation_rebuilder_v2> _mut_builder;
     size_t _buffer_size{0};
     noncopyable_function<future<row_locker::lock_holder>(mutation)> _view_update_pusher;
+    size_t _concurrency;
 
 private:
     void do_flush_buffer();
@@ -54,16 +58,17 @@ class view_updating_consumer {
 public:
     // Push updates with a custom pusher. Mainly for tests.
     view_updating_consumer(schema_ptr schema, reader_permit permit, const seastar::abort_source& as, evictable_reader_handle_v2& staging_reader_handle,
-            noncopyable_function<future<row_locker::lock_holder>(mutation)> view_update_pusher)
+            noncopyable_function<future<row_locker::lock_holder>(mutation)> view_update_pusher, size_t concurrency = default_concurrency)
             : _schema(std::move(schema))
             , _permit(std::move(permit))
             , _as(&as)
             , _staging_reader_handle(staging_reader_handle)
             , _view_update_pusher(std::move(view_update_pusher))
+            , _concurrency(std::max<size_t>(concurrency, 1))
     { }
 
     view_updating_consumer(schema_ptr schema, reader_permit permit, replica::table& table, std::vector<sstables::shared_sstable> excluded_sstables, const seastar::abort_source& as,
-            evictable_reader_handle_v2& staging_reader_handle);
+            evictable_reader_handle_v2& staging_reader_handle, size_t concurrency = default_concurrency);
 
     view_updating_consumer(view_updating_consumer&&) = default;
 
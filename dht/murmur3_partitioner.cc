@@ -8,6 +8,8 @@
 
 #include "murmur3_partitioner.hh"
 #include "utils/murmur_hash.hh"
+#include "utils/fragment_range.hh"
+#include "schema.hh"
 #include "sstables/key.hh"
 #include "utils/class_registrator.hh"
 #include <boost/lexical_cast.hpp>
@@ -44,12 +46,31 @@ murmur3_partitioner::get_token(const sstables::key_view& key) const {
     });
 }
 
+// Hashes the legacy form of the key, see legacy_compound_view, piece by piece.
+// The value of each component is hashed in place, the way the bytes_view
+// version does, rather than through the legacy form's iterator, which yields
+// the key byte by byte.
 token
 murmur3_partitioner::get_token(const schema& s, partition_key_view key) const {
-    std::array<uint64_t, 2> hash;
-    auto&& legacy = key.legacy_form(s);
-    utils::murmur_hash::hash3_x64_128(legacy.begin(), legacy.size(), 0, hash);
-    return get_token(hash[0]);
+    utils::murmur_hash::hash3_x64_128_state hash(0);
+    auto hash_value = [&] (managed_bytes_view v) {
+        for (bytes_view frag : fragment_range(v)) {
+            hash.update(frag);
+        }
+    };
+    auto& type = *s.partition_key_type();
+    if (type.is_singular()) {
+        hash_value(*type.begin(key.representation()));
+    } else {
+        for (managed_bytes_view c : type.components(key.representation())) {
+            const int8_t length[] = { int8_t(c.size() >> 8), int8_t(c.size()) };
+            const int8_t eoc = 0;
+            hash.update(bytes_view(length, sizeof(length)));
+            hash_value(c);
+            hash.update(bytes_view(&eoc, 1));
+        }
+    }
+    return get_token(hash.finalize()[0]);
 }
 
 using registry = class_registrator<i_partitioner, murmur3_partitioner>;
@@ -34,10 +34,13 @@ range_streamer::get_range_fetch_map(const std::unordered_map<dht::token_range, s
                                     const std::unordered_set<std::unique_ptr<i_source_filter>>& source_filters,
                                     const sstring& keyspace) {
     std::unordered_map<inet_address, dht::token_range_vector> range_fetch_map_map;
+    auto& eligible_sources = _eligible_sources[keyspace];
+    auto& snitch = locator::i_endpoint_snitch::get_local_snitch_ptr();
     for (auto x : ranges_with_sources) {
         const dht::token_range& range_ = x.first;
         const std::vector<inet_address>& addresses = x.second;
         bool found_source = false;
+        std::vector<inet_address> eligible;
         for (auto address : addresses) {
             if (address == utils::fb_utilities::get_broadcast_address()) {
                 // If localhost is a source, we have found one, but we don't add it to the map to avoid streaming locally
@@ -58,9 +61,30 @@ range_streamer::get_range_fetch_map(const std::unordered_map<dht::token_range, s
                 continue;
             }
 
-            range_fetch_map_map[address].push_back(range_);
+            eligible.push_back(address);
+        }
+
+        if (!eligible.empty()) {
+            // Stream from one other node for each range. Of the sources as close
+            // as the closest one, pick the one with the fewest ranges so far, so
+            // that the ranges are spread over all of them.
+            auto nr_ranges = [&] (inet_address address) {
+                auto it = range_fetch_map_map.find(address);
+                return it == range_fetch_map_map.end() ? 0 : it->second.size();
+            };
+            auto closest = eligible.front();
+            auto source = closest;
+            for (auto address : eligible) {
+                if (snitch->compare_endpoints(_address, closest, address) != 0) {
+                    break;
+                }
+                if (nr_ranges(address) < nr_ranges(source)) {
+                    source = address;
+                }
+            }
+            range_fetch_map_map[source].push_back(range_);
             found_source = true;
-            break; // ensure we only stream from one other node for each range
+            eligible_sources[range_] = std::move(eligible);
         }
 
         if (!found_source) {
@@ -260,11 +284,11 @@ future<> range_streamer::stream_async() {
         auto ips = boost::copy_range<std::list<inet_address>>(ip_range_vec | boost::adaptors::map_keys);
         // Fetch from or send to peer node in parallel
         logger.info("{} with {} for keyspace={} started, nodes_to_stream={}", description, ips, keyspace, ip_range_vec.size());
-        return parallel_for_each(ip_range_vec, [this, description, keyspace] (auto& ip_range) {
+        return parallel_for_each(ip_range_vec, [this, description, keyspace, &ip_range_vec] (auto& ip_range) {
           auto& source = ip_range.first;
           auto& range_vec = ip_range.second;
-          return seastar::with_semaphore(_limiter, 1, [this, description, keyspace, source, &range_vec] () mutable {
-            return seastar::async([this, description, keyspace, source, &range_vec] () mutable {
+          return seastar::with_semaphore(_limiter, 1, [this, description, keyspace, source, &range_vec, &ip_range_vec] () mutable {
+            return seastar::async([this, description, keyspace, source, &range_vec, &ip_range_vec] () mutable {
                 // TODO: It is better to use fiber instead of thread here because
                 // creating a thread per peer can be some memory in a large cluster.
                 auto start_time = lowres_clock::now();
@@ -290,18 +314,22 @@ future<> range_streamer::stream_async() {
                     ranges_to_stream.clear();
                 };
                 try {
-                    for (auto it = range_vec.begin(); it < range_vec.end();) {
-                        ranges_to_stream.push_back(*it);
-                        it = range_vec.erase(it);
-                        if (ranges_to_stream.size() < nr_ranges_per_stream_plan) {
-                            continue;
-                        } else {
+                    for (;;) {
+                        if (range_vec.empty()) {
+                            if (ranges_to_stream.size() > 0) {
+                                do_streaming();
+                            }
+                            if (!steal_ranges(keyspace, source, ip_range_vec)) {
+                                break;
+                            }
+                            nr_ranges_total += range_vec.size();
+                        }
+                        ranges_to_stream.push_back(range_vec.front());
+                        range_vec.erase(range_vec.begin());
+                        if (ranges_to_stream.size() >= nr_ranges_per_stream_plan) {
                             do_streaming();
                         }
                     }
-                    if (ranges_to_stream.size() > 0) {
-                        do_streaming();
-                    }
                 } catch (...) {
                     for (auto& range : ranges_to_stream) {
                         range_vec.push_back(range);
@@ -326,6 +354,36 @@ future<> range_streamer::stream_async() {
     });
 }
 
+bool range_streamer::steal_ranges(const sstring& keyspace, inet_address source, std::unordered_map<inet_address, dht::token_range_vector>& ip_range_vec) {
+    auto ks_sources = _eligible_sources.find(keyspace);
+    if (ks_sources == _eligible_sources.end()) {
+        return false;
+    }
+    auto& range_vec = ip_range_vec[source];
+    for (auto& [other, other_range_vec] : ip_range_vec) {
+        if (other == source) {
+            continue;
+        }
+        // Take ranges from the back, the other source's streaming takes them
+        // from the front. Leave it at least half of its remaining ranges.
+        auto to_steal = other_range_vec.size() / 2;
+        for (auto it = other_range_vec.end(); to_steal && it != other_range_vec.begin();) {
+            --it;
+            auto sources = ks_sources->second.find(*it);
+            if (sources != ks_sources->second.end() && std::ranges::find(sources->second, source) != sources->second.end()) {
+                range_vec.push_back(*it);
+                it = other_range_vec.erase(it);
+                --to_steal;
+            }
+        }
+    }
+    if (range_vec.empty()) {
+        return false;
+    }
+    logger.info("{} with {} for keyspace={}, took over {} ranges from slower sources", _description, source, keyspace, range_vec.size());
+    return true;
+}
+
 size_t range_streamer::nr_ranges_to_stream() {
     size_t nr_ranges_remaining = 0;
     for (auto& fetch : _to_stream) {
@@ -139,6 +139,10 @@ class range_streamer {
     const token_metadata& get_token_metadata() {
         return *_token_metadata_ptr;
     }
+    // Moves ranges which source can stream from the other sources, up to half
+    // of the ranges each has left, to source, which has none left.
+    // Returns false if there were no such ranges.
+    bool steal_ranges(const sstring& keyspace, inet_address source, std::unordered_map<inet_address, dht::token_range_vector>& ip_range_vec);
 public:
     future<> stream_async();
     size_t nr_ranges_to_stream();
@@ -153,6 +157,8 @@ class range_streamer {
     streaming::stream_reason _reason;
     std::unordered_multimap<sstring, std::unordered_map<inet_address, dht::token_range_vector>> _to_stream;
     std::unordered_set<std::unique_ptr<i_source_filter>> _source_filters;
+    // For each keyspace and range to fetch, the sources which may be streamed from.
+    std::unordered_map<sstring, std::unordered_map<dht::token_range, std::vector<inet_address>>> _eligible_sources;
     // Number of tx and rx ranges added
     unsigned _nr_tx_added = 0;
     unsigned _nr_rx_added = 0;
@@ -112,6 +112,9 @@ class feature_service final {
     gms::feature schema_commitlog { *this, "SCHEMA_COMMITLOG"sv };
     gms::feature uda_native_parallelized_aggregation { *this, "UDA_NATIVE_PARALLELIZED_AGGREGATION"sv };
     gms::feature aggregate_storage_options { *this, "AGGREGATE_STORAGE_OPTIONS"sv };
+    gms::feature parallelized_group_by { *this, "PARALLELIZED_GROUP_BY"sv };
+    gms::feature read_data_batch { *this, "READ_DATA_BATCH"sv };
+    gms::feature mutation_batch { *this, "MUTATION_BATCH"sv };
 
 public:
 
@@ -107,6 +107,7 @@ gossiper::gossiper(abort_source& as, feature_service& features, const locator::s
     }
 
     _scheduled_gossip_task.set_callback(_gcfg.gossip_scheduling_group, [this] { run(); });
+    _push_local_state_timer.set_callback(_gcfg.gossip_scheduling_group, [this] { push_local_state(); });
     // half of QUARATINE_DELAY, to ensure _just_removed_endpoints has enough leeway to prevent re-gossip
     fat_client_timeout = quarantine_delay() / 2;
     register_(make_shared<feature_enabler>(*this));
@@ -196,8 +197,22 @@ future<> gossiper::handle_syn_msg(msg_addr from, gossip_digest_syn syn_msg) {
     syn_msg_pending& p = _syn_handlers[from.addr];
     if (p.pending) {
         // The latest syn message from peer has the latest infomation, so
-        // it is safe to drop the previous syn message and keep the latest
-        // one only.
+        // it replaces the digests of the previous syn message. But a syn
+        // pushing the peer's own state carries only its digest, so the
+        // digests of the other endpoints in the previous one are kept.
+        if (p.syn_msg) {
+            auto digests = syn_msg.get_gossip_digests();
+            std::unordered_set<inet_address> endpoints;
+            for (auto& d : digests) {
+                endpoints.insert(d.get_endpoint());
+            }
+            for (auto& d : p.syn_msg->get_gossip_digests()) {
+                if (!endpoints.contains(d.get_endpoint())) {
+                    digests.push_back(d);
+                }
+            }
+            syn_msg = gossip_digest_syn(syn_msg.cluster_id(), syn_msg.partioner(), std::move(digests));
+        }
         logger.debug("Queue gossip syn msg from node {}, syn_msg={}", from, syn_msg);
         p.syn_msg = std::move(syn_msg);
         return make_ready_future<>();
@@ -1288,6 +1303,47 @@ future<> gossiper::do_gossip_to_live_member(gossip_digest_syn message, gms::inet
     return send_gossip(message, {ep});
 }
 
+void gossiper::push_local_state() {
+    if (!is_enabled() || _background_msg.is_closed()) {
+        return;
+    }
+    // Changes which closely follow a push are pushed together, a gossip
+    // interval after it.
+    auto next_push = _last_local_state_push + INTERVAL;
+    if (lowres_clock::now() < next_push) {
+        if (!_push_local_state_timer.armed()) {
+            _push_local_state_timer.arm(next_push);
+        }
+        return;
+    }
+    _last_local_state_push = lowres_clock::now();
+    auto es = get_endpoint_state_for_endpoint_ptr(get_broadcast_address());
+    if (!es) {
+        return;
+    }
+    utils::chunked_vector<gossip_digest> digests;
+    digests.push_back(gossip_digest(get_broadcast_address(), es->get_heart_beat_state().get_generation(), get_max_endpoint_state_version(*es)));
+    gossip_digest_syn message(get_cluster_name(), get_partitioner_name(), std::move(digests));
+    // When all nodes change their state at once (e.g. their schema version),
+    // pushing to all live members would take a number of messages quadratic
+    // in the size of the cluster. Those not pushed to learn about the change
+    // from the gossip rounds, in which the members pushed to now take part.
+    auto endpoints = _live_endpoints;
+    if (endpoints.size() > MAX_LOCAL_STATE_PUSH_FANOUT) {
+        std::shuffle(endpoints.begin(), endpoints.end(), _random_engine);
+        endpoints.resize(MAX_LOCAL_STATE_PUSH_FANOUT);
+    }
+    logger.debug("Push local state to live nodes: {}", endpoints);
+    for (auto& ep : endpoints) {
+        // Do it in the background, shutdown() waits for it.
+        (void)with_gate(_background_msg, [this, message, ep] () mutable {
+            return do_gossip_to_live_member(std::move(message), ep).handle_exception([] (auto ep) {
+                logger.trace("Failed to push local state: {}", ep);
+            });
+        });
+    }
+}
+
 future<> gossiper::do_gossip_to_unreachable_member(gossip_digest_syn message) {
     double live_endpoint_count = _live_endpoints.size();
     double unreachable_endpoint_count = _unreachable_endpoints.size();
@@ -2094,6 +2150,16 @@ future<> gossiper::add_local_application_state(std::list<std::pair<application_s
                 gossiper.replicate(ep_addr, state, value).get();
                 gossiper.do_on_change_notifications(ep_addr, state, value).get();
             }
+            // The states which change all the time are left to the gossip rounds,
+            // other changes (e.g. of the node's status, tokens or schema version)
+            // are pushed to all the nodes at once.
+            bool push = std::any_of(states.begin(), states.end(), [] (const auto& p) {
+                return p.first != application_state::LOAD && p.first != application_state::VIEW_BACKLOG
+                        && p.first != application_state::CACHE_HITRATES;
+            });
+            if (push) {
+                gossiper.push_local_state();
+            }
         }).handle_exception([] (auto ep) {
             logger.warn("Fail to apply application_state: {}", ep);
         });
@@ -2138,6 +2204,7 @@ future<> gossiper::do_stop_gossiping() {
             g._enabled = false;
         }).get();
         _scheduled_gossip_task.cancel();
+        _push_local_state_timer.cancel();
         // Take the semaphore makes sure existing gossip loop is finished
         get_units(_callback_running, 1).get0();
         container().invoke_on_all([] (auto& g) {
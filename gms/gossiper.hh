@@ -117,6 +117,8 @@ class gossiper : public seastar::async_sharded_service<gossiper>, public seastar
     msg_addr get_msg_addr(inet_address to) const noexcept;
     void do_sort(utils::chunked_vector<gossip_digest>& g_digest_list);
     timer<lowres_clock> _scheduled_gossip_task;
+    timer<lowres_clock> _push_local_state_timer;
+    lowres_clock::time_point _last_local_state_push;
     bool _enabled = false;
     semaphore _callback_running{1};
     semaphore _apply_state_locally_semaphore{100};
@@ -180,6 +182,8 @@ class gossiper : public seastar::async_sharded_service<gossiper>, public seastar
         versioned_value::STATUS_UNKNOWN,
     };
     static constexpr std::chrono::milliseconds INTERVAL{1000};
+    // The number of live members a change of the local state is pushed to, at most.
+    static constexpr size_t MAX_LOCAL_STATE_PUSH_FANOUT = 32;
     static constexpr std::chrono::hours A_VERY_LONG_TIME{24 * 3};
 
     static constexpr std::chrono::milliseconds GOSSIP_SETTLE_MIN_WAIT_MS{5000};
@@ -380,6 +384,14 @@ class gossiper : public seastar::async_sharded_service<gossiper>, public seastar
     /* Sends a Gossip message to an unreachable member */
     future<> do_gossip_to_unreachable_member(gossip_digest_syn message);
 
+    /*
+     * Sends the digest of the local endpoint state alone to live members,
+     * so that they ask for its changes right away instead of learning about
+     * them from the epidemic gossip rounds. Pushes at most once per gossip
+     * interval, to at most MAX_LOCAL_STATE_PUSH_FANOUT members.
+     */
+    void push_local_state();
+
     future<> do_status_check();
 
 public:
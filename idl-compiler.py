@@ -22,7 +22,7 @@ READ_BUFF = 'input_buffer'
 WRITE_BUFF = 'output_buffer'
 SERIALIZER = 'serialize'
 DESERIALIZER = 'deserialize'
-SETSIZE = 'set_size'
+START_SIZED_FRAME = 'start_sized_frame'
 SIZETYPE = 'size_type'
 
 
@@ -292,12 +292,14 @@ class ClassDef(ASTBase):
 template <typename Output>
 void serializer<{full_name}>::write(Output& buf, const {full_name}& obj) {{""")
         if not self.final:
-            fprintln(cout, f"""  {SETSIZE}(buf, obj);""")
+            fprintln(cout, f"""  auto size_frame = {START_SIZED_FRAME}(buf, obj);""")
         for member in self.members:
             if isinstance(member, ClassDef) or isinstance(member, EnumDef):
                 continue
             fprintln(cout, f"""  static_assert(is_equivalent<decltype(obj.{member.name}), {param_type(member.type)}>::value, "member value has a wrong type");
   {SERIALIZER}(buf, obj.{member.name});""")
+        if not self.final:
+            fprintln(cout, """  size_frame.end(buf);""")
         fprintln(cout, "}")
 
 
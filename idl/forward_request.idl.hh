@@ -26,10 +26,12 @@ struct forward_request {
     lowres_clock::time_point timeout;
 
     std::optional<std::vector<query::forward_request::aggregation_info>> aggregation_infos [[version 5.1]];
+    std::optional<std::vector<sstring>> group_by_column_names [[version 5.2]];
 };
 
 struct forward_result {
     std::vector<bytes_opt> query_results;
+    std::optional<std::vector<std::vector<bytes_opt>>> grouped_query_results [[version 5.2]];
 };
 
 verb forward_request(query::forward_request, std::optional<tracing::trace_info>) -> query::forward_result;
@@ -31,6 +31,7 @@ struct get_sync_boundary_response {
 enum class row_level_diff_detect_algorithm : uint8_t {
     send_full_set,
     send_full_set_rpc_stream,
+    send_bucketed_set_rpc_stream,
 };
 
 enum class repair_stream_cmd : uint8_t {
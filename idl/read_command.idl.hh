@@ -23,6 +23,12 @@ class specific_ranges {
 // * native format
 // The wire format uses the legacy format. See docs/dev/reverse-reads.md
 // for more details on the formats.
+struct partition_key_filter {
+    uint32_t component;
+    std::optional<std::vector<bytes>> values;
+    nonwrapping_range<bytes> range;
+};
+
 class partition_slice {
     std::vector<nonwrapping_range<clustering_key_prefix>> default_row_ranges();
     utils::small_vector<uint32_t, 8> static_columns;
@@ -32,6 +38,7 @@ class partition_slice {
     cql_serialization_format cql_format();
     uint32_t partition_row_limit_low_bits() [[version 1.3]] = std::numeric_limits<uint32_t>::max();
     uint32_t partition_row_limit_high_bits() [[version 4.3]] = 0;
+    std::vector<query::partition_key_filter> partition_key_filters() [[version 5.2]];
 };
 
 struct max_result_size {
@@ -55,6 +55,39 @@ static wasmtime::Func import_func(wasmtime::Instance& instance, wasmtime::Store&
     }
 }
 
+wasmtime::Memory& instance_exports::memory(wasmtime::Instance& instance, wasmtime::Store& store) {
+    if (!_memory) {
+        // `memory` is required to be exported in the WebAssembly module
+        auto memory_export = instance.get(store, "memory");
+        if (!memory_export) {
+            throw wasm::exception("memory export not found - please export `memory` in the wasm module");
+        }
+        _memory = std::get<wasmtime::Memory>(*memory_export);
+    }
+    return *_memory;
+}
+
+uint32_t instance_exports::abi(wasmtime::Instance& instance, wasmtime::Store& store) {
+    if (!_abi) {
+        _abi = get_abi(instance, store, memory(instance, store).data(store).data());
+    }
+    return *_abi;
+}
+
+wasmtime::Func& instance_exports::malloc_func(wasmtime::Instance& instance, wasmtime::Store& store) {
+    if (!_malloc_func) {
+        _malloc_func = import_func(instance, store, "_scylla_malloc");
+    }
+    return *_malloc_func;
+}
+
+wasmtime::Func& instance_exports::free_func(wasmtime::Instance& instance, wasmtime::Store& store) {
+    if (!_free_func) {
+        _free_func = import_func(instance, store, "_scylla_free");
+    }
+    return *_free_func;
+}
+
 static wasmtime::Val call_func(wasmtime::Store& store, wasmtime::Func func, std::vector<wasmtime::Val> argv) {
     auto result = func.call(store, argv);
     if (!result) {
@@ -117,21 +150,14 @@ void compile(context& ctx, const std::vector<sstring>& arg_names, std::string sc
     create_instance_and_func(ctx, store);
 }
 
-static void init_abstract_arg(const abstract_type& t, const bytes_opt& param, std::vector<wasmtime::Val>& argv, wasmtime::Store& store, wasmtime::Instance& instance) {
-        // set up exported memory's underlying buffer,
-        // `memory` is required to be exported in the WebAssembly module
-        auto memory_export = instance.get(store, "memory");
-        if (!memory_export) {
-            throw wasm::exception("memory export not found - please export `memory` in the wasm module");
-        }
-        auto memory = std::get<wasmtime::Memory>(*memory_export);
-        uint8_t* data = memory.data(store).data();
+static void init_abstract_arg(const abstract_type& t, const bytes_opt& param, std::vector<wasmtime::Val>& argv, wasmtime::Store& store, wasmtime::Instance& instance, instance_exports& exports) {
+        auto& memory = exports.memory(instance, store);
         size_t mem_size = memory.size(store) * WASM_PAGE_SIZE;
         int32_t serialized_size = param ? param->size() : 0;
         if (serialized_size > std::numeric_limits<int32_t>::max()) {
             throw wasm::exception(format("Serialized parameter is too large: {} > {}", param->size(), std::numeric_limits<int32_t>::max()));
         }
-        switch (uint32_t abi_ver = get_abi(instance, store, data)) {
+        switch (uint32_t abi_ver = exports.abi(instance, store)) {
             case 1: {
                 auto grown = memory.grow(store, 1 + (sizeof(int32_t) + serialized_size - 1) / WASM_PAGE_SIZE); // for fitting serialized size + the buffer itself
                 if (!grown) {
@@ -141,8 +167,8 @@ static void init_abstract_arg(const abstract_type& t, const bytes_opt& param, st
                 break;
             }
             case 2: {
-                auto malloc_func = import_func(instance, store, "_scylla_malloc");
-                import_func(instance, store, "_scylla_free");
+                auto& malloc_func = exports.malloc_func(instance, store);
+                exports.free_func(instance, store);
                 auto size = call_func(store, malloc_func, {int32_t(sizeof(int32_t) + serialized_size)});
                 mem_size = size.i32();
                 break;
@@ -151,7 +177,9 @@ static void init_abstract_arg(const abstract_type& t, const bytes_opt& param, st
                 throw wasm::exception(format("ABI version {} not recognized", abi_ver));
         }
         if (param) {
-            // put the argument in wasm module's memory
+            // put the argument in wasm module's memory; growing it, directly
+            // or through malloc, may have moved its underlying buffer
+            uint8_t* data = memory.data(store).data();
             std::memcpy(data + mem_size, param->data(), serialized_size);
         } else {
             // size of -1 means that the value is null
@@ -168,6 +196,7 @@ struct init_arg_visitor {
     std::vector<wasmtime::Val>& argv;
     wasmtime::Store& store;
     wasmtime::Instance& instance;
+    instance_exports& exports;
 
     void operator()(const boolean_type_impl&) {
         auto dv = boolean_type->deserialize(*param);
@@ -209,7 +238,7 @@ struct init_arg_visitor {
         if (!param) {
             on_internal_error(wasm_logger, "init_arg_visitor does not accept null values");
         }
-        init_abstract_arg(t, param, argv, store, instance);
+        init_abstract_arg(t, param, argv, store, instance, exports);
     }
 };
 
@@ -218,9 +247,10 @@ struct init_nullable_arg_visitor {
     std::vector<wasmtime::Val>& argv;
     wasmtime::Store& store;
     wasmtime::Instance& instance;
+    instance_exports& exports;
 
     void operator()(const abstract_type& t) {
-        init_abstract_arg(t, param, argv, store, instance);
+        init_abstract_arg(t, param, argv, store, instance, exports);
     }
 };
 
@@ -229,6 +259,7 @@ struct from_val_visitor {
     const wasmtime::Val& val;
     wasmtime::Store& store;
     wasmtime::Instance& instance;
+    instance_exports& exports;
 
     bytes_opt operator()(const boolean_type_impl&) {
         expect_kind(wasmtime::ValKind::I32);
@@ -261,12 +292,7 @@ struct from_val_visitor {
 
     bytes_opt operator()(const abstract_type& t) {
         expect_kind(wasmtime::ValKind::I64);
-        auto memory_export = instance.get(store, "memory");
-        if (!memory_export) {
-            throw wasm::exception("memory export not found - please export `memory` in the wasm module");
-        }
-        auto memory = std::get<wasmtime::Memory>(*memory_export);
-        uint8_t* mem_base = memory.data(store).data();
+        uint8_t* mem_base = exports.memory(instance, store).data(store).data();
         uint8_t* data = mem_base + (val.i64() & 0xffffffff);
         int32_t ret_size = val.i64() >> 32;
         if (ret_size == -1) {
@@ -274,9 +300,8 @@ struct from_val_visitor {
         }
         bytes_opt ret = t.decompose(t.deserialize(bytes_view(reinterpret_cast<int8_t*>(data), ret_size)));
 
-        if (get_abi(instance, store, mem_base) == 2) {
-            auto free_func = import_func(instance, store, "_scylla_free");
-            call_void_func(store, free_func, {wasmtime::Val((int32_t)val.i64())});
+        if (exports.abi(instance, store) == 2) {
+            call_void_func(store, exports.free_func(instance, store), {wasmtime::Val((int32_t)val.i64())});
         }
 
         return ret;
@@ -299,7 +324,7 @@ struct from_val_visitor {
     }
 };
 
-seastar::future<bytes_opt> run_script(context& ctx, wasmtime::Store& store, wasmtime::Instance& instance, wasmtime::Func& func, const std::vector<data_type>& arg_types, const std::vector<bytes_opt>& params, data_type return_type, bool allow_null_input) {
+seastar::future<bytes_opt> run_script(context& ctx, wasmtime::Store& store, wasmtime::Instance& instance, wasmtime::Func& func, instance_exports& exports, const std::vector<data_type>& arg_types, const std::vector<bytes_opt>& params, data_type return_type, bool allow_null_input) {
     wasm_logger.debug("Running function {}", ctx.function_name);
 
     // Replenish the store with initial amount of fuel
@@ -314,9 +339,9 @@ seastar::future<bytes_opt> run_script(context& ctx, wasmtime::Store& store, wasm
         // If nulls are allowed, each type will be passed indirectly
         // as a struct {bool is_null; int32_t serialized_size, char[] serialized_buf}
         if (allow_null_input) {
-            visit(type, init_nullable_arg_visitor{param, argv, store, instance});
+            visit(type, init_nullable_arg_visitor{param, argv, store, instance, exports});
         } else if (param) {
-            visit(type, init_arg_visitor{param, argv, store, instance});
+            visit(type, init_arg_visitor{param, argv, store, instance, exports});
         } else {
             co_await coroutine::return_exception(wasm::exception(format("Function {} cannot be called on null values", ctx.function_name)));
         }
@@ -352,16 +377,17 @@ seastar::future<bytes_opt> run_script(context& ctx, wasmtime::Store& store, wasm
     if (allow_null_input) {
         // Force calling the default method for abstract_type, which checks for nulls
         // and expects a serialized input
-        co_return from_val_visitor{result_vec[0], store, instance}(static_cast<const abstract_type&>(*return_type));
+        co_return from_val_visitor{result_vec[0], store, instance, exports}(static_cast<const abstract_type&>(*return_type));
     } else {
-        co_return visit(*return_type, from_val_visitor{result_vec[0], store, instance});
+        co_return visit(*return_type, from_val_visitor{result_vec[0], store, instance, exports});
     }
 }
 
 seastar::future<bytes_opt> run_script(context& ctx, const std::vector<data_type>& arg_types, const std::vector<bytes_opt>& params, data_type return_type, bool allow_null_input) {
     auto store = wasmtime::Store(ctx.engine_ptr->get());
     auto [instance, func] = create_instance_and_func(ctx, store);
-    return run_script(ctx, store, instance, func, arg_types, params, return_type, allow_null_input);
+    instance_exports exports;
+    return run_script(ctx, store, instance, func, exports, arg_types, params, return_type, allow_null_input);
 }
 
 seastar::future<bytes_opt> run_script(const db::functions::function_name& name, context& ctx, const std::vector<data_type>& arg_types, const std::vector<bytes_opt>& params, data_type return_type, bool allow_null_input) {
@@ -370,7 +396,7 @@ seastar::future<bytes_opt> run_script(const db::functions::function_name& name,
     bytes_opt ret;
     try {
         func_inst = ctx.cache->get(name, arg_types, ctx).get0();
-        ret = wasm::run_script(ctx, func_inst->instance->store, func_inst->instance->instance, func_inst->instance->func, arg_types, params, return_type, allow_null_input).get0();
+        ret = wasm::run_script(ctx, func_inst->instance->store, func_inst->instance->instance, func_inst->instance->func, func_inst->instance->exports, arg_types, params, return_type, allow_null_input).get0();
     } catch (const wasm::instance_corrupting_exception& e) {
         func_inst->instance = std::nullopt;
         ex = std::current_exception();
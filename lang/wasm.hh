@@ -41,6 +41,22 @@ struct context {
     context(wasm::engine* engine_ptr, std::string name, instance_cache* cache);
 };
 
+// Exports of an instance which are used to pass arguments and return values.
+// They are looked up on first use and remembered, so that calls with
+// serialized arguments don't search the instance's exports by name for each
+// of them.
+class instance_exports {
+    std::optional<wasmtime::Memory> _memory;
+    std::optional<uint32_t> _abi;
+    std::optional<wasmtime::Func> _malloc_func;
+    std::optional<wasmtime::Func> _free_func;
+public:
+    wasmtime::Memory& memory(wasmtime::Instance& instance, wasmtime::Store& store);
+    uint32_t abi(wasmtime::Instance& instance, wasmtime::Store& store);
+    wasmtime::Func& malloc_func(wasmtime::Instance& instance, wasmtime::Store& store);
+    wasmtime::Func& free_func(wasmtime::Instance& instance, wasmtime::Store& store);
+};
+
 void compile(context& ctx, const std::vector<sstring>& arg_names, std::string script);
 
 seastar::future<bytes_opt> run_script(context& ctx, const std::vector<data_type>& arg_types, const std::vector<bytes_opt>& params, data_type return_type, bool allow_null_input);
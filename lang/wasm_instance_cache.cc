@@ -79,7 +79,7 @@ wasm_instance instance_cache::load(wasm::context& ctx) {
     }
     auto memory = std::get<wasmtime::Memory>(*memory_export);
 
-    return wasm::wasm_instance{.store=std::move(store), .instance=std::move(instance), .func=std::move(*func), .memory=std::move(memory)};
+    return wasm::wasm_instance{.store=std::move(store), .instance=std::move(instance), .func=std::move(*func), .memory=std::move(memory), .exports={}};
 }
 
 // lru must not be empty, and its elements must refer to entries in _cache
@@ -50,6 +50,7 @@ struct wasm_instance {
     wasmtime::Instance instance;
     wasmtime::Func func;
     wasmtime::Memory memory;
+    instance_exports exports;
 };
 
 // For each UDF full name and a scheduling group, we store a wasmtime instance
@@ -11,7 +11,6 @@
 #include "exceptions/exceptions.hh"
 #include <boost/range/algorithm/remove_if.hpp>
 #include <seastar/core/coroutine.hh>
-#include <seastar/coroutine/maybe_yield.hh>
 #include "utils/stall_free.hh"
 
 namespace locator {
@@ -67,6 +66,10 @@ sstring abstract_replication_strategy::to_qualified_class_name(std::string_view
 }
 
 inet_address_vector_replica_set abstract_replication_strategy::get_natural_endpoints(const token& search_token, const effective_replication_map& erm) const {
+    const auto& lookup_table = erm.get_lookup_table();
+    if (!lookup_table.empty()) {
+        return lookup_table.get(search_token);
+    }
     const token& key_token = erm.get_token_metadata_ptr()->first_token(search_token);
     auto res = erm.get_replication_map().find(key_token);
     return res->second;
@@ -322,26 +325,26 @@ future<mutable_effective_replication_map_ptr> calculate_effective_replication_ma
         replication_map.emplace(t, co_await rs->calculate_natural_endpoints(t, *tmptr));
     }
 
+    // The table points into replication_map, whose nodes stay in place when it is moved.
+    auto lookup_table = co_await replica_lookup_table::build(tmptr->sorted_tokens(), replication_map);
     auto rf = rs->get_replication_factor(*tmptr);
-    co_return make_effective_replication_map(std::move(rs), std::move(tmptr), std::move(replication_map), rf);
+    co_return make_effective_replication_map(std::move(rs), std::move(tmptr), std::move(replication_map), rf, std::move(lookup_table));
 }
 
-future<replication_map> effective_replication_map::clone_endpoints_gently() const {
-    replication_map cloned_endpoints;
-
-    for (auto& i : _replication_map) {
-        cloned_endpoints.emplace(i.first, i.second);
-        co_await coroutine::maybe_yield();
-    }
-
-    co_return cloned_endpoints;
-}
+effective_replication_map::effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr, foreign_ptr<effective_replication_map_ptr> shared_erm) noexcept
+    : _rs(std::move(rs))
+    , _tmptr(std::move(tmptr))
+    , _shared_erm(std::move(shared_erm))
+    , _replication_factor(_shared_erm->get_replication_factor())
+{ }
 
 inet_address_vector_replica_set effective_replication_map::get_natural_endpoints(const token& search_token) const {
     return _rs->get_natural_endpoints(search_token, *this);
 }
 
 future<> effective_replication_map::clear_gently() noexcept {
+    _shared_erm.reset();
+    _lookup_table.clear();
     co_await utils::clear_gently(_replication_map);
     co_await utils::clear_gently(_tmptr);
 }
@@ -386,9 +389,9 @@ future<effective_replication_map_ptr> effective_replication_map_factory::create_
     });
     mutable_effective_replication_map_ptr new_erm;
     if (ref_erm) {
-        auto rf = ref_erm->get_replication_factor();
-        auto local_replication_map = co_await ref_erm->clone_endpoints_gently();
-        new_erm = make_effective_replication_map(std::move(rs), std::move(tmptr), std::move(local_replication_map), rf);
+        // The reference map is immutable and kept alive by ref_erm,
+        // so share its replication map rather than cloning it.
+        new_erm = make_effective_replication_map(std::move(rs), std::move(tmptr), std::move(ref_erm));
     } else {
         new_erm = co_await calculate_effective_replication_map(std::move(rs), std::move(tmptr));
     }
@@ -15,8 +15,10 @@
 #include "locator/snitch_base.hh"
 #include "dht/i_partitioner.hh"
 #include "token_metadata.hh"
+#include "locator/replica_lookup_table.hh"
 #include "snitch_base.hh"
 #include <seastar/util/bool_class.hh>
+#include <seastar/core/sharded.hh>
 #include "utils/maybe_yield.hh"
 
 // forward declaration since replica/database.hh includes this file
@@ -152,6 +154,11 @@ class effective_replication_map : public enable_lw_shared_from_this<effective_re
     abstract_replication_strategy::ptr_type _rs;
     token_metadata_ptr _tmptr;
     replication_map _replication_map;
+    replica_lookup_table _lookup_table;
+    // The map of shard 0 this one shares its replication map with, if any.
+    // Replication maps are immutable once calculated, so the other shards
+    // read the one of shard 0 instead of keeping their own copy of it.
+    foreign_ptr<effective_replication_map_ptr> _shared_erm;
     size_t _replication_factor;
     std::optional<factory_key> _factory_key = std::nullopt;
     effective_replication_map_factory* _factory = nullptr;
@@ -159,12 +166,15 @@ class effective_replication_map : public enable_lw_shared_from_this<effective_re
     friend class abstract_replication_strategy;
     friend class effective_replication_map_factory;
 public:
-    explicit effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr, replication_map replication_map, size_t replication_factor) noexcept
+    explicit effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr, replication_map replication_map, size_t replication_factor,
+            replica_lookup_table lookup_table = {}) noexcept
         : _rs(std::move(rs))
         , _tmptr(std::move(tmptr))
         , _replication_map(std::move(replication_map))
+        , _lookup_table(std::move(lookup_table))
         , _replication_factor(replication_factor)
     { }
+    explicit effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr, foreign_ptr<effective_replication_map_ptr> shared_erm) noexcept;
     effective_replication_map() = delete;
     effective_replication_map(effective_replication_map&&) = default;
     ~effective_replication_map();
@@ -174,7 +184,13 @@ class effective_replication_map : public enable_lw_shared_from_this<effective_re
     }
 
     const replication_map& get_replication_map() const noexcept {
-        return _replication_map;
+        return _shared_erm ? _shared_erm->get_replication_map() : _replication_map;
+    }
+
+    // Finds the replica set of a token in the replication map.
+    // Empty if the map wasn't built by calculate_effective_replication_map().
+    const replica_lookup_table& get_lookup_table() const noexcept {
+        return _shared_erm ? _shared_erm->get_lookup_table() : _lookup_table;
     }
 
     const size_t get_replication_factor() const noexcept {
@@ -183,8 +199,6 @@ class effective_replication_map : public enable_lw_shared_from_this<effective_re
 
     future<> clear_gently() noexcept;
 
-    future<replication_map> clone_endpoints_gently() const;
-
     inet_address_vector_replica_set get_natural_endpoints(const token& search_token) const;
     inet_address_vector_replica_set get_natural_endpoints_without_node_being_replaced(const token& search_token) const;
 
@@ -243,8 +257,14 @@ class effective_replication_map : public enable_lw_shared_from_this<effective_re
 using effective_replication_map_ptr = lw_shared_ptr<const effective_replication_map>;
 using mutable_effective_replication_map_ptr = lw_shared_ptr<effective_replication_map>;
 
-inline mutable_effective_replication_map_ptr make_effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr, replication_map replication_map, size_t replication_factor) {
-    return make_lw_shared<effective_replication_map>(std::move(rs), std::move(tmptr), std::move(replication_map), replication_factor);
+inline mutable_effective_replication_map_ptr make_effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr, replication_map replication_map, size_t replication_factor,
+        replica_lookup_table lookup_table = {}) {
+    return make_lw_shared<effective_replication_map>(std::move(rs), std::move(tmptr), std::move(replication_map), replication_factor, std::move(lookup_table));
+}
+
+// Make an effective_replication_map sharing the replication map of shared_erm, which lives on another shard.
+inline mutable_effective_replication_map_ptr make_effective_replication_map(abstract_replication_strategy::ptr_type rs, token_metadata_ptr tmptr, foreign_ptr<effective_replication_map_ptr> shared_erm) {
+    return make_lw_shared<effective_replication_map>(std::move(rs), std::move(tmptr), std::move(shared_erm));
 }
 
 // Apply the replication strategy over the current configuration and the given token_metadata.
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/coroutine/maybe_yield.hh>
+
+#include "locator/replica_lookup_table.hh"
+
+namespace locator {
+
+future<replica_lookup_table> replica_lookup_table::build(const std::vector<dht::token>& sorted_tokens,
+        const std::unordered_map<dht::token, inet_address_vector_replica_set>& replication_map) {
+    replica_lookup_table table;
+    const size_t n = sorted_tokens.size();
+    if (!n) {
+        co_return table;
+    }
+    table._keys.resize(n + 1);
+    table._replicas.resize(n + 1);
+
+    // Visit the implicit tree in order, which assigns the sorted tokens to it.
+    size_t k = 1;
+    while (2 * k <= n) {
+        k *= 2;
+    }
+    for (const auto& t : sorted_tokens) {
+        auto* replicas = &replication_map.at(t);
+        table._keys[k] = t.raw();
+        table._replicas[k] = replicas;
+        if (!table._first) {
+            table._first = replicas;
+        }
+        if (2 * k + 1 <= n) {
+            k = 2 * k + 1;
+            while (2 * k <= n) {
+                k *= 2;
+            }
+        } else {
+            while (k & 1) {
+                k >>= 1;
+            }
+            k >>= 1;
+        }
+        co_await coroutine::maybe_yield();
+    }
+    co_return table;
+}
+
+} // namespace locator
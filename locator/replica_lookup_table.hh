@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <unordered_map>
+#include <vector>
+
+#include <seastar/core/future.hh>
+
+#include "dht/i_partitioner.hh"
+#include "inet_address_vectors.hh"
+#include "seastarx.hh"
+
+namespace locator {
+
+// Maps a token to the replica set of the first ring token not smaller
+// than it, wrapping around to the first ring token.
+//
+// The raw values of the ring tokens are kept in Eytzinger (breadth-first)
+// layout, so the top levels of the search share a few cache lines and the
+// next levels can be prefetched, unlike a binary search over the sorted
+// tokens. The replica sets aren't copied: the table points into the
+// replication map it was built from, which must outlive it and must not
+// be modified.
+class replica_lookup_table {
+    // _keys[1..n] hold the raw tokens, _replicas[k] the replica set of _keys[k].
+    std::vector<int64_t> _keys;
+    std::vector<const inet_address_vector_replica_set*> _replicas;
+    const inet_address_vector_replica_set* _first = nullptr;
+public:
+    replica_lookup_table() = default;
+
+    static future<replica_lookup_table> build(const std::vector<dht::token>& sorted_tokens,
+            const std::unordered_map<dht::token, inet_address_vector_replica_set>& replication_map);
+
+    bool empty() const noexcept {
+        return _first == nullptr;
+    }
+
+    // Must not be called on an empty table.
+    const inet_address_vector_replica_set& get(const dht::token& t) const noexcept {
+        // Ring tokens are of kind key, so the raw values order them like
+        // tokens do, except for the maximum token, which is after all of them.
+        if (t.is_maximum()) {
+            return *_first;
+        }
+        const auto x = t.raw();
+        const size_t n = _keys.size() - 1;
+        size_t k = 1;
+        while (k <= n) {
+            __builtin_prefetch(_keys.data() + std::min(16 * k, n));
+            k = 2 * k + (_keys[k] < x);
+        }
+        // Undo the right turns taken after the last left turn, which was
+        // made at the lower bound. k == 0 if there was none.
+        k >>= std::countr_one(k) + 1;
+        return k ? *_replicas[k] : *_first;
+    }
+
+    void clear() noexcept {
+        _keys = {};
+        _replicas = {};
+        _first = nullptr;
+    }
+};
+
+} // namespace locator
@@ -37,6 +37,7 @@
 #include "utils/runtime.hh"
 #include "log.hh"
 #include "utils/directories.hh"
+#include "utils/hw_counters.hh"
 #include "debug.hh"
 #include "auth/common.hh"
 #include "init.hh"
@@ -87,6 +88,7 @@
 #include "alternator/ttl.hh"
 #include "tools/entry_point.hh"
 #include "db/per_partition_rate_limit_extension.hh"
+#include "db/non_durable_writes_extension.hh"
 #include "lang/wasm_instance_cache.hh"
 
 #include "service/raft/raft_group_registry.hh"
@@ -496,6 +498,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
     ext->add_schema_extension<db::paxos_grace_seconds_extension>(db::paxos_grace_seconds_extension::NAME);
     ext->add_schema_extension<tombstone_gc_extension>(tombstone_gc_extension::NAME);
     ext->add_schema_extension<db::per_partition_rate_limit_extension>(db::per_partition_rate_limit_extension::NAME);
+    ext->add_schema_extension<db::non_durable_writes_extension>(db::non_durable_writes_extension::NAME);
 
     auto cfg = make_lw_shared<db::config>(ext);
     auto init = app.get_options_description().add_options();
@@ -669,6 +672,8 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                 st_cfg.abort_on_lsa_bad_alloc = cfg->abort_on_lsa_bad_alloc();
                 st_cfg.lsa_reclamation_step = cfg->lsa_reclamation_step();
                 st_cfg.background_reclaim_sched_group = background_reclaim_scheduling_group;
+                st_cfg.background_defragmentation = cfg->lsa_background_defragmentation();
+                st_cfg.huge_pages = cfg->lsa_huge_pages();
                 st_cfg.sanitizer_report_backtrace = cfg->sanitizer_report_backtrace();
                 logalloc::shard_tracker().configure(st_cfg);
             }).get();
@@ -777,7 +782,8 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             supervisor::notify("creating tracing");
             tracing::backend_registry tracing_backend_registry;
             tracing::register_tracing_keyspace_backend(tracing_backend_registry);
-            tracing::tracing::create_tracing(tracing_backend_registry, "trace_keyspace_helper").get();
+            tracing::register_tracing_ring_buffer_backend(tracing_backend_registry);
+            tracing::tracing::create_tracing(tracing_backend_registry, cfg->tracing_backend()).get();
             auto destroy_tracing = defer_verbose_shutdown("tracing instance", [] {
                 tracing::tracing::tracing_instance().stop().get();
             });
@@ -807,6 +813,18 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             dbcfg.gossip_scheduling_group = make_sched_group("gossip", 1000);
             dbcfg.available_memory = memory::stats().total_memory();
 
+            static sharded<utils::hw_counter_sampler> hw_counter_sampler;
+            if (auto sample_cycles = cfg->hw_counters_sample_cycles()) {
+                supervisor::notify("starting hardware counter sampling");
+                hw_counter_sampler.start(sample_cycles).get();
+                hw_counter_sampler.invoke_on_all(&utils::hw_counter_sampler::start).get();
+            }
+            auto stop_hw_counter_sampler = defer_verbose_shutdown("hardware counter sampling", [] {
+                if (hw_counter_sampler.local_is_initialized()) {
+                    hw_counter_sampler.stop().get();
+                }
+            });
+
             netw::messaging_service::config mscfg;
 
             mscfg.ip = utils::resolve(cfg->listen_address, family).get0();
@@ -832,6 +850,7 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
             } else if (compress_what == "dc") {
                 mscfg.compress = netw::messaging_service::compress_what::dc;
             }
+            mscfg.compress_streaming = cfg->internode_compression_streaming();
 
             if (!cfg->inter_dc_tcp_nodelay()) {
                 mscfg.tcp_nodelay = netw::messaging_service::tcp_nodelay_what::local;
@@ -989,6 +1008,9 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                     .available_memory = dbcfg.available_memory,
                     .static_shares = cfg->compaction_static_shares,
                     .throughput_mb_per_sec = cfg->compaction_throughput_mb_per_sec,
+                    .major_compaction_parallelism = cfg->major_compaction_parallelism,
+                    .read_latency_objective_us = cfg->compaction_read_latency_objective_us,
+                    .read_queue_length_objective = cfg->compaction_read_queue_length_objective,
                 };
             });
             cm.start(std::move(get_cm_cfg), std::ref(stop_signal.as_sharded_abort_source())).get();
@@ -1175,6 +1197,8 @@ To start the scylla server proper, simply invoke as: scylla server (or just scyl
                 }
             }
 
+            api::set_server_commitlog_replay(ctx).get();
+
             auto sch_cl = db.local().schema_commitlog();
             if (sch_cl != nullptr) {
                 auto paths = sch_cl->get_segments_to_replay();
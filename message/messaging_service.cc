@@ -145,7 +145,7 @@ struct messaging_service::rpc_protocol_server_wrapper : public rpc_protocol::ser
 constexpr int32_t messaging_service::current_version;
 
 // Count of connection types that are not associated with any tenant
-const size_t PER_SHARD_CONNECTION_COUNT = 2;
+const size_t PER_SHARD_CONNECTION_COUNT = 3;
 // Counts per tenant connection types
 const size_t PER_TENANT_CONNECTION_COUNT = 3;
 
@@ -494,11 +494,17 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::REPAIR_UPDATE_SYSTEM_TABLE:
     case messaging_verb::REPAIR_FLUSH_HINTS_BATCHLOG:
     case messaging_verb::NODE_OPS_CMD:
-    case messaging_verb::HINT_MUTATION:
         return 1;
+    // Hints are replayed in the streaming scheduling group, but on a connection
+    // of their own, so that they aren't queued behind large repair payloads
+    // and don't delay repair's small requests in turn.
+    case messaging_verb::HINT_MUTATION:
+        return 2;
     case messaging_verb::CLIENT_ID:
     case messaging_verb::MUTATION:
+    case messaging_verb::MUTATION_BATCH:
     case messaging_verb::READ_DATA:
+    case messaging_verb::READ_DATA_BATCH:
     case messaging_verb::READ_MUTATION_DATA:
     case messaging_verb::READ_DIGEST:
     case messaging_verb::DEFINITIONS_UPDATE:
@@ -523,12 +529,12 @@ static constexpr unsigned do_get_rpc_client_idx(messaging_verb verb) {
     case messaging_verb::RAFT_EXECUTE_READ_BARRIER_ON_LEADER:
     case messaging_verb::RAFT_ADD_ENTRY:
     case messaging_verb::RAFT_MODIFY_CONFIG:
-        return 2;
+        return 3;
     case messaging_verb::MUTATION_DONE:
     case messaging_verb::MUTATION_FAILED:
-        return 3;
-    case messaging_verb::FORWARD_REQUEST:
         return 4;
+    case messaging_verb::FORWARD_REQUEST:
+        return 5;
     case messaging_verb::LAST:
         return -1; // should never happen
     }
@@ -577,6 +583,7 @@ messaging_service::initial_scheduling_info() const {
     auto sched_infos = std::vector<scheduling_info_for_connection_index>({
         { _scheduling_config.gossip, "gossip" },
         { _scheduling_config.streaming, "streaming", },
+        { _scheduling_config.streaming, "hints", },
     });
 
     sched_infos.reserve(sched_infos.size() +
@@ -724,11 +731,15 @@ shared_ptr<messaging_service::rpc_protocol_client_wrapper> messaging_service::ge
         return broadcast_address != laddr && snitch_ptr->get_rack(laddr) != my_rack;
     }();
 
-    auto must_compress = [&id, this] {
+    auto must_compress = [&id, idx, this] {
         if (_cfg.compress == compress_what::none) {
             return false;
         }
 
+        if (idx == 1 && !_cfg.compress_streaming) {
+            return false;
+        }
+
         if (_cfg.compress == compress_what::dc) {
             auto& snitch_ptr = locator::i_endpoint_snitch::get_local_snitch_ptr();
             return snitch_ptr->get_datacenter(id.addr)
@@ -1118,14 +1129,17 @@ future<> messaging_service::send_replication_finished(msg_addr id, inet_address
 }
 
 // Wrapper for REPAIR_GET_FULL_ROW_HASHES
-void messaging_service::register_repair_get_full_row_hashes(std::function<future<repair_hash_set> (const rpc::client_info& cinfo, uint32_t repair_meta_id)>&& func) {
+void messaging_service::register_repair_get_full_row_hashes(std::function<future<rpc::tuple<repair_hash_set, std::vector<uint32_t>>> (const rpc::client_info& cinfo, uint32_t repair_meta_id,
+        rpc::optional<std::vector<repair_hash>> bucket_hashes)>&& func) {
     register_handler(this, messaging_verb::REPAIR_GET_FULL_ROW_HASHES, std::move(func));
 }
 future<> messaging_service::unregister_repair_get_full_row_hashes() {
     return unregister_handler(messaging_verb::REPAIR_GET_FULL_ROW_HASHES);
 }
-future<repair_hash_set> messaging_service::send_repair_get_full_row_hashes(msg_addr id, uint32_t repair_meta_id) {
-    return send_message<future<repair_hash_set>>(this, messaging_verb::REPAIR_GET_FULL_ROW_HASHES, std::move(id), repair_meta_id);
+future<rpc::tuple<repair_hash_set, rpc::optional<std::vector<uint32_t>>>> messaging_service::send_repair_get_full_row_hashes(msg_addr id, uint32_t repair_meta_id,
+        std::vector<repair_hash> bucket_hashes) {
+    return send_message<future<rpc::tuple<repair_hash_set, rpc::optional<std::vector<uint32_t>>>>>(this, messaging_verb::REPAIR_GET_FULL_ROW_HASHES, std::move(id),
+            repair_meta_id, std::move(bucket_hashes));
 }
 
 // Wrapper for REPAIR_GET_COMBINED_ROW_HASH
@@ -1194,14 +1208,14 @@ future<> messaging_service::send_repair_row_level_stop(msg_addr id, uint32_t rep
 }
 
 // Wrapper for REPAIR_GET_ESTIMATED_PARTITIONS
-void messaging_service::register_repair_get_estimated_partitions(std::function<future<uint64_t> (const rpc::client_info& cinfo, uint32_t repair_meta_id)>&& func) {
+void messaging_service::register_repair_get_estimated_partitions(std::function<future<rpc::tuple<uint64_t, bool>> (const rpc::client_info& cinfo, uint32_t repair_meta_id)>&& func) {
     register_handler(this, messaging_verb::REPAIR_GET_ESTIMATED_PARTITIONS, std::move(func));
 }
 future<> messaging_service::unregister_repair_get_estimated_partitions() {
     return unregister_handler(messaging_verb::REPAIR_GET_ESTIMATED_PARTITIONS);
 }
-future<uint64_t> messaging_service::send_repair_get_estimated_partitions(msg_addr id, uint32_t repair_meta_id) {
-    return send_message<future<uint64_t>>(this, messaging_verb::REPAIR_GET_ESTIMATED_PARTITIONS, std::move(id), repair_meta_id);
+future<rpc::tuple<uint64_t, rpc::optional<bool>>> messaging_service::send_repair_get_estimated_partitions(msg_addr id, uint32_t repair_meta_id) {
+    return send_message<future<rpc::tuple<uint64_t, rpc::optional<bool>>>>(this, messaging_verb::REPAIR_GET_ESTIMATED_PARTITIONS, std::move(id), repair_meta_id);
 }
 
 // Wrapper for REPAIR_SET_ESTIMATED_PARTITIONS
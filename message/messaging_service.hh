@@ -178,7 +178,9 @@ enum class messaging_verb : int32_t {
     REPAIR_UPDATE_SYSTEM_TABLE = 59,
     REPAIR_FLUSH_HINTS_BATCHLOG = 60,
     FORWARD_REQUEST = 61,
-    LAST = 62,
+    READ_DATA_BATCH = 62,
+    MUTATION_BATCH = 63,
+    LAST = 64,
 };
 
 } // namespace netw
@@ -263,6 +265,9 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
         uint16_t ssl_port = 0;
         encrypt_what encrypt = encrypt_what::none;
         compress_what compress = compress_what::none;
+        // Whether the connection carrying streaming and repair is
+        // compressed, when compress applies to its peer.
+        bool compress_streaming = true;
         tcp_nodelay_what tcp_nodelay = tcp_nodelay_what::all;
         bool listen_on_broadcast_address = false;
         size_t rpc_memory_limit = 1'000'000;
@@ -381,9 +386,11 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
     future<> unregister_complete_message();
 
     // Wrapper for REPAIR_GET_FULL_ROW_HASHES
-    void register_repair_get_full_row_hashes(std::function<future<repair_hash_set> (const rpc::client_info& cinfo, uint32_t repair_meta_id)>&& func);
+    void register_repair_get_full_row_hashes(std::function<future<rpc::tuple<repair_hash_set, std::vector<uint32_t>>> (const rpc::client_info& cinfo, uint32_t repair_meta_id,
+            rpc::optional<std::vector<repair_hash>> bucket_hashes)>&& func);
     future<> unregister_repair_get_full_row_hashes();
-    future<repair_hash_set> send_repair_get_full_row_hashes(msg_addr id, uint32_t repair_meta_id);
+    future<rpc::tuple<repair_hash_set, rpc::optional<std::vector<uint32_t>>>> send_repair_get_full_row_hashes(msg_addr id, uint32_t repair_meta_id,
+            std::vector<repair_hash> bucket_hashes);
 
     // Wrapper for REPAIR_GET_COMBINED_ROW_HASH
     void register_repair_get_combined_row_hash(std::function<future<get_combined_row_hash_response> (const rpc::client_info& cinfo, uint32_t repair_meta_id, std::optional<repair_sync_boundary> common_sync_boundary)>&& func);
@@ -416,9 +423,10 @@ class messaging_service : public seastar::async_sharded_service<messaging_servic
     future<> send_repair_row_level_stop(msg_addr id, uint32_t repair_meta_id, sstring keyspace_name, sstring cf_name, dht::token_range range);
 
     // Wrapper for REPAIR_GET_ESTIMATED_PARTITIONS
-    void register_repair_get_estimated_partitions(std::function<future<uint64_t> (const rpc::client_info& cinfo, uint32_t repair_meta_id)>&& func);
+    // The second element of the result tells whether the follower may hold tombstones in the range.
+    void register_repair_get_estimated_partitions(std::function<future<rpc::tuple<uint64_t, bool>> (const rpc::client_info& cinfo, uint32_t repair_meta_id)>&& func);
     future<> unregister_repair_get_estimated_partitions();
-    future<uint64_t> send_repair_get_estimated_partitions(msg_addr id, uint32_t repair_meta_id);
+    future<rpc::tuple<uint64_t, rpc::optional<bool>>> send_repair_get_estimated_partitions(msg_addr id, uint32_t repair_meta_id);
 
     // Wrapper for REPAIR_SET_ESTIMATED_PARTITIONS
     void register_repair_set_estimated_partitions(std::function<future<> (const rpc::client_info& cinfo, uint32_t repair_meta_id, uint64_t estimated_partitions)>&& func);
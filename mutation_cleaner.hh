@@ -85,13 +85,21 @@ void mutation_cleaner_impl::destroy_gently(partition_version& v) noexcept {
 
 inline
 void mutation_cleaner_impl::merge_and_destroy(partition_snapshot& ps) noexcept {
+    // A snapshot of the latest version shares versions with an entry, which
+    // reads of the partition will keep merging until the versions are coalesced.
+    const bool visible_to_reads = ps.at_latest_version();
     if (ps.slide_to_oldest() == stop_iteration::yes || merge_some(ps) == stop_iteration::yes) {
         lw_shared_ptr<partition_snapshot>::dispose(&ps);
     } else {
         // The snapshot must not be reachable by partitino_entry::read() after this,
         // which is ensured by slide_to_oldest() == stop_iteration::no.
         ps.migrate(&_region, _cleaner);
-        _worker_state->snapshots.push_back(ps);
+        // Merge versions which reads still see before those of partitions which are gone.
+        if (visible_to_reads) {
+            _worker_state->snapshots.push_front(ps);
+        } else {
+            _worker_state->snapshots.push_back(ps);
+        }
         _worker_state->cv.signal();
     }
 }
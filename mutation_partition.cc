@@ -407,6 +407,11 @@ stop_iteration mutation_partition::apply_monotonically(const schema& s, mutation
 
     auto p_i = p._rows.begin();
     auto i = _rows.begin();
+    // Appends, typical for time series, need no lookup: when p starts after our last row,
+    // all of its rows go to the end.
+    if (p_i != p._rows.end() && !_rows.empty() && cmp(*_rows.rbegin(), *p_i) < 0) {
+        i = _rows.end();
+    }
     while (p_i != p._rows.end()) {
       try {
         rows_entry& src_e = *p_i;
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "mutation_writer/size_based_splitting_writer.hh"
+
+#include <seastar/core/coroutine.hh>
+
+namespace mutation_writer {
+
+class size_based_splitting_mutation_writer {
+    schema_ptr _schema;
+    reader_permit _permit;
+    reader_consumer_v2 _consumer;
+    uint64_t _max_size;
+    uint64_t _current_size = 0;
+    std::optional<bucket_writer_v2> _current_writer;
+
+    future<> write(mutation_fragment_v2&& mf) {
+        _current_size += mf.memory_usage();
+        return _current_writer->consume(std::move(mf));
+    }
+public:
+    size_based_splitting_mutation_writer(schema_ptr schema, reader_permit permit, uint64_t max_size, reader_consumer_v2 consumer)
+        : _schema(std::move(schema))
+        , _permit(std::move(permit))
+        , _consumer(std::move(consumer))
+        , _max_size(max_size)
+    {}
+
+    future<> consume(partition_start&& ps) {
+        if (_current_writer && _current_size >= _max_size) {
+            _current_writer->consume_end_of_stream();
+            co_await _current_writer->close();
+            _current_writer.reset();
+        }
+        if (!_current_writer) {
+            _current_writer.emplace(_schema, _permit, _consumer);
+            _current_size = 0;
+        }
+        co_await write(mutation_fragment_v2(*_schema, _permit, std::move(ps)));
+    }
+
+    future<> consume(static_row&& sr) {
+        return write(mutation_fragment_v2(*_schema, _permit, std::move(sr)));
+    }
+
+    future<> consume(clustering_row&& cr) {
+        return write(mutation_fragment_v2(*_schema, _permit, std::move(cr)));
+    }
+
+    future<> consume(range_tombstone_change&& rt) {
+        return write(mutation_fragment_v2(*_schema, _permit, std::move(rt)));
+    }
+
+    future<> consume(partition_end&& pe) {
+        return write(mutation_fragment_v2(*_schema, _permit, std::move(pe)));
+    }
+
+    void consume_end_of_stream() {
+        if (_current_writer) {
+            _current_writer->consume_end_of_stream();
+        }
+    }
+    void abort(std::exception_ptr ep) {
+        if (_current_writer) {
+            _current_writer->abort(ep);
+        }
+    }
+    future<> close() noexcept {
+        return _current_writer ? _current_writer->close() : make_ready_future<>();
+    }
+};
+
+future<> split_by_size(flat_mutation_reader_v2 producer, uint64_t max_size, reader_consumer_v2 consumer) {
+    auto schema = producer.schema();
+    auto permit = producer.permit();
+    return feed_writer(
+        std::move(producer),
+        size_based_splitting_mutation_writer(std::move(schema), std::move(permit), max_size, std::move(consumer)));
+}
+
+} // namespace mutation_writer
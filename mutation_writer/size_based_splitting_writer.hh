@@ -0,0 +1,25 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <seastar/util/noncopyable_function.hh>
+
+#include "feed_writers.hh"
+
+namespace mutation_writer {
+
+// Consume the producer in consecutive runs of partitions, starting a new output
+// stream at the first partition boundary after max_size bytes of fragments went
+// into the current one. Sizes are those of fragments in memory, which is a rough,
+// usually pessimistic, estimate of their size on disk.
+// This is useful for writing a stream which doesn't fit a single sstable into
+// disjoint sstables of bounded size, as leveled compaction expects them.
+future<> split_by_size(flat_mutation_reader_v2 producer, uint64_t max_size, reader_consumer_v2 consumer);
+
+} // namespace mutation_writer
@@ -19,6 +19,7 @@ partition_slice_builder::partition_slice_builder(const schema& schema, query::pa
     , _specific_ranges(std::move(slice._specific_ranges))
     , _schema(schema)
     , _options(std::move(slice.options))
+    , _partition_key_filters(std::move(slice._partition_key_filters))
 {
 }
 
@@ -56,7 +57,7 @@ partition_slice_builder::build() {
             _schema.regular_columns() | boost::adaptors::transformed(std::mem_fn(&column_definition::id)));
     }
 
-    return {
+    query::partition_slice slice{
         std::move(ranges),
         std::move(static_columns),
         std::move(regular_columns),
@@ -65,6 +66,8 @@ partition_slice_builder::build() {
         cql_serialization_format::internal(),
         _partition_row_limit,
     };
+    slice.set_partition_key_filters(std::move(_partition_key_filters));
+    return slice;
 }
 
 partition_slice_builder&
@@ -30,6 +30,7 @@ class partition_slice_builder {
     std::unique_ptr<query::specific_ranges> _specific_ranges;
     const schema& _schema;
     query::partition_slice::option_set _options;
+    std::vector<query::partition_key_filter> _partition_key_filters;
     uint64_t _partition_row_limit = query::partition_max_rows;
 public:
     partition_slice_builder(const schema& schema);
@@ -239,10 +239,18 @@ void querier_cache::insert_querier(
 
     tracing::trace(trace_state, "Caching querier with key {}", key);
 
+    // The page which was resumed with the help of the state is over.
+    drop_resume_states(key);
+    drop_expired_resume_states();
+
     auto& sem = q.permit().semaphore();
 
+    // The resume state of an evicted querier lives no longer than the querier would have.
+    auto expiry = lowres_clock::now() + ttl;
+    auto resume_state = make_resume_state(q.permit());
     auto irh = sem.register_inactive_read(querier_utils::get_reader(q));
     if (!irh) {
+        keep_resume_state(key, std::move(resume_state), expiry);
         ++stats.resource_based_evictions;
         return;
     }
@@ -259,7 +267,10 @@ void querier_cache::insert_querier(
         --stats.population;
     });
 
-    auto notify_handler = [&stats, &index, it] (reader_concurrency_semaphore::evict_reason reason) {
+    auto notify_handler = [this, &stats, &index, it, resume_state = std::move(resume_state), expiry] (reader_concurrency_semaphore::evict_reason reason) mutable {
+        if (reason == reader_concurrency_semaphore::evict_reason::permit) {
+            keep_resume_state(it->first, std::move(resume_state), expiry);
+        }
         index.erase(it);
         switch (reason) {
             case reader_concurrency_semaphore::evict_reason::permit:
@@ -313,6 +324,10 @@ std::optional<Querier> querier_cache::lookup_querier(
     ++stats.lookups;
     if (!base_ptr) {
         ++stats.misses;
+        if (_resume_state_index.contains(key)) {
+            tracing::trace(trace_state, "Found resume state of evicted querier for key {}", key);
+            ++stats.resume_state_hits;
+        }
         return std::nullopt;
     }
 
@@ -390,6 +405,76 @@ future<> querier_base::close() noexcept {
     return std::visit(variant_closer{*this}, _reader);
 }
 
+lw_shared_ptr<reader_resume_state> querier_cache::make_resume_state(reader_permit& permit) noexcept {
+    try {
+        auto state = make_lw_shared<reader_resume_state>(max_pins_per_resume_state);
+        permit.set_resume_state(state);
+        return state;
+    } catch (...) {
+        return {};
+    }
+}
+
+void querier_cache::keep_resume_state(utils::UUID key, lw_shared_ptr<reader_resume_state> state, lowres_clock::time_point expiry) noexcept {
+    if (!state) {
+        return;
+    }
+    drop_expired_resume_states();
+    if (_resume_states.size() >= max_resume_states) {
+        erase_resume_state(_resume_states.begin());
+    }
+    // Keep the list ordered by expiry. Queriers are evicted in a different
+    // order than they were inserted in, but all of them have the same TTL,
+    // so the position is usually close to the end.
+    auto pos = _resume_states.end();
+    while (pos != _resume_states.begin() && std::prev(pos)->expiry > expiry) {
+        --pos;
+    }
+    try {
+        auto it = _resume_states.insert(pos, resume_entry{key, expiry, std::move(state)});
+        try {
+            _resume_state_index.emplace(key, it);
+        } catch (...) {
+            _resume_states.erase(it);
+            throw;
+        }
+        ++_stats.resume_states;
+    } catch (...) {
+        // The next page just has to look up the index again.
+    }
+}
+
+void querier_cache::erase_resume_state(resume_list::iterator it) noexcept {
+    auto [begin, end] = _resume_state_index.equal_range(it->key);
+    for (auto i = begin; i != end; ++i) {
+        if (i->second == it) {
+            _resume_state_index.erase(i);
+            break;
+        }
+    }
+    _resume_states.erase(it);
+    --_stats.resume_states;
+}
+
+void querier_cache::drop_resume_states(utils::UUID key) noexcept {
+    auto [begin, end] = _resume_state_index.equal_range(key);
+    if (begin == end) {
+        return;
+    }
+    for (auto i = begin; i != end; ++i) {
+        _resume_states.erase(i->second);
+        --_stats.resume_states;
+    }
+    _resume_state_index.erase(begin, end);
+}
+
+void querier_cache::drop_expired_resume_states() noexcept {
+    const auto now = lowres_clock::now();
+    while (!_resume_states.empty() && _resume_states.front().expiry <= now) {
+        erase_resume_state(_resume_states.begin());
+    }
+}
+
 void querier_cache::set_entry_ttl(std::chrono::seconds entry_ttl) {
     _entry_ttl = entry_ttl;
 }
@@ -416,6 +501,10 @@ future<bool> querier_cache::evict_one() noexcept {
 future<> querier_cache::stop() noexcept {
     co_await _closing_gate.close();
 
+    _resume_state_index.clear();
+    _resume_states.clear();
+    _stats.resume_states = 0;
+
     for (auto* ip : {&_data_querier_index, &_mutation_querier_index, &_shard_mutation_querier_index}) {
         auto& idx = *ip;
         for (auto it = idx.begin(); it != idx.end(); it = idx.erase(it)) {
@@ -17,6 +17,7 @@
 
 #include <boost/intrusive/set.hpp>
 
+#include <list>
 #include <variant>
 
 namespace query {
@@ -263,9 +264,20 @@ class shard_mutation_querier : public querier_base {
 /// Keeps the total memory consumption of cached queriers
 /// below max_queriers_memory_usage by evicting older entries upon inserting
 /// new ones if the the memory consupmtion would go above the limit.
+///
+/// When a querier is evicted to free up resources, the cache keeps a resume
+/// state in its place, see \ref reader_resume_state, which holds the index
+/// pages its sstable readers were at. The readers created by the next page
+/// find those pages cached instead of reading them again. The resume state
+/// costs only the pins, as the pages are part of the index cache, and is
+/// dropped when the next page ends, or when the evicted querier would have
+/// expired.
 class querier_cache {
 public:
     static const std::chrono::seconds default_entry_ttl;
+    // Limits on the resume states kept for evicted queriers.
+    static constexpr size_t max_resume_states = 1024;
+    static constexpr size_t max_pins_per_resume_state = 64;
 
     struct stats {
         // The number of inserts into the cache.
@@ -284,19 +296,41 @@ class querier_cache {
         uint64_t resource_based_evictions = 0;
         // The number of queriers currently in the cache.
         uint64_t population = 0;
+        // The subset of misses for which a resume state of an evicted
+        // querier was found.
+        uint64_t resume_state_hits = 0;
+        // The number of resume states currently kept.
+        uint64_t resume_states = 0;
     };
 
     using index = std::unordered_multimap<utils::UUID, std::unique_ptr<querier_base>>;
 
 private:
+    struct resume_entry {
+        utils::UUID key;
+        lowres_clock::time_point expiry;
+        lw_shared_ptr<reader_resume_state> state;
+    };
+    // Ordered by expiry.
+    using resume_list = std::list<resume_entry>;
+
     index _data_querier_index;
     index _mutation_querier_index;
     index _shard_mutation_querier_index;
+    resume_list _resume_states;
+    std::unordered_multimap<utils::UUID, resume_list::iterator> _resume_state_index;
     std::chrono::seconds _entry_ttl;
     stats _stats;
     gate _closing_gate;
 
 private:
+    // Attaches a resume state to the permit, to be filled if the querier is evicted.
+    static lw_shared_ptr<reader_resume_state> make_resume_state(reader_permit& permit) noexcept;
+    // The state is dropped at expiry at the latest.
+    void keep_resume_state(utils::UUID key, lw_shared_ptr<reader_resume_state> state, lowres_clock::time_point expiry) noexcept;
+    void drop_expired_resume_states() noexcept;
+    void erase_resume_state(resume_list::iterator it) noexcept;
+
     template <typename Querier>
     void insert_querier(
             utils::UUID key,
@@ -377,6 +411,9 @@ class querier_cache {
     /// Applies only to entries inserted after the change.
     void set_entry_ttl(std::chrono::seconds entry_ttl);
 
+    /// Drop the resume states of a read which is over.
+    void drop_resume_states(utils::UUID key) noexcept;
+
     /// Evict a querier.
     ///
     /// Return true if a querier was evicted and false otherwise (if the cache
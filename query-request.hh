@@ -131,6 +131,25 @@ class specific_ranges {
     clustering_row_ranges _ranges;
 };
 
+// Values a component of the partition key must have for a partition to be returned.
+//
+// Set by the coordinator for filtering restrictions on partition key columns, so
+// that replicas skip partitions which would be filtered out without reading their
+// rows. Unlike values of other columns, keys are the same on all replicas, so a
+// replica dropping a partition is indistinguishable from the coordinator doing so.
+struct partition_key_filter {
+    // Index of the component in the partition key.
+    uint32_t component;
+    // If engaged, the values the component may have, otherwise it must lie within `range`.
+    std::optional<std::vector<bytes>> values;
+    nonwrapping_range<bytes> range = nonwrapping_range<bytes>::make_open_ended_both_sides();
+};
+
+// True iff the key satisfies all the filters.
+bool partition_key_matches(const schema& s, const partition_key& key, const std::vector<partition_key_filter>& filters);
+
+std::ostream& operator<<(std::ostream& out, const partition_key_filter& f);
+
 constexpr auto max_rows = std::numeric_limits<uint64_t>::max();
 constexpr auto partition_max_rows = std::numeric_limits<uint64_t>::max();
 constexpr auto max_rows_if_set = std::numeric_limits<uint32_t>::max();
@@ -193,13 +212,15 @@ class partition_slice {
     cql_serialization_format _cql_format;
     uint32_t _partition_row_limit_low_bits;
     uint32_t _partition_row_limit_high_bits;
+    std::vector<partition_key_filter> _partition_key_filters;
 public:
     partition_slice(clustering_row_ranges row_ranges, column_id_vector static_columns,
         column_id_vector regular_columns, option_set options,
         std::unique_ptr<specific_ranges> specific_ranges,
         cql_serialization_format,
         uint32_t partition_row_limit_low_bits,
-        uint32_t partition_row_limit_high_bits);
+        uint32_t partition_row_limit_high_bits,
+        std::vector<partition_key_filter> partition_key_filters = {});
     partition_slice(clustering_row_ranges row_ranges, column_id_vector static_columns,
         column_id_vector regular_columns, option_set options,
         std::unique_ptr<specific_ranges> specific_ranges = nullptr,
@@ -244,6 +265,13 @@ class partition_slice {
         _partition_row_limit_high_bits = static_cast<uint64_t>(limit >> 32);
     }
 
+    const std::vector<partition_key_filter>& partition_key_filters() const {
+        return _partition_key_filters;
+    }
+    void set_partition_key_filters(std::vector<partition_key_filter> filters) {
+        _partition_key_filters = std::move(filters);
+    }
+
     [[nodiscard]]
     bool is_reversed() const {
         return options.contains<query::partition_slice::option::reversed>();
@@ -393,6 +421,10 @@ struct forward_request {
     db::consistency_level cl;
     lowres_clock::time_point timeout;
     std::optional<std::vector<aggregation_info>> aggregation_infos;
+    // When engaged, results are aggregated per group of rows with equal values
+    // of these columns, which are a prefix of the primary key including the
+    // whole partition key.
+    std::optional<std::vector<sstring>> group_by_column_names;
 };
 
 std::ostream& operator<<(std::ostream& out, const forward_request& r);
@@ -402,6 +434,10 @@ std::ostream& operator<<(std::ostream& out, const forward_request::aggregation_i
 struct forward_result {
     // vector storing query result for each selected column
     std::vector<bytes_opt> query_results;
+    // Engaged instead of query_results when the request has GROUP BY columns.
+    // Each group consists of the values of the GROUP BY columns followed by
+    // the results of the reductions, groups are in ring and clustering order.
+    std::optional<std::vector<std::vector<bytes_opt>>> grouped_query_results;
 
     struct printer {
         const std::vector<::shared_ptr<db::functions::aggregate_function>>& functions;
@@ -51,9 +51,48 @@ std::ostream& operator<<(std::ostream& out, const partition_slice& ps) {
     out << ", options=" << format("{:x}", ps.options.mask()); // FIXME: pretty print options
     out << ", cql_format=" << ps.cql_format();
     out << ", partition_row_limit=" << ps.partition_row_limit();
+    if (!ps._partition_key_filters.empty()) {
+        out << ", partition_key_filters=[" << join(", ", ps._partition_key_filters) << "]";
+    }
     return out << "}";
 }
 
+std::ostream& operator<<(std::ostream& out, const partition_key_filter& f) {
+    out << "{component=" << f.component;
+    if (f.values) {
+        out << ", values=[" << join(", ", *f.values) << "]";
+    } else {
+        out << ", range=" << f.range;
+    }
+    return out << "}";
+}
+
+bool partition_key_matches(const schema& s, const partition_key& key, const std::vector<partition_key_filter>& filters) {
+    for (const auto& f : filters) {
+        const auto& type = *s.partition_key_columns()[f.component].type;
+        auto component = key.get_component(s, f.component);
+        if (f.values) {
+            if (std::none_of(f.values->begin(), f.values->end(), [&] (const bytes& v) { return type.equal(component, managed_bytes_view(bytes_view(v))); })) {
+                return false;
+            }
+            continue;
+        }
+        if (const auto& start = f.range.start()) {
+            const auto cmp = type.compare(component, managed_bytes_view(bytes_view(start->value())));
+            if (cmp < 0 || (cmp == 0 && !start->is_inclusive())) {
+                return false;
+            }
+        }
+        if (const auto& end = f.range.end()) {
+            const auto cmp = type.compare(component, managed_bytes_view(bytes_view(end->value())));
+            if (cmp > 0 || (cmp == 0 && !end->is_inclusive())) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 std::ostream& operator<<(std::ostream& out, const read_command& r) {
     return out << "read_command{"
         << "cf_id=" << r.cf_id
@@ -96,6 +135,9 @@ std::ostream& operator<<(std::ostream& out, const forward_request& r) {
     if(r.aggregation_infos) {
         out << ", aggregation_infos=[" << join(",", r.aggregation_infos.value()) << "]";
     }
+    if (r.group_by_column_names) {
+        out << ", group_by_column_names=[" << join(",", r.group_by_column_names.value()) << "]";
+    }
     return out << ", cmd=" << r.cmd
         << ", pr=" << r.pr
         << ", cl=" << r.cl
@@ -207,7 +249,8 @@ partition_slice::partition_slice(clustering_row_ranges row_ranges,
     std::unique_ptr<specific_ranges> specific_ranges,
     cql_serialization_format cql_format,
     uint32_t partition_row_limit_low_bits,
-    uint32_t partition_row_limit_high_bits)
+    uint32_t partition_row_limit_high_bits,
+    std::vector<partition_key_filter> partition_key_filters)
     : _row_ranges(std::move(row_ranges))
     , static_columns(std::move(static_columns))
     , regular_columns(std::move(regular_columns))
@@ -216,6 +259,7 @@ partition_slice::partition_slice(clustering_row_ranges row_ranges,
     , _cql_format(std::move(cql_format))
     , _partition_row_limit_low_bits(partition_row_limit_low_bits)
     , _partition_row_limit_high_bits(partition_row_limit_high_bits)
+    , _partition_key_filters(std::move(partition_key_filters))
 {}
 
 partition_slice::partition_slice(clustering_row_ranges row_ranges,
@@ -259,6 +303,7 @@ partition_slice::partition_slice(const partition_slice& s)
     , _cql_format(s._cql_format)
     , _partition_row_limit_low_bits(s._partition_row_limit_low_bits)
     , _partition_row_limit_high_bits(s._partition_row_limit_high_bits)
+    , _partition_key_filters(s._partition_key_filters)
 {}
 
 partition_slice::~partition_slice()
@@ -424,6 +469,9 @@ foreign_ptr<lw_shared_ptr<query::result>> result_merger::get() {
 }
 
 std::ostream& operator<<(std::ostream& out, const query::forward_result::printer& p) {
+    if (p.res.grouped_query_results) {
+        return out << "[" << p.res.grouped_query_results->size() << " groups]";
+    }
     if (p.functions.size() != p.res.query_results.size()) {
         return out << "[malformed forward_result (" << p.res.query_results.size()
             << " results, " << p.functions.size() << " aggregates)]";
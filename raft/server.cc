@@ -827,22 +827,6 @@ future<> server_impl::io_fiber(index_t last_stable) {
                 }
             }
 
-            if (batch.log_entries.size()) {
-                auto& entries = batch.log_entries;
-
-                if (last_stable >= entries[0]->idx) {
-                    co_await _persistence->truncate_log(entries[0]->idx);
-                    _stats.truncate_persisted_log++;
-                }
-
-                // Combine saving and truncating into one call?
-                // will require persistence to keep track of last idx
-                co_await _persistence->store_log_entries(entries);
-
-                last_stable = (*entries.crbegin())->idx;
-                _stats.persisted_log_entries += entries.size();
-            }
-
             // Update RPC server address mappings. Add servers which are joining
             // the cluster according to the new configuration (obtained from the
             // last_conf_idx).
@@ -859,8 +843,44 @@ future<> server_impl::io_fiber(index_t last_stable) {
                 }
             }
 
-             // After entries are persisted we can send messages.
+            // The leader may send entries to followers while it persists them
+            // itself (Raft thesis, 10.2.1), so the disk write and the round trip
+            // to the followers overlap. This is safe since the entries can only
+            // be committed by a later output, which is handled after this one,
+            // once they are persisted here as well. The term was stored above.
+            // Replies and votes of a follower must wait for persistence.
+            for (auto&& m : batch.messages) {
+                if (!std::holds_alternative<append_request>(m.second)) {
+                    continue;
+                }
+                try {
+                    send_message(m.first, std::move(m.second));
+                } catch(...) {
+                    logger.debug("[{}] io_fiber failed to send a message to {}: {}", _id, m.first, std::current_exception());
+                }
+            }
+
+            if (batch.log_entries.size()) {
+                auto& entries = batch.log_entries;
+
+                if (last_stable >= entries[0]->idx) {
+                    co_await _persistence->truncate_log(entries[0]->idx);
+                    _stats.truncate_persisted_log++;
+                }
+
+                // Combine saving and truncating into one call?
+                // will require persistence to keep track of last idx
+                co_await _persistence->store_log_entries(entries);
+
+                last_stable = (*entries.crbegin())->idx;
+                _stats.persisted_log_entries += entries.size();
+            }
+
+             // After entries are persisted we can send the remaining messages.
             for (auto&& m : batch.messages) {
+                if (std::holds_alternative<append_request>(m.second)) {
+                    continue;
+                }
                 try {
                     send_message(m.first, std::move(m.second));
                 } catch(...) {
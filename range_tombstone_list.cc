@@ -440,13 +440,37 @@ bool range_tombstone_list::equal(const schema& s, const range_tombstone_list& ot
     });
 }
 
+std::optional<range_tombstone_list::range_tombstones_type::iterator>
+range_tombstone_list::find_gap_for(const schema& s, const range_tombstone& rt) {
+    position_in_partition::less_compare less(s);
+    auto next = _tombstones.end();
+    // Tombstones are usually added after all the existing ones, check that first.
+    if (!_tombstones.empty() && !less(std::prev(next)->end_position(), rt.position())) {
+        next = _tombstones.upper_bound(rt.position(), pos_order_by_end{s});
+        if (next != _tombstones.end() && !less(rt.end_position(), next->position())) {
+            return std::nullopt;
+        }
+    }
+    // Adjacent tombstones are left to insert_from(), which merges them if they are equal.
+    if (next != _tombstones.begin() && !less(std::prev(next)->end_position(), rt.position())) {
+        return std::nullopt;
+    }
+    return next;
+}
+
 stop_iteration range_tombstone_list::apply_monotonically(const schema& s, range_tombstone_list&& list, is_preemptible preemptible) {
     auto del = current_deleter<range_tombstone_entry>();
     auto it = list.begin();
     while (it != list.end()) {
-        // FIXME: Optimize by stealing the entry
-        apply_monotonically(s, it->tombstone());
-        it = list._tombstones.erase_and_dispose(it, del);
+        if (auto next = find_gap_for(s, it->tombstone())) {
+            // Doesn't touch any of our tombstones, move the entry over instead of copying it.
+            auto& rt = *it;
+            it = list._tombstones.erase(it);
+            _tombstones.insert_before(*next, rt);
+        } else {
+            apply_monotonically(s, it->tombstone());
+            it = list._tombstones.erase_and_dispose(it, del);
+        }
         if (preemptible && need_preempt()) {
             return stop_iteration::no;
         }
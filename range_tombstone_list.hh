@@ -294,4 +294,8 @@ class range_tombstone_list final {
                      reverter& rev);
 
     range_tombstones_type::iterator find(const schema& s, const range_tombstone_entry& rt);
+
+    // If rt neither overlaps nor is adjacent to any tombstone in the list,
+    // returns the position before which it belongs.
+    std::optional<range_tombstones_type::iterator> find_gap_for(const schema& s, const range_tombstone& rt);
 };
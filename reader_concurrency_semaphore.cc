@@ -82,23 +82,51 @@ class reader_permit::impl
     bool _marked_as_blocked = false;
     db::timeout_clock::time_point _timeout;
     query::max_result_size _max_result_size{query::result_memory_limiter::unlimited_result_size};
+    lw_shared_ptr<reader_resume_state> _resume_state;
+    // Storage of destroyed fragments, linked through the blocks themselves.
+    struct free_block {
+        free_block* next;
+    };
+    free_block* _free_fragment_storage = nullptr;
+    size_t _fragment_storage_size = 0;
+    unsigned _free_fragment_storage_count = 0;
+    // Free blocks are charged to the permit up to the most it ever held, so
+    // that the charge is adjusted only while the free list grows.
+    unsigned _charged_fragment_storage = 0;
+    reader_permit::read_cost _cost;
+    // Whether _cost is tracked, fixed for the lifetime of the permit.
+    const bool _track_cost;
+    // Valid while the permit is used and not blocked, and its cost is tracked.
+    std::chrono::steady_clock::time_point _active_since;
 
 private:
     void on_permit_used() {
         _semaphore.on_permit_used();
         _marked_as_used = true;
+        if (_track_cost) {
+            _active_since = std::chrono::steady_clock::now();
+        }
     }
     void on_permit_unused() {
         _semaphore.on_permit_unused();
         _marked_as_used = false;
+        if (_track_cost && !_marked_as_blocked) {
+            _cost.active_time += std::chrono::steady_clock::now() - _active_since;
+        }
     }
     void on_permit_blocked() {
         _semaphore.on_permit_blocked();
         _marked_as_blocked = true;
+        if (_track_cost) {
+            _cost.active_time += std::chrono::steady_clock::now() - _active_since;
+        }
     }
     void on_permit_unblocked() {
         _semaphore.on_permit_unblocked();
         _marked_as_blocked = false;
+        if (_track_cost && _marked_as_used) {
+            _active_since = std::chrono::steady_clock::now();
+        }
     }
     void on_permit_active() {
         if (_used_branches) {
@@ -125,6 +153,7 @@ class reader_permit::impl
         , _op_name_view(op_name)
         , _base_resources(base_resources)
         , _timeout(timeout)
+        , _track_cost(semaphore.tracks_read_costs())
     {
         _semaphore.on_permit_created(*this);
     }
@@ -135,10 +164,13 @@ class reader_permit::impl
         , _op_name_view(_op_name)
         , _base_resources(base_resources)
         , _timeout(timeout)
+        , _track_cost(semaphore.tracks_read_costs())
     {
         _semaphore.on_permit_created(*this);
     }
     ~impl() {
+        release_fragment_storage();
+
         if (_base_resources_consumed) {
             signal(_base_resources);
         }
@@ -212,6 +244,7 @@ class reader_permit::impl
     void on_evicted() {
         assert(_state == reader_permit::state::inactive);
         _state = reader_permit::state::evicted;
+        release_fragment_storage();
         if (_base_resources_consumed) {
             signal(_base_resources);
             _base_resources_consumed = false;
@@ -326,6 +359,72 @@ class reader_permit::impl
     void set_max_result_size(query::max_result_size s) {
         _max_result_size = std::move(s);
     }
+
+    void set_resume_state(lw_shared_ptr<reader_resume_state> state) noexcept {
+        _resume_state = std::move(state);
+    }
+
+    reader_resume_state* resume_state() const noexcept {
+        return needs_readmission() ? _resume_state.get() : nullptr;
+    }
+
+    bool tracks_cost() const noexcept {
+        return _track_cost;
+    }
+
+    const reader_permit::read_cost& cost() const noexcept {
+        return _cost;
+    }
+
+    void on_disk_read(size_t bytes) noexcept {
+        if (_track_cost) {
+            ++_cost.disk_reads;
+            _cost.disk_bytes_read += bytes;
+        }
+    }
+
+    void on_sstable_read() noexcept {
+        if (_track_cost) {
+            ++_cost.sstables_read;
+        }
+    }
+
+    void* allocate_fragment_storage(size_t size) {
+        if (_free_fragment_storage && size == _fragment_storage_size) {
+            --_free_fragment_storage_count;
+            return std::exchange(_free_fragment_storage, _free_fragment_storage->next);
+        }
+        return ::operator new(size);
+    }
+
+    void free_fragment_storage(void* p, size_t size) noexcept {
+        if (!_fragment_storage_size && size >= sizeof(free_block)) {
+            _fragment_storage_size = size;
+        }
+        if (size != _fragment_storage_size
+                || _free_fragment_storage_count == reader_permit::max_free_fragment_storage
+                || _state == reader_permit::state::evicted) {
+            ::operator delete(p, size);
+            return;
+        }
+        if (_free_fragment_storage_count == _charged_fragment_storage) {
+            consume(reader_resources::with_memory(size));
+            ++_charged_fragment_storage;
+        }
+        _free_fragment_storage = new (p) free_block{_free_fragment_storage};
+        ++_free_fragment_storage_count;
+    }
+
+    void release_fragment_storage() noexcept {
+        while (_free_fragment_storage) {
+            ::operator delete(std::exchange(_free_fragment_storage, _free_fragment_storage->next), _fragment_storage_size);
+        }
+        _free_fragment_storage_count = 0;
+        if (_charged_fragment_storage) {
+            signal(reader_resources::with_memory(_charged_fragment_storage * _fragment_storage_size));
+            _charged_fragment_storage = 0;
+        }
+    }
 };
 
 static_assert(std::is_nothrow_copy_constructible_v<reader_permit>);
@@ -434,6 +533,34 @@ void reader_permit::set_max_result_size(query::max_result_size s) {
     _impl->set_max_result_size(std::move(s));
 }
 
+void reader_permit::set_resume_state(lw_shared_ptr<reader_resume_state> state) noexcept {
+    _impl->set_resume_state(std::move(state));
+}
+
+reader_resume_state* reader_permit::resume_state() const noexcept {
+    return _impl->resume_state();
+}
+
+void* reader_permit::allocate_fragment_storage(size_t size) {
+    return _impl->allocate_fragment_storage(size);
+}
+
+void reader_permit::free_fragment_storage(void* p, size_t size) noexcept {
+    _impl->free_fragment_storage(p, size);
+}
+
+const reader_permit::read_cost& reader_permit::cost() const noexcept {
+    return _impl->cost();
+}
+
+void reader_permit::on_disk_read(size_t bytes) noexcept {
+    _impl->on_disk_read(bytes);
+}
+
+void reader_permit::on_sstable_read() noexcept {
+    _impl->on_sstable_read();
+}
+
 std::ostream& operator<<(std::ostream& os, reader_permit::state s) {
     switch (s) {
         case reader_permit::state::waiting:
@@ -638,6 +765,7 @@ reader_concurrency_semaphore::reader_concurrency_semaphore(int count, ssize_t me
     : _initial_resources(count, memory)
     , _resources(count, memory)
     , _wait_list(expiry_handler(*this))
+    , _cheap_wait_list(expiry_handler(*this))
     , _ready_list(max_queue_length)
     , _name(std::move(name))
     , _max_queue_length(max_queue_length)
@@ -669,9 +797,9 @@ reader_concurrency_semaphore::inactive_read_handle reader_concurrency_semaphore:
     permit_impl.on_register_as_inactive();
     // Implies _inactive_reads.empty(), we don't queue new readers before
     // evicting all inactive reads.
-    // Checking the _wait_list covers the count resources only, so check memory
+    // Checking the wait lists covers the count resources only, so check memory
     // separately.
-    if (_wait_list.empty() && _resources.memory > 0) {
+    if (!waiters() && _resources.memory > 0) {
       try {
         auto irp = std::make_unique<inactive_read>(std::move(reader));
         auto& ir = *irp;
@@ -842,7 +970,7 @@ bool reader_concurrency_semaphore::all_used_permits_are_stalled() const {
 }
 
 std::exception_ptr reader_concurrency_semaphore::check_queue_size(std::string_view queue_name) {
-    if ((_wait_list.size() + _ready_list.size()) >= _max_queue_length) {
+    if ((waiters() + _ready_list.size()) >= _max_queue_length) {
         _stats.total_reads_shed_due_to_overload++;
         maybe_dump_reader_permit_diagnostics(*this, _permit_list, fmt::format("{} queue overload", queue_name));
         return std::make_exception_ptr(std::runtime_error(format("{}: {} queue overload", _name, queue_name)));
@@ -850,15 +978,24 @@ std::exception_ptr reader_concurrency_semaphore::check_queue_size(std::string_vi
     return {};
 }
 
-future<> reader_concurrency_semaphore::enqueue_waiter(reader_permit permit, read_func func) {
+future<> reader_concurrency_semaphore::enqueue_waiter(reader_permit permit, read_func func, read_class cls) {
     if (auto ex = check_queue_size("wait")) {
         return make_exception_future<>(std::move(ex));
     }
     promise<> pr;
     auto fut = pr.get_future();
-    permit.on_waiting();
     auto timeout = permit.timeout();
-    _wait_list.push_back(entry(std::move(pr), std::move(permit), std::move(func)), timeout);
+    auto& wait_list = cls == read_class::cheap ? _cheap_wait_list : _wait_list;
+    // Only reject when there are reads ahead in the queue, so that the
+    // estimate is refreshed by admissions once the overload is gone.
+    const auto estimate = cls == read_class::cheap ? _cheap_queue_time_estimate : _normal_queue_time_estimate;
+    if (_shed_reads_expected_to_time_out() && !wait_list.empty() && timeout != db::no_timeout
+            && db::timeout_clock::now() + std::chrono::duration_cast<db::timeout_clock::duration>(estimate) >= timeout) {
+        ++_stats.total_reads_shed_due_to_timeout;
+        return make_exception_future<>(named_semaphore_timed_out(_name));
+    }
+    permit.on_waiting();
+    wait_list.push_back(entry(std::move(pr), std::move(permit), std::move(func), cls), timeout);
     ++_stats.reads_enqueued;
     return fut;
 }
@@ -867,22 +1004,28 @@ void reader_concurrency_semaphore::evict_readers_in_background() {
     // Evict inactive readers in the background while wait list isn't empty
     // This is safe since stop() closes _gate;
     (void)with_gate(_close_readers_gate, [this] {
-        return do_until([this] { return _wait_list.empty() || _inactive_reads.empty(); }, [this] {
+        return do_until([this] { return !waiters() || _inactive_reads.empty(); }, [this] {
             return detach_inactive_reader(_inactive_reads.front(), evict_reason::permit).close();
         });
     });
  }
 
-future<> reader_concurrency_semaphore::do_wait_admission(reader_permit permit, read_func func) {
+future<> reader_concurrency_semaphore::do_wait_admission(reader_permit permit, read_func func, read_class cls) {
     if (!_execution_loop_future) {
         _execution_loop_future.emplace(execution_loop());
     }
-    if (!_wait_list.empty() || !_ready_list.empty()) {
-        return enqueue_waiter(std::move(permit), std::move(func));
+    // Cheap reads may overtake waiting normal reads, subject to the same
+    // limit as when admitted from the queue.
+    const bool overtakes = cls == read_class::cheap && !_wait_list.empty();
+    if (overtakes ? (!_cheap_wait_list.empty() || _cheap_admitted_in_row >= max_cheap_admissions_in_row) : bool(waiters())) {
+        return enqueue_waiter(std::move(permit), std::move(func), cls);
+    }
+    if (!_ready_list.empty()) {
+        return enqueue_waiter(std::move(permit), std::move(func), cls);
     }
 
     if (!has_available_units(permit.base_resources())) {
-        auto fut = enqueue_waiter(std::move(permit), std::move(func));
+        auto fut = enqueue_waiter(std::move(permit), std::move(func), cls);
         if (!_inactive_reads.empty()) {
             evict_readers_in_background();
         }
@@ -890,20 +1033,48 @@ future<> reader_concurrency_semaphore::do_wait_admission(reader_permit permit, r
     }
 
     if (!all_used_permits_are_stalled()) {
-        return enqueue_waiter(std::move(permit), std::move(func));
+        return enqueue_waiter(std::move(permit), std::move(func), cls);
     }
 
     permit.on_admission();
     ++_stats.reads_admitted;
+    if (overtakes) {
+        ++_cheap_admitted_in_row;
+    }
     if (func) {
         return with_ready_permit(std::move(permit), std::move(func));
     }
     return make_ready_future<>();
 }
 
+reader_concurrency_semaphore::wait_list_type* reader_concurrency_semaphore::next_wait_list() noexcept {
+    if (_cheap_wait_list.empty()) {
+        return _wait_list.empty() ? nullptr : &_wait_list;
+    }
+    if (_wait_list.empty() || _cheap_admitted_in_row < max_cheap_admissions_in_row) {
+        return &_cheap_wait_list;
+    }
+    return &_wait_list;
+}
+
 void reader_concurrency_semaphore::maybe_admit_waiters() noexcept {
-    while (!_wait_list.empty() && _ready_list.empty() && has_available_units(_wait_list.front().permit.base_resources()) && all_used_permits_are_stalled()) {
-        auto& x = _wait_list.front();
+    for (auto* wl = next_wait_list(); wl && _ready_list.empty() && has_available_units(wl->front().permit.base_resources()) && all_used_permits_are_stalled();
+            wl = next_wait_list()) {
+        auto& x = wl->front();
+        auto queue_time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - x.enqueued_at);
+        auto& estimate = x.cls == read_class::cheap ? _cheap_queue_time_estimate : _normal_queue_time_estimate;
+        estimate += (queue_time - estimate) / 8;
+        if (x.cls == read_class::cheap) {
+            ++_stats.cheap_reads_dequeued;
+            _stats.cheap_reads_queue_time_us += queue_time.count();
+            if (!_wait_list.empty()) {
+                ++_cheap_admitted_in_row;
+            }
+        } else {
+            ++_stats.normal_reads_dequeued;
+            _stats.normal_reads_queue_time_us += queue_time.count();
+            _cheap_admitted_in_row = 0;
+        }
         try {
             x.permit.on_admission();
             ++_stats.reads_admitted;
@@ -915,7 +1086,7 @@ void reader_concurrency_semaphore::maybe_admit_waiters() noexcept {
         } catch (...) {
             x.pr.set_exception(std::current_exception());
         }
-        _wait_list.pop_front();
+        wl->pop_front();
     }
 }
 
@@ -930,6 +1101,19 @@ void reader_concurrency_semaphore::on_permit_destroyed(reader_permit::impl& perm
     permit.unlink();
     _permit_gate.leave();
     --_stats.current_permits;
+    if (auto s = permit.get_schema(); s && permit.tracks_cost()) {
+        try {
+            auto [it, inserted] = _table_read_costs.try_emplace(s->id());
+            if (inserted) {
+                it->second.ks_name = s->ks_name();
+                it->second.cf_name = s->cf_name();
+            }
+            ++it->second.reads;
+            it->second.cost += permit.cost();
+        } catch (...) {
+            // The costs are statistics, losing a read's cost is fine.
+        }
+    }
 }
 
 void reader_concurrency_semaphore::on_permit_used() noexcept {
@@ -955,17 +1139,17 @@ void reader_concurrency_semaphore::on_permit_unblocked() noexcept {
 }
 
 future<reader_permit> reader_concurrency_semaphore::obtain_permit(const schema* const schema, const char* const op_name, size_t memory,
-        db::timeout_clock::time_point timeout) {
+        db::timeout_clock::time_point timeout, read_class cls) {
     auto permit = reader_permit(*this, schema, std::string_view(op_name), {1, static_cast<ssize_t>(memory)}, timeout);
-    return do_wait_admission(permit).then([permit] () mutable {
+    return do_wait_admission(permit, {}, cls).then([permit] () mutable {
         return std::move(permit);
     });
 }
 
 future<reader_permit> reader_concurrency_semaphore::obtain_permit(const schema* const schema, sstring&& op_name, size_t memory,
-        db::timeout_clock::time_point timeout) {
+        db::timeout_clock::time_point timeout, read_class cls) {
     auto permit = reader_permit(*this, schema, std::move(op_name), {1, static_cast<ssize_t>(memory)}, timeout);
-    return do_wait_admission(permit).then([permit] () mutable {
+    return do_wait_admission(permit, {}, cls).then([permit] () mutable {
         return std::move(permit);
     });
 }
@@ -979,8 +1163,8 @@ reader_permit reader_concurrency_semaphore::make_tracking_only_permit(const sche
 }
 
 future<> reader_concurrency_semaphore::with_permit(const schema* const schema, const char* const op_name, size_t memory,
-        db::timeout_clock::time_point timeout, read_func func) {
-    return do_wait_admission(reader_permit(*this, schema, std::string_view(op_name), {1, static_cast<ssize_t>(memory)}, timeout), std::move(func));
+        db::timeout_clock::time_point timeout, read_func func, read_class cls) {
+    return do_wait_admission(reader_permit(*this, schema, std::string_view(op_name), {1, static_cast<ssize_t>(memory)}, timeout), std::move(func), cls);
 }
 
 future<> reader_concurrency_semaphore::with_ready_permit(reader_permit permit, read_func func) {
@@ -997,9 +1181,11 @@ void reader_concurrency_semaphore::broken(std::exception_ptr ex) {
     if (!ex) {
         ex = std::make_exception_ptr(broken_semaphore{});
     }
-    while (!_wait_list.empty()) {
-        _wait_list.front().pr.set_exception(ex);
-        _wait_list.pop_front();
+    for (auto* wl : {&_cheap_wait_list, &_wait_list}) {
+        while (!wl->empty()) {
+            wl->front().pr.set_exception(ex);
+            wl->pop_front();
+        }
     }
 }
 
@@ -1036,10 +1222,16 @@ class tracking_file_impl : public file_impl {
     }
 
     virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, const io_priority_class& pc) override {
+        _permit.on_disk_read(len);
         return get_file_impl(_tracked_file)->read_dma(pos, buffer, len, pc);
     }
 
     virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, const io_priority_class& pc) override {
+        size_t len = 0;
+        for (const auto& v : iov) {
+            len += v.iov_len;
+        }
+        _permit.on_disk_read(len);
         return get_file_impl(_tracked_file)->read_dma(pos, iov, pc);
     }
 
@@ -1080,6 +1272,7 @@ class tracking_file_impl : public file_impl {
     }
 
     virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, const io_priority_class& pc) override {
+        _permit.on_disk_read(range_size);
         return get_file_impl(_tracked_file)->dma_read_bulk(offset, range_size, pc).then([this, units = _permit.consume_memory(range_size)] (temporary_buffer<uint8_t> buf) {
             return make_ready_future<temporary_buffer<uint8_t>>(make_tracked_temporary_buffer(std::move(buf), _permit));
         });
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <unordered_map>
 #include <boost/intrusive/list.hpp>
 #include <seastar/core/future.hh>
 #include <seastar/core/gate.hh>
@@ -15,6 +16,8 @@
 #include <seastar/core/expiring_fifo.hh>
 #include "reader_permit.hh"
 #include "readers/flat_mutation_reader_v2.hh"
+#include "utils/UUID.hh"
+#include "utils/updateable_value.hh"
 
 namespace bi = boost::intrusive;
 
@@ -71,6 +74,8 @@ class reader_concurrency_semaphore {
         uint64_t total_failed_reads = 0;
         // Total number of reads rejected because the admission queue reached its max capacity
         uint64_t total_reads_shed_due_to_overload = 0;
+        // Total number of reads rejected on arrival because they were expected to time out in the queue
+        uint64_t total_reads_shed_due_to_timeout = 0;
         // Total number of reads admitted, via all admission paths.
         uint64_t reads_admitted = 0;
         // Total number of reads enqueued to wait for admission.
@@ -83,6 +88,20 @@ class reader_concurrency_semaphore {
         uint64_t used_permits = 0;
         // Current number of blocked permits.
         uint64_t blocked_permits = 0;
+        // Total number of reads of each class admitted after waiting in the queue.
+        uint64_t cheap_reads_dequeued = 0;
+        uint64_t normal_reads_dequeued = 0;
+        // Total time reads of each class spent in the queue before admission, in microseconds.
+        uint64_t cheap_reads_queue_time_us = 0;
+        uint64_t normal_reads_queue_time_us = 0;
+    };
+
+    /// The costs of the reads of a table, summed when their permits are destroyed.
+    struct table_read_cost {
+        sstring ks_name;
+        sstring cf_name;
+        uint64_t reads = 0;
+        reader_permit::read_cost cost;
     };
 
     using permit_list_type = bi::list<
@@ -94,13 +113,26 @@ class reader_concurrency_semaphore {
 
     using read_func = noncopyable_function<future<>(reader_permit)>;
 
+    /// The predicted cost of a read.
+    ///
+    /// Cheap reads wait in a queue of their own, which is admitted from ahead
+    /// of the queue of normal reads, so that a few expensive reads at the head
+    /// of the queue don't hold up many cheap ones. To keep normal reads from
+    /// starving, a normal read is admitted after every
+    /// \ref max_cheap_admissions_in_row cheap reads admitted while it waits.
+    enum class read_class { cheap, normal };
+
+    static constexpr unsigned max_cheap_admissions_in_row = 8;
+
 private:
     struct entry {
         promise<> pr;
         reader_permit permit;
         read_func func;
-        entry(promise<>&& pr, reader_permit permit, read_func func)
-            : pr(std::move(pr)), permit(std::move(permit)), func(std::move(func)) {}
+        read_class cls;
+        std::chrono::steady_clock::time_point enqueued_at;
+        entry(promise<>&& pr, reader_permit permit, read_func func, read_class cls = read_class::normal)
+            : pr(std::move(pr)), permit(std::move(permit)), func(std::move(func)), cls(cls), enqueued_at(std::chrono::steady_clock::now()) {}
     };
 
     class expiry_handler {
@@ -111,6 +143,8 @@ class reader_concurrency_semaphore {
         void operator()(entry& e) noexcept;
     };
 
+    using wait_list_type = expiring_fifo<entry, expiry_handler, db::timeout_clock>;
+
     struct inactive_read : public bi::list_base_hook<bi::link_mode<bi::auto_unlink>> {
         flat_mutation_reader_v2 reader;
         eviction_notify_handler notify_handler;
@@ -173,13 +207,24 @@ class reader_concurrency_semaphore {
     const resources _initial_resources;
     resources _resources;
 
-    expiring_fifo<entry, expiry_handler, db::timeout_clock> _wait_list;
+    wait_list_type _wait_list;
+    wait_list_type _cheap_wait_list;
     queue<entry> _ready_list;
+    // Cheap reads admitted from the queue since a normal read was last admitted.
+    unsigned _cheap_admitted_in_row = 0;
+    // Moving average of the time reads of each class recently spent in the
+    // queue. A read whose timeout is sooner than that is failed right away
+    // instead of being queued, see enqueue_waiter().
+    std::chrono::microseconds _cheap_queue_time_estimate{0};
+    std::chrono::microseconds _normal_queue_time_estimate{0};
+    utils::updateable_value<bool> _shed_reads_expected_to_time_out{true};
+    utils::updateable_value<bool> _track_read_costs{false};
 
     sstring _name;
     size_t _max_queue_length = std::numeric_limits<size_t>::max();
     inactive_reads_type _inactive_reads;
     stats _stats;
+    std::unordered_map<utils::UUID, table_read_cost> _table_read_costs;
     permit_list_type _permit_list;
     bool _stopped = false;
     gate _close_readers_gate;
@@ -199,9 +244,13 @@ class reader_concurrency_semaphore {
 
     // Add the permit to the wait queue and return the future which resolves when
     // the permit is admitted (popped from the queue).
-    future<> enqueue_waiter(reader_permit permit, read_func func);
+    // Fails the permit with a timeout right away if other reads are already
+    // waiting in its queue and it's expected to time out before its turn.
+    future<> enqueue_waiter(reader_permit permit, read_func func, read_class cls);
     void evict_readers_in_background();
-    future<> do_wait_admission(reader_permit permit, read_func func = {});
+    future<> do_wait_admission(reader_permit permit, read_func func = {}, read_class cls = read_class::normal);
+    // The queue to admit the next waiter from, nullptr if there are no waiters.
+    wait_list_type* next_wait_list() noexcept;
     void maybe_admit_waiters() noexcept;
 
     void on_permit_created(reader_permit::impl&);
@@ -330,6 +379,25 @@ class reader_concurrency_semaphore {
         return _stats;
     }
 
+    /// The costs of finished reads, by table id.
+    const std::unordered_map<utils::UUID, table_read_cost>& table_read_costs() const {
+        return _table_read_costs;
+    }
+
+    /// Whether the costs of reads whose permits are created from now on are tracked.
+    void set_track_read_costs(utils::updateable_value<bool> enabled) {
+        _track_read_costs = std::move(enabled);
+    }
+
+    bool tracks_read_costs() const {
+        return _track_read_costs();
+    }
+
+    /// Forget the costs of the reads of a dropped table.
+    void drop_table_read_costs(const utils::UUID& id) noexcept {
+        _table_read_costs.erase(id);
+    }
+
     /// Make an admitted permit
     ///
     /// The permit is already in an admitted state after being created, this
@@ -342,8 +410,12 @@ class reader_concurrency_semaphore {
     ///
     /// Some permits cannot be associated with any table, so passing nullptr as
     /// the schema parameter is allowed.
-    future<reader_permit> obtain_permit(const schema* const schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout);
-    future<reader_permit> obtain_permit(const schema* const schema, sstring&& op_name, size_t memory, db::timeout_clock::time_point timeout);
+    ///
+    /// The read class decides the queue the permit waits in, see \ref read_class.
+    future<reader_permit> obtain_permit(const schema* const schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout,
+            read_class cls = read_class::normal);
+    future<reader_permit> obtain_permit(const schema* const schema, sstring&& op_name, size_t memory, db::timeout_clock::time_point timeout,
+            read_class cls = read_class::normal);
 
     /// Make a tracking only permit
     ///
@@ -380,7 +452,10 @@ class reader_concurrency_semaphore {
     ///
     /// Some permits cannot be associated with any table, so passing nullptr as
     /// the schema parameter is allowed.
-    future<> with_permit(const schema* const schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, read_func func);
+    ///
+    /// The read class decides the queue the permit waits in, see \ref read_class.
+    future<> with_permit(const schema* const schema, const char* const op_name, size_t memory, db::timeout_clock::time_point timeout, read_func func,
+            read_class cls = read_class::normal);
 
     /// Run the function through the semaphore's execution stage with a pre-admitted permit
     ///
@@ -410,7 +485,7 @@ class reader_concurrency_semaphore {
     void signal(const resources& r) noexcept;
 
     size_t waiters() const {
-        return _wait_list.size();
+        return _wait_list.size() + _cheap_wait_list.size();
     }
 
     void broken(std::exception_ptr ex = {});
@@ -424,4 +499,9 @@ class reader_concurrency_semaphore {
     void set_max_queue_length(size_t size) {
         _max_queue_length = size;
     }
+
+    /// Whether reads expected to time out in the queue are failed on arrival, see enqueue_waiter().
+    void set_shed_reads_expected_to_time_out(utils::updateable_value<bool> enabled) {
+        _shed_reads_expected_to_time_out = std::move(enabled);
+    }
 };
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <seastar/core/shared_ptr.hh>
 #include <seastar/util/optimized_optional.hh>
 #include "seastarx.hh"
 
@@ -69,6 +71,42 @@ std::ostream& operator<<(std::ostream& os, const reader_resources& r);
 
 class reader_concurrency_semaphore;
 
+/// State left behind by the readers of an evicted read, which makes it cheaper
+/// to create readers resuming it.
+///
+/// Readers add pins to it when they are closed after the permit was evicted,
+/// if the owner of the read attached one to the permit with
+/// \ref reader_permit::set_resume_state(). A pin keeps something the readers
+/// would otherwise have to look up again, e.g. an index page, in memory.
+class reader_resume_state {
+public:
+    class pin {
+    public:
+        virtual ~pin() = default;
+    };
+private:
+    std::vector<std::unique_ptr<pin>> _pins;
+    size_t _max_pins;
+public:
+    explicit reader_resume_state(size_t max_pins) : _max_pins(max_pins) {}
+
+    // Pins above the limit, or which can't be stored, are dropped.
+    void add(std::unique_ptr<pin> p) noexcept {
+        if (_pins.size() >= _max_pins) {
+            return;
+        }
+        try {
+            _pins.push_back(std::move(p));
+        } catch (...) {
+            // The read is resumed without it.
+        }
+    }
+
+    size_t pins() const noexcept {
+        return _pins.size();
+    }
+};
+
 /// A permit for a specific read.
 ///
 /// Used to track the read's resource consumption. Use `consume_memory()` to
@@ -93,6 +131,27 @@ class reader_permit {
 
     class impl;
 
+    /// What the read cost so far.
+    struct read_cost {
+        // Reads from sstable files, and the bytes they read.
+        uint64_t disk_reads = 0;
+        uint64_t disk_bytes_read = 0;
+        // Number of sstable readers created.
+        uint64_t sstables_read = 0;
+        // Time readers spent filling their buffers, except while waiting for
+        // I/O. This is an estimate of the CPU time of the read, which also
+        // includes the time other tasks ran when the read was preempted.
+        std::chrono::steady_clock::duration active_time{};
+
+        read_cost& operator+=(const read_cost& o) noexcept {
+            disk_reads += o.disk_reads;
+            disk_bytes_read += o.disk_bytes_read;
+            sstables_read += o.sstables_read;
+            active_time += o.active_time;
+            return *this;
+        }
+    };
+
 private:
     shared_ptr<impl> _impl;
 
@@ -161,6 +220,25 @@ class reader_permit {
 
     query::max_result_size max_result_size() const;
     void set_max_result_size(query::max_result_size);
+
+    // The state readers leave behind when closed after the permit is evicted.
+    void set_resume_state(lw_shared_ptr<reader_resume_state> state) noexcept;
+    // Engaged only if the permit was evicted and an owner attached a resume state.
+    reader_resume_state* resume_state() const noexcept;
+
+    const read_cost& cost() const noexcept;
+    void on_disk_read(size_t bytes) noexcept;
+    void on_sstable_read() noexcept;
+
+    // The most blocks of fragment storage kept for reuse by a permit.
+    static constexpr unsigned max_free_fragment_storage = 128;
+
+    // Storage for the fragments of the read. Freed blocks are kept on a free
+    // list of the permit, charged to it, and reused for subsequent fragments,
+    // so that readers don't go to the allocator for each fragment they emit.
+    // The free list is dropped when the permit is evicted.
+    void* allocate_fragment_storage(size_t size);
+    void free_fragment_storage(void* p, size_t size) noexcept;
 };
 
 using reader_permit_opt = optimized_optional<reader_permit>;
@@ -278,6 +278,12 @@ class mutation_reader_merger {
     // Readers and their current fragments, belonging to the current
     // partition.
     merger_vector<reader_and_fragment> _fragment_heap;
+    // Set when the fragment at the top of _fragment_heap was moved into
+    // _current while its reader, now in _next, stays at the top. When the
+    // reader produces its next fragment, it replaces the moved-from one in a
+    // single pass down the heap, instead of a pop followed by a push.
+    // Used only when the top was the only fragment at its position.
+    bool _fragment_heap_top_taken = false;
     merger_vector<reader_and_last_fragment_kind> _next;
     // Readers that reached EOS.
     merger_vector<reader_and_last_fragment_kind> _halted_readers;
@@ -305,6 +311,10 @@ class mutation_reader_merger {
     void maybe_add_readers(const std::optional<dht::ring_position_view>& pos);
     void add_readers(std::vector<flat_mutation_reader_v2> new_readers);
     bool in_gallop_mode() const;
+    // Removes the reader at the top of _fragment_heap, if its fragment was taken.
+    void release_fragment_heap_top();
+    // Puts the fragment produced by the reader where it belongs.
+    needs_merge push_fragment(reader_and_last_fragment_kind rk, mutation_fragment_v2 mf, reader_galloping reader_galloping);
     future<needs_merge> prepare_one(reader_and_last_fragment_kind rk, reader_galloping reader_galloping);
     future<needs_merge> advance_galloping_reader();
     future<> prepare_next();
@@ -423,6 +433,37 @@ bool mutation_reader_merger::in_gallop_mode() const {
     return _gallop_mode_hits >= gallop_mode_entering_threshold;
 }
 
+// Restores the heap property after the element at the top was replaced.
+template <typename Compare>
+static void sift_down_heap_top(merger_vector<mutation_reader_merger::reader_and_fragment>& heap, Compare cmp) {
+    const size_t size = heap.size();
+    size_t i = 0;
+    for (;;) {
+        size_t child = 2 * i + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && cmp(heap[child], heap[child + 1])) {
+            ++child;
+        }
+        if (!cmp(heap[i], heap[child])) {
+            break;
+        }
+        std::swap(heap[i], heap[child]);
+        i = child;
+    }
+}
+
+void mutation_reader_merger::release_fragment_heap_top() {
+    if (!_fragment_heap_top_taken) {
+        return;
+    }
+    // The moved-from fragment is swapped to the back before any comparison.
+    boost::range::pop_heap(_fragment_heap, fragment_heap_compare(*_schema));
+    _fragment_heap.pop_back();
+    _fragment_heap_top_taken = false;
+}
+
 void mutation_reader_merger::maybe_add_readers_at_partition_boundary() {
     // We are either crossing partition boundary or ran out of
     // readers. If there are halted readers then we are just
@@ -437,6 +478,11 @@ void mutation_reader_merger::maybe_add_readers_at_partition_boundary() {
 }
 
 future<mutation_reader_merger::needs_merge> mutation_reader_merger::advance_galloping_reader() {
+    if (!_galloping_reader.reader->is_buffer_empty()) {
+        auto needs_merge = push_fragment(_galloping_reader, _galloping_reader.reader->pop_mutation_fragment(), reader_galloping::yes);
+        maybe_add_readers_at_partition_boundary();
+        return make_ready_future<mutation_reader_merger::needs_merge>(needs_merge);
+    }
     return prepare_one(_galloping_reader, reader_galloping::yes).then([this] (needs_merge needs_merge) {
         maybe_add_readers_at_partition_boundary();
         return needs_merge;
@@ -444,6 +490,24 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::advance_gall
 }
 
 future<> mutation_reader_merger::prepare_next() {
+    // Take fragments from readers which have them buffered right away, only
+    // the readers which have to fill their buffers are waited for.
+    try {
+        auto it = std::remove_if(_next.begin(), _next.end(), [this] (reader_and_last_fragment_kind rk) {
+            if (rk.reader->is_buffer_empty()) {
+                return false;
+            }
+            push_fragment(rk, rk.reader->pop_mutation_fragment(), reader_galloping::no);
+            return true;
+        });
+        _next.erase(it, _next.end());
+    } catch (...) {
+        return current_exception_as_future();
+    }
+    if (_next.empty()) {
+        maybe_add_readers_at_partition_boundary();
+        return make_ready_future<>();
+    }
     return parallel_for_each(_next, [this] (reader_and_last_fragment_kind rk) {
         return prepare_one(rk, reader_galloping::no).discard_result();
     }).then([this] {
@@ -452,29 +516,53 @@ future<> mutation_reader_merger::prepare_next() {
     });
 }
 
+mutation_reader_merger::needs_merge mutation_reader_merger::push_fragment(
+        reader_and_last_fragment_kind rk, mutation_fragment_v2 mf, reader_galloping reader_galloping) {
+    if (mf.is_partition_start()) {
+        release_fragment_heap_top();
+        _reader_heap.emplace_back(rk.reader, std::move(mf));
+        boost::push_heap(_reader_heap, reader_heap_compare(*_schema));
+    } else {
+        if (reader_galloping) {
+            // Optimization: assume that galloping reader will keep winning, and compare directly with the heap front.
+            // If this assumption is correct, we do one key comparison instead of pushing to/popping from the heap.
+            if (_fragment_heap.empty() || position_in_partition::less_compare(*_schema)(mf.position(), _fragment_heap.front().fragment.position())) {
+                _current.clear();
+                _current.emplace_back(std::move(mf), &*_galloping_reader.reader);
+                _galloping_reader.last_kind = _current.back().fragment.mutation_fragment_kind();
+                return needs_merge::no;
+            }
+
+            _gallop_mode_hits = 0;
+        }
+
+        if (_fragment_heap_top_taken) {
+            // Only the reader at the top is in _next while its fragment is taken.
+            _fragment_heap.front().fragment = std::move(mf);
+            _fragment_heap_top_taken = false;
+            sift_down_heap_top(_fragment_heap, fragment_heap_compare(*_schema));
+        } else {
+            _fragment_heap.emplace_back(rk.reader, std::move(mf));
+            boost::range::push_heap(_fragment_heap, fragment_heap_compare(*_schema));
+        }
+    }
+    if (reader_galloping) {
+        _gallop_mode_hits = 0;
+    }
+    return needs_merge::yes;
+}
+
 future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
         reader_and_last_fragment_kind rk, reader_galloping reader_galloping) {
     return (*rk.reader)().then([this, rk, reader_galloping] (mutation_fragment_v2_opt mfo) {
+        if (!mfo) {
+            // The reader is done with the partition, so if its fragment was
+            // taken from the top of the heap, it isn't coming back.
+            release_fragment_heap_top();
+        }
         if (mfo) {
-            if (mfo->is_partition_start()) {
-                _reader_heap.emplace_back(rk.reader, std::move(*mfo));
-                boost::push_heap(_reader_heap, reader_heap_compare(*_schema));
-            } else {
-                if (reader_galloping) {
-                    // Optimization: assume that galloping reader will keep winning, and compare directly with the heap front.
-                    // If this assumption is correct, we do one key comparison instead of pushing to/popping from the heap.
-                    if (_fragment_heap.empty() || position_in_partition::less_compare(*_schema)(mfo->position(), _fragment_heap.front().fragment.position())) {
-                        _current.clear();
-                        _current.emplace_back(std::move(*mfo), &*_galloping_reader.reader);
-                        _galloping_reader.last_kind = _current.back().fragment.mutation_fragment_kind();
-                        return make_ready_future<needs_merge>(needs_merge::no);
-                    }
-
-                    _gallop_mode_hits = 0;
-                }
-
-                _fragment_heap.emplace_back(rk.reader, std::move(*mfo));
-                boost::range::push_heap(_fragment_heap, fragment_heap_compare(*_schema));
+            if (!push_fragment(rk, std::move(*mfo), reader_galloping)) {
+                return make_ready_future<needs_merge>(needs_merge::no);
             }
         } else if (_fwd_sm == streamed_mutation::forwarding::yes && rk.last_kind != mutation_fragment_v2::kind::partition_end) {
             // When in streamed_mutation::forwarding mode we need
@@ -514,6 +602,8 @@ future<mutation_reader_merger::needs_merge> mutation_reader_merger::prepare_one(
 }
 
 void mutation_reader_merger::prepare_forwardable_readers() {
+    // The reader at the top is already in _next.
+    release_fragment_heap_top();
     _next.reserve(_halted_readers.size() + _fragment_heap.size() + _next.size());
 
     std::move(_halted_readers.begin(), _halted_readers.end(), std::back_inserter(_next));
@@ -609,19 +699,34 @@ future<mutation_fragment_batch> mutation_reader_merger::operator()() {
     }
 
     const auto equal = position_in_partition::equal_compare(*_schema);
-    do {
-        boost::range::pop_heap(_fragment_heap, fragment_heap_compare(*_schema));
-        auto& n = _fragment_heap.back();
+    auto cmp = fragment_heap_compare(*_schema);
+    // The second smallest fragment is one of the children of the top.
+    auto runner_up = [&] () -> const reader_and_fragment& {
+        return _fragment_heap.size() == 2 || cmp(_fragment_heap[2], _fragment_heap[1]) ? _fragment_heap[1] : _fragment_heap[2];
+    };
+    if (_fragment_heap.size() == 1 || !equal(_fragment_heap.front().fragment.position(), runner_up().fragment.position())) {
+        auto& n = _fragment_heap.front();
         const auto kind = n.fragment.mutation_fragment_kind();
         _current.emplace_back(std::move(n.fragment), &*n.reader);
         _next.emplace_back(n.reader, kind);
-        _fragment_heap.pop_back();
+        _fragment_heap_top_taken = true;
+    } else {
+        do {
+            boost::range::pop_heap(_fragment_heap, cmp);
+            auto& n = _fragment_heap.back();
+            const auto kind = n.fragment.mutation_fragment_kind();
+            _current.emplace_back(std::move(n.fragment), &*n.reader);
+            _next.emplace_back(n.reader, kind);
+            _fragment_heap.pop_back();
+        }
+        while (!_fragment_heap.empty() && equal(_current.back().fragment.position(), _fragment_heap.front().fragment.position()));
     }
-    while (!_fragment_heap.empty() && equal(_current.back().fragment.position(), _fragment_heap.front().fragment.position()));
 
     if (_next.size() == 1 && _next.front().reader == _galloping_reader.reader) {
         ++_gallop_mode_hits;
         if (in_gallop_mode()) {
+            // The galloping reader is compared with the heap from outside.
+            release_fragment_heap_top();
             _galloping_reader.last_kind = _next.front().last_kind;
             _next.clear();
         }
@@ -659,6 +764,7 @@ future<> mutation_reader_merger::fast_forward_to(const dht::partition_range& pr)
     _next.clear();
     _halted_readers.clear();
     _fragment_heap.clear();
+    _fragment_heap_top_taken = false;
     _reader_heap.clear();
 
     for (auto it = _all_readers.begin(); it != _all_readers.end(); ++it) {
@@ -690,10 +690,21 @@ std::pair<flat_mutation_reader_v2, evictable_reader_handle_v2> make_manually_pau
 
 namespace {
 
+// Reading ahead more than the minimum is only worth it while memory is plentiful.
+bool can_read_ahead_more(reader_permit& permit) {
+    auto& sem = permit.semaphore();
+    return sem.available_resources().memory > sem.initial_resources().memory / 2;
+}
+
 // A special-purpose shard reader.
 //
 // Shard reader manages a reader located on a remote shard. It transparently
 // supports read-ahead (background fill_buffer() calls).
+// Each round trip to the remote shard fills up to `_buffers_per_fill` buffers
+// of the remote reader. The count starts at one and is doubled each time the
+// consumer had to wait for the remote shard, up to `max_buffers_per_fill`.
+// It is halved when buffered fragments are dropped, and when memory on either
+// shard is scarce, only a single buffer is filled.
 // This reader is not for general use, it was designed to serve the
 // multishard_combining_reader.
 // Although it implements the flat_mutation_reader_v2:impl interface it cannot be
@@ -710,9 +721,15 @@ class shard_reader_v2 : public flat_mutation_reader_v2::impl {
     const mutation_reader::forwarding _fwd_mr;
     std::optional<future<>> _read_ahead;
     foreign_ptr<std::unique_ptr<evictable_reader_v2>> _reader;
+    unsigned _buffers_per_fill = 1;
+
+public:
+    static constexpr unsigned max_buffers_per_fill = 8;
 
 private:
     future<> do_fill_buffer();
+    void on_consumer_waited();
+    void on_fragments_dropped();
 
 public:
     shard_reader_v2(
@@ -838,11 +855,14 @@ future<> shard_reader_v2::do_fill_buffer() {
             return std::move(res.result);
         });
     } else {
-        fill_buf_fut = smp::submit_to(_shard, [this] () mutable {
-            reader_permit::used_guard ug{_reader->permit()};
-            return _reader->fill_buffer().then([this, ug = std::move(ug)] {
-                return remote_fill_buffer_result_v2(_reader->detach_buffer(), _reader->is_end_of_stream());
-            });
+        fill_buf_fut = smp::submit_to(_shard, [this, buffers = _buffers_per_fill] () -> future<remote_fill_buffer_result_v2> {
+            auto permit = _reader->permit();
+            reader_permit::used_guard ug{permit};
+            co_await _reader->fill_buffer();
+            for (unsigned i = 1; i < buffers && !_reader->is_end_of_stream() && can_read_ahead_more(permit); ++i) {
+                co_await _reader->fill_buffer();
+            }
+            co_return remote_fill_buffer_result_v2(_reader->detach_buffer(), _reader->is_end_of_stream());
         });
     }
 
@@ -855,16 +875,30 @@ future<> shard_reader_v2::do_fill_buffer() {
     _end_of_stream = res.end_of_stream;
 }
 
+void shard_reader_v2::on_consumer_waited() {
+    if (_reader && _buffers_per_fill < max_buffers_per_fill && can_read_ahead_more(_permit)) {
+        _buffers_per_fill *= 2;
+    }
+}
+
+void shard_reader_v2::on_fragments_dropped() {
+    _buffers_per_fill = std::max(_buffers_per_fill / 2, 1u);
+}
+
 future<> shard_reader_v2::fill_buffer() {
     // FIXME: want to move this to the inner scopes but it makes clang miscompile the code.
     reader_permit::blocked_guard guard(_permit);
     if (_read_ahead) {
+        if (!_read_ahead->available()) {
+            on_consumer_waited();
+        }
         co_await *std::exchange(_read_ahead, std::nullopt);
         co_return;
     }
     if (!is_buffer_empty()) {
         co_return;
     }
+    on_consumer_waited();
     co_await do_fill_buffer();
 }
 
@@ -879,7 +913,11 @@ future<> shard_reader_v2::next_partition() {
     if (_read_ahead) {
         co_await *std::exchange(_read_ahead, std::nullopt);
     }
+    const auto buffered = buffer_size();
     clear_buffer_to_next_partition();
+    if (buffer_size() < buffered) {
+        on_fragments_dropped();
+    }
     if (!is_buffer_empty()) {
         co_return;
     }
@@ -902,6 +940,9 @@ future<> shard_reader_v2::fast_forward_to(const dht::partition_range& pr) {
         co_await *std::exchange(_read_ahead, std::nullopt);
     }
     _end_of_stream = false;
+    if (!is_buffer_empty()) {
+        on_fragments_dropped();
+    }
     clear_buffer();
 
     _pr = co_await smp::submit_to(_shard, [this, &pr] () -> future<foreign_ptr<lw_shared_ptr<const dht::partition_range>>> {
@@ -1033,7 +1074,10 @@ future<> multishard_combining_reader_v2::handle_empty_reader_buffer() {
         // double concurrency so the next time we cross shards we will have
         // more chances of hitting the reader's buffer.
         if (_crossed_shards) {
-            _concurrency = std::min(_concurrency * 2, _sharder.shard_count());
+            // Each read-ahead holds buffers, so stop widening it when memory gets scarce.
+            if (can_read_ahead_more(_permit)) {
+                _concurrency = std::min(_concurrency * 2, _sharder.shard_count());
+            }
 
             // Read ahead shouldn't change the min selection heap so we work on a local copy.
             auto shard_selection_min_heap_copy = _shard_selection_min_heap;
@@ -27,14 +27,20 @@ future<redis_message> command_factory::create_execute(service::storage_proxy& pr
         { "strlen", commands::strlen },
         { "set", commands::set },
         { "setex", commands::setex },
+        { "mget", commands::mget },
+        { "mset", commands::mset },
         { "del", commands::del },
         { "echo", commands::echo },
         { "lolwut", commands::lolwut },
         { "hget", commands::hget },
+        { "hmget", commands::hmget },
         { "hset", commands::hset },
         { "hgetall", commands::hgetall },
         { "hdel", commands::hdel },
         { "hexists", commands::hexists },
+        { "lpush", commands::lpush },
+        { "rpush", commands::rpush },
+        { "lrange", commands::lrange },
     };
     auto&& command = _commands.find(req._command);
     if (command != _commands.end()) {
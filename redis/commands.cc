@@ -19,6 +19,8 @@
 #include "redis/lolwut.hh"
 #include "redis/keyspace_utils.hh"
 
+#include <unordered_map>
+
 namespace redis {
 
 namespace commands {
@@ -29,7 +31,7 @@ future<redis_message> get(service::storage_proxy& proxy, request& req, redis::re
     }
     return redis::read_strings(proxy, options, req._args[0], permit).then([] (auto result) {
         if (result->has_result()) {
-            return redis_message::make_strings_result(std::move(result->result()));
+            return redis_message::make_strings_result(result->result(), result);
         }
         // return nil string if key does not exist
         return redis_message::nil();
@@ -75,7 +77,7 @@ future<redis_message> strlen(service::storage_proxy& proxy, request& req, redis:
     }
     return redis::read_strings(proxy, options, req._args[0], permit).then([] (auto result) {
         if (result->has_result()) {
-            return redis_message::number(result->result().length());
+            return redis_message::number(result->result().size_bytes());
         }
         // return 0 string if key does not exist
         return redis_message::zero();
@@ -87,8 +89,8 @@ future<redis_message> hgetall(service::storage_proxy& proxy, request& req, redis
         throw wrong_number_of_arguments_exception(req._command);
     }
     return redis::read_hashes(proxy, options, req._args[0], permit).then([] (auto result) {
-        if (!result->empty()) {
-            return redis_message::make_list_result(*result);
+        if (!result->_fields.empty()) {
+            return redis_message::make_list_result(result->_fields, result);
         }
         // return nil string if key does not exist
         return redis_message::nil();
@@ -101,14 +103,30 @@ future<redis_message> hget(service::storage_proxy& proxy, request& req, redis::r
     }
     auto field = std::move(req._args[1]);
     return redis::read_hashes(proxy, options, req._args[0], field, permit).then([field] (auto result) {
-        if (!result->empty()) {
-            return redis_message::make_strings_result(std::move(result->at(field)));
+        if (!result->_fields.empty()) {
+            return redis_message::make_strings_result(result->_fields.at(field), result);
         }
         // return nil string if key does not exist
         return redis_message::nil();
     });
 }
 
+future<redis_message> hmget(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 2) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    auto fields = std::vector<bytes>(req._args.begin() + 1, req._args.end());
+    return redis::read_hashes(proxy, options, req._args[0], fields, permit).then([fields = std::move(fields)] (auto result) {
+        std::vector<std::optional<query::result_bytes_view>> values;
+        values.reserve(fields.size());
+        for (auto& field : fields) {
+            auto it = result->_fields.find(field);
+            values.push_back(it == result->_fields.end() ? std::nullopt : std::make_optional(it->second));
+        }
+        return redis_message::make_list_result(values, result);
+    });
+}
+
 future<redis_message> hset(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
     if (req.arguments_size() != 3) {
         throw wrong_number_of_arguments_exception(req._command);
@@ -135,7 +153,83 @@ future<redis_message> hexists(service::storage_proxy& proxy, request& req, redis
         throw wrong_arguments_exception(2, req.arguments_size(), req._command);
     }
     return redis::read_hashes(proxy, options, req._args[0], req._args[1], permit).then([] (auto result) {
-        return redis_message::number(result->empty() ? 0 : 1);
+        return redis_message::number(result->_fields.empty() ? 0 : 1);
+    });
+}
+
+static future<redis_message> push(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit, bool left) {
+    if (req.arguments_size() < 2) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    auto values = std::vector<bytes>(req._args.begin() + 1, req._args.end());
+    bytes key = req._args[0];
+    return redis::write_lists(proxy, options, std::move(req._args[0]), std::move(values), left, permit).then([&proxy, &options, key = std::move(key), permit] () mutable {
+        // The list is read back after the write, so unlike in Redis, the
+        // length may include values pushed concurrently by other clients.
+        return redis::read_list_length(proxy, options, key, std::move(permit)).then([] (uint64_t length) {
+            return redis_message::number(length);
+        });
+    });
+}
+
+future<redis_message> lpush(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    return push(proxy, req, options, std::move(permit), true);
+}
+
+future<redis_message> rpush(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    return push(proxy, req, options, std::move(permit), false);
+}
+
+future<redis_message> lrange(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() != 3) {
+        throw wrong_arguments_exception(3, req.arguments_size(), req._command);
+    }
+    long start, stop;
+    try {
+        start = std::stol(std::string(reinterpret_cast<const char*>(req._args[1].data()), req._args[1].size()));
+        stop = std::stol(std::string(reinterpret_cast<const char*>(req._args[2].data()), req._args[2].size()));
+    } catch (...) {
+        throw invalid_arguments_exception(req._command);
+    }
+    // Negative indexes count from the tail. When both indexes count from
+    // the same end, only the part of the list up to the farther one is read,
+    // from that end. Otherwise the whole list is read.
+    constexpr long max_limit = std::numeric_limits<uint32_t>::max();
+    uint32_t limit = std::numeric_limits<uint32_t>::max();
+    bool reversed = false;
+    if (start >= 0 && stop >= 0) {
+        if (start > stop) {
+            std::vector<bytes> empty;
+            return redis_message::make_list_result(empty);
+        }
+        limit = std::min(stop + 1, max_limit);
+    } else if (start < 0 && stop < 0) {
+        if (start > stop) {
+            std::vector<bytes> empty;
+            return redis_message::make_list_result(empty);
+        }
+        limit = std::min(-start, max_limit);
+        reversed = true;
+    }
+    return redis::read_lists(proxy, options, req._args[0], limit, reversed, permit).then([start, stop, reversed] (auto result) {
+        auto& values = *result;
+        if (reversed) {
+            std::reverse(values.begin(), values.end());
+        }
+        // Translate the indexes to positions in what was read.
+        long size = values.size();
+        long first = start < 0 ? size + start : start;
+        long last = stop < 0 ? size + stop : stop;
+        first = std::max(first, 0L);
+        last = std::min(last, size - 1);
+        std::vector<bytes> range;
+        if (first <= last) {
+            range.reserve(last - first + 1);
+            for (long i = first; i <= last; ++i) {
+                range.push_back(std::move(values[i]));
+            }
+        }
+        return redis_message::make_list_result(range);
     });
 }
 
@@ -162,6 +256,31 @@ future<redis_message> set(service::storage_proxy& proxy, request& req, redis::re
     });
 }
 
+future<redis_message> mget(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() < 1) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    return redis::read_strings(proxy, options, std::move(req._args), permit).then([] (auto result) {
+        return redis_message::make_list_result(result->_values, result);
+    });
+}
+
+future<redis_message> mset(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
+    if (req.arguments_size() == 0 || req.arguments_size() % 2 != 0) {
+        throw wrong_number_of_arguments_exception(req._command);
+    }
+    // The writes of a key share a timestamp, so only the last value of a
+    // key repeated in the command may be written.
+    std::unordered_map<bytes, bytes> last_values;
+    for (size_t i = 0; i < req.arguments_size(); i += 2) {
+        last_values.insert_or_assign(std::move(req._args[i]), std::move(req._args[i + 1]));
+    }
+    std::vector<std::pair<bytes, bytes>> values(std::make_move_iterator(last_values.begin()), std::make_move_iterator(last_values.end()));
+    return redis::write_strings(proxy, options, std::move(values), permit).then([] {
+        return redis_message::ok();
+    });
+}
+
 future<redis_message> setex(service::storage_proxy& proxy, request& req, redis::redis_options& options, service_permit permit) {
     if (req.arguments_size() != 3) {
         throw wrong_arguments_exception(3, req.arguments_size(), req._command);
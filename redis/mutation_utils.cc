@@ -15,6 +15,8 @@
 #include "redis/options.hh"
 #include "mutation.hh"
 #include "service_permit.hh"
+#include "utils/UUID_gen.hh"
+#include <seastar/core/byteorder.hh>
 
 using namespace seastar;
 
@@ -54,6 +56,44 @@ future<> write_hashes(service::storage_proxy& proxy, redis::redis_options& optio
 }
 
 
+// The clustering key of a list element orders it in its list: elements
+// pushed to the head get keys below the keys of all earlier pushes, and
+// elements pushed to the tail keys above them. The key starts with a
+// position derived from the write's timestamp and the element's index in
+// the push, followed by a time UUID which tells apart elements pushed at
+// the same time by different coordinators.
+static bytes list_element_key(api::timestamp_type ts, bool left, size_t index, size_t count) {
+    constexpr uint64_t middle = uint64_t(1) << 63;
+    uint64_t position = left ? middle - 1 - uint64_t(ts) : middle + uint64_t(ts);
+    // The first value pushed to the head ends up last of the pushed ones.
+    uint64_t sequence = left ? count - index : index;
+    auto uuid = utils::UUID_gen::get_time_UUID();
+    bytes key(bytes::initialized_later(), 32);
+    auto p = reinterpret_cast<char*>(key.data());
+    write_be<uint64_t>(p, position);
+    write_be<uint64_t>(p + 8, sequence);
+    write_be<uint64_t>(p + 16, uuid.get_most_significant_bits());
+    write_be<uint64_t>(p + 24, uuid.get_least_significant_bits());
+    return key;
+}
+
+future<> write_lists(service::storage_proxy& proxy, redis::redis_options& options, bytes&& key, std::vector<bytes>&& values, bool left, service_permit permit) {
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
+
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::LISTs);
+    const column_definition& column = *schema->get_column_definition(redis::DATA_COLUMN_NAME);
+    auto pkey = partition_key::from_single_value(*schema, key);
+    auto m = mutation(schema, std::move(pkey));
+    auto ts = api::new_timestamp();
+    for (size_t i = 0; i < values.size(); ++i) {
+        auto ckey = clustering_key::from_single_value(*schema, list_element_key(ts, left, i, values.size()));
+        m.set_clustered_cell(ckey, column, make_cell(schema, *(column.type.get()), values[i]));
+    }
+
+    auto write_consistency_level = options.get_write_consistency_level();
+    return proxy.mutate(std::vector<mutation> {std::move(m)}, write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
+}
+
 mutation make_mutation(service::storage_proxy& proxy, const redis_options& options, bytes&& key, bytes&& data, long ttl) {
     auto schema = get_schema(proxy, options.get_keyspace_name(), redis::STRINGs);
     const column_definition& column = *schema->get_column_definition(redis::DATA_COLUMN_NAME);
@@ -72,6 +112,18 @@ future<> write_strings(service::storage_proxy& proxy, redis::redis_options& opti
 }
 
 
+future<> write_strings(service::storage_proxy& proxy, redis::redis_options& options, std::vector<std::pair<bytes, bytes>>&& values, service_permit permit) {
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_write_timeout();
+    std::vector<mutation> mutations;
+    mutations.reserve(values.size());
+    for (auto& [key, data] : values) {
+        mutations.push_back(make_mutation(proxy, options, std::move(key), std::move(data), 0));
+    }
+    auto write_consistency_level = options.get_write_consistency_level();
+    return proxy.mutate(std::move(mutations), write_consistency_level, timeout, nullptr, permit, db::allow_per_partition_rate_limit::yes);
+}
+
+
 mutation make_tombstone(service::storage_proxy& proxy, const redis_options& options, const sstring& cf_name, const bytes& key) {
     auto schema = get_schema(proxy, options.get_keyspace_name(), cf_name);
     auto pkey = partition_key::from_single_value(*schema, key);
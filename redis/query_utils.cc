@@ -20,6 +20,9 @@
 #include "service_permit.hh"
 #include "redis/keyspace_utils.hh"
 
+#include <unordered_set>
+#include <seastar/core/coroutine.hh>
+
 namespace redis {
 
 class strings_result_builder {
@@ -27,18 +30,14 @@ class strings_result_builder {
     const query::partition_slice& _partition_slice;
     const schema_ptr _schema;
 private:
-    void add_cell(const column_definition& col, const std::optional<query::result_atomic_cell_view>& cell)
+    void add_cell(const std::optional<query::result_atomic_cell_view>& cell)
     {
         if (cell) {
-            cell->value().with_linearized([this, &col, &cell] (bytes_view cell_view) {
-                auto&& dv = col.type->deserialize_value(cell_view);
-                auto&& d = dv.serialize_nonnull();
-                _data->_result = std::move(d);
-                if (cell->expiry().has_value()) {
-                    _data->_ttl = cell->expiry().value() - gc_clock::now();
-                }
-                _data->_has_result = true;
-            });
+            // The data columns are of the text type, whose serialized form is the value.
+            _data->_result = cell->value();
+            if (cell->expiry().has_value()) {
+                _data->_ttl = cell->expiry().value() - gc_clock::now();
+            }
         }
     }
 public:
@@ -53,8 +52,8 @@ class strings_result_builder {
     void accept_new_row(const clustering_key& key, const query::result_row_view& static_row, const query::result_row_view& row)
     {
         auto row_iterator = row.iterator();
-        for (auto&& id : _partition_slice.regular_columns) {
-            add_cell(_schema->regular_column_at(id), row_iterator.next_atomic_cell());
+        for (size_t i = 0; i < _partition_slice.regular_columns.size(); ++i) {
+            add_cell(row_iterator.next_atomic_cell());
         }
     }
     void accept_new_row(const query::result_row_view& static_row, const query::result_row_view& row) {}
@@ -78,32 +77,92 @@ future<lw_shared_ptr<strings_result>> query_strings(service::storage_proxy& prox
     auto read_consistency_level = options.get_read_consistency_level();
     db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_read_timeout();
     return proxy.query(schema, make_lw_shared<query::read_command>(std::move(cmd)), std::move(partition_ranges), read_consistency_level, {timeout, permit, service::client_state::for_internal_calls()}).then([ps, schema] (auto qr) {
-        return query::result_view::do_with(*qr.query_result, [&] (query::result_view v) {
-            auto pd = make_lw_shared<strings_result>();
-            v.consume(ps, strings_result_builder(pd, schema, ps));
-            return pd;
-        });
+        auto pd = make_lw_shared<strings_result>();
+        query::result_view::consume(*qr.query_result, ps, strings_result_builder(pd, schema, ps));
+        pd->_query_result = std::move(qr.query_result);
+        return pd;
+    });
+}
+
+
+// Collects the values of a read of several STRINGs keys, by key.
+class multi_strings_result_builder {
+    std::unordered_map<bytes, query::result_bytes_view>& _data;
+    const query::partition_slice& _partition_slice;
+    const schema_ptr _schema;
+    bytes _current_key;
+public:
+    multi_strings_result_builder(std::unordered_map<bytes, query::result_bytes_view>& data, const schema_ptr schema, const query::partition_slice& ps)
+        : _data(data)
+        , _partition_slice(ps)
+        , _schema(schema)
+    {
+    }
+    void accept_new_partition(const partition_key& key, uint32_t row_count) {
+        _current_key = std::move(key.explode().front());
+    }
+    void accept_new_partition(uint32_t row_count) {}
+    void accept_new_row(const clustering_key& key, const query::result_row_view& static_row, const query::result_row_view& row)
+    {
+        auto row_iterator = row.iterator();
+        for (size_t i = 0; i < _partition_slice.regular_columns.size(); ++i) {
+            auto cell = row_iterator.next_atomic_cell();
+            if (cell) {
+                _data.insert_or_assign(_current_key, cell->value());
+            }
+        }
+    }
+    void accept_new_row(const query::result_row_view& static_row, const query::result_row_view& row) {}
+    void accept_partition_end(const query::result_row_view& static_row) {}
+};
+
+future<lw_shared_ptr<multi_strings_result>> read_strings(service::storage_proxy& proxy, const redis_options& options, std::vector<bytes> keys, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::STRINGs);
+    auto ps = partition_slice_builder(*schema)
+        .with_option<query::partition_slice::option::send_partition_key>()
+        .build();
+    // All the keys are read by a single query, whose partitions are read in parallel
+    // by the coordinator, instead of a query per key.
+    std::unordered_set<bytes> unique_keys(keys.begin(), keys.end());
+    dht::partition_range_vector partition_ranges;
+    partition_ranges.reserve(unique_keys.size());
+    for (auto& key : unique_keys) {
+        auto pkey = partition_key::from_single_value(*schema, key);
+        partition_ranges.emplace_back(dht::partition_range::make_singular(dht::decorate_key(*schema, std::move(pkey))));
+    }
+    const auto max_result_size = proxy.get_max_result_size(ps);
+    const auto limit = uint32_t(partition_ranges.size());
+    query::read_command cmd(schema->id(), schema->version(), ps, limit, gc_clock::now(), std::nullopt, limit, utils::UUID(), query::is_first_page::no, max_result_size, 0);
+    auto read_consistency_level = options.get_read_consistency_level();
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_read_timeout();
+    return proxy.query(schema, make_lw_shared<query::read_command>(std::move(cmd)), std::move(partition_ranges), read_consistency_level, {timeout, permit, service::client_state::for_internal_calls()}).then([ps, schema, keys = std::move(keys)] (auto qr) {
+        std::unordered_map<bytes, query::result_bytes_view> values;
+        query::result_view::consume(*qr.query_result, ps, multi_strings_result_builder(values, schema, ps));
+        auto pd = make_lw_shared<multi_strings_result>();
+        pd->_values.reserve(keys.size());
+        for (auto& key : keys) {
+            auto it = values.find(key);
+            pd->_values.push_back(it == values.end() ? std::nullopt : std::make_optional(it->second));
+        }
+        pd->_query_result = std::move(qr.query_result);
+        return pd;
     });
 }
 
 
 class hashes_result_builder {
-    lw_shared_ptr<std::map<bytes, bytes>> _data;
+    lw_shared_ptr<hashes_result> _data;
     const query::partition_slice& _partition_slice;
     const schema_ptr _schema;
 private:
-    void add_cell(const bytes& ckey, const column_definition& col, const std::optional<query::result_atomic_cell_view>& cell)
+    void add_cell(bytes&& ckey, const std::optional<query::result_atomic_cell_view>& cell)
     {
         if (cell) {
-            cell->value().with_linearized([this, &col, &cell, &ckey] (bytes_view cell_view) {
-                auto&& dv = col.type->deserialize_value(cell_view);
-                auto&& d = dv.serialize_nonnull();
-                _data->emplace(std::move(ckey), std::move(d));
-            });
+            _data->_fields.emplace(std::move(ckey), cell->value());
         }
     }
 public:
-    hashes_result_builder(lw_shared_ptr<std::map<bytes, bytes>> data, const schema_ptr schema, const query::partition_slice& ps)
+    hashes_result_builder(lw_shared_ptr<hashes_result> data, const schema_ptr schema, const query::partition_slice& ps)
         : _data(data)
         , _partition_slice(ps)
         , _schema(schema)
@@ -115,8 +174,8 @@ class hashes_result_builder {
     {
         auto row_iterator = row.iterator();
         for (auto&& v : key.explode()) {
-            for (auto&& id : _partition_slice.regular_columns) {
-                add_cell(std::move(v), _schema->regular_column_at(id), row_iterator.next_atomic_cell());
+            for (size_t i = 0; i < _partition_slice.regular_columns.size(); ++i) {
+                add_cell(std::move(v), row_iterator.next_atomic_cell());
             }
         }
     }
@@ -126,14 +185,14 @@ class hashes_result_builder {
 
 
 
-future<lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit) {
+future<lw_shared_ptr<hashes_result>> read_hashes(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit) {
     auto schema = get_schema(proxy, options.get_keyspace_name(), redis::HASHes);
 
     auto ps = partition_slice_builder(*schema)
         .build();
     return query_hashes(proxy, options, key, permit, schema, ps);
 }
-future<lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy& proxy, const redis_options& options, const bytes& key, const bytes& field, service_permit permit) {
+future<lw_shared_ptr<hashes_result>> read_hashes(service::storage_proxy& proxy, const redis_options& options, const bytes& key, const bytes& field, service_permit permit) {
     auto schema = get_schema(proxy, options.get_keyspace_name(), redis::HASHes);
     auto ckey = clustering_key::from_single_value(*schema, field);
     auto clustering_range = query::clustering_range::make_singular(ckey);
@@ -144,7 +203,20 @@ future<lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy
     return query_hashes(proxy, options, key, permit, schema, ps);
 }
 
-future<lw_shared_ptr<std::map<bytes, bytes>>> query_hashes(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit, schema_ptr schema, query::partition_slice ps) {
+future<lw_shared_ptr<hashes_result>> read_hashes(service::storage_proxy& proxy, const redis_options& options, const bytes& key, const std::vector<bytes>& fields, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::HASHes);
+    std::vector<query::clustering_range> clustering_ranges;
+    for (auto& field : std::set<bytes>(fields.begin(), fields.end())) {
+        clustering_ranges.push_back(query::clustering_range::make_singular(clustering_key::from_single_value(*schema, field)));
+    }
+
+    auto ps = partition_slice_builder(*schema)
+        .with_ranges(std::move(clustering_ranges))
+        .build();
+    return query_hashes(proxy, options, key, permit, schema, ps);
+}
+
+future<lw_shared_ptr<hashes_result>> query_hashes(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit, schema_ptr schema, query::partition_slice ps) {
     const auto max_result_size = proxy.get_max_result_size(ps);
     query::read_command cmd(schema->id(), schema->version(), ps, std::numeric_limits<uint32_t>::max(), gc_clock::now(), std::nullopt, 1, utils::UUID(), query::is_first_page::no, max_result_size, 0);
     auto pkey = partition_key::from_single_value(*schema, key);
@@ -153,13 +225,118 @@ future<lw_shared_ptr<std::map<bytes, bytes>>> query_hashes(service::storage_prox
     partition_ranges.emplace_back(std::move(partition_range));
     auto read_consistency_level = options.get_read_consistency_level();
     db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_read_timeout();
+    return proxy.query(schema, make_lw_shared<query::read_command>(std::move(cmd)), std::move(partition_ranges), read_consistency_level, {timeout, permit, service::client_state::for_internal_calls()}).then([ps, schema] (auto qr) {
+        auto pd = make_lw_shared<hashes_result>();
+        query::result_view::consume(*qr.query_result, ps, hashes_result_builder(pd, schema, ps));
+        pd->_query_result = std::move(qr.query_result);
+        return pd;
+    });
+}
+
+class lists_result_builder {
+    lw_shared_ptr<std::vector<bytes>> _data;
+    const query::partition_slice& _partition_slice;
+    const schema_ptr _schema;
+public:
+    lists_result_builder(lw_shared_ptr<std::vector<bytes>> data, const schema_ptr schema, const query::partition_slice& ps)
+        : _data(data)
+        , _partition_slice(ps)
+        , _schema(schema)
+    {
+    }
+    void accept_new_partition(const partition_key& key, uint32_t row_count) {}
+    void accept_new_partition(uint32_t row_count) {}
+    void accept_new_row(const clustering_key& key, const query::result_row_view& static_row, const query::result_row_view& row)
+    {
+        auto row_iterator = row.iterator();
+        for (auto&& id : _partition_slice.regular_columns) {
+            auto cell = row_iterator.next_atomic_cell();
+            if (cell) {
+                cell->value().with_linearized([this, &col = _schema->regular_column_at(id)] (bytes_view cell_view) {
+                    _data->push_back(col.type->deserialize_value(cell_view).serialize_nonnull());
+                });
+            }
+        }
+    }
+    void accept_new_row(const query::result_row_view& static_row, const query::result_row_view& row) {}
+    void accept_partition_end(const query::result_row_view& static_row) {}
+};
+
+future<lw_shared_ptr<std::vector<bytes>>> read_lists(service::storage_proxy& proxy, const redis_options& options, const bytes& key, uint32_t limit, bool reversed, service_permit permit) {
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::LISTs);
+    auto builder = partition_slice_builder(*schema);
+    if (reversed) {
+        builder.reversed();
+    }
+    auto ps = builder.build();
+    const auto max_result_size = proxy.get_max_result_size(ps);
+    // The row limit makes the read stop after the requested part of the list.
+    query::read_command cmd(schema->id(), schema->version(), ps, limit, gc_clock::now(), std::nullopt, 1, utils::UUID(), query::is_first_page::no, max_result_size, 0);
+    auto pkey = partition_key::from_single_value(*schema, key);
+    auto partition_range = dht::partition_range::make_singular(dht::decorate_key(*schema, std::move(pkey)));
+    dht::partition_range_vector partition_ranges;
+    partition_ranges.emplace_back(std::move(partition_range));
+    auto read_consistency_level = options.get_read_consistency_level();
+    db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_read_timeout();
     return proxy.query(schema, make_lw_shared<query::read_command>(std::move(cmd)), std::move(partition_ranges), read_consistency_level, {timeout, permit, service::client_state::for_internal_calls()}).then([ps, schema] (auto qr) {
         return query::result_view::do_with(*qr.query_result, [&] (query::result_view v) {
-            auto pd = make_lw_shared<std::map<bytes, bytes>>();
-            v.consume(ps, hashes_result_builder(pd, schema, ps));
+            auto pd = make_lw_shared<std::vector<bytes>>();
+            v.consume(ps, lists_result_builder(pd, schema, ps));
             return pd;
         });
     });
 }
 
+// Counts the rows of a list, and remembers the last one, for paging.
+class list_length_builder {
+    uint64_t& _length;
+    std::optional<clustering_key>& _last;
+public:
+    list_length_builder(uint64_t& length, std::optional<clustering_key>& last)
+        : _length(length)
+        , _last(last)
+    {
+    }
+    void accept_new_partition(const partition_key& key, uint32_t row_count) {}
+    void accept_new_partition(uint32_t row_count) {}
+    void accept_new_row(const clustering_key& key, const query::result_row_view& static_row, const query::result_row_view& row)
+    {
+        ++_length;
+        _last = key;
+    }
+    void accept_new_row(const query::result_row_view& static_row, const query::result_row_view& row) {}
+    void accept_partition_end(const query::result_row_view& static_row) {}
+};
+
+future<uint64_t> read_list_length(service::storage_proxy& proxy, const redis_options& options, const bytes& key, service_permit permit) {
+    // Only the keys of the elements are read, a page at a time.
+    constexpr uint32_t page_size = 10000;
+    auto schema = get_schema(proxy, options.get_keyspace_name(), redis::LISTs);
+    auto pkey = partition_key::from_single_value(*schema, key);
+    auto dk = dht::decorate_key(*schema, std::move(pkey));
+    uint64_t length = 0;
+    std::optional<clustering_key> last;
+    while (true) {
+        auto builder = partition_slice_builder(*schema);
+        builder.with_no_regular_columns();
+        if (last) {
+            builder.with_range(query::clustering_range::make_starting_with({*last, false}));
+        }
+        auto ps = builder.build();
+        const auto max_result_size = proxy.get_max_result_size(ps);
+        query::read_command cmd(schema->id(), schema->version(), ps, page_size, gc_clock::now(), std::nullopt, 1, utils::UUID(), query::is_first_page(!last), max_result_size, 0);
+        dht::partition_range_vector partition_ranges;
+        partition_ranges.emplace_back(dht::partition_range::make_singular(dk));
+        auto read_consistency_level = options.get_read_consistency_level();
+        db::timeout_clock::time_point timeout = db::timeout_clock::now() + options.get_read_timeout();
+        auto qr = co_await proxy.query(schema, make_lw_shared<query::read_command>(std::move(cmd)), std::move(partition_ranges), read_consistency_level, {timeout, permit, service::client_state::for_internal_calls()});
+        auto page_length = length;
+        query::result_view::consume(*qr.query_result, ps, list_length_builder(length, last));
+        page_length = length - page_length;
+        if (page_length == 0 || (page_length < page_size && !qr.query_result->is_short_read())) {
+            co_return length;
+        }
+    }
+}
+
 }
@@ -13,6 +13,7 @@
 #include "bytes.hh"
 #include "gc_clock.hh"
 #include "query-request.hh"
+#include "query-result-reader.hh"
 
 namespace service {
 class storage_proxy;
@@ -25,21 +26,46 @@ namespace redis {
 
 class redis_options;
 
+// The values of the results below reference the buffers of the query result
+// they were read from, which the result keeps, so that replies can be made of
+// them without copying them.
+
 struct strings_result {
-    bytes _result;
-    bool _has_result;
+    foreign_ptr<lw_shared_ptr<query::result>> _query_result;
+    std::optional<query::result_bytes_view> _result;
     ttl_opt _ttl;
-    bytes& result() { return _result; }
-    bool has_result() const { return _has_result; }
+    const query::result_bytes_view& result() const { return *_result; }
+    bool has_result() const { return _result.has_value(); }
     gc_clock::duration ttl() { return _ttl.value(); }
     bool has_ttl() { return _ttl.has_value(); }
 };
 
+struct multi_strings_result {
+    foreign_ptr<lw_shared_ptr<query::result>> _query_result;
+    // In the order of the keys, disengaged for a key which does not exist.
+    std::vector<std::optional<query::result_bytes_view>> _values;
+};
+
+struct hashes_result {
+    foreign_ptr<lw_shared_ptr<query::result>> _query_result;
+    std::map<bytes, query::result_bytes_view> _fields;
+};
+
 seastar::future<seastar::lw_shared_ptr<strings_result>> read_strings(service::storage_proxy&, const redis_options&, const bytes&, service_permit);
+// Reads the values of several keys.
+seastar::future<seastar::lw_shared_ptr<multi_strings_result>> read_strings(service::storage_proxy&, const redis_options&, std::vector<bytes>, service_permit);
 seastar::future<seastar::lw_shared_ptr<strings_result>> query_strings(service::storage_proxy&, const redis_options&, const bytes&, service_permit, schema_ptr, query::partition_slice);
 
-seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, service_permit);
-seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, const bytes&, service_permit);
-seastar::future<seastar::lw_shared_ptr<std::map<bytes, bytes>>> query_hashes(service::storage_proxy&, const redis_options&, const bytes&, service_permit, schema_ptr, query::partition_slice);
+seastar::future<seastar::lw_shared_ptr<hashes_result>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, service_permit);
+seastar::future<seastar::lw_shared_ptr<hashes_result>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, const bytes&, service_permit);
+// Reads the given fields of the hash.
+seastar::future<seastar::lw_shared_ptr<hashes_result>> read_hashes(service::storage_proxy&, const redis_options&, const bytes&, const std::vector<bytes>&, service_permit);
+// Reads up to limit values of the list, from its head, or from its tail if
+// reversed (in which case they are returned from the tail).
+seastar::future<seastar::lw_shared_ptr<std::vector<bytes>>> read_lists(service::storage_proxy&, const redis_options&, const bytes&, uint32_t limit, bool reversed, service_permit);
+// Reads the number of values in the list.
+seastar::future<uint64_t> read_list_length(service::storage_proxy&, const redis_options&, const bytes&, service_permit);
+
+seastar::future<seastar::lw_shared_ptr<hashes_result>> query_hashes(service::storage_proxy&, const redis_options&, const bytes&, service_permit, schema_ptr, query::partition_slice);
 
 }
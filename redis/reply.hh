@@ -15,6 +15,7 @@
 #include <seastar/core/scattered_message.hh>
 #include "redis/exceptions.hh"
 #include "utils/fmt-compat.hh"
+#include "utils/fragment_range.hh"
 
 namespace redis {
 
@@ -63,11 +64,55 @@ class redis_message final {
         auto m = make_lw_shared<scattered_message<char>> ();
         m->append(fmt::format("*{}\r\n", list_result.size() * 2));
         for (auto r : list_result) {
-            write_bytes(m, (bytes&)r.first);
+            write_bytes(m, r.first);
             write_bytes(m, r.second);
         }
         return make_ready_future<redis_message>(m);
     }
+    static seastar::future<redis_message> make_list_result(std::vector<bytes>& list_result) {
+        auto m = make_lw_shared<scattered_message<char>> ();
+        m->append(fmt::format("*{}\r\n", list_result.size()));
+        for (auto& r : list_result) {
+            write_bytes(m, r);
+        }
+        return make_ready_future<redis_message>(m);
+    }
+    // The replies below reference the fragments of the values instead of
+    // copying them, so the owner of the fragments is kept by the reply until
+    // it is sent.
+    template <FragmentRange Range, typename Owner>
+    static seastar::future<redis_message> make_strings_result(const Range& result, Owner owner) {
+        auto m = make_lw_shared<scattered_message<char>> ();
+        write_fragments(m, result);
+        m->on_delete([owner = std::move(owner)] {});
+        return make_ready_future<redis_message>(m);
+    }
+    template <FragmentRange Range, typename Owner>
+    static seastar::future<redis_message> make_list_result(const std::map<bytes, Range>& list_result, Owner owner) {
+        auto m = make_lw_shared<scattered_message<char>> ();
+        m->append(fmt::format("*{}\r\n", list_result.size() * 2));
+        for (auto& [key, value] : list_result) {
+            write_bytes(m, key);
+            write_fragments(m, value);
+        }
+        m->on_delete([owner = std::move(owner)] {});
+        return make_ready_future<redis_message>(m);
+    }
+    // Writes nil for the disengaged values.
+    template <FragmentRange Range, typename Owner>
+    static seastar::future<redis_message> make_list_result(const std::vector<std::optional<Range>>& list_result, Owner owner) {
+        auto m = make_lw_shared<scattered_message<char>> ();
+        m->append(fmt::format("*{}\r\n", list_result.size()));
+        for (auto& r : list_result) {
+            if (r) {
+                write_fragments(m, *r);
+            } else {
+                m->append_static("$-1\r\n");
+            }
+        }
+        m->on_delete([owner = std::move(owner)] {});
+        return make_ready_future<redis_message>(m);
+    }
     static seastar::future<redis_message> make_strings_result(bytes result) {
         auto m = make_lw_shared<scattered_message<char>> ();
         write_bytes(m, result);
@@ -102,11 +147,19 @@ class redis_message final {
     static sstring to_sstring(const bytes& b) {
         return sstring(reinterpret_cast<const char*>(b.data()), b.size());
     }
-    static void write_bytes(lw_shared_ptr<scattered_message<char>> m, bytes& b) {
+    static void write_bytes(lw_shared_ptr<scattered_message<char>> m, const bytes& b) {
         m->append(fmt::format("${}\r\n", b.size()));
         m->append(std::string_view(reinterpret_cast<const char*>(b.data()), b.size()));
         m->append_static("\r\n");
     }   
+    template <FragmentRange Range>
+    static void write_fragments(lw_shared_ptr<scattered_message<char>> m, const Range& r) {
+        m->append(fmt::format("${}\r\n", r.size_bytes()));
+        for (bytes_view fragment : r) {
+            m->append_static(reinterpret_cast<const char*>(fragment.data()), fragment.size());
+        }
+        m->append_static("\r\n");
+    }
 };
 
 }
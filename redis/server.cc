@@ -19,6 +19,7 @@
 #include "service/query_state.hh"
 
 #include <seastar/core/future-util.hh>
+#include <seastar/core/when_all.hh>
 #include <seastar/core/seastar.hh>
 #include <seastar/net/byteorder.hh>
 #include <seastar/core/execution_stage.hh>
@@ -27,6 +28,7 @@
 #include <cassert>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace redis_transport {
 
@@ -78,8 +80,79 @@ redis_server::connection::~connection() {
 
 thread_local redis_server::connection::execution_stage_type redis_server::connection::_process_request_stage {"redis_transport", &connection::process_request_one};
 
-future<redis_server::result> redis_server::connection::process_request_internal() {
-    return _process_request_stage(this, _parser.get_request(), seastar::ref(_options), empty_service_permit());
+// The keys which a request reads or writes, used to order it after the running
+// requests which use them. Disengaged for a request which has to run alone.
+static std::optional<std::vector<bytes>> request_keys(const redis::request& req) {
+    static thread_local const std::unordered_set<bytes> all_keys_commands = {
+        "del", "exists", "mget",
+    };
+    static thread_local const std::unordered_set<bytes> first_key_commands = {
+        "get", "ttl", "strlen", "set", "setex", "hget", "hmget", "hset", "hgetall", "hdel", "hexists", "lpush", "rpush", "lrange",
+    };
+    static thread_local const std::unordered_set<bytes> keyless_commands = {
+        "ping", "echo", "lolwut",
+    };
+    if (all_keys_commands.contains(req._command)) {
+        return req._args;
+    }
+    if (first_key_commands.contains(req._command)) {
+        if (req._args.empty()) {
+            return std::vector<bytes>();
+        }
+        return std::vector<bytes>{req._args[0]};
+    }
+    if (keyless_commands.contains(req._command)) {
+        return std::vector<bytes>();
+    }
+    if (req._command == "mset") {
+        std::vector<bytes> keys;
+        for (size_t i = 0; i < req._args.size(); i += 2) {
+            keys.push_back(req._args[i]);
+        }
+        return keys;
+    }
+    return std::nullopt;
+}
+
+future<redis_server::result> redis_server::connection::process_request_internal(redis::request&& request) {
+    auto keys = request_keys(request);
+    auto id = _next_request_id++;
+    auto done = make_lw_shared<shared_promise<>>();
+    std::vector<future<>> waits;
+    if (!keys) {
+        for (auto& [_, f] : _running) {
+            waits.push_back(f.get_future());
+        }
+        _barrier.emplace(id, done->get_shared_future());
+    } else {
+        if (_barrier) {
+            waits.push_back(_barrier->second.get_future());
+        }
+        for (auto& key : *keys) {
+            auto [it, inserted] = _running_keys.try_emplace(key, id, done->get_shared_future());
+            if (!inserted && it->second.first != id) {
+                waits.push_back(it->second.second.get_future());
+                it->second = {id, done->get_shared_future()};
+            }
+        }
+    }
+    _running.emplace(id, done->get_shared_future());
+    return when_all(waits.begin(), waits.end()).discard_result().then([this, request = std::move(request)] () mutable {
+        return _process_request_stage(this, std::move(request), seastar::ref(_options), empty_service_permit());
+    }).finally([this, id, keys = std::move(keys), done] {
+        done->set_value();
+        _running.erase(id);
+        if (keys) {
+            for (auto& key : *keys) {
+                auto it = _running_keys.find(key);
+                if (it != _running_keys.end() && it->second.first == id) {
+                    _running_keys.erase(it);
+                }
+            }
+        } else if (_barrier && _barrier->first == id) {
+            _barrier.reset();
+        }
+    });
 }
 
 void redis_server::connection::write_reply(const redis_exception& e)
@@ -104,33 +177,61 @@ void redis_server::connection::write_reply(redis_server::result result)
     });
 }
 
+// Writes the reply of a request, or its error.
+future<> redis_server::connection::write_result(future<result>&& f) {
+    return f.then_wrapped([this] (future<result> f) {
+        sstring error;
+        try {
+            auto m = f.get0().make_message();
+            return _write_buf.write(std::move(*m)).then([this] {
+                return _write_buf.flush();
+            });
+        } catch (redis_exception& e) {
+            error = e.what_message();
+        } catch (std::exception& e) {
+            error = e.what();
+        } catch (...) {
+            error = "Unknown exception";
+        }
+        return redis_message::exception(error).then([this] (auto&& result) {
+            auto m = result.message();
+            return _write_buf.write(std::move(*m)).then([this] {
+                return _write_buf.flush();
+            });
+        });
+    });
+}
+
 future<> redis_server::connection::process_request() {
     _parser.init();
     return _read_buf.consume(_parser).then([this] {
         if (_parser.eof()) {
             return make_ready_future<>();
         }
-        ++_server._stats._requests_serving;
-        _pending_requests_gate.enter();
-        utils::latency_counter lc;
-        lc.start();
-        auto leave = defer([this] () noexcept { _pending_requests_gate.leave(); });
-        return process_request_internal().then([this, leave = std::move(leave), lc = std::move(lc)] (auto&& result) mutable {
-            --_server._stats._requests_serving;
-            try {
-                if (_parser.failed()) {
-                    logging.error("request parse failed");
-                    const auto e = redis_exception("unknown command ''");
-                    write_reply(std::move(e));
-                }else{
-                    write_reply(std::move(result));
-                }
+        if (_parser.failed()) {
+            logging.error("request parse failed");
+            write_reply(redis_exception("unknown command ''"));
+            return make_ready_future<>();
+        }
+        // Wait for a free slot, but don't wait for the request itself, so that
+        // the next requests of a pipeline are read and executed meanwhile.
+        return get_units(_concurrent_requests, 1).then([this] (semaphore_units<> units) {
+            ++_server._stats._requests_serving;
+            _pending_requests_gate.enter();
+            utils::latency_counter lc;
+            lc.start();
+            auto leave = defer([this] () noexcept { _pending_requests_gate.leave(); });
+            auto f = process_request_internal(std::move(_parser.get_request())).finally([this, leave = std::move(leave), lc = std::move(lc)] () mutable {
+                --_server._stats._requests_serving;
                 ++_server._stats._requests_served;
                 _server._stats._requests.mark(lc.stop().latency());
                 _server._stats._estimated_requests_latency.add(lc.latency(), _server._stats._requests.hist.count);
-            } catch (...) {
-                logging.error("request processing failed: {}", std::current_exception());
-            }
+            });
+            // Replies are written in the order of the requests. The slot is kept
+            // until the reply is written, which bounds the replies kept in memory.
+            _ready_to_respond = _ready_to_respond.then([this, f = std::move(f), units = std::move(units)] () mutable {
+                return write_result(std::move(f)).finally([units = std::move(units)] {});
+            });
         });
     });
 }
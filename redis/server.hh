@@ -29,9 +29,12 @@
 #include <seastar/core/semaphore.hh>
 #include <seastar/core/sharded.hh>
 #include <seastar/core/execution_stage.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/net/tls.hh>
 
 #include <memory>
+#include <optional>
+#include <unordered_map>
 
 db::consistency_level make_consistency_level(const sstring&);
 
@@ -89,6 +92,20 @@ class redis_server : public generic_server::server {
                 service_permit
         >;
         static thread_local execution_stage_type _process_request_stage;
+
+        // Requests of a pipeline are executed concurrently, up to this many at a time,
+        // and their replies are written in the order of the requests.
+        static constexpr size_t max_concurrent_requests = 64;
+        semaphore _concurrent_requests{max_concurrent_requests};
+        // A request waits for the running requests which use one of its keys,
+        // and for the running barrier, i.e. a request which has to run alone
+        // (like SELECT, which changes the database of the following requests).
+        // Each is resolved when its request completes, and is only removed by
+        // its own request.
+        uint64_t _next_request_id = 0;
+        std::unordered_map<uint64_t, shared_future<>> _running;
+        std::unordered_map<bytes, std::pair<uint64_t, shared_future<>>> _running_keys;
+        std::optional<std::pair<uint64_t, shared_future<>>> _barrier;
     public:
         connection(redis_server& server, socket_address server_addr, connected_socket&& fd, socket_address addr);
         virtual ~connection();
@@ -99,7 +116,8 @@ class redis_server : public generic_server::server {
     private:
         const ::timeout_config& timeout_config() { return _server.timeout_config(); }
         future<result> process_request_one(redis::request&& request, redis::redis_options&, service_permit permit);
-        future<result> process_request_internal();
+        future<result> process_request_internal(redis::request&& request);
+        future<> write_result(future<result>&& f);
     };
 
     virtual shared_ptr<generic_server::connection> make_connection(socket_address server_addr, connected_socket&& fd, socket_address addr) override;
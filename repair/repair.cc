@@ -77,6 +77,10 @@ node_ops_metrics::node_ops_metrics(tracker& tracker)
         sm::make_gauge("finished_percentage", [this] { return repair_finished_percentage(); },
                 sm::description("Finished percentage of node operation on this shard"), {ops_label_type("repair")}),
     });
+    _metrics.add_group("repair", {
+        sm::make_gauge("range_parallelism", [this] { return _tracker.range_parallelism(); },
+                sm::description("Holds the number of ranges that can be repaired in parallel on this shard.")),
+    });
 }
 
 float node_ops_metrics::bootstrap_finished_percentage() {
@@ -118,6 +122,8 @@ std::ostream& operator<<(std::ostream& out, row_level_diff_detect_algorithm algo
         return out << "send_full_set";
     case row_level_diff_detect_algorithm::send_full_set_rpc_stream:
         return out << "send_full_set_rpc_stream";
+    case row_level_diff_detect_algorithm::send_bucketed_set_rpc_stream:
+        return out << "send_bucketed_set_rpc_stream";
     };
     return out << "unknown";
 }
@@ -322,8 +328,9 @@ tracker::tracker(size_t max_repair_memory)
     : _shutdown(false)
     , _range_parallelism_semaphore(std::max(size_t(1), size_t(max_repair_memory / max_repair_memory_per_range() / 4)),
             named_semaphore_exception_factory{"repair range parallelism"})
+    , _max_range_parallelism(_range_parallelism_semaphore.available_units())
 {
-    auto nr = _range_parallelism_semaphore.available_units();
+    auto nr = _max_range_parallelism;
     rlogger.info("Setting max_repair_memory={}, max_repair_memory_per_range={}, max_repair_ranges_in_parallel={}",
         max_repair_memory, max_repair_memory_per_range(), nr);
 }
@@ -472,6 +479,17 @@ named_semaphore& tracker::range_parallelism_semaphore() {
     return _range_parallelism_semaphore;
 }
 
+void tracker::set_range_parallelism(size_t nr) {
+    nr = std::clamp(nr, size_t(1), _max_range_parallelism);
+    auto withheld = _max_range_parallelism - nr;
+    if (withheld > _withheld_range_parallelism) {
+        _range_parallelism_semaphore.consume(withheld - _withheld_range_parallelism);
+    } else if (withheld < _withheld_range_parallelism) {
+        _range_parallelism_semaphore.signal(_withheld_range_parallelism - withheld);
+    }
+    _withheld_range_parallelism = withheld;
+}
+
 future<> tracker::run(repair_uniq_id id, std::function<void ()> func) {
     return seastar::with_gate(_gate, [this, id, func =std::move(func)] {
         start(id);
@@ -507,6 +525,17 @@ future<uint64_t> estimate_partitions(seastar::sharded<replica::database>& db, co
     );
 }
 
+future<bool> may_have_tombstones(seastar::sharded<replica::database>& db, const sstring& keyspace,
+        const sstring& cf, const dht::token_range& range) {
+    return db.map_reduce0(
+        [keyspace, cf, range] (auto& db) {
+            return db.find_column_family(keyspace, cf).may_have_tombstones(range);
+        },
+        false,
+        std::logical_or<bool>()
+    );
+}
+
 static
 const dht::sharder&
 get_sharder_for_tables(seastar::sharded<replica::database>& db, const sstring& keyspace, const std::vector<utils::UUID>& table_ids) {
@@ -780,6 +809,10 @@ struct repair_options {
     // The node starting the repair must be in the data center; Issuing a
     // repair to a data center other than the named one returns an error.
     std::vector<sstring> data_centers;
+    // If tombstone_ranges_only is true, ranges in which none of the replicas
+    // holds tombstones are not synced, only recorded in the repair history,
+    // which is what tombstone_gc=repair needs to purge tombstones later.
+    bool tombstone_ranges_only = false;
 
     repair_options(std::unordered_map<sstring, sstring> options) {
         bool_opt(primary_range, options, PRIMARY_RANGE_KEY);
@@ -788,6 +821,7 @@ struct repair_options {
         list_opt(hosts, options, HOSTS_KEY);
         list_opt(ignore_nodes, options, IGNORE_NODES_KEY);
         list_opt(data_centers, options, DATACENTERS_KEY);
+        bool_opt(tombstone_ranges_only, options, TOMBSTONE_RANGES_ONLY_KEY);
         // We currently do not support incremental repair. We could probably
         // ignore this option as it is just an optimization, but for now,
         // let's make it an error.
@@ -833,6 +867,7 @@ struct repair_options {
     static constexpr const char* DATACENTERS_KEY = "dataCenters";
     static constexpr const char* HOSTS_KEY = "hosts";
     static constexpr const char* IGNORE_NODES_KEY = "ignore_nodes";
+    static constexpr const char* TOMBSTONE_RANGES_ONLY_KEY = "tombstone_ranges_only";
     static constexpr const char* TRACE_KEY = "trace";
     static constexpr const char* START_TOKEN = "startToken";
     static constexpr const char* END_TOKEN = "endToken";
@@ -1196,11 +1231,13 @@ int repair_service::do_repair_start(sstring keyspace, std::unordered_map<sstring
 
         for (auto shard : boost::irange(unsigned(0), smp::count)) {
             auto f = container().invoke_on(shard, [keyspace, table_ids, id, ranges, hints_batchlog_flushed,
-                    data_centers = options.data_centers, hosts = options.hosts, ignore_nodes] (repair_service& local_repair) mutable {
+                    data_centers = options.data_centers, hosts = options.hosts, ignore_nodes,
+                    tombstone_ranges_only = options.tombstone_ranges_only] (repair_service& local_repair) mutable {
                 local_repair.get_metrics().repair_total_ranges_sum += ranges.size();
                 auto ri = make_lw_shared<repair_info>(local_repair,
                         std::move(keyspace), std::move(ranges), std::move(table_ids),
                         id, std::move(data_centers), std::move(hosts), std::move(ignore_nodes), streaming::stream_reason::repair, id.uuid, hints_batchlog_flushed);
+                ri->tombstone_ranges_only = tombstone_ranges_only;
                 return repair_ranges(ri);
             });
             repair_results.push_back(std::move(f));
@@ -169,6 +169,8 @@ class repair_info {
     std::unordered_set<sstring> dropped_tables;
     std::optional<utils::UUID> _ops_uuid;
     bool _hints_batchlog_flushed = false;
+    // Set by the tombstone_ranges_only repair option.
+    bool tombstone_ranges_only = false;
 public:
     repair_info(repair_service& repair,
             const sstring& keyspace_,
@@ -233,6 +235,10 @@ class tracker {
     // The semaphore used to control the maximum
     // ranges that can be repaired in parallel.
     named_semaphore _range_parallelism_semaphore;
+    // The units _range_parallelism_semaphore was created with.
+    size_t _max_range_parallelism;
+    // Units taken out of _range_parallelism_semaphore to lower the parallelism.
+    size_t _withheld_range_parallelism = 0;
     static constexpr size_t _max_repair_memory_per_range = 32 * 1024 * 1024;
     seastar::condition_variable _done_cond;
     void start(repair_uniq_id id);
@@ -250,6 +256,12 @@ class tracker {
     size_t nr_running_repair_jobs();
     void abort_all_repairs();
     named_semaphore& range_parallelism_semaphore();
+    size_t max_range_parallelism() const noexcept { return _max_range_parallelism; }
+    size_t range_parallelism() const noexcept { return _max_range_parallelism - _withheld_range_parallelism; }
+    // Sets the number of ranges that can be repaired in parallel, clamped to
+    // [1, max_range_parallelism()]. Ranges already being repaired are not
+    // affected, lowering the parallelism only holds back new ones.
+    void set_range_parallelism(size_t nr);
     static size_t max_repair_memory_per_range() { return _max_repair_memory_per_range; }
     future<> run(repair_uniq_id id, std::function<void ()> func);
     future<repair_status> repair_await_completion(int id, std::chrono::steady_clock::time_point timeout);
@@ -261,6 +273,10 @@ class tracker {
 future<uint64_t> estimate_partitions(seastar::sharded<replica::database>& db, const sstring& keyspace,
         const sstring& cf, const dht::token_range& range);
 
+// Returns false if no shard holds tombstones or expiring cells of the table in the range.
+future<bool> may_have_tombstones(seastar::sharded<replica::database>& db, const sstring& keyspace,
+        const sstring& cf, const dht::token_range& range);
+
 
 enum class repair_row_level_start_status: uint8_t {
     ok,
@@ -340,6 +356,9 @@ struct repair_row_on_wire_with_cmd {
 enum class row_level_diff_detect_algorithm : uint8_t {
     send_full_set,
     send_full_set_rpc_stream,
+    // Like send_full_set_rpc_stream, but only hashes of rows in buckets whose
+    // combined hashes differ are sent, see REPAIR_GET_FULL_ROW_HASHES.
+    send_bucketed_set_rpc_stream,
 };
 
 std::ostream& operator<<(std::ostream& out, row_level_diff_detect_algorithm algo);
@@ -25,6 +25,7 @@
 #include <seastar/core/metrics_registration.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
+#include <seastar/coroutine/maybe_yield.hh>
 #include <list>
 #include <vector>
 #include <algorithm>
@@ -42,6 +43,7 @@
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/all.hh>
 #include "db/system_keyspace.hh"
+#include "db/config.hh"
 #include "service/storage_proxy.hh"
 #include "db/batchlog_manager.hh"
 #include "idl/position_in_partition.dist.hh"
@@ -204,6 +206,7 @@ static const std::vector<row_level_diff_detect_algorithm>& suportted_diff_detect
     static std::vector<row_level_diff_detect_algorithm> _algorithms = {
         row_level_diff_detect_algorithm::send_full_set,
         row_level_diff_detect_algorithm::send_full_set_rpc_stream,
+        row_level_diff_detect_algorithm::send_bucketed_set_rpc_stream,
     };
     return _algorithms;
 };
@@ -774,6 +777,9 @@ class repair_meta {
     bool use_rpc_stream() const {
         return is_rpc_stream_supported(_algo);
     }
+    bool use_bucketed_row_hashes() const {
+        return _algo == row_level_diff_detect_algorithm::send_bucketed_set_rpc_stream;
+    }
 
 public:
     repair_meta(
@@ -976,6 +982,16 @@ class repair_meta {
       });
     }
 
+    // Whether this node may hold tombstones in the part of the range the master's shard repairs.
+    future<bool> may_have_tombstones_in_range() {
+        return with_gate(_gate, [this] {
+            if (_repair_master || _same_sharding_config) {
+                return make_ready_future<bool>(_cf.may_have_tombstones(_range));
+            }
+            return may_have_tombstones(_db, _schema->ks_name(), _schema->cf_name(), _range);
+        });
+    }
+
     future<> set_estimated_partitions(uint64_t estimated_partitions) {
         return with_gate(_gate, [this, estimated_partitions] {
             _estimated_partitions = estimated_partitions;
@@ -1334,6 +1350,27 @@ class repair_meta {
         });
     };
 
+    // Rows are spread over buckets by their hashes, so that the rows of two
+    // nodes can be compared bucket by bucket. Buckets hold about
+    // rows_per_row_hash_bucket of the master's rows.
+    static constexpr size_t rows_per_row_hash_bucket = 16;
+    static constexpr size_t max_row_hash_buckets = 4096;
+
+    static size_t row_hash_bucket(const repair_hash& h, size_t nr_buckets) {
+        return h.hash % nr_buckets;
+    }
+
+    // The combined hashes of the rows in _working_row_buf in each of nr_buckets buckets
+    future<std::vector<repair_hash>>
+    working_row_bucket_hashes(size_t nr_buckets) {
+        std::vector<repair_hash> bucket_hashes(nr_buckets);
+        for (auto& r : _working_row_buf) {
+            bucket_hashes[row_hash_bucket(r.hash(), nr_buckets)].add(r.hash());
+            co_await coroutine::maybe_yield();
+        }
+        co_return bucket_hashes;
+    }
+
 public:
     // RPC API
     // Return the hashes of the rows in _working_row_buf
@@ -1343,7 +1380,7 @@ class repair_meta {
             return get_full_row_hashes_handler();
         }
         return _messaging.send_repair_get_full_row_hashes(msg_addr(remote_node),
-                _repair_meta_id).then([this, remote_node] (repair_hash_set hashes) {
+                _repair_meta_id, {}).then_unpack([this, remote_node] (repair_hash_set hashes, rpc::optional<std::vector<uint32_t>>) {
             rlogger.debug("Got full hashes from peer={}, nr_hashes={}", remote_node, hashes.size());
             _metrics.rx_hashes_nr += hashes.size();
             stats().rx_hashes_nr += hashes.size();
@@ -1352,6 +1389,42 @@ class repair_meta {
         });
     }
 
+    // RPC API
+    // Return the hashes of the rows in the peer's _working_row_buf, like
+    // get_full_row_hashes(), but only transfer the hashes of the rows in
+    // buckets whose combined hashes differ from the local ones. The rows
+    // of the other buckets are the same on both nodes, so their hashes
+    // are taken from the local _working_row_buf.
+    future<repair_hash_set>
+    get_full_row_hashes_in_differing_buckets(gms::inet_address remote_node) {
+        auto nr_buckets = std::clamp(_working_row_buf.size() / rows_per_row_hash_bucket, size_t(1), max_row_hash_buckets);
+        auto bucket_hashes = co_await working_row_bucket_hashes(nr_buckets);
+        auto res = co_await _messaging.send_repair_get_full_row_hashes(msg_addr(remote_node),
+                _repair_meta_id, std::move(bucket_hashes));
+        auto& hashes = std::get<0>(res);
+        auto& differing_buckets = std::get<1>(res);
+        stats().rpc_call_nr++;
+        _metrics.rx_hashes_nr += hashes.size();
+        stats().rx_hashes_nr += hashes.size();
+        rlogger.debug("Got hashes from peer={}, nr_hashes={}, nr_buckets={}, nr_differing_buckets={}", remote_node, hashes.size(),
+                nr_buckets, differing_buckets ? differing_buckets->size() : nr_buckets);
+        if (!differing_buckets) {
+            // The peer sent all its hashes
+            co_return std::move(hashes);
+        }
+        std::vector<bool> differs(nr_buckets);
+        for (auto b : *differing_buckets) {
+            differs.at(b) = true;
+        }
+        for (auto& r : _working_row_buf) {
+            if (!differs[row_hash_bucket(r.hash(), nr_buckets)]) {
+                hashes.insert(r.hash());
+            }
+            co_await coroutine::maybe_yield();
+        }
+        co_return std::move(hashes);
+    }
+
 private:
     future<> get_full_row_hashes_source_op(
             lw_shared_ptr<repair_hash_set> current_hashes,
@@ -1419,6 +1492,32 @@ class repair_meta {
         });
     }
 
+    // RPC handler
+    // Return the hashes of the rows in buckets whose combined hashes differ
+    // from bucket_hashes, the master's, and those buckets.
+    future<std::tuple<repair_hash_set, std::vector<uint32_t>>>
+    get_full_row_hashes_in_differing_buckets_handler(std::vector<repair_hash> bucket_hashes) {
+        auto gate_holder = _gate.hold();
+        auto nr_buckets = bucket_hashes.size();
+        auto local_bucket_hashes = co_await working_row_bucket_hashes(nr_buckets);
+        std::vector<uint32_t> differing_buckets;
+        std::vector<bool> differs(nr_buckets);
+        for (size_t b = 0; b < nr_buckets; ++b) {
+            if (local_bucket_hashes[b] != bucket_hashes[b]) {
+                differing_buckets.push_back(b);
+                differs[b] = true;
+            }
+        }
+        repair_hash_set hashes;
+        for (auto& r : _working_row_buf) {
+            if (differs[row_hash_bucket(r.hash(), nr_buckets)]) {
+                hashes.insert(r.hash());
+            }
+            co_await coroutine::maybe_yield();
+        }
+        co_return std::make_tuple(std::move(hashes), std::move(differing_buckets));
+    }
+
     // RPC API
     // Return the combined hashes of the current working row buf
     future<get_combined_row_hash_response>
@@ -1509,23 +1608,27 @@ class repair_meta {
     }
 
     // RPC API
-    future<uint64_t> repair_get_estimated_partitions(gms::inet_address remote_node) {
+    // Return the estimated partitions of the node and whether it may hold tombstones in the range
+    future<std::pair<uint64_t, bool>> repair_get_estimated_partitions(gms::inet_address remote_node) {
         if (remote_node == _myip) {
-            return get_estimated_partitions();
+            auto partitions = co_await get_estimated_partitions();
+            co_return std::pair(partitions, co_await may_have_tombstones_in_range());
         }
         stats().rpc_call_nr++;
-        return _messaging.send_repair_get_estimated_partitions(msg_addr(remote_node), _repair_meta_id);
+        auto [partitions, tombstones] = co_await _messaging.send_repair_get_estimated_partitions(msg_addr(remote_node), _repair_meta_id);
+        // Older nodes don't tell, assume they hold tombstones.
+        co_return std::pair(partitions, tombstones.value_or(true));
     }
 
 
     // RPC handler
-    static future<uint64_t> repair_get_estimated_partitions_handler(repair_service& rs, gms::inet_address from, uint32_t repair_meta_id) {
+    static future<rpc::tuple<uint64_t, bool>> repair_get_estimated_partitions_handler(repair_service& rs, gms::inet_address from, uint32_t repair_meta_id) {
         auto rm = rs.get_repair_meta(from, repair_meta_id);
         rm->set_repair_state_for_local_node(repair_state::get_estimated_partitions_started);
-        return rm->get_estimated_partitions().then([rm] (uint64_t partitions) {
-            rm->set_repair_state_for_local_node(repair_state::get_estimated_partitions_finished);
-            return partitions;
-        });
+        auto partitions = co_await rm->get_estimated_partitions();
+        auto tombstones = co_await rm->may_have_tombstones_in_range();
+        rm->set_repair_state_for_local_node(repair_state::get_estimated_partitions_finished);
+        co_return rpc::tuple(partitions, tombstones);
     }
 
     // RPC API
@@ -2183,16 +2286,27 @@ future<> repair_service::init_ms_handlers() {
         });
         return make_ready_future<rpc::sink<repair_hash_with_cmd>>(sink);
     });
-    ms.register_repair_get_full_row_hashes([this] (const rpc::client_info& cinfo, uint32_t repair_meta_id) {
+    ms.register_repair_get_full_row_hashes([this] (const rpc::client_info& cinfo, uint32_t repair_meta_id,
+            rpc::optional<std::vector<repair_hash>> bucket_hashes_opt) {
         auto src_cpu_id = cinfo.retrieve_auxiliary<uint32_t>("src_cpu_id");
         auto from = cinfo.retrieve_auxiliary<gms::inet_address>("baddr");
-        return container().invoke_on(src_cpu_id % smp::count, [from, repair_meta_id] (repair_service& local_repair) {
+        auto bucket_hashes = bucket_hashes_opt.value_or(std::vector<repair_hash>());
+        return container().invoke_on(src_cpu_id % smp::count, [from, repair_meta_id,
+                bucket_hashes = std::move(bucket_hashes)] (repair_service& local_repair) mutable {
             auto rm = local_repair.get_repair_meta(from, repair_meta_id);
             rm->set_repair_state_for_local_node(repair_state::get_full_row_hashes_started);
-            return rm->get_full_row_hashes_handler().then([rm] (repair_hash_set hashes) {
+            if (bucket_hashes.empty()) {
+                return rm->get_full_row_hashes_handler().then([rm] (repair_hash_set hashes) {
+                    rm->set_repair_state_for_local_node(repair_state::get_full_row_hashes_finished);
+                    _metrics.tx_hashes_nr += hashes.size();
+                    return rpc::tuple(std::move(hashes), std::vector<uint32_t>());
+                });
+            }
+            return rm->get_full_row_hashes_in_differing_buckets_handler(std::move(bucket_hashes)).then_unpack([rm] (repair_hash_set hashes,
+                    std::vector<uint32_t> differing_buckets) {
                 rm->set_repair_state_for_local_node(repair_state::get_full_row_hashes_finished);
                 _metrics.tx_hashes_nr += hashes.size();
-                return hashes;
+                return rpc::tuple(std::move(hashes), std::move(differing_buckets));
             });
         }) ;
     });
@@ -2406,6 +2520,9 @@ class row_level_repair {
     // Sum of estimated_partitions on all peers
     uint64_t _estimated_partitions = 0;
 
+    // Set if any of the peers may hold tombstones in the range
+    bool _may_have_tombstones = false;
+
     // A flag indicates any error during the repair
     bool _failed = false;
 
@@ -2601,7 +2718,11 @@ class row_level_repair {
             rlogger.debug("Before master.get_full_row_hashes for node {}, hash_sets={}",
                 node, master.peer_row_hash_sets(node_idx).size());
             // Ask the peer to send the full list hashes in the working row buf.
-            if (master.use_rpc_stream()) {
+            if (master.use_bucketed_row_hashes()) {
+                ns.state = repair_state::get_full_row_hashes_started;
+                master.peer_row_hash_sets(node_idx) = master.get_full_row_hashes_in_differing_buckets(node).get0();
+                ns.state = repair_state::get_full_row_hashes_finished;
+            } else if (master.use_rpc_stream()) {
                 ns.state = repair_state::get_full_row_hashes_with_rpc_stream_started;
                 master.peer_row_hash_sets(node_idx) = master.get_full_row_hashes_with_rpc_stream(node, node_idx).get0();
                 ns.state = repair_state::get_full_row_hashes_with_rpc_stream_finished;
@@ -2778,10 +2899,12 @@ class row_level_repair {
                         ns.state = repair_state::row_level_start_finished;
                         nodes_to_stop.push_back(node);
                         ns.state = repair_state::get_estimated_partitions_started;
-                        return master.repair_get_estimated_partitions(node).then([this, node, &ns] (uint64_t partitions) {
+                        return master.repair_get_estimated_partitions(node).then([this, node, &ns] (std::pair<uint64_t, bool> res) {
+                            auto [partitions, tombstones] = res;
                             ns.state = repair_state::get_estimated_partitions_finished;
-                            rlogger.trace("Get repair_get_estimated_partitions for node={}, estimated_partitions={}", node, partitions);
+                            rlogger.trace("Get repair_get_estimated_partitions for node={}, estimated_partitions={}, may_have_tombstones={}", node, partitions, tombstones);
                             _estimated_partitions += partitions;
+                            _may_have_tombstones |= tombstones;
                         });
                     });
                 }).get();
@@ -2795,18 +2918,25 @@ class row_level_repair {
                     });
                 }).get();
 
-                while (true) {
-                    auto status = negotiate_sync_boundary(master);
-                    if (status == op_status::next_round) {
-                        continue;
-                    } else if (status == op_status::all_done) {
-                        break;
-                    }
-                    status = get_missing_rows_from_follower_nodes(master);
-                    if (status == op_status::next_round) {
-                        continue;
+                if (_ri.tombstone_ranges_only && !_may_have_tombstones) {
+                    // Nothing in the range can be purged, so it needs no syncing for
+                    // tombstone_gc=repair, only the repair history update below.
+                    rlogger.debug("repair[{}]: Skipped to sync keyspace={}, cf={}, range={}, no replica holds tombstones",
+                            _ri.id.uuid, _ri.keyspace, _cf_name, _range);
+                } else {
+                    while (true) {
+                        auto status = negotiate_sync_boundary(master);
+                        if (status == op_status::next_round) {
+                            continue;
+                        } else if (status == op_status::all_done) {
+                            break;
+                        }
+                        status = get_missing_rows_from_follower_nodes(master);
+                        if (status == op_status::next_round) {
+                            continue;
+                        }
+                        send_missing_rows_to_follower_nodes(master);
                     }
-                    send_missing_rows_to_follower_nodes(master);
                 }
             } catch (replica::no_such_column_family& e) {
                 table_dropped = true;
@@ -2933,6 +3063,7 @@ repair_service::repair_service(distributed<gms::gossiper>& gossiper,
     , _node_ops_metrics(_tracker)
     , _max_repair_memory(max_repair_memory)
     , _memory_sem(max_repair_memory)
+    , _range_parallelism_timer([this] { adjust_range_parallelism(); })
 {
     if (this_shard_id() == 0) {
         _gossip_helper = make_shared<row_level_repair_gossip_helper>(*this);
@@ -2943,9 +3074,11 @@ repair_service::repair_service(distributed<gms::gossiper>& gossiper,
 future<> repair_service::start() {
     co_await load_history();
     co_await init_ms_handlers();
+    _range_parallelism_timer.arm_periodic(range_parallelism_adjust_interval);
 }
 
 future<> repair_service::stop() {
+    _range_parallelism_timer.cancel();
     co_await uninit_ms_handlers();
     if (this_shard_id() == 0) {
         co_await _gossiper.local().unregister_(_gossip_helper);
@@ -2957,6 +3090,38 @@ repair_service::~repair_service() {
     assert(_stopped);
 }
 
+// Repair competes with compaction and user reads for the same disk and CPU.
+// The parallelism is halved while compaction falls behind, i.e. its backlog is
+// past the point where the compaction controller gives it the most shares, or
+// while reads breach their objectives. It's raised by one range per interval
+// once both recover, up to the limit given by the repair memory.
+void repair_service::adjust_range_parallelism() {
+    auto& db = _db.local();
+    auto current = _tracker.range_parallelism();
+    if (!db.get_config().repair_adaptive_parallelism()) {
+        _tracker.set_range_parallelism(_tracker.max_range_parallelism());
+        return;
+    }
+    auto& cm = db.get_compaction_manager();
+    auto memory = cm.available_memory();
+    float backlog = memory ? cm.backlog() / memory : 0.0f;
+    if (compaction_controller::backlog_disabled(backlog)) {
+        backlog = 0.0f;
+    }
+    auto read_pressure = cm.read_pressure();
+    auto nr = current;
+    if (read_pressure > 1.0f || backlog > compaction_controller::normalization_factor) {
+        nr /= 2;
+    } else if (read_pressure < compaction_controller::read_pressure_headroom && backlog < compaction_controller::normalization_factor / 2) {
+        nr += 1;
+    }
+    _tracker.set_range_parallelism(nr);
+    if (_tracker.range_parallelism() != current) {
+        rlogger.debug("Setting repair range parallelism from {} to {}, read_pressure={}, compaction_backlog={}",
+                current, _tracker.range_parallelism(), read_pressure, backlog);
+    }
+}
+
 static shard_id repair_id_to_shard(utils::UUID& repair_id) {
     return shard_id(repair_id.get_most_significant_bits()) % smp::count;
 }
@@ -12,6 +12,8 @@
 #include "gms/inet_address.hh"
 #include "repair/repair.hh"
 #include <seastar/core/distributed.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/timer.hh>
 #include <seastar/util/bool_class.hh>
 
 using namespace seastar;
@@ -103,6 +105,11 @@ class repair_service : public seastar::peering_sharded_service<repair_service> {
     size_t _max_repair_memory;
     seastar::semaphore _memory_sem;
 
+    // Adjusts the number of ranges repaired in parallel when repair_adaptive_parallelism is set.
+    static constexpr std::chrono::seconds range_parallelism_adjust_interval{10};
+    timer<lowres_clock> _range_parallelism_timer;
+    void adjust_range_parallelism();
+
     future<> init_ms_handlers();
     future<> uninit_ms_handlers();
 
@@ -18,6 +18,7 @@
 #include "to_string.hh"
 #include "cql3/functions/functions.hh"
 #include "cql3/functions/user_function.hh"
+#include "cql3/select_result_cache.hh"
 #include <seastar/core/seastar.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
@@ -54,6 +55,7 @@
 #include "db/timeout_clock.hh"
 #include "db/large_data_handler.hh"
 #include "db/data_listeners.hh"
+#include "replica/hot_partitions.hh"
 
 #include "data_dictionary/user_types_metadata.hh"
 #include <seastar/core/shared_ptr_incomplete.hh>
@@ -347,6 +349,16 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     , _apply_stage("db_apply", &database::do_apply)
     , _version(empty_version)
     , _compaction_manager(cm)
+    , _write_throttle(write_throttle::config{
+            .soft_limit = _dirty_memory_manager.soft_limit_threshold(),
+            .hard_limit = _dirty_memory_manager.throttle_threshold(),
+            .horizon_in_ms = cfg.write_throttle_horizon_in_ms,
+        }, 100ms,
+        [this] { return _dirty_memory_manager.virtual_dirty_memory(); },
+        [this] () -> float {
+            auto memory = _compaction_manager.available_memory();
+            return memory ? _compaction_manager.backlog() / memory : 0.0f;
+        })
     , _enable_incremental_backups(cfg.incremental_backups())
     , _large_data_handler(std::make_unique<db::cql_table_large_data_handler>(_cfg.compaction_large_partition_warning_threshold_mb()*1024*1024,
               _cfg.compaction_large_row_warning_threshold_mb()*1024*1024,
@@ -357,6 +369,10 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     , _system_sstables_manager(std::make_unique<sstables::sstables_manager>(*_nop_large_data_handler, _cfg, feat, _row_cache_tracker))
     , _result_memory_limiter(dbcfg.available_memory / 10)
     , _data_listeners(std::make_unique<db::data_listeners>())
+    , _hot_partitions(std::make_unique<hot_partition_replicator>(*this, hot_partition_replicator::config{
+            .read_threshold = cfg.hot_partition_copies_threshold(),
+        }))
+    , _hot_partition_tracker(std::make_unique<db::hot_partition_tracker>(*this, _cfg.compaction_large_cell_warning_threshold_mb()*1024*1024))
     , _mnotifier(mn)
     , _feat(feat)
     , _shared_token_metadata(stm)
@@ -371,7 +387,17 @@ database::database(const db::config& cfg, database_config dbcfg, service::migrat
     local_schema_registry().init(*this); // TODO: we're never unbound.
     setup_metrics();
 
+    for (auto* sem : {&_read_concurrency_sem, &_streaming_concurrency_sem, &_compaction_concurrency_sem, &_system_read_concurrency_sem}) {
+        sem->set_shed_reads_expected_to_time_out(_cfg.shed_reads_expected_to_time_out);
+        sem->set_track_read_costs(_cfg.track_read_costs);
+    }
+
     _row_cache_tracker.set_compaction_scheduling_group(dbcfg.memory_compaction_scheduling_group);
+    _row_cache_tracker.absent_partitions().set_capacity(_cfg.cache_absent_partitions());
+    if (_cfg.cache_frequency_admission()) {
+        // Sized for a cache filled with rows of about 1KiB, capped at 2MiB of counters.
+        _row_cache_tracker.get_lru().enable_frequency_admission(std::min<size_t>(dbcfg.available_memory / 1024, size_t(1) << 22));
+    }
 
     setup_scylla_memory_diagnostics_producer();
     if (_dbcfg.sstables_format) {
@@ -446,6 +472,55 @@ void backlog_controller::update_controller(float shares) {
     _inflight_update = _scheduling_group.io.update_shares(uint32_t(shares));
 }
 
+void compaction_controller::update_read_throttle(float pressure) noexcept {
+    if (pressure > 1.0f) {
+        _read_throttle = std::max(min_read_throttle, _read_throttle * read_throttle_decrease);
+    } else if (pressure < read_pressure_headroom) {
+        _read_throttle = std::min(1.0f, _read_throttle + read_throttle_increase);
+    }
+}
+
+void compaction_controller::update_controller(float shares) {
+    if (!controller_disabled() && _read_pressure) {
+        update_read_throttle(_read_pressure());
+        shares *= _read_throttle;
+    }
+    backlog_controller::update_controller(shares);
+}
+
+void write_throttle::update(clock_type::time_point now) {
+    auto dirty = _dirty_memory();
+    auto elapsed = std::chrono::duration<double>(now - _last_update).count();
+    if (elapsed > 0) {
+        auto rate = (double(dirty) - double(_last_dirty)) / elapsed;
+        _dirty_rate += rate_smoothing * (rate - _dirty_rate);
+    }
+    _last_update = now;
+    _last_dirty = dirty;
+
+    auto horizon = std::chrono::duration<double>(std::chrono::milliseconds(_cfg.horizon_in_ms())).count();
+    if (!horizon) {
+        _pressure = 0;
+        return;
+    }
+
+    auto projected = double(dirty) + _dirty_rate * horizon;
+    float memory_pressure;
+    if (_cfg.hard_limit > _cfg.soft_limit) {
+        memory_pressure = std::clamp((projected - _cfg.soft_limit) / (_cfg.hard_limit - _cfg.soft_limit), 0.0, 1.0);
+    } else {
+        memory_pressure = projected >= _cfg.hard_limit;
+    }
+
+    auto backlog = _compaction_backlog();
+    float compaction_pressure = 0;
+    if (!compaction_controller::backlog_disabled(backlog)) {
+        compaction_pressure = std::clamp((backlog - compaction_backlog_start) / (compaction_backlog_limit - compaction_backlog_start), 0.0f, 1.0f);
+    }
+
+    _pressure = std::max(memory_pressure, compaction_pressure);
+}
+
 
 dirty_memory_manager::dirty_memory_manager(replica::database& db, size_t threshold, double soft_limit, scheduling_group deferred_work_sg)
     : dirty_memory_manager_logalloc::region_group_reclaimer(threshold / 2, threshold * soft_limit / 2)
@@ -485,6 +560,7 @@ database::setup_metrics() {
     auto user_label_instance = class_label("user");
     auto streaming_label_instance = class_label("streaming");
     auto system_label_instance = class_label("system");
+    auto compaction_label_instance = class_label("compaction");
 
     _metrics.add_group("memory", {
         sm::make_gauge("dirty_bytes", [this] { return _dirty_memory_manager.real_dirty_memory() + _system_dirty_memory_manager.real_dirty_memory(); },
@@ -536,6 +612,15 @@ database::setup_metrics() {
         sm::make_counter("dropped_view_updates", _cf_stats.dropped_view_updates,
                        sm::description("Counts the number of view updates that have been dropped due to cluster overload. ")),
 
+        sm::make_counter("batched_view_updates", _cf_stats.batched_view_updates,
+                       sm::description("Counts the number of writes whose view updates were generated along with a concurrent write to the same partition.")),
+
+        sm::make_counter("coalesced_view_updates", _cf_stats.coalesced_view_updates,
+                       sm::description("Counts the number of asynchronous view updates merged into a queued update of the same view partition.")),
+
+        sm::make_gauge("queued_view_updates", [] { return db::view::queued_remote_view_updates(); },
+                       sm::description("Holds the number of asynchronous view updates waiting to be sent to remote view replicas.")),
+
        sm::make_counter("view_building_paused", _cf_stats.view_building_paused,
                       sm::description("Counts the number of times view building process was paused (e.g. due to node unavailability). ")),
 
@@ -576,6 +661,21 @@ database::setup_metrics() {
         sm::make_current_bytes("view_update_backlog", [this] { return get_view_update_backlog().current; },
                        sm::description("Holds the current size in bytes of the pending view updates for all tables")),
 
+        sm::make_gauge("write_throttle_pressure", [this] { return _write_throttle.pressure(); },
+                       sm::description("Holds the pressure, between 0 and 1, by which coordinators delay responses to writes because of predicted dirty memory and compaction debt")),
+
+        sm::make_gauge("hot_partition_copies", [this] { return _hot_partitions->copies(); },
+                       sm::description("Holds the number of read-only copies of hot partitions owned by other shards held by this shard")),
+
+        sm::make_counter("hot_partition_copy_reads", [this] { return _hot_partitions->get_stats().copy_reads; },
+                       sm::description("Counts single-partition reads served from a copy of a hot partition owned by another shard")),
+
+        sm::make_counter("hot_partition_cached_digest_reads", [this] { return _hot_partitions->get_stats().cached_digest_reads; },
+                       sm::description("Counts digest reads of a copy of a hot partition served from a digest cached with the copy, without querying it")),
+
+        sm::make_counter("hot_partition_invalidations", [this] { return _hot_partitions->get_stats().invalidations; },
+                       sm::description("Counts times copies of a hot partition owned by this shard were dropped from other shards, because of writes or expiry")),
+
         sm::make_counter("querier_cache_lookups", _querier_cache.get_stats().lookups,
                        sm::description("Counts querier cache lookups (paging queries)")),
 
@@ -595,6 +695,13 @@ database::setup_metrics() {
         sm::make_gauge("querier_cache_population", _querier_cache.get_stats().population,
                        sm::description("The number of entries currently in the querier cache.")),
 
+        sm::make_counter("querier_cache_resume_state_hits", _querier_cache.get_stats().resume_state_hits,
+                       sm::description("Counts querier cache misses which found the resume state of a querier evicted to free up resources, "
+                                       "which keeps the index pages of the evicted readers cached for the next page.")),
+
+        sm::make_gauge("querier_cache_resume_states", _querier_cache.get_stats().resume_states,
+                       sm::description("The number of resume states of evicted queriers currently kept in the querier cache.")),
+
         sm::make_counter("sstable_read_queue_overloads", _read_concurrency_sem.get_stats().total_reads_shed_due_to_overload,
                        sm::description("Counts the number of times the sstable read queue was overloaded. "
                                        "A non-zero value indicates that we have to drop read requests because they arrive faster than we can serve them.")),
@@ -603,6 +710,12 @@ database::setup_metrics() {
                        sm::description("Holds the number of currently active read operations. "),
                        {user_label_instance}),
 
+        sm::make_counter("linearizations", [] { return utils::get_linearization_stats().linearizations; },
+                       sm::description("Counts fragmented values which had to be copied into a newly allocated buffer to be processed.")),
+
+        sm::make_counter("linearized_bytes", [] { return utils::get_linearization_stats().linearized_bytes; },
+                       sm::description("Counts bytes of fragmented values which had to be copied into a newly allocated buffer to be processed.")),
+
     });
 
     // Registering all the metrics with a single call causes the stack size to blow up.
@@ -617,6 +730,22 @@ database::setup_metrics() {
                        sm::description("Holds the number of currently queued read operations."),
                        {user_label_instance}),
 
+        sm::make_counter("cheap_reads_dequeued", _read_concurrency_sem.get_stats().cheap_reads_dequeued,
+                       sm::description("The number of reads predicted to be cheap admitted after waiting in the queue."),
+                       {user_label_instance}),
+
+        sm::make_counter("cheap_reads_queue_time_us", _read_concurrency_sem.get_stats().cheap_reads_queue_time_us,
+                       sm::description("The total time reads predicted to be cheap waited in the queue before admission, in microseconds."),
+                       {user_label_instance}),
+
+        sm::make_counter("normal_reads_dequeued", _read_concurrency_sem.get_stats().normal_reads_dequeued,
+                       sm::description("The number of reads not predicted to be cheap admitted after waiting in the queue."),
+                       {user_label_instance}),
+
+        sm::make_counter("normal_reads_queue_time_us", _read_concurrency_sem.get_stats().normal_reads_queue_time_us,
+                       sm::description("The total time reads not predicted to be cheap waited in the queue before admission, in microseconds."),
+                       {user_label_instance}),
+
         sm::make_gauge("paused_reads", _read_concurrency_sem.get_stats().inactive_reads,
                        sm::description("The number of currently active reads that are temporarily paused."),
                        {user_label_instance}),
@@ -632,6 +761,11 @@ database::setup_metrics() {
                                        " When the queue is full, excessive reads are shed to avoid overload."),
                        {user_label_instance}),
 
+        sm::make_counter("reads_shed_due_to_timeout", _read_concurrency_sem.get_stats().total_reads_shed_due_to_timeout,
+                       sm::description("The number of reads failed on arrival because they were expected to time out"
+                                       " before being admitted, given the recent time reads spent in the admission queue."),
+                       {user_label_instance}),
+
         sm::make_gauge("active_reads", [this] { return max_count_streaming_concurrent_reads - _streaming_concurrency_sem.available_resources().count; },
                        sm::description("Holds the number of currently active read operations issued on behalf of streaming "),
                        {streaming_label_instance}),
@@ -662,6 +796,11 @@ database::setup_metrics() {
                                        " When the queue is full, excessive reads are shed to avoid overload."),
                        {streaming_label_instance}),
 
+        sm::make_counter("reads_shed_due_to_timeout", _streaming_concurrency_sem.get_stats().total_reads_shed_due_to_timeout,
+                       sm::description("The number of reads failed on arrival because they were expected to time out"
+                                       " before being admitted, given the recent time reads spent in the admission queue."),
+                       {streaming_label_instance}),
+
         sm::make_gauge("active_reads", [this] { return max_count_system_concurrent_reads - _system_read_concurrency_sem.available_resources().count; },
                        sm::description("Holds the number of currently active read operations from \"system\" keyspace tables. "),
                        {system_label_instance}),
@@ -691,6 +830,16 @@ database::setup_metrics() {
                                        " When the queue is full, excessive reads are shed to avoid overload."),
                        {system_label_instance}),
 
+        sm::make_counter("reads_shed_due_to_timeout", _system_read_concurrency_sem.get_stats().total_reads_shed_due_to_timeout,
+                       sm::description("The number of reads failed on arrival because they were expected to time out"
+                                       " before being admitted, given the recent time reads spent in the admission queue."),
+                       {system_label_instance}),
+
+        sm::make_counter("reads_shed_due_to_timeout", _compaction_concurrency_sem.get_stats().total_reads_shed_due_to_timeout,
+                       sm::description("The number of reads failed on arrival because they were expected to time out"
+                                       " before being admitted, given the recent time reads spent in the admission queue."),
+                       {compaction_label_instance}),
+
         sm::make_gauge("total_result_bytes", [this] { return get_result_memory_limiter().total_used_memory(); },
                        sm::description("Holds the current amount of memory used for results.")),
 
@@ -718,6 +867,9 @@ database::setup_metrics() {
         sm::make_queue_length("counter_cell_lock_pending", _cl_stats->operations_waiting_for_lock,
                              sm::description("The number of counter updates waiting for a lock.")),
 
+        sm::make_counter("counter_updates_coalesced", _stats->counter_updates_coalesced,
+                       sm::description("The number of counter updates merged into a concurrent update of the same partition.")),
+
         sm::make_counter("large_partition_exceeding_threshold", [this] { return _large_data_handler->stats().partitions_bigger_than_threshold; },
             sm::description("Number of large partitions exceeding compaction_large_partition_warning_threshold_mb. "
                 "Large partitions have performance impact and should be avoided, check the documentation for details.")),
@@ -1022,6 +1174,10 @@ future<> database::drop_column_family(const sstring& ks_name, const sstring& cf_
     }
     auto f = co_await coroutine::as_future(truncate(ks, *cf, std::move(tsf), snapshot));
     co_await cf->stop();
+    for (auto* sem : {&_read_concurrency_sem, &_streaming_concurrency_sem, &_compaction_concurrency_sem, &_system_read_concurrency_sem}) {
+        sem->drop_table_read_costs(uuid);
+    }
+    cql3::select_result_cache::drop(uuid);
     f.get(); // re-throw exception from truncate() if any
 }
 
@@ -1213,6 +1369,8 @@ keyspace::make_column_family_config(const schema& s, const database& db) const {
     cfg.enable_metrics_reporting = db_config.enable_keyspace_column_family_metrics();
     cfg.reversed_reads_auto_bypass_cache = db_config.reversed_reads_auto_bypass_cache;
     cfg.enable_optimized_reversed_reads = db_config.enable_optimized_reversed_reads;
+    cfg.memtable_flush_parallelism = db_config.memtable_flush_parallelism;
+    cfg.coalesce_partition_writes = db_config.coalesce_partition_writes;
     cfg.view_update_concurrency_semaphore = _config.view_update_concurrency_semaphore;
     cfg.view_update_concurrency_semaphore_limit = _config.view_update_concurrency_semaphore_limit;
     cfg.data_listeners = &db.data_listeners();
@@ -1244,6 +1402,8 @@ keyspace::make_directory_for_column_family(const sstring& name, utils::UUID uuid
         return io_check([cfdirs0] { return touch_directory(cfdirs0 + "/upload"); });
     }).then([cfdirs0 = cfdirs[0]] {
         return io_check([cfdirs0] { return touch_directory(cfdirs0 + "/staging"); });
+    }).then([cfdirs0 = cfdirs[0]] {
+        return io_check([cfdirs0] { return touch_directory(cfdirs0 + "/" + sstables::cold_dir); });
     });
 }
 
@@ -1412,6 +1572,14 @@ std::optional<db::rate_limiter::can_proceed> database::account_coordinator_opera
     return _rate_limiter.account_operation(lbl, dht::token::to_int64(token), *table_limit, account_and_enforce_info);
 }
 
+db::rate_limiter::can_proceed database::account_non_replica_coordinator_write_to_rate_limit(table& tbl, const dht::token& token,
+        db::per_partition_rate_limit::account_and_enforce account_and_enforce_info) {
+
+    std::optional<uint32_t> table_limit = tbl.schema()->per_partition_rate_limit_options().get_max_ops_per_second(db::operation_type::write);
+    db::rate_limiter::label& lbl = tbl.get_coordinated_rate_limiter_label_for_writes();
+    return _rate_limiter.account_operation(lbl, dht::token::to_int64(token), *table_limit, account_and_enforce_info);
+}
+
 static db::rate_limiter::can_proceed account_singular_ranges_to_rate_limit(
         db::rate_limiter& limiter, column_family& cf,
         const dht::partition_range_vector& ranges,
@@ -1484,12 +1652,16 @@ database::query(schema_ptr s, const query::read_command& cmd, query::result_opti
         if (querier_opt) {
             f = co_await coroutine::as_future(semaphore.with_ready_permit(querier_opt->permit(), read_func));
         } else {
-            f = co_await coroutine::as_future(semaphore.with_permit(s.get(), "data-query", cf.estimate_read_memory_cost(), timeout, read_func));
+            f = co_await coroutine::as_future(semaphore.with_permit(s.get(), "data-query", cf.estimate_read_memory_cost(), timeout, read_func,
+                    _cfg.cheap_read_fast_lane() ? cf.estimate_read_class(ranges, cmd.slice) : reader_concurrency_semaphore::read_class::normal));
         }
 
         if (!f.failed()) {
             if (cmd.query_uuid != utils::UUID{} && querier_opt) {
                 _querier_cache.insert_data_querier(cmd.query_uuid, std::move(*querier_opt), std::move(trace_state));
+            } else if (cmd.query_uuid != utils::UUID{}) {
+                // The read is over, its index pages needn't be kept for another page.
+                _querier_cache.drop_resume_states(cmd.query_uuid);
             }
         } else {
             ex = f.get_exception();
@@ -1556,6 +1728,9 @@ database::query_mutations(schema_ptr s, const query::read_command& cmd, const dh
         if (!f.failed()) {
             if (cmd.query_uuid != utils::UUID{} && querier_opt) {
                 _querier_cache.insert_mutation_querier(cmd.query_uuid, std::move(*querier_opt), std::move(trace_state));
+            } else if (cmd.query_uuid != utils::UUID{}) {
+                // The read is over, its index pages needn't be kept for another page.
+                _querier_cache.drop_resume_states(cmd.query_uuid);
             }
         } else {
             ex = f.get_exception();
@@ -1622,11 +1797,50 @@ std::ostream& operator<<(std::ostream& out, const database& db) {
     return out;
 }
 
+// Whether all cells updated by m are updated by batch too, and are thus
+// covered by the cell locks acquired for batch.
+static bool counter_cells_covered_by(const mutation& m, const mutation& batch) {
+    bool covered = true;
+    m.partition().static_row().for_each_cell([&] (column_id id, const atomic_cell_or_collection&) {
+        covered = covered && batch.partition().static_row().find_cell(id);
+    });
+    for (auto&& cr : m.partition().clustered_rows()) {
+        auto row = batch.partition().find_row(*batch.schema(), cr.key());
+        if (!row) {
+            return false;
+        }
+        cr.row().cells().for_each_cell([&] (column_id id, const atomic_cell_or_collection&) {
+            covered = covered && row->find_cell(id);
+        });
+    }
+    return covered;
+}
+
 future<mutation> database::do_apply_counter_update(column_family& cf, const frozen_mutation& fm, schema_ptr m_schema,
                                                    db::timeout_clock::time_point timeout,tracing::trace_state_ptr trace_state) {
     auto m = fm.unfreeze(m_schema);
     m.upgrade(cf.schema());
 
+    // Updates of a hot counter queue up for its cell lock, and each of them
+    // would read the counter and write the commitlog in turn. Instead, an
+    // update waiting for the locks takes the updates of the same cells which
+    // arrive meanwhile along: their deltas are summed up, and applied with a
+    // single read and a single write once the locks are acquired. All of
+    // them complete with the resulting mutation, which the leader replicates.
+    if (_cfg.coalesce_counter_updates()) {
+        auto batch = cf._counter_update_batches.find(m.token(), [&m] (const column_family::counter_update_batch& b) {
+            return b.m.schema() == m.schema() && b.m.decorated_key().equal(*m.schema(), m.decorated_key())
+                    && counter_cells_covered_by(m, b.m);
+        });
+        if (batch) {
+            ++_stats->counter_updates_coalesced;
+            tracing::trace(trace_state, "Counter update merged with a concurrent update of the partition");
+            batch->joined.push_back(std::move(m));
+            // Don't wait for the batch past the update's own timeout.
+            return batch->done.get_shared_future(timeout);
+        }
+    }
+
     // prepare partition slice
     query::column_id_vector static_columns;
     static_columns.reserve(m.partition().static_row().size());
@@ -1653,11 +1867,28 @@ future<mutation> database::do_apply_counter_update(column_family& cf, const froz
     auto slice = query::partition_slice(std::move(cr_ranges), std::move(static_columns),
         std::move(regular_columns), { }, { }, cql_serialization_format::internal(), query::max_rows);
 
-    return do_with(std::move(slice), std::move(m), std::vector<locked_cell>(),
-                   [this, &cf, timeout, trace_state = std::move(trace_state), op = cf.write_in_progress()] (const query::partition_slice& slice, mutation& m, std::vector<locked_cell>& locks) mutable {
+    auto batch = make_lw_shared<column_family::counter_update_batch>(std::move(m));
+    auto registration = make_lw_shared<decltype(cf._counter_update_batches)::registration>();
+    if (_cfg.coalesce_counter_updates()) {
+        *registration = cf._counter_update_batches.add(batch->m.token(), batch);
+    }
+
+    auto op = cf.write_in_progress();
+    return do_with(std::move(slice), std::vector<locked_cell>(),
+                   [this, &cf, batch, registration, timeout, trace_state = std::move(trace_state)] (const query::partition_slice& slice, std::vector<locked_cell>& locks) mutable {
         tracing::trace(trace_state, "Acquiring counter locks");
-        return cf.lock_counter_cells(m, timeout).then([&, m_schema = cf.schema(), trace_state = std::move(trace_state), timeout, this] (std::vector<locked_cell> lcs) mutable {
+        return cf.lock_counter_cells(batch->m, timeout).then([&, batch, registration, m_schema = cf.schema(), trace_state = std::move(trace_state), timeout, this] (std::vector<locked_cell> lcs) mutable {
             locks = std::move(lcs);
+            auto& m = batch->m;
+
+            // Updates arriving from now on wait for the locks we hold, so
+            // they start a batch of their own. The cells of the joined ones
+            // are locked along with ours, and their deltas can be merged.
+            registration->release();
+            for (auto&& joined : batch->joined) {
+                m.apply(std::move(joined));
+            }
+            batch->joined.clear();
 
             // Before counter update is applied it needs to be transformed from
             // deltas to counter shards. To do that, we need to read the current
@@ -1666,17 +1897,25 @@ future<mutation> database::do_apply_counter_update(column_family& cf, const froz
             tracing::trace(trace_state, "Reading counter values from the CF");
             auto permit = get_reader_concurrency_semaphore().make_tracking_only_permit(m_schema.get(), "counter-read-before-write", timeout);
             return counter_write_query(m_schema, cf.as_mutation_source(), std::move(permit), m.decorated_key(), slice, trace_state)
-                    .then([this, &cf, &m, m_schema, timeout, trace_state] (auto mopt) {
+                    .then([this, &cf, batch, m_schema, timeout, trace_state] (auto mopt) {
+                auto& m = batch->m;
                 // ...now, that we got existing state of all affected counter
                 // cells we can look for our shard in each of them, increment
                 // its clock and apply the delta.
                 transform_counter_updates_to_shards(m, mopt ? &*mopt : nullptr, cf.failed_counter_applies_to_memtable(), _cfg.host_id);
                 tracing::trace(trace_state, "Applying counter update");
                 return this->apply_with_commitlog(cf, m, timeout);
-            }).then([&m] {
-                return std::move(m);
             });
         });
+    }).then_wrapped([batch, registration, op = std::move(op)] (future<> f) {
+        registration->release();
+        if (f.failed()) {
+            auto ex = f.get_exception();
+            batch->done.set_exception(ex);
+            return make_exception_future<mutation>(std::move(ex));
+        }
+        batch->done.set_value(batch->m);
+        return make_ready_future<mutation>(std::move(batch->m));
     });
 }
 
@@ -1807,13 +2046,17 @@ future<> database::apply_in_memory(const frozen_mutation& m, schema_ptr m_schema
     data_listeners().on_write(m_schema, m);
 
     return with_gate(cf.async_gate(), [this, &m, m_schema = std::move(m_schema), h = std::move(h), &cf, timeout] () mutable -> future<> {
-        return cf.apply(m, std::move(m_schema), std::move(h), timeout);
+        return cf.apply(m, m_schema, std::move(h), timeout).then([this, &m, m_schema] {
+            return _hot_partitions->invalidate(*m_schema, m);
+        });
     });
 }
 
 future<> database::apply_in_memory(const mutation& m, column_family& cf, db::rp_handle&& h, db::timeout_clock::time_point timeout) {
     return with_gate(cf.async_gate(), [this, &m, h = std::move(h), &cf, timeout]() mutable -> future<> {
-        return cf.apply(m, std::move(h), timeout);
+        return cf.apply(m, std::move(h), timeout).then([this, &m] {
+            return _hot_partitions->invalidate(m);
+        });
     });
 }
 
@@ -1979,8 +2222,13 @@ future<> database::do_apply(schema_ptr s, const frozen_mutation& m, tracing::tra
     auto op = cf.write_in_progress();
 
     row_locker::lock_holder lock;
+    lw_shared_ptr<row_locker::lock_holder> batch_lock;
     if (!cf.views().empty()) {
-        lock = co_await cf.push_view_replica_updates(s, m, timeout, std::move(tr_state), get_reader_concurrency_semaphore());
+        if (_cfg.batch_view_updates()) {
+            batch_lock = co_await cf.push_view_replica_updates_batched(s, m, timeout, std::move(tr_state), get_reader_concurrency_semaphore());
+        } else {
+            lock = co_await cf.push_view_replica_updates(s, m, timeout, std::move(tr_state), get_reader_concurrency_semaphore());
+        }
     }
 
     // purposefully manually "inlined" apply_with_commitlog call here to reduce # coroutine
@@ -2209,11 +2457,20 @@ future<> database::start() {
     _large_data_handler->start();
     // We need the compaction manager ready early so we can reshard.
     _compaction_manager.enable();
+    _compaction_manager.set_foreground_read_load_source([this] {
+        _cf_stats.read_latency.update();
+        return compaction_manager::foreground_read_load{
+            .p99_latency = std::chrono::microseconds(int64_t(_cf_stats.read_latency.summary().back())),
+            .queue_length = _read_concurrency_sem.waiters(),
+        };
+    });
     co_await init_commitlog();
 }
 
 future<> database::shutdown() {
     _shutdown = true;
+    // Copies of partitions are dropped while all shards can still receive messages.
+    co_await _hot_partitions->stop();
     auto b = defer([this] { _stop_barrier.abort(); });
     co_await _stop_barrier.arrive_and_wait();
     b.cancel();
@@ -2237,6 +2494,7 @@ future<> database::stop() {
     if (!_shutdown) {
         co_await shutdown();
     }
+    _compaction_manager.set_foreground_read_load_source({});
 
     // try to ensure that CL has done disk flushing
     if (_commitlog) {
@@ -2249,6 +2507,7 @@ future<> database::stop() {
         co_await _schema_commitlog->shutdown();
         dblog.info("Shutting down schema commitlog complete");
     }
+    co_await db::view::stop_remote_view_update_queue();
     co_await _view_update_concurrency_sem.wait(max_memory_pending_view_updates());
     if (_commitlog) {
         co_await _commitlog->release();
@@ -2259,6 +2518,7 @@ future<> database::stop() {
     co_await _system_dirty_memory_manager.shutdown();
     co_await _dirty_memory_manager.shutdown();
     co_await _memtable_controller.shutdown();
+    _write_throttle.shutdown();
     co_await _user_sstables_manager->close();
     co_await _system_sstables_manager->close();
     co_await _querier_cache.stop();
@@ -2404,8 +2664,10 @@ future<> database::truncate(const keyspace& ks, column_family& cf, timestamp_fun
                 co_await vcf.clear();
             }
             db::replay_position rp = co_await vcf.discard_sstables(truncated_at);
+            cql3::select_result_cache::on_write(*vcf.schema());
             co_await db::system_keyspace::save_truncation_record(vcf, truncated_at, rp);
     });
+    cql3::select_result_cache::on_write(*cf.schema());
     // save_truncation_record() may actually fail after we cached the truncation time
     // but this is not be worse that if failing without caching: at least the correct time
     // will be available until next reboot and a client will have to retry truncation anyway.
@@ -18,6 +18,7 @@
 #include "utils/hash.hh"
 #include "db_clock.hh"
 #include "gc_clock.hh"
+#include <array>
 #include <chrono>
 #include <seastar/core/distributed.hh>
 #include <functional>
@@ -70,6 +71,7 @@
 #include "db/per_partition_rate_limit_info.hh"
 #include "db/operation_type.hh"
 #include "utils/serialized_action.hh"
+#include "utils/joinable_batches.hh"
 
 class cell_locker;
 class cell_locker_stats;
@@ -120,6 +122,7 @@ class config;
 class extensions;
 class rp_handle;
 class data_listeners;
+class hot_partition_tracker;
 class large_data_handler;
 class system_keyspace;
 class table_selector;
@@ -139,6 +142,8 @@ class database_test;
 
 namespace replica {
 
+class hot_partition_replicator;
+
 using shared_memtable = lw_shared_ptr<memtable>;
 
 // We could just add all memtables, regardless of types, to a single list, and
@@ -304,6 +309,12 @@ struct cf_stats {
     // How many view updates were dropped due to overload.
     int64_t dropped_view_updates = 0;
 
+    // How many writes had their view updates generated along with a concurrent write to the same partition.
+    int64_t batched_view_updates = 0;
+
+    // How many asynchronous view updates were merged into a queued update of the same view partition.
+    int64_t coalesced_view_updates = 0;
+
     // How many times view building was paused (e.g. due to node unavailability)
     int64_t view_building_paused = 0;
 
@@ -312,6 +323,10 @@ struct cf_stats {
     uint64_t total_view_updates_pushed_remote = 0;
     uint64_t total_view_updates_failed_local = 0;
     uint64_t total_view_updates_failed_remote = 0;
+
+    // Latency of reads of all tables, summarized over the interval between samples
+    // taken by the compaction controller.
+    utils::summary_calculator read_latency;
 };
 
 class table;
@@ -328,6 +343,8 @@ extern const ssize_t new_reader_base_cost;
 struct table_stats {
     /** Number of times flush has resulted in the memtable being switched out. */
     int64_t memtable_switch_count = 0;
+    /** Number of flushes forced to bound the data lost on a crash by tables with non_durable_writes */
+    int64_t non_durable_flushes = 0;
     /** Estimated number of tasks pending for this column family */
     int64_t pending_flushes = 0;
     int64_t live_disk_space_used = 0;
@@ -339,6 +356,8 @@ struct table_stats {
     int64_t memtable_partition_hits = 0;
     int64_t memtable_range_tombstone_reads = 0;
     int64_t memtable_row_tombstone_reads = 0;
+    /** Number of writes applied to the memtable along with a concurrent write to the same partition */
+    int64_t memtable_coalesced_writes = 0;
     mutation_application_stats memtable_app_stats;
     utils::timed_rate_moving_average_summary_and_histogram reads{256};
     utils::timed_rate_moving_average_summary_and_histogram writes{256};
@@ -381,6 +400,8 @@ class table : public enable_lw_shared_from_this<table> {
         // for easy access from `table` member functions:
         utils::updateable_value<bool> reversed_reads_auto_bypass_cache{false};
         utils::updateable_value<bool> enable_optimized_reversed_reads{true};
+        utils::updateable_value<uint32_t> memtable_flush_parallelism{1};
+        utils::updateable_value<bool> coalesce_partition_writes{false};
         // Can be updated by a schema change:
         bool enable_optimized_twcs_queries{true};
     };
@@ -406,6 +427,8 @@ class table : public enable_lw_shared_from_this<table> {
     template<typename... Args>
     void do_apply(db::rp_handle&&, Args&&... args);
 
+    future<> apply_coalesced(const frozen_mutation& m, schema_ptr m_schema, db::rp_handle&& h, db::timeout_clock::time_point timeout);
+
     lw_shared_ptr<memtable_list> _memtables;
 
     lw_shared_ptr<memtable_list> make_memory_only_memtable_list();
@@ -433,6 +456,9 @@ class table : public enable_lw_shared_from_this<table> {
     seastar::named_semaphore _sstable_deletion_sem = {1, named_semaphore_exception_factory{"sstable deletion"}};
     // Ensures that concurrent updates to sstable set will work correctly
     seastar::named_semaphore _sstable_set_mutation_sem = {1, named_semaphore_exception_factory{"sstable set mutation"}};
+    // Set when the caching options of the table bound its cache memory. Such a
+    // table is cached separately from others, so that the bounds can be enforced.
+    std::unique_ptr<cache_tracker> _dedicated_cache_tracker;
     mutable row_cache _cache; // Cache covers only sstables.
     std::optional<int64_t> _sstable_generation = {};
 
@@ -452,9 +478,46 @@ class table : public enable_lw_shared_from_this<table> {
 
     std::unique_ptr<cell_locker> _counter_cell_locks; // Memory-intensive; allocate only when needed.
 
+    // Writes of a partition which are applied to the memtable together, see apply_coalesced().
+    struct pending_partition_writes {
+        mutation m;
+        // Of the commitlog entries of all merged writes.
+        std::vector<db::rp_handle> handles;
+        shared_promise<> applied;
+
+        explicit pending_partition_writes(mutation m) : m(std::move(m)) {}
+    };
+    utils::joinable_batches<dht::token, pending_partition_writes> _pending_partition_writes;
+
+    // Writes of a partition whose view updates are generated together, see push_view_replica_updates_batched().
+    struct view_update_batch {
+        mutation m;
+        // Held until the base writes of all writes in the batch are applied.
+        lw_shared_ptr<row_locker::lock_holder> lock;
+        shared_promise<> generated;
+
+        explicit view_update_batch(mutation m) : m(std::move(m)) {}
+    };
+    // Batches which didn't start generating their view updates yet and may be joined.
+    utils::joinable_batches<dht::token, view_update_batch> _view_update_batches;
+
+    // Counter updates of a partition which were merged together, see database::do_apply_counter_update().
+    struct counter_update_batch {
+        mutation m;
+        // Updates which joined while the batch waited for its cell locks.
+        std::vector<mutation> joined;
+        shared_promise<mutation> done;
+
+        explicit counter_update_batch(mutation m) : m(std::move(m)) {}
+    };
+    // Batches which still wait for their cell locks and may be joined.
+    utils::joinable_batches<dht::token, counter_update_batch> _counter_update_batches;
+
     // Labels used to identify writes and reads for this table in the rate_limiter structure.
     db::rate_limiter::label _rate_limiter_label_for_writes;
     db::rate_limiter::label _rate_limiter_label_for_reads;
+    // Label of the writes coordinated by a shard which isn't their replica.
+    db::rate_limiter::label _rate_limiter_label_for_coordinated_writes;
 
     void set_metrics();
     seastar::metrics::metric_groups _metrics;
@@ -480,6 +543,10 @@ class table : public enable_lw_shared_from_this<table> {
     lowres_clock::time_point _percentile_cache_timestamp;
     std::chrono::milliseconds _percentile_cache_value;
 
+    // Moving average of the rows per vnode range returned by the range scans
+    // of the table coordinated by this shard. Negative until one completes.
+    double _range_scan_rows_per_range = -1;
+
     // Phaser used to synchronize with in-progress writes. This is useful for code that,
     // after some modification, needs to ensure that news writes will see it before
     // it can proceed, such as the view building code.
@@ -753,6 +820,10 @@ class table : public enable_lw_shared_from_this<table> {
         }
     }
 
+    db::rate_limiter::label& get_coordinated_rate_limiter_label_for_writes() {
+        return _rate_limiter_label_for_coordinated_writes;
+    }
+
     db::rate_limiter::label& get_rate_limiter_label_for_writes() {
         return _rate_limiter_label_for_writes;
     }
@@ -896,6 +967,9 @@ class table : public enable_lw_shared_from_this<table> {
     lw_shared_ptr<const sstable_list> get_sstables_including_compacted_undeleted() const;
     const std::vector<sstables::shared_sstable>& compacted_undeleted_sstables() const;
     std::vector<sstables::shared_sstable> select_sstables(const dht::partition_range& range) const;
+    // Returns false if neither the memtables nor the sstables overlapping the range
+    // hold tombstones or expiring cells. Memtables are not filtered by the range.
+    bool may_have_tombstones(const dht::token_range& range) const;
     size_t sstables_count() const;
     std::vector<uint64_t> sstable_count_per_level() const;
     int64_t get_unleveled_sstables() const;
@@ -938,8 +1012,10 @@ class table : public enable_lw_shared_from_this<table> {
         return _global_cache_hit_rate;
     }
 
+    // Whether writes go to the commitlog. Tables with the non_durable_writes
+    // option skip it even in a keyspace with durable_writes.
     bool durable_writes() const {
-        return _durable_writes;
+        return _durable_writes && !_schema->non_durable_writes_flush_period();
     }
 
     void set_durable_writes(bool dw) {
@@ -1015,10 +1091,18 @@ class table : public enable_lw_shared_from_this<table> {
     future<row_locker::lock_holder>
     stream_view_replica_updates(const schema_ptr& s, mutation&& m, db::timeout_clock::time_point timeout,
             std::vector<sstables::shared_sstable>& excluded_sstables) const;
+    // Like push_view_replica_updates(), but generates the view updates of concurrent
+    // writes to the same partition together, with a single read of the base partition.
+    // The returned lock is shared by all writes of the batch.
+    future<lw_shared_ptr<row_locker::lock_holder>> push_view_replica_updates_batched(const schema_ptr& s, const frozen_mutation& fm,
+            db::timeout_clock::time_point timeout, tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem);
 
     void add_coordinator_read_latency(utils::estimated_histogram::duration latency);
     std::chrono::milliseconds get_coordinator_read_latency_percentile(double percentile);
 
+    void add_range_scan_rows_per_range(double rows_per_range);
+    std::optional<double> get_range_scan_rows_per_range() const;
+
     secondary_index::secondary_index_manager& get_index_manager() {
         return _index_manager;
     }
@@ -1047,6 +1131,10 @@ class table : public enable_lw_shared_from_this<table> {
     }
 
     size_t estimate_read_memory_cost() const;
+    // Predicts whether reading the ranges is cheap, from the number of partitions
+    // and rows they select.
+    reader_concurrency_semaphore::read_class estimate_read_class(const dht::partition_range_vector& ranges,
+            const query::partition_slice& slice) const;
 
 private:
     future<row_locker::lock_holder> do_push_view_replica_updates(schema_ptr s, mutation m, db::timeout_clock::time_point timeout, mutation_source source,
@@ -1096,6 +1184,11 @@ class table : public enable_lw_shared_from_this<table> {
     timer<> _off_strategy_trigger;
     void do_update_off_strategy_trigger();
 
+    // Flushes memtables of tables with non_durable_writes periodically.
+    timer<lowres_clock> _non_durable_flush_timer;
+    void update_non_durable_flush_timer();
+    void on_non_durable_flush_timer();
+
 public:
     void update_off_strategy_trigger();
     void enable_off_strategy_trigger();
@@ -1282,6 +1375,8 @@ class database : public peering_sharded_service<database> {
         uint64_t multishard_query_unpopped_bytes = 0;
         uint64_t multishard_query_failed_reader_stops = 0;
         uint64_t multishard_query_failed_reader_saves = 0;
+
+        uint64_t counter_updates_coalesced = 0;
     };
 
     lw_shared_ptr<db_stats> _stats;
@@ -1328,6 +1423,7 @@ class database : public peering_sharded_service<database> {
     uint32_t _schema_change_count = 0;
     // compaction_manager object is referenced by all column families of a database.
     compaction_manager& _compaction_manager;
+    write_throttle _write_throttle;
     seastar::metrics::metric_groups _metrics;
     bool _enable_incremental_backups = false;
     bool _shutdown = false;
@@ -1345,6 +1441,8 @@ class database : public peering_sharded_service<database> {
 
     friend db::data_listeners;
     std::unique_ptr<db::data_listeners> _data_listeners;
+    std::unique_ptr<hot_partition_replicator> _hot_partitions;
+    std::unique_ptr<db::hot_partition_tracker> _hot_partition_tracker;
 
     service::migration_notifier& _mnotifier;
     gms::feature_service& _feat;
@@ -1533,6 +1631,12 @@ class database : public peering_sharded_service<database> {
     std::optional<db::rate_limiter::can_proceed> account_coordinator_operation_to_rate_limit(table& tbl, const dht::token& token,
             db::per_partition_rate_limit::account_and_enforce account_and_enforce_info,
             db::operation_type op_type);
+    /// Accounts a write coordinated by a shard which isn't its replica.
+    /// The shard only sees its own share of the partition's writes, all of which
+    /// replicas see too: if the share alone exceeds the limit, the excess may be
+    /// rejected before it is sent to replicas.
+    db::rate_limiter::can_proceed account_non_replica_coordinator_write_to_rate_limit(table& tbl, const dht::token& token,
+            db::per_partition_rate_limit::account_and_enforce account_and_enforce_info);
 
     future<std::tuple<lw_shared_ptr<query::result>, cache_temperature>> query(schema_ptr, const query::read_command& cmd, query::result_options opts,
                                                                   const dht::partition_range_vector& ranges, tracing::trace_state_ptr trace_state,
@@ -1674,10 +1778,23 @@ class database : public peering_sharded_service<database> {
         return {max_memory_pending_view_updates() - _view_update_concurrency_sem.current(), max_memory_pending_view_updates()};
     }
 
+    // The backlog of writes to this shard, see write_throttle.
+    db::view::update_backlog get_write_throttle_backlog() const {
+        return _write_throttle.backlog();
+    }
+
     db::data_listeners& data_listeners() const {
         return *_data_listeners;
     }
 
+    hot_partition_replicator& hot_partitions() const {
+        return *_hot_partitions;
+    }
+
+    db::hot_partition_tracker& hot_partition_tracker() const {
+        return *_hot_partition_tracker;
+    }
+
     // Get the maximum result size for an unlimited query, appropriate for the
     // query class, which is deduced from the current scheduling group.
     query::max_result_size get_unlimited_query_max_result_size() const;
@@ -1686,6 +1803,11 @@ class database : public peering_sharded_service<database> {
     // which is deduced from the current scheduling group.
     reader_concurrency_semaphore& get_reader_concurrency_semaphore();
 
+    // All reader concurrency semaphores of the shard.
+    std::array<const reader_concurrency_semaphore*, 4> get_reader_concurrency_semaphores() const {
+        return {&_read_concurrency_sem, &_streaming_concurrency_sem, &_compaction_concurrency_sem, &_system_read_concurrency_sem};
+    }
+
     // Convenience method to obtain an admitted permit. See reader_concurrency_semaphore::obtain_permit().
     future<reader_permit> obtain_reader_permit(table& tbl, const char* const op_name, db::timeout_clock::time_point timeout);
     future<reader_permit> obtain_reader_permit(schema_ptr schema, const char* const op_name, db::timeout_clock::time_point timeout);
@@ -7,6 +7,7 @@
  */
 
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/timer.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/util/closeable.hh>
@@ -435,9 +436,10 @@ future<> distributed_loader::handle_sstables_pending_delete(sstring pending_dele
     co_await when_all_succeed(futures.begin(), futures.end()).discard_result();
 }
 
-future<> distributed_loader::populate_column_family(distributed<replica::database>& db, sstring sstdir, sstring ks, sstring cf, allow_offstrategy_compaction do_allow_offstrategy_compaction, must_exist dir_must_exist) {
+future<> distributed_loader::populate_column_family(distributed<replica::database>& db, sstring sstdir, sstring ks, sstring cf, allow_offstrategy_compaction do_allow_offstrategy_compaction, must_exist dir_must_exist,
+        populate_progress* progress) {
     dblog.debug("Populating {}/{}/{} allow_offstrategy_compaction={} must_exist={}", ks, cf, sstdir, do_allow_offstrategy_compaction, dir_must_exist);
-    return async([&db, sstdir = std::move(sstdir), ks = std::move(ks), cf = std::move(cf), do_allow_offstrategy_compaction, dir_must_exist] {
+    return async([&db, sstdir = std::move(sstdir), ks = std::move(ks), cf = std::move(cf), do_allow_offstrategy_compaction, dir_must_exist, progress] {
         assert(this_shard_id() == 0);
 
         if (!file_exists(sstdir).get0()) {
@@ -512,20 +514,26 @@ future<> distributed_loader::populate_column_family(distributed<replica::databas
             return global_table->make_sstable(sstdir, gen, sst_version, sstables::sstable::format_types::big);
         }, eligible_for_reshape_on_boot).get();
 
-        directory.invoke_on_all([global_table, &eligible_for_reshape_on_boot, do_allow_offstrategy_compaction] (sstables::sstable_directory& dir) {
-            return dir.do_for_each_sstable([&global_table, &eligible_for_reshape_on_boot, do_allow_offstrategy_compaction] (sstables::shared_sstable sst) {
+        auto loaded = directory.map_reduce0([global_table, &eligible_for_reshape_on_boot, do_allow_offstrategy_compaction] (sstables::sstable_directory& dir) {
+            auto count = make_lw_shared<size_t>(0);
+            return dir.do_for_each_sstable([&global_table, &eligible_for_reshape_on_boot, do_allow_offstrategy_compaction, count] (sstables::shared_sstable sst) {
                 auto requires_offstrategy = sstables::offstrategy(do_allow_offstrategy_compaction && !eligible_for_reshape_on_boot(sst));
+                ++*count;
                 return global_table->add_sstable_and_update_cache(sst, requires_offstrategy);
-            }).then([&global_table, do_allow_offstrategy_compaction] {
+            }).then([&global_table, do_allow_offstrategy_compaction, count] {
               if (do_allow_offstrategy_compaction) {
                 global_table->trigger_offstrategy_compaction();
               }
+              return *count;
             });
-        }).get();
+        }, size_t(0), std::plus<size_t>()).get0();
+        if (progress) {
+            progress->sstables_loaded += loaded;
+        }
     });
 }
 
-future<> distributed_loader::populate_keyspace(distributed<replica::database>& db, sstring datadir, sstring ks_name) {
+future<> distributed_loader::populate_keyspace(distributed<replica::database>& db, sstring datadir, sstring ks_name, populate_progress* progress) {
     auto ksdir = datadir + "/" + ks_name;
     auto& keyspaces = db.local().get_keyspaces();
     auto i = keyspaces.find(ks_name);
@@ -547,9 +555,13 @@ future<> distributed_loader::populate_keyspace(distributed<replica::database>& d
 
         try {
             co_await ks.make_directory_for_column_family(cfname, uuid);
-            co_await distributed_loader::populate_column_family(db, sstdir + "/" + sstables::staging_dir, ks_name, cfname, allow_offstrategy_compaction::no);
-            co_await distributed_loader::populate_column_family(db, sstdir + "/" + sstables::quarantine_dir, ks_name, cfname, allow_offstrategy_compaction::no, must_exist::no);
-            co_await distributed_loader::populate_column_family(db, sstdir, ks_name, cfname, allow_offstrategy_compaction::yes);
+            co_await distributed_loader::populate_column_family(db, sstdir + "/" + sstables::staging_dir, ks_name, cfname, allow_offstrategy_compaction::no, must_exist::yes, progress);
+            co_await distributed_loader::populate_column_family(db, sstdir + "/" + sstables::quarantine_dir, ks_name, cfname, allow_offstrategy_compaction::no, must_exist::no, progress);
+            co_await distributed_loader::populate_column_family(db, sstdir + "/" + sstables::cold_dir, ks_name, cfname, allow_offstrategy_compaction::no, must_exist::no, progress);
+            co_await distributed_loader::populate_column_family(db, sstdir, ks_name, cfname, allow_offstrategy_compaction::yes, must_exist::yes, progress);
+            if (progress) {
+                progress->tables_done++;
+            }
         } catch (...) {
             std::exception_ptr eptr = std::current_exception();
             std::string msg =
@@ -638,6 +650,22 @@ future<> distributed_loader::init_non_system_keyspaces(distributed<replica::data
             }
         }).get();
 
+        populate_progress progress;
+        for (auto& [ks_name, datadir] : dirs) {
+            if (db.local().has_keyspace(ks_name)) {
+                progress.tables_total += db.local().find_keyspace(ks_name).metadata()->cf_meta_data().size();
+            }
+        }
+        auto start = lowres_clock::now();
+        auto elapsed = [start] {
+            return std::chrono::duration_cast<std::chrono::seconds>(lowres_clock::now() - start).count();
+        };
+        timer<lowres_clock> progress_timer([&progress, &elapsed] {
+            dblog.info("Populating keyspaces: {}/{} tables done, {} sstables loaded in {}s",
+                    progress.tables_done, progress.tables_total, progress.sstables_loaded, elapsed());
+        });
+        progress_timer.arm_periodic(std::chrono::seconds(10));
+
         std::vector<future<>> futures;
 
         // treat "dirs" as immutable to avoid modifying it while still in 
@@ -650,7 +678,7 @@ future<> distributed_loader::init_non_system_keyspaces(distributed<replica::data
             // somehow someone placed sstables in more than one of them for a given ks. (import?) 
             futures.emplace_back(parallel_for_each(j, e, [&](const std::pair<sstring, sstring>& p) {
                 auto& datadir = p.second;
-                return distributed_loader::populate_keyspace(db, datadir, ks_name);
+                return distributed_loader::populate_keyspace(db, datadir, ks_name, &progress);
             }).finally([&] {
                 return db.invoke_on_all([ks_name] (replica::database& db) {
                     // can be false if running test environment
@@ -665,6 +693,8 @@ future<> distributed_loader::init_non_system_keyspaces(distributed<replica::data
         }
 
         when_all_succeed(futures.begin(), futures.end()).discard_result().get();
+        progress_timer.cancel();
+        dblog.info("Populated keyspaces: {} tables, {} sstables loaded in {}s", progress.tables_done, progress.sstables_loaded, elapsed());
 
         db.invoke_on_all([] (replica::database& db) {
             return parallel_for_each(db.get_non_system_column_families(), [] (lw_shared_ptr<replica::table> table) {
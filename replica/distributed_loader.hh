@@ -72,8 +72,15 @@ class distributed_loader {
             std::filesystem::path datadir, sstring ks, sstring cf);
     using allow_offstrategy_compaction = bool_class<struct allow_offstrategy_compaction_tag>;
     using must_exist = bool_class<struct must_exist_tag>;
-    static future<> populate_column_family(distributed<replica::database>& db, sstring sstdir, sstring ks, sstring cf, allow_offstrategy_compaction, must_exist = must_exist::yes);
-    static future<> populate_keyspace(distributed<replica::database>& db, sstring datadir, sstring ks_name);
+    // Progress of populating keyspaces at startup, updated on shard 0.
+    struct populate_progress {
+        size_t tables_total = 0;
+        size_t tables_done = 0;
+        size_t sstables_loaded = 0;
+    };
+    static future<> populate_column_family(distributed<replica::database>& db, sstring sstdir, sstring ks, sstring cf, allow_offstrategy_compaction, must_exist = must_exist::yes,
+            populate_progress* progress = nullptr);
+    static future<> populate_keyspace(distributed<replica::database>& db, sstring datadir, sstring ks_name, populate_progress* progress = nullptr);
     static future<> cleanup_column_family_temp_sst_dirs(sstring sstdir);
     static future<> handle_sstables_pending_delete(sstring pending_deletes_dir);
 
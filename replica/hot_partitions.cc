@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/gate.hh>
+#include <seastar/core/loop.hh>
+#include <seastar/core/sleep.hh>
+#include <seastar/coroutine/as_future.hh>
+
+#include "replica/hot_partitions.hh"
+#include "replica/database.hh"
+#include "mutation_query.hh"
+#include "query-result-writer.hh"
+#include "collection_mutation.hh"
+#include "log.hh"
+
+static logging::logger hplog("hot_partitions");
+
+namespace replica {
+
+// Partitions read more often than the threshold are looked for among these.
+static constexpr unsigned max_hot_partitions_per_period = 16;
+static constexpr auto detection_period = std::chrono::seconds(1);
+// Digest query results kept per copy, one per query shape.
+static constexpr size_t max_cached_digests = 4;
+
+hot_partition_replicator::hot_partition_replicator(database& db, config cfg)
+    : _db(db)
+    , _cfg(std::move(cfg))
+    , _timer([this] { on_timer(); })
+{
+    // Reads are only counted, and external updates only matter, when copies are made.
+    if (_cfg.read_threshold) {
+        _db.data_listeners().install(this);
+    }
+    _timer.arm_periodic(detection_period);
+}
+
+hot_partition_replicator::~hot_partition_replicator() {
+    if (_cfg.read_threshold) {
+        _db.data_listeners().uninstall(this);
+    }
+}
+
+hot_partition_replicator::partition_id hot_partition_replicator::make_id(const schema& s, const dht::decorated_key& dk) {
+    return partition_id{s.id(), dk.token().raw(), to_bytes(dk.key().representation())};
+}
+
+bool hot_partition_replicator::has_expiring_data(const schema& s, const mutation_partition& mp) {
+    auto has_expiring_cells = [&s] (column_kind kind, const row& cells) {
+        bool found = false;
+        cells.for_each_cell_until([&] (column_id id, const atomic_cell_or_collection& c) {
+            auto& cdef = s.column_at(kind, id);
+            if (cdef.is_atomic()) {
+                found = c.as_atomic_cell(cdef).is_live_and_has_ttl();
+            } else {
+                found = c.as_collection_mutation().with_deserialized(*cdef.type, [] (collection_mutation_view_description desc) {
+                    return std::ranges::any_of(desc.cells, [] (const auto& cell) { return cell.second.is_live_and_has_ttl(); });
+                });
+            }
+            return stop_iteration(found);
+        });
+        return found;
+    };
+    if (has_expiring_cells(column_kind::static_column, mp.static_row().get())) {
+        return true;
+    }
+    return std::ranges::any_of(mp.clustered_rows(), [&] (const rows_entry& re) {
+        return re.row().marker().is_expiring() || has_expiring_cells(column_kind::regular_column, re.row().cells());
+    });
+}
+
+const hot_partition_replicator::cached_digest* hot_partition_replicator::find_digest(const schema& s, const partition_copy& copy,
+        const query::read_command& cmd, query::result_options opts) {
+    auto range_tri_cmp = clustering_key_prefix::tri_compare(s);
+    auto same_range = [&] (const query::clustering_range& a, const query::clustering_range& b) {
+        return a.equal(b, range_tri_cmp);
+    };
+    for (auto& d : copy.digests) {
+        if (d.row_limit == cmd.get_row_limit() && d.digest_algo == opts.digest_algo
+                && d.slice.options.mask() == cmd.slice.options.mask()
+                && d.slice.partition_row_limit() == cmd.slice.partition_row_limit()
+                && d.slice.cql_format() == cmd.slice.cql_format()
+                && d.slice.static_columns == cmd.slice.static_columns
+                && d.slice.regular_columns == cmd.slice.regular_columns
+                && std::ranges::equal(d.slice.default_row_ranges(), cmd.slice.default_row_ranges(), same_range)) {
+            return &d;
+        }
+    }
+    return nullptr;
+}
+
+flat_mutation_reader_v2 hot_partition_replicator::on_read(const schema_ptr& s, const dht::partition_range& range,
+        const query::partition_slice& slice, flat_mutation_reader_v2&& rd) {
+    if (_cfg.read_threshold && range.is_singular() && range.start()->value().has_key()) {
+        try {
+            _reads.append(db::toppartitions_item_key{s, range.start()->value().as_decorated_key()});
+        } catch (...) {
+            // The sketch is invalidated and replaced on the next period.
+        }
+    }
+    return std::move(rd);
+}
+
+future<> hot_partition_replicator::on_external_update(const schema_ptr& s) {
+    std::vector<partition_id> ids;
+    for (auto& [id, p] : _replicated) {
+        if (id.table == s->id()) {
+            ids.push_back(id);
+        }
+    }
+    co_await parallel_for_each(ids, [this] (const partition_id& id) {
+        return invalidate(id);
+    });
+}
+
+void hot_partition_replicator::on_timer() {
+    auto now = lowres_clock::now();
+    std::vector<partition_id> expired;
+    for (auto& [id, p] : _replicated) {
+        if (!p.invalidation && p.copied_at + _cfg.ttl <= now) {
+            expired.push_back(id);
+        }
+    }
+    for (auto& id : expired) {
+        invalidate_in_background(id);
+    }
+
+    if (!_cfg.read_threshold || _stopped) {
+        return;
+    }
+    auto reads = std::exchange(_reads, db::toppartitions_data_listener::top_k(_reads.capacity()));
+    if (!reads.valid()) {
+        return;
+    }
+    const uint64_t threshold = uint64_t(_cfg.read_threshold) * detection_period.count();
+    for (auto& r : reads.top(max_hot_partitions_per_period)) {
+        if (r.count < threshold) {
+            break;
+        }
+        (void)with_gate(_gate, [this, s = r.item.schema, dk = r.item.key] () mutable {
+            return replicate(std::move(s), std::move(dk));
+        });
+    }
+}
+
+future<> hot_partition_replicator::replicate(schema_ptr s, dht::decorated_key dk) {
+    auto id = make_id(*s, dk);
+    if (_stopped || smp::count == 1 || _replicated.contains(id)) {
+        co_return;
+    }
+    const auto generation = _next_generation++;
+    _replicated.emplace(id, replicated_partition{generation, lowres_clock::now(), std::nullopt});
+
+    // False if the partition was written to, or its copies dropped, since we started.
+    auto current = [this, &id, generation] {
+        auto it = _replicated.find(id);
+        return it != _replicated.end() && it->second.generation == generation && !it->second.invalidation;
+    };
+
+    std::optional<partition_copy> copy;
+    try {
+        auto& t = _db.find_column_family(s->id());
+        s = t.schema();
+        auto pr = dht::partition_range::make_singular(dk);
+        auto rd = t.make_reader_v2(s, _db.get_reader_concurrency_semaphore().make_tracking_only_permit(s.get(), "hot-partition-copy", db::no_timeout), pr);
+        auto mo = co_await coroutine::as_future(read_mutation_from_flat_mutation_reader(rd));
+        co_await rd.close();
+        if (auto m = mo.get0()) {
+            auto fm = freeze(*m);
+            if (fm.representation().size() <= _cfg.max_partition_size) {
+                copy.emplace(partition_copy{s->version(), std::move(fm), has_expiring_data(*s, m->partition()), {}});
+            }
+        }
+    } catch (...) {
+        hplog.debug("Failed to read partition {} of {}.{} for copying: {}", dk, s->ks_name(), s->cf_name(), std::current_exception());
+    }
+
+    if (!current()) {
+        co_return;
+    }
+    if (!copy) {
+        _replicated.erase(id);
+        co_return;
+    }
+
+    // Messages to a shard are delivered in order, so copies which are installed here
+    // are dropped by an invalidation which starts after this point.
+    auto f = co_await coroutine::as_future(_db.container().invoke_on_others([id, version = copy->version, data = std::move(copy->data),
+            has_expiring_data = copy->has_expiring_data] (database& db) {
+        db.hot_partitions().install_copy(id, version, data, has_expiring_data);
+    }));
+    if (f.failed()) {
+        hplog.debug("Failed to copy partition {} of {}.{}: {}", dk, s->ks_name(), s->cf_name(), f.get_exception());
+        // Some shards may have installed the copy.
+        co_await invalidate(id);
+        co_return;
+    }
+    ++_stats.partitions_copied;
+    hplog.trace("Copied partition {} of {}.{} to all shards", dk, s->ks_name(), s->cf_name());
+}
+
+future<> hot_partition_replicator::invalidate(const partition_id& id) {
+    auto it = _replicated.find(id);
+    if (it == _replicated.end()) {
+        return make_ready_future<>();
+    }
+    if (it->second.invalidation) {
+        return it->second.invalidation->get_future();
+    }
+    ++_stats.invalidations;
+    const auto generation = it->second.generation;
+    auto f = [] (hot_partition_replicator& self, partition_id id, uint64_t generation) -> future<> {
+        // Acknowledging the write while copies remain would let reads miss it, so keep trying.
+        for (;;) {
+            auto f = co_await coroutine::as_future(self._db.container().invoke_on_others([id] (database& db) {
+                db.hot_partitions().drop_copy(id);
+            }));
+            if (!f.failed()) {
+                break;
+            }
+            hplog.warn("Failed to drop copies of a partition, retrying: {}", f.get_exception());
+            co_await sleep(std::chrono::milliseconds(10));
+        }
+        auto it = self._replicated.find(id);
+        if (it != self._replicated.end() && it->second.generation == generation) {
+            self._replicated.erase(it);
+        }
+    }(*this, id, generation);
+    shared_future<> sf(std::move(f));
+    // The lookup is repeated because the entry is gone if dropping the copies already completed.
+    it = _replicated.find(id);
+    if (it != _replicated.end() && it->second.generation == generation) {
+        it->second.invalidation.emplace(sf);
+    }
+    return sf.get_future();
+}
+
+void hot_partition_replicator::invalidate_in_background(const partition_id& id) {
+    // Doesn't fail, and stop() waits for the invalidation of all partitions.
+    (void)invalidate(id);
+}
+
+future<> hot_partition_replicator::invalidate(const schema& s, const frozen_mutation& m) {
+    if (_replicated.empty()) {
+        return make_ready_future<>();
+    }
+    return invalidate(make_id(s, m.decorated_key(s)));
+}
+
+future<> hot_partition_replicator::invalidate(const mutation& m) {
+    if (_replicated.empty()) {
+        return make_ready_future<>();
+    }
+    return invalidate(make_id(*m.schema(), m.decorated_key()));
+}
+
+std::optional<std::tuple<lw_shared_ptr<query::result>, cache_temperature>>
+hot_partition_replicator::query(const schema_ptr& s, const query::read_command& cmd, const dht::partition_range& pr, query::result_options opts) {
+    if (_copies.empty() || opts.request == query::result_request::result_and_digest || cmd.slice.is_reversed()
+            || !pr.is_singular() || !pr.start()->value().has_key()) {
+        return std::nullopt;
+    }
+    auto it = _copies.find(make_id(*s, pr.start()->value().as_decorated_key()));
+    if (it == _copies.end() || it->second.version != s->version()) {
+        return std::nullopt;
+    }
+    auto& copy = it->second;
+    // Specific ranges are only used by paged queries, which are not worth caching.
+    const bool cacheable = opts.request == query::result_request::only_digest && !copy.has_expiring_data
+            && !cmd.slice.get_specific_ranges();
+    try {
+        auto& t = _db.find_column_family(s->id());
+        if (cacheable) {
+            if (auto d = find_digest(*s, copy, cmd, opts)) {
+                ++_stats.copy_reads;
+                ++_stats.cached_digest_reads;
+                // The same as what query::result::builder makes for a digest-only query.
+                bytes_ostream buf;
+                ser::writer_of_query_result<bytes_ostream>(buf).start_partitions().end_partitions().end_query_result();
+                return std::tuple(make_lw_shared<query::result>(std::move(buf), d->digest, d->last_modified, query::short_read::no,
+                        std::nullopt, std::nullopt, std::nullopt, std::nullopt), t.get_global_cache_hit_rate());
+            }
+        }
+        auto result = query_mutation(copy.data.unfreeze(s), cmd.slice, cmd.get_row_limit(), cmd.timestamp, opts);
+        // The copy is queried in one go, so leave results which the owner would cut short
+        // or fail to it.
+        if (cmd.max_result_size && result.buf().size() > cmd.max_result_size->get_page_size()) {
+            return std::nullopt;
+        }
+        ++_stats.copy_reads;
+        if (cacheable && result.digest() && !result.is_short_read()) {
+            if (copy.digests.size() >= max_cached_digests) {
+                copy.digests.erase(copy.digests.begin());
+            }
+            copy.digests.push_back(cached_digest{cmd.slice, cmd.get_row_limit(), opts.digest_algo, *result.digest(), result.last_modified()});
+        }
+        return std::tuple(make_lw_shared<query::result>(std::move(result)), t.get_global_cache_hit_rate());
+    } catch (...) {
+        // The owning shard will serve the query.
+        hplog.debug("Failed to query a copy of partition of {}.{}: {}", s->ks_name(), s->cf_name(), std::current_exception());
+        return std::nullopt;
+    }
+}
+
+void hot_partition_replicator::install_copy(partition_id id, table_schema_version version, frozen_mutation data, bool has_expiring_data) {
+    if (_stopped) {
+        return;
+    }
+    if (_copies.size() >= _cfg.max_copies && !_copies.contains(id)) {
+        _copies.erase(_copies.begin());
+    }
+    _copies.insert_or_assign(std::move(id), partition_copy{version, std::move(data), has_expiring_data, {}});
+}
+
+void hot_partition_replicator::drop_copy(const partition_id& id) noexcept {
+    _copies.erase(id);
+}
+
+future<> hot_partition_replicator::stop() {
+    _stopped = true;
+    _timer.cancel();
+    std::vector<partition_id> ids;
+    for (auto& [id, p] : _replicated) {
+        ids.push_back(id);
+    }
+    co_await parallel_for_each(ids, [this] (const partition_id& id) {
+        return invalidate(id);
+    });
+    _copies.clear();
+    co_await _gate.close();
+}
+
+} // namespace replica
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <unordered_map>
+
+#include <seastar/core/gate.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/core/timer.hh>
+
+#include "bytes.hh"
+#include "cache_temperature.hh"
+#include "db/data_listeners.hh"
+#include "frozen_mutation.hh"
+#include "query-request.hh"
+#include "query-result.hh"
+#include "utils/UUID.hh"
+
+namespace replica {
+
+class database;
+
+// Makes read-only copies of partitions which are read often on the other shards of the node,
+// so that single-partition queries coordinated by those shards can be served without going
+// to the shard owning the partition, which would otherwise limit the throughput of the
+// partition to what a single core can do.
+//
+// The owning shard detects hot partitions by counting reads in a top-k sketch. Every second
+// it reads partitions which were read more than the threshold, and sends them frozen to the
+// other shards. A write to a partition which has copies drops them on all shards before the
+// write is acknowledged, so that a read which starts after a write completes never sees a
+// copy older than the write. Copies are also dropped when data of the table changes other
+// than by writes and after a while, after which the partition has to prove hot again.
+//
+// Copies are kept outside of the row_cache, in the standard allocator, and are bounded by
+// count and size of the partition, because row_cache entries are tied to the underlying
+// data source of the shard.
+//
+// Digest queries served from a copy keep their result with it, per query shape, so that
+// repeated digest reads of the partition are answered without querying and hashing it
+// again. This is only done for partitions without expiring data, whose results don't
+// depend on the query time. The cached results go away with the copy.
+class hot_partition_replicator : public db::data_listener {
+public:
+    struct config {
+        // Reads per second above which a partition is copied, 0 disables detection.
+        uint32_t read_threshold = 0;
+        // Maximum number of copies held by a shard.
+        size_t max_copies = 1024;
+        // Partitions whose frozen size exceeds this are not copied.
+        size_t max_partition_size = 256 * 1024;
+        // Time after which copies of a partition are dropped.
+        std::chrono::seconds ttl = std::chrono::seconds(10);
+    };
+    struct stats {
+        uint64_t partitions_copied = 0;
+        uint64_t copy_reads = 0;
+        uint64_t invalidations = 0;
+        uint64_t cached_digest_reads = 0;
+    };
+    // Identifies a partition across shards.
+    struct partition_id {
+        utils::UUID table;
+        int64_t token;
+        bytes key;
+
+        bool operator==(const partition_id&) const = default;
+    };
+private:
+    struct partition_id_hash {
+        size_t operator()(const partition_id& id) const noexcept {
+            return std::hash<int64_t>()(id.token);
+        }
+    };
+    // A partition owned by this shard which may have copies on other shards.
+    struct replicated_partition {
+        uint64_t generation;
+        lowres_clock::time_point copied_at;
+        // Engaged while copies are being dropped, writes wait for it.
+        std::optional<shared_future<>> invalidation;
+    };
+    // Result of a digest query of a copy, the result itself is rebuilt from it when served.
+    struct cached_digest {
+        query::partition_slice slice;
+        uint64_t row_limit;
+        query::digest_algorithm digest_algo;
+        query::result_digest digest;
+        api::timestamp_type last_modified;
+    };
+    struct partition_copy {
+        table_schema_version version;
+        frozen_mutation data;
+        // If false, results of queries of the copy don't depend on the query time.
+        bool has_expiring_data;
+        std::vector<cached_digest> digests;
+    };
+
+    database& _db;
+    config _cfg;
+    db::toppartitions_data_listener::top_k _reads;
+    std::unordered_map<partition_id, replicated_partition, partition_id_hash> _replicated;
+    std::unordered_map<partition_id, partition_copy, partition_id_hash> _copies;
+    uint64_t _next_generation = 0;
+    timer<lowres_clock> _timer;
+    seastar::gate _gate;
+    bool _stopped = false;
+    stats _stats;
+private:
+    static partition_id make_id(const schema& s, const dht::decorated_key& dk);
+    static bool has_expiring_data(const schema& s, const mutation_partition& mp);
+    static const cached_digest* find_digest(const schema& s, const partition_copy& copy, const query::read_command& cmd,
+            query::result_options opts);
+    void on_timer();
+    future<> invalidate(const partition_id& id);
+    void invalidate_in_background(const partition_id& id);
+public:
+    hot_partition_replicator(database& db, config cfg);
+    ~hot_partition_replicator();
+
+    virtual flat_mutation_reader_v2 on_read(const schema_ptr& s, const dht::partition_range& range,
+            const query::partition_slice& slice, flat_mutation_reader_v2&& rd) override;
+    virtual future<> on_external_update(const schema_ptr& s) override;
+
+    // Copies the partition, owned by this shard, to all other shards.
+    future<> replicate(schema_ptr s, dht::decorated_key dk);
+
+    // Drops copies of the partition written to, owned by this shard, from all shards.
+    // Must be called before the write is acknowledged.
+    future<> invalidate(const schema& s, const frozen_mutation& m);
+    future<> invalidate(const mutation& m);
+
+    // Serves a single-partition data or digest query from a copy held by this shard,
+    // returns std::nullopt if there is no copy which can serve it.
+    std::optional<std::tuple<lw_shared_ptr<query::result>, cache_temperature>>
+    query(const schema_ptr& s, const query::read_command& cmd, const dht::partition_range& pr, query::result_options opts);
+
+    // Called on this shard by the shard owning the partition.
+    void install_copy(partition_id id, table_schema_version version, frozen_mutation data, bool has_expiring_data);
+    void drop_copy(const partition_id& id) noexcept;
+
+    // Drops all copies made by this shard and stops making new ones.
+    future<> stop();
+
+    size_t copies() const noexcept {
+        return _copies.size();
+    }
+
+    size_t replicated_partitions() const noexcept {
+        return _replicated.size();
+    }
+
+    const stats& get_stats() const noexcept {
+        return _stats;
+    }
+};
+
+} // namespace replica
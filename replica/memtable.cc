@@ -14,6 +14,7 @@
 #include "mutation_partition_view.hh"
 #include "readers/empty_v2.hh"
 #include "readers/forwardable_v2.hh"
+#include "utils/code_region.hh"
 
 namespace replica {
 
@@ -57,24 +58,27 @@ void memtable::memtable_encoding_stats_collector::update(tombstone tomb) noexcep
     }
 }
 
+void memtable::memtable_encoding_stats_collector::update(const column_definition& col, const atomic_cell_or_collection& item) {
+    if (col.is_atomic()) {
+        update(item.as_atomic_cell(col));
+    } else {
+        item.as_collection_mutation().with_deserialized(*col.type, [&] (collection_mutation_view_description mview) {
+        // Note: when some of the collection cells are dead and some are live
+        // we need to encode a "live" deletion_time for the living ones.
+        // It is not strictly required to update encoding_stats for the latter case
+        // since { <int64_t>.min(), <int32_t>.max() } will not affect the encoding_stats
+        // minimum values.  (See #4035)
+        update(mview.tomb);
+        for (auto& entry : mview.cells) {
+            update(entry.second);
+        }
+        });
+    }
+}
+
 void memtable::memtable_encoding_stats_collector::update(const ::schema& s, const row& r, column_kind kind) {
     r.for_each_cell([this, &s, kind](column_id id, const atomic_cell_or_collection& item) {
-        auto& col = s.column_at(kind, id);
-        if (col.is_atomic()) {
-            update(item.as_atomic_cell(col));
-        } else {
-            item.as_collection_mutation().with_deserialized(*col.type, [&] (collection_mutation_view_description mview) {
-            // Note: when some of the collection cells are dead and some are live
-            // we need to encode a "live" deletion_time for the living ones.
-            // It is not strictly required to update encoding_stats for the latter case
-            // since { <int64_t>.min(), <int32_t>.max() } will not affect the encoding_stats
-            // minimum values.  (See #4035)
-            update(mview.tomb);
-            for (auto& entry : mview.cells) {
-                update(entry.second);
-            }
-            });
-        }
+        update(s.column_at(kind, id), item);
     });
 }
 
@@ -169,6 +173,7 @@ future<> memtable::clear_gently() noexcept {
             while (!p.empty()) {
                 auto dirty_before = dirty_size();
                 with_allocator(alloc, [&] () noexcept {
+                    utils::code_region_timer region_timer(utils::code_region::memtable_flush);
                     while (!p.empty()) {
                         if (p.begin()->clear_gently() == stop_iteration::no) {
                             break;
@@ -620,9 +625,9 @@ class flush_reader final : public flat_mutation_reader_v2::impl, private iterato
     flat_mutation_reader_v2_opt _partition_reader;
     flush_memory_accounter _flushed_memory;
 public:
-    flush_reader(schema_ptr s, reader_permit permit, lw_shared_ptr<memtable> m)
+    flush_reader(schema_ptr s, reader_permit permit, lw_shared_ptr<memtable> m, const dht::partition_range& range)
         : impl(s, std::move(permit))
-        , iterator_reader(std::move(s), m, query::full_partition_range)
+        , iterator_reader(std::move(s), m, range)
         , _flushed_memory(*m)
     {}
     flush_reader(const flush_reader&) = delete;
@@ -744,13 +749,13 @@ memtable::make_flat_reader_opt(schema_ptr s,
 }
 
 flat_mutation_reader_v2
-memtable::make_flush_reader(schema_ptr s, reader_permit permit, const io_priority_class& pc) {
+memtable::make_flush_reader(schema_ptr s, reader_permit permit, const io_priority_class& pc, const dht::partition_range& range) {
     if (!_merged_into_cache) {
-        return make_flat_mutation_reader_v2<flush_reader>(std::move(s), std::move(permit), shared_from_this());
+        return make_flat_mutation_reader_v2<flush_reader>(std::move(s), std::move(permit), shared_from_this(), range);
     } else {
         auto& full_slice = s->full_slice();
         return make_flat_mutation_reader_v2<scanning_reader>(std::move(s), shared_from_this(), std::move(permit),
-                      query::full_partition_range, full_slice, pc, mutation_reader::forwarding::no);
+                      range, full_slice, pc, mutation_reader::forwarding::no);
     }
 }
 
@@ -788,15 +793,90 @@ memtable::apply(const mutation& m, db::rp_handle&& h) {
     update(std::move(h));
 }
 
+// Builds a mutation_partition from a frozen one, updating the encoding stats
+// as the data is visited instead of walking the built partition again.
+//
+// The partition is a scratch one, merged into the entry by
+// partition_entry::apply(). That gives strong exception guarantees and
+// compacts the existing rows with the incoming tombstones.
+class memtable::partition_applier final : public mutation_partition_visitor {
+    const ::schema& _schema;
+    mutation_partition& _partition;
+    memtable_encoding_stats_collector& _stats;
+    rows_entry::tri_compare _cmp;
+    deletable_row* _current_row = nullptr;
+private:
+    void apply_cell(row& r, const column_definition& cdef, atomic_cell_or_collection&& cell) {
+        _stats.update(cdef, cell);
+        r.apply(cdef, std::move(cell));
+    }
+public:
+    partition_applier(const ::schema& s, mutation_partition& p, memtable_encoding_stats_collector& stats)
+        : _schema(s)
+        , _partition(p)
+        , _stats(stats)
+        , _cmp(s)
+    { }
+
+    virtual void accept_partition_tombstone(tombstone t) override {
+        _stats.update(t);
+        _partition.apply(t);
+    }
+
+    virtual void accept_static_cell(column_id id, atomic_cell_view cell) override {
+        auto& cdef = _schema.static_column_at(id);
+        apply_cell(_partition.static_row().maybe_create(), cdef, atomic_cell(*cdef.type, cell));
+    }
+
+    virtual void accept_static_cell(column_id id, collection_mutation_view collection) override {
+        auto& cdef = _schema.static_column_at(id);
+        apply_cell(_partition.static_row().maybe_create(), cdef, collection_mutation(*cdef.type, collection));
+    }
+
+    virtual void accept_row_tombstone(const range_tombstone& rt) override {
+        _stats.update(rt);
+        _partition.apply_row_tombstone(_schema, rt);
+    }
+
+    virtual void accept_row(position_in_partition_view key, const row_tombstone& deleted_at, const row_marker& rm, is_dummy dummy, is_continuous continuous) override {
+        auto& rows = _partition.mutable_clustered_rows();
+        auto i = rows.end();
+        bool match = false;
+        // Frozen rows are sorted, so they are appended without a lookup.
+        if (!rows.empty() && _cmp(*std::prev(i), key) >= 0) {
+            i = rows.lower_bound(key, match, _cmp);
+        }
+        if (!match) {
+            auto e = alloc_strategy_unique_ptr<rows_entry>(current_allocator().construct<rows_entry>(_schema, key, dummy, continuous));
+            i = rows.insert_before(i, std::move(e));
+        }
+        _stats.update(rm);
+        _stats.update(deleted_at.regular());
+        _stats.update(deleted_at.tomb());
+        _current_row = &i->row();
+        _current_row->apply(rm);
+        _current_row->apply(deleted_at);
+    }
+
+    virtual void accept_row_cell(column_id id, atomic_cell_view cell) override {
+        auto& cdef = _schema.regular_column_at(id);
+        apply_cell(_current_row->cells(), cdef, atomic_cell(*cdef.type, cell));
+    }
+
+    virtual void accept_row_cell(column_id id, collection_mutation_view collection) override {
+        auto& cdef = _schema.regular_column_at(id);
+        apply_cell(_current_row->cells(), cdef, collection_mutation(*cdef.type, collection));
+    }
+};
+
 void
 memtable::apply(const frozen_mutation& m, const schema_ptr& m_schema, db::rp_handle&& h) {
     with_allocator(allocator(), [this, &m, &m_schema] {
         _allocating_section(*this, [&, this] {
             auto& p = find_or_create_partition_slow(m.key());
             mutation_partition mp(m_schema);
-            partition_builder pb(*m_schema, mp);
-            m.partition().accept(*m_schema, pb);
-            _stats_collector.update(*m_schema, mp);
+            partition_applier applier(*m_schema, mp, _stats_collector);
+            m.partition().accept(*m_schema, applier);
             p.apply(region(), cleaner(), *_schema, std::move(mp), *m_schema, _table_stats.memtable_app_stats);
         });
     });
@@ -143,6 +143,7 @@ class memtable final : public enable_lw_shared_from_this<memtable>, private dirt
 
         void update(tombstone tomb) noexcept;
 
+        void update(const column_definition& col, const atomic_cell_or_collection& item);
         void update(const ::schema& s, const row& r, column_kind kind);
         void update(const range_tombstone& rt) noexcept;
         void update(const row_marker& marker) noexcept;
@@ -158,6 +159,8 @@ class memtable final : public enable_lw_shared_from_this<memtable>, private dirt
         }
     } _stats_collector;
 
+    class partition_applier;
+
     void update(db::rp_handle&&);
     friend class ::row_cache;
     friend class memtable_entry;
@@ -190,6 +193,11 @@ class memtable final : public enable_lw_shared_from_this<memtable>, private dirt
     void apply(const mutation& m, db::rp_handle&& = {});
     // The mutation is upgraded to current schema.
     void apply(const frozen_mutation& m, const schema_ptr& m_schema, db::rp_handle&& = {});
+    // Makes the memtable hold the commitlog entry of a write which
+    // was merged into another write applied to the memtable.
+    void hold_replay_position(db::rp_handle&& h) {
+        update(std::move(h));
+    }
     void evict_entry(memtable_entry& e, mutation_cleaner& cleaner) noexcept;
 
     static memtable& from_region(logalloc::region& r) noexcept {
@@ -268,7 +276,11 @@ class memtable final : public enable_lw_shared_from_this<memtable>, private dirt
         return make_flat_reader(s, std::move(permit), range, full_slice);
     }
 
-    flat_mutation_reader_v2 make_flush_reader(schema_ptr, reader_permit permit, const io_priority_class& pc);
+    // Reads the partitions of the memtable for writing them to sstables, accounting them as flushed.
+    // Several flush readers for disjoint ranges may be used concurrently to flush a memtable
+    // into many sstables. The range must be kept alive by the caller while the reader is in use.
+    flat_mutation_reader_v2 make_flush_reader(schema_ptr, reader_permit permit, const io_priority_class& pc,
+                                              const dht::partition_range& range = query::full_partition_range);
 
     mutation_source as_data_source();
 
@@ -12,6 +12,7 @@
 #include <seastar/coroutine/exception.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
 #include <seastar/coroutine/as_future.hh>
+#include <seastar/core/later.hh>
 #include <seastar/util/closeable.hh>
 #include <seastar/util/defer.hh>
 
@@ -36,6 +37,7 @@
 #include "db/view/view.hh"
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/adaptor/map.hpp>
+#include <boost/range/irange.hpp>
 #include "utils/error_injection.hh"
 #include "utils/histogram_metrics_helper.hh"
 #include "utils/fb_utilities.hh"
@@ -54,6 +56,7 @@
 #include "readers/multi_range.hh"
 #include "readers/combined.hh"
 #include "readers/compacting.hh"
+#include "readers/filtering.hh"
 
 namespace replica {
 
@@ -142,6 +145,34 @@ table::find_row(schema_ptr s, reader_permit permit, const dht::decorated_key& pa
     });
 }
 
+// Drops partitions whose keys don't match the partition key filters of a slice.
+//
+// The replica ends a page based only on what it returns, so a scan which matches
+// few partitions would read its whole range in a single page. To bound that, every
+// max_consecutive_dropped-th partition is kept regardless, to be dropped by the
+// coordinator, which filters all results anyway.
+class partition_key_filtering {
+    static constexpr unsigned max_consecutive_dropped = 100;
+
+    schema_ptr _schema;
+    std::vector<query::partition_key_filter> _filters;
+    unsigned _dropped = 0;
+public:
+    partition_key_filtering(schema_ptr s, std::vector<query::partition_key_filter> filters)
+        : _schema(std::move(s))
+        , _filters(std::move(filters))
+    { }
+
+    bool operator()(const dht::decorated_key& dk) {
+        if (query::partition_key_matches(*_schema, dk.key(), _filters) || _dropped == max_consecutive_dropped) {
+            _dropped = 0;
+            return true;
+        }
+        ++_dropped;
+        return false;
+    }
+};
+
 flat_mutation_reader_v2
 table::make_reader_v2(schema_ptr s,
                            reader_permit permit,
@@ -205,6 +236,10 @@ table::make_reader_v2(schema_ptr s,
 
     auto rd = make_combined_reader(s, permit, std::move(readers), fwd, fwd_mr);
 
+    if (!slice.partition_key_filters().empty()) {
+        rd = make_filtering_reader(std::move(rd), partition_key_filtering(s, slice.partition_key_filters()));
+    }
+
     if (_config.data_listeners && !_config.data_listeners->empty()) {
         rd = _config.data_listeners->on_read(s, range, slice, std::move(rd));
     }
@@ -440,7 +475,7 @@ void table::enable_off_strategy_trigger() {
 future<>
 table::do_add_sstable_and_update_cache(sstables::shared_sstable sst, sstables::offstrategy offstrategy) {
     auto permit = co_await seastar::get_units(_sstable_set_mutation_sem, 1);
-    co_return co_await get_row_cache().invalidate(row_cache::external_updater([this, sst, offstrategy] () noexcept {
+    co_await get_row_cache().invalidate(row_cache::external_updater([this, sst, offstrategy] () noexcept {
         // FIXME: this is not really noexcept, but we need to provide strong exception guarantees.
         // atomically load all opened sstables into column family.
         if (!offstrategy) {
@@ -449,6 +484,9 @@ table::do_add_sstable_and_update_cache(sstables::shared_sstable sst, sstables::o
             add_maintenance_sstable(sst);
         }
     }), dht::partition_range::make({sst->get_first_decorated_key(), true}, {sst->get_last_decorated_key(), true}));
+    if (_config.data_listeners) {
+        co_await _config.data_listeners->on_external_update(_schema);
+    }
 }
 
 future<>
@@ -703,6 +741,29 @@ table::seal_active_memtable(flush_permit&& flush_permit) noexcept {
     // FIXME: provide back-pressure to upper layers
 }
 
+// Splits the ring into ranges which are flushed concurrently, each into its own sstable(s),
+// so that flushing a large memtable isn't bound by the throughput of a single writer.
+// Tokens are spread evenly over the ring, so ranges of equal width hold similar amounts of data.
+static dht::partition_range_vector make_flush_ranges(const memtable& mt, unsigned parallelism) {
+    static constexpr size_t min_flush_range_size = 16 << 20;
+    auto count = std::min<size_t>(parallelism, mt.occupancy().used_space() / min_flush_range_size);
+    if (count <= 1) {
+        return {query::full_partition_range};
+    }
+    dht::partition_range_vector ranges;
+    ranges.reserve(count);
+    const auto width = std::numeric_limits<uint64_t>::max() / count;
+    std::optional<dht::partition_range::bound> start;
+    for (size_t i = 1; i < count; ++i) {
+        auto t = dht::token::from_int64(int64_t(uint64_t(std::numeric_limits<int64_t>::min()) + width * i));
+        auto pos = dht::ring_position::starting_at(t);
+        ranges.emplace_back(std::move(start), dht::partition_range::bound(pos, false));
+        start = dht::partition_range::bound(std::move(pos), true);
+    }
+    ranges.emplace_back(std::move(start), std::nullopt);
+    return ranges;
+}
+
 future<>
 table::try_flush_memtable_to_sstable(lw_shared_ptr<memtable> old, sstable_write_permit&& permit) {
     auto try_flush = [this, old = std::move(old), permit = make_lw_shared(std::move(permit))] () mutable -> future<> {
@@ -722,9 +783,11 @@ table::try_flush_memtable_to_sstable(lw_shared_ptr<memtable> old, sstable_write_
         auto metadata = mutation_source_metadata{};
         metadata.min_timestamp = old->get_min_timestamp();
         metadata.max_timestamp = old->get_max_timestamp();
-        auto estimated_partitions = _compaction_strategy.adjust_partition_estimate(metadata, old->partition_count());
+        // Must be kept alive as long as the readers.
+        const auto ranges = make_flush_ranges(*old, _config.memtable_flush_parallelism());
+        auto estimated_partitions = _compaction_strategy.adjust_partition_estimate(metadata, old->partition_count() / ranges.size());
 
-        auto consumer = _compaction_strategy.make_interposer_consumer(metadata, [this, old, permit, &newtabs, metadata, estimated_partitions] (flat_mutation_reader_v2 reader) mutable -> future<> {
+        auto write_sstable = [this, old, permit, &newtabs, metadata, estimated_partitions] (flat_mutation_reader_v2 reader) mutable -> future<> {
           std::exception_ptr ex;
           try {
             auto&& priority = service::get_local_memtable_flush_priority();
@@ -744,25 +807,40 @@ table::try_flush_memtable_to_sstable(lw_shared_ptr<memtable> old, sstable_write_
           }
           co_await reader.close();
           co_await coroutine::return_exception_ptr(std::move(ex));
-        });
-
-        auto reader = old->make_flush_reader(
-            old->schema(),
-            compaction_concurrency_semaphore().make_tracking_only_permit(old->schema().get(), "try_flush_memtable_to_sstable()", db::no_timeout),
-            service::get_local_memtable_flush_priority());
+        };
 
-        if (old->has_any_tombstones()) {
-            reader = make_compacting_reader(
-                std::move(reader),
-                gc_clock::now(),
-                [] (const dht::decorated_key&) { return api::min_timestamp; });
-        }
+        std::vector<flat_mutation_reader_v2> readers;
+        readers.reserve(ranges.size());
+        // Interposer consumers may be invoked only once, so each range gets its own.
+        std::vector<reader_consumer_v2> consumers;
+        consumers.reserve(ranges.size());
 
         std::exception_ptr err;
         try {
-            auto* fragment = co_await reader.peek();
-            if (!fragment) {
-                co_await reader.close();
+            for (auto& range : ranges) {
+                auto reader = old->make_flush_reader(
+                    old->schema(),
+                    compaction_concurrency_semaphore().make_tracking_only_permit(old->schema().get(), "try_flush_memtable_to_sstable()", db::no_timeout),
+                    service::get_local_memtable_flush_priority(),
+                    range);
+
+                if (old->has_any_tombstones()) {
+                    reader = make_compacting_reader(
+                        std::move(reader),
+                        gc_clock::now(),
+                        [] (const dht::decorated_key&) { return api::min_timestamp; });
+                }
+                readers.push_back(std::move(reader));
+
+                auto* fragment = co_await readers.back().peek();
+                if (!fragment) {
+                    co_await readers.back().close();
+                    readers.pop_back();
+                    continue;
+                }
+                consumers.push_back(_compaction_strategy.make_interposer_consumer(metadata, write_sstable));
+            }
+            if (readers.empty()) {
                 _memtables->erase(old);
                 co_return;
             }
@@ -774,11 +852,15 @@ table::try_flush_memtable_to_sstable(lw_shared_ptr<memtable> old, sstable_write_
         }
         if (err) {
             tlogger.error("failed to flush memtable for {}.{}: {}", old->schema()->ks_name(), old->schema()->cf_name(), err);
-            co_await reader.close();
+            co_await coroutine::parallel_for_each(readers, [] (flat_mutation_reader_v2& reader) {
+                return reader.close();
+            });
             co_await coroutine::return_exception_ptr(std::move(err));
         }
 
-        auto f = consumer(std::move(reader));
+        auto f = parallel_for_each(boost::irange(readers.size()), [&readers, &consumers] (size_t i) {
+            return consumers[i](std::move(readers[i]));
+        });
 
         // Switch back to default scheduling group for post-flush actions, to avoid them being staved by the memtable flush
         // controller. Cache update does not affect the input of the memtable cpu controller, so it can be subject to
@@ -825,6 +907,7 @@ table::stop() {
     if (_async_gate.is_closed()) {
         return make_ready_future<>();
     }
+    _non_durable_flush_timer.cancel();
     return _async_gate.close().then([this] {
         return await_pending_ops().finally([this] {
             return _memtables->flush().finally([this] {
@@ -853,8 +936,12 @@ void table::set_metrics() {
     if (_config.enable_metrics_reporting) {
         _metrics.add_group("column_family", {
                 ms::make_counter("memtable_switch", ms::description("Number of times flush has resulted in the memtable being switched out"), _stats.memtable_switch_count)(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("non_durable_flushes", ms::description("Number of flushes forced to bound the data lost on a crash, by tables which don't use the commitlog"), _stats.non_durable_flushes)(cf)(ks).set_skip_when_empty(),
+                ms::make_gauge("non_durable_bytes", ms::description("Bytes of memtables which would be lost on a crash, for tables which don't use the commitlog"),
+                        [this] { return _commitlog && durable_writes() ? 0 : occupancy().used_space(); })(cf)(ks),
                 ms::make_counter("memtable_partition_writes", [this] () { return _stats.memtable_partition_insertions + _stats.memtable_partition_hits; }, ms::description("Number of write operations performed on partitions in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_partition_hits", _stats.memtable_partition_hits, ms::description("Number of times a write operation was issued on an existing partition in memtables"))(cf)(ks).set_skip_when_empty(),
+                ms::make_counter("memtable_coalesced_writes", _stats.memtable_coalesced_writes, ms::description("Number of writes applied to memtables along with a concurrent write to the same partition"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_row_writes", _stats.memtable_app_stats.row_writes, ms::description("Number of row writes performed in memtables"))(cf)(ks).set_skip_when_empty(),
                 ms::make_counter("memtable_row_hits", _stats.memtable_app_stats.row_hits, ms::description("Number of rows overwritten by write operations in memtables"))(cf)(ks).set_skip_when_empty().set_skip_when_empty(),
                 ms::make_counter("memtable_rows_dropped_by_tombstones", _stats.memtable_app_stats.rows_dropped_by_tombstones, ms::description("Number of rows dropped in memtables by a tombstone write"))(cf)(ks).set_skip_when_empty(),
@@ -903,8 +990,16 @@ void table::set_metrics() {
                     ms::make_histogram("cas_prepare_latency", ms::description("CAS prepare round latency histogram"), [this] {return to_metrics_histogram(_stats.cas_prepare.histogram());})(cf)(ks).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
                     ms::make_histogram("cas_propose_latency", ms::description("CAS accept round latency histogram"), [this] {return to_metrics_histogram(_stats.cas_accept.histogram());})(cf)(ks).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
                     ms::make_histogram("cas_commit_latency", ms::description("CAS learn round latency histogram"), [this] {return to_metrics_histogram(_stats.cas_learn.histogram());})(cf)(ks).aggregate({seastar::metrics::shard_label}).set_skip_when_empty(),
-                    ms::make_gauge("cache_hit_rate", ms::description("Cache hit rate"), [this] {return float(_global_cache_hit_rate);})(cf)(ks)
+                    ms::make_gauge("cache_hit_rate", ms::description("Cache hit rate"), [this] {return float(_global_cache_hit_rate);})(cf)(ks),
+                    ms::make_counter("cache_partition_hits", ms::description("Number of partitions needed by reads and found in cache"), [this] {return _cache.stats().hits.count();})(cf)(ks).set_skip_when_empty(),
+                    ms::make_counter("cache_partition_misses", ms::description("Number of partitions needed by reads and missing in cache"), [this] {return _cache.stats().misses.count();})(cf)(ks).set_skip_when_empty(),
             });
+            if (_dedicated_cache_tracker) {
+                _metrics.add_group("column_family", {
+                    ms::make_gauge("cache_bytes_used", ms::description("Memory used by the cache of the table, which is bounded by its caching options"),
+                            [this] {return _dedicated_cache_tracker->region().occupancy().used_space();})(cf)(ks),
+                });
+            }
         }
     }
 }
@@ -1114,6 +1209,25 @@ void table::trigger_offstrategy_compaction() {
     });
 }
 
+void table::update_non_durable_flush_timer() {
+    _non_durable_flush_timer.cancel();
+    if (auto period = _schema->non_durable_writes_flush_period(); period && _config.enable_disk_writes) {
+        _non_durable_flush_timer.arm_periodic(std::chrono::duration_cast<lowres_clock::duration>(*period));
+    }
+}
+
+void table::on_non_durable_flush_timer() {
+    if (_async_gate.is_closed() || !_memtables->can_flush() || _memtables->back()->empty()) {
+        return;
+    }
+    _stats.non_durable_flushes++;
+    (void)with_gate(_async_gate, [this] {
+        return flush().handle_exception([this] (std::exception_ptr ep) {
+            tlogger.warn("Periodic flush of {}.{}, which doesn't use the commitlog, failed: {}", _schema->ks_name(), _schema->cf_name(), ep);
+        });
+    });
+}
+
 future<bool> table::perform_offstrategy_compaction() {
     // If the user calls trigger_offstrategy_compaction() to trigger
     // off-strategy explicitly, cancel the timeout based automatic trigger.
@@ -1205,6 +1319,22 @@ std::vector<sstables::shared_sstable> table::select_sstables(const dht::partitio
     return _sstables->select(range);
 }
 
+bool table::may_have_tombstones(const dht::token_range& range) const {
+    for (auto& mt : *_memtables) {
+        if (!mt->empty() && mt->get_encoding_stats().min_local_deletion_time != gc_clock::time_point::max()) {
+            return true;
+        }
+    }
+    // The tombstone histogram also accounts for expiring cells, both turn into
+    // something purgeable eventually.
+    for (auto& sst : _sstables->select(dht::to_partition_range(range))) {
+        if (!sst->get_stats_metadata().estimated_tombstone_drop_time.bin.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // Gets the list of all sstables in the column family, including ones that are
 // not used for active queries because they have already been compacted, but are
 // waiting for delete_atomically() to return.
@@ -1242,6 +1372,17 @@ table::make_memtable_list() {
     return make_lw_shared<memtable_list>(std::move(seal), std::move(get_schema), _config.dirty_memory_manager, _stats, _config.memory_compaction_scheduling_group);
 }
 
+static std::unique_ptr<cache_tracker> make_dedicated_cache_tracker(const schema& s, const table::config& cfg) {
+    auto& co = s.caching_options();
+    if (!co.has_memory_bounds()) {
+        return nullptr;
+    }
+    auto tracker = std::make_unique<cache_tracker>();
+    tracker->set_memory_limits(co.reserved_memory(), co.max_memory());
+    tracker->set_compaction_scheduling_group(cfg.memory_compaction_scheduling_group);
+    return tracker;
+}
+
 table::table(schema_ptr schema, config config, db::commitlog* cl, compaction_manager& compaction_manager,
         sstables::sstables_manager& sst_manager, cell_locker_stats& cl_stats, cache_tracker& row_cache_tracker)
     : _schema(std::move(schema))
@@ -1255,7 +1396,8 @@ table::table(schema_ptr schema, config config, db::commitlog* cl, compaction_man
     , _main_sstables(make_lw_shared<sstables::sstable_set>(_compaction_strategy.make_sstable_set(_schema)))
     , _maintenance_sstables(make_maintenance_sstable_set())
     , _sstables(make_compound_sstable_set())
-    , _cache(_schema, sstables_as_snapshot_source(), row_cache_tracker, is_continuous::yes)
+    , _dedicated_cache_tracker(make_dedicated_cache_tracker(*_schema, _config))
+    , _cache(_schema, sstables_as_snapshot_source(), _dedicated_cache_tracker ? *_dedicated_cache_tracker : row_cache_tracker, is_continuous::yes)
     , _commitlog(cl)
     , _durable_writes(true)
     , _compaction_manager(compaction_manager)
@@ -1265,10 +1407,12 @@ table::table(schema_ptr schema, config config, db::commitlog* cl, compaction_man
     , _table_state(std::make_unique<table_state>(*this))
     , _row_locker(_schema)
     , _off_strategy_trigger([this] { trigger_offstrategy_compaction(); })
+    , _non_durable_flush_timer([this] { on_non_durable_flush_timer(); })
 {
     if (!_config.enable_disk_writes) {
         tlogger.warn("Writes disabled, column family no durable.");
     }
+    update_non_durable_flush_timer();
     set_metrics();
     _compaction_manager.add(as_table_state());
 
@@ -1595,6 +1739,9 @@ future<> table::clear() {
         co_await smt->clear_gently();
     }
     co_await _cache.invalidate(row_cache::external_updater([] { /* There is no underlying mutation source */ }));
+    if (_config.data_listeners) {
+        co_await _config.data_listeners->on_external_update(_schema);
+    }
 }
 
 // NOTE: does not need to be futurized, but might eventually, depending on
@@ -1644,7 +1791,9 @@ future<db::replay_position> table::discard_sstables(db_clock::time_point truncat
     return _cache.invalidate(row_cache::external_updater([p, truncated_at] {
         p->prune(truncated_at);
         tlogger.debug("cleaning out row cache");
-    })).then([this, p]() mutable {
+    })).then([this] {
+        return _config.data_listeners ? _config.data_listeners->on_external_update(_schema) : make_ready_future<>();
+    }).then([this, p]() mutable {
         rebuild_statistics();
 
         return parallel_for_each(p->remove, [this](pruner::removed_sstable& r) {
@@ -1668,6 +1817,12 @@ void table::set_schema(schema_ptr s) {
     }
 
     _cache.set_schema(s);
+    auto& co = s->caching_options();
+    if (_dedicated_cache_tracker) {
+        _dedicated_cache_tracker->set_memory_limits(co.reserved_memory(), co.max_memory());
+    } else if (co.has_memory_bounds()) {
+        tlogger.info("Cache memory bounds of {}.{} will take effect when the table is loaded again", s->ks_name(), s->cf_name());
+    }
     if (_counter_cell_locks) {
         _counter_cell_locks->set_schema(s);
     }
@@ -1680,6 +1835,7 @@ void table::set_schema(schema_ptr s) {
 
     set_compaction_strategy(_schema->compaction_strategy());
     update_optimized_twcs_queries_flag();
+    update_non_durable_flush_timer();
     trigger_compaction();
 }
 
@@ -1934,6 +2090,39 @@ size_t table::estimate_read_memory_cost() const {
     return new_reader_base_cost;
 }
 
+// Reads of at most this many partitions and rows may be cheap.
+static constexpr size_t cheap_read_max_partitions = 4;
+static constexpr size_t cheap_read_max_rows = 1000;
+
+reader_concurrency_semaphore::read_class table::estimate_read_class(const dht::partition_range_vector& ranges,
+        const query::partition_slice& slice) const {
+    using read_class = reader_concurrency_semaphore::read_class;
+    if (ranges.empty() || ranges.size() > cheap_read_max_partitions || slice.is_reversed()) {
+        return read_class::normal;
+    }
+    for (auto& pr : ranges) {
+        if (!pr.is_singular() || !pr.start()->value().has_key()) {
+            return read_class::normal;
+        }
+    }
+    // Partitions of tables without clustering columns have a single row.
+    if (!_schema->clustering_key_size()) {
+        return read_class::cheap;
+    }
+    // Otherwise only reads of given rows are cheap, the page size
+    // doesn't bound the work of a read which filters rows out.
+    auto& row_ranges = slice.default_row_ranges();
+    if (slice.get_specific_ranges() || row_ranges.empty() || row_ranges.size() * ranges.size() > cheap_read_max_rows) {
+        return read_class::normal;
+    }
+    for (auto& r : row_ranges) {
+        if (!r.is_singular() || !r.start()->value().is_full(*_schema)) {
+            return read_class::normal;
+        }
+    }
+    return read_class::cheap;
+}
+
 void table::set_hit_rate(gms::inet_address addr, cache_temperature rate) {
     auto& e = _cluster_cache_hit_rates[addr];
     e.rate = rate;
@@ -2018,11 +2207,61 @@ future<> table::apply(const frozen_mutation& m, schema_ptr m_schema, db::rp_hand
         return (*_virtual_writer)(m);
     }
 
+    if (_config.coalesce_partition_writes()) {
+        return apply_coalesced(m, std::move(m_schema), std::move(h), timeout);
+    }
+
     return dirty_memory_region_group().run_when_memory_available([this, &m, m_schema = std::move(m_schema), h = std::move(h)]() mutable {
         do_apply(std::move(h), m, m_schema);
     }, timeout);
 }
 
+// Bursts of writes to a single partition each allocate in the memtable's
+// region and apply to the partition on their own. Instead, a write waits
+// until the tasks which are ready when it arrives have run, and until
+// the memtable accepts writes; writes to the same partition which arrive
+// meanwhile are merged into it and applied along with it.
+future<> table::apply_coalesced(const frozen_mutation& m, schema_ptr m_schema, db::rp_handle&& h, db::timeout_clock::time_point timeout) {
+    auto dk = m.decorated_key(*m_schema);
+    auto same_partition = [&] (const pending_partition_writes& w) {
+        return w.m.schema() == m_schema && w.m.decorated_key().equal(*m_schema, dk);
+    };
+    if (auto w = _pending_partition_writes.find(dk.token(), same_partition)) {
+        w->m.apply(m.unfreeze(m_schema));
+        w->handles.push_back(std::move(h));
+        ++_stats.memtable_coalesced_writes;
+        co_return co_await w->applied.get_shared_future();
+    }
+
+    auto w = make_lw_shared<pending_partition_writes>(m.unfreeze(m_schema));
+    w->handles.push_back(std::move(h));
+    auto registration = _pending_partition_writes.add(dk.token(), w);
+    try {
+        co_await yield();
+        co_await dirty_memory_region_group().run_when_memory_available([this, w, &registration] {
+            registration.release();
+            // The memtable holds the commitlog entries of all merged writes,
+            // and is flushed before the segment holding any of them is freed.
+            auto handles = std::move(w->handles);
+            auto last = std::max_element(handles.begin(), handles.end(), [] (const db::rp_handle& a, const db::rp_handle& b) {
+                return a.rp() < b.rp();
+            });
+            auto h = std::move(*last);
+            for (auto& other : handles) {
+                if (other) {
+                    check_valid_rp(other.rp());
+                    _memtables->active_memtable().hold_replay_position(std::move(other));
+                }
+            }
+            do_apply(std::move(h), w->m);
+        }, timeout);
+    } catch (...) {
+        w->applied.set_exception(std::current_exception());
+        throw;
+    }
+    w->applied.set_value();
+}
+
 template void table::do_apply(db::rp_handle&&, const frozen_mutation&, const schema_ptr&);
 
 future<>
@@ -2114,6 +2353,7 @@ table::query(schema_ptr s,
 
     auto finally = defer([&] () noexcept {
         _stats.reads.mark(lc);
+        _config.cf_stats->read_latency.mark(lc.latency());
         _async_gate.leave();
     });
 
@@ -2234,6 +2474,17 @@ void table::add_coordinator_read_latency(utils::estimated_histogram::duration la
     _stats.estimated_coordinator_read.add(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
 }
 
+void table::add_range_scan_rows_per_range(double rows_per_range) {
+    _range_scan_rows_per_range = _range_scan_rows_per_range < 0 ? rows_per_range : 0.75 * _range_scan_rows_per_range + 0.25 * rows_per_range;
+}
+
+std::optional<double> table::get_range_scan_rows_per_range() const {
+    if (_range_scan_rows_per_range < 0) {
+        return std::nullopt;
+    }
+    return _range_scan_rows_per_range;
+}
+
 std::chrono::milliseconds table::get_coordinator_read_latency_percentile(double percentile) {
     if (_cached_percentile != percentile || lowres_clock::now() - _percentile_cache_timestamp > 1s) {
         _percentile_cache_timestamp = lowres_clock::now();
@@ -2370,6 +2621,9 @@ future<row_locker::lock_holder> table::do_push_view_replica_updates(schema_ptr s
         now -= 10s;
     });
     auto views = db::view::with_base_info_snapshot(affected_views(base, m));
+    std::erase_if(views, [&] (const db::view::view_and_base& v) {
+        return !db::view::columns_may_affect_view(*base, *v.view->view_info(), m);
+    });
     if (views.empty()) {
         co_return row_locker::lock_holder();
     }
@@ -2418,6 +2672,42 @@ future<row_locker::lock_holder> table::push_view_replica_updates(const schema_pt
             std::move(tr_state), sem, service::get_local_sstable_query_read_priority(), {});
 }
 
+// Each write to a table with views reads the base rows it modifies before
+// generating its view updates. Instead, a write waits until the tasks which
+// are ready when it arrives have run; writes to the same partition arriving
+// meanwhile are merged into it, and the view updates of the merged mutation
+// are generated with a single read covering the rows of all of them. The
+// base partition stays locked until all of them are applied.
+future<lw_shared_ptr<row_locker::lock_holder>> table::push_view_replica_updates_batched(const schema_ptr& s, const frozen_mutation& fm,
+        db::timeout_clock::time_point timeout, tracing::trace_state_ptr tr_state, reader_concurrency_semaphore& sem) {
+    auto dk = fm.decorated_key(*s);
+    auto same_partition = [&] (const view_update_batch& b) {
+        return b.m.schema() == s && b.m.decorated_key().equal(*s, dk);
+    };
+    if (auto b = _view_update_batches.find(dk.token(), same_partition)) {
+        b->m.apply(fm.unfreeze(s));
+        ++_config.cf_stats->batched_view_updates;
+        tracing::trace(tr_state, "View updates are generated along with a concurrent write to the same partition");
+        co_await b->generated.get_shared_future(timeout);
+        co_return b->lock;
+    }
+
+    auto b = make_lw_shared<view_update_batch>(fm.unfreeze(s));
+    auto registration = _view_update_batches.add(dk.token(), b);
+    co_await yield();
+    registration.release();
+
+    try {
+        auto lock = co_await push_view_replica_updates(s, std::move(b->m), timeout, std::move(tr_state), sem);
+        b->lock = make_lw_shared<row_locker::lock_holder>(std::move(lock));
+        b->generated.set_value();
+    } catch (...) {
+        b->generated.set_exception(std::current_exception());
+        throw;
+    }
+    co_return b->lock;
+}
+
 future<row_locker::lock_holder>
 table::stream_view_replica_updates(const schema_ptr& s, mutation&& m, db::timeout_clock::time_point timeout,
         std::vector<sstables::shared_sstable>& excluded_sstables) const {
@@ -2493,6 +2783,9 @@ class table::table_state : public compaction::table_state {
     sstables::shared_sstable make_sstable() const override {
         return _t.make_sstable();
     }
+    sstables::shared_sstable make_cold_sstable() const override {
+        return _t.make_sstable(_t.dir() + "/" + sstables::cold_dir);
+    }
     sstables::sstable_writer_config configure_writer(sstring origin) const override {
         return _t.get_sstables_manager().configure_writer(std::move(origin));
     }
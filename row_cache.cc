@@ -24,6 +24,7 @@
 #include "readers/nonforwardable.hh"
 #include "cache_flat_mutation_reader.hh"
 #include "clustering_key_filter.hh"
+#include "utils/code_region.hh"
 
 namespace cache {
 
@@ -79,6 +80,9 @@ cache_tracker::cache_tracker(mutation_application_stats& app_stats, register_met
                 _memtable_cleaner.clear_some();
                 return memory::reclaiming_result::reclaimed_something;
             }
+            if (_reserved_memory && _region.occupancy().used_space() <= _reserved_memory) {
+                return memory::reclaiming_result::reclaimed_nothing;
+            }
             current_tracker = this;
             return _lru.evict();
            } catch (std::bad_alloc&) {
@@ -123,6 +127,11 @@ cache_tracker::setup_metrics() {
         sm::make_counter("partition_evictions", sm::description("total number of evicted partitions"), _stats.partition_evictions),
         sm::make_counter("partition_removals", sm::description("total number of invalidated partitions"), _stats.partition_removals),
         sm::make_counter("mispopulations", sm::description("number of entries not inserted by reads"), _stats.mispopulations),
+        sm::make_counter("absent_partition_hits", sm::description("number of partitions needed by reads and known to be absent"), [this] { return _absent_partitions.get_stats().hits; }),
+        sm::make_counter("absent_partition_insertions", sm::description("total number of partitions remembered to be absent"), [this] { return _absent_partitions.get_stats().insertions; }),
+        sm::make_gauge("absent_partitions", sm::description("number of partitions currently remembered to be absent"), [this] { return _absent_partitions.size(); }),
+        sm::make_counter("frequency_admissions", sm::description("number of entries admitted to the protected segment of cache at the expense of less frequently used ones"), [this] { return _lru.admissions(); }),
+        sm::make_counter("frequency_demotions", sm::description("number of entries moved back from the protected segment of cache once no longer used frequently"), [this] { return _lru.demotions(); }),
         sm::make_gauge("partitions", sm::description("total number of cached partitions"), _stats.partitions),
         sm::make_gauge("rows", sm::description("total number of cached rows"), _stats.rows),
         sm::make_counter("reads", sm::description("number of started reads"), _stats.reads),
@@ -142,6 +151,10 @@ cache_tracker::setup_metrics() {
             sm::description("total amount of range tombstones processed during read")),
         sm::make_counter("row_tombstone_reads", _stats.row_tombstone_reads,
             sm::description("total amount of row tombstones processed during read")),
+        sm::make_counter("partition_snapshot_reads", _stats.partition_snapshot_reads,
+            sm::description("total number of reads of cached partitions")),
+        sm::make_counter("partition_snapshot_versions", _stats.partition_snapshot_versions,
+            sm::description("total number of partition versions merged by reads of cached partitions, divide by partition_snapshot_reads to get the average number of versions merged per read")),
     });
 }
 
@@ -164,11 +177,33 @@ void cache_tracker::clear() {
     allocator().invalidate_references();
 }
 
+void cache_tracker::set_memory_limits(size_t reserved_memory, size_t max_memory) noexcept {
+    _reserved_memory = reserved_memory;
+    _max_memory = max_memory;
+}
+
+void cache_tracker::enforce_memory_limit() noexcept {
+    if (!_max_memory || _region.occupancy().used_space() <= _max_memory) {
+        return;
+    }
+    // Bounds the work done at once; the limit is enforced on every read and update
+    // of the cache, so the excess doesn't accumulate.
+    static constexpr unsigned max_evictions = 1024;
+    with_allocator(_region.allocator(), [this] {
+        current_tracker = this;
+        for (unsigned i = 0; i < max_evictions && _region.occupancy().used_space() > _max_memory; ++i) {
+            if (_lru.evict() == memory::reclaiming_result::reclaimed_nothing) {
+                break;
+            }
+        }
+    });
+    allocator().invalidate_references();
+}
+
 void cache_tracker::touch(rows_entry& e) {
     // last dummy may not be linked if evicted, but
-    // the unlink_from_lru() handles it
-    e.unlink_from_lru();
-    _lru.add(e);
+    // lru::touch() handles it
+    _lru.touch(e);
 }
 
 void cache_tracker::insert(cache_entry& entry) {
@@ -370,14 +405,19 @@ class single_partition_populating_reader final : public flat_mutation_reader_v2:
     future<> create_reader() {
         auto src_and_phase = _cache.snapshot_of(_read_context->range().start()->value());
         auto phase = src_and_phase.phase;
+        auto epoch = _cache._absent_epoch;
         _read_context->enter_partition(_read_context->range().start()->value().as_decorated_key(), src_and_phase.snapshot, phase);
-        return _read_context->create_underlying().then([this, phase] {
-          return _read_context->underlying().underlying()().then([this, phase] (auto&& mfopt) {
+        return _read_context->create_underlying().then([this, phase, epoch] {
+          return _read_context->underlying().underlying()().then([this, phase, epoch] (auto&& mfopt) {
             if (!mfopt) {
                 if (phase == _cache.phase_of(_read_context->range().start()->value())) {
-                    _cache._read_section(_cache._tracker.region(), [this] {
-                        _cache.find_or_create_missing(_read_context->key());
-                    });
+                    if (_cache._tracker.absent_partitions().enabled()) {
+                        _cache._tracker.absent_partitions().insert(epoch, _read_context->key());
+                    } else {
+                        _cache._read_section(_cache._tracker.region(), [this] {
+                            _cache.find_or_create_missing(_read_context->key());
+                        });
+                    }
                 } else {
                     _cache._tracker.on_mispopulate();
                 }
@@ -739,6 +779,8 @@ row_cache::make_reader_opt(schema_ptr s,
                        streamed_mutation::forwarding fwd,
                        mutation_reader::forwarding fwd_mr)
 {
+    _tracker.enforce_memory_limit();
+
     auto make_context = [&] {
         return std::make_unique<read_context>(*this, s, std::move(permit), range, slice, pc, trace_state, fwd_mr);
     };
@@ -758,6 +800,10 @@ row_cache::make_reader_opt(schema_ptr s,
                 return e.read(*this, make_context());
             } else if (i->continuous()) {
                 return {};
+            } else if (_tracker.absent_partitions().contains(_absent_epoch, pos.as_decorated_key())) {
+                tracing::trace(trace_state, "Partition {} known to be absent", range);
+                on_partition_hit();
+                return {};
             } else {
                 tracing::trace(trace_state, "Range {} not found in cache", range);
                 on_partition_miss();
@@ -793,7 +839,18 @@ row_cache::~row_cache() {
     });
 }
 
+void row_cache::forget_absent_partitions() noexcept {
+    _absent_epoch = _tracker.absent_partitions().new_epoch();
+}
+
+void row_cache::forget_absent_partition(const dht::decorated_key& dk) noexcept {
+    if (!_tracker.absent_partitions().erase(_absent_epoch, dk)) {
+        forget_absent_partitions();
+    }
+}
+
 void row_cache::clear_now() noexcept {
+    forget_absent_partitions();
     with_allocator(_tracker.allocator(), [this] {
         auto it = _partitions.erase_and_dispose(_partitions.begin(), partitions_end(), [this] (cache_entry* p) noexcept {
             _tracker.on_partition_erase();
@@ -963,6 +1020,7 @@ future<> row_cache::do_update(external_updater eu, replica::memtable& m, Updater
         partition_presence_checker is_present = _prev_snapshot->make_partition_presence_checker();
         while (!m.partitions.empty()) {
             with_allocator(_tracker.allocator(), [&] () {
+                utils::code_region_timer region_timer(utils::code_region::cache_update);
                 auto cmp = dht::ring_position_comparator(*_schema);
                 {
                     size_t partition_count = 0;
@@ -980,6 +1038,7 @@ future<> row_cache::do_update(external_updater eu, replica::memtable& m, Updater
                                     size_entry = mem_e.size_in_allocator_without_rows(_tracker.allocator());
                                     partitions_type::bound_hint hint;
                                     auto cache_i = _partitions.lower_bound(mem_e.key(), cmp, hint);
+                                    forget_absent_partition(mem_e.key());
                                     update = updater(_update_section, cache_i, mem_e, is_present, real_dirty_acc, hint);
                                 });
                             }
@@ -993,6 +1052,8 @@ future<> row_cache::do_update(external_updater eu, replica::memtable& m, Updater
                             real_dirty_acc.unpin_memory(size_entry);
                             _update_section(_tracker.region(), [&] {
                                 auto i = m.partitions.begin();
+                                // A read may have found the partition absent while the update of it was preempted.
+                                forget_absent_partition(i->key());
                                 i.erase_and_dispose(dht::raw_token_less_comparator{}, [&] (replica::memtable_entry* e) noexcept {
                                     m.evict_entry(*e, _tracker.memtable_cleaner());
                                 });
@@ -1022,6 +1083,7 @@ future<> row_cache::do_update(external_updater eu, replica::memtable& m, Updater
 }
 
 future<> row_cache::update(external_updater eu, replica::memtable& m) {
+    _tracker.enforce_memory_limit();
     return do_update(std::move(eu), m, [this] (logalloc::allocating_section& alloc,
             row_cache::partitions_type::iterator cache_i, replica::memtable_entry& mem_e, partition_presence_checker& is_present,
             real_dirty_memory_accounter& acc, const partitions_type::bound_hint& hint) mutable {
@@ -1104,6 +1166,7 @@ void row_cache::unlink_from_lru(const dht::decorated_key& dk) {
 }
 
 void row_cache::invalidate_locked(const dht::decorated_key& dk) {
+    forget_absent_partition(dk);
     auto pos = _partitions.lower_bound(dk, dht::ring_position_comparator(*_schema));
     if (pos == partitions_end() || !pos->key().equal(*_schema, dk)) {
         _tracker.clear_continuity(*pos);
@@ -1133,6 +1196,13 @@ future<> row_cache::invalidate(external_updater eu, dht::partition_range_vector&
                 _prev_snapshot_pos = {};
                 _prev_snapshot = {};
             });
+            // Absent partitions are not tracked by range, so forget all of them. Reads which
+            // happen during invalidation may find partitions absent in the old snapshot, so
+            // forget them again when done.
+            forget_absent_partitions();
+            auto forget_absent_when_done = defer([this] () noexcept {
+                forget_absent_partitions();
+            });
 
             for (auto&& range : ranges) {
                 _prev_snapshot_pos = dht::ring_position_view::for_range_start(range);
@@ -1187,6 +1257,7 @@ row_cache::row_cache(schema_ptr s, snapshot_source src, cache_tracker& tracker,
     , _schema(std::move(s))
     , _partitions(dht::raw_token_less_comparator{})
     , _underlying(src())
+    , _absent_epoch(tracker.absent_partitions().new_epoch())
     , _snapshot_source(std::move(src))
 {
     with_allocator(_tracker.allocator(), [this, cont] {
@@ -1287,6 +1358,7 @@ flat_mutation_reader_v2 cache_entry::read(row_cache& rc, std::unique_ptr<read_co
 // Assumes reader is in the corresponding partition
 flat_mutation_reader_v2 cache_entry::do_read(row_cache& rc, read_context& reader) {
     auto snp = _pe.read(rc._tracker.region(), rc._tracker.cleaner(), _schema, &rc._tracker, reader.phase());
+    rc._tracker.on_partition_snapshot_read(snp->version_count());
     auto ckr = query::clustering_key_filter_ranges::get_native_ranges(*_schema, reader.native_slice(), _key.key());
     schema_ptr entry_schema = to_query_domain(reader.slice(), _schema);
     auto r = make_cache_flat_mutation_reader(entry_schema, _key, std::move(ckr), rc, reader, std::move(snp));
@@ -1297,6 +1369,7 @@ flat_mutation_reader_v2 cache_entry::do_read(row_cache& rc, read_context& reader
 
 flat_mutation_reader_v2 cache_entry::do_read(row_cache& rc, std::unique_ptr<read_context> unique_ctx) {
     auto snp = _pe.read(rc._tracker.region(), rc._tracker.cleaner(), _schema, &rc._tracker, unique_ctx->phase());
+    rc._tracker.on_partition_snapshot_read(snp->version_count());
     auto ckr = query::clustering_key_filter_ranges::get_native_ranges(*_schema, unique_ctx->native_slice(), _key.key());
     schema_ptr reader_schema = unique_ctx->schema();
     schema_ptr entry_schema = to_query_domain(unique_ctx->slice(), _schema);
@@ -244,6 +244,9 @@ class row_cache final {
 
     mutation_source _underlying;
     phase_type _underlying_phase = partition_snapshot::min_phase;
+    // Scopes the entries of this cache in _tracker.absent_partitions().
+    // Absent partitions are subject to the same phase rules as population.
+    absent_partition_cache::epoch_type _absent_epoch;
     mutation_source_opt _prev_snapshot;
 
     // Positions >= than this are using _prev_snapshot, the rest is using _underlying.
@@ -268,6 +271,9 @@ class row_cache final {
     void upgrade_entry(cache_entry&);
     void invalidate_locked(const dht::decorated_key&);
     void clear_now() noexcept;
+    // Makes the cache forget all partitions it knows to be absent.
+    void forget_absent_partitions() noexcept;
+    void forget_absent_partition(const dht::decorated_key&) noexcept;
 
     struct previous_entry_pointer {
         std::optional<dht::decorated_key> _key;
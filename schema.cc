@@ -32,6 +32,7 @@
 #include "utils/rjson.hh"
 #include "tombstone_gc_options.hh"
 #include "db/per_partition_rate_limit_extension.hh"
+#include "db/non_durable_writes_extension.hh"
 
 constexpr int32_t schema::NAME_LENGTH;
 
@@ -257,9 +258,111 @@ const std::vector<column_definition>& v3_columns::all_columns() const {
     return _columns;
 }
 
+namespace {
+
+// Comparators of non-null values of a given type, equivalent to its
+// abstract_type::compare() but without the dispatch on the type's kind.
+
+template <typename T>
+struct fixed_value_tri_compare {
+    std::strong_ordering operator()(managed_bytes_view v1, managed_bytes_view v2) const {
+        if (v1.empty() || v2.empty()) {
+            return !v1.empty() <=> !v2.empty();
+        }
+        return read_simple_exactly<T>(v1) <=> read_simple_exactly<T>(v2);
+    }
+};
+
+struct unsigned_value_tri_compare {
+    std::strong_ordering operator()(managed_bytes_view v1, managed_bytes_view v2) const {
+        return compare_unsigned(v1, v2);
+    }
+};
+
+struct timeuuid_value_tri_compare {
+    std::strong_ordering operator()(managed_bytes_view v1, managed_bytes_view v2) const {
+        if (v1.empty() || v2.empty()) {
+            return !v1.empty() <=> !v2.empty();
+        }
+        return with_linearized(v1, [&] (bytes_view v1) {
+            return with_linearized(v2, [&] (bytes_view v2) {
+                return utils::timeuuid_tri_compare(v1, v2);
+            });
+        });
+    }
+};
+
+using prefix_tri_compare_fn = std::strong_ordering (*)(const schema&, managed_bytes_view, managed_bytes_view);
+
+std::strong_ordering generic_prefix_tri_compare(const schema& s, managed_bytes_view p1, managed_bytes_view p2) {
+    const auto& type = s.clustering_key_prefix_type();
+    return prefix_equality_tri_compare(type->types().begin(),
+        type->begin(p1), type->end(p1),
+        type->begin(p2), type->end(p2),
+        ::tri_compare);
+}
+
+// A prefix of a single column key has either no component, which is equal to
+// any other prefix, or the length of the value followed by the value.
+template <typename ValueCompare, bool Reversed>
+std::strong_ordering single_column_prefix_tri_compare(const schema&, managed_bytes_view p1, managed_bytes_view p2) {
+    if (p1.empty() || p2.empty()) {
+        return std::strong_ordering::equal;
+    }
+    p1.remove_prefix(sizeof(compound_prefix::size_type));
+    p2.remove_prefix(sizeof(compound_prefix::size_type));
+    return Reversed ? ValueCompare{}(p2, p1) : ValueCompare{}(p1, p2);
+}
+
+template <bool Reversed>
+prefix_tri_compare_fn single_column_prefix_tri_compare_for(const abstract_type& type) {
+    using kind = abstract_type::kind;
+    switch (type.get_kind()) {
+    case kind::byte:
+        return &single_column_prefix_tri_compare<fixed_value_tri_compare<int8_t>, Reversed>;
+    case kind::short_kind:
+        return &single_column_prefix_tri_compare<fixed_value_tri_compare<int16_t>, Reversed>;
+    case kind::int32:
+        return &single_column_prefix_tri_compare<fixed_value_tri_compare<int32_t>, Reversed>;
+    case kind::long_kind:
+    case kind::timestamp:
+    case kind::time:
+        return &single_column_prefix_tri_compare<fixed_value_tri_compare<int64_t>, Reversed>;
+    case kind::simple_date:
+        return &single_column_prefix_tri_compare<fixed_value_tri_compare<uint32_t>, Reversed>;
+    case kind::timeuuid:
+        return &single_column_prefix_tri_compare<timeuuid_value_tri_compare, Reversed>;
+    case kind::ascii:
+    case kind::utf8:
+    case kind::bytes:
+    case kind::inet:
+    case kind::date:
+    case kind::duration:
+        return &single_column_prefix_tri_compare<unsigned_value_tri_compare, Reversed>;
+    default:
+        return nullptr;
+    }
+}
+
+prefix_tri_compare_fn select_prefix_tri_compare(const compound_prefix& type) {
+    if (type.types().size() == 1) {
+        const abstract_type& t = *type.types().front();
+        auto fn = t.is_reversed()
+                ? single_column_prefix_tri_compare_for<true>(t.without_reversed())
+                : single_column_prefix_tri_compare_for<false>(t);
+        if (fn) {
+            return fn;
+        }
+    }
+    return &generic_prefix_tri_compare;
+}
+
+}
+
 void schema::rebuild() {
     _partition_key_type = make_lw_shared<compound_type<>>(get_column_types(partition_key_columns()));
     _clustering_key_type = make_lw_shared<compound_prefix>(get_column_types(clustering_key_columns()));
+    _clustering_prefix_tri_compare = select_prefix_tri_compare(*_clustering_key_type);
     _clustering_key_size = column_offset(column_kind::static_column) - column_offset(column_kind::clustering_key);
     _regular_column_count = _raw._columns.size() - column_offset(column_kind::regular_column);
     _static_column_count = column_offset(column_kind::regular_column) - column_offset(column_kind::static_column);
@@ -1276,6 +1379,14 @@ schema_ptr schema_builder::build() {
             dynamic_pointer_cast<db::per_partition_rate_limit_extension>(it->second)->get_options();
     }
 
+    // cache the `non_durable_writes` flush period, checked on every write.
+    if (auto it = new_raw._extensions.find(db::non_durable_writes_extension::NAME); it != new_raw._extensions.end()) {
+        new_raw._non_durable_writes_flush_period =
+            dynamic_pointer_cast<db::non_durable_writes_extension>(it->second)->flush_period();
+    } else {
+        new_raw._non_durable_writes_flush_period = std::nullopt;
+    }
+
     return make_lw_shared<schema>(schema::private_tag{}, new_raw, _view_info);
 }
 
@@ -1314,6 +1425,11 @@ schema_builder& schema_builder::with_per_partition_rate_limit_options(const db::
     return *this;
 }
 
+schema_builder& schema_builder::with_non_durable_writes(std::chrono::milliseconds flush_period) {
+    add_extension(db::non_durable_writes_extension::NAME, ::make_shared<db::non_durable_writes_extension>(flush_period));
+    return *this;
+}
+
 schema_builder& schema_builder::set_paxos_grace_seconds(int32_t seconds) {
     add_extension(db::paxos_grace_seconds_extension::NAME, ::make_shared<db::paxos_grace_seconds_extension>(seconds));
     return *this;
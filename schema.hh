@@ -623,6 +623,7 @@ class schema final : public enable_lw_shared_from_this<schema> {
         double _read_repair_chance = 0.0;
         double _crc_check_chance = 1;
         db::per_partition_rate_limit_options _per_partition_rate_limit_options;
+        std::optional<std::chrono::milliseconds> _non_durable_writes_flush_period;
         int32_t _min_compaction_threshold = DEFAULT_MIN_COMPACTION_THRESHOLD;
         int32_t _max_compaction_threshold = DEFAULT_MAX_COMPACTION_THRESHOLD;
         int32_t _min_index_interval = DEFAULT_MIN_INDEX_INTERVAL;
@@ -661,6 +662,10 @@ class schema final : public enable_lw_shared_from_this<schema> {
     std::unordered_map<bytes, const column_definition*> _columns_by_name;
     lw_shared_ptr<compound_type<allow_prefixes::no>> _partition_key_type;
     lw_shared_ptr<compound_type<allow_prefixes::yes>> _clustering_key_type;
+    // Compares serialized clustering prefixes like prefix_equality_tri_compare()
+    // over _clustering_key_type. Specialized for the clustering key's types
+    // in rebuild().
+    std::strong_ordering (*_clustering_prefix_tri_compare)(const schema&, managed_bytes_view, managed_bytes_view);
     column_mapping _column_mapping;
     shared_ptr<query::partition_slice> _full_slice;
     column_count_type _clustering_key_size;
@@ -764,6 +769,11 @@ class schema final : public enable_lw_shared_from_this<schema> {
 
     gc_clock::duration paxos_grace_seconds() const;
 
+    // Engaged if writes skip the commitlog and memtables are flushed periodically instead.
+    std::optional<std::chrono::milliseconds> non_durable_writes_flush_period() const {
+        return _raw._non_durable_writes_flush_period;
+    }
+
     double dc_local_read_repair_chance() const {
         return _raw._dc_local_read_repair_chance;
     }
@@ -913,6 +923,10 @@ class schema final : public enable_lw_shared_from_this<schema> {
     const lw_shared_ptr<compound_type<allow_prefixes::yes>>& clustering_key_prefix_type() const {
         return _clustering_key_type;
     }
+    // Prefix equality order of clustering prefixes given by their representation.
+    std::strong_ordering clustering_prefix_tri_compare(managed_bytes_view p1, managed_bytes_view p2) const {
+        return _clustering_prefix_tri_compare(*this, p1, p2);
+    }
     const data_type& regular_column_name_type() const {
         return _raw._regular_column_name_type;
     }
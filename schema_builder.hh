@@ -285,6 +285,7 @@ struct schema_builder {
     schema_builder& with_cdc_options(const cdc::options&);
     schema_builder& with_tombstone_gc_options(const tombstone_gc_options& opts);
     schema_builder& with_per_partition_rate_limit_options(const db::per_partition_rate_limit_options&);
+    schema_builder& with_non_durable_writes(std::chrono::milliseconds flush_period);
     
     default_names get_default_names() const {
         return default_names(_raw);
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "serializer.hh"
+#include "serialization_visitors.hh"
 #include <seastar/util/bool_class.hh>
 #include "utils/small_vector.hh"
 #include <absl/container/btree_set.h>
@@ -32,6 +33,24 @@ void set_size(Stream& os, const T& obj) {
     serialize(os, get_sizeof(obj));
 }
 
+// Starts writing an object preceded by its size, the returned frame's end()
+// must be called after the object is written.
+//
+// Where the output can go back and fill in a placeholder, the size is written
+// once the object is, instead of measuring the object upfront with set_size().
+// Measuring serializes the whole object one more time, and since nested
+// objects measure themselves again, an object nested n levels deep used to be
+// serialized n + 1 times.
+template<typename Output, typename T>
+auto start_sized_frame(Output& out, const T& obj) {
+    if constexpr (requires { start_frame(out).end(out); }) {
+        return start_frame(out);
+    } else {
+        set_size(out, obj);
+        return empty_frame<Output>();
+    }
+}
+
 
 template<typename Output>
 void safe_serialize_as_uint32(Output& out, uint64_t data) {
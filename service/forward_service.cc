@@ -9,6 +9,7 @@
 #include "service/forward_service.hh"
 
 #include <boost/range/algorithm/remove_if.hpp>
+#include <numeric>
 #include <seastar/core/coroutine.hh>
 #include <seastar/core/future-util.hh>
 #include <seastar/core/smp.hh>
@@ -59,9 +60,19 @@ static std::vector<::shared_ptr<db::functions::aggregate_function>> get_function
 
 class forward_aggregates {
 private:
+    schema_ptr _schema;
     std::vector<::shared_ptr<db::functions::aggregate_function>> _funcs;
     std::vector<std::unique_ptr<db::functions::aggregate_function::aggregate>> _aggrs;
-
+    // Number of GROUP BY columns, 0 if results are not grouped.
+    size_t _group_by_size = 0;
+
+    void check_group_size(const std::vector<bytes_opt>& group) const;
+    dht::decorated_key group_partition_key(const std::vector<bytes_opt>& group) const;
+    std::strong_ordering compare_groups(const dht::decorated_key& a_key, const std::vector<bytes_opt>& a,
+            const dht::decorated_key& b_key, const std::vector<bytes_opt>& b) const;
+    void reduce_group(std::vector<bytes_opt>& group, std::vector<bytes_opt>&& other);
+    void merge_groups(query::forward_result& result, query::forward_result&& other);
+    void finalize_groups(query::forward_result& result);
 public:
     forward_aggregates(const query::forward_request& request);
     void merge(query::forward_result& result, query::forward_result&& other);
@@ -84,6 +95,7 @@ class forward_aggregates {
 };
 
 forward_aggregates::forward_aggregates(const query::forward_request& request) {
+    _schema = local_schema_registry().get(request.cmd.schema_version);
     _funcs = get_functions(request);
     std::vector<std::unique_ptr<db::functions::aggregate_function::aggregate>> aggrs;
 
@@ -91,9 +103,142 @@ forward_aggregates::forward_aggregates(const query::forward_request& request) {
         aggrs.push_back(func->new_aggregate());
     }
     _aggrs = std::move(aggrs);
+
+    if (request.group_by_column_names) {
+        _group_by_size = request.group_by_column_names->size();
+        if (_group_by_size < _schema->partition_key_size() || _group_by_size > _schema->partition_key_size() + _schema->clustering_key_size()) {
+            throw std::runtime_error(format("Invalid number of GROUP BY columns: {}", _group_by_size));
+        }
+    }
+}
+
+void forward_aggregates::check_group_size(const std::vector<bytes_opt>& group) const {
+    if (group.size() != _group_by_size + _aggrs.size()) {
+        on_internal_error(
+            flogger,
+            format("forward_aggregates: invalid group size. "
+                    "this.aggrs.size(): {} "
+                    "group_by_size: {} "
+                    "group.size(): {} ",
+                    _aggrs.size(), _group_by_size, group.size())
+        );
+    }
+}
+
+dht::decorated_key forward_aggregates::group_partition_key(const std::vector<bytes_opt>& group) const {
+    std::vector<bytes> components;
+    components.reserve(_schema->partition_key_size());
+    for (size_t i = 0; i < _schema->partition_key_size(); i++) {
+        components.push_back(*group[i]);
+    }
+    return dht::decorate_key(*_schema, partition_key::from_exploded(*_schema, components));
+}
+
+// Orders groups the way rows are returned by a query: in ring order, then in
+// clustering order. A null clustering column, of a partition with no rows,
+// sorts before the values.
+std::strong_ordering forward_aggregates::compare_groups(const dht::decorated_key& a_key, const std::vector<bytes_opt>& a,
+        const dht::decorated_key& b_key, const std::vector<bytes_opt>& b) const {
+    if (auto cmp = a_key.tri_compare(*_schema, b_key); cmp != 0) {
+        return cmp;
+    }
+    for (size_t i = _schema->partition_key_size(); i < _group_by_size; i++) {
+        if (!a[i] || !b[i]) {
+            if (auto cmp = bool(a[i]) <=> bool(b[i]); cmp != 0) {
+                return cmp;
+            }
+            continue;
+        }
+        auto& type = _schema->clustering_key_columns()[i - _schema->partition_key_size()].type;
+        if (auto cmp = type->compare(*a[i], *b[i]); cmp != 0) {
+            return cmp;
+        }
+    }
+    return std::strong_ordering::equal;
+}
+
+void forward_aggregates::reduce_group(std::vector<bytes_opt>& group, std::vector<bytes_opt>&& other) {
+    for (size_t i = 0; i < _aggrs.size(); i++) {
+        _aggrs[i]->set_accumulator(group[_group_by_size + i]);
+        _aggrs[i]->reduce(cql_serialization_format::internal(), std::move(other[_group_by_size + i]));
+        group[_group_by_size + i] = _aggrs[i]->get_accumulator();
+    }
+}
+
+// Both results hold their groups in query order, so the merge keeps it.
+// GROUP BY includes the whole partition key, so results coming from different
+// shards don't share groups, but the merge doesn't depend on that.
+void forward_aggregates::merge_groups(query::forward_result& result, query::forward_result&& other) {
+    if (!other.grouped_query_results) {
+        return;
+    }
+    if (!result.grouped_query_results) {
+        result.grouped_query_results = std::move(other.grouped_query_results);
+        return;
+    }
+
+    auto& groups = *result.grouped_query_results;
+    auto& other_groups = *other.grouped_query_results;
+    auto decorate = [this] (const std::vector<std::vector<bytes_opt>>& groups) {
+        std::vector<dht::decorated_key> keys;
+        keys.reserve(groups.size());
+        for (auto& group : groups) {
+            check_group_size(group);
+            keys.push_back(group_partition_key(group));
+        }
+        return keys;
+    };
+    auto keys = decorate(groups);
+    auto other_keys = decorate(other_groups);
+
+    std::vector<std::vector<bytes_opt>> merged;
+    merged.reserve(groups.size() + other_groups.size());
+    size_t i = 0;
+    size_t j = 0;
+    while (i < groups.size() && j < other_groups.size()) {
+        auto cmp = compare_groups(keys[i], groups[i], other_keys[j], other_groups[j]);
+        if (cmp < 0) {
+            merged.push_back(std::move(groups[i++]));
+        } else if (cmp > 0) {
+            merged.push_back(std::move(other_groups[j++]));
+        } else {
+            reduce_group(groups[i], std::move(other_groups[j++]));
+            merged.push_back(std::move(groups[i++]));
+        }
+    }
+    std::move(groups.begin() + i, groups.end(), std::back_inserter(merged));
+    std::move(other_groups.begin() + j, other_groups.end(), std::back_inserter(merged));
+    groups = std::move(merged);
+}
+
+void forward_aggregates::finalize_groups(query::forward_result& result) {
+    if (!result.grouped_query_results) {
+        result.grouped_query_results.emplace();
+    }
+    auto& groups = *result.grouped_query_results;
+    for (auto& group : groups) {
+        check_group_size(group);
+        for (size_t i = 0; i < _aggrs.size(); i++) {
+            _aggrs[i]->set_accumulator(group[_group_by_size + i]);
+            group[_group_by_size + i] = _aggrs[i]->compute(cql_serialization_format::internal());
+        }
+    }
+    // Like the non-parallelized query, return a single row without a group
+    // when no rows were selected.
+    if (groups.empty()) {
+        std::vector<bytes_opt> group(_group_by_size);
+        for (auto& func : _funcs) {
+            group.push_back(func->new_aggregate()->compute(cql_serialization_format::internal()));
+        }
+        groups.push_back(std::move(group));
+    }
 }
 
 void forward_aggregates::merge(query::forward_result &result, query::forward_result&& other) {
+    if (_group_by_size) {
+        merge_groups(result, std::move(other));
+        return;
+    }
     if (result.query_results.empty()) {
         result.query_results = std::move(other.query_results);
         return;
@@ -120,6 +265,10 @@ void forward_aggregates::merge(query::forward_result &result, query::forward_res
 }
 
 void forward_aggregates::finalize(query::forward_result &result) {
+    if (_group_by_size) {
+        finalize_groups(result);
+        return;
+    }
     if (result.query_results.size() != _aggrs.size()) {
         on_internal_error(
             flogger,
@@ -325,6 +474,15 @@ static shared_ptr<cql3::selection::selection> mock_selection(
         return make_shared<cql3::selection::raw_selector>(fc_expr, column_identifier);
     };
 
+    // Selections of GROUP BY columns come first, so that the rows of
+    // the result set have the layout of forward_result::grouped_query_results.
+    if (request.group_by_column_names) {
+        for (auto& name : *request.group_by_column_names) {
+            auto selectable = cql3::expr::unresolved_identifier{make_shared<cql3::column_identifier_raw>(name, true)};
+            raw_selectors.emplace_back(make_shared<cql3::selection::raw_selector>(std::move(selectable), nullptr));
+        }
+    }
+
     for (size_t i = 0; i < request.reduction_types.size(); i++) {
         auto info = (request.aggregation_infos) ? std::optional(request.aggregation_infos->at(i)) : std::nullopt;
         raw_selectors.emplace_back(mock_singular_selection(functions[i], request.reduction_types[i], info));
@@ -399,11 +557,14 @@ future<query::forward_result> forward_service::execute_on_this_shard(
         cql_serialization_format::latest()
     );
 
+    const size_t group_by_size = req.group_by_column_names ? req.group_by_column_names->size() : 0;
+    std::vector<size_t> group_by_cell_indices(group_by_size);
+    std::iota(group_by_cell_indices.begin(), group_by_cell_indices.end(), 0);
     auto rs_builder = cql3::selection::result_set_builder(
         *selection,
         now,
         cql_serialization_format::latest(),
-        std::vector<size_t>() // Represents empty GROUP BY indices.
+        std::move(group_by_cell_indices)
     );
 
     dht::partition_range_vector ranges_owned_by_this_shard;
@@ -443,9 +604,26 @@ future<query::forward_result> forward_service::execute_on_this_shard(
         ranges_owned_by_this_shard.clear();
     } while (current_range);
 
-    co_return co_await rs_builder.with_thread_if_needed([&req, &rs_builder, reductions = req.reduction_types, tr_state = std::move(tr_state)] {
+    co_return co_await rs_builder.with_thread_if_needed([&req, &rs_builder, reductions = req.reduction_types, group_by_size, tr_state = std::move(tr_state)] {
         auto rs = rs_builder.build();
         auto& rows = rs->rows();
+        if (group_by_size) {
+            query::forward_result res = { .grouped_query_results = std::vector<std::vector<bytes_opt>>() };
+            res.grouped_query_results->reserve(rows.size());
+            for (auto& row : rows) {
+                if (row.size() != group_by_size + reductions.size()) {
+                    flogger.error("aggregation result column count does not match requested column count");
+                    throw std::runtime_error("aggregation result column count does not match requested column count");
+                }
+                // The builder returns a row without a group, whose partition
+                // key is null, when no rows were selected.
+                if (row[0]) {
+                    res.grouped_query_results->push_back(row);
+                }
+            }
+            tracing::trace(tr_state, "On shard execution result has {} groups", res.grouped_query_results->size());
+            return res;
+        }
         if (rows.size() != 1) {
             flogger.error("aggregation result row count != 1");
             throw std::runtime_error("aggregation result row count != 1");
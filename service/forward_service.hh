@@ -41,6 +41,10 @@ class storage_proxy;
 //   5. `dispatch` merges results from all coordinators and returns merged
 //      result.
 //
+// Requests with GROUP BY columns are aggregated per group on each shard, and
+// the partial results of each group are merged along with the groups, which
+// are kept in the order of the query.
+//
 // Splitting query into sub-queries in is implemented as:
 //   a. Partition ranges of the original query are split into a sequence of
 //      vnodes.
@@ -25,6 +25,7 @@ namespace service::paxos {
 logging::logger paxos_state::logger("paxos");
 thread_local paxos_state::key_lock_map paxos_state::_paxos_table_lock;
 thread_local paxos_state::key_lock_map paxos_state::_coordinator_lock;
+thread_local paxos_state::promise_cache paxos_state::_promises;
 
 paxos_state::key_lock_map::semaphore& paxos_state::key_lock_map::get_semaphore_for_key(const dht::token& key) {
     return _locks.try_emplace(key, 1).first->second;
@@ -37,6 +38,25 @@ void paxos_state::key_lock_map::release_semaphore_for_key(const dht::token& key)
     }
 }
 
+std::optional<utils::UUID> paxos_state::promise_cache::find(const schema& s, const dht::token& token, partition_key_view key) const {
+    auto it = _entries.find({s.id(), token});
+    if (it == _entries.end() || !it->second.key.equal(s, key)) {
+        return std::nullopt;
+    }
+    return it->second.ballot;
+}
+
+void paxos_state::promise_cache::insert(const schema& s, const dht::token& token, partition_key_view key, utils::UUID ballot) {
+    if (_entries.size() >= max_entries) {
+        _entries.clear();
+    }
+    _entries.insert_or_assign({s.id(), token}, entry{partition_key(key), ballot});
+}
+
+void paxos_state::promise_cache::erase(const schema& s, const dht::token& token) {
+    _entries.erase({s.id(), token});
+}
+
 future<paxos_state::guard> paxos_state::get_cas_lock(const dht::token& key, clock_type::time_point timeout) {
     guard m(_coordinator_lock, key, timeout);
     co_await m.lock();
@@ -78,12 +98,19 @@ future<prepare_response> paxos_state::prepare(storage_proxy& sp, tracing::trace_
                                     prv, tr_state, timeout);
                         });
                     });
-                    return when_all(std::move(f1), std::move(f2)).then([state = std::move(state), only_digest] (auto t) {
+                    return when_all(std::move(f1), std::move(f2)).then([state = std::move(state), only_digest, schema, token, &key, ballot] (auto t) {
+                        auto&& f1 = std::get<0>(t);
+                        auto&& f2 = std::get<1>(t);
+                        if (f1.failed()) {
+                            _promises.erase(*schema, token);
+                        } else {
+                            _promises.insert(*schema, token, key, ballot);
+                        }
                         if (utils::get_local_injector().enter("paxos_error_after_save_promise")) {
+                            f1.ignore_ready_future();
+                            f2.ignore_ready_future();
                             return make_exception_future<prepare_response>(utils::injected_error("injected_error_after_save_promise"));
                         }
-                        auto&& f1 = std::get<0>(t);
-                        auto&& f2 = std::get<1>(t);
                         if (f1.failed()) {
                             f2.ignore_ready_future();
                             // Failed to save promise. Nothing we can do but throw.
@@ -128,13 +155,21 @@ future<bool> paxos_state::accept(storage_proxy& sp, tracing::trace_state_ptr tr_
             [&sp, token = std::move(token), &proposal, schema, tr_state, timeout] {
         utils::latency_counter lc;
         lc.start();
-        return with_locked_key(token, timeout, [&proposal, schema, tr_state, timeout] () mutable {
-            auto now_in_sec = utils::UUID_gen::unix_timestamp_in_sec(proposal.ballot);
-            auto f = db::system_keyspace::load_paxos_state(proposal.update.key(), schema, gc_clock::time_point(now_in_sec), timeout);
-            return f.then([&proposal, tr_state, schema, timeout] (paxos_state state) {
+        return with_locked_key(token, timeout, [&proposal, token, schema, tr_state, timeout] () mutable {
+            future<utils::UUID> f = make_ready_future<utils::UUID>();
+            if (auto promised = _promises.find(*schema, token, proposal.update.key())) {
+                tracing::trace(tr_state, "Using the ballot promised by this shard {}", *promised);
+                f = make_ready_future<utils::UUID>(*promised);
+            } else {
+                auto now_in_sec = utils::UUID_gen::unix_timestamp_in_sec(proposal.ballot);
+                f = db::system_keyspace::load_paxos_state(proposal.update.key(), schema, gc_clock::time_point(now_in_sec), timeout).then([] (paxos_state state) {
+                    return state._promised_ballot;
+                });
+            }
+            return f.then([&proposal, token, tr_state, schema, timeout] (utils::UUID promised_ballot) {
                 // Accept the proposal if we promised to accept it or the proposal is newer than the one we promised.
                 // Otherwise the proposal was cutoff by another Paxos proposer and has to be rejected.
-                if (proposal.ballot == state._promised_ballot || proposal.ballot.timestamp() > state._promised_ballot.timestamp()) {
+                if (proposal.ballot == promised_ballot || proposal.ballot.timestamp() > promised_ballot.timestamp()) {
                     logger.debug("Accepting proposal {}", proposal);
                     tracing::trace(tr_state, "Accepting proposal {}", proposal);
 
@@ -142,15 +177,21 @@ future<bool> paxos_state::accept(storage_proxy& sp, tracing::trace_state_ptr tr_
                         return make_exception_future<bool>(utils::injected_error("injected_error_before_save_proposal"));
                     }
 
-                    return db::system_keyspace::save_paxos_proposal(*schema, proposal, timeout).then([] {
+                    // Saving the proposal also promises its ballot.
+                    return db::system_keyspace::save_paxos_proposal(*schema, proposal, timeout).then_wrapped([&proposal, token, schema] (future<> f) {
+                        if (f.failed()) {
+                            _promises.erase(*schema, token);
+                            return make_exception_future<bool>(f.get_exception());
+                        }
+                        _promises.insert(*schema, token, proposal.update.key(), proposal.ballot);
                         if (utils::get_local_injector().enter("paxos_error_after_save_proposal")) {
                             return make_exception_future<bool>(utils::injected_error("injected_error_after_save_proposal"));
                         }
                         return make_ready_future<bool>(true);
                     });
                 } else {
-                    logger.debug("Rejecting proposal for {} because in_progress is now {}", proposal, state._promised_ballot);
-                    tracing::trace(tr_state, "Rejecting proposal for {} because in_progress is now {}", proposal, state._promised_ballot);
+                    logger.debug("Rejecting proposal for {} because in_progress is now {}", proposal, promised_ballot);
+                    tracing::trace(tr_state, "Rejecting proposal for {} because in_progress is now {}", proposal, promised_ballot);
                     return make_ready_future<bool>(false);
                 }
             });
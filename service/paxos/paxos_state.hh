@@ -14,6 +14,7 @@
 #include <unordered_map>
 #include "utils/UUID_gen.hh"
 #include "service/paxos/prepare_response.hh"
+#include "utils/hash.hh"
 
 namespace service {
 class storage_proxy;
@@ -64,6 +65,32 @@ class paxos_state {
     static thread_local key_lock_map _coordinator_lock;
 
 
+    // The ballots promised for the keys which this shard prepared or accepted
+    // recently. system.paxos is written under _paxos_table_lock of the key's
+    // shard, so an entry holds the same ballot as the promise persisted there.
+    // This lets accept() check a proposal without reading the key's paxos state,
+    // which on an uncontended key was just read and written by prepare().
+    class promise_cache {
+        // Entries are dropped all at once when there are more, a miss only
+        // costs reading the state from system.paxos.
+        static constexpr size_t max_entries = 10000;
+
+        struct entry {
+            partition_key key;
+            utils::UUID ballot;
+        };
+        // Keyed by table and token. A key whose token collides with that of
+        // another key of the same table replaces its entry.
+        std::unordered_map<std::pair<utils::UUID, dht::token>, entry, utils::tuple_hash> _entries;
+    public:
+        std::optional<utils::UUID> find(const schema& s, const dht::token& token, partition_key_view key) const;
+        void insert(const schema& s, const dht::token& token, partition_key_view key, utils::UUID ballot);
+        // Called when it's not known whether the promise was persisted.
+        void erase(const schema& s, const dht::token& token);
+    };
+
+    static thread_local promise_cache _promises;
+
     // protects acess to system.paxos
     template<typename Func>
     static
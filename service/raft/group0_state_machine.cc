@@ -48,8 +48,25 @@ static mutation convert_history_mutation(canonical_mutation m, const data_dictio
     return m.to_mutation(db.find_schema(db::system_keyspace::NAME, db::system_keyspace::GROUP0_HISTORY));
 }
 
+// The state ID the history table reports as the last one once `id` is appended to it.
+static utils::UUID later_state_id(const utils::UUID& last, const utils::UUID& id) {
+    return utils::timeuuid_tri_compare(last.serialize(), id.serialize()) < 0 ? id : last;
+}
+
 future<> group0_state_machine::apply(std::vector<raft::command_cref> command) {
-    slogger.trace("apply() is called");
+    slogger.trace("apply() is called with {} commands", command.size());
+
+    // The commands given to a single apply() are merged: the schema mutations of consecutive commands
+    // of the same creator which pass the state ID check are applied with a single schema merge, so its
+    // per-shard work (rebuilding schemas and replication maps, updating views, notifying listeners) is
+    // done once per run of commands instead of once per command. Each command is still checked against
+    // the state ID which the commands before it leave behind, as if they were applied one by one.
+    auto read_apply_mutex_holder = co_await get_units(_client._read_apply_mutex, 1);
+    auto last_group0_state_id = co_await db::system_keyspace::get_last_group0_state_id();
+
+    // Schema changes, in order, each with the commands' creator.
+    std::vector<std::pair<gms::inet_address, std::vector<canonical_mutation>>> schema_changes;
+    std::vector<mutation> history_mutations;
     for (auto&& c : command) {
         auto is = ser::as_input_stream(c);
         auto cmd = ser::deserialize(is, boost::type<group0_command>{});
@@ -58,10 +75,7 @@ future<> group0_state_machine::apply(std::vector<raft::command_cref> command) {
                 cmd.prev_state_id, cmd.new_state_id, cmd.creator_addr, cmd.creator_id);
         slogger.trace("cmd.history_append: {}", cmd.history_append);
 
-        auto read_apply_mutex_holder = co_await get_units(_client._read_apply_mutex, 1);
-
         if (cmd.prev_state_id) {
-            auto last_group0_state_id = co_await db::system_keyspace::get_last_group0_state_id();
             if (*cmd.prev_state_id != last_group0_state_id) {
                 // This command used obsolete state. Make it a no-op.
                 // BTW. on restart, all commands after last snapshot descriptor become no-ops even when they originally weren't no-ops.
@@ -77,26 +91,43 @@ future<> group0_state_machine::apply(std::vector<raft::command_cref> command) {
             slogger.trace("unconditional modification, cmd.new_state_id: {}", cmd.new_state_id);
         }
 
-        // We assume that `cmd.change` was constructed using group0 state which was observed *after* `cmd.prev_state_id` was obtained.
-        // It is now important that we apply the change *before* we append the group0 state ID to the history table.
-        //
-        // If we crash before appending the state ID, when we reapply the command after restart, the change will be applied because
-        // the state ID was not yet appended so the above check will pass.
-
-        // TODO: reapplication of a command after a crash may require contacting a quorum (we need to learn that the command
-        // is committed from a leader). But we may want to ensure that group 0 state is consistent after restart even without
-        // access to quorum, which means we cannot allow partially applied commands. We need to ensure that either the entire
-        // change is applied and the state ID is updated or none of this happens.
-        // E.g. use a write-ahead-entry which contains all this information and make sure it's replayed during restarts.
-
-        co_await std::visit(make_visitor(
-        [&] (schema_change& chng) -> future<> {
-            return _mm.merge_schema_from(netw::messaging_service::msg_addr(std::move(cmd.creator_addr)), std::move(chng.mutations));
+        std::visit(make_visitor(
+        [&] (schema_change& chng) {
+            if (schema_changes.empty() || schema_changes.back().first != cmd.creator_addr) {
+                schema_changes.emplace_back(cmd.creator_addr, std::vector<canonical_mutation>());
+            }
+            auto& muts = schema_changes.back().second;
+            std::move(chng.mutations.begin(), chng.mutations.end(), std::back_inserter(muts));
         }
         ), cmd.change);
 
-        co_await _sp.mutate_locally({convert_history_mutation(std::move(cmd.history_append), _sp.data_dictionary())}, nullptr);
+        history_mutations.push_back(convert_history_mutation(std::move(cmd.history_append), _sp.data_dictionary()));
+        last_group0_state_id = later_state_id(last_group0_state_id, cmd.new_state_id);
     }
+
+    if (history_mutations.empty()) {
+        co_return;
+    }
+
+    // We assume that each command's change was constructed using group0 state which was observed *after* its `prev_state_id`
+    // was obtained. It is now important that we apply the changes *before* we append the group0 state IDs to the history table.
+    //
+    // If we crash before appending the state IDs, when we reapply the commands after restart, the changes will be applied because
+    // the state IDs were not yet appended so the above check will pass.
+
+    // TODO: reapplication of a command after a crash may require contacting a quorum (we need to learn that the command
+    // is committed from a leader). But we may want to ensure that group 0 state is consistent after restart even without
+    // access to quorum, which means we cannot allow partially applied commands. We need to ensure that either the entire
+    // change is applied and the state ID is updated or none of this happens.
+    // E.g. use a write-ahead-entry which contains all this information and make sure it's replayed during restarts.
+
+    for (auto& [creator_addr, schema_mutations] : schema_changes) {
+        if (!schema_mutations.empty()) {
+            co_await _mm.merge_schema_from(netw::messaging_service::msg_addr(creator_addr), std::move(schema_mutations));
+        }
+    }
+
+    co_await _sp.mutate_locally(std::move(history_mutations), nullptr);
 }
 
 future<raft::snapshot_id> group0_state_machine::take_snapshot() {
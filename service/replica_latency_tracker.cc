@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+
+#include "service/replica_latency_tracker.hh"
+
+namespace service {
+
+void replica_latency_tracker::add(gms::inet_address ep, std::chrono::microseconds latency) {
+    auto& r = _replicas[ep];
+    auto us = double(latency.count());
+    r.ewma = r.ewma ? r.ewma + ewma_weight * (us - r.ewma) : us;
+    r.histogram.add(latency.count());
+}
+
+double replica_latency_tracker::score(gms::inet_address ep) const {
+    auto it = _replicas.find(ep);
+    return it == _replicas.end() ? 0 : it->second.ewma;
+}
+
+std::optional<std::chrono::microseconds> replica_latency_tracker::percentile(gms::inet_address ep, double p) {
+    auto it = _replicas.find(ep);
+    if (it == _replicas.end()) {
+        return std::nullopt;
+    }
+    auto& r = it->second;
+    auto now = clock_type::now();
+    if (r.cached_percentile != p || now - r.percentile_timestamp > std::chrono::seconds(1)) {
+        if (r.histogram.count() < min_samples) {
+            return std::nullopt;
+        }
+        r.percentile_timestamp = now;
+        r.cached_percentile = p;
+        r.percentile_value = std::chrono::microseconds(std::max(r.histogram.percentile(p), int64_t(1)));
+        r.histogram *= 0.9; // decay values a little to give new data points more weight
+    }
+    return r.percentile_value;
+}
+
+void replica_latency_tracker::maybe_reset(clock_type::duration reset_interval) {
+    auto now = clock_type::now();
+    if (now - _last_reset > reset_interval) {
+        _replicas.clear();
+        _last_reset = now;
+    }
+}
+
+bool replica_latency_tracker::sort_group(inet_address_vector_replica_set::iterator begin, inet_address_vector_replica_set::iterator end, double badness_threshold) const {
+    if (std::distance(begin, end) < 2) {
+        return false;
+    }
+    auto [min, max] = std::minmax_element(begin, end, [this] (gms::inet_address a, gms::inet_address b) {
+        return score(a) < score(b);
+    });
+    if (score(*max) <= score(*min) * (1 + badness_threshold)) {
+        return false;
+    }
+    std::stable_sort(begin, end, [this] (gms::inet_address a, gms::inet_address b) {
+        return score(a) < score(b);
+    });
+    return true;
+}
+
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+
+#include <seastar/core/lowres_clock.hh>
+
+#include "gms/inet_address.hh"
+#include "inet_address_vectors.hh"
+#include "utils/estimated_histogram.hh"
+#include "seastarx.hh"
+
+namespace service {
+
+/// \class replica_latency_tracker
+/// \brief Latencies of the reads a coordinator shard sent to each replica.
+///
+/// Every replica has an exponentially weighted moving average of its latency,
+/// which orders the replicas of a read, and a histogram, whose percentiles decide
+/// when a read waiting for the replica speculates. Both only reflect the replicas'
+/// recent behaviour: the average weighs every new sample by ewma_weight, and the
+/// histogram decays whenever a percentile is computed from it.
+///
+/// A replica which was slow gets fewer reads, so its scores would be slow to
+/// recover. All scores are forgotten every reset interval, so that such replicas
+/// are tried again.
+class replica_latency_tracker {
+public:
+    using clock_type = seastar::lowres_clock;
+
+    // The weight of a new sample in the moving average.
+    static constexpr double ewma_weight = 0.1;
+    // Percentiles of replicas with fewer samples are not trusted.
+    static constexpr int64_t min_samples = 100;
+
+private:
+    struct replica_latency {
+        // In microseconds.
+        double ewma = 0;
+        utils::estimated_histogram histogram;
+        double cached_percentile = -1;
+        std::chrono::microseconds percentile_value{0};
+        clock_type::time_point percentile_timestamp;
+    };
+
+    std::unordered_map<gms::inet_address, replica_latency> _replicas;
+    clock_type::time_point _last_reset = clock_type::now();
+
+public:
+    void add(gms::inet_address ep, std::chrono::microseconds latency);
+
+    // The moving average of the replica's latency in microseconds,
+    // or 0 if it wasn't sent any reads since the last reset.
+    double score(gms::inet_address ep) const;
+
+    // The latency under which the given share of the replica's reads complete,
+    // or nothing if too few reads were sent to the replica since the last reset.
+    std::optional<std::chrono::microseconds> percentile(gms::inet_address ep, double p);
+
+    // Forgets all scores if they were last forgotten more than reset_interval ago.
+    void maybe_reset(clock_type::duration reset_interval);
+
+    /// Reorders the replicas of each datacenter by their scores, if one of them
+    /// is slower than the fastest by more than badness_threshold (0.2 meaning 20%).
+    /// Otherwise the order, which reflects proximity, is kept. Replicas are expected
+    /// to be grouped by datacenter, as sorting by proximity does, and the groups are
+    /// not reordered. Replicas without a score are treated as the fastest, so that
+    /// their score gets known.
+    ///
+    /// Returns true if the replicas of some datacenter were sorted by their scores.
+    template <typename DatacenterOf>
+    requires std::is_invocable_v<DatacenterOf, gms::inet_address>
+    bool sort(inet_address_vector_replica_set& eps, double badness_threshold, DatacenterOf&& dc_of) const {
+        bool reordered = false;
+        auto begin = eps.begin();
+        while (begin != eps.end()) {
+            auto dc = dc_of(*begin);
+            auto end = std::find_if(begin, eps.end(), [&] (gms::inet_address ep) { return dc_of(ep) != dc; });
+            reordered |= sort_group(begin, end, badness_threshold);
+            begin = end;
+        }
+        return reordered;
+    }
+
+private:
+    bool sort_group(inet_address_vector_replica_set::iterator begin, inet_address_vector_replica_set::iterator end, double badness_threshold) const;
+};
+
+}
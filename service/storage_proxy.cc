@@ -10,6 +10,7 @@
 
 #include <random>
 #include <seastar/core/sleep.hh>
+#include <seastar/core/gate.hh>
 #include <seastar/util/defer.hh>
 #include "partition_range_compat.hh"
 #include "db/consistency_level.hh"
@@ -62,6 +63,7 @@
 #include "db/timeout_clock.hh"
 #include "multishard_mutation_query.hh"
 #include "replica/database.hh"
+#include "replica/hot_partitions.hh"
 #include "db/consistency_level_validations.hh"
 #include "cdc/log.hh"
 #include "cdc/stats.hh"
@@ -73,6 +75,7 @@
 #include "locator/token_metadata.hh"
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/parallel_for_each.hh>
+#include <seastar/coroutine/as_future.hh>
 #include "locator/abstract_replication_strategy.hh"
 #include "service/paxos/cas_request.hh"
 #include "mutation_partition_view.hh"
@@ -163,8 +166,8 @@ static result<db::per_partition_rate_limit::info> choose_rate_limit_info(
     db::per_partition_rate_limit::account_and_enforce enforce_info{
         .random_variable = random_variable_for_rate_limit(),
     };
+    auto& cf = db.find_column_family(s);
     if (coordinator_in_replica_set && dht::shard_of(*s, token) == this_shard_id()) {
-        auto& cf = db.find_column_family(s);
         auto decision = db.account_coordinator_operation_to_rate_limit(cf, token, enforce_info, op_type);
         if (decision) {
             if (*decision == db::rate_limiter::can_proceed::yes) {
@@ -182,8 +185,20 @@ static result<db::per_partition_rate_limit::info> choose_rate_limit_info(
         }
     }
 
-    // The coordinator is not a replica. The decision whether to accept
-    // or reject is left for replicas.
+    // The coordinator is not a replica. Every replica sees every write it
+    // sends, so if its own writes to the partition exceed the limit, it
+    // rejects the excess without sending it, and replicas still see about
+    // the limit. This doesn't hold for reads: below CL=ALL each replica only
+    // sees its share of them, and rejecting on the coordinator would make
+    // the limit tighter than what replicas enforce.
+    if (op_type == db::operation_type::write
+            && db.account_non_replica_coordinator_write_to_rate_limit(cf, token, enforce_info) == db::rate_limiter::can_proceed::no) {
+        slogger.trace("Per-partition rate limiting: coordinator rejected its own excess");
+        tracing::trace(tr_state, "Per-partition rate limiting: coordinator rejected its own excess");
+        return coordinator_exception_container(exceptions::rate_limit_exception(s->ks_name(), s->cf_name(), op_type, true));
+    }
+
+    // The decision whether to accept or reject is left for replicas.
     slogger.trace("Per-partition rate limiting: replicas will decide");
     tracing::trace(tr_state, "Per-partition rate limiting: replicas will decide");
     return enforce_info;
@@ -199,6 +214,195 @@ static inline db::per_partition_rate_limit::info adjust_rate_limit_for_local_ope
     return info;
 }
 
+// Batches of requests which concurrent operations send to the same replica,
+// see read_data_batcher and mutation_batcher.
+//
+// A batch is opened by the first request queued for a replica and is sent once
+// the task which queued it yields, so it gathers the requests issued by the
+// tasks which were ready at the same time. Batches are kept per scheduling
+// group, so that requests of different service levels are not mixed, and stop
+// taking requests once they reach the given number of requests or bytes.
+template <typename Request>
+class replica_batches {
+public:
+    struct batch {
+        scheduling_group sg;
+        std::vector<Request> requests;
+        size_t bytes = 0;
+    };
+    using send_func = noncopyable_function<future<> (gms::inet_address, lw_shared_ptr<batch>)>;
+private:
+    const size_t _max_requests;
+    const size_t _max_bytes;
+    send_func _send;
+    std::unordered_map<gms::inet_address, utils::small_vector<lw_shared_ptr<batch>, 1>> _open_batches;
+    // Held by the batches until they are sent.
+    gate _gate;
+public:
+    replica_batches(size_t max_requests, size_t max_bytes, send_func send)
+        : _max_requests(max_requests), _max_bytes(max_bytes), _send(std::move(send)) {}
+
+    // Queues the request for the replica. The returned reference is valid
+    // until the next request is queued.
+    Request& add(gms::inet_address ep, Request r, size_t bytes = 0) {
+        auto sg = current_scheduling_group();
+        lw_shared_ptr<batch> b;
+        if (auto it = _open_batches.find(ep); it != _open_batches.end()) {
+            auto bit = boost::find_if(it->second, [sg] (const lw_shared_ptr<batch>& o) { return o->sg == sg; });
+            if (bit != it->second.end()) {
+                b = *bit;
+            }
+        }
+        if (!b) {
+            auto holder = _gate.hold();
+            b = make_lw_shared<batch>(batch{sg, {}});
+            _open_batches[ep].push_back(b);
+            // Waited on by stop(), and by the callers through the requests' promises
+            (void)seastar::yield().then([this, ep, b] () mutable {
+                stop_joining(ep, *b);
+                return _send(ep, std::move(b));
+            }).finally([holder = std::move(holder)] {});
+        }
+        b->bytes += bytes;
+        b->requests.push_back(std::move(r));
+        auto& queued = b->requests.back();
+        if (b->requests.size() >= _max_requests || b->bytes >= _max_bytes) {
+            stop_joining(ep, *b);
+        }
+        return queued;
+    }
+
+    // Waits for the queued batches to be sent. No requests may be queued afterwards.
+    future<> stop() {
+        return _gate.close();
+    }
+private:
+    // Stops adding requests to the batch. It is still sent by the task which opened it.
+    void stop_joining(gms::inet_address ep, const batch& b) {
+        auto it = _open_batches.find(ep);
+        if (it == _open_batches.end()) {
+            return;
+        }
+        auto& open = it->second;
+        auto bit = boost::find_if(open, [&b] (const lw_shared_ptr<batch>& o) { return o.get() == &b; });
+        if (bit != open.end()) {
+            open.erase(bit);
+        }
+        if (open.empty()) {
+            _open_batches.erase(it);
+        }
+    }
+};
+
+// Coalesces the mutations which concurrent writes send to the same replica
+// into MUTATION_BATCH messages.
+//
+// Batches are formed like those of read_data_batcher, so they gather e.g. the
+// partitions of an unlogged batch, which are all sent by one task. Only small
+// mutations without forwarding are batched; the replica applies each one as if
+// it came in its own MUTATION message and acknowledges it separately, so
+// response handlers are not affected.
+class storage_proxy::mutation_batcher {
+    struct pending_write {
+        lw_shared_ptr<const frozen_mutation> fm;
+        response_id_type response_id;
+        std::optional<tracing::trace_info> trace_info;
+        db::per_partition_rate_limit::info rate_limit_info;
+        clock_type::time_point timeout;
+        promise<> sent;
+    };
+    using batches_type = replica_batches<pending_write>;
+    using batch = batches_type::batch;
+    static constexpr size_t max_batch_size = 64;
+    static constexpr size_t max_batch_bytes = 256 * 1024;
+    // Larger mutations gain little from sharing a message.
+    static constexpr size_t max_batched_mutation_size = 16 * 1024;
+
+    storage_proxy& _proxy;
+    batches_type _batches;
+public:
+    explicit mutation_batcher(storage_proxy& proxy)
+        : _proxy(proxy)
+        , _batches(max_batch_size, max_batch_bytes, [this] (gms::inet_address ep, lw_shared_ptr<batch> b) { return flush(ep, std::move(b)); })
+    {}
+
+    bool can_batch(const frozen_mutation& fm, const inet_address_vector_replica_set& forward) const {
+        return forward.empty() && fm.representation().size() <= max_batched_mutation_size
+                && _proxy._db.local().get_config().coordinator_write_batching() && _proxy.features().mutation_batch;
+    }
+
+    future<> send(gms::inet_address ep, lw_shared_ptr<const frozen_mutation> fm, response_id_type response_id,
+            std::optional<tracing::trace_info> trace_info, db::per_partition_rate_limit::info rate_limit_info, clock_type::time_point timeout) {
+        auto bytes = fm->representation().size();
+        auto& w = _batches.add(ep, pending_write{std::move(fm), response_id, std::move(trace_info), rate_limit_info, timeout, {}}, bytes);
+        return w.sent.get_future();
+    }
+
+    future<> stop() {
+        return _batches.stop();
+    }
+private:
+    future<> flush(gms::inet_address ep, lw_shared_ptr<batch> b) {
+        auto my_address = utils::fb_utilities::get_broadcast_address();
+        future<> f = make_ready_future<>();
+        if (b->requests.size() == 1) {
+            auto& w = b->requests.front();
+            f = ser::storage_proxy_rpc_verbs::send_mutation(&_proxy._messaging, netw::messaging_service::msg_addr{ep, 0}, w.timeout,
+                    *w.fm, {}, my_address, this_shard_id(), w.response_id, std::move(w.trace_info), w.rate_limit_info);
+        } else {
+            std::vector<frozen_mutation> fms;
+            std::vector<response_id_type> response_ids;
+            std::vector<std::optional<tracing::trace_info>> trace_infos;
+            std::vector<db::per_partition_rate_limit::info> rate_limit_infos;
+            fms.reserve(b->requests.size());
+            response_ids.reserve(b->requests.size());
+            trace_infos.reserve(b->requests.size());
+            rate_limit_infos.reserve(b->requests.size());
+            // The replica applies all writes of the batch with the same timeout.
+            // Each write still fails at its own deadline, which its response handler enforces.
+            auto timeout = clock_type::time_point::min();
+            for (auto& w : b->requests) {
+                fms.push_back(*w.fm);
+                response_ids.push_back(w.response_id);
+                trace_infos.push_back(std::move(w.trace_info));
+                rate_limit_infos.push_back(w.rate_limit_info);
+                timeout = std::max(timeout, w.timeout);
+            }
+            auto& stats = _proxy.get_stats();
+            ++stats.mutation_batches;
+            stats.batched_mutations += b->requests.size();
+            f = ser::storage_proxy_rpc_verbs::send_mutation_batch(&_proxy._messaging, netw::messaging_service::msg_addr{ep, 0}, timeout,
+                    fms, my_address, this_shard_id(), response_ids, trace_infos, rate_limit_infos);
+        }
+        return f.then_wrapped([b] (future<> f) {
+            if (f.failed()) {
+                auto ex = f.get_exception();
+                for (auto& w : b->requests) {
+                    w.sent.set_exception(ex);
+                }
+                return;
+            }
+            for (auto& w : b->requests) {
+                w.sent.set_value();
+            }
+        });
+    }
+};
+
+future<> storage_proxy::send_mutation(gms::inet_address ep, lw_shared_ptr<const frozen_mutation> fm, inet_address_vector_replica_set&& forward,
+        response_id_type response_id, clock_type::time_point timeout, tracing::trace_state_ptr tr_state, db::per_partition_rate_limit::info rate_limit_info) {
+    if (_mutation_batcher->can_batch(*fm, forward)) {
+        tracing::trace(tr_state, "Queueing a batched mutation to /{}", ep);
+        return _mutation_batcher->send(ep, std::move(fm), response_id, tracing::make_trace_info(tr_state), rate_limit_info, timeout);
+    }
+    tracing::trace(tr_state, "Sending a mutation to /{}", ep);
+    return ser::storage_proxy_rpc_verbs::send_mutation(&_messaging,
+            netw::messaging_service::msg_addr{ep, 0}, timeout, *fm,
+            std::move(forward), utils::fb_utilities::get_broadcast_address(), this_shard_id(),
+            response_id, tracing::make_trace_info(tr_state),
+            rate_limit_info);
+}
+
 class mutation_holder {
 protected:
     size_t _size = 0;
@@ -264,12 +468,7 @@ class per_destination_mutation : public mutation_holder {
             tracing::trace_state_ptr tr_state, db::per_partition_rate_limit::info rate_limit_info) override {
         auto m = _mutations[ep];
         if (m) {
-            tracing::trace(tr_state, "Sending a mutation to /{}", ep);
-            return ser::storage_proxy_rpc_verbs::send_mutation(&sp._messaging,
-                                    netw::messaging_service::msg_addr{ep, 0}, timeout, *m,
-                                    std::move(forward), utils::fb_utilities::get_broadcast_address(), this_shard_id(),
-                                    response_id, tracing::make_trace_info(tr_state),
-                                    rate_limit_info);
+            return sp.send_mutation(ep, std::move(m), std::move(forward), response_id, timeout, std::move(tr_state), rate_limit_info);
         }
         sp.got_response(response_id, ep, std::nullopt);
         return make_ready_future<>();
@@ -312,12 +511,7 @@ class shared_mutation : public mutation_holder {
     virtual future<> apply_remotely(storage_proxy& sp, gms::inet_address ep, inet_address_vector_replica_set&& forward,
             storage_proxy::response_id_type response_id, storage_proxy::clock_type::time_point timeout,
             tracing::trace_state_ptr tr_state, db::per_partition_rate_limit::info rate_limit_info) override {
-        tracing::trace(tr_state, "Sending a mutation to /{}", ep);
-        return ser::storage_proxy_rpc_verbs::send_mutation(&sp._messaging,
-                netw::messaging_service::msg_addr{ep, 0}, timeout, *_mutation,
-                std::move(forward), utils::fb_utilities::get_broadcast_address(), this_shard_id(),
-                response_id, tracing::make_trace_info(tr_state),
-                rate_limit_info);
+        return sp.send_mutation(ep, _mutation, std::move(forward), response_id, timeout, std::move(tr_state), rate_limit_info);
     }
     virtual bool is_shared() override {
         return true;
@@ -1466,7 +1660,8 @@ void storage_proxy::maybe_update_view_backlog_of(gms::inet_address replica, std:
 }
 
 db::view::update_backlog storage_proxy::get_view_update_backlog() const {
-    return _max_view_update_backlog.add_fetch(this_shard_id(), get_db().local().get_view_update_backlog());
+    auto& db = get_db().local();
+    return _max_view_update_backlog.add_fetch(this_shard_id(), std::max(db.get_view_update_backlog(), db.get_write_throttle_backlog()));
 }
 
 db::view::update_backlog storage_proxy::get_backlog_of(gms::inet_address ep) const {
@@ -1653,6 +1848,10 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of background read repairs"),
                        {storage_proxy_stats::current_scheduling_group_label()}),
 
+        sm::make_total_operations("coalesced_background_read_repairs", read_repair_coalesced_background,
+                       sm::description("number of background read repairs not started because one for the same partition was in progress"),
+                       {storage_proxy_stats::current_scheduling_group_label()}),
+
         sm::make_total_operations("read_timeouts", [this]{return read_timeouts.count(); },
                        sm::description("number of read request failed due to a timeout"),
                        {storage_proxy_stats::current_scheduling_group_label()}),
@@ -1685,6 +1884,26 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of speculative data read requests that were sent"),
                        {storage_proxy_stats::current_scheduling_group_label()}),
 
+        sm::make_total_operations("mutation_batches", mutation_batches,
+                       sm::description("number of messages which carried several mutations to the same replica"),
+                       {storage_proxy_stats::current_scheduling_group_label()}),
+
+        sm::make_total_operations("batched_mutations", batched_mutations,
+                       sm::description("number of mutations that were sent as part of a batch"),
+                       {storage_proxy_stats::current_scheduling_group_label()}),
+
+        sm::make_total_operations("data_read_batches", data_read_batches,
+                       sm::description("number of messages which carried several data read requests to the same replica"),
+                       {storage_proxy_stats::current_scheduling_group_label()}),
+
+        sm::make_total_operations("batched_data_reads", batched_data_reads,
+                       sm::description("number of data read requests that were sent as part of a batch"),
+                       {storage_proxy_stats::current_scheduling_group_label()}),
+
+        sm::make_total_operations("reads_reordered_by_latency", reads_reordered_by_latency,
+                       sm::description("number of reads whose replicas were reordered because some replicas were slower than others"),
+                       {storage_proxy_stats::current_scheduling_group_label()}),
+
         sm::make_histogram("cas_read_latency", sm::description("Transactional read latency histogram"),
                 {storage_proxy_stats::current_scheduling_group_label()},
                 [this]{ return to_metrics_histogram(estimated_cas_read);}),
@@ -1788,6 +2007,14 @@ void storage_proxy_stats::stats::register_stats() {
                        sm::description("number of remote digest read requests this Node received"),
                        {storage_proxy_stats::current_scheduling_group_label(), storage_proxy_stats::op_type_label("digest")}),
 
+        sm::make_total_operations("mutation_batches", replica_mutation_batches,
+                       sm::description("number of batches of remote mutations this Node received"),
+                       {storage_proxy_stats::current_scheduling_group_label()}),
+
+        sm::make_total_operations("read_batches", replica_data_read_batches,
+                       sm::description("number of batches of remote data read requests this Node received"),
+                       {storage_proxy_stats::current_scheduling_group_label()}),
+
         sm::make_total_operations("cross_shard_ops", replica_cross_shard_ops,
                        sm::description("number of operations that crossed a shard boundary"),
                        {storage_proxy_stats::current_scheduling_group_label()}),
@@ -1890,7 +2117,9 @@ storage_proxy::storage_proxy(distributed<replica::database>& db, gms::gossiper&
     , _connection_dropped([this] (gms::inet_address addr) { connection_dropped(std::move(addr)); })
     , _condrop_registration(_messaging.when_connection_drops(_connection_dropped))
     , _max_view_update_backlog(max_view_update_backlog)
-    , _view_update_handlers_list(std::make_unique<view_update_handlers_list>()) {
+    , _view_update_handlers_list(std::make_unique<view_update_handlers_list>())
+    , _read_data_batcher(std::make_unique<read_data_batcher>(*this))
+    , _mutation_batcher(std::make_unique<mutation_batcher>(*this)) {
     namespace sm = seastar::metrics;
     _metrics.add_group(storage_proxy_stats::COORDINATOR_STATS_CATEGORY, {
         sm::make_queue_length("current_throttled_writes", [this] { return _throttled_writes.size(); },
@@ -3626,6 +3855,119 @@ class data_read_resolver : public abstract_read_resolver {
     }
 };
 
+// Coalesces the data reads which concurrent single-partition queries send to
+// the same replica into READ_DATA_BATCH messages.
+//
+// Batches are formed by replica_batches, so they gather the reads issued by
+// the tasks which were ready at the same time, e.g. the partitions of an IN
+// query or the requests of a multi-get which arrived in the same poll.
+// A batch holding a single read is sent as a plain READ_DATA.
+class storage_proxy::read_data_batcher {
+public:
+    using result_type = rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>;
+private:
+    struct pending_read {
+        lw_shared_ptr<query::read_command> cmd;
+        dht::partition_range range;
+        query::digest_algorithm digest_algo;
+        db::per_partition_rate_limit::info rate_limit_info;
+        clock_type::time_point timeout;
+        promise<result_type> response;
+    };
+    using batches_type = replica_batches<pending_read>;
+    using batch = batches_type::batch;
+    // Keeps the replica's response to a batch reasonably small.
+    static constexpr size_t max_batch_size = 64;
+
+    storage_proxy& _proxy;
+    batches_type _batches;
+public:
+    explicit read_data_batcher(storage_proxy& proxy)
+        : _proxy(proxy)
+        , _batches(max_batch_size, std::numeric_limits<size_t>::max(), [this] (gms::inet_address ep, lw_shared_ptr<batch> b) { return send(ep, std::move(b)); })
+    {}
+
+    bool enabled() const {
+        return _proxy._db.local().get_config().coordinator_read_batching() && _proxy.features().read_data_batch;
+    }
+
+    future<result_type> read(gms::inet_address ep, lw_shared_ptr<query::read_command> cmd, const dht::partition_range& range,
+            query::digest_algorithm digest_algo, db::per_partition_rate_limit::info rate_limit_info, clock_type::time_point timeout) {
+        auto& r = _batches.add(ep, pending_read{std::move(cmd), range, digest_algo, rate_limit_info, timeout, {}});
+        return r.response.get_future();
+    }
+
+    future<> stop() {
+        return _batches.stop();
+    }
+private:
+    future<> send(gms::inet_address ep, lw_shared_ptr<batch> b) {
+        if (b->requests.size() == 1) {
+            auto& r = b->requests.front();
+            return ser::storage_proxy_rpc_verbs::send_read_data(&_proxy._messaging, netw::messaging_service::msg_addr{ep, 0}, r.timeout,
+                    *r.cmd, r.range, r.digest_algo, r.rate_limit_info).then_wrapped([b] (
+                    future<rpc::tuple<query::result, rpc::optional<cache_temperature>, rpc::optional<replica::exception_variant>>> f) {
+                auto& response = b->requests.front().response;
+                if (f.failed()) {
+                    response.set_exception(f.get_exception());
+                    return;
+                }
+                auto&& [result, hit_rate, opt_exception] = f.get0();
+                if (opt_exception.has_value() && *opt_exception) {
+                    response.set_exception((*opt_exception).into_exception_ptr());
+                    return;
+                }
+                response.set_value(result_type(make_foreign(::make_lw_shared<query::result>(std::move(result))), hit_rate.value_or(cache_temperature::invalid())));
+            });
+        }
+
+        std::vector<query::read_command> cmds;
+        std::vector<::compat::wrapping_partition_range> ranges;
+        std::vector<query::digest_algorithm> digest_algos;
+        std::vector<db::per_partition_rate_limit::info> rate_limit_infos;
+        cmds.reserve(b->requests.size());
+        ranges.reserve(b->requests.size());
+        digest_algos.reserve(b->requests.size());
+        rate_limit_infos.reserve(b->requests.size());
+        // The replica serves all reads of the batch with the same timeout.
+        // Each read still fails at its own deadline, which its executor enforces.
+        auto timeout = clock_type::time_point::min();
+        for (auto& r : b->requests) {
+            cmds.push_back(*r.cmd);
+            ranges.emplace_back(r.range);
+            digest_algos.push_back(r.digest_algo);
+            rate_limit_infos.push_back(r.rate_limit_info);
+            timeout = std::max(timeout, r.timeout);
+        }
+        auto& stats = _proxy.get_stats();
+        ++stats.data_read_batches;
+        stats.batched_data_reads += b->requests.size();
+        return ser::storage_proxy_rpc_verbs::send_read_data_batch(&_proxy._messaging, netw::messaging_service::msg_addr{ep, 0}, timeout,
+                cmds, ranges, digest_algos, rate_limit_infos).then_wrapped([b] (
+                future<rpc::tuple<std::vector<query::result>, std::vector<cache_temperature>, std::vector<replica::exception_variant>>> f) {
+            if (f.failed()) {
+                auto ex = f.get_exception();
+                for (auto& r : b->requests) {
+                    r.response.set_exception(ex);
+                }
+                return;
+            }
+            auto&& [results, hit_rates, exceptions] = f.get0();
+            for (size_t i = 0; i < b->requests.size(); ++i) {
+                auto& response = b->requests[i].response;
+                if (i >= results.size() || i >= hit_rates.size() || i >= exceptions.size()) {
+                    response.set_exception(std::make_exception_ptr(std::runtime_error(
+                            format("READ_DATA_BATCH returned {} responses for {} reads", results.size(), b->requests.size()))));
+                } else if (exceptions[i]) {
+                    response.set_exception(exceptions[i].into_exception_ptr());
+                } else {
+                    response.set_value(result_type(make_foreign(::make_lw_shared<query::result>(std::move(results[i]))), hit_rates[i]));
+                }
+            }
+        });
+    }
+};
+
 class abstract_read_executor : public enable_shared_from_this<abstract_read_executor> {
 protected:
     using targets_iterator = inet_address_vector_replica_set::iterator;
@@ -3711,6 +4053,13 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
         if (fbu::is_me(ep)) {
             tracing::trace(_trace_state, "read_data: querying locally");
             return _proxy->query_result_local(_schema, _cmd, _partition_range, opts, _trace_state, timeout, adjust_rate_limit_for_local_operation(_rate_limit_info));
+        } else if (_proxy->_read_data_batcher->enabled()) {
+            tracing::trace(_trace_state, "read_data: queueing a batched message to /{}", ep);
+            return _proxy->_read_data_batcher->read(ep, _cmd, _partition_range, opts.digest_algo, _rate_limit_info, timeout).then([this, ep] (
+                    rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature> result) {
+                tracing::trace(_trace_state, "read_data: got response from /{}", ep);
+                return result;
+            });
         } else {
             tracing::trace(_trace_state, "read_data: sending a message to /{}", ep);
             return ser::storage_proxy_rpc_verbs::send_read_data(&_proxy->_messaging, netw::messaging_service::msg_addr{ep, 0}, timeout, *_cmd, _partition_range, opts.digest_algo, _rate_limit_info).then([this, ep](rpc::tuple<query::result, rpc::optional<cache_temperature>, rpc::optional<replica::exception_variant>> result_hit_rate) {
@@ -3756,6 +4105,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     resolver->add_mutate_data(ep, std::get<0>(std::move(v)));
                     ++_proxy->get_stats().mutation_data_read_completed.get_ep_stat(get_topology(), ep);
                     register_request_latency(latency_clock::now() - start);
+                    register_replica_latency(ep, latency_clock::now() - start);
                     return;
                   } else {
                     ex = f.get_exception();
@@ -3764,6 +4114,10 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                   ex = std::current_exception();
                 }
 
+                if (try_catch<rpc::timeout_error>(ex)) {
+                    // The replica is at least this slow.
+                    register_replica_latency(ep, latency_clock::now() - start);
+                }
                 ++_proxy->get_stats().mutation_data_read_errors.get_ep_stat(get_topology(), ep);
                 resolver->error(ep, std::move(ex));
             });
@@ -3783,6 +4137,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     ++_proxy->get_stats().data_read_completed.get_ep_stat(get_topology(), ep);
                     _used_targets.push_back(ep);
                     register_request_latency(latency_clock::now() - start);
+                    register_replica_latency(ep, latency_clock::now() - start);
                     return;
                   } else {
                     ex = f.get_exception();
@@ -3791,6 +4146,10 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                   ex = std::current_exception();
                 }
 
+                if (try_catch<rpc::timeout_error>(ex)) {
+                    // The replica is at least this slow.
+                    register_replica_latency(ep, latency_clock::now() - start);
+                }
                 ++_proxy->get_stats().data_read_errors.get_ep_stat(get_topology(), ep);
                 resolver->error(ep, std::move(ex));
             });
@@ -3810,6 +4169,7 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                     ++_proxy->get_stats().digest_read_completed.get_ep_stat(get_topology(), ep);
                     _used_targets.push_back(ep);
                     register_request_latency(latency_clock::now() - start);
+                    register_replica_latency(ep, latency_clock::now() - start);
                     return;
                   } else {
                     ex = f.get_exception();
@@ -3818,6 +4178,10 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
                   ex = std::current_exception();
                 }
 
+                if (try_catch<rpc::timeout_error>(ex)) {
+                    // The replica is at least this slow.
+                    register_replica_latency(ep, latency_clock::now() - start);
+                }
                 ++_proxy->get_stats().digest_read_errors.get_ep_stat(get_topology(), ep);
                 resolver->error(ep, std::move(ex));
             });
@@ -4008,10 +4372,25 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
             // Waited on indirectly.
             (void)digest_resolver->done().then(utils::result_wrap([exec, digest_resolver, timeout, background_repair_check] () mutable {
                 if (background_repair_check && !digest_resolver->digests_match()) {
+                    std::optional<std::tuple<utils::UUID, dht::token, bytes>> key;
+                    if (exec->_partition_range.is_singular() && exec->_partition_range.start()->value().has_key()) {
+                        auto dk = exec->_partition_range.start()->value().as_decorated_key();
+                        key.emplace(exec->_schema->id(), dk.token(), to_bytes(dk.key().representation()));
+                        if (!exec->_proxy->_background_read_repairs.insert(*key).second) {
+                            exec->_proxy->get_stats().read_repair_coalesced_background++;
+                            return make_ready_future<result<>>(bo::success());
+                        }
+                    }
                     exec->_proxy->get_stats().read_repair_repaired_background++;
-                    exec->_result_promise = promise<result<foreign_ptr<lw_shared_ptr<query::result>>>>();
-                    exec->reconcile(exec->_cl, timeout);
-                    return exec->_result_promise.get_future().then(utils::result_discard_value<result<foreign_ptr<lw_shared_ptr<query::result>>>>);
+                    return utils::get_local_injector().inject("storage_proxy_delay_background_read_repair", std::chrono::milliseconds(1000)).then([exec, timeout] {
+                        exec->_result_promise = promise<result<foreign_ptr<lw_shared_ptr<query::result>>>>();
+                        exec->reconcile(exec->_cl, timeout);
+                        return exec->_result_promise.get_future().then(utils::result_discard_value<result<foreign_ptr<lw_shared_ptr<query::result>>>>);
+                    }).finally([exec, key] {
+                        if (key) {
+                            exec->_proxy->_background_read_repairs.erase(*key);
+                        }
+                    });
                 } else {
                     return make_ready_future<result<>>(bo::success());
                 }
@@ -4042,6 +4421,12 @@ class abstract_read_executor : public enable_shared_from_this<abstract_read_exec
         _max_request_latency = std::max(_max_request_latency, d);
     }
 
+    void register_replica_latency(gms::inet_address ep, latency_clock::duration d) {
+        if (_proxy->get_db().local().get_config().replica_latency_read_balancing()) {
+            _proxy->_replica_latencies.add(ep, std::chrono::duration_cast<std::chrono::microseconds>(d));
+        }
+    }
+
     static constexpr latency_clock::duration NO_LATENCY{-1};
     latency_clock::duration _max_request_latency{NO_LATENCY};
 };
@@ -4092,7 +4477,8 @@ class speculating_read_executor : public abstract_read_executor {
         });
         auto& sr = _schema->speculative_retry();
         auto t = (sr.get_type() == speculative_retry::type::PERCENTILE) ?
-            std::min(_cf->get_coordinator_read_latency_percentile(sr.get_value()), std::chrono::milliseconds(_proxy->get_db().local().get_config().read_request_timeout_in_ms()/2)) :
+            std::min(speculation_threshold(sr.get_value()), std::chrono::duration_cast<storage_proxy::clock_type::duration>(
+                    std::chrono::milliseconds(_proxy->get_db().local().get_config().read_request_timeout_in_ms()/2))) :
             std::chrono::milliseconds(unsigned(sr.get_value()));
         _speculate_timer.arm(t);
 
@@ -4120,6 +4506,24 @@ class speculating_read_executor : public abstract_read_executor {
     virtual void adjust_targets_for_reconciliation() override {
         _targets = used_targets();
     }
+private:
+    // The read speculates once it has waited longer than the given percentile of
+    // the latencies of the replicas it waits for. Without enough samples of some
+    // replica, the percentile of the table's read latency is used instead.
+    storage_proxy::clock_type::duration speculation_threshold(double percentile) {
+        if (!_proxy->get_db().local().get_config().replica_latency_read_balancing()) {
+            return _cf->get_coordinator_read_latency_percentile(percentile);
+        }
+        std::chrono::microseconds threshold{0};
+        for (auto ep : boost::make_iterator_range(_targets.begin(), _targets.end() - 1)) {
+            auto p = _proxy->_replica_latencies.percentile(ep, percentile);
+            if (!p) {
+                return _cf->get_coordinator_read_latency_percentile(percentile);
+            }
+            threshold = std::max(threshold, *p);
+        }
+        return threshold;
+    }
 };
 
 db::read_repair_decision storage_proxy::new_read_repair_decision(const schema& s) {
@@ -4158,6 +4562,17 @@ result<::shared_ptr<abstract_read_executor>> storage_proxy::get_read_executor(lw
     // orders the list by proximity to the local endpoint.
     is_read_non_local |= !all_replicas.empty() && all_replicas.front() != utils::fb_utilities::get_broadcast_address();
 
+    if (_db.local().get_config().replica_latency_read_balancing()) {
+        auto& cfg = _db.local().get_config();
+        _replica_latencies.maybe_reset(std::chrono::milliseconds(cfg.dynamic_snitch_reset_interval_in_ms()));
+        const auto& topology = get_token_metadata_ptr()->get_topology();
+        if (_replica_latencies.sort(all_replicas, cfg.dynamic_snitch_badness_threshold(), [&topology] (gms::inet_address ep) {
+                    return topology.get_datacenter(ep);
+                })) {
+            ++get_stats().reads_reordered_by_latency;
+        }
+    }
+
     auto cf = _db.local().find_column_family(schema).shared_from_this();
     inet_address_vector_replica_set target_replicas = db::filter_for_query(cl, ks, all_replicas, preferred_endpoints, repair_decision,
             _gossiper,
@@ -4239,6 +4654,13 @@ storage_proxy::query_result_local(schema_ptr s, lw_shared_ptr<query::read_comman
     cmd->slice.options.set_if<query::partition_slice::option::with_digest>(opts.request != query::result_request::only_result);
     if (pr.is_singular()) {
         unsigned shard = dht::shard_of(*s, pr.start()->value().token());
+        if (shard != this_shard_id() && std::holds_alternative<std::monostate>(rate_limit_info)) {
+            if (auto res = _db.local().hot_partitions().query(s, *cmd, pr, opts)) {
+                auto&& [r, ht] = *res;
+                tracing::trace(trace_state, "Served singular range {} from a copy of a hot partition", pr);
+                return make_ready_future<rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature>>(rpc::tuple(make_foreign(std::move(r)), ht));
+            }
+        }
         get_stats().replica_cross_shard_ops += shard != this_shard_id();
         return _db.invoke_on(shard, _read_smp_service_group, [gs = global_schema_ptr(s), prv = dht::partition_range_vector({pr}) /* FIXME: pr is copied */, cmd, opts, timeout, gt = tracing::global_trace_state_ptr(std::move(trace_state)), rate_limit_info] (replica::database& db) mutable {
             auto trace_state = gt.get();
@@ -4389,6 +4811,25 @@ storage_proxy::query_singular(lw_shared_ptr<query::read_command> cmd,
     co_return coordinator_query_result(std::move(result).value(), std::move(used_replicas), repair_decision);
 }
 
+// The number of vnode ranges a range scan should read next in order to get
+// the remaining rows in one round, given how many rows it expects per range
+// and how many ranges it read in the previous round, if any.
+static int range_scan_concurrency(std::optional<double> rows_per_range, uint64_t remaining_row_count, int concurrency, int max_concurrency) {
+    if (!rows_per_range) {
+        return 1;
+    }
+    if (*rows_per_range <= 0) {
+        // The ranges read so far were empty, there's nothing to go by. Data
+        // may still be just ahead, so grow geometrically rather than jumping
+        // to the maximum, as a single empty round would otherwise do.
+        return std::min(concurrency * 2, max_concurrency);
+    }
+    // Ranges don't hold the same number of rows. Leave a margin, so that a round
+    // which meets a few sparse ranges doesn't fall just short of the limit.
+    auto ranges = std::ceil(remaining_row_count * 1.1 / *rows_per_range);
+    return ranges < max_concurrency ? std::max(int(ranges), 1) : max_concurrency;
+}
+
 future<result<query_partition_key_range_concurrent_result>>
 storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::time_point timeout,
         std::vector<foreign_ptr<lw_shared_ptr<query::result>>>&& results,
@@ -4428,6 +4869,7 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
     // eventualy zero out resulting in an infinite recursion. This line makes sure that concurrency factor is never
     // get stuck on 0 and never increased too much if the number of results remains small.
     concurrency_factor = std::max(size_t(1), ranges.size());
+    const size_t ranges_queried = ranges.size();
 
     while (i != ranges.end()) {
         dht::partition_range& range = *i;
@@ -4548,12 +4990,14 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
     return utils::result_futurize_try([&] {
       return f.then(utils::result_wrap([p,
             tmptr,
+            table = cf.shared_from_this(),
             exec = std::move(exec),
             results = std::move(results),
             ranges_to_vnodes = std::move(ranges_to_vnodes),
             cl,
             cmd,
             concurrency_factor,
+            ranges_queried,
             timeout,
             remaining_row_count,
             remaining_partition_count,
@@ -4562,9 +5006,16 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
             ranges_per_exec = std::move(ranges_per_exec),
             permit = std::move(permit)] (foreign_ptr<lw_shared_ptr<query::result>>&& result) mutable {
         result->ensure_counts();
-        remaining_row_count -= result->row_count().value();
+        auto rows = result->row_count().value();
+        remaining_row_count -= rows;
         remaining_partition_count -= result->partition_count().value();
         results.emplace_back(std::move(result));
+        // Rows per range are only known if the limit didn't cut the result short.
+        std::optional<double> rows_per_range;
+        if (remaining_row_count && remaining_partition_count && ranges_queried) {
+            rows_per_range = double(rows) / ranges_queried;
+            table->add_range_scan_rows_per_range(*rows_per_range);
+        }
         if (ranges_to_vnodes.empty() || !remaining_row_count || !remaining_partition_count) {
             auto used_replicas = replicas_per_token_range();
             for (auto& e : exec) {
@@ -4582,8 +5033,11 @@ storage_proxy::query_partition_key_range_concurrent(storage_proxy::clock_type::t
         } else {
             cmd->set_row_limit(remaining_row_count);
             cmd->partition_limit = remaining_partition_count;
+            auto max_concurrency = std::max(int(p->_db.local().get_config().max_range_scan_concurrency()), 1);
+            auto next_concurrency_factor = range_scan_concurrency(rows_per_range, remaining_row_count, concurrency_factor, max_concurrency);
+            slogger.trace("Range scan read {} rows from {} ranges, reading {} ranges next", rows, ranges_queried, next_concurrency_factor);
             return p->query_partition_key_range_concurrent(timeout, std::move(results), cmd, cl, std::move(ranges_to_vnodes),
-                    concurrency_factor * 2, std::move(trace_state), remaining_row_count, remaining_partition_count, std::move(preferred_replicas), std::move(permit));
+                    next_concurrency_factor, std::move(trace_state), remaining_row_count, remaining_partition_count, std::move(preferred_replicas), std::move(permit));
         }
       }));
     },  utils::result_catch_dots([p] (auto&& handle) {
@@ -4604,13 +5058,16 @@ storage_proxy::query_partition_key_range(lw_shared_ptr<query::read_command> cmd,
     // expensive in clusters with vnodes)
     query_ranges_to_vnodes_generator ranges_to_vnodes(get_token_metadata_ptr(), schema, std::move(partition_ranges), ks.get_replication_strategy().get_type() == locator::replication_strategy_type::local);
 
-    int result_rows_per_range = 0;
-    int concurrency_factor = 1;
+    // Start with as many ranges as previous scans of the table suggest are needed
+    // for the requested rows. Without previous scans, start with a single range.
+    auto result_rows_per_range = _db.local().find_column_family(schema).get_range_scan_rows_per_range();
+    auto max_concurrency = std::max(int(_db.local().get_config().max_range_scan_concurrency()), 1);
+    int concurrency_factor = range_scan_concurrency(result_rows_per_range, cmd->get_row_limit(), 1, max_concurrency);
 
     std::vector<foreign_ptr<lw_shared_ptr<query::result>>> results;
 
     slogger.debug("Estimated result rows per range: {}; requested rows: {}, concurrent range requests: {}",
-            result_rows_per_range, cmd->get_row_limit(), concurrency_factor);
+            result_rows_per_range ? format("{}", *result_rows_per_range) : sstring("unknown"), cmd->get_row_limit(), concurrency_factor);
 
     // The call to `query_partition_key_range_concurrent()` below
     // updates `cmd` directly when processing the results. Under
@@ -5094,11 +5551,13 @@ void storage_proxy::init_messaging_service(shared_ptr<migration_manager> mm) {
     _mm = std::move(mm);
     ser::storage_proxy_rpc_verbs::register_counter_mutation(&_messaging, std::bind_front(&storage_proxy::handle_counter_mutation, this));
     ser::storage_proxy_rpc_verbs::register_mutation(&_messaging, std::bind_front(&storage_proxy::receive_mutation_handler, this, _write_smp_service_group));
+    ser::storage_proxy_rpc_verbs::register_mutation_batch(&_messaging, std::bind_front(&storage_proxy::handle_mutation_batch, this));
     ser::storage_proxy_rpc_verbs::register_hint_mutation(&_messaging, [this] <typename... Args>(Args&&... args) { return receive_mutation_handler(_hints_write_smp_service_group, std::forward<Args>(args)..., std::monostate()); });
     ser::storage_proxy_rpc_verbs::register_paxos_learn(&_messaging, std::bind_front(&storage_proxy::handle_paxos_learn, this));
     ser::storage_proxy_rpc_verbs::register_mutation_done(&_messaging, std::bind_front(&storage_proxy::handle_mutation_done, this));
     ser::storage_proxy_rpc_verbs::register_mutation_failed(&_messaging, std::bind_front(&storage_proxy::handle_mutation_failed, this));
     ser::storage_proxy_rpc_verbs::register_read_data(&_messaging, std::bind_front(&storage_proxy::handle_read_data, this));
+    ser::storage_proxy_rpc_verbs::register_read_data_batch(&_messaging, std::bind_front(&storage_proxy::handle_read_data_batch, this));
     ser::storage_proxy_rpc_verbs::register_read_mutation_data(&_messaging, std::bind_front(&storage_proxy::handle_read_mutation_data, this));
     ser::storage_proxy_rpc_verbs::register_read_digest(&_messaging, std::bind_front(&storage_proxy::handle_read_digest, this));
     ser::storage_proxy_rpc_verbs::register_truncate(&_messaging, std::bind_front(&storage_proxy::handle_truncate, this));
@@ -5245,6 +5704,11 @@ storage_proxy::receive_mutation_handler(smp_service_group smp_grp, const rpc::cl
         auto src_addr = netw::messaging_service::get_source(cinfo);
         auto rate_limit_info = rate_limit_info_opt.value_or(std::monostate());
 
+        // Lets the coordinator time out on a live replica, and hint the write.
+        if (smp_grp == _write_smp_service_group && utils::get_local_injector().enter("storage_proxy_drop_mutation")) {
+            return make_ready_future<rpc::no_wait_type>(netw::messaging_service::no_wait());
+        }
+
         utils::UUID schema_version = in.schema_version();
         return handle_write(src_addr, t, schema_version, std::move(in), std::move(forward), reply_to, shard, response_id,
                 trace_info ? *trace_info : std::nullopt,
@@ -5260,6 +5724,23 @@ storage_proxy::receive_mutation_handler(smp_service_group smp_grp, const rpc::cl
                 });
 }
 
+future<rpc::no_wait_type>
+storage_proxy::handle_mutation_batch(const rpc::client_info& cinfo, rpc::opt_time_point t, std::vector<frozen_mutation> fms,
+            gms::inet_address reply_to, unsigned shard, std::vector<response_id_type> response_ids,
+            std::vector<std::optional<tracing::trace_info>> trace_infos, std::vector<db::per_partition_rate_limit::info> rate_limit_infos) {
+    if (response_ids.size() != fms.size() || trace_infos.size() != fms.size() || rate_limit_infos.size() != fms.size()) {
+        throw std::runtime_error(format("MUTATION_BATCH called with {} mutations, {} response ids, {} trace infos and {} rate limit infos",
+                fms.size(), response_ids.size(), trace_infos.size(), rate_limit_infos.size()));
+    }
+    get_stats().replica_mutation_batches++;
+    // Each mutation is acknowledged on its own, with MUTATION_DONE or MUTATION_FAILED.
+    co_await coroutine::parallel_for_each(boost::irange<size_t>(0, fms.size()), [&] (size_t i) -> future<> {
+        co_await receive_mutation_handler(_write_smp_service_group, cinfo, t, std::move(fms[i]), {}, reply_to, shard, response_ids[i],
+                std::move(trace_infos[i]), rate_limit_infos[i]);
+    });
+    co_return netw::messaging_service::no_wait();
+}
+
 future<rpc::no_wait_type>
 storage_proxy::handle_paxos_learn(const rpc::client_info& cinfo, rpc::opt_time_point t, paxos::proposal decision,
             inet_address_vector_replica_set forward, gms::inet_address reply_to, unsigned shard,
@@ -5368,6 +5849,36 @@ storage_proxy::handle_read_data(const rpc::client_info& cinfo, rpc::opt_time_poi
         });
 }
 
+future<rpc::tuple<std::vector<query::result>, std::vector<cache_temperature>, std::vector<replica::exception_variant>>>
+storage_proxy::handle_read_data_batch(const rpc::client_info& cinfo, rpc::opt_time_point t, std::vector<query::read_command> cmds, std::vector<::compat::wrapping_partition_range> prs,
+        std::vector<query::digest_algorithm> digest_algos, std::vector<db::per_partition_rate_limit::info> rate_limit_infos) {
+    if (prs.size() != cmds.size() || digest_algos.size() != cmds.size() || rate_limit_infos.size() != cmds.size()) {
+        throw std::runtime_error(format("READ_DATA_BATCH called with {} commands, {} ranges, {} digest algorithms and {} rate limit infos",
+                cmds.size(), prs.size(), digest_algos.size(), rate_limit_infos.size()));
+    }
+    get_stats().replica_data_read_batches++;
+    std::vector<query::result> results(cmds.size());
+    std::vector<cache_temperature> hit_rates(cmds.size(), cache_temperature::invalid());
+    std::vector<replica::exception_variant> exceptions(cmds.size());
+    co_await coroutine::parallel_for_each(boost::irange<size_t>(0, cmds.size()), [&] (size_t i) -> future<> {
+        auto f = co_await coroutine::as_future(handle_read_data(cinfo, t, std::move(cmds[i]), std::move(prs[i]), digest_algos[i], rate_limit_infos[i]));
+        if (f.failed()) {
+            // The exception cannot be sent back on its own without failing the
+            // other reads of the batch, so only the fact that the read failed is.
+            slogger.debug("read_data_batch: read {} failed: {}", i, f.get_exception());
+            exceptions[i] = replica::unknown_exception{};
+            co_return;
+        }
+        auto&& [result, hit_rate, ex] = f.get0();
+        // The result may live on another shard. It isn't shared, so its buffers are
+        // moved into the response, which is serialized here.
+        results[i] = std::move(*result);
+        hit_rates[i] = hit_rate;
+        exceptions[i] = std::move(ex);
+    });
+    co_return rpc::tuple(std::move(results), std::move(hit_rates), std::move(exceptions));
+}
+
 future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature, replica::exception_variant>>
 storage_proxy::handle_read_mutation_data(const rpc::client_info& cinfo, rpc::opt_time_point t, query::read_command cmd, ::compat::wrapping_partition_range pr) {
         tracing::trace_state_ptr trace_state_ptr;
@@ -5427,6 +5938,11 @@ storage_proxy::handle_read_digest(const rpc::client_info& cinfo, rpc::opt_time_p
                 }
                 auto timeout = t ? *t : db::no_timeout;
                 return p->query_result_local_digest(std::move(s), cmd, std::move(pr2.first), trace_state_ptr, timeout, da, rate_limit_info);
+            }).then([] (rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature> r) {
+                utils::get_local_injector().inject("storage_proxy_corrupt_read_digest", [&r] {
+                    std::get<0>(r) = query::result_digest(query::result_digest::type{});
+                });
+                return r;
             }).then_wrapped([this, &trace_state_ptr, src_ip] (future<rpc::tuple<query::result_digest, api::timestamp_type, cache_temperature>> f) mutable {
                 tracing::trace(trace_state_ptr, "read_digest handling is done, sending a response to /{}", src_ip);
                 return encode_replica_exception_for_rpc(std::move(f), [] { return std::make_tuple(query::result_digest(), api::missing_timestamp, cache_temperature::invalid()); });
@@ -5671,6 +6187,24 @@ future<db::hints::sync_point> storage_proxy::create_hint_sync_point(const std::v
     co_return spoint;
 }
 
+future<std::vector<gms::inet_address>> storage_proxy::get_endpoints_with_pending_hints() const {
+    std::set<gms::inet_address> eps;
+    co_await coroutine::parallel_for_each(boost::irange<unsigned>(0, smp::count), [this, &eps] (unsigned shard) {
+        const auto& sharded_sp = container();
+        // sharded::invoke_on does not have a const-method version, so we cannot use it here
+        return smp::submit_to(shard, [&sharded_sp] {
+            const storage_proxy& sp = sharded_sp.local();
+            auto shard_eps = sp._hints_manager.endpoints_with_segments_to_replay();
+            auto mv_eps = sp._hints_for_views_manager.endpoints_with_segments_to_replay();
+            shard_eps.insert(shard_eps.end(), mv_eps.begin(), mv_eps.end());
+            return shard_eps;
+        }).then([&eps] (std::vector<gms::inet_address> shard_eps) {
+            eps.insert(shard_eps.begin(), shard_eps.end());
+        });
+    });
+    co_return std::vector<gms::inet_address>(eps.begin(), eps.end());
+}
+
 future<> storage_proxy::wait_for_hint_sync_point(const db::hints::sync_point spoint, clock_type::time_point deadline) {
     const utils::UUID my_host_id = _db.local().get_config().host_id;
     if (spoint.host_id != my_host_id) {
@@ -5785,7 +6319,8 @@ future<> storage_proxy::drain_on_shutdown() {
 
 future<>
 storage_proxy::stop() {
-    return make_ready_future<>();
+    co_await _read_data_batcher->stop();
+    co_await _mutation_batcher->stop();
 }
 
 locator::token_metadata_ptr storage_proxy::get_token_metadata_ptr() const noexcept {
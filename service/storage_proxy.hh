@@ -48,6 +48,8 @@
 #include "exceptions/coordinator_result.hh"
 #include "replica/exceptions.hh"
 #include "db/per_partition_rate_limit_info.hh"
+#include "service/replica_latency_tracker.hh"
+#include "utils/hash.hh"
 
 class reconcilable_result;
 class frozen_mutation_and_schema;
@@ -282,6 +284,24 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     class view_update_handlers_list;
     std::unique_ptr<view_update_handlers_list> _view_update_handlers_list;
 
+    // Coalesces data reads sent to the same replica, see storage_proxy.cc.
+    class read_data_batcher;
+    std::unique_ptr<read_data_batcher> _read_data_batcher;
+
+    // Coalesces small mutations sent to the same replica, see storage_proxy.cc.
+    class mutation_batcher;
+    std::unique_ptr<mutation_batcher> _mutation_batcher;
+
+    // Latencies of the reads sent to each replica, which order the replicas of
+    // reads and decide when they speculate.
+    replica_latency_tracker _replica_latencies;
+
+    // Partitions, by table, token and key, with a background read repair in
+    // progress. Concurrent reads which find the same mismatch don't start
+    // another one; the repair in progress sends the same diffs. The key is
+    // part of the entry, since distinct partitions may share a token.
+    std::unordered_set<std::tuple<utils::UUID, dht::token, bytes>, utils::tuple_hash> _background_read_repairs;
+
     /* This is a pointer to the shard-local part of the sharded cdc_service:
      * storage_proxy needs access to cdc_service to augument mutations.
      *
@@ -438,6 +458,9 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
                       utils::UUID schema_version, auto in, inet_address_vector_replica_set forward, gms::inet_address reply_to,
                       unsigned shard, storage_proxy::response_id_type response_id, std::optional<tracing::trace_info> trace_info,
                       auto&& apply_fn, auto&& forward_fn);
+    // Sends a mutation to a replica, batched with others when possible.
+    future<> send_mutation(gms::inet_address ep, lw_shared_ptr<const frozen_mutation> fm, inet_address_vector_replica_set&& forward,
+            response_id_type response_id, clock_type::time_point timeout, tracing::trace_state_ptr tr_state, db::per_partition_rate_limit::info rate_limit_info);
     future<rpc::no_wait_type> receive_mutation_handler (smp_service_group smp_grp, const rpc::client_info& cinfo, rpc::opt_time_point t, frozen_mutation in, inet_address_vector_replica_set forward,
             gms::inet_address reply_to, unsigned shard, storage_proxy::response_id_type response_id, rpc::optional<std::optional<tracing::trace_info>> trace_info, rpc::optional<db::per_partition_rate_limit::info> rate_limit_info_opt);
     future<rpc::no_wait_type> handle_paxos_learn(const rpc::client_info& cinfo, rpc::opt_time_point t, paxos::proposal decision,
@@ -446,6 +469,8 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
     future<rpc::no_wait_type> handle_mutation_done(const rpc::client_info& cinfo, unsigned shard, storage_proxy::response_id_type response_id, rpc::optional<db::view::update_backlog> backlog);
     future<rpc::no_wait_type> handle_mutation_failed(const rpc::client_info& cinfo, unsigned shard, storage_proxy::response_id_type response_id, size_t num_failed, rpc::optional<db::view::update_backlog> backlog, rpc::optional<replica::exception_variant> exception);
     future<rpc::tuple<foreign_ptr<lw_shared_ptr<query::result>>, cache_temperature, replica::exception_variant>> handle_read_data(const rpc::client_info& cinfo, rpc::opt_time_point t, query::read_command cmd, ::compat::wrapping_partition_range pr, rpc::optional<query::digest_algorithm> oda, rpc::optional<db::per_partition_rate_limit::info> rate_limit_info_opt);
+    future<rpc::no_wait_type> handle_mutation_batch(const rpc::client_info& cinfo, rpc::opt_time_point t, std::vector<frozen_mutation> fms, gms::inet_address reply_to, unsigned shard, std::vector<response_id_type> response_ids, std::vector<std::optional<tracing::trace_info>> trace_infos, std::vector<db::per_partition_rate_limit::info> rate_limit_infos);
+    future<rpc::tuple<std::vector<query::result>, std::vector<cache_temperature>, std::vector<replica::exception_variant>>> handle_read_data_batch(const rpc::client_info& cinfo, rpc::opt_time_point t, std::vector<query::read_command> cmds, std::vector<::compat::wrapping_partition_range> prs, std::vector<query::digest_algorithm> digest_algos, std::vector<db::per_partition_rate_limit::info> rate_limit_infos);
     future<rpc::tuple<foreign_ptr<lw_shared_ptr<reconcilable_result>>, cache_temperature, replica::exception_variant>> handle_read_mutation_data(const rpc::client_info& cinfo, rpc::opt_time_point t, query::read_command cmd, ::compat::wrapping_partition_range pr);
     future<rpc::tuple<query::result_digest, long, cache_temperature, replica::exception_variant>> handle_read_digest(const rpc::client_info& cinfo, rpc::opt_time_point t, query::read_command cmd, ::compat::wrapping_partition_range pr, rpc::optional<query::digest_algorithm> oda, rpc::optional<db::per_partition_rate_limit::info> rate_limit_info_opt);
     future<> handle_truncate(rpc::opt_time_point timeout, sstring ksname, sstring cfname);
@@ -660,6 +685,8 @@ class storage_proxy : public seastar::async_sharded_service<storage_proxy>, publ
 
     future<db::hints::sync_point> create_hint_sync_point(const std::vector<gms::inet_address> target_hosts) const;
     future<> wait_for_hint_sync_point(const db::hints::sync_point spoint, clock_type::time_point deadline);
+    // Endpoints which hints files on any shard of this node are waiting to be replayed to.
+    future<std::vector<gms::inet_address>> get_endpoints_with_pending_hints() const;
 
     const stats& get_stats() const {
         return scheduling_group_get_specific<storage_proxy_stats::stats>(_stats_key);
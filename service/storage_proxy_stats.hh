@@ -142,6 +142,7 @@ struct stats : public write_stats {
     uint64_t read_repair_attempts = 0;
     uint64_t read_repair_repaired_blocking = 0;
     uint64_t read_repair_repaired_background = 0;
+    uint64_t read_repair_coalesced_background = 0;
     uint64_t global_read_repairs_canceled_due_to_concurrent_write = 0;
 
     // number of mutations received as a coordinator
@@ -158,6 +159,8 @@ struct stats : public write_stats {
     uint64_t replica_data_reads = 0;
     uint64_t replica_digest_reads = 0;
     uint64_t replica_mutation_data_reads = 0;
+    uint64_t replica_data_read_batches = 0;
+    uint64_t replica_mutation_batches = 0;
 
     uint64_t replica_cross_shard_ops = 0;
 
@@ -174,6 +177,11 @@ struct stats : public write_stats {
     uint64_t read_retries = 0; // read is retried with new limit
     uint64_t speculative_digest_reads = 0;
     uint64_t speculative_data_reads = 0;
+    uint64_t data_read_batches = 0; // READ_DATA_BATCH messages sent
+    uint64_t batched_data_reads = 0; // data reads sent as part of a batch
+    uint64_t mutation_batches = 0; // MUTATION_BATCH messages sent
+    uint64_t batched_mutations = 0; // mutations sent as part of a batch
+    uint64_t reads_reordered_by_latency = 0; // reads whose replicas were reordered by their latencies
 
     uint64_t cas_read_unfinished_commit = 0;
     uint64_t cas_foreground = 0;
@@ -27,7 +27,8 @@
 // Each compressed chunk is followed by a 4-byte checksum of the compressed
 // data, using the Adler32 or CRC32 algorithm. In Cassandra, there is a parameter
 // "crc_check_chance" (defaulting to 1.0) which determines the probability
-// of us verifying the checksum of each chunk we read.
+// of us verifying the checksum of each chunk we read. We honour the table's
+// setting of it when reading data files.
 //
 // This implementation does not cache the compressed disk blocks (which
 // are read using O_DIRECT), nor uncompressed data. We intend to cache high-
@@ -371,11 +372,11 @@ compressor_ptr get_sstable_compressor(const compression&);
 // sstable alive, and the compression metadata is only a part of it.
 input_stream<char> make_compressed_file_k_l_format_input_stream(file f,
                 sstables::compression* cm, uint64_t offset, size_t len,
-                class file_input_stream_options options);
+                class file_input_stream_options options, double crc_check_chance = 1.0);
 
 input_stream<char> make_compressed_file_m_format_input_stream(file f,
                 sstables::compression* cm, uint64_t offset, size_t len,
-                class file_input_stream_options options);
+                class file_input_stream_options options, double crc_check_chance = 1.0);
 
 output_stream<char> make_compressed_file_m_format_output_stream(output_stream<char> out,
                 sstables::compression* cm,
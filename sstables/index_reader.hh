@@ -415,6 +415,15 @@ struct index_bound {
     index_bound& operator=(index_bound&&) noexcept = default;
 };
 
+// Keeps an index page cached for resuming an evicted read.
+struct index_page_pin : public reader_resume_state::pin {
+    shared_sstable sstable;
+    partition_index_cache::entry_ptr page;
+
+    index_page_pin(shared_sstable sst, partition_index_cache::entry_ptr p) noexcept
+        : sstable(std::move(sst)), page(std::move(p)) {}
+};
+
 // Provides access to sstable indexes.
 //
 // Maintains logical cursors to sstable elements (partitions, cells).
@@ -1083,7 +1092,23 @@ class index_reader {
 
     const shared_sstable& sstable() const { return _sstable; }
 
+    // A resumed read starts from where the evicted one stopped, so it
+    // needs the index page the lower bound is at.
+    void keep_index_page_for_resume() noexcept {
+        if (!_use_caching || !_lower_bound.current_list) {
+            return;
+        }
+        if (auto* rs = _permit.resume_state()) {
+            try {
+                rs->add(std::make_unique<index_page_pin>(_sstable, std::move(_lower_bound.current_list)));
+            } catch (...) {
+                // The page is looked up again on resume.
+            }
+        }
+    }
+
     future<> close() noexcept {
+        keep_index_page_for_resume();
         // index_bound::close must not fail
         return close(_lower_bound).then([this] {
             if (_upper_bound) {
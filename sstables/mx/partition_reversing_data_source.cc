@@ -336,7 +336,10 @@ static temporary_buffer<char> end_of_partition() {
 // partition end. In the former case, we read the following unfiltered, and
 // deduce the position of the first row of our actual range using
 // row_body_skipping_context::prev_len(). If it's the latter, we find the
-// last row by iterating over the entire last promoted index block.
+// last row by iterating over the entire last promoted index block. Unless
+// it's larger than the maximum read size, the block is read into the cached
+// read buffer at once, so that its rows, which are the first ones returned,
+// are not read again.
 //
 // After finding the last row, we produce rows in reversed order one by one,
 // parsing current row using row_body_skipping_context, and finding file
@@ -529,7 +532,16 @@ class partition_reversing_data_source_impl final : public data_source_impl {
                     _row_start = _clustering_range_start;
                 }
                 uint64_t last_row_start = _row_start;
-                co_await emplace_row_skipping_context(data_stream(_row_start, _partition_end), _row_start, _partition_end);
+                const uint64_t block_start = _row_start;
+                const bool cache_block = _partition_end - block_start <= max_read_size;
+                if (cache_block) {
+                    // The rows of the block are returned next, so read it once
+                    // and serve them from the cache instead of reading them again.
+                    _cached_read = co_await data_read(block_start, _partition_end);
+                    co_await emplace_row_skipping_context(make_buffer_input_stream(_cached_read.share()), _row_start, _partition_end);
+                } else {
+                    co_await emplace_row_skipping_context(data_stream(_row_start, _partition_end), _row_start, _partition_end);
+                }
                 co_await _row_skipping_context->consume_input();
                 while (!_row_skipping_context->end_of_partition()) {
                     last_row_start = _row_start;
@@ -538,6 +550,10 @@ class partition_reversing_data_source_impl final : public data_source_impl {
                 }
                 _row_end = _row_start;
                 _row_start = last_row_start;
+                if (cache_block) {
+                    // Drop the end of partition flag, so that the cache ends at _row_end.
+                    _cached_read.trim(_row_end - block_start);
+                }
                 if (_row_start == _row_end) {
                     // empty partition
                     _state = state::FINISHED;
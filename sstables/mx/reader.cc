@@ -1002,9 +1002,22 @@ class data_consume_rows_context_m : public data_consumer::continuous_data_consum
                     _row->_columns_selector.set();
                 }
                 while (_missing_columns_to_read > 0) {
-                    --_missing_columns_to_read;
-                    co_yield read_unsigned_vint(*_processing_data);
-                    _row->_columns_selector.flip(_u64);
+                    // Decode in bulk the indexes which are fully contained in the current buffer.
+                    std::array<uint64_t, 64> indexes;
+                    bytes_view in(reinterpret_cast<const bytes::value_type*>(_processing_data->get()), _processing_data->size());
+                    auto n = unsigned_vint::deserialize_many(in,
+                            std::span(indexes.data(), std::min<uint64_t>(_missing_columns_to_read, indexes.size())));
+                    _processing_data->trim_front(_processing_data->size() - in.size());
+                    for (size_t i = 0; i < n; ++i) {
+                        _row->_columns_selector.flip(indexes[i]);
+                    }
+                    _missing_columns_to_read -= n;
+                    if (n == 0) {
+                        // The next index spans buffers.
+                        --_missing_columns_to_read;
+                        co_yield read_unsigned_vint(*_processing_data);
+                        _row->_columns_selector.flip(_u64);
+                    }
                 }
                 skip_absent_columns();
             } else {
@@ -119,7 +119,7 @@ class partition_index_cache {
         entry_ptr& operator=(std::nullptr_t) noexcept {
             if (_ref) {
                 if (_ref.unique()) {
-                    _ref->_parent->_lru.add(*_ref);
+                    _ref->_parent->_lru.touch(*_ref);
                 }
                 _ref = nullptr;
             }
@@ -357,6 +357,14 @@ future<uint64_t> sstable_directory::reshape(compaction_manager& cm, replica::tab
                 dirlog.info("Table {}.{} with compaction strategy {} found SSTables that need reshape. Starting reshape process", table.schema()->ks_name(), table.schema()->cf_name(), table.get_compaction_strategy().name());
             }
 
+            if (desc.relevel_only) {
+                return parallel_for_each(desc.sstables, [level = desc.level] (const sstables::shared_sstable& sst) {
+                    return sst->mutate_sstable_level(level);
+                }).then([] {
+                    return make_ready_future<stop_iteration>(stop_iteration::no);
+                });
+            }
+
             std::vector<sstables::shared_sstable> sstlist;
             for (auto& sst : desc.sstables) {
                 reshaped_size += sst->data_size();
@@ -6,6 +6,7 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <cmath>
 #include <seastar/util/defer.hh>
 
 #include <boost/icl/interval_map.hpp>
@@ -222,8 +223,22 @@ partitioned_sstable_set::query(const dht::partition_range& range) const {
     }
 }
 
+// Fraction of the token ring covered by the sstable.
+static double token_range_fraction(const sstable& sst) {
+    auto first = sst.get_first_decorated_key().token().raw();
+    auto last = sst.get_last_decorated_key().token().raw();
+    return (double(last) - double(first)) / std::pow(2.0, 64);
+}
+
 bool partitioned_sstable_set::store_as_unleveled(const shared_sstable& sst) const {
-    return _use_level_metadata && sst->get_sstable_level() == 0;
+    if (!_use_level_metadata) {
+        return false;
+    }
+    // Adding a wide sstable to the interval map would copy it into the sets of
+    // all the intervals it overlaps, and split all of them at its bounds.
+    // The incremental selector would then keep returning it anyway.
+    static constexpr double max_leveled_token_range_fraction = 0.5;
+    return sst->get_sstable_level() == 0 || token_range_fraction(*sst) > max_leveled_token_range_fraction;
 }
 
 dht::ring_position partitioned_sstable_set::to_ring_position(const compatible_ring_position_or_view& crp) {
@@ -743,10 +758,11 @@ class incremental_reader_selector : public reader_selector {
 // Assumes the given `pos` and `schema` are alive during the function's lifetime.
 static std::predicate<const sstable&> auto
 make_pk_filter(const dht::ring_position& pos, const schema& schema) {
-    return [&pos, key = key::from_partition_key(schema, *pos.key()), cmp = dht::ring_position_comparator(schema)] (const sstable& sst) {
+    // Hash the key once, rather than once per checked sstable.
+    return [&pos, hk = sstable::make_hashed_key(schema, *pos.key()), cmp = dht::ring_position_comparator(schema)] (const sstable& sst) {
         return cmp(pos, sst.get_first_decorated_key()) >= 0 &&
                cmp(pos, sst.get_last_decorated_key()) <= 0 &&
-               sst.filter_has_key(key);
+               sst.filter_has_key(hk);
     };
 }
 
@@ -72,6 +72,8 @@ class partitioned_sstable_set : public sstable_set_impl {
     interval_type singular(const dht::ring_position& rp) const;
     std::pair<map_iterator, map_iterator> query(const dht::partition_range& range) const;
     // SSTables are stored separately to avoid interval map's fragmentation issue when level 0 falls behind.
+    // This is also done for sstables spanning most of the ring, whatever their level, as each of them
+    // overlaps almost every interval in the map.
     bool store_as_unleveled(const shared_sstable& sst) const;
 public:
     static dht::ring_position to_ring_position(const compatible_ring_position_or_view& crp);
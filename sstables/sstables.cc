@@ -8,6 +8,7 @@
 
 #include "log.hh"
 #include <vector>
+#include <map>
 #include <typeinfo>
 #include <limits>
 #include <seastar/core/future.hh>
@@ -81,6 +82,7 @@
 
 #include "release.hh"
 #include "utils/build_id.hh"
+#include "utils/coalescing_file.hh"
 
 thread_local disk_error_signal_type sstable_read_error;
 thread_local disk_error_signal_type sstable_write_error;
@@ -101,6 +103,16 @@ thread_local utils::updateable_value<bool> global_cache_index_pages(false);
 
 logging::logger sstlog("sstable");
 
+static thread_local coalescing_file_impl::stats data_read_coalescing_stats;
+
+// Merges concurrent nearby reads of the data file, see coalesce_sstable_data_reads.
+file sstable::maybe_coalesce_data_reads(file f) const {
+    if (!_manager.config().coalesce_sstable_data_reads()) {
+        return f;
+    }
+    return make_coalescing_file(std::move(f), {}, data_read_coalescing_stats);
+}
+
 // Because this is a noop and won't hold any state, it is better to use a global than a
 // thread_local. It will be faster, specially on non-x86.
 struct noop_write_monitor final : public write_monitor {
@@ -160,6 +172,12 @@ future<file> sstable::new_sstable_component_file(const io_error_handler& error_h
         return make_checked_file(error_handler, std::move(f));
     });
 
+    if (readonly && type == component_type::Data) {
+        f = f.then([this] (file data) {
+            return maybe_coalesce_data_reads(std::move(data));
+        });
+    }
+
     if (!readonly) {
         f = with_file_close_on_failure(std::move(f).handle_exception([name] (auto ep) {
             sstlog.error("Could not create SSTable component {}. Found exception: {}", name, ep);
@@ -1282,6 +1300,10 @@ future<> sstable::open_data() noexcept {
     }).then([this] {
         _open_mode.emplace(open_flags::ro);
         _stats.on_open_for_reading();
+        if (_components->filter) {
+            _total_reclaimable_memory = _components->filter->memory_size();
+            _manager.increment_total_reclaimable_memory_and_maybe_reclaim(this);
+        }
     });
 }
 
@@ -1358,10 +1380,9 @@ future<> sstable::drop_caches() {
     });
 }
 
-future<> sstable::read_filter(const io_priority_class& pc) {
+future<utils::filter_ptr> sstable::load_filter(const io_priority_class& pc) {
     if (!has_component(component_type::Filter)) {
-        _components->filter = std::make_unique<utils::filter::always_present_filter>();
-        return make_ready_future<>();
+        return make_ready_future<utils::filter_ptr>(std::make_unique<utils::filter::always_present_filter>());
     }
 
     return seastar::async([this, &pc] () mutable {
@@ -1372,10 +1393,32 @@ future<> sstable::read_filter(const io_priority_class& pc) {
         utils::filter_format format = (_version >= sstable_version_types::mc)
                                       ? utils::filter_format::m_format
                                       : utils::filter_format::k_l_format;
-        _components->filter = utils::filter::create_filter(filter.hashes, std::move(bs), format);
+        return utils::filter::create_filter(filter.hashes, std::move(bs), format);
+    });
+}
+
+future<> sstable::read_filter(const io_priority_class& pc) {
+    return load_filter(pc).then([this] (utils::filter_ptr filter) {
+        _components->filter = std::move(filter);
     });
 }
 
+void sstable::reclaim_memory_from_components() {
+    _components->filter = std::make_unique<utils::filter::always_present_filter>();
+    _filter_reclaimed = true;
+}
+
+future<> sstable::reload_reclaimed_components(const io_priority_class& pc) {
+    auto filter = co_await load_filter(pc);
+    // get_open_info() loaded the filter itself before sharing the components.
+    if (_components_shared || !_filter_reclaimed) {
+        co_return;
+    }
+    _total_reclaimable_memory = filter->memory_size();
+    _components->filter = std::move(filter);
+    _filter_reclaimed = false;
+}
+
 void sstable::write_filter(const io_priority_class& pc) {
     if (!has_component(component_type::Filter)) {
         return;
@@ -1395,19 +1438,20 @@ future<> sstable::load(const io_priority_class& pc) noexcept {
         // read scylla-meta after toc. Might need it to parse
         // rest (hint extensions)
         return read_scylla_metadata(pc).then([this, &pc] {
-            // Read statistics ahead of others - if summary is missing
-            // we'll attempt to re-generate it and we need statistics for that
-            return read_statistics(pc).then([this, &pc] {
-                return seastar::when_all_succeed(
-                        read_compression(pc),
-                        read_filter(pc),
-                        read_summary(pc)).then_unpack([this] {
-                            validate_min_max_metadata();
-                            validate_max_local_deletion_time();
-                            validate_partitioner();
-                            return open_data();
-                        });
-            });
+            // Read the other components concurrently, except for the summary:
+            // if it is missing we'll attempt to re-generate it and we need
+            // statistics for that
+            return seastar::when_all_succeed(
+                    read_compression(pc),
+                    read_filter(pc),
+                    read_statistics(pc).then([this, &pc] {
+                        return read_summary(pc);
+                    })).then_unpack([this] {
+                        validate_min_max_metadata();
+                        validate_max_local_deletion_time();
+                        validate_partitioner();
+                        return open_data();
+                    });
         });
     });
 }
@@ -1416,7 +1460,8 @@ future<> sstable::load(sstables::foreign_sstable_open_info info) noexcept {
     static_assert(std::is_nothrow_move_constructible_v<sstables::foreign_sstable_open_info>);
     return read_toc().then([this, info = std::move(info)] () mutable {
         _components = std::move(info.components);
-        _data_file = make_checked_file(_read_error_handler, info.data.to_file());
+        _components_shared = true;
+        _data_file = maybe_coalesce_data_reads(make_checked_file(_read_error_handler, info.data.to_file()));
         _index_file = make_checked_file(_read_error_handler, info.index.to_file());
         _shards = std::move(info.owners);
         validate_min_max_metadata();
@@ -1427,10 +1472,20 @@ future<> sstable::load(sstables::foreign_sstable_open_info info) noexcept {
 }
 
 future<foreign_sstable_open_info> sstable::get_open_info() & {
-    return _components.copy().then([this] (auto c) mutable {
-        return foreign_sstable_open_info{std::move(c), this->get_shards_for_this_sstable(), _data_file.dup(), _index_file.dup(),
-            _generation, _version, _format, data_size()};
-    });
+    _components_shared = true;
+    _manager.remove_reclaimable(this);
+    // Shared components are never changed again, so they have to be shared
+    // with the real filter, even if it was dropped or is being reloaded.
+    if (_filter_reclaimed) {
+        _filter_reclaimed = false;
+        _shared_filter_load.emplace(read_filter(default_priority_class()));
+    }
+    if (_shared_filter_load) {
+        co_await _shared_filter_load->get_future();
+    }
+    auto c = co_await _components.copy();
+    co_return foreign_sstable_open_info{std::move(c), get_shards_for_this_sstable(), _data_file.dup(), _index_file.dup(),
+        _generation, _version, _format, data_size()};
 }
 
 void prepare_summary(summary& s, uint64_t expected_partition_count, uint32_t min_index_interval) {
@@ -1899,6 +1954,10 @@ bool sstable::is_quarantined() const noexcept {
     return boost::algorithm::ends_with(_dir, quarantine_dir);
 }
 
+bool sstable::is_cold() const noexcept {
+    return boost::algorithm::ends_with(_dir, cold_dir);
+}
+
 bool sstable::is_uploaded() const noexcept {
     return boost::algorithm::ends_with(_dir, upload_dir);
 }
@@ -2144,7 +2203,7 @@ future<> sstable::move_to_quarantine(bool do_sync_dirs) {
     sstring basename = path.filename().native();
     if (basename == quarantine_dir) {
         co_return;
-    } else if (basename == staging_dir) {
+    } else if (basename == staging_dir || basename == cold_dir) {
         path = path.parent_path();
     }
     // Note: moving a sstable in a snapshot or in the uploads dir to quarantine
@@ -2166,6 +2225,7 @@ sstable::make_reader(
         streamed_mutation::forwarding fwd,
         mutation_reader::forwarding fwd_mr,
         read_monitor& mon) {
+    permit.on_sstable_read();
     const auto reversed = slice.is_reversed();
     if (_version >= version_types::mc && (!reversed || range.is_singular())) {
         return mx::make_reader(shared_from_this(), std::move(schema), std::move(permit), range, slice, pc, std::move(trace_state), fwd, fwd_mr, mon);
@@ -2220,8 +2280,8 @@ static entry_descriptor make_entry_descriptor(sstring sstdir, sstring fname, sst
     static std::regex la_mx("(la|m[cde])-(\\d+)-(\\w+)-(.*)");
     static std::regex ka("(\\w+)-(\\w+)-ka-(\\d+)-(.*)");
 
-    static std::regex dir(format(".*/([^/]*)/([^/]+)-[\\da-fA-F]+(?:/({}|{}|{}|{})(?:/[^/]+)?)?/?",
-            sstables::staging_dir, sstables::quarantine_dir, sstables::upload_dir, sstables::snapshots_dir).c_str());
+    static std::regex dir(format(".*/([^/]*)/([^/]+)-[\\da-fA-F]+(?:/({}|{}|{}|{}|{})(?:/[^/]+)?)?/?",
+            sstables::staging_dir, sstables::quarantine_dir, sstables::upload_dir, sstables::snapshots_dir, sstables::cold_dir).c_str());
 
     std::smatch match;
 
@@ -2320,10 +2380,10 @@ input_stream<char> sstable::data_stream(uint64_t pos, size_t len, const io_prior
     if (_components->compression && raw == raw_stream::no) {
         if (_version >= sstable_version_types::mc) {
              return make_compressed_file_m_format_input_stream(f, &_components->compression,
-                pos, len, std::move(options));
+                pos, len, std::move(options), _schema->crc_check_chance());
         } else {
             return make_compressed_file_k_l_format_input_stream(f, &_components->compression,
-                pos, len, std::move(options));
+                pos, len, std::move(options), _schema->crc_check_chance());
         }
     }
 
@@ -2614,6 +2674,32 @@ future<> sstable::mutate_sstable_level(uint32_t new_level) {
     });
 }
 
+future<> sstable::mutate_repaired_at(uint64_t repaired_at) {
+    if (!has_component(component_type::Statistics)) {
+        return make_ready_future<>();
+    }
+
+    auto entry = _components->statistics.contents.find(metadata_type::Stats);
+    if (entry == _components->statistics.contents.end()) {
+        return make_ready_future<>();
+    }
+
+    auto& p = entry->second;
+    if (!p) {
+        return make_exception_future<>(std::runtime_error("Statistics is malformed"));
+    }
+    stats_metadata& s = *static_cast<stats_metadata *>(p.get());
+    if (s.repaired_at == repaired_at) {
+        return make_ready_future<>();
+    }
+
+    sstlog.debug("set repaired_at of {} from {} to {}", get_filename(), s.repaired_at, repaired_at);
+    s.repaired_at = repaired_at;
+    return seastar::async([this] {
+        rewrite_statistics(default_priority_class());
+    });
+}
+
 int sstable::compare_by_max_timestamp(const sstable& other) const {
     auto ts1 = get_stats_metadata().max_timestamp;
     auto ts2 = other.get_stats_metadata().max_timestamp;
@@ -2973,68 +3059,73 @@ delete_atomically(std::vector<shared_sstable> ssts) {
         return make_ready_future<>();
     }
     return seastar::async([ssts = std::move(ssts)] {
-        sstring sstdir;
+        // All sstables are assumed to be in the same column_family, but they
+        // may be in different subdirectories of its directory, e.g. when
+        // compacting sstables of the cold directory with hot ones.
+        std::map<sstring, std::vector<shared_sstable>> ssts_by_dir;
         min_max_tracker<generation_type> gen_tracker;
 
         for (const auto& sst : ssts) {
             gen_tracker.update(sst->generation());
+            ssts_by_dir[sst->get_dir()].push_back(sst);
+        }
+
+        // A pending_delete log is written to every directory before any sstable
+        // is removed, so that the removal of all of them is completed on restart.
+        // Each log is replayed when its directory is populated.
+        std::vector<sstring> pending_delete_logs;
+        for (const auto& [sstdir, dir_ssts] : ssts_by_dir) {
+            sstring pending_delete_dir = sstdir + "/" + sstable::pending_delete_dir_basename();
+            sstring pending_delete_log = format("{}/sstables-{}-{}.log", pending_delete_dir, gen_tracker.min(), gen_tracker.max());
+            sstring tmp_pending_delete_log = pending_delete_log + ".tmp";
+            sstlog.trace("Writing {}", tmp_pending_delete_log);
+            try {
+                touch_directory(pending_delete_dir).get();
+                auto oflags = open_flags::wo | open_flags::create | open_flags::exclusive;
+                // Create temporary pending_delete log file.
+                auto f = open_file_dma(tmp_pending_delete_log, oflags).get0();
+                // Write all toc names into the log file.
+                file_output_stream_options options;
+                options.buffer_size = 4096;
+                auto w = file_writer::make(std::move(f), options, tmp_pending_delete_log).get0();
+
+                for (const auto& sst : dir_ssts) {
+                    auto toc = sst->component_basename(component_type::TOC);
+                    w.write(toc.c_str(), toc.size());
+                    w.write("\n", 1);
+                }
 
-            if (sstdir.empty()) {
-                sstdir = sst->get_dir();
-            } else {
-                // All sstables are assumed to be in the same column_family, hence
-                // sharing their base directory.
-                assert (sstdir == sst->get_dir());
-            }
-        }
-
-        sstring pending_delete_dir = sstdir + "/" + sstable::pending_delete_dir_basename();
-        sstring pending_delete_log = format("{}/sstables-{}-{}.log", pending_delete_dir, gen_tracker.min(), gen_tracker.max());
-        sstring tmp_pending_delete_log = pending_delete_log + ".tmp";
-        sstlog.trace("Writing {}", tmp_pending_delete_log);
-        try {
-            touch_directory(pending_delete_dir).get();
-            auto oflags = open_flags::wo | open_flags::create | open_flags::exclusive;
-            // Create temporary pending_delete log file.
-            auto f = open_file_dma(tmp_pending_delete_log, oflags).get0();
-            // Write all toc names into the log file.
-            file_output_stream_options options;
-            options.buffer_size = 4096;
-            auto w = file_writer::make(std::move(f), options, tmp_pending_delete_log).get0();
-
-            for (const auto& sst : ssts) {
-                auto toc = sst->component_basename(component_type::TOC);
-                w.write(toc.c_str(), toc.size());
-                w.write("\n", 1);
-            }
-
-            w.flush();
-            w.close();
+                w.flush();
+                w.close();
 
-            auto dir_f = open_directory(pending_delete_dir).get0();
-            // Once flushed and closed, the temporary log file can be renamed.
-            rename_file(tmp_pending_delete_log, pending_delete_log).get();
+                auto dir_f = open_directory(pending_delete_dir).get0();
+                // Once flushed and closed, the temporary log file can be renamed.
+                rename_file(tmp_pending_delete_log, pending_delete_log).get();
 
-            // Guarantee that the changes above reached the disk.
-            dir_f.flush().get();
-            dir_f.close().get();
-            sstlog.debug("{} written successfully.", pending_delete_log);
-        } catch (...) {
-            sstlog.warn("Error while writing {}: {}. Ignoring.", pending_delete_log, std::current_exception());
+                // Guarantee that the changes above reached the disk.
+                dir_f.flush().get();
+                dir_f.close().get();
+                sstlog.debug("{} written successfully.", pending_delete_log);
+                pending_delete_logs.push_back(std::move(pending_delete_log));
+            } catch (...) {
+                sstlog.warn("Error while writing {}: {}. Ignoring.", pending_delete_log, std::current_exception());
+            }
         }
 
         parallel_for_each(ssts, [] (shared_sstable sst) {
             return sst->unlink();
         }).get();
 
-        // Once all sstables are deleted, the log file can be removed.
-        // Note: the log file will be removed also if unlink failed to remove
+        // Once all sstables are deleted, the log files can be removed.
+        // Note: the log files will be removed also if unlink failed to remove
         // any sstable and ignored the error.
-        try {
-            remove_file(pending_delete_log).get();
-            sstlog.debug("{} removed.", pending_delete_log);
-        } catch (...) {
-            sstlog.warn("Error removing {}: {}. Ignoring.", pending_delete_log, std::current_exception());
+        for (const auto& pending_delete_log : pending_delete_logs) {
+            try {
+                remove_file(pending_delete_log).get();
+                sstlog.debug("{} removed.", pending_delete_log);
+            } catch (...) {
+                sstlog.warn("Error removing {}: {}. Ignoring.", pending_delete_log, std::current_exception());
+            }
         }
     });
 }
@@ -3095,6 +3186,8 @@ future<> init_metrics() {
             sm::description("Index page cache requests which were served from cache")),
         sm::make_counter("index_page_cache_misses", [] { return index_page_cache_metrics.page_misses; },
             sm::description("Index page cache requests which had to perform I/O")),
+        sm::make_counter("index_page_cache_concurrent_misses", [] { return index_page_cache_metrics.page_concurrent_misses; },
+            sm::description("Index page cache misses which waited for a read of the same page already in progress, instead of performing I/O")),
         sm::make_counter("index_page_cache_evictions", [] { return index_page_cache_metrics.page_evictions; },
             sm::description("Total number of index page cache pages which have been evicted")),
         sm::make_counter("index_page_cache_populations", [] { return index_page_cache_metrics.page_populations; },
@@ -3181,6 +3274,12 @@ future<> init_metrics() {
 
         sm::make_gauge("bloom_filter_memory_size", [] { return utils::filter::bloom_filter::get_shard_stats().memory_size; },
             sm::description("Bloom filter memory usage in bytes.")),
+
+        sm::make_counter("coalesced_data_read_requests", [] { return data_read_coalescing_stats.requests; },
+            sm::description("Counts the bulk reads of data files which were queued to be merged with concurrent nearby reads.")),
+
+        sm::make_counter("coalesced_data_reads", [] { return data_read_coalescing_stats.reads; },
+            sm::description("Counts the reads of data files issued for the merged bulk reads.")),
     });
   });
 }
@@ -18,6 +18,7 @@
 #include <seastar/core/enum.hh>
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/distributed.hh>
+#include <seastar/core/shared_future.hh>
 #include <unordered_set>
 #include <unordered_map>
 #include <variant>
@@ -110,6 +111,8 @@ struct sstable_writer_config {
     mutation_fragment_stream_validation_level validation_level;
     std::optional<db::replay_position> replay_position;
     std::optional<int> sstable_level;
+    // Time at which the data written was repaired, 0 if it wasn't.
+    uint64_t repaired_at = 0;
     write_monitor* monitor = &default_write_monitor();
     utils::UUID run_identifier = utils::make_random_uuid();
     size_t summary_byte_cost;
@@ -125,6 +128,7 @@ constexpr const char* upload_dir = "upload";
 constexpr const char* snapshots_dir = "snapshots";
 constexpr const char* quarantine_dir = "quarantine";
 constexpr const char* pending_delete_dir = "pending_delete";
+constexpr const char* cold_dir = "cold";
 
 constexpr auto table_subdirectories = std::to_array({
     staging_dir,
@@ -132,6 +136,7 @@ constexpr auto table_subdirectories = std::to_array({
     snapshots_dir,
     quarantine_dir,
     pending_delete_dir,
+    cold_dir,
 });
 
 constexpr const char* repair_origin = "repair";
@@ -406,6 +411,10 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     bool is_quarantined() const noexcept;
 
+    // Returns true if the sstable is in the cold_dir of its table, which holds old data
+    // moved there by the compaction strategy, possibly on slower storage.
+    bool is_cold() const noexcept;
+
     bool is_uploaded() const noexcept;
 
     std::vector<std::pair<component_type, sstring>> all_components() const;
@@ -489,6 +498,15 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     std::vector<sstring> _unrecognized_components;
 
     foreign_ptr<lw_shared_ptr<shareable_components>> _components = make_foreign(make_lw_shared<shareable_components>());
+    // Memory used by the components which sstables_manager may drop and
+    // have loaded again later, which is only the filter.
+    size_t _total_reclaimable_memory = 0;
+    // Set once other shards may read the components: they are left alone then.
+    bool _components_shared = false;
+    // Set while the filter is replaced by an always-present one, until it is loaded again.
+    bool _filter_reclaimed = false;
+    // Loading of a reclaimed filter by get_open_info(), which concurrent calls wait for.
+    std::optional<shared_future<>> _shared_filter_load;
     column_translation _column_translation;
     std::optional<open_flags> _open_mode;
     // _compaction_ancestors track which sstable generations were used to generate this sstable.
@@ -571,6 +589,8 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     future<> rename_new_sstable_component_file(sstring from_file, sstring to_file);
     future<file> new_sstable_component_file(const io_error_handler& error_handler, component_type f, open_flags flags, file_open_options options = {}) noexcept;
 
+    file maybe_coalesce_data_reads(file f) const;
+
     future<file_writer> make_component_file_writer(component_type c, file_output_stream_options options,
             open_flags oflags = open_flags::wo | open_flags::create | open_flags::exclusive) noexcept;
 
@@ -588,7 +608,11 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     void write_scylla_metadata(const io_priority_class& pc, shard_id shard, sstable_enabled_features features, run_identifier identifier,
             std::optional<scylla_metadata::large_data_stats> ld_stats, sstring origin);
 
+    future<utils::filter_ptr> load_filter(const io_priority_class& pc);
     future<> read_filter(const io_priority_class& pc);
+    // Drops the filter, letting all keys through until it is reloaded.
+    void reclaim_memory_from_components();
+    future<> reload_reclaimed_components(const io_priority_class& pc);
 
     void write_filter(const io_priority_class& pc);
 
@@ -814,6 +838,19 @@ class sstable : public enable_lw_shared_from_this<sstable> {
     // This will change sstable level only in memory.
     void set_sstable_level(uint32_t);
 
+    // The time, in milliseconds since the epoch, of the repair which covered
+    // all data of the sstable, or 0 if no repair did.
+    // Only metadata for now: repair doesn't mark the sstables it covered,
+    // and nothing but compaction, which carries the mark over, reads it.
+    // Sstables are marked only by scylla-sstable's set-repaired-at.
+    uint64_t get_repaired_at() const {
+        return get_stats_metadata().repaired_at;
+    }
+
+    bool is_repaired() const {
+        return get_repaired_at() != 0;
+    }
+
     void generate_new_run_identifier() {
         _run_identifier = utils::make_random_uuid();
     }
@@ -826,6 +863,10 @@ class sstable : public enable_lw_shared_from_this<sstable> {
 
     future<> mutate_sstable_level(uint32_t);
 
+    // Marks the sstable repaired at the given time, or unrepaired if 0,
+    // rewriting its statistics component.
+    future<> mutate_repaired_at(uint64_t);
+
     const summary& get_summary() const {
         return _components->summary;
     }
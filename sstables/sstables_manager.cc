@@ -6,6 +6,9 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/memory.hh>
+
 #include "log.hh"
 #include "sstables/sstables_manager.hh"
 #include "sstables/partition_index_cache.hh"
@@ -20,7 +23,11 @@ logging::logger smlogger("sstables_manager");
 
 sstables_manager::sstables_manager(
     db::large_data_handler& large_data_handler, const db::config& dbcfg, gms::feature_service& feat, cache_tracker& ct)
-    : _large_data_handler(large_data_handler), _db_config(dbcfg), _features(feat), _cache_tracker(ct) {
+    : _large_data_handler(large_data_handler), _db_config(dbcfg), _features(feat), _cache_tracker(ct)
+    , _components_memory_reclaim_threshold_observer(dbcfg.components_memory_reclaim_threshold.observe([this] (const double&) {
+        _components_reloader_cv.signal();
+    })) {
+    _components_reloader = components_reloader_fiber();
 }
 
 sstables_manager::~sstables_manager() {
@@ -66,7 +73,65 @@ void sstables_manager::add(sstable* sst) {
     _active.push_back(*sst);
 }
 
+size_t sstables_manager::get_memory_available_for_reclaimable_components() const {
+    return _db_config.components_memory_reclaim_threshold() * memory::stats().total_memory();
+}
+
+void sstables_manager::increment_total_reclaimable_memory_and_maybe_reclaim(sstable* sst) {
+    if (sst->_components_shared || !sst->_total_reclaimable_memory
+            || !_reclaimable.emplace(sst->_total_reclaimable_memory, sst).second) {
+        return;
+    }
+    _total_reclaimable_memory += sst->_total_reclaimable_memory;
+
+    auto limit = get_memory_available_for_reclaimable_components();
+    while (_total_reclaimable_memory > limit) {
+        auto it = std::prev(_reclaimable.end());
+        auto [size, victim] = *it;
+        _reclaimable.erase(it);
+        _total_reclaimable_memory -= size;
+        victim->reclaim_memory_from_components();
+        _reclaimed.emplace(size, victim);
+        smlogger.debug("Reclaimed {} bytes of memory from the filter of {}", size, victim->get_filename());
+    }
+}
+
+void sstables_manager::remove_reclaimable(sstable* sst) {
+    auto key = std::pair(sst->_total_reclaimable_memory, sst);
+    if (_reclaimable.erase(key)) {
+        _total_reclaimable_memory -= key.first;
+        _components_reloader_cv.signal();
+    } else {
+        _reclaimed.erase(key);
+    }
+}
+
+future<> sstables_manager::components_reloader_fiber() {
+    auto can_reload = [this] {
+        return !_reclaimed.empty()
+                && _total_reclaimable_memory + _reclaimed.begin()->first <= get_memory_available_for_reclaimable_components();
+    };
+    while (true) {
+        co_await _components_reloader_cv.wait([this, &can_reload] { return _closing || can_reload(); });
+        if (_closing) {
+            co_return;
+        }
+        auto [size, sst] = *_reclaimed.begin();
+        _reclaimed.erase(_reclaimed.begin());
+        // Keeps sst active, and so out of remove_reclaimable(), while its filter is reloaded.
+        auto ptr = sst->shared_from_this();
+        try {
+            co_await sst->reload_reclaimed_components(default_priority_class());
+            smlogger.debug("Reloaded the filter of {}", sst->get_filename());
+            increment_total_reclaimable_memory_and_maybe_reclaim(sst);
+        } catch (...) {
+            smlogger.warn("Failed to reload the filter of {}, leaving it out: {}", sst->get_filename(), std::current_exception());
+        }
+    }
+}
+
 void sstables_manager::deactivate(sstable* sst) {
+    remove_reclaimable(sst);
     // At this point, sst has a reference count of zero, since we got here from
     // lw_shared_ptr_deleter<sstables::sstable>::dispose().
     _active.erase(_active.iterator_to(*sst));
@@ -94,7 +159,9 @@ void sstables_manager::maybe_done() {
 future<> sstables_manager::close() {
     _closing = true;
     maybe_done();
-    return _done.get_future();
+    _components_reloader_cv.signal();
+    co_await std::move(_components_reloader);
+    co_await _done.get_future();
 }
 
 }   // namespace sstables
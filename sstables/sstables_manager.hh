@@ -11,6 +11,7 @@
 
 #include <seastar/core/shared_ptr.hh>
 #include <seastar/core/sharded.hh>
+#include <seastar/core/condition-variable.hh>
 
 #include "utils/disk-error-handler.hh"
 #include "gc_clock.hh"
@@ -21,6 +22,7 @@
 #include "sstables/version.hh"
 #include "sstables/component_type.hh"
 #include "db/cache_tracker.hh"
+#include "utils/observable.hh"
 
 #include <boost/intrusive/list.hpp>
 
@@ -65,6 +67,18 @@ class sstables_manager {
     bool _closing = false;
     promise<> _done;
     cache_tracker& _cache_tracker;
+
+    // Memory used by the filters of the open sstables of this shard. Once it
+    // is over components_memory_reclaim_threshold of the shard's memory, the
+    // largest filters are dropped until it is below again, and the sstables
+    // let all keys through meanwhile. Dropped filters are reloaded in the
+    // background, smallest first, once there is room for them.
+    size_t _total_reclaimable_memory = 0;
+    std::set<std::pair<size_t, sstable*>> _reclaimable;
+    std::set<std::pair<size_t, sstable*>> _reclaimed;
+    condition_variable _components_reloader_cv;
+    future<> _components_reloader = make_ready_future<>();
+    utils::observer<double> _components_memory_reclaim_threshold_observer;
 public:
     explicit sstables_manager(db::large_data_handler& large_data_handler, const db::config& dbcfg, gms::feature_service& feat, cache_tracker&);
     virtual ~sstables_manager();
@@ -97,8 +111,16 @@ class sstables_manager {
     // Note that close() will not complete until all references to all
     // sstables have been destroyed.
     future<> close();
+
+    size_t get_total_reclaimable_memory() const noexcept { return _total_reclaimable_memory; }
+    size_t get_reclaimed_sstables_count() const noexcept { return _reclaimed.size(); }
 private:
     void add(sstable* sst);
+    size_t get_memory_available_for_reclaimable_components() const;
+    // Accounts for the memory of sst's filter, dropping the largest filters if over the limit.
+    void increment_total_reclaimable_memory_and_maybe_reclaim(sstable* sst);
+    void remove_reclaimable(sstable* sst);
+    future<> components_reloader_fiber();
     // Transition the sstable to the "inactive" state. It has no
     // visible references at this point, and only waits for its
     // files to be deleted (if necessary) and closed.
@@ -126,6 +126,15 @@ future<> sstables_loader::load_and_stream(sstring ks_name, sstring cf_name,
 
     size_t nr_sst_total = sstables.size();
     size_t nr_sst_current = 0;
+    _progress = progress{.sstables_total = nr_sst_total, .start_time = std::chrono::steady_clock::now()};
+
+    // Sstables are taken from the back in batches. Sort them by their first
+    // token, so that a batch covers a narrow part of the ring, which has fewer
+    // replica sets and lets the partitioned set read non-overlapping sstables
+    // of the batch one after the other, instead of merging all of them.
+    std::sort(sstables.begin(), sstables.end(), [s] (const sstables::shared_sstable& a, const sstables::shared_sstable& b) {
+        return a->get_first_decorated_key().tri_compare(*s, b->get_first_decorated_key()) > 0;
+    });
     while (!sstables.empty()) {
         auto ops_uuid = utils::make_random_uuid();
         auto sst_set = make_lw_shared<sstables::sstable_set>(sstables::make_partitioned_sstable_set(s, false));
@@ -161,6 +170,7 @@ future<> sstables_loader::load_and_stream(sstring ks_name, sstring cf_name,
                 bool is_partition_start = mf->is_partition_start();
                 if (is_partition_start) {
                     ++num_partitions_processed;
+                    ++_progress.partitions_processed;
                     auto& start = mf->as_partition_start();
                     const auto& current_dk = start.key();
 
@@ -182,6 +192,7 @@ future<> sstables_loader::load_and_stream(sstring ks_name, sstring cf_name,
                 }
                 frozen_mutation_fragment fmf = freeze(*s, *mf);
                 num_bytes_read += fmf.representation().size();
+                _progress.bytes_processed += fmf.representation().size();
                 co_await coroutine::parallel_for_each(current_targets, [&metas, &fmf, is_partition_start] (const gms::inet_address& node) {
                     return metas.at(node).send(fmf, is_partition_start);
                 });
@@ -231,6 +242,7 @@ future<> sstables_loader::load_and_stream(sstring ks_name, sstring cf_name,
         if (failed) {
             std::rethrow_exception(eptr);
         }
+        _progress.sstables_processed += sst_processed.size();
     }
     co_return;
 }
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <seastar/core/sharded.hh>
 #include "utils/UUID.hh"
 #include "sstables/shared_sstable.hh"
@@ -31,6 +32,17 @@ class view_update_generator;
 // Gets sstables from the upload directory and makes them available in the
 // system. Built on top of the distributed_loader functionality.
 class sstables_loader : public seastar::peering_sharded_service<sstables_loader> {
+public:
+    // Progress of the current or last load and stream on this shard.
+    struct progress {
+        uint64_t sstables_total = 0;
+        uint64_t sstables_processed = 0;
+        uint64_t partitions_processed = 0;
+        uint64_t bytes_processed = 0;
+        std::chrono::steady_clock::time_point start_time;
+    };
+
+private:
     sharded<replica::database>& _db;
     sharded<db::system_distributed_keyspace>& _sys_dist_ks;
     sharded<db::view::view_update_generator>& _view_update_generator;
@@ -44,6 +56,8 @@ class sstables_loader : public seastar::peering_sharded_service<sstables_loader>
     // ever arise.
     bool _loading_new_sstables = false;
 
+    progress _progress;
+
     future<> load_and_stream(sstring ks_name, sstring cf_name,
             utils::UUID table_id, std::vector<sstables::shared_sstable> sstables,
             bool primary_replica_only);
@@ -74,4 +88,8 @@ class sstables_loader : public seastar::peering_sharded_service<sstables_loader>
      */
     future<> load_new_sstables(sstring ks_name, sstring cf_name,
             bool load_and_stream, bool primary_replica_only);
+
+    const progress& get_progress() const {
+        return _progress;
+    }
 };
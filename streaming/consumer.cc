@@ -37,7 +37,7 @@ std::function<future<> (flat_mutation_reader_v2)> make_streaming_consumer(sstrin
             auto make_interposer_consumer = [&cs, offstrategy] (const mutation_source_metadata& ms_meta, reader_consumer_v2 end_consumer) mutable {
                 // postpone data segregation to off-strategy compaction if enabled
                 if (offstrategy) {
-                    return end_consumer;
+                    return cs.make_offstrategy_interposer_consumer(std::move(end_consumer));
                 }
                 return cs.make_interposer_consumer(ms_meta, std::move(end_consumer));
             };
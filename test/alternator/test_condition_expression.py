@@ -1735,12 +1735,12 @@ def test_update_condition_unused_entries_short_circuit(test_table_s):
     assert test_table_s.get_item(Key={'p': p}, ConsistentRead=True)['Item'] == {'p': p, 'a': 3}
 
 # Test a bunch of cases with permissive write isolation levels,
-# i.e. LWT_ALWAYS, LWT_RMW_ONLY and UNSAFE_RMW.
+# i.e. LWT_ALWAYS, LWT_RMW_ONLY, UNSAFE_RMW and LOCAL_LOCK.
 # These test cases make sense only for alternator, so they're skipped
 # when run on AWS
 def test_condition_expression_with_permissive_write_isolation(scylla_only, dynamodb, test_table_s):
     try:
-        for isolation in ['a', 'o', 'u']:
+        for isolation in ['a', 'o', 'u', 'l']:
             set_write_isolation(test_table_s, isolation)
             for test_case in [test_update_condition_eq_success,
                               test_update_condition_attribute_exists,
@@ -445,3 +445,44 @@ def test_scan_paging_missing_limit(dynamodb):
         # we don't know how big n should be (hopefully around 100)
         # but definitely not N.
         assert n < N
+
+# Scylla can read sub-ranges of a Scan in parallel, when the table's
+# system:scan_parallelism tag is set. Test that paging through such a scan,
+# alone or within a segment, returns every item exactly once, and that no
+# page is longer than the Limit.
+def test_scan_server_side_parallel(dynamodb, scylla_only):
+    with new_test_table(dynamodb,
+        Tags=[{'Key': 'system:scan_parallelism', 'Value': '4'}],
+        KeySchema=[{ 'AttributeName': 'p', 'KeyType': 'HASH' },
+                   { 'AttributeName': 'c', 'KeyType': 'RANGE' }],
+        AttributeDefinitions=[ { 'AttributeName': 'p', 'AttributeType': 'S' },
+                               { 'AttributeName': 'c', 'AttributeType': 'N' }]
+        ) as table:
+        items = [{'p': str(i), 'c': j, 'v': random_string()} for i in range(20) for j in range(3)]
+        with table.batch_writer() as batch:
+            for item in items:
+                batch.put_item(item)
+        assert multiset(items) == multiset(full_scan(table))
+        for limit in [1, 3, 7, 100]:
+            got_items = []
+            response = table.scan(ConsistentRead=True, Limit=limit)
+            while True:
+                assert len(response['Items']) <= limit
+                got_items.extend(response['Items'])
+                if 'LastEvaluatedKey' not in response:
+                    break
+                response = table.scan(ConsistentRead=True, Limit=limit, ExclusiveStartKey=response['LastEvaluatedKey'])
+            assert multiset(items) == multiset(got_items)
+        got_items = []
+        for segment in range(3):
+            got_items.extend(full_scan(table, Limit=5, TotalSegments=3, Segment=segment))
+        assert multiset(items) == multiset(got_items)
+
+def test_scan_server_side_parallel_incorrect_tag(dynamodb, scylla_only):
+    for value in ['1', '1000']:
+        with pytest.raises(ClientError, match='ValidationException.*scan parallelism'):
+            with new_test_table(dynamodb,
+                Tags=[{'Key': 'system:scan_parallelism', 'Value': value}],
+                KeySchema=[{ 'AttributeName': 'p', 'KeyType': 'HASH' }],
+                AttributeDefinitions=[{ 'AttributeName': 'p', 'AttributeType': 'S' }]) as table:
+                pass
@@ -272,3 +272,48 @@ SEASTAR_TEST_CASE(test_minmax_on_set) {
         }
     });
 }
+
+// Aggregates are passed the inputs of many rows at once, check that
+// results don't depend on how rows are split into batches.
+SEASTAR_TEST_CASE(test_aggregates_over_many_rows) {
+    return do_with_cql_env_thread([&] (auto& e) {
+        e.execute_cql("CREATE TABLE test (p int, c int, i int, l bigint, d double, tm timestamp, PRIMARY KEY (p, c))").get();
+        const int rows = 1000;
+        int64_t sum = 0;
+        int64_t count = 0;
+        int min_value = std::numeric_limits<int>::max();
+        int max_value = std::numeric_limits<int>::min();
+        for (int c = 0; c < rows; c++) {
+            if (c % 7 == 3) {
+                e.execute_cql(format("INSERT INTO test (p, c) VALUES (0, {})", c)).get();
+                continue;
+            }
+            const int v = (c * 37) % 1001 - 500;
+            sum += v;
+            ++count;
+            min_value = std::min(min_value, v);
+            max_value = std::max(max_value, v);
+            e.execute_cql(format("INSERT INTO test (p, c, i, l, d, tm) VALUES (0, {}, {}, {}, {}, {})", c, v, int64_t(v) << 32, v * 0.5, v + 1000)).get();
+        }
+
+        auto msg = e.execute_cql("SELECT count(*), count(i), sum(i), avg(i), min(i), max(i), sum(l), min(l), max(d), min(tm), max(tm) FROM test").get0();
+        assert_that(msg).is_rows().with_size(1).with_row({
+                {long_type->decompose(int64_t(rows))},
+                {long_type->decompose(count)},
+                {int32_type->decompose(int32_t(sum))},
+                {int32_type->decompose(int32_t(sum / count))},
+                {int32_type->decompose(int32_t(min_value))},
+                {int32_type->decompose(int32_t(max_value))},
+                {long_type->decompose(sum << 32)},
+                {long_type->decompose(int64_t(min_value) << 32)},
+                {double_type->decompose(max_value * 0.5)},
+                {timestamp_type->decompose(db_clock::from_time_t({ 0 }) + std::chrono::milliseconds(min_value + 1000))},
+                {timestamp_type->decompose(db_clock::from_time_t({ 0 }) + std::chrono::milliseconds(max_value + 1000))}});
+
+        e.execute_cql("CREATE TABLE overflow (p int, c int, i int, PRIMARY KEY (p, c))").get();
+        for (int c = 0; c < 300; c++) {
+            e.execute_cql(format("INSERT INTO overflow (p, c, i) VALUES (0, {}, {})", c, std::numeric_limits<int32_t>::max())).get();
+        }
+        BOOST_REQUIRE_THROW(e.execute_cql("SELECT sum(i) FROM overflow").get(), exceptions::overflow_error_exception);
+    });
+}
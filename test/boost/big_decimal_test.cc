@@ -203,3 +203,31 @@ BOOST_AUTO_TEST_CASE(test_big_decimal_sub) {
     test_sub("9999999999999999999999999999999999999", "-1.000e0", "10000000000000000000000000000000000000.000");
     test_sub("+10.", "1.e+1", "0");
 }
+
+BOOST_AUTO_TEST_CASE(test_big_decimal_rescale) {
+    // Scale differences that do and don't fit a power of ten in 64 bits.
+    test_add("1", "1e-19", "1.0000000000000000001");
+    test_add("1e-20", "-1", "-0.99999999999999999999");
+    test_sub("1e-30", "1e5", "-99999.999999999999999999999999999999");
+    test_assignadd("1e-25", "1e25", "10000000000000000000000000.0000000000000000000000001");
+    test_assignsub("123e10", "-1e-10", "1230000000000.0000000001");
+}
+
+BOOST_AUTO_TEST_CASE(test_big_decimal_compare) {
+    auto check = [] (const char* x, const char* y, std::strong_ordering expected) {
+        BOOST_REQUIRE(big_decimal(x).compare(big_decimal(y)) == expected);
+        BOOST_REQUIRE(big_decimal(y).compare(big_decimal(x)) == 0 <=> expected);
+    };
+    check("1", "1", std::strong_ordering::equal);
+    check("1", "1.000", std::strong_ordering::equal);
+    check("1e3", "1000.0", std::strong_ordering::equal);
+    check("0", "0.00", std::strong_ordering::equal);
+    check("1", "2", std::strong_ordering::less);
+    check("1.5", "2", std::strong_ordering::less);
+    check("-1", "0.001", std::strong_ordering::less);
+    check("-2", "-1.5", std::strong_ordering::less);
+    check("0", "1e-40", std::strong_ordering::less);
+    check("-1e-40", "0", std::strong_ordering::less);
+    check("1.0000000000000000000000000001", "1.00000000000000000000000000011", std::strong_ordering::less);
+    check("12345678901234567890e-30", "1e-10", std::strong_ordering::less);
+}
@@ -142,6 +142,8 @@ SEASTAR_THREAD_TEST_CASE(test_concurrent_population) {
     BOOST_REQUIRE_EQUAL(0, metrics.page_evictions);
     BOOST_REQUIRE_EQUAL(0, metrics.page_hits);
     BOOST_REQUIRE_EQUAL(1, metrics.page_populations);
+    // The second read waited for the first one instead of reading the page again.
+    BOOST_REQUIRE_EQUAL(1, metrics.page_concurrent_misses);
 }
 
 SEASTAR_THREAD_TEST_CASE(test_reading_from_small_file) {
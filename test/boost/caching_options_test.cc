@@ -35,3 +35,42 @@ BOOST_AUTO_TEST_CASE(test_caching_options) {
         BOOST_REQUIRE_THROW(caching_options::from_sstring(in_str), std::exception);
     }
 }
+
+BOOST_AUTO_TEST_CASE(test_caching_options_memory_bounds) {
+    using string_map = std::map<sstring, sstring>;
+    {
+        string_map in_map = { {"keys", "ALL"}, {"rows_per_partition", "ALL"}, {"max_memory_in_mb", "64"}, {"reserved_memory_in_mb", "16"}};
+        caching_options co = caching_options::from_map(in_map);
+        BOOST_REQUIRE(co.has_memory_bounds());
+        BOOST_REQUIRE_EQUAL(co.max_memory(), 64u << 20);
+        BOOST_REQUIRE_EQUAL(co.reserved_memory(), 16u << 20);
+        BOOST_REQUIRE(in_map == co.to_map());
+        BOOST_REQUIRE(co == caching_options::from_sstring(co.to_sstring()));
+        BOOST_REQUIRE(co != caching_options::from_map({ {"keys", "ALL"}, {"rows_per_partition", "ALL"}}));
+    }
+    {
+        caching_options co = caching_options::from_map({ {"keys", "ALL"}});
+        BOOST_REQUIRE(!co.has_memory_bounds());
+        BOOST_REQUIRE_EQUAL(co.to_map().count("max_memory_in_mb"), 0u);
+    }
+    BOOST_REQUIRE_THROW(caching_options::from_map({ {"max_memory_in_mb", "lots"}}), std::exception);
+    BOOST_REQUIRE_THROW(caching_options::from_map({ {"max_memory_in_mb", "16"}, {"reserved_memory_in_mb", "64"}}), std::exception);
+}
+
+BOOST_AUTO_TEST_CASE(test_caching_options_results_ttl) {
+    using string_map = std::map<sstring, sstring>;
+    {
+        string_map in_map = { {"keys", "ALL"}, {"rows_per_partition", "ALL"}, {"results_ttl_in_ms", "250"}};
+        caching_options co = caching_options::from_map(in_map);
+        BOOST_REQUIRE_EQUAL(co.results_ttl().count(), 250);
+        BOOST_REQUIRE(in_map == co.to_map());
+        BOOST_REQUIRE(co == caching_options::from_sstring(co.to_sstring()));
+        BOOST_REQUIRE(co != caching_options::from_map({ {"keys", "ALL"}, {"rows_per_partition", "ALL"}}));
+    }
+    {
+        caching_options co = caching_options::from_map({ {"keys", "ALL"}});
+        BOOST_REQUIRE_EQUAL(co.results_ttl().count(), 0);
+        BOOST_REQUIRE_EQUAL(co.to_map().count("results_ttl_in_ms"), 0u);
+    }
+    BOOST_REQUIRE_THROW(caching_options::from_map({ {"results_ttl_in_ms", "soon"}}), std::exception);
+}
@@ -8,8 +8,10 @@
 
 #include <seastar/util/defer.hh>
 #include <seastar/testing/thread_test_case.hh>
+#include <set>
 #include <string>
 #include <boost/range/adaptor/map.hpp>
+#include <boost/range/irange.hpp>
 
 #include "cdc/log.hh"
 #include "cdc/cdc_extension.hh"
@@ -609,6 +611,40 @@ SEASTAR_THREAD_TEST_CASE(test_pre_post_image_logging) {
     }).get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_coalesced_preimage_selects) {
+    auto cfg = make_shared<db::config>();
+    cfg->cdc_coalesce_preimage_selects.set(true);
+    do_with_cql_env_thread([](cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE ks.tbl (pk int, ck int, val int, PRIMARY KEY(pk, ck)) WITH cdc = {'enabled':'true', 'preimage':'true'}");
+        cquery_nofail(e, "INSERT INTO ks.tbl (pk, ck, val) VALUES (0, 0, 100)");
+
+        // Concurrent updates of the same row share a preimage select, and
+        // every one of them still gets a preimage of a value the row had.
+        constexpr int updates = 20;
+        auto coalesced_before = e.local_qp().proxy().get_cdc_stats().preimage_selects_coalesced;
+        parallel_for_each(boost::irange(0, updates), [&e] (int i) {
+            return e.execute_cql(format("UPDATE ks.tbl SET val = {} WHERE pk = 0 AND ck = 0", i)).discard_result();
+        }).get();
+        auto coalesced = e.local_qp().proxy().get_cdc_stats().preimage_selects_coalesced - coalesced_before;
+        BOOST_REQUIRE_GT(coalesced, 0);
+
+        auto rows = select_log(e, "tbl");
+        auto pre_image = to_bytes_filtered(*rows, cdc::operation::pre_image);
+        BOOST_REQUIRE_EQUAL(pre_image.size(), updates);
+        auto val_index = column_index(*rows, cdc::log_data_column_name("val"));
+        std::set<int32_t> vals;
+        for (auto& r : pre_image) {
+            auto val = value_cast<int32_t>(int32_type->deserialize(bytes_view(*r[val_index])));
+            BOOST_REQUIRE(val == 100 || (val >= 0 && val < updates));
+            vals.insert(val);
+        }
+        // The first select runs before any of the updates is applied, and
+        // the updates of a batch get the preimage of its single select.
+        BOOST_REQUIRE(vals.contains(100));
+        BOOST_REQUIRE_LE(vals.size(), updates - coalesced);
+    }, cfg).get();
+}
+
 SEASTAR_THREAD_TEST_CASE(test_pre_post_image_logging_static_row) {
     do_with_cql_env_thread([](cql_test_env& e) {
         auto test = [&e] (bool enabled, bool with_ttl) {
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/core/when_all.hh>
+#include <seastar/core/fstream.hh>
+#include <seastar/core/file.hh>
+#include <seastar/util/defer.hh>
+
+#include "test/lib/random_utils.hh"
+#include "test/lib/log.hh"
+#include "test/lib/tmpdir.hh"
+
+#include "utils/coalescing_file.hh"
+
+using namespace seastar;
+
+struct test_file {
+    tmpdir dir;
+    file f;
+    sstring contents;
+};
+
+static test_file make_test_file(size_t size) {
+    tmpdir dir;
+    auto contents = tests::random::get_sstring(size);
+
+    auto path = dir.path() / "file";
+    file f = open_file_dma(path.c_str(), open_flags::create | open_flags::rw).get0();
+
+    output_stream<char> out = make_file_output_stream(f).get0();
+    auto close_out = defer([&] { out.close().get(); });
+    out.write(contents.begin(), contents.size()).get();
+    out.flush().get();
+
+    f = open_file_dma(path.c_str(), open_flags::ro).get0();
+
+    return test_file{
+        .dir = std::move(dir),
+        .f = std::move(f),
+        .contents = std::move(contents)
+    };
+}
+
+static sstring to_sstring(const temporary_buffer<uint8_t>& buf) {
+    return sstring(reinterpret_cast<const char*>(buf.get()), buf.size());
+}
+
+SEASTAR_THREAD_TEST_CASE(test_concurrent_nearby_reads_are_merged) {
+    const size_t block = 4096;
+    test_file tf = make_test_file(block * 8);
+
+    coalescing_file_impl::stats stats;
+    coalescing_file_impl::config cfg;
+    cfg.max_gap = block;
+    cfg.max_read_size = block * 4;
+    file f = make_coalescing_file(tf.f, cfg, stats);
+    auto close_f = defer([&] { f.close().get(); });
+
+    auto& pc = default_priority_class();
+
+    // Blocks 0 and 1 are adjacent and block 3 is within max_gap, so they are merged.
+    // Block 6 is too far away and gets its own read.
+    auto results = when_all_succeed(
+            f.dma_read_bulk<uint8_t>(0, block, pc),
+            f.dma_read_bulk<uint8_t>(block, block, pc),
+            f.dma_read_bulk<uint8_t>(block * 3, block, pc),
+            f.dma_read_bulk<uint8_t>(block * 6, block, pc)).get0();
+
+    BOOST_REQUIRE_EQUAL(stats.requests, 4);
+    BOOST_REQUIRE_EQUAL(stats.reads, 2);
+
+    BOOST_REQUIRE_EQUAL(to_sstring(std::get<0>(results)), tf.contents.substr(0, block));
+    BOOST_REQUIRE_EQUAL(to_sstring(std::get<1>(results)), tf.contents.substr(block, block));
+    BOOST_REQUIRE_EQUAL(to_sstring(std::get<2>(results)), tf.contents.substr(block * 3, block));
+    BOOST_REQUIRE_EQUAL(to_sstring(std::get<3>(results)), tf.contents.substr(block * 6, block));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_read_size_limit_and_eof) {
+    const size_t block = 4096;
+    test_file tf = make_test_file(block * 3);
+
+    coalescing_file_impl::stats stats;
+    coalescing_file_impl::config cfg;
+    cfg.max_read_size = block * 2;
+    file f = make_coalescing_file(tf.f, cfg, stats);
+    auto close_f = defer([&] { f.close().get(); });
+
+    auto& pc = default_priority_class();
+
+    // The third request would make the merged read exceed max_read_size,
+    // and it extends past the end of file.
+    auto results = when_all_succeed(
+            f.dma_read_bulk<uint8_t>(0, block, pc),
+            f.dma_read_bulk<uint8_t>(block, block, pc),
+            f.dma_read_bulk<uint8_t>(block * 2, block * 2, pc)).get0();
+
+    BOOST_REQUIRE_EQUAL(stats.reads, 2);
+    BOOST_REQUIRE_EQUAL(to_sstring(std::get<0>(results)), tf.contents.substr(0, block));
+    BOOST_REQUIRE_EQUAL(to_sstring(std::get<1>(results)), tf.contents.substr(block, block));
+    BOOST_REQUIRE_EQUAL(to_sstring(std::get<2>(results)), tf.contents.substr(block * 2));
+
+    testlog.debug("requests: {}, reads: {}", stats.requests, stats.reads);
+}
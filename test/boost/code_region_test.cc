@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <seastar/core/reactor.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include "utils/code_region.hh"
+
+using namespace std::chrono_literals;
+
+static const utils::code_region_stats::site* find_site(utils::code_region r, scheduling_group sg) {
+    for (const auto& s : utils::code_region_stats::local().sites()) {
+        if (s->region == r && s->sg == sg) {
+            return s.get();
+        }
+    }
+    return nullptr;
+}
+
+// Each (region, scheduling group) pair is accounted separately, and only the
+// runs longer than the blocked reactor notification threshold are stalls.
+SEASTAR_THREAD_TEST_CASE(test_code_region_stats) {
+    auto& stats = utils::code_region_stats::local();
+    auto sg = create_scheduling_group("code_region_test", 100).get();
+    auto threshold = engine().get_blocked_reactor_notify_ms();
+
+    stats.record(utils::code_region::compaction, sg, 1us);
+    stats.record(utils::code_region::compaction, sg, threshold + 1ms);
+    stats.record(utils::code_region::view_update, sg, 2us);
+
+    auto* compaction = find_site(utils::code_region::compaction, sg);
+    BOOST_REQUIRE(compaction);
+    BOOST_REQUIRE_EQUAL(compaction->runs, 2);
+    BOOST_REQUIRE_EQUAL(compaction->stalls, 1);
+    BOOST_REQUIRE(compaction->max_runtime == threshold + 1ms);
+
+    auto* view_update = find_site(utils::code_region::view_update, sg);
+    BOOST_REQUIRE(view_update);
+    BOOST_REQUIRE_EQUAL(view_update->runs, 1);
+    BOOST_REQUIRE_EQUAL(view_update->stalls, 0);
+
+    BOOST_REQUIRE(!find_site(utils::code_region::cache_update, sg));
+}
+
+// The timer accounts its run to the scheduling group it was created in.
+SEASTAR_THREAD_TEST_CASE(test_code_region_timer) {
+    auto sg = create_scheduling_group("code_region_timer_test", 100).get();
+    auto runs = [] (scheduling_group group) -> uint64_t {
+        auto* s = find_site(utils::code_region::memtable_flush, group);
+        return s ? s->runs : 0;
+    };
+    auto default_runs = runs(default_scheduling_group());
+
+    with_scheduling_group(sg, [] {
+        utils::code_region_timer timer(utils::code_region::memtable_flush);
+    }).get();
+
+    auto* s = find_site(utils::code_region::memtable_flush, sg);
+    BOOST_REQUIRE(s);
+    BOOST_REQUIRE_EQUAL(s->runs, 1);
+    BOOST_REQUIRE_EQUAL(s->stalls, 0);
+    BOOST_REQUIRE_EQUAL(runs(default_scheduling_group()), default_runs);
+}
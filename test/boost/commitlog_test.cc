@@ -9,6 +9,7 @@
 
 #include <boost/test/unit_test.hpp>
 #include <boost/range/adaptor/map.hpp>
+#include <boost/range/irange.hpp>
 
 #include <stdlib.h>
 #include <iostream>
@@ -98,6 +99,25 @@ SEASTAR_TEST_CASE(test_commitlog_written_to_disk_batch){
         });
 }
 
+// check that concurrent writes in group mode are all flushed, sharing syncs
+SEASTAR_TEST_CASE(test_commitlog_written_to_disk_group){
+    commitlog::config cfg;
+    cfg.mode = commitlog::sync_mode::GROUP;
+    return cl_test(cfg, [](commitlog& log) {
+        return parallel_for_each(boost::irange(0, 100), [&log] (int) {
+            sstring tmp = "hej bubba cow";
+            return log.add_mutation(utils::UUID_gen::get_time_UUID(), tmp.size(), db::commitlog::force_sync::no, [tmp](db::commitlog::output& dst) {
+                dst.write(tmp.data(), tmp.size());
+            }).then([&log](replay_position rp) {
+                BOOST_CHECK_NE(rp, db::replay_position());
+                BOOST_REQUIRE(log.get_flush_count() > 0);
+            });
+        }).then([&log] {
+            BOOST_REQUIRE_LT(log.get_flush_count(), 100u);
+        });
+    });
+}
+
 // check that an entry marked as sync is immediately flushed to a storage
 SEASTAR_TEST_CASE(test_commitlog_written_to_disk_sync){
     commitlog::config cfg;
@@ -412,6 +432,45 @@ SEASTAR_TEST_CASE(test_commitlog_reader){
         });
 }
 
+SEASTAR_TEST_CASE(test_commitlog_reader_compressed){
+    commitlog::config cfg;
+    cfg.use_compression = true;
+
+    return cl_test(cfg, [](commitlog& log) -> future<> {
+        auto uuid = utils::UUID_gen::get_time_UUID();
+        // Compressible entries, and one too small to be compressed.
+        std::vector<sstring> values;
+        for (int i = 0; i < 10; ++i) {
+            values.push_back(sstring(4096 + i, 'a' + i));
+        }
+        values.push_back("hej bubba cow");
+
+        rp_set set;
+        for (auto& v : values) {
+            rp_handle h = co_await log.add_mutation(uuid, v.size(), db::commitlog::force_sync::no, [v](db::commitlog::output& dst) {
+                dst.write(v.data(), v.size());
+            });
+            set.put(std::move(h));
+        }
+        co_await log.sync_all_segments();
+
+        auto segments = log.get_active_segment_names();
+        BOOST_REQUIRE_EQUAL(segments.size(), 1u);
+        commitlog::descriptor desc(segments.front(), db::commitlog::descriptor::FILENAME_PREFIX);
+        BOOST_REQUIRE_EQUAL(desc.ver, db::commitlog::descriptor::segment_version_3);
+
+        std::vector<sstring> read;
+        co_await db::commitlog::read_log_file(segments.front(), db::commitlog::descriptor::FILENAME_PREFIX, service::get_local_commitlog_priority(), [&read](db::commitlog::buffer_and_replay_position buf_rp) {
+            auto&& [buf, rp] = buf_rp;
+            auto linearization_buffer = bytes_ostream();
+            auto in = buf.get_istream();
+            read.push_back(sstring(to_sstring_view(in.read_bytes_view(buf.size_bytes(), linearization_buffer))));
+            return make_ready_future<>();
+        });
+        BOOST_REQUIRE(read == values);
+    });
+}
+
 static future<> corrupt_segment(sstring seg, uint64_t off, uint32_t value) {
     return open_file_dma(seg, open_flags::rw).then([off, value](file f) {
         size_t size = align_up<size_t>(off, 4096);
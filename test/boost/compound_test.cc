@@ -387,3 +387,46 @@ SEASTAR_THREAD_TEST_CASE(test_prefix_compound_validity) {
     BOOST_REQUIRE_THROW(validate({'\x00', '\x01', 0, '\x00', '\x02', 'a', 'b', '\x00', '\x01', 'a'}), marshal_exception); // to many components
     BOOST_REQUIRE_THROW(validate({'\x00', '\x02', 'a', 'b', '\x00', '\x01', 0}), marshal_exception); // wrong order of components
 }
+
+SEASTAR_THREAD_TEST_CASE(test_compare_fragmented) {
+    struct fragmenting_allocation_strategy : standard_allocation_strategy {
+        fragmenting_allocation_strategy(size_t n) {
+            _preferred_max_contiguous_allocation = n;
+        }
+    };
+    fragmenting_allocation_strategy fragmenting_allocator(63);
+
+    auto check = [&] (const compound_type<allow_prefixes::yes>& c, std::function<bytes()> random_first) {
+        std::vector<bytes> values;
+        for (int i = 0; i < 50; ++i) {
+            std::vector<bytes> components{random_first()};
+            if (tests::random::get_bool()) {
+                components.push_back(to_bytes(sstring(tests::random::get_int<size_t>(0, 40), 'b')));
+            }
+            values.push_back(to_bytes(c.serialize_value(components)));
+        }
+        with_allocator(fragmenting_allocator, [&] {
+            std::vector<managed_bytes> fragmented(values.begin(), values.end());
+            auto linearizations = utils::get_linearization_stats().linearizations;
+            for (size_t i = 0; i < values.size(); ++i) {
+                for (size_t j = 0; j < values.size(); ++j) {
+                    managed_bytes_view a(fragmented[i]);
+                    managed_bytes_view b(fragmented[j]);
+                    bytes_view la(values[i]);
+                    bytes_view lb(values[j]);
+                    BOOST_REQUIRE(c.compare(a, b) == c.compare(la, lb));
+                    BOOST_REQUIRE_EQUAL(c.equal(a, b), c.equal(la, lb));
+                    BOOST_REQUIRE_EQUAL(c.less(a, b), c.less(la, lb));
+                }
+            }
+            BOOST_REQUIRE_EQUAL(utils::get_linearization_stats().linearizations, linearizations);
+        });
+    };
+
+    check(compound_type<allow_prefixes::yes>({int32_type, bytes_type}), [] {
+        return int32_type->decompose(tests::random::get_int<int32_t>(-2, 2));
+    });
+    check(compound_type<allow_prefixes::yes>({utf8_type, bytes_type}), [] {
+        return utf8_type->decompose(sstring(tests::random::get_int<size_t>(0, 30), 'a'));
+    });
+}
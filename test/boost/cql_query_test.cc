@@ -44,6 +44,7 @@
 #include "db/query_context.hh"
 #include "service/qos/qos_common.hh"
 #include "utils/UUID_gen.hh"
+#include "cql3/select_result_cache.hh"
 
 using namespace std::literals::chrono_literals;
 
@@ -4852,6 +4853,28 @@ SEASTAR_TEST_CASE(test_counter_column_added_into_non_counter_table) {
     });
 }
 
+SEASTAR_TEST_CASE(test_concurrent_counter_updates) {
+    cql_test_config cfg;
+    cfg.db_config->coalesce_counter_updates.set(true);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        cquery_nofail(e, "CREATE TABLE t (pk int, ck int, c1 counter, c2 counter, PRIMARY KEY(pk, ck))");
+
+        // Concurrent updates of the same cells are merged on the leader,
+        // none of the deltas may get lost.
+        auto updates = boost::irange(0, 100);
+        parallel_for_each(updates, [&e] (int i) {
+            auto set = i % 2 ? "c1 = c1 + 1, c2 = c2 - 1" : "c1 = c1 + 2";
+            return e.execute_cql(format("UPDATE t SET {} WHERE pk = 0 AND ck = {}", set, i % 3 ? 0 : 1)).discard_result();
+        }).get();
+
+        auto msg = cquery_nofail(e, "SELECT ck, c1, c2 FROM t WHERE pk = 0");
+        assert_that(msg).is_rows().with_rows({
+            {int32_type->decompose(0), long_type->decompose(int64_t(99)), long_type->decompose(int64_t(-33))},
+            {int32_type->decompose(1), long_type->decompose(int64_t(51)), long_type->decompose(int64_t(-17))},
+        });
+    }, std::move(cfg));
+}
+
 SEASTAR_THREAD_TEST_CASE(test_invalid_using_timestamps) {
     do_with_cql_env_thread([] (cql_test_env& e) {
         auto now_nano = std::chrono::duration_cast<std::chrono::nanoseconds>(db_clock::now().time_since_epoch()).count();
@@ -5180,7 +5203,53 @@ SEASTAR_TEST_CASE(test_parallelized_select_sum_group_by) {
             {int32_type->decompose(int32_t(0)), int32_type->decompose(int32_t((value_count - 1) * value_count / 2))}
         });
 
-        BOOST_CHECK_EQUAL(stat_parallelized, qp.get_cql_stats().select_parallelized);
+        BOOST_CHECK_EQUAL(stat_parallelized + 1, qp.get_cql_stats().select_parallelized);
+    });
+}
+
+SEASTAR_TEST_CASE(test_parallelized_select_count_group_by_clustering_prefix) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        auto& qp = e.local_qp();
+
+        e.execute_cql("CREATE TABLE tbl (k int, c1 int, c2 int, v int, PRIMARY KEY (k, c1, c2));").get();
+        for (int k = 0; k < 2; k++) {
+            for (int c1 = 0; c1 < 3; c1++) {
+                for (int c2 = 0; c2 <= c1; c2++) {
+                    e.execute_cql(format("INSERT INTO tbl (k, c1, c2, v) VALUES ({:d}, {:d}, {:d}, {:d});", k, c1, c2, c2)).get();
+                }
+            }
+        }
+
+        auto stat_parallelized = qp.get_cql_stats().select_parallelized;
+        auto msg = e.execute_cql("SELECT c1, k, COUNT(*), MAX(v) FROM tbl GROUP BY k, c1;").get();
+        std::vector<std::vector<bytes_opt>> expected;
+        for (int k : {1, 0}) {
+            for (int c1 = 0; c1 < 3; c1++) {
+                expected.push_back({int32_type->decompose(c1), int32_type->decompose(k), long_type->decompose(int64_t(c1 + 1)), int32_type->decompose(c1)});
+            }
+        }
+        assert_that(msg).is_rows().with_rows(expected);
+        BOOST_CHECK_EQUAL(stat_parallelized + 1, qp.get_cql_stats().select_parallelized);
+
+        msg = e.execute_cql("SELECT k, c1, COUNT(*) FROM tbl GROUP BY k, c1 LIMIT 2;").get();
+        assert_that(msg).is_rows().with_rows({
+            {int32_type->decompose(1), int32_type->decompose(0), long_type->decompose(int64_t(1))},
+            {int32_type->decompose(1), int32_type->decompose(1), long_type->decompose(int64_t(2))},
+        });
+        BOOST_CHECK_EQUAL(stat_parallelized + 2, qp.get_cql_stats().select_parallelized);
+
+        // Selecting a column which isn't grouped by isn't a reduction.
+        e.execute_cql("SELECT k, c2, COUNT(*) FROM tbl GROUP BY k, c1;").get();
+        BOOST_CHECK_EQUAL(stat_parallelized + 2, qp.get_cql_stats().select_parallelized);
+
+        // Paged queries aren't forwarded, since groups are merged in a
+        // single page, but give the same result.
+        auto qo = std::make_unique<cql3::query_options>(db::consistency_level::LOCAL_ONE,
+                std::vector<cql3::raw_value>{},
+                cql3::query_options::specific_options{2, nullptr, {}, api::new_timestamp()});
+        msg = e.execute_cql("SELECT c1, k, COUNT(*), MAX(v) FROM tbl GROUP BY k, c1;", std::move(qo)).get();
+        assert_that(msg).is_rows().with_rows(expected);
+        BOOST_CHECK_EQUAL(stat_parallelized + 2, qp.get_cql_stats().select_parallelized);
     });
 }
 
@@ -5566,3 +5635,71 @@ SEASTAR_TEST_CASE(test_setting_synchronous_updates_property) {
         );
     });
 }
+
+// Results of a prepared SELECT are served from the coordinator's cache until
+// the table is written to or truncated. Dropping the table forgets it.
+SEASTAR_TEST_CASE(test_select_result_cache) {
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        e.execute_cql("CREATE TABLE t (pk int PRIMARY KEY, v int) "
+                "WITH caching = {'keys': 'ALL', 'rows_per_partition': 'ALL', 'results_ttl_in_ms': '3600000'}").get();
+        e.execute_cql("INSERT INTO t (pk, v) VALUES (1, 1)").get();
+        auto table = e.local_db().find_schema("ks", "t")->id();
+        auto id = e.prepare("SELECT v FROM t WHERE pk = ?").get0();
+
+        auto& stats = cql3::select_result_cache::shard_stats();
+        auto select = [&] (bool hit) {
+            auto hits = stats.hits;
+            auto misses = stats.misses;
+            auto msg = e.execute_prepared(id, {cql3::raw_value::make_value(int32_type->decompose(int32_t{1}))}).get0();
+            BOOST_REQUIRE_EQUAL(stats.hits, hits + hit);
+            BOOST_REQUIRE_EQUAL(stats.misses, misses + !hit);
+            return msg;
+        };
+
+        assert_that(select(false)).is_rows().with_rows({{int32_type->decompose(int32_t{1})}});
+        assert_that(select(true)).is_rows().with_rows({{int32_type->decompose(int32_t{1})}});
+
+        auto invalidations = stats.invalidations;
+        e.execute_cql("UPDATE t SET v = 2 WHERE pk = 1").get();
+        BOOST_REQUIRE_EQUAL(stats.invalidations, invalidations + 1);
+        assert_that(select(false)).is_rows().with_rows({{int32_type->decompose(int32_t{2})}});
+        assert_that(select(true)).is_rows().with_rows({{int32_type->decompose(int32_t{2})}});
+
+        // Reads at consistency levels stronger than ONE bypass the cache.
+        auto hits = stats.hits;
+        e.execute_prepared(id, {cql3::raw_value::make_value(int32_type->decompose(int32_t{1}))}, db::consistency_level::QUORUM).get();
+        BOOST_REQUIRE_EQUAL(stats.hits, hits);
+
+        e.execute_cql("TRUNCATE t").get();
+        assert_that(select(false)).is_rows().is_empty();
+        assert_that(select(true)).is_rows().is_empty();
+
+        BOOST_REQUIRE_GT(cql3::select_result_cache(table).generation(), 0);
+        e.execute_cql("DROP TABLE t").get();
+        BOOST_REQUIRE_EQUAL(cql3::select_result_cache(table).generation(), 0);
+    });
+}
+
+// Concurrent reads of an sstable's data file are merged when
+// coalesce_sstable_data_reads is set, and each gets its own data back.
+SEASTAR_TEST_CASE(test_coalesced_sstable_data_reads) {
+    cql_test_config cfg;
+    cfg.db_config->coalesce_sstable_data_reads.set(true);
+    return do_with_cql_env_thread([](cql_test_env& e) {
+        const int partitions = 100;
+        e.execute_cql("CREATE TABLE t (pk int PRIMARY KEY, v text)").get();
+        auto insert = e.prepare("INSERT INTO t (pk, v) VALUES (?, ?)").get0();
+        for (int pk = 0; pk < partitions; ++pk) {
+            e.execute_prepared(insert, {cql3::raw_value::make_value(int32_type->decompose(pk)),
+                    cql3::raw_value::make_value(utf8_type->decompose(sstring(1000, char('a' + pk % 26))))}).get();
+        }
+        e.db().invoke_on_all([] (replica::database& db) { return db.flush_all_memtables(); }).get();
+
+        auto select = e.prepare("SELECT v FROM t WHERE pk = ? BYPASS CACHE").get0();
+        parallel_for_each(boost::irange(0, partitions), [&] (int pk) {
+            return e.execute_prepared(select, {cql3::raw_value::make_value(int32_type->decompose(pk))}).then([pk] (shared_ptr<cql_transport::messages::result_message> msg) {
+                assert_that(msg).is_rows().with_rows({{utf8_type->decompose(sstring(1000, char('a' + pk % 26)))}});
+            });
+        }).get();
+    }, std::move(cfg));
+}
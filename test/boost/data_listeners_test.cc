@@ -11,11 +11,15 @@
 #include <seastar/testing/test_case.hh>
 #include "test/lib/cql_test_env.hh"
 #include "test/lib/cql_assertions.hh"
+#include "test/lib/result_set_assertions.hh"
 #include "test/lib/log.hh"
 #include "cql3/query_processor.hh"
 #include "readers/filtering.hh"
 
+#include "db/config.hh"
 #include "db/data_listeners.hh"
+#include "replica/hot_partitions.hh"
+#include "query-result-set.hh"
 
 using namespace std;
 using namespace std::chrono_literals;
@@ -114,3 +118,119 @@ SEASTAR_TEST_CASE(test_dlistener_t2) {
         BOOST_REQUIRE_EQUAL(0, res.write);
     });
 }
+
+SEASTAR_TEST_CASE(test_hot_partition_copies) {
+    // Copies are made on demand below. Detection must be enabled, so that
+    // truncation drops them, but no partition gets anywhere near the threshold.
+    cql_test_config cfg;
+    cfg.db_config->hot_partition_copies_threshold.set(1000000);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        if (smp::count < 2) {
+            testlog.info("test_hot_partition_copies needs at least 2 shards, skipping");
+            return;
+        }
+
+        e.execute_cql("CREATE TABLE t3 (k int PRIMARY KEY, v int);").get();
+        e.execute_cql("INSERT INTO t3 (k, v) VALUES (1, 1);").get();
+
+        auto s = e.local_db().find_schema("ks", "t3");
+        auto dk = dht::decorate_key(*s, partition_key::from_single_value(*s, int32_type->decompose(1)));
+        auto owner = dht::shard_of(*s, dk.token());
+        auto other = (owner + 1) % smp::count;
+        auto gs = global_schema_ptr(s);
+
+        auto replicate = [&] {
+            e.db().invoke_on(owner, [gs, dk] (replica::database& db) {
+                return db.hot_partitions().replicate(gs, dk);
+            }).get();
+        };
+        auto read_copy = [&] (uint64_t max_size = 1024 * 1024) {
+            return e.db().invoke_on(other, [gs, dk, max_size] (replica::database& db) -> std::optional<query::result_set> {
+                schema_ptr s = gs;
+                query::read_command cmd(s->id(), s->version(), s->full_slice(), query::max_result_size(max_size), query::row_limit(query::max_rows));
+                auto res = db.hot_partitions().query(s, cmd, dht::partition_range::make_singular(dk), query::result_options::only_result());
+                if (!res) {
+                    return std::nullopt;
+                }
+                return query::result_set::from_raw_result(s, cmd.slice, *std::get<0>(*res));
+            }).get0();
+        };
+
+        replicate();
+        auto rs = read_copy();
+        BOOST_REQUIRE(rs);
+        assert_that(*rs).has_only(a_row().with_column("k", 1).with_column("v", 1));
+
+        // Results larger than the query allows are left to the owner.
+        BOOST_REQUIRE(!read_copy(1));
+
+        // A write drops the copies before it completes.
+        e.execute_cql("UPDATE t3 SET v = 2 WHERE k = 1;").get();
+        BOOST_REQUIRE(!read_copy());
+
+        replicate();
+        rs = read_copy();
+        BOOST_REQUIRE(rs);
+        assert_that(*rs).has_only(a_row().with_column("k", 1).with_column("v", 2));
+
+        // So does truncation.
+        e.execute_cql("TRUNCATE t3;").get();
+        BOOST_REQUIRE(!read_copy());
+        BOOST_REQUIRE_EQUAL(e.db().invoke_on(owner, [] (replica::database& db) {
+            return db.hot_partitions().replicated_partitions();
+        }).get0(), 0u);
+    }, std::move(cfg));
+}
+
+SEASTAR_TEST_CASE(test_hot_partition_cached_digests) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        if (smp::count < 2) {
+            testlog.info("test_hot_partition_cached_digests needs at least 2 shards, skipping");
+            return;
+        }
+
+        e.execute_cql("CREATE TABLE t4 (k int PRIMARY KEY, v int);").get();
+        e.execute_cql("INSERT INTO t4 (k, v) VALUES (1, 1);").get();
+        e.execute_cql("INSERT INTO t4 (k, v) VALUES (2, 2) USING TTL 1000;").get();
+
+        auto s = e.local_db().find_schema("ks", "t4");
+        auto gs = global_schema_ptr(s);
+
+        struct digest_read {
+            query::result_digest digest;
+            api::timestamp_type last_modified;
+            uint64_t cached_digest_reads;
+        };
+        // Replicates the partition and reads its digest from a copy twice.
+        auto read_digests = [&] (int k) {
+            auto dk = dht::decorate_key(*s, partition_key::from_single_value(*s, int32_type->decompose(k)));
+            auto owner = dht::shard_of(*s, dk.token());
+            e.db().invoke_on(owner, [gs, dk] (replica::database& db) {
+                return db.hot_partitions().replicate(gs, dk);
+            }).get();
+            return e.db().invoke_on((owner + 1) % smp::count, [gs, dk] (replica::database& db) {
+                schema_ptr s = gs;
+                query::read_command cmd(s->id(), s->version(), s->full_slice(), query::max_result_size(1024 * 1024), query::row_limit(query::max_rows));
+                auto opts = query::result_options::only_digest(query::digest_algorithm::xxHash);
+                std::vector<digest_read> reads;
+                for (int i = 0; i < 2; ++i) {
+                    auto res = db.hot_partitions().query(s, cmd, dht::partition_range::make_singular(dk), opts);
+                    BOOST_REQUIRE(res);
+                    auto& r = *std::get<0>(*res);
+                    reads.push_back({*r.digest(), r.last_modified(), db.hot_partitions().get_stats().cached_digest_reads});
+                }
+                return reads;
+            }).get0();
+        };
+
+        auto reads = read_digests(1);
+        BOOST_REQUIRE(reads[0].digest == reads[1].digest);
+        BOOST_REQUIRE_EQUAL(reads[0].last_modified, reads[1].last_modified);
+        BOOST_REQUIRE_EQUAL(reads[1].cached_digest_reads, reads[0].cached_digest_reads + 1);
+
+        // Results of partitions with expiring data depend on the query time.
+        reads = read_digests(2);
+        BOOST_REQUIRE(reads[0].digest == reads[1].digest);
+        BOOST_REQUIRE_EQUAL(reads[1].cached_digest_reads, reads[0].cached_digest_reads);
+    });
+}
@@ -16,6 +16,8 @@
 
 #include "test/lib/cql_test_env.hh"
 #include "test/lib/result_set_assertions.hh"
+#include "test/lib/cql_assertions.hh"
+#include "test/lib/eventually.hh"
 #include "test/lib/log.hh"
 #include "test/lib/random_utils.hh"
 
@@ -142,6 +144,65 @@ SEASTAR_TEST_CASE(test_truncate_without_snapshot_during_writes) {
     }, cfg);
 }
 
+// Applies concurrent writes of distinct rows of partition 0 of ks.cf on the
+// shard owning it, and returns the value of the given counter afterwards.
+static uint64_t apply_concurrent_partition_writes(cql_test_env& e, int writes, std::function<uint64_t (replica::database&, replica::table&)> counter) {
+    auto uuid = e.local_db().find_uuid("ks", "cf");
+    auto s = e.local_db().find_column_family(uuid).schema();
+    auto pkey = partition_key::from_single_value(*s, int32_type->decompose(0));
+    auto shard = dht::shard_of(*s, dht::get_token(*s, pkey));
+
+    return e.db().invoke_on(shard, [uuid, pkey, writes, counter = std::move(counter)] (replica::database& db) {
+        auto& t = db.find_column_family(uuid);
+        auto s = t.schema();
+        return parallel_for_each(boost::irange(0, writes), [&db, s, pkey] (int i) {
+            mutation m(s, pkey);
+            m.set_clustered_cell(clustering_key::from_single_value(*s, int32_type->decompose(i)), "v", int32_t(i), api::new_timestamp());
+            return do_with(freeze(m), [&db, s] (const frozen_mutation& fm) {
+                return db.apply(s, fm, tracing::trace_state_ptr(), db::commitlog::force_sync::no, db::no_timeout);
+            });
+        }).then([&db, &t, counter] {
+            return counter(db, t);
+        });
+    }).get0();
+}
+
+SEASTAR_TEST_CASE(test_coalesced_partition_writes) {
+    auto cfg = make_shared<db::config>();
+    cfg->coalesce_partition_writes.set(true);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table ks.cf (pk int, ck int, v int, primary key (pk, ck));").get();
+        auto coalesced = apply_concurrent_partition_writes(e, 100, [] (replica::database&, replica::table& t) {
+            return t.get_stats().memtable_coalesced_writes;
+        });
+        BOOST_REQUIRE_GT(coalesced, 0);
+
+        auto msg = e.execute_cql("select count(*) from ks.cf where pk = 0;").get0();
+        assert_that(msg).is_rows().with_rows({{long_type->decompose(int64_t(100))}});
+    }, cfg);
+}
+
+SEASTAR_TEST_CASE(test_batched_view_updates) {
+    auto cfg = make_shared<db::config>();
+    cfg->batch_view_updates.set(true);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table ks.cf (pk int, ck int, v int, primary key (pk, ck));").get();
+        e.execute_cql("create materialized view ks.mv as select * from ks.cf "
+                "where pk is not null and ck is not null and v is not null primary key (v, pk, ck);").get();
+        auto batched = apply_concurrent_partition_writes(e, 100, [] (replica::database& db, replica::table&) {
+            return db.cf_stats()->batched_view_updates;
+        });
+        BOOST_REQUIRE_GT(batched, 0);
+
+        auto msg = e.execute_cql("select count(*) from ks.cf where pk = 0;").get0();
+        assert_that(msg).is_rows().with_rows({{long_type->decompose(int64_t(100))}});
+        eventually([&] {
+            auto msg = e.execute_cql("select count(*) from ks.mv;").get0();
+            assert_that(msg).is_rows().with_rows({{long_type->decompose(int64_t(100))}});
+        });
+    }, cfg);
+}
+
 SEASTAR_TEST_CASE(test_querying_with_limits) {
     return do_with_cql_env([](cql_test_env& e) {
         return seastar::async([&] {
@@ -1091,6 +1152,83 @@ SEASTAR_TEST_CASE(populate_from_quarantine_works) {
     BOOST_REQUIRE_EQUAL(row_count, 6);
 }
 
+static future<size_t> count_cold_sstables(sharded<replica::database>& db) {
+    return db.map_reduce0([] (replica::database& db) {
+        auto& cf = db.find_column_family("ks", "cf");
+        auto sstables = in_strategy_sstables(cf.as_table_state());
+        return size_t(std::count_if(sstables.begin(), sstables.end(), [] (const sstables::shared_sstable& sst) {
+            return sst->is_cold();
+        }));
+    }, size_t(0), std::plus<size_t>());
+}
+
+static future<size_t> count_rows(cql_test_env& e) {
+    auto res = co_await e.execute_cql("select * from ks.cf;");
+    auto rows = dynamic_pointer_cast<cql_transport::messages::result_message::rows>(res);
+    BOOST_REQUIRE(rows);
+    co_return rows->rs().result_set().size();
+}
+
+SEASTAR_TEST_CASE(populate_from_cold_works) {
+    auto tmpdir_for_data = make_lw_shared<tmpdir>();
+    auto db_cfg_ptr = make_shared<db::config>();
+    db_cfg_ptr->data_file_directories(std::vector<sstring>({ tmpdir_for_data->path().string() }));
+    utils::UUID host_id;
+
+    // populate tmpdir_for_data and
+    // move a random sstable to the cold directory
+    co_await do_with_some_data({"cf"}, [&host_id] (cql_test_env& e) -> future<> {
+        host_id = e.local_db().get_config().host_id;
+        auto& db = e.db();
+        co_await db.invoke_on_all([] (replica::database& db) {
+            auto& cf = db.find_column_family("ks", "cf");
+            return cf.flush();
+        });
+        auto shard = tests::random::get_int<unsigned>(0, smp::count);
+        auto found = false;
+        for (auto i = 0; i < smp::count && !found; i++) {
+            found = co_await db.invoke_on((shard + i) % smp::count, [] (replica::database& db) -> future<bool> {
+                auto& cf = db.find_column_family("ks", "cf");
+                auto sstables = in_strategy_sstables(cf.as_table_state());
+                if (sstables.empty()) {
+                    co_return false;
+                }
+                auto sst = sstables[tests::random::get_int<size_t>(0, sstables.size() - 1)];
+                auto cold_dir = sst->get_dir() + "/" + sstables::cold_dir;
+                co_await touch_directory(cold_dir);
+                co_await sst->move_to_new_dir(cold_dir, sst->generation());
+                co_return true;
+            });
+        }
+        BOOST_REQUIRE(found);
+    }, db_cfg_ptr);
+
+    // the cold sstable is loaded on restart, and can be compacted
+    // together with sstables of the table directory
+    db_cfg_ptr->host_id = host_id;
+    co_await do_with_cql_env([] (cql_test_env& e) -> future<> {
+        BOOST_REQUIRE_EQUAL(co_await count_cold_sstables(e.db()), 1);
+        BOOST_REQUIRE_EQUAL(co_await count_rows(e), 6);
+
+        for (int i = 0; i < 100; i++) {
+            co_await e.execute_cql(format("insert into ks.cf (p1, c1, c2, r1) values ('key{}', 1, 2, 3);", i + 3));
+        }
+        co_await e.db().invoke_on_all([] (replica::database& db) -> future<> {
+            auto& cf = db.find_column_family("ks", "cf");
+            co_await cf.flush();
+            co_await cf.compact_all_sstables();
+        });
+        BOOST_REQUIRE_EQUAL(co_await count_cold_sstables(e.db()), 0);
+        BOOST_REQUIRE_EQUAL(co_await count_rows(e), 106);
+    }, db_cfg_ptr);
+
+    // nothing was lost or resurrected by removing the compacted sstables
+    co_await do_with_cql_env([] (cql_test_env& e) -> future<> {
+        BOOST_REQUIRE_EQUAL(co_await count_cold_sstables(e.db()), 0);
+        BOOST_REQUIRE_EQUAL(co_await count_rows(e), 106);
+    }, std::move(db_cfg_ptr));
+}
+
 SEASTAR_TEST_CASE(snapshot_with_quarantine_works) {
     return do_with_some_data({"cf"}, [] (cql_test_env& e) -> future<> {
         auto& db = e.db();
@@ -1251,3 +1389,30 @@ SEASTAR_TEST_CASE(drop_table_with_explicit_snapshot) {
         co_return;
     });
 }
+
+SEASTAR_TEST_CASE(test_table_may_have_tombstones) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table ks.cf (p int primary key, v int)").get();
+        auto range = dht::token_range::make_open_ended_both_sides();
+        auto may_have_tombstones = [&] {
+            return e.db().map_reduce0([&] (replica::database& db) {
+                return db.find_column_family("ks", "cf").may_have_tombstones(range);
+            }, false, std::logical_or<bool>()).get0();
+        };
+        auto flush = [&] {
+            e.db().invoke_on_all([] (replica::database& db) {
+                return db.flush_all_memtables();
+            }).get();
+        };
+
+        e.execute_cql("insert into ks.cf (p, v) values (0, 0)").get();
+        BOOST_REQUIRE(!may_have_tombstones());
+        flush();
+        BOOST_REQUIRE(!may_have_tombstones());
+
+        e.execute_cql("delete from ks.cf where p = 1").get();
+        BOOST_REQUIRE(may_have_tombstones());
+        flush();
+        BOOST_REQUIRE(may_have_tombstones());
+    });
+}
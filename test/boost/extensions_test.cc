@@ -23,6 +23,8 @@
 #include "sstables/sstables.hh"
 #include "cdc/cdc_extension.hh"
 #include "db/paxos_grace_seconds_extension.hh"
+#include "db/non_durable_writes_extension.hh"
+#include "exceptions/exceptions.hh"
 #include "transport/messages/result_message.hh"
 #include "utils/overloaded_functor.hh"
 
@@ -159,6 +161,33 @@ SEASTAR_TEST_CASE(paxos_grace_seconds_extension) {
     }, cfg);
 }
 
+SEASTAR_TEST_CASE(non_durable_writes_extension) {
+    auto ext = std::make_shared<db::extensions>();
+    ext->add_schema_extension<db::non_durable_writes_extension>(db::non_durable_writes_extension::NAME);
+    auto cfg = ::make_shared<db::config>(ext);
+
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE cf (pk int PRIMARY KEY, v int) WITH non_durable_writes = {'flush_period_in_ms': '1000'}").get();
+        auto& cf = e.local_db().find_column_family("ks", "cf");
+        BOOST_REQUIRE(cf.schema()->non_durable_writes_flush_period() == std::chrono::milliseconds(1000));
+        BOOST_REQUIRE(!cf.durable_writes());
+
+        // Writes are flushed without being asked to.
+        e.execute_cql("INSERT INTO cf (pk, v) VALUES (1, 1)").get();
+        auto deadline = lowres_clock::now() + std::chrono::seconds(30);
+        while (cf.get_stats().non_durable_flushes == 0) {
+            BOOST_REQUIRE(lowres_clock::now() < deadline);
+            seastar::sleep(std::chrono::milliseconds(100)).get();
+        }
+
+        BOOST_REQUIRE_THROW(e.execute_cql("ALTER TABLE cf WITH non_durable_writes = {'flush_period_in_ms': '0'}").get(), exceptions::configuration_exception);
+        BOOST_REQUIRE_THROW(e.execute_cql("ALTER TABLE cf WITH non_durable_writes = {'knas': '1'}").get(), exceptions::configuration_exception);
+
+        e.execute_cql("CREATE TABLE durable (pk int PRIMARY KEY, v int)").get();
+        BOOST_REQUIRE(e.local_db().find_column_family("ks", "durable").durable_writes());
+    }, cfg);
+}
+
 SEASTAR_TEST_CASE(test_extension_remove) {
     auto ext = std::make_shared<db::extensions>();
     ext->add_schema_extension("knas", [](db::extensions::schema_ext_config args) {
@@ -1153,3 +1153,64 @@ SEASTAR_TEST_CASE(test_filtering) {
 
     });
 }
+
+SEASTAR_TEST_CASE(test_filtering_reversed_clustering_and_null_cells) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE t (p int, c int, v int, PRIMARY KEY (p, c)) WITH CLUSTERING ORDER BY (c DESC)").get();
+        e.execute_cql("INSERT INTO t (p, c, v) VALUES (1, 1, 10)").get();
+        e.execute_cql("INSERT INTO t (p, c, v) VALUES (1, 2, 20)").get();
+        e.execute_cql("INSERT INTO t (p, c) VALUES (1, 3)").get();
+
+        // Comparisons on a reversed column use the order of its values, not the clustering order.
+        auto msg = e.execute_cql("SELECT c FROM t WHERE c > 1 AND v < 30 ALLOW FILTERING").get0();
+        assert_that(msg).is_rows().with_rows({
+            { int32_type->decompose(2) },
+        });
+
+        // A null cell doesn't satisfy any comparison.
+        msg = e.execute_cql("SELECT c FROM t WHERE v >= 0 ALLOW FILTERING").get0();
+        assert_that(msg).is_rows().with_rows({
+            { int32_type->decompose(2) },
+            { int32_type->decompose(1) },
+        });
+        msg = e.execute_cql("SELECT c FROM t WHERE p = 1 AND v = 10 ALLOW FILTERING").get0();
+        assert_that(msg).is_rows().with_rows({
+            { int32_type->decompose(1) },
+        });
+    });
+}
+
+SEASTAR_TEST_CASE(test_filtering_on_partition_key_components) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("CREATE TABLE t (p1 int, p2 int, c int, v int, PRIMARY KEY ((p1, p2), c))").get();
+        // More partitions than replicas skip in a row before returning one regardless.
+        for (int i = 0; i < 300; ++i) {
+            e.execute_cql(format("INSERT INTO t (p1, p2, c, v) VALUES ({}, {}, 0, {})", i % 3, i, i)).get();
+        }
+
+        auto msg = e.execute_cql("SELECT v FROM t WHERE p2 = 7 ALLOW FILTERING").get0();
+        assert_that(msg).is_rows().with_rows({
+            { int32_type->decompose(7) },
+        });
+
+        msg = e.execute_cql("SELECT v FROM t WHERE p2 IN (1, 2, 1000) ALLOW FILTERING").get0();
+        assert_that(msg).is_rows().with_rows_ignore_order({
+            { int32_type->decompose(1) },
+            { int32_type->decompose(2) },
+        });
+
+        msg = e.execute_cql("SELECT v FROM t WHERE p2 >= 10 AND p2 < 13 AND p1 = 1 ALLOW FILTERING").get0();
+        assert_that(msg).is_rows().with_rows({
+            { int32_type->decompose(10) },
+        });
+
+        msg = e.execute_cql("SELECT DISTINCT p1, p2 FROM t WHERE p2 > 297 ALLOW FILTERING").get0();
+        assert_that(msg).is_rows().with_size(2);
+
+        auto prepared_id = e.prepare("SELECT v FROM t WHERE p2 = ? ALLOW FILTERING").get0();
+        msg = e.execute_prepared(prepared_id, {cql3::raw_value::make_value(int32_type->decompose(42))}).get0();
+        assert_that(msg).is_rows().with_rows({
+            { int32_type->decompose(42) },
+        });
+    });
+}
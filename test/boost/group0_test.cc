@@ -15,6 +15,16 @@
 #include "utils/UUID_gen.hh"
 #include "transport/messages/result_message.hh"
 #include "service/migration_manager.hh"
+#include "service/storage_proxy.hh"
+#include "cql3/query_processor.hh"
+#include "service/raft/group0_state_machine.hh"
+#include "db/schema_tables.hh"
+#include "db/system_keyspace.hh"
+#include "data_dictionary/keyspace_metadata.hh"
+#include "schema_builder.hh"
+#include "serializer_impl.hh"
+#include "idl/group0_state_machine.dist.hh"
+#include "idl/group0_state_machine.dist.impl.hh"
 
 static future<utils::chunked_vector<std::vector<bytes_opt>>> fetch_rows(cql_test_env& e, std::string_view cql) {
     auto msg = co_await e.execute_cql(cql);
@@ -189,3 +199,63 @@ SEASTAR_TEST_CASE(test_concurrent_group0_modifications) {
 
     }, raft_cql_test_config());
 }
+
+// All commands given to a single apply() are applied, in order, with the
+// schema changes of consecutive commands of the same creator merged at once,
+// and commands built on an obsolete state are skipped.
+SEASTAR_TEST_CASE(test_group0_apply_batch) {
+    return do_with_cql_env([] (cql_test_env& e) -> future<> {
+        auto& mm = e.migration_manager().local();
+        auto& proxy = e.local_qp().proxy();
+        auto& db = e.local_db();
+        auto features = db.features().cluster_schema_features();
+
+        auto initial_state_id = co_await db::system_keyspace::get_last_group0_state_id();
+        auto make_command = [&] (std::vector<mutation> muts, std::optional<utils::UUID> prev_state_id, gms::inet_address creator) {
+            auto new_state_id = utils::UUID_gen::get_time_UUID();
+            std::vector<canonical_mutation> cmuts;
+            for (auto& m : muts) {
+                cmuts.emplace_back(m);
+            }
+            service::group0_command cmd {
+                .change{service::schema_change{std::move(cmuts)}},
+                .history_append{db::system_keyspace::make_group0_history_state_id_mutation(new_state_id, std::nullopt, "")},
+                .prev_state_id{prev_state_id},
+                .new_state_id{new_state_id},
+                .creator_addr{creator},
+                .creator_id{},
+            };
+            raft::command c;
+            ser::serialize(c, cmd);
+            return std::pair(std::move(c), new_state_id);
+        };
+        auto make_ks = [&] (sstring name) {
+            auto ksm = keyspace_metadata::new_keyspace(name, "org.apache.cassandra.locator.SimpleStrategy", {{"replication_factor", "1"}}, true);
+            return db::schema_tables::make_create_keyspace_mutations(features, ksm, api::new_timestamp());
+        };
+
+        auto self = gms::inet_address("127.0.0.1");
+        auto other = gms::inet_address("127.0.0.2");
+        // The table is created by a command after the one creating its
+        // keyspace, and both are merged together.
+        auto [create_ks1, id1] = make_command(make_ks("batch_ks1"), initial_state_id, self);
+        auto t = schema_builder("batch_ks1", "t").with_column("pk", int32_type, column_kind::partition_key).build();
+        auto [create_t, id2] = make_command(db::schema_tables::make_create_table_mutations(t, api::new_timestamp()), id1, self);
+        // Built on the state before the batch, so skipped.
+        auto [create_ks_obsolete, id3] = make_command(make_ks("batch_ks_obsolete"), initial_state_id, self);
+        auto [create_ks2, id4] = make_command(make_ks("batch_ks2"), id2, other);
+
+        service::group0_state_machine sm(e.get_raft_group0_client(), mm, proxy);
+        co_await sm.apply({std::cref(create_ks1), std::cref(create_t), std::cref(create_ks_obsolete), std::cref(create_ks2)});
+
+        BOOST_REQUIRE(db.has_keyspace("batch_ks1"));
+        BOOST_REQUIRE(db.has_schema("batch_ks1", "t"));
+        BOOST_REQUIRE(db.has_keyspace("batch_ks2"));
+        BOOST_REQUIRE(!db.has_keyspace("batch_ks_obsolete"));
+        BOOST_REQUIRE(co_await db::system_keyspace::group0_history_contains(id1));
+        BOOST_REQUIRE(co_await db::system_keyspace::group0_history_contains(id2));
+        BOOST_REQUIRE(!co_await db::system_keyspace::group0_history_contains(id3));
+        BOOST_REQUIRE(co_await db::system_keyspace::group0_history_contains(id4));
+        BOOST_REQUIRE_EQUAL(co_await db::system_keyspace::get_last_group0_state_id(), id4);
+    }, raft_cql_test_config());
+}
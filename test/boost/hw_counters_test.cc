@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/testing/thread_test_case.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/util/defer.hh>
+
+#include "test/lib/log.hh"
+
+#include "utils/hw_counters.hh"
+
+SEASTAR_THREAD_TEST_CASE(test_busy_scheduling_group_is_sampled) {
+    utils::hw_counter_sampler sampler(1'000'000);
+    sampler.start().get();
+    auto stop = defer([&] { sampler.stop().get(); });
+    if (!sampler.enabled()) {
+        testlog.info("Perf events are not available, skipping");
+        return;
+    }
+
+    // Spin in the current scheduling group, long enough for tens of
+    // overflows even on a slow machine.
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    volatile uint64_t sink = 0;
+    while (std::chrono::steady_clock::now() < end) {
+        for (unsigned i = 0; i < 10000; ++i) {
+            sink = sink + i;
+        }
+        thread::maybe_yield();
+    }
+
+    BOOST_REQUIRE_GT(sampler.samples(), 1u);
+    auto counts = sampler.get(current_scheduling_group());
+    BOOST_REQUIRE_GT(counts[size_t(utils::hw_counter_sampler::counter::cycles)], 0u);
+    BOOST_REQUIRE_GT(counts[size_t(utils::hw_counter_sampler::counter::instructions)], 0u);
+}
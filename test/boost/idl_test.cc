@@ -10,6 +10,8 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <seastar/core/simple-stream.hh>
+#include <seastar/core/temporary_buffer.hh>
 #include <seastar/util/variant_utils.hh>
 
 #include <map>
@@ -246,6 +248,38 @@ BOOST_AUTO_TEST_CASE(test_vector)
     }
 }
 
+// Sizes of non-final objects are filled in after the object is written for
+// some outputs and measured upfront for others, all must write the same bytes.
+BOOST_AUTO_TEST_CASE(test_output_streams_agree)
+{
+    std::vector<simple_compound> vec1 = { { 1, 2 }, { 3, 4 }, { 5, 6 } };
+    std::vector<simple_compound> vec2 = { { 7, 8 }, { 9, 10 } };
+    vectors_of_compounds voc = { vec1, wrapped_vector { vec2 } };
+
+    bytes_ostream buf1;
+    ser::serialize(buf1, voc);
+    auto expected = buf1.linearize();
+    BOOST_REQUIRE_EQUAL(ser::get_sizeof(voc), expected.size());
+
+    auto buf2 = ser::serialize_to_buffer<bytes>(voc);
+    BOOST_REQUIRE_EQUAL(bytes_view(buf2), expected);
+
+    // Fragments smaller than the size fields, so that some of them are split.
+    std::vector<seastar::temporary_buffer<char>> fragments;
+    for (size_t left = expected.size(); left; left -= fragments.back().size()) {
+        fragments.emplace_back(std::min<size_t>(left, 3));
+    }
+    using fragment_iterator = std::vector<seastar::temporary_buffer<char>>::iterator;
+    auto out = seastar::memory_output_stream<fragment_iterator>(
+            seastar::fragmented_memory_output_stream<fragment_iterator>(fragments.begin(), expected.size()));
+    ser::serialize(out, voc);
+    bytes buf3;
+    for (auto& f : fragments) {
+        buf3 += bytes(reinterpret_cast<const int8_t*>(f.get()), f.size());
+    }
+    BOOST_REQUIRE_EQUAL(bytes_view(buf3), expected);
+}
+
 BOOST_AUTO_TEST_CASE(test_variant)
 {
     std::vector<simple_compound> vec = {
@@ -188,3 +188,45 @@ BOOST_AUTO_TEST_CASE(test_from_nodetool_style_string) {
     auto key4 = partition_key::from_nodetool_style_string(s2, "value1:value2");
     BOOST_REQUIRE(key3.equal(*s1, key4));
 }
+
+BOOST_AUTO_TEST_CASE(test_specialized_clustering_prefix_compare) {
+    auto check = [] (data_type type, std::vector<data_value> values) {
+        auto s = schema_builder("", "")
+                .with_column("pk", bytes_type, column_kind::partition_key)
+                .with_column("ck", type, column_kind::clustering_key)
+                .build();
+        auto reversed_s = schema_builder("", "")
+                .with_column("pk", bytes_type, column_kind::partition_key)
+                .with_column("ck", reversed_type_impl::get_instance(type), column_kind::clustering_key)
+                .build();
+
+        std::vector<clustering_key_prefix> prefixes;
+        prefixes.push_back(clustering_key_prefix::make_empty());
+        prefixes.push_back(clustering_key_prefix::from_single_value(*s, bytes()));
+        for (auto& v : values) {
+            prefixes.push_back(clustering_key_prefix::from_single_value(*s, type->decompose(v)));
+        }
+
+        for (auto& p1 : prefixes) {
+            for (auto& p2 : prefixes) {
+                auto type_cmp = [&] {
+                    if (p1.is_empty(*s) || p2.is_empty(*s)) {
+                        return std::strong_ordering::equal;
+                    }
+                    return type->compare(*p1.begin(*s), *p2.begin(*s));
+                }();
+                BOOST_REQUIRE(s->clustering_prefix_tri_compare(p1.representation(), p2.representation()) == type_cmp);
+                BOOST_REQUIRE(reversed_s->clustering_prefix_tri_compare(p2.representation(), p1.representation()) == type_cmp);
+            }
+        }
+    };
+
+    check(int32_type, {int32_t(-1), int32_t(0), int32_t(1), std::numeric_limits<int32_t>::min()});
+    check(long_type, {int64_t(-1), int64_t(0), int64_t(1), std::numeric_limits<int64_t>::max()});
+    check(timestamp_type, {db_clock::time_point(db_clock::duration(-10)), db_clock::time_point(db_clock::duration(10))});
+    check(utf8_type, {sstring("a"), sstring("ab"), sstring("b"), sstring("\xc3\xa9")});
+    check(bytes_type, {to_bytes(std::string("\0", 1)), bytes("\xff"), bytes("a")});
+    check(timeuuid_type, {utils::UUID("e1e2e7e0-1a2b-11ee-8000-000000000001"), utils::UUID("e1e2e7e0-1a2b-11ee-7f00-000000000001"),
+            utils::UUID("01e2e7e0-1a2b-11ef-8000-000000000001")});
+    check(double_type, {-1.0, 0.0, 1.0});
+}
@@ -430,6 +430,57 @@ BOOST_AUTO_TEST_CASE(test_dollar) {
     BOOST_TEST(matches(matcher(u8R"(a\$bc)"), u8"a$bc"));
 }
 
+BOOST_AUTO_TEST_CASE(test_percent_segments) {
+    auto m1 = matcher(u8"a%b%c");
+    BOOST_TEST(matches(m1, u8"abc"));
+    BOOST_TEST(matches(m1, u8"aXbXc"));
+    BOOST_TEST(matches(m1, u8"abbcc"));
+    BOOST_TEST(matches(m1, u8"aШbШc"));
+    BOOST_TEST(!matches(m1, u8"acb"));
+    BOOST_TEST(!matches(m1, u8"ac"));
+    BOOST_TEST(!matches(m1, u8"abcd"));
+
+    auto m2 = matcher(u8"%ab%ab");
+    BOOST_TEST(matches(m2, u8"abab"));
+    BOOST_TEST(matches(m2, u8"xabyab"));
+    BOOST_TEST(!matches(m2, u8"ab"));
+    BOOST_TEST(!matches(m2, u8"aba"));
+
+    auto m3 = matcher(u8"ab%ba");
+    BOOST_TEST(matches(m3, u8"abba"));
+    BOOST_TEST(!matches(m3, u8"aba"));
+    BOOST_TEST(!matches(m3, u8"ab"));
+
+    auto m4 = matcher(u8"a%%b");
+    BOOST_TEST(matches(m4, u8"ab"));
+    BOOST_TEST(matches(m4, u8"a%%b"));
+    BOOST_TEST(!matches(m4, u8"a"));
+
+    auto m5 = matcher(u8"%bc%bc%");
+    BOOST_TEST(matches(m5, u8"bcbc"));
+    BOOST_TEST(matches(m5, u8"abcabcd"));
+    BOOST_TEST(!matches(m5, u8"bcb"));
+    BOOST_TEST(!matches(m5, u8"bcxb"));
+}
+
+BOOST_AUTO_TEST_CASE(test_percent_segments_escaped) {
+    auto m1 = matcher(u8R"(%\%%\_)");
+    BOOST_TEST(matches(m1, u8"%_"));
+    BOOST_TEST(matches(m1, u8"a%b_"));
+    BOOST_TEST(!matches(m1, u8"a%bc"));
+    BOOST_TEST(!matches(m1, u8"a_b%"));
+
+    auto m2 = matcher(u8R"(a\\%)");
+    BOOST_TEST(matches(m2, u8R"(a\)"));
+    BOOST_TEST(matches(m2, u8R"(a\bc)"));
+    BOOST_TEST(!matches(m2, u8"abc"));
+
+    auto m3 = matcher(u8R"(%a\)");
+    BOOST_TEST(matches(m3, u8R"(a\)"));
+    BOOST_TEST(matches(m3, u8R"(ba\)"));
+    BOOST_TEST(!matches(m3, u8"ba"));
+}
+
 BOOST_AUTO_TEST_CASE(test_reset) {
     auto m = matcher(u8"alpha");
     BOOST_TEST(matches(m, u8"alpha"));
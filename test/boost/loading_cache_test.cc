@@ -308,6 +308,27 @@ SEASTAR_THREAD_TEST_CASE(test_loading_cache_removing_key) {
     BOOST_REQUIRE(loading_cache.find(0) == nullptr);
 }
 
+SEASTAR_THREAD_TEST_CASE(test_loading_cache_value_ptr_cached) {
+    using namespace std::chrono;
+    load_count = 0;
+    utils::loading_cache<int, sstring> loading_cache(num_loaders, 100s, testlog);
+    auto stop_cache_reload = seastar::defer([&loading_cache] { loading_cache.stop().get(); });
+
+    prepare().get();
+
+    auto vp = loading_cache.get_ptr(0, loader).get0();
+    BOOST_REQUIRE(vp.cached());
+    vp.touch();
+    BOOST_REQUIRE(vp.cached());
+
+    loading_cache.remove(0);
+    BOOST_REQUIRE(!vp.cached());
+    BOOST_REQUIRE_EQUAL(*vp, test_string);
+
+    decltype(vp) null_vp = nullptr;
+    BOOST_REQUIRE(!null_vp.cached());
+}
+
 SEASTAR_TEST_CASE(test_loading_cache_loading_different_keys) {
     return seastar::async([] {
         using namespace std::chrono;
@@ -96,6 +96,44 @@ SEASTAR_TEST_CASE(test_compaction) {
     });
 }
 
+// Background defragmentation compacts the segments which are at most half
+// full, and leaves the objects in them intact.
+SEASTAR_THREAD_TEST_CASE(test_defragment) {
+    region reg;
+
+    with_allocator(reg.allocator(), [&reg] {
+        std::vector<managed_ref<int>> allocated;
+        for (int i = 0; i < 32 * 1024 * 8; i++) {
+            allocated.push_back(make_managed<int>(i));
+        }
+
+        // Leave every segment a quarter full.
+        for (size_t i = 0; i < allocated.size(); ++i) {
+            if (i % 4) {
+                allocated[i] = {};
+            }
+        }
+        auto before = reg.occupancy();
+        BOOST_REQUIRE_LE(before.used_fraction(), 0.5);
+
+        auto reclaim_counter = reg.reclaim_counter();
+        BOOST_REQUIRE(shard_tracker().defragment());
+        while (shard_tracker().defragment()) {
+        }
+        BOOST_REQUIRE(reg.reclaim_counter() != reclaim_counter);
+
+        auto after = reg.occupancy();
+        BOOST_REQUIRE_EQUAL(after.used_space(), before.used_space());
+        BOOST_REQUIRE_LT(after.total_space(), before.total_space());
+        BOOST_REQUIRE_GT(after.used_fraction(), 0.5);
+        for (size_t i = 0; i < allocated.size(); i += 4) {
+            BOOST_REQUIRE_EQUAL(*allocated[i], int(i));
+        }
+
+        allocated.clear();
+    });
+}
+
 SEASTAR_TEST_CASE(test_occupancy) {
     return seastar::async([] {
         region reg;
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/testing/thread_test_case.hh>
+
+#include "utils/lru.hh"
+#include "utils/frequency_sketch.hh"
+
+struct test_entry final : public evictable {
+    std::vector<int>& evicted;
+    int id;
+
+    test_entry(std::vector<int>& evicted, int id) : evicted(evicted), id(id) {}
+    ~test_entry() = default;
+
+    void on_evicted() noexcept override {
+        evicted.push_back(id);
+    }
+};
+
+static std::vector<std::unique_ptr<test_entry>> make_entries(lru& l, std::vector<int>& evicted, int first, int count) {
+    std::vector<std::unique_ptr<test_entry>> entries;
+    for (int i = first; i < first + count; ++i) {
+        entries.push_back(std::make_unique<test_entry>(evicted, i));
+        l.add(*entries.back());
+    }
+    return entries;
+}
+
+SEASTAR_THREAD_TEST_CASE(test_frequency_sketch) {
+    utils::frequency_sketch sketch(1024);
+
+    for (int i = 0; i < 5; ++i) {
+        sketch.increment(1);
+    }
+    sketch.increment(2);
+
+    BOOST_REQUIRE_GE(sketch.estimate(1), 5u);
+    BOOST_REQUIRE_GE(sketch.estimate(2), 1u);
+    BOOST_REQUIRE_LT(sketch.estimate(2), sketch.estimate(1));
+
+    // Counters saturate instead of overflowing.
+    for (int i = 0; i < 100; ++i) {
+        sketch.increment(3);
+    }
+    BOOST_REQUIRE_EQUAL(sketch.estimate(3), 15u);
+
+    // Enough additions halve all counters.
+    for (uint64_t i = 0; i < 1024 * 10; ++i) {
+        sketch.increment(1000 + i % 4096);
+    }
+    BOOST_REQUIRE_LE(sketch.estimate(3), 8u);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_lru_order_without_frequency_admission) {
+    lru l;
+    std::vector<int> evicted;
+    auto entries = make_entries(l, evicted, 0, 4);
+
+    l.touch(*entries[0]);
+    l.touch(*entries[0]);
+    l.evict_all();
+
+    BOOST_REQUIRE(evicted == std::vector<int>({1, 2, 3, 0}));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_lru_frequency_admission_resists_scans) {
+    lru l;
+    l.enable_frequency_admission(1024);
+    std::vector<int> evicted;
+
+    auto hot = make_entries(l, evicted, 0, 4);
+    for (auto& e : hot) {
+        l.touch(*e);
+        l.touch(*e);
+    }
+
+    // A scan adds entries which are touched once, after the hot ones.
+    auto scanned = make_entries(l, evicted, 100, 8);
+    for (auto& e : scanned) {
+        l.touch(*e);
+    }
+
+    for (size_t i = 0; i < scanned.size(); ++i) {
+        BOOST_REQUIRE(l.evict() == lru::reclaiming_result::reclaimed_something);
+    }
+    BOOST_REQUIRE(evicted == std::vector<int>({100, 101, 102, 103, 104, 105, 106, 107}));
+    for (auto& e : hot) {
+        BOOST_REQUIRE(e->is_linked());
+    }
+
+    // An entry in probation used more often than protected ones replaces them.
+    evicted.clear();
+    auto popular = make_entries(l, evicted, 200, 1);
+    for (int i = 0; i < 8; ++i) {
+        l.touch(*hot[0]);
+    }
+    for (int i = 0; i < 10; ++i) {
+        l.touch(*popular[0]);
+    }
+    popular[0]->unlink_from_lru();
+    l.add(*popular[0]);
+    BOOST_REQUIRE(l.evict() == lru::reclaiming_result::reclaimed_something);
+    BOOST_REQUIRE(evicted == std::vector<int>({1}));
+    BOOST_REQUIRE(popular[0]->is_linked());
+    BOOST_REQUIRE_EQUAL(l.admissions(), 1u);
+
+    l.evict_all();
+}
+
+SEASTAR_THREAD_TEST_CASE(test_lru_frequency_admission_demotes_aged_entries) {
+    lru l;
+    l.enable_frequency_admission(1024);
+    std::vector<int> evicted;
+
+    auto hot = make_entries(l, evicted, 0, 1);
+    l.touch(*hot[0]);
+    l.touch(*hot[0]);
+
+    // Enough uses of other entries age the sketch, so the once hot entry
+    // is no longer counted as frequent and goes back to probation.
+    auto others = make_entries(l, evicted, 100, 8);
+    for (int i = 0; i < 1300; ++i) {
+        for (auto& e : others) {
+            l.touch(*e);
+        }
+    }
+    BOOST_REQUIRE_EQUAL(l.demotions(), 1u);
+
+    BOOST_REQUIRE(l.evict() == lru::reclaiming_result::reclaimed_something);
+    BOOST_REQUIRE(evicted == std::vector<int>({0}));
+
+    l.evict_all();
+}
@@ -194,6 +194,27 @@ BOOST_AUTO_TEST_CASE(test_with_linearized) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(test_with_linearized_allocations) {
+    fragmenting_allocation_strategy fragmenting_allocator(alloc_size);
+    for (size_t size : {size_t(100), max_stack_linearization_size, max_stack_linearization_size + 1}) {
+        with_allocator(fragmenting_allocator, [&] {
+            auto b = tests::random::get_bytes(size);
+            auto m = managed_bytes(b);
+            auto stats_before = utils::get_linearization_stats();
+            m.with_linearized([&] (bytes_view bv) {
+                BOOST_CHECK_EQUAL(bv, b);
+            });
+            with_linearized(mbv(m), [&] (bytes_view bv) {
+                BOOST_CHECK_EQUAL(bv, b);
+            });
+            auto stats_after = utils::get_linearization_stats();
+            bool allocates = size > max_stack_linearization_size;
+            BOOST_CHECK_EQUAL(stats_after.linearizations - stats_before.linearizations, uint64_t(allocates ? 2 : 0));
+            BOOST_CHECK_EQUAL(stats_after.linearized_bytes - stats_before.linearized_bytes, uint64_t(allocates ? 2 * size : 0));
+        });
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_equality) {
     fragmenting_allocation_strategy alloc_1(alloc_size);
     fragmenting_allocation_strategy alloc_2(alloc_size + 1);
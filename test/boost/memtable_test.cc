@@ -196,6 +196,39 @@ SEASTAR_TEST_CASE(test_memtable_flush_reader) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_memtable_flush_reader_with_ranges) {
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    random_mutation_generator gen(random_mutation_generator::generate_counters::no);
+    replica::table_stats tbl_stats;
+    dirty_memory_manager mgr;
+
+    const auto muts = gen(8);
+    const auto now = gc_clock::now();
+    auto compacted_muts = muts;
+    for (auto& mut : compacted_muts) {
+        mut.partition().compact_for_compaction(*mut.schema(), always_gc, mut.decorated_key(), now);
+    }
+
+    auto mt = make_lw_shared<replica::memtable>(gen.schema(), mgr, tbl_stats);
+    for (auto& m : muts) {
+        mt->apply(m);
+    }
+
+    // Disjoint ranges covering the ring, read concurrently, as a split flush does.
+    auto split = dht::ring_position::starting_at(muts[4].token());
+    const auto left = dht::partition_range::make_ending_with({split, false});
+    const auto right = dht::partition_range::make_starting_with({split, true});
+
+    auto left_rd = assert_that(mt->make_flush_reader(gen.schema(), semaphore.make_permit(), default_priority_class(), left));
+    auto right_rd = assert_that(mt->make_flush_reader(gen.schema(), semaphore.make_permit(), default_priority_class(), right));
+    for (size_t i = 0; i < 4; ++i) {
+        left_rd.produces_compacted(compacted_muts[i], now);
+        right_rd.produces_compacted(compacted_muts[i + 4], now);
+    }
+    left_rd.produces_end_of_stream();
+    right_rd.produces_end_of_stream();
+}
+
 SEASTAR_TEST_CASE(test_adding_a_column_during_reading_doesnt_affect_read_result) {
     return seastar::async([] {
         auto common_builder = schema_builder("ks", "cf")
@@ -574,6 +607,82 @@ SEASTAR_THREAD_TEST_CASE(test_tombstone_compaction_during_flush) {
     mt->cleaner().drain().get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_appending_and_out_of_order_rows) {
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    simple_schema ss;
+    auto s = ss.schema();
+    auto mt = make_lw_shared<replica::memtable>(s);
+
+    auto pk = ss.make_pkey(0);
+    auto pr = dht::partition_range::make_singular(pk);
+    mutation expected(s, pk);
+
+    auto write = [&] (std::initializer_list<int> cks) {
+        mutation m(s, pk);
+        for (auto ck : cks) {
+            ss.add_row(m, ss.make_ckey(ck), format("v{}", ck));
+        }
+        mt->apply(m);
+        expected.apply(m);
+    };
+
+    write({1});
+    write({2, 3});
+    write({10});
+    // Out of order, and overlapping with the last row.
+    write({0, 5, 10});
+    write({4});
+    write({11, 12});
+
+    assert_that(mt->make_flat_reader(s, semaphore.make_permit(), pr))
+        .produces(expected)
+        .produces_end_of_stream();
+}
+
+SEASTAR_THREAD_TEST_CASE(test_applying_frozen_mutations) {
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    random_mutation_generator gen(random_mutation_generator::generate_counters::no);
+    auto s = gen.schema();
+    auto mt = make_lw_shared<replica::memtable>(s);
+    auto unfrozen_mt = make_lw_shared<replica::memtable>(s);
+
+    auto pk = gen().decorated_key();
+    auto pr = dht::partition_range::make_singular(pk);
+    mutation expected(s, pk);
+
+    std::vector<flat_mutation_reader_v2> readers;
+    auto close_readers = defer([&] {
+        for (auto& rd : readers) {
+            rd.close().get();
+        }
+    });
+
+    for (int i = 0; i < 10; ++i) {
+        mutation m(s, pk, std::move(gen().partition()));
+        mt->apply(freeze(m), s);
+        unfrozen_mt->apply(m);
+        expected.apply(m);
+        // A snapshot of the latest version makes the next write create a new
+        // version instead of merging into it.
+        if (i % 2) {
+            auto rd = mt->make_flat_reader(s, semaphore.make_permit(), pr);
+            rd.set_max_buffer_size(1);
+            rd.fill_buffer().get();
+            readers.push_back(std::move(rd));
+        }
+    }
+
+    assert_that(mt->make_flat_reader(s, semaphore.make_permit(), pr))
+        .produces(expected)
+        .produces_end_of_stream();
+
+    auto stats = mt->get_encoding_stats();
+    auto unfrozen_stats = unfrozen_mt->get_encoding_stats();
+    BOOST_REQUIRE_EQUAL(stats.min_timestamp, unfrozen_stats.min_timestamp);
+    BOOST_REQUIRE(stats.min_local_deletion_time == unfrozen_stats.min_local_deletion_time);
+    BOOST_REQUIRE(stats.min_ttl == unfrozen_stats.min_ttl);
+}
+
 SEASTAR_THREAD_TEST_CASE(test_tombstone_merging_with_multiple_versions) {
     tests::reader_concurrency_semaphore_wrapper semaphore;
     simple_schema ss;
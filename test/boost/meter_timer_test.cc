@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <seastar/testing/thread_test_case.hh>
+
+#include "utils/histogram.hh"
+
+SEASTAR_THREAD_TEST_CASE(test_meter_registration) {
+    auto base = meter_timer::registered();
+    int ticks = 0;
+    {
+        auto a = std::make_unique<meter_timer>([&] { ++ticks; });
+        BOOST_REQUIRE_EQUAL(meter_timer::registered(), base + 1);
+        BOOST_REQUIRE(meter_timer::armed());
+
+        // The moved-to meter takes over the handler, the moved-from one
+        // stays registered until destroyed, but doesn't tick.
+        auto b = std::make_unique<meter_timer>(std::move(*a));
+        BOOST_REQUIRE_EQUAL(meter_timer::registered(), base + 2);
+        meter_timer::tick().get();
+        BOOST_REQUIRE_EQUAL(ticks, 1);
+
+        a.reset();
+        BOOST_REQUIRE_EQUAL(meter_timer::registered(), base + 1);
+        meter_timer::tick().get();
+        BOOST_REQUIRE_EQUAL(ticks, 2);
+    }
+    BOOST_REQUIRE_EQUAL(meter_timer::registered(), base);
+    if (base == 0) {
+        BOOST_REQUIRE(!meter_timer::armed());
+    }
+    meter_timer::tick().get();
+    BOOST_REQUIRE_EQUAL(ticks, 2);
+}
+
+// Meters may come and go while a tick is preempted. Each of those which
+// stay registered is ticked exactly once.
+SEASTAR_THREAD_TEST_CASE(test_meters_change_during_tick) {
+    constexpr size_t count = 100000;
+    std::vector<std::unique_ptr<meter_timer>> meters;
+    std::vector<int> ticks(count * 2);
+    for (size_t i = 0; i < count; ++i) {
+        meters.push_back(std::make_unique<meter_timer>([&ticks, i] {
+            ++ticks[i];
+            for (volatile int j = 0; j < 100; j = j + 1) {}
+        }));
+    }
+
+    auto f = meter_timer::tick();
+    bool preempted = !f.available();
+    BOOST_TEST_MESSAGE(format("the tick was preempted: {}", preempted));
+    // Remove every other meter, and add as many new ones.
+    for (size_t i = 0; i < count; i += 2) {
+        meters[i].reset();
+        meters.push_back(std::make_unique<meter_timer>([&ticks, i] { ++ticks[count + i]; }));
+    }
+    if (preempted) {
+        // Another tick while the first one is in progress does nothing.
+        meter_timer::tick().get();
+    }
+    f.get();
+
+    for (size_t i = 0; i < count; ++i) {
+        if (meters[i]) {
+            BOOST_REQUIRE_EQUAL(ticks[i], 1);
+        } else {
+            BOOST_REQUIRE_LE(ticks[i], 1);
+        }
+    }
+    for (size_t i = count; i < ticks.size(); ++i) {
+        BOOST_REQUIRE_LE(ticks[i], 1);
+    }
+
+    meters.clear();
+    meter_timer::tick().get();
+    BOOST_REQUIRE_EQUAL(ticks[1], 1);
+}
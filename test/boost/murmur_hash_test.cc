@@ -107,5 +107,22 @@ BOOST_AUTO_TEST_CASE(test_hash_output) {
             utils::murmur_hash::hash3_x64_128(prefix.begin(), prefix.size(), seed, dst);
             assert_hashes_equal(prefix, dst, expected);
         }
+
+        // Test the incremental version, with the data split at every position
+        for (size_t split = 0; split <= prefix.size(); ++split) {
+            utils::murmur_hash::hash3_x64_128_state state(seed);
+            state.update(prefix.substr(0, split));
+            state.update(prefix.substr(split));
+            assert_hashes_equal(prefix, state.finalize(), expected);
+        }
+
+        // ...and byte by byte
+        {
+            utils::murmur_hash::hash3_x64_128_state state(seed);
+            for (size_t j = 0; j < prefix.size(); ++j) {
+                state.update(prefix.substr(j, 1));
+            }
+            assert_hashes_equal(prefix, state.finalize(), expected);
+        }
     }
 }
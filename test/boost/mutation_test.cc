@@ -1797,6 +1797,44 @@ SEASTAR_TEST_CASE(test_collection_cell_diff) {
     });
 }
 
+// Merging collections whose keys don't overlap copies the cells without
+// deserializing them, check that this gives the same as the general merge.
+SEASTAR_THREAD_TEST_CASE(test_collection_merge) {
+    auto type = map_type_impl::get_instance(int32_type, int32_type, true);
+    auto key = [] (int32_t k) { return int32_type->decompose(k); };
+    auto make = [&] (tombstone tomb, std::vector<std::pair<int32_t, api::timestamp_type>> cells) {
+        collection_mutation_description m;
+        m.tomb = tomb;
+        for (auto [k, ts] : cells) {
+            m.cells.emplace_back(key(k), atomic_cell::make_live(*int32_type, ts, int32_type->decompose(k * 10)));
+        }
+        return m.serialize(*type);
+    };
+    auto check = [&] (const collection_mutation& a, const collection_mutation& b, const collection_mutation& expected) {
+        for (auto [x, y] : {std::pair(&a, &b), std::pair(&b, &a)}) {
+            auto merged = merge(*type, *x, *y);
+            BOOST_REQUIRE_EQUAL(to_bytes(collection_mutation_view(merged).data), to_bytes(collection_mutation_view(expected).data));
+        }
+    };
+    auto t1 = tombstone(api::timestamp_type(1), gc_clock::now());
+    auto t5 = tombstone(api::timestamp_type(5), gc_clock::now());
+
+    // Appending, in either order.
+    check(make({}, {{1, 2}, {2, 2}}), make({}, {{3, 3}, {4, 3}}), make({}, {{1, 2}, {2, 2}, {3, 3}, {4, 3}}));
+    check(make({}, {}), make({}, {{3, 3}}), make({}, {{3, 3}}));
+    check(make({}, {}), make({}, {}), make({}, {}));
+    check(make(t1, {{1, 2}}), make({}, {{3, 3}}), make(t1, {{1, 2}, {3, 3}}));
+    check(make(t1, {}), make(t5, {{3, 6}}), make(t5, {{3, 6}}));
+
+    // Overlapping keys.
+    check(make({}, {{1, 2}, {3, 2}}), make({}, {{2, 3}, {4, 3}}), make({}, {{1, 2}, {2, 3}, {3, 2}, {4, 3}}));
+    check(make({}, {{1, 2}, {3, 2}}), make({}, {{3, 3}}), make({}, {{1, 2}, {3, 3}}));
+
+    // A tombstone which kills cells of the other side.
+    check(make(t5, {{3, 6}}), make({}, {{1, 2}}), make(t5, {{3, 6}}));
+    check(make(t5, {}), make({}, {{1, 5}, {2, 6}}), make(t5, {{2, 6}}));
+}
+
 SEASTAR_TEST_CASE(test_apply_is_commutative) {
     return seastar::async([] {
         for_each_mutation_pair([] (auto&& m1, auto&& m2, are_equal eq) {
@@ -20,6 +20,7 @@
 #include "mutation_writer/multishard_writer.hh"
 #include "mutation_writer/timestamp_based_splitting_writer.hh"
 #include "mutation_writer/partition_based_splitting_writer.hh"
+#include "mutation_writer/size_based_splitting_writer.hh"
 #include "test/lib/cql_test_env.hh"
 #include "test/lib/flat_mutation_reader_assertions.hh"
 #include "test/lib/mutation_assertions.hh"
@@ -522,3 +523,61 @@ SEASTAR_THREAD_TEST_CASE(test_partition_based_splitting_mutation_writer) {
     }
 
 }
+
+SEASTAR_THREAD_TEST_CASE(test_size_based_splitting_mutation_writer) {
+    tests::reader_concurrency_semaphore_wrapper semaphore;
+    auto random_spec = tests::make_random_schema_specification(
+            get_name(),
+            std::uniform_int_distribution<size_t>(1, 2),
+            std::uniform_int_distribution<size_t>(0, 2),
+            std::uniform_int_distribution<size_t>(1, 2),
+            std::uniform_int_distribution<size_t>(0, 1));
+
+    auto random_schema = tests::random_schema{tests::random::get_int<uint32_t>(), *random_spec};
+
+    const auto input_mutations = tests::generate_random_mutations(
+            random_schema,
+            tests::default_timestamp_generator(),
+            tests::no_expiry_expiry_generator(),
+            std::uniform_int_distribution<size_t>(10, 100), // partitions
+            std::uniform_int_distribution<size_t>(1, 4), // rows
+            std::uniform_int_distribution<size_t>(0, 1)).get(); // range tombstones
+
+    std::vector<std::vector<mutation>> output_mutations;
+
+    auto consumer = [&] (flat_mutation_reader_v2 rd) {
+        output_mutations.emplace_back();
+        return async([&, index = output_mutations.size() - 1, rd = std::move(rd)] () mutable {
+            auto close_rd = deferred_close(rd);
+            while (auto mut_opt = read_mutation_from_flat_mutation_reader(rd).get0()) {
+                output_mutations[index].emplace_back(std::move(*mut_opt));
+            }
+        });
+    };
+
+    auto split = [&] (uint64_t max_size) {
+        output_mutations.clear();
+        mutation_writer::split_by_size(
+                make_flat_mutation_reader_from_mutations_v2(random_schema.schema(), semaphore.make_permit(), input_mutations),
+                max_size,
+                consumer).get();
+        testlog.info("Split {} partitions into {} streams (max_size={})", input_mutations.size(), output_mutations.size(), max_size);
+
+        // The streams are consecutive runs of the input.
+        std::vector<mutation> concatenated;
+        for (auto& muts : output_mutations) {
+            BOOST_REQUIRE(!muts.empty());
+            std::move(muts.begin(), muts.end(), std::back_inserter(concatenated));
+        }
+        BOOST_REQUIRE_EQUAL(concatenated.size(), input_mutations.size());
+        for (size_t i = 0; i < concatenated.size(); ++i) {
+            assert_that(concatenated[i]).is_equal_to(input_mutations[i]);
+        }
+    };
+
+    split(1);
+    BOOST_REQUIRE_EQUAL(output_mutations.size(), input_mutations.size());
+    split(10'000);
+    split(std::numeric_limits<uint64_t>::max());
+    BOOST_REQUIRE_EQUAL(output_mutations.size(), 1);
+}
@@ -11,6 +11,7 @@
 #include "utils/fb_utilities.hh"
 #include "utils/sequenced_set.hh"
 #include "locator/network_topology_strategy.hh"
+#include "locator/replica_lookup_table.hh"
 #include <seastar/testing/test_case.hh>
 #include <seastar/testing/thread_test_case.hh>
 #include <seastar/core/sstring.hh>
@@ -626,6 +627,37 @@ SEASTAR_THREAD_TEST_CASE(testCalculateEndpoints) {
     }
 }
 
+SEASTAR_THREAD_TEST_CASE(test_replica_lookup_table) {
+    for (size_t n = 1; n <= 40; ++n) {
+        std::set<token> token_set;
+        while (token_set.size() < n) {
+            token_set.insert(token(dht::token::kind::key, tests::random::get_int<int64_t>(-1000, 1000)));
+        }
+        std::vector<token> sorted_tokens(token_set.begin(), token_set.end());
+        replication_map rmap;
+        for (size_t i = 0; i < n; ++i) {
+            rmap.emplace(sorted_tokens[i], inet_address_vector_replica_set{inet_address(int32_t(i + 1))});
+        }
+        auto table = replica_lookup_table::build(sorted_tokens, rmap).get0();
+        BOOST_REQUIRE(!table.empty());
+
+        auto check = [&] (const token& t) {
+            auto it = std::lower_bound(sorted_tokens.begin(), sorted_tokens.end(), t);
+            auto& expected = rmap.at(it == sorted_tokens.end() ? sorted_tokens.front() : *it);
+            BOOST_REQUIRE(table.get(t) == expected);
+        };
+        check(dht::minimum_token());
+        check(dht::maximum_token());
+        for (auto& t : sorted_tokens) {
+            check(t);
+        }
+        for (int64_t v = -1001; v <= 1001; ++v) {
+            check(token(dht::token::kind::key, v));
+        }
+    }
+    BOOST_REQUIRE(replica_lookup_table::build({}, {}).get0().empty());
+}
+
 SEASTAR_TEST_CASE(test_invalid_dcs) {
     return do_with_cql_env_thread([] (auto& e) {
         for (auto& incorrect : std::vector<std::string>{"3\"", "", "!!!", "abcb", "!3", "-5", "0x123", "999999999999999999999999999999"}) {
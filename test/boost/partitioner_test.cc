@@ -17,6 +17,8 @@
 #include "types.hh"
 #include "schema_builder.hh"
 #include "utils/div_ceil.hh"
+#include "utils/murmur_hash.hh"
+#include "compound_compat.hh"
 
 #include "test/lib/simple_schema.hh"
 #include "test/lib/log.hh"
@@ -55,6 +57,32 @@ SEASTAR_THREAD_TEST_CASE(test_decorated_key_is_compatible_with_origin) {
     BOOST_REQUIRE(dk._key.equal(*s, key));
 }
 
+// get_token() hashes the legacy form without materializing it.
+SEASTAR_THREAD_TEST_CASE(test_murmur3_token_of_legacy_form) {
+    auto singular = schema_builder("ks", "cf")
+        .with_column("pk", utf8_type, column_kind::partition_key)
+        .build();
+    auto compound = schema_builder("ks", "cf")
+        .with_column("pk1", utf8_type, column_kind::partition_key)
+        .with_column("pk2", bytes_type, column_kind::partition_key)
+        .build();
+
+    dht::murmur3_partitioner partitioner;
+    auto check = [&] (const schema& s, const partition_key& key) {
+        std::array<uint64_t, 2> hash;
+        utils::murmur_hash::hash3_x64_128(to_legacy(*s.partition_key_type(), key.representation()), 0, hash);
+        BOOST_REQUIRE_EQUAL(partitioner.get_token(s, key), token_from_long(hash[0]));
+    };
+    for (size_t len1 : {0, 1, 7, 13, 14, 15, 16, 17, 31, 100}) {
+        auto v1 = utf8_type->decompose(sstring(len1, 'a'));
+        check(*singular, partition_key::from_single_value(*singular, v1));
+        for (size_t len2 : {0, 1, 2, 16, 33}) {
+            auto v2 = bytes(len2, int8_t(0xf0));
+            check(*compound, partition_key::from_exploded(*compound, {v1, v2}));
+        }
+    }
+}
+
 SEASTAR_THREAD_TEST_CASE(test_token_wraparound_1) {
     auto t1 = token_from_long(0x7000'0000'0000'0000);
     auto t2 = token_from_long(0xa000'0000'0000'0000);
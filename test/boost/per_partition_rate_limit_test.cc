@@ -106,4 +106,72 @@ SEASTAR_TEST_CASE(test_internal_operation_filtering) {
 
         return make_ready_future<>();
     });
-}
\ No newline at end of file
+}
+
+SEASTAR_TEST_CASE(test_non_replica_coordinator_rejects_writes_only) {
+    return do_with_cql_env_thread([] (cql_test_env& e) -> future<> {
+        // The coordinator is only not a replica on a foreign shard
+        BOOST_REQUIRE_GT(smp::count, 1);
+
+        cquery_nofail(e, "CREATE TABLE ks.tbl (pk int PRIMARY KEY) \
+                WITH per_partition_rate_limit = {'max_reads_per_second': 1, 'max_writes_per_second': 1}");
+
+        auto& db = e.db();
+        auto& qp = e.qp();
+        const auto sptr = db.local().find_schema("ks", "tbl");
+        auto pk = partition_key::from_singular(*sptr, int32_t(0));
+        unsigned foreign_shard = (dht::shard_of(*sptr, dht::get_token(*sptr, pk.view())) + 1) % smp::count;
+        auto sgroups = get_scheduling_groups().get();
+
+        smp::submit_to(foreign_shard, [&] {
+            return seastar::async(thread_attributes{sgroups.statement_scheduling_group}, [&] {
+                const auto sptr = db.local().find_schema("ks", "tbl");
+                auto m = mutation(sptr, partition_key(pk));
+                auto dk = dht::decorate_key(*sptr, partition_key(pk));
+                auto selection = cql3::selection::selection::for_columns(sptr, {sptr->get_column_definition("pk")});
+                auto cmd = make_lw_shared<query::read_command>(sptr->id(), sptr->version(),
+                        query::partition_slice({query::clustering_range::make_open_ended_both_sides()}, {}, {}, selection->get_query_options()),
+                        query::max_result_size(1), query::row_limit(1));
+                cmd->allow_limit = db::allow_per_partition_rate_limit::yes;
+
+                unsigned writes_rejected_by_coordinator = 0;
+                unsigned reads_rejected_by_coordinator = 0;
+                unsigned reads_rejected_by_replica = 0;
+                // Rejection is probabilistic, so try many times
+                for (int i = 0; i < 100; i++) {
+                    try {
+                        qp.local().proxy().mutate({m},
+                                db::consistency_level::ALL,
+                                service::storage_proxy::clock_type::now() + std::chrono::seconds(10),
+                                nullptr,
+                                empty_service_permit(),
+                                db::allow_per_partition_rate_limit::yes).get();
+                    } catch (exceptions::rate_limit_exception& ex) {
+                        writes_rejected_by_coordinator += ex.rejected_by_coordinator;
+                    }
+                    try {
+                        qp.local().proxy().query(sptr,
+                                cmd,
+                                {dht::partition_range(dk)},
+                                db::consistency_level::ALL,
+                                service::storage_proxy::coordinator_query_options(
+                                        db::timeout_clock::now() + std::chrono::seconds(10),
+                                        empty_service_permit(),
+                                        service::client_state::for_internal_calls())).get();
+                    } catch (exceptions::rate_limit_exception& ex) {
+                        reads_rejected_by_coordinator += ex.rejected_by_coordinator;
+                        reads_rejected_by_replica += !ex.rejected_by_coordinator;
+                    }
+                }
+
+                BOOST_REQUIRE_GT(writes_rejected_by_coordinator, 0);
+                // Reads are left to replicas, which see only a share of
+                // them below CL=ALL.
+                BOOST_REQUIRE_EQUAL(reads_rejected_by_coordinator, 0);
+                BOOST_REQUIRE_GT(reads_rejected_by_replica, 0);
+            });
+        }).get();
+
+        return make_ready_future<>();
+    });
+}
@@ -187,6 +187,14 @@ class test_querier_cache {
         return _sem;
     }
 
+    const query::querier_cache::stats& get_cache_stats() const {
+        return _cache.get_stats();
+    }
+
+    query::querier_cache& get_cache() {
+        return _cache;
+    }
+
     dht::partition_range make_partition_range(bound begin, bound end) const {
         return dht::partition_range::make({_mutations.at(begin.value()).decorated_key(), begin.is_inclusive()},
                 {_mutations.at(end.value()).decorated_key(), end.is_inclusive()});
@@ -747,6 +755,50 @@ SEASTAR_THREAD_TEST_CASE(test_immediate_evict_on_insert) {
     fut.get();
 }
 
+SEASTAR_THREAD_TEST_CASE(test_resume_state_kept_on_resource_based_eviction) {
+    test_querier_cache t;
+
+    auto& sem = t.get_semaphore();
+    auto permit1 = sem.obtain_permit(t.get_schema().get(), get_name(), 0, db::no_timeout).get0();
+    auto resources = permit1.consume_resources(reader_resources(sem.available_resources().count, 0));
+    auto fut = sem.obtain_permit(t.get_schema().get(), get_name(), 1, db::no_timeout);
+
+    const auto entry = t.produce_first_page_and_save_data_querier();
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().resume_states, 1);
+
+    t.assert_cache_lookup_data_querier(entry.key, *t.get_schema(), entry.expected_range, entry.expected_slice)
+        .misses()
+        .no_drops()
+        .resource_based_evictions();
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().resume_state_hits, 1);
+
+    resources.reset();
+    fut.get();
+
+    // Inserting the querier of the next page drops the state.
+    t.produce_first_page_and_save_data_querier(entry.key);
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().resume_states, 0);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_resume_state_dropped_with_read) {
+    test_querier_cache t;
+
+    auto& sem = t.get_semaphore();
+    auto permit1 = sem.obtain_permit(t.get_schema().get(), get_name(), 0, db::no_timeout).get0();
+    auto resources = permit1.consume_resources(reader_resources(sem.available_resources().count, 0));
+    auto fut = sem.obtain_permit(t.get_schema().get(), get_name(), 1, db::no_timeout);
+
+    const auto entry = t.produce_first_page_and_save_data_querier();
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().resume_states, 1);
+
+    resources.reset();
+    fut.get();
+
+    // The last page of the read doesn't insert a querier, but the read is over.
+    t.get_cache().drop_resume_states(entry.key);
+    BOOST_REQUIRE_EQUAL(t.get_cache_stats().resume_states, 0);
+}
+
 SEASTAR_THREAD_TEST_CASE(test_unique_inactive_read_handle) {
     reader_concurrency_semaphore sem1(reader_concurrency_semaphore::no_limits{}, "sem1");
     auto stop_sem1 = deferred_stop(sem1);
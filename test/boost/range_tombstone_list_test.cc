@@ -913,6 +913,43 @@ BOOST_AUTO_TEST_CASE(test_exception_safety) {
     });
 }
 
+// apply_monotonically() of an rvalue list moves the entries which don't touch
+// any existing tombstone instead of applying them, check that it ends up with
+// the same list.
+BOOST_AUTO_TEST_CASE(test_apply_monotonically_moves_disjoint_entries) {
+    std::mt19937 gen(std::random_device{}());
+    auto random_list = [&] (int n) {
+        range_tombstone_list list(*s);
+        std::uniform_int_distribution<int32_t> pos(0, 40);
+        std::uniform_int_distribution<int> kind(0, 3);
+        std::uniform_int_distribution<api::timestamp_type> ts(0, 2);
+        for (int i = 0; i < n; ++i) {
+            auto start = pos(gen);
+            auto end = start + pos(gen) % 4 + 1;
+            switch (kind(gen)) {
+            case 0: list.apply(*s, rt(start, end, ts(gen))); break;
+            case 1: list.apply(*s, rtie(start, end, ts(gen))); break;
+            case 2: list.apply(*s, rtei(start, end, ts(gen))); break;
+            default: list.apply(*s, rtee(start, end, ts(gen))); break;
+            }
+        }
+        return list;
+    };
+
+    for (int i = 0; i < 1000; ++i) {
+        auto a = random_list(std::uniform_int_distribution<int>(0, 6)(gen));
+        auto b = random_list(std::uniform_int_distribution<int>(0, 6)(gen));
+
+        auto expected = a;
+        expected.apply(*s, b);
+
+        auto b_copy = b;
+        a.apply_monotonically(*s, std::move(b_copy));
+        assert_that(*s, a).is_equal_to(expected);
+        BOOST_REQUIRE(b_copy.empty());
+    }
+}
+
 BOOST_AUTO_TEST_CASE(test_accumulator) {
     auto ts1 = 1;
     auto ts2 = 2;
@@ -13,6 +13,7 @@
 #include "test/lib/random_schema.hh"
 
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/sleep.hh>
 #include <seastar/testing/test_case.hh>
 #include <seastar/testing/thread_test_case.hh>
 #include <boost/test/unit_test.hpp>
@@ -522,6 +523,52 @@ SEASTAR_TEST_CASE(reader_concurrency_semaphore_max_queue_length) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_sheds_reads_expected_to_time_out) {
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 1, replica::new_reader_base_cost);
+    auto stop_sem = deferred_stop(semaphore);
+
+    reader_permit_opt permit = semaphore.obtain_permit(nullptr, "initial", replica::new_reader_base_cost, db::no_timeout).get();
+
+    // Make the next read wait long in the queue, to raise the queue time estimate.
+    auto slow_fut = semaphore.obtain_permit(nullptr, "slow", replica::new_reader_base_cost, db::no_timeout);
+    seastar::sleep(std::chrono::milliseconds(100)).get();
+    permit = {};
+    permit = slow_fut.get();
+
+    // The first read in the queue is never shed...
+    auto first_fut = semaphore.obtain_permit(nullptr, "first", replica::new_reader_base_cost, db::timeout_clock::now() + std::chrono::milliseconds(1));
+    BOOST_REQUIRE_EQUAL(semaphore.waiters(), 1);
+
+    // ... but one behind it with a timeout sooner than the estimate is.
+    auto doomed_fut = semaphore.obtain_permit(nullptr, "doomed", replica::new_reader_base_cost, db::timeout_clock::now() + std::chrono::milliseconds(1));
+    BOOST_REQUIRE(doomed_fut.failed());
+    BOOST_REQUIRE_THROW(doomed_fut.get(), semaphore_timed_out);
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().total_reads_shed_due_to_timeout, 1);
+
+    // Reads with a longer timeout are queued as usual.
+    auto patient_fut = semaphore.obtain_permit(nullptr, "patient", replica::new_reader_base_cost, db::timeout_clock::now() + std::chrono::minutes(1));
+    BOOST_REQUIRE_EQUAL(semaphore.waiters(), 2);
+
+    permit = {};
+    BOOST_REQUIRE(eventually_true([&] { return first_fut.available(); }));
+    first_fut.ignore_ready_future();
+    BOOST_REQUIRE(eventually_true([&] { return patient_fut.available(); }));
+    permit = patient_fut.get();
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().total_reads_shed_due_to_timeout, 1);
+
+    // With shedding disabled, such reads wait in the queue until they time out.
+    semaphore.set_shed_reads_expected_to_time_out(utils::updateable_value<bool>(false));
+    auto waiting_fut = semaphore.obtain_permit(nullptr, "waiting", replica::new_reader_base_cost, db::no_timeout);
+    auto late_fut = semaphore.obtain_permit(nullptr, "late", replica::new_reader_base_cost, db::timeout_clock::now() + std::chrono::milliseconds(1));
+    BOOST_REQUIRE(!late_fut.failed());
+    BOOST_REQUIRE_THROW(late_fut.get(), semaphore_timed_out);
+    BOOST_REQUIRE_EQUAL(semaphore.get_stats().total_reads_shed_due_to_timeout, 1);
+
+    permit = {};
+    permit = waiting_fut.get();
+    permit = {};
+}
+
 SEASTAR_THREAD_TEST_CASE(reader_concurrency_semaphore_dump_reader_diganostics) {
     reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::no_limits{}, get_name());
     auto stop_sem = deferred_stop(semaphore);
@@ -957,3 +1004,70 @@ SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_evict_inactive_reads_
         handles.clear();
     }
 }
+
+SEASTAR_THREAD_TEST_CASE(test_reader_concurrency_semaphore_cheap_reads_fast_lane) {
+    using read_class = reader_concurrency_semaphore::read_class;
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), 1, replica::new_reader_base_cost);
+    auto stop_sem = deferred_stop(semaphore);
+
+    reader_permit_opt permit = semaphore.obtain_permit(nullptr, "initial", replica::new_reader_base_cost, db::no_timeout).get();
+
+    auto normal_fut = semaphore.obtain_permit(nullptr, "normal", replica::new_reader_base_cost, db::no_timeout);
+    std::vector<future<reader_permit>> cheap_futs;
+    for (unsigned i = 0; i < reader_concurrency_semaphore::max_cheap_admissions_in_row + 1; ++i) {
+        cheap_futs.push_back(semaphore.obtain_permit(nullptr, "cheap", replica::new_reader_base_cost, db::no_timeout, read_class::cheap));
+    }
+    BOOST_REQUIRE_EQUAL(semaphore.waiters(), cheap_futs.size() + 1);
+
+    // Cheap reads are admitted ahead of the normal read queued before them...
+    for (unsigned i = 0; i < reader_concurrency_semaphore::max_cheap_admissions_in_row; ++i) {
+        permit = {};
+        permit = cheap_futs[i].get();
+        BOOST_REQUIRE(!normal_fut.available());
+    }
+
+    // ... but not indefinitely.
+    permit = {};
+    permit = normal_fut.get();
+    BOOST_REQUIRE(!cheap_futs.back().available());
+    permit = {};
+    permit = cheap_futs.back().get();
+    permit = {};
+
+    const auto& stats = semaphore.get_stats();
+    BOOST_REQUIRE_EQUAL(stats.cheap_reads_dequeued, cheap_futs.size());
+    BOOST_REQUIRE_EQUAL(stats.normal_reads_dequeued, 1);
+}
+
+SEASTAR_THREAD_TEST_CASE(test_reader_permit_fragment_storage_reuse) {
+    simple_schema s;
+    const auto initial_resources = reader_concurrency_semaphore::resources{10, 1024 * 1024};
+    reader_concurrency_semaphore semaphore(reader_concurrency_semaphore::for_tests{}, get_name(), initial_resources.count, initial_resources.memory);
+    auto stop_sem = deferred_stop(semaphore);
+
+    const size_t size = 64;
+    {
+        auto permit = semaphore.make_tracking_only_permit(s.schema().get(), get_name(), db::no_timeout);
+
+        auto* p = permit.allocate_fragment_storage(size);
+        permit.free_fragment_storage(p, size);
+        // The free block is charged to the permit.
+        BOOST_REQUIRE_EQUAL(permit.consumed_resources().memory, ssize_t(size));
+
+        BOOST_REQUIRE_EQUAL(permit.allocate_fragment_storage(size), p);
+        permit.free_fragment_storage(p, size);
+        BOOST_REQUIRE_EQUAL(permit.consumed_resources().memory, ssize_t(size));
+    }
+    BOOST_REQUIRE_EQUAL(semaphore.available_resources(), initial_resources);
+
+    // Eviction drops the free list.
+    {
+        auto permit = semaphore.make_tracking_only_permit(s.schema().get(), get_name(), db::no_timeout);
+        permit.free_fragment_storage(permit.allocate_fragment_storage(size), size);
+
+        auto handle = semaphore.register_inactive_read(make_empty_flat_reader_v2(s.schema(), permit));
+        BOOST_REQUIRE(semaphore.try_evict_one_inactive_read());
+        BOOST_REQUIRE_EQUAL(permit.consumed_resources().memory, 0);
+    }
+    BOOST_REQUIRE_EQUAL(semaphore.available_resources(), initial_resources);
+}
@@ -132,3 +132,29 @@ SEASTAR_TEST_CASE(flush_repair_rows_on_wire_to_sstable) {
     });
 }
 
+SEASTAR_TEST_CASE(test_tracker_range_parallelism) {
+    tracker t(4 * 4 * tracker::max_repair_memory_per_range());
+    auto& sem = t.range_parallelism_semaphore();
+    BOOST_REQUIRE_EQUAL(t.max_range_parallelism(), 4);
+    BOOST_REQUIRE_EQUAL(t.range_parallelism(), 4);
+
+    t.set_range_parallelism(2);
+    BOOST_REQUIRE_EQUAL(t.range_parallelism(), 2);
+    BOOST_REQUIRE_EQUAL(sem.available_units(), 2);
+
+    // Never below one range, nor above the limit given by the memory.
+    t.set_range_parallelism(0);
+    BOOST_REQUIRE_EQUAL(t.range_parallelism(), 1);
+    BOOST_REQUIRE_EQUAL(sem.available_units(), 1);
+    t.set_range_parallelism(10);
+    BOOST_REQUIRE_EQUAL(t.range_parallelism(), 4);
+    BOOST_REQUIRE_EQUAL(sem.available_units(), 4);
+
+    // Ranges being repaired keep their units.
+    auto units = consume_units(sem, 3);
+    t.set_range_parallelism(2);
+    BOOST_REQUIRE_EQUAL(sem.available_units(), -1);
+    units.return_all();
+    BOOST_REQUIRE_EQUAL(sem.available_units(), 2);
+    return make_ready_future<>();
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <seastar/testing/thread_test_case.hh>
+
+#include "service/replica_latency_tracker.hh"
+
+using namespace std::chrono_literals;
+
+static const gms::inet_address a("127.0.0.1");
+static const gms::inet_address b("127.0.0.2");
+static const gms::inet_address c("127.0.0.3");
+static const gms::inet_address d("127.0.0.4");
+
+static sstring one_dc(gms::inet_address) {
+    return "dc1";
+}
+
+SEASTAR_THREAD_TEST_CASE(test_replica_latency_tracker_score) {
+    service::replica_latency_tracker t;
+    BOOST_REQUIRE_EQUAL(t.score(a), 0);
+    t.add(a, 1000us);
+    BOOST_REQUIRE_EQUAL(t.score(a), 1000);
+    t.add(a, 2000us);
+    BOOST_REQUIRE_GT(t.score(a), 1000);
+    BOOST_REQUIRE_LT(t.score(a), 2000);
+
+    BOOST_REQUIRE(!t.percentile(a, 0.99));
+    for (int i = 0; i < service::replica_latency_tracker::min_samples; ++i) {
+        t.add(a, 1000us);
+    }
+    auto p = t.percentile(a, 0.5);
+    BOOST_REQUIRE(p);
+    BOOST_REQUIRE_GE(*p, 1000us);
+    BOOST_REQUIRE_LT(*p, 2000us);
+
+    t.maybe_reset(0ms);
+    BOOST_REQUIRE_EQUAL(t.score(a), 0);
+    BOOST_REQUIRE(!t.percentile(a, 0.5));
+}
+
+SEASTAR_THREAD_TEST_CASE(test_replica_latency_tracker_sort) {
+    service::replica_latency_tracker t;
+    t.add(a, 1000us);
+    t.add(b, 1100us);
+    t.add(c, 5000us);
+
+    // Within the badness threshold the order is kept.
+    inet_address_vector_replica_set eps{b, a};
+    BOOST_REQUIRE(!t.sort(eps, 0.2, one_dc));
+    BOOST_REQUIRE(eps == inet_address_vector_replica_set({b, a}));
+
+    eps = {c, b, a};
+    BOOST_REQUIRE(t.sort(eps, 0.2, one_dc));
+    BOOST_REQUIRE(eps == inet_address_vector_replica_set({a, b, c}));
+
+    // Replicas without a score go first.
+    eps = {c, d};
+    BOOST_REQUIRE(t.sort(eps, 0.2, one_dc));
+    BOOST_REQUIRE(eps == inet_address_vector_replica_set({d, c}));
+
+    // Datacenters are not reordered.
+    auto two_dcs = [] (gms::inet_address ep) -> sstring {
+        return ep == c || ep == a ? "dc1" : "dc2";
+    };
+    eps = {c, a, b};
+    BOOST_REQUIRE(t.sort(eps, 0.2, two_dcs));
+    BOOST_REQUIRE(eps == inet_address_vector_replica_set({a, c, b}));
+    eps = {c, b};
+    BOOST_REQUIRE(!t.sort(eps, 0.2, two_dcs));
+    BOOST_REQUIRE(eps == inet_address_vector_replica_set({c, b}));
+}
@@ -1856,6 +1856,34 @@ SEASTAR_TEST_CASE(test_lru) {
     });
 }
 
+SEASTAR_TEST_CASE(test_cache_memory_limits) {
+    return seastar::async([] {
+        auto s = make_schema();
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        auto cache_mt = make_lw_shared<replica::memtable>(s);
+
+        cache_tracker tracker;
+        row_cache cache(s, snapshot_source_from_snapshot(cache_mt->as_data_source()), tracker);
+
+        for (auto&& m : make_ring(s, 100)) {
+            cache.populate(m);
+        }
+        auto used = tracker.region().occupancy().used_space();
+        BOOST_REQUIRE_GT(used, 0u);
+
+        // Reclamation doesn't evict reserved memory.
+        tracker.set_memory_limits(used, 0);
+        BOOST_REQUIRE(tracker.region().evict_some() == memory::reclaiming_result::reclaimed_nothing);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, 100u);
+
+        // Reads evict down to the limit.
+        tracker.set_memory_limits(0, used / 2);
+        cache.make_reader(s, semaphore.make_permit()).close().get();
+        BOOST_REQUIRE_LE(tracker.region().occupancy().used_space(), used / 2);
+        BOOST_REQUIRE_LT(tracker.get_stats().partitions, 100u);
+    });
+}
+
 SEASTAR_TEST_CASE(test_update_invalidating) {
     return seastar::async([] {
         simple_schema s;
@@ -1907,6 +1935,112 @@ SEASTAR_TEST_CASE(test_update_invalidating) {
     });
 }
 
+SEASTAR_TEST_CASE(test_absent_partitions) {
+    return seastar::async([] {
+        simple_schema s;
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        cache_tracker tracker;
+        tracker.absent_partitions().set_capacity(100);
+        memtable_snapshot_source underlying(s.schema());
+
+        auto mutation_for_key = [&] (dht::decorated_key key) {
+            mutation m(s.schema(), key);
+            s.add_row(m, s.make_ckey(0), "val");
+            return m;
+        };
+
+        auto keys = s.make_pkeys(3);
+        auto m0 = mutation_for_key(keys[0]);
+        underlying.apply(m0);
+
+        row_cache cache(s.schema(), snapshot_source([&] { return underlying(); }), tracker);
+
+        auto& absent = tracker.absent_partitions();
+        auto pr1 = dht::partition_range::make_singular(keys[1]);
+        auto pr2 = dht::partition_range::make_singular(keys[2]);
+
+        assert_that(cache.make_reader(s.schema(), semaphore.make_permit(), pr1))
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(absent.get_stats().insertions, 1u);
+        BOOST_REQUIRE_EQUAL(tracker.get_stats().partitions, 0u);
+
+        assert_that(cache.make_reader(s.schema(), semaphore.make_permit(), pr1))
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(absent.get_stats().hits, 1u);
+
+        // Flushing a memtable with the partition makes it present.
+        auto m1 = mutation_for_key(keys[1]);
+        auto mt = make_lw_shared<replica::memtable>(s.schema());
+        mt->apply(m1);
+        auto mt_copy = make_lw_shared<replica::memtable>(s.schema());
+        mt_copy->apply(*mt, semaphore.make_permit()).get();
+        cache.update(row_cache::external_updater([&] { underlying.apply(mt_copy); }), *mt).get();
+
+        assert_that(cache.make_reader(s.schema(), semaphore.make_permit(), pr1))
+            .produces(m1)
+            .produces_end_of_stream();
+
+        // So does invalidation.
+        assert_that(cache.make_reader(s.schema(), semaphore.make_permit(), pr2))
+            .produces_end_of_stream();
+        auto m2 = mutation_for_key(keys[2]);
+        cache.invalidate(row_cache::external_updater([&] { underlying.apply(m2); })).get();
+
+        assert_that(cache.make_reader(s.schema(), semaphore.make_permit(), pr2))
+            .produces(m2)
+            .produces_end_of_stream();
+        BOOST_REQUIRE_EQUAL(absent.get_stats().hits, 1u);
+    });
+}
+
+SEASTAR_TEST_CASE(test_versions_merged_by_reads_are_counted) {
+    return seastar::async([] {
+        simple_schema s;
+        tests::reader_concurrency_semaphore_wrapper semaphore;
+        cache_tracker tracker;
+        memtable_snapshot_source underlying(s.schema());
+
+        auto pk = s.make_pkey(0);
+        auto pr = dht::partition_range::make_singular(pk);
+        mutation m0(s.schema(), pk);
+        s.add_row(m0, s.make_ckey(0), "v0");
+        underlying.apply(m0);
+
+        row_cache cache(s.schema(), snapshot_source([&] { return underlying(); }), tracker);
+        assert_that(cache.make_reader(s.schema(), semaphore.make_permit(), pr))
+            .produces(m0)
+            .produces_end_of_stream();
+
+        auto versions_of_next_read = [&] {
+            auto versions_before = tracker.get_stats().partition_snapshot_versions;
+            auto reads_before = tracker.get_stats().partition_snapshot_reads;
+            auto rd = cache.make_reader(s.schema(), semaphore.make_permit(), pr);
+            rd.fill_buffer().get();
+            rd.close().get();
+            BOOST_REQUIRE_EQUAL(tracker.get_stats().partition_snapshot_reads, reads_before + 1);
+            return tracker.get_stats().partition_snapshot_versions - versions_before;
+        };
+        BOOST_REQUIRE_EQUAL(versions_of_next_read(), 1u);
+
+        // A reader holding a snapshot makes the update add a version.
+        auto rd = cache.make_reader(s.schema(), semaphore.make_permit(), pr);
+        rd.set_max_buffer_size(1);
+        rd.fill_buffer().get();
+
+        mutation m1(s.schema(), pk);
+        s.add_row(m1, s.make_ckey(1), "v1");
+        auto mt = make_lw_shared<replica::memtable>(s.schema());
+        mt->apply(m1);
+        cache.update(row_cache::external_updater([&] { underlying.apply(m1); }), *mt).get();
+        BOOST_REQUIRE_EQUAL(versions_of_next_read(), 2u);
+
+        // Releasing the snapshot coalesces the versions.
+        rd.close().get();
+        tracker.cleaner().drain().get();
+        BOOST_REQUIRE_EQUAL(versions_of_next_read(), 1u);
+    });
+}
+
 SEASTAR_TEST_CASE(test_scan_with_partial_partitions) {
     return seastar::async([] {
         simple_schema s;
@@ -38,6 +38,7 @@
 #include "compaction/compaction_strategy_impl.hh"
 #include "compaction/date_tiered_compaction_strategy.hh"
 #include "compaction/time_window_compaction_strategy.hh"
+#include "compaction/incremental_compaction_strategy.hh"
 #include "compaction/leveled_compaction_strategy.hh"
 #include "test/lib/mutation_assertions.hh"
 #include "counters.hh"
@@ -65,6 +66,7 @@
 #include <boost/icl/interval_map.hpp>
 #include "test/lib/test_services.hh"
 #include "test/lib/cql_test_env.hh"
+#include "transport/messages/result_message.hh"
 #include "test/lib/reader_concurrency_semaphore.hh"
 #include "test/lib/sstable_utils.hh"
 #include "test/lib/random_utils.hh"
@@ -163,6 +165,9 @@ class table_state_for_test : public table_state {
     sstables::shared_sstable make_sstable() const override {
         return _t->make_sstable();
     }
+    sstables::shared_sstable make_cold_sstable() const override {
+        return _t->make_sstable(_t->dir() + "/" + sstables::cold_dir);
+    }
     sstables::sstable_writer_config configure_writer(sstring origin) const override {
         return _env.manager().configure_writer(std::move(origin));
     }
@@ -830,6 +835,80 @@ SEASTAR_TEST_CASE(leveled_04) {
   });
 }
 
+SEASTAR_TEST_CASE(leveled_dynamic_level_bytes_test) {
+  BOOST_REQUIRE_EQUAL(smp::count, 1);
+  return test_env::do_with([] (test_env& env) {
+    column_family_for_tests cf(env.manager());
+
+    auto key_and_token_pair = token_generation_for_current_shard(50);
+    auto min_key = key_and_token_pair[0].first;
+    auto max_key = key_and_token_pair[key_and_token_pair.size()-1].first;
+
+    auto max_sstable_size_in_mb = 1;
+    auto max_sstable_size_in_bytes = max_sstable_size_in_mb*1024*1024;
+
+    // Level 1 holds half its static target, but a quarter of the highest level, which is far below its own static target.
+    add_sstable_for_leveled_test(env, cf, /*gen*/1, /*data_size*/5 * max_sstable_size_in_bytes, /*level*/1, min_key, max_key);
+    add_sstable_for_leveled_test(env, cf, /*gen*/2, /*data_size*/20 * max_sstable_size_in_bytes, /*level*/3, min_key, max_key);
+
+    auto candidates = get_candidates_for_leveled_strategy(*cf);
+    sstables::size_tiered_compaction_strategy_options stcs_options;
+    auto table_s = make_table_state_for_test(cf, env);
+    std::vector<std::optional<dht::decorated_key>> last_compacted_keys(leveled_manifest::MAX_LEVELS);
+    std::vector<int> compaction_counter(leveled_manifest::MAX_LEVELS);
+
+    leveled_manifest manifest = leveled_manifest::create(*table_s, candidates, max_sstable_size_in_mb, stcs_options);
+    BOOST_REQUIRE_EQUAL(manifest.max_bytes_for_level(1), leveled_manifest::max_bytes_for_level(1, max_sstable_size_in_bytes));
+    BOOST_REQUIRE(manifest.get_compaction_candidates(last_compacted_keys, compaction_counter).sstables.empty());
+
+    leveled_manifest dynamic_manifest = leveled_manifest::create(*table_s, candidates, max_sstable_size_in_mb, stcs_options, true);
+    BOOST_REQUIRE_EQUAL(dynamic_manifest.max_bytes_for_level(2), uint64_t(2 * max_sstable_size_in_bytes));
+    BOOST_REQUIRE_EQUAL(dynamic_manifest.max_bytes_for_level(1), uint64_t(max_sstable_size_in_bytes));
+    BOOST_REQUIRE_EQUAL(dynamic_manifest.max_bytes_for_level(3), leveled_manifest::max_bytes_for_level(3, max_sstable_size_in_bytes));
+    auto candidate = dynamic_manifest.get_compaction_candidates(last_compacted_keys, compaction_counter);
+    BOOST_REQUIRE_EQUAL(candidate.sstables.size(), 1u);
+    BOOST_REQUIRE_EQUAL(candidate.level, 2);
+
+    BOOST_REQUIRE_THROW(sstables::make_compaction_strategy(sstables::compaction_strategy_type::leveled, {{"dynamic_level_bytes", "yes"}}),
+            exceptions::configuration_exception);
+
+    return cf.stop_and_keep_alive();
+  });
+}
+
+SEASTAR_TEST_CASE(leveled_l0_subcompactions_test) {
+  BOOST_REQUIRE_EQUAL(smp::count, 1);
+  return test_env::do_with([] (test_env& env) {
+    column_family_for_tests cf(env.manager());
+
+    auto key_and_token_pair = token_generation_for_current_shard(50);
+    auto min_key = key_and_token_pair[0].first;
+    auto max_key = key_and_token_pair[key_and_token_pair.size()-1].first;
+    auto max_sstable_size_in_mb = 1;
+    auto max_sstable_size = max_sstable_size_in_mb*1024*1024;
+
+    add_sstable_for_leveled_test(env, cf, /*gen*/1, max_sstable_size, /*level*/0, min_key, max_key);
+    add_sstable_for_leveled_test(env, cf, /*gen*/2, max_sstable_size, /*level*/0, key_and_token_pair[1].first, max_key);
+
+    auto candidates = get_candidates_for_leveled_strategy(*cf);
+    sstables::size_tiered_compaction_strategy_options stcs_options;
+    auto table_s = make_table_state_for_test(cf, env);
+    std::vector<std::optional<dht::decorated_key>> last_compacted_keys(leveled_manifest::MAX_LEVELS);
+    std::vector<int> compaction_counter(leveled_manifest::MAX_LEVELS);
+
+    leveled_manifest manifest = leveled_manifest::create(*table_s, candidates, max_sstable_size_in_mb, stcs_options, false, 4);
+    auto candidate = manifest.get_compaction_candidates(last_compacted_keys, compaction_counter);
+    BOOST_REQUIRE_EQUAL(candidate.sstables.size(), 2u);
+    BOOST_REQUIRE_EQUAL(candidate.level, 1);
+    BOOST_REQUIRE_EQUAL(candidate.parallelism, 4u);
+
+    BOOST_REQUIRE_THROW(sstables::make_compaction_strategy(sstables::compaction_strategy_type::leveled, {{"l0_subcompactions", "0"}}),
+            exceptions::configuration_exception);
+
+    return cf.stop_and_keep_alive();
+  });
+}
+
 SEASTAR_TEST_CASE(leveled_05) {
     // NOTE: Generations from 48 to 51 are used here.
     return test_setup::do_with_tmp_directory([] (test_env& env, sstring tmpdir_path) {
@@ -1293,6 +1372,128 @@ SEASTAR_TEST_CASE(tombstone_purge_test) {
     });
 }
 
+SEASTAR_TEST_CASE(garbage_collect_compaction_test) {
+    BOOST_REQUIRE(smp::count == 1);
+    return test_env::do_with_async([] (test_env& env) {
+        auto builder = schema_builder("tests", "garbage_collect")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type);
+        builder.set_gc_grace_seconds(0);
+        auto s = builder.build();
+
+        auto tmp = tmpdir();
+        auto sst_gen = [&env, s, &tmp, gen = make_lw_shared<unsigned>(1)] () mutable {
+            return env.make_sstable(s, tmp.path().string(), (*gen)++, sstables::get_highest_sstable_version(), big);
+        };
+
+        api::timestamp_type next_timestamp = 1;
+        auto make_insert = [&] (partition_key key) {
+            mutation m(s, key);
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(int32_t(1)), next_timestamp++);
+            return m;
+        };
+        auto make_expiring = [&] (partition_key key, int ttl) {
+            mutation m(s, key);
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(int32_t(1)),
+                next_timestamp++, gc_clock::duration(ttl));
+            return m;
+        };
+        auto make_delete = [&] (partition_key key) {
+            mutation m(s, key);
+            m.partition().apply(tombstone(next_timestamp++, gc_clock::now()));
+            return m;
+        };
+
+        auto alpha = partition_key::from_exploded(*s, {to_bytes("alpha")});
+        auto beta = partition_key::from_exploded(*s, {to_bytes("beta")});
+        auto gamma = partition_key::from_exploded(*s, {to_bytes("gamma")});
+        auto ttl = 10;
+
+        auto old_insert = make_insert(alpha);
+        auto deletion = make_delete(alpha);
+        auto expiring = make_expiring(beta, ttl);
+        auto live = make_insert(gamma);
+
+        auto sst1 = make_sstable_containing(sst_gen, {old_insert});
+        auto sst2 = make_sstable_containing(sst_gen, {deletion, expiring, live});
+
+        forward_jump_clocks(std::chrono::seconds(ttl));
+
+        column_family_for_tests cf(env.manager(), s);
+        auto stop_cf = deferred_stop(cf);
+        column_family_test(cf).add_sstable(sst1);
+        column_family_test(cf).add_sstable(sst2);
+
+        auto desc = sstables::compaction_descriptor({ sst2 }, default_priority_class(), sst2->get_sstable_level(),
+                sstables::compaction_descriptor::default_max_sstable_bytes, sst2->run_identifier(), sstables::compaction_type_options::make_garbage_collect());
+        BOOST_REQUIRE_EQUAL(desc.options.type(), sstables::compaction_type::GarbageCollect);
+        auto result = compact_sstables(cf.get_compaction_manager(), std::move(desc), *cf, sst_gen).get0();
+        BOOST_REQUIRE_EQUAL(1, result.new_sstables.size());
+        BOOST_REQUIRE_EQUAL(result.new_sstables.front()->run_identifier(), sst2->run_identifier());
+
+        // The expired cell is purged, but the tombstone shadowing data in the sstable which wasn't
+        // rewritten is kept, and that sstable isn't merged into the output.
+        std::vector<mutation> expected = { deletion, live };
+        std::sort(expected.begin(), expected.end(), mutation_decorated_key_less_comparator());
+        auto rd = assert_that(sstable_reader(result.new_sstables.front(), s, env.make_reader_permit()));
+        for (auto& m : expected) {
+            rd.produces(m);
+        }
+        rd.produces_end_of_stream();
+    });
+}
+
+SEASTAR_TEST_CASE(reshape_disjoint_input_test) {
+    BOOST_REQUIRE(smp::count == 1);
+    return test_env::do_with_async([] (test_env& env) {
+        auto s = schema_builder("tests", "reshape_disjoint_input")
+                .with_column("id", utf8_type, column_kind::partition_key)
+                .with_column("value", int32_type).build();
+
+        auto tmp = tmpdir();
+        auto sst_gen = [&env, s, &tmp, gen = make_lw_shared<unsigned>(1)] () mutable {
+            return env.make_sstable(s, tmp.path().string(), (*gen)++, sstables::get_highest_sstable_version(), big);
+        };
+
+        auto make_insert = [&] (const dht::decorated_key& dk, api::timestamp_type ts) {
+            mutation m(s, dk);
+            m.set_clustered_cell(clustering_key::make_empty(), bytes("value"), data_value(int32_t(ts)), ts);
+            return m;
+        };
+
+        auto keys = make_local_keys(4, s);
+        auto dks = boost::copy_range<std::vector<dht::decorated_key>>(keys | boost::adaptors::transformed([&] (const sstring& k) {
+            return dht::decorate_key(*s, partition_key::from_exploded(*s, {to_bytes(k)}));
+        }));
+
+        column_family_for_tests cf(env.manager(), s);
+        auto stop_cf = deferred_stop(cf);
+
+        auto reshape = [&] (std::vector<shared_sstable> input, std::vector<mutation> expected) {
+            auto desc = sstables::compaction_descriptor(std::move(input), default_priority_class());
+            desc.options = sstables::compaction_type_options::make_reshape();
+            auto result = compact_sstables(cf.get_compaction_manager(), std::move(desc), *cf, sst_gen).get0();
+            BOOST_REQUIRE_EQUAL(1, result.new_sstables.size());
+            auto rd = assert_that(sstable_reader(result.new_sstables.front(), s, env.make_reader_permit()));
+            for (auto& m : expected) {
+                rd.produces(m);
+            }
+            rd.produces_end_of_stream();
+        };
+
+        // Disjoint input is copied.
+        auto m0 = make_insert(dks[0], 1);
+        auto m1 = make_insert(dks[1], 1);
+        auto m2 = make_insert(dks[2], 1);
+        auto m3 = make_insert(dks[3], 1);
+        reshape({ make_sstable_containing(sst_gen, {m0, m1}), make_sstable_containing(sst_gen, {m2, m3}) }, { m0, m1, m2, m3 });
+
+        // Overlapping input is still merged.
+        auto newer_m1 = make_insert(dks[1], 2);
+        reshape({ make_sstable_containing(sst_gen, {m0, m1}), make_sstable_containing(sst_gen, {newer_m1, m2}) }, { m0, newer_m1, m2 });
+    });
+}
+
 SEASTAR_TEST_CASE(sstable_rewrite) {
     BOOST_REQUIRE(smp::count == 1);
     return test_setup::do_with_tmp_directory([] (test_env& env, sstring tmpdir_path) {
@@ -1654,6 +1855,50 @@ SEASTAR_TEST_CASE(time_window_strategy_ts_resolution_check) {
   });
 }
 
+SEASTAR_TEST_CASE(time_window_strategy_cold_storage_test) {
+  return test_env::do_with([] (test_env& env) {
+    column_family_for_tests cf(env.manager());
+    auto s = cf.schema();
+    auto now = std::chrono::duration_cast<std::chrono::microseconds>(db_clock::now().time_since_epoch());
+    auto old_ts = (now - std::chrono::hours(24 * 30)).count();
+    int64_t gen = 1;
+
+    auto make_sstable = [&] (sstring dir, int64_t ts) {
+        auto sst = env.make_sstable(s, dir, gen++, la, big);
+        sstables::test(sst).set_values("key1", "key1", build_stats(ts, ts, std::numeric_limits<int32_t>::max()));
+        return sst;
+    };
+
+    auto cold_dir = cf->dir() + "/" + sstables::cold_dir;
+    auto old_hot = make_sstable(cf->dir(), old_ts);
+    auto old_cold = make_sstable(cold_dir, old_ts + 1);
+    auto recent = make_sstable(cf->dir(), now.count());
+    BOOST_REQUIRE(!old_hot->is_cold());
+    BOOST_REQUIRE(old_cold->is_cold());
+
+    auto table_s = make_table_state_for_test(cf, env);
+    auto strategy_c = make_strategy_control_for_test(false);
+    std::map<sstring, sstring> opts = { { time_window_compaction_strategy_options::COLD_STORAGE_AGE_SECONDS_KEY, "604800" }, };
+
+    // Only the sstable of the old window which is still in hot storage is moved.
+    auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::time_window, opts);
+    auto desc = cs.get_sstables_for_compaction(*table_s, *strategy_c, { old_hot, recent });
+    BOOST_REQUIRE_EQUAL(desc.sstables.size(), 1);
+    BOOST_REQUIRE(desc.sstables.front() == old_hot);
+    BOOST_REQUIRE(desc.output_tier == storage_tier::cold);
+
+    cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::time_window, opts);
+    desc = cs.get_sstables_for_compaction(*table_s, *strategy_c, { old_cold, recent });
+    BOOST_REQUIRE(desc.sstables.empty());
+
+    cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::time_window, {});
+    desc = cs.get_sstables_for_compaction(*table_s, *strategy_c, { old_hot, recent });
+    BOOST_REQUIRE(desc.sstables.empty());
+
+    return cf.stop_and_keep_alive();
+  });
+}
+
 SEASTAR_TEST_CASE(time_window_strategy_correctness_test) {
     using namespace std::chrono;
 
@@ -1924,6 +2169,109 @@ SEASTAR_TEST_CASE(size_tiered_beyond_max_threshold_test) {
   });
 }
 
+SEASTAR_TEST_CASE(incremental_compaction_strategy_compacts_whole_runs_test) {
+  return test_env::do_with([] (test_env& env) {
+    column_family_for_tests cf(env.manager());
+    auto s = cf.schema();
+    std::map<sstring, sstring> options = {{"sstable_size_in_mb", "1"}, {"min_sstable_size", "1"}};
+    auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::incremental, options);
+    const uint64_t fragment_size = 1024 * 1024;
+    auto keys = make_local_keys(8, s);
+
+    std::vector<sstables::shared_sstable> candidates;
+    int64_t gen = 1;
+    size_t min_threshold = s->min_compaction_threshold();
+    // min_threshold runs of 4 disjoint fragments each.
+    for (size_t run = 0; run < min_threshold; run++) {
+        auto run_identifier = utils::make_random_uuid();
+        for (auto fragment = 0; fragment < 4; fragment++) {
+            auto sst = env.make_sstable(s, "", gen++, la, big);
+            sstables::test(sst).set_values_for_leveled_strategy(fragment_size, 0, 0, keys[2 * fragment], keys[2 * fragment + 1]);
+            sstables::test(sst).set_run_identifier(run_identifier);
+            candidates.push_back(std::move(sst));
+        }
+    }
+    // A single big sstable, which is in a tier of its own.
+    auto big_sst = env.make_sstable(s, "", gen++, la, big);
+    sstables::test(big_sst).set_values_for_leveled_strategy(fragment_size * 100, 0, 0, keys.front(), keys.back());
+    candidates.push_back(big_sst);
+
+    BOOST_REQUIRE_EQUAL(sstables::incremental_compaction_strategy::make_runs(candidates).size(), min_threshold + 1);
+
+    auto table_s = make_table_state_for_test(cf, env);
+    auto strategy_c = make_strategy_control_for_test(false);
+    auto desc = cs.get_sstables_for_compaction(*table_s, *strategy_c, candidates);
+    BOOST_REQUIRE_EQUAL(desc.sstables.size(), min_threshold * 4);
+    BOOST_REQUIRE_EQUAL(desc.max_sstable_bytes, fragment_size);
+    BOOST_REQUIRE(std::find(desc.sstables.begin(), desc.sstables.end(), big_sst) == desc.sstables.end());
+
+    // A fragment overlapping with its run cannot be part of it.
+    auto overlapping = env.make_sstable(s, "", gen++, la, big);
+    sstables::test(overlapping).set_values_for_leveled_strategy(fragment_size, 0, 0, keys[0], keys[3]);
+    sstables::test(overlapping).set_run_identifier(candidates.front()->run_identifier());
+    candidates.push_back(overlapping);
+    BOOST_REQUIRE_EQUAL(sstables::incremental_compaction_strategy::make_runs(candidates).size(), min_threshold + 2);
+
+    return cf.stop_and_keep_alive();
+  });
+}
+
+SEASTAR_TEST_CASE(parallel_major_compaction_test) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        auto tmp = tmpdir();
+        auto sst_gen = [&env, s, &tmp, gen = make_lw_shared<unsigned>(1)] () mutable {
+            return env.make_sstable(s, tmp.path().string(), (*gen)++, sstables::get_highest_sstable_version(), big);
+        };
+
+        // Two overlapping sstables, each containing a row for every key.
+        auto keys = ss.make_pkeys(32);
+        std::vector<mutation> first, second, expected;
+        for (auto& key : keys) {
+            mutation m1(s, key);
+            ss.add_row(m1, ss.make_ckey(0), "v1");
+            mutation m2(s, key);
+            ss.add_row(m2, ss.make_ckey(1), "v2");
+            expected.push_back(m1 + m2);
+            first.push_back(std::move(m1));
+            second.push_back(std::move(m2));
+        }
+        std::vector<shared_sstable> input = {
+            make_sstable_containing(sst_gen, std::move(first)),
+            make_sstable_containing(sst_gen, std::move(second)),
+        };
+
+        column_family_for_tests cf(env.manager(), s);
+        auto stop_cf = deferred_stop(cf);
+        for (auto& sst : input) {
+            column_family_test(cf).add_sstable(sst);
+        }
+
+        unsigned replacements = 0;
+        auto replacer = [&] (sstables::compaction_completion_desc desc) {
+            replacements++;
+            BOOST_REQUIRE_EQUAL(desc.old_sstables.size(), input.size());
+        };
+        auto desc = sstables::compaction_descriptor(input, default_priority_class());
+        desc.parallelism = 4;
+        auto result = compact_sstables(cf.get_compaction_manager(), std::move(desc), *cf, sst_gen, replacer).get0();
+        BOOST_REQUIRE_EQUAL(replacements, 1);
+        BOOST_REQUIRE_GE(result.new_sstables.size(), 1);
+
+        // Sub-ranges are disjoint, so merging the output must yield every partition exactly once.
+        std::vector<flat_mutation_reader_v2> readers;
+        for (auto& sst : result.new_sstables) {
+            readers.push_back(sstable_reader(sst, s, env.make_reader_permit()));
+        }
+        auto rd = assert_that(make_combined_reader(s, env.make_reader_permit(), std::move(readers)));
+        for (auto& m : expected) {
+            rd.produces(m);
+        }
+        rd.produces_end_of_stream();
+    });
+}
+
 SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
     return test_env::do_with_async([] (test_env& env) {
         auto tmp = tmpdir();
@@ -2030,6 +2378,61 @@ SEASTAR_TEST_CASE(sstable_expired_data_ratio) {
     });
 }
 
+SEASTAR_TEST_CASE(tombstone_dense_range_compaction_test) {
+  return test_env::do_with([] (test_env& env) {
+    column_family_for_tests cf(env.manager());
+    auto s = cf.schema();
+    auto keys = make_local_keys(7, s);
+    int64_t gen = 1;
+
+    auto make_sstable = [&] (size_t first, size_t last, int64_t min_timestamp, int64_t max_timestamp, uint64_t droppable, uint64_t size) {
+        stats_metadata stats = {};
+        stats.min_timestamp = min_timestamp;
+        stats.max_timestamp = max_timestamp;
+        for (auto i = 0; i < 10; i++) {
+            stats.estimated_cells_count.add(10);
+        }
+        stats.estimated_tombstone_drop_time = utils::streaming_histogram(sstables::TOMBSTONE_HISTOGRAM_BIN_SIZE);
+        if (droppable) {
+            stats.estimated_tombstone_drop_time.update(0, droppable);
+        }
+        auto sst = env.make_sstable(s, "", gen++, la, big);
+        sstables::test(sst).set_values(keys[first], keys[last], std::move(stats));
+        sstables::test(sst).set_data_file_size(size);
+        sstables::test(sst).set_data_file_write_time(db_clock::time_point::min());
+        return sst;
+    };
+
+    // Sizes are far apart, so no size tier is interesting.
+    auto tombstone_heavy = make_sstable(1, 3, 10, 20, 50, 1024 * 1024);
+    auto older_overlapping = make_sstable(2, 4, 0, 5, 0, 16 * 1024 * 1024);
+    auto newer_overlapping = make_sstable(0, 2, 30, 40, 0, 256 * 1024 * 1024);
+    auto older_disjoint = make_sstable(5, 6, 0, 5, 0, 4096ull * 1024 * 1024);
+    std::vector<shared_sstable> candidates = { tombstone_heavy, older_overlapping, newer_overlapping, older_disjoint };
+
+    auto table_s = make_table_state_for_test(cf, env);
+    auto strategy_c = make_strategy_control_for_test(false);
+
+    auto cs = sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, {});
+    auto desc = cs.get_sstables_for_compaction(*table_s, *strategy_c, candidates);
+    BOOST_REQUIRE_EQUAL(desc.sstables.size(), 1);
+    BOOST_REQUIRE(desc.sstables.front() == tombstone_heavy);
+
+    for (auto type : { sstables::compaction_strategy_type::size_tiered, sstables::compaction_strategy_type::incremental }) {
+        auto cs = sstables::make_compaction_strategy(type, {{"tombstone_compaction_scope", "token_range"}});
+        auto desc = cs.get_sstables_for_compaction(*table_s, *strategy_c, candidates);
+        BOOST_REQUIRE_EQUAL(desc.sstables.size(), 2);
+        BOOST_REQUIRE(desc.sstables[0] == tombstone_heavy);
+        BOOST_REQUIRE(desc.sstables[1] == older_overlapping);
+    }
+
+    BOOST_REQUIRE_THROW(sstables::make_compaction_strategy(sstables::compaction_strategy_type::size_tiered, {{"tombstone_compaction_scope", "table"}}),
+            exceptions::configuration_exception);
+
+    return cf.stop_and_keep_alive();
+  });
+}
+
 SEASTAR_TEST_CASE(compaction_correctness_with_partitioned_sstable_set) {
     return test_env::do_with_async([] (test_env& env) {
         cell_locker_stats cl_stats;
@@ -2191,6 +2594,49 @@ SEASTAR_TEST_CASE(sstable_cleanup_correctness_test) {
     });
 }
 
+// Cleanup is done once perform_cleanup() returns: after a topology change
+// takes some of the ranges away, none of their data is left in the sstables.
+SEASTAR_TEST_CASE(sstable_cleanup_after_topology_change_test) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table ks.t (pk int primary key, v int)").get();
+        constexpr int32_t total_partitions = 1000;
+        for (int32_t pk = 0; pk < total_partitions; pk++) {
+            e.execute_cql(format("insert into ks.t (pk, v) values ({}, {})", pk, pk)).get();
+        }
+
+        auto count_rows = [&] {
+            auto msg = e.execute_cql("select pk from ks.t bypass cache").get0();
+            auto rows = dynamic_pointer_cast<cql_transport::messages::result_message::rows>(msg);
+            BOOST_REQUIRE(rows);
+            return rows->rs().result_set().size();
+        };
+        auto cleanup = [&] (dht::token_range_vector owned_ranges) {
+            e.db().invoke_on_all([owned_ranges] (replica::database& db) -> future<> {
+                auto& t = db.find_column_family("ks", "t");
+                co_await t.flush();
+                co_await db.get_compaction_manager().perform_cleanup(compaction::make_owned_ranges_ptr(owned_ranges), t.as_table_state());
+            }).get();
+        };
+
+        // Nothing is dropped while all ranges are owned.
+        cleanup(e.local_db().get_keyspace_local_ranges("ks"));
+        BOOST_REQUIRE_EQUAL(count_rows(), total_partitions);
+
+        // Then the node loses the ranges above token 0.
+        auto s = e.local_db().find_schema("ks", "t");
+        auto owned = dht::token_range::make_ending_with({dht::token::from_int64(0), true});
+        size_t owned_partitions = 0;
+        for (int32_t pk = 0; pk < total_partitions; pk++) {
+            owned_partitions += owned.contains(dht::get_token(*s, partition_key::from_singular(*s, pk)), dht::token_comparator());
+        }
+        BOOST_REQUIRE_GT(owned_partitions, 0);
+        BOOST_REQUIRE_LT(owned_partitions, total_partitions);
+
+        cleanup({owned});
+        BOOST_REQUIRE_EQUAL(count_rows(), owned_partitions);
+    });
+}
+
 std::vector<mutation_fragment_v2> write_corrupt_sstable(test_env& env, sstable& sst, reader_permit permit,
         std::function<void(mutation_fragment_v2&&, bool)> write_to_secondary) {
     auto schema = sst.get_schema();
@@ -4018,6 +4464,34 @@ SEASTAR_TEST_CASE(lcs_reshape_test) {
 
             BOOST_REQUIRE(cs.get_reshaping_job(sstables, s, default_priority_class(), reshape_mode::strict).sstables.size() == 256);
         }
+        // non overlapping, sized for a level: moved there without being rewritten,
+        // unless too many of them are much smaller
+        {
+            const uint64_t max_sstable_size = uint64_t(160) << 20; // the default sstable_size_in_mb
+            auto make_sstables = [&] (int small) {
+                std::vector <shared_sstable> sstables;
+                for (auto i = 0; i < 256; i++) {
+                    auto sst = env.make_sstable(s, "", i + 1);
+                    auto key = keys[i].first;
+                    auto size = i < small ? 1 : max_sstable_size;
+                    sstables::test(sst).set_values_for_leveled_strategy(size, 0 /* level */, 0 /* max ts */, key, key);
+                    sstables.push_back(std::move(sst));
+                }
+                return sstables;
+            };
+
+            auto desc = cs.get_reshaping_job(make_sstables(0), s, default_priority_class(), reshape_mode::strict);
+            BOOST_REQUIRE_EQUAL(desc.sstables.size(), 256);
+            BOOST_REQUIRE(desc.relevel_only);
+
+            desc = cs.get_reshaping_job(make_sstables(64), s, default_priority_class(), reshape_mode::strict);
+            BOOST_REQUIRE_EQUAL(desc.sstables.size(), 256);
+            BOOST_REQUIRE(desc.relevel_only);
+
+            desc = cs.get_reshaping_job(make_sstables(192), s, default_priority_class(), reshape_mode::strict);
+            BOOST_REQUIRE_EQUAL(desc.sstables.size(), 256);
+            BOOST_REQUIRE(!desc.relevel_only);
+        }
         // all overlapping
         {
             std::vector <shared_sstable> sstables;
@@ -5008,6 +5482,116 @@ SEASTAR_TEST_CASE(simple_backlog_controller_test) {
     });
 }
 
+SEASTAR_THREAD_TEST_CASE(compaction_controller_read_feedback_test) {
+    auto as = abort_source();
+    compaction_manager::config cfg = {
+        .compaction_sched_group = { default_scheduling_group(), default_priority_class() },
+        .maintenance_sched_group = { default_scheduling_group(), default_priority_class() },
+        .available_memory = 1 << 30,
+        .read_latency_objective_us = utils::updateable_value<uint32_t>(1000),
+        .read_queue_length_objective = utils::updateable_value<uint32_t>(10),
+    };
+    auto manager = compaction_manager(std::move(cfg), as);
+
+    compaction_manager::foreground_read_load load;
+    BOOST_REQUIRE_EQUAL(manager.read_pressure(), 0.0f);
+    manager.set_foreground_read_load_source([&load] { return load; });
+
+    load = { .p99_latency = std::chrono::microseconds(500), .queue_length = 20 };
+    BOOST_REQUIRE_EQUAL(manager.read_pressure(), 2.0f);
+    load = { .p99_latency = std::chrono::microseconds(3000), .queue_length = 5 };
+    BOOST_REQUIRE_EQUAL(manager.read_pressure(), 3.0f);
+    load = {};
+    BOOST_REQUIRE_EQUAL(manager.read_pressure(), 0.0f);
+
+    manager.set_foreground_read_load_source({});
+
+    // The adjustments are driven by hand, the controller's timer never fires.
+    compaction_controller controller({}, 0, std::chrono::hours(1), [] { return 0.0f; });
+    BOOST_REQUIRE_EQUAL(controller.read_throttle(), 1.0f);
+
+    // Breaching the objective cuts the throttle multiplicatively, down to its minimum.
+    controller.update_read_throttle(3.0f);
+    BOOST_REQUIRE_EQUAL(controller.read_throttle(), compaction_controller::read_throttle_decrease);
+    for (int i = 0; i < 100; ++i) {
+        controller.update_read_throttle(3.0f);
+    }
+    BOOST_REQUIRE_EQUAL(controller.read_throttle(), compaction_controller::min_read_throttle);
+
+    // Without enough headroom, the throttle stays.
+    controller.update_read_throttle(0.9f);
+    BOOST_REQUIRE_EQUAL(controller.read_throttle(), compaction_controller::min_read_throttle);
+
+    // With headroom, it grows back additively, up to 1.
+    controller.update_read_throttle(0.0f);
+    BOOST_REQUIRE_EQUAL(controller.read_throttle(), std::min(1.0f, compaction_controller::min_read_throttle + compaction_controller::read_throttle_increase));
+    for (int i = 0; i < 100; ++i) {
+        controller.update_read_throttle(0.0f);
+    }
+    BOOST_REQUIRE_EQUAL(controller.read_throttle(), 1.0f);
+
+    controller.shutdown().get();
+}
+
+SEASTAR_THREAD_TEST_CASE(write_throttle_test) {
+    size_t dirty = 0;
+    float compaction_backlog = 0;
+    utils::updateable_value_source<uint32_t> horizon_in_ms(1000);
+    // Updated manually, not by the timer.
+    write_throttle throttle(write_throttle::config{
+            .soft_limit = 100,
+            .hard_limit = 200,
+            .horizon_in_ms = utils::updateable_value<uint32_t>(horizon_in_ms),
+        }, std::chrono::hours(1), [&] { return dirty; }, [&] { return compaction_backlog; });
+
+    auto now = write_throttle::clock_type::now();
+    auto sample = [&] (unsigned count, ssize_t dirty_delta) {
+        for (unsigned i = 0; i < count; ++i) {
+            dirty += dirty_delta;
+            now += std::chrono::milliseconds(100);
+            throttle.update(now);
+        }
+    };
+
+    sample(10, 0);
+    BOOST_REQUIRE_EQUAL(throttle.pressure(), 0.0f);
+
+    // Dirty memory growing by 40 bytes/s is projected to cross the soft limit
+    // before it actually does.
+    sample(20, 4);
+    BOOST_REQUIRE_LT(dirty, 100u);
+    BOOST_REQUIRE_GT(throttle.pressure(), 0.1f);
+    BOOST_REQUIRE_LT(throttle.pressure(), 0.3f);
+
+    // Flushes releasing memory faster than it is dirtied relieve the pressure
+    // even above the soft limit.
+    sample(20, 5);
+    BOOST_REQUIRE_GT(dirty, 100u);
+    auto growing = throttle.pressure();
+    sample(10, -4);
+    BOOST_REQUIRE_GT(dirty, 100u);
+    BOOST_REQUIRE_LT(throttle.pressure(), growing);
+
+    horizon_in_ms.set(0);
+    sample(1, 0);
+    BOOST_REQUIRE_EQUAL(throttle.pressure(), 0.0f);
+    BOOST_REQUIRE_EQUAL(throttle.backlog().relative_size(), 0.0f);
+
+    // Compaction debt adds pressure once the backlog is beyond what maximum shares can handle.
+    horizon_in_ms.set(1000);
+    dirty = 0;
+    sample(100, 0);
+    compaction_backlog = compaction_controller::normalization_factor;
+    sample(1, 0);
+    BOOST_REQUIRE_EQUAL(throttle.pressure(), 0.0f);
+    compaction_backlog = 1.5 * compaction_controller::normalization_factor;
+    sample(1, 0);
+    BOOST_REQUIRE_CLOSE(throttle.pressure(), 0.5f, 1);
+    BOOST_REQUIRE_CLOSE(throttle.backlog().relative_size(), 0.5f, 1);
+
+    throttle.shutdown();
+}
+
 SEASTAR_TEST_CASE(test_compaction_strategy_cleanup_method) {
     return test_env::do_with_async([] (test_env& env) {
         constexpr size_t all_files = 64;
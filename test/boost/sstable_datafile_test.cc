@@ -59,6 +59,7 @@
 #include "test/lib/reader_concurrency_semaphore.hh"
 #include "test/lib/sstable_utils.hh"
 #include "test/lib/random_utils.hh"
+#include "test/lib/eventually.hh"
 #include "readers/from_mutations_v2.hh"
 #include "readers/from_fragments_v2.hh"
 #include "test/lib/random_schema.hh"
@@ -2168,6 +2169,26 @@ SEASTAR_TEST_CASE(sstable_set_incremental_selector) {
         check(sel, decorated_keys[7], {0});
     }
 
+    {
+        // sstable 0 spans most of the ring, so it's kept out of the interval map although it's leveled.
+        sstable_set set = cs.make_sstable_set(s);
+        set.insert(sstable_for_overlapping_test(env, s, 0, key_and_token_pair[0].first, key_and_token_pair[7].first, 1));
+        set.insert(sstable_for_overlapping_test(env, s, 1, key_and_token_pair[3].first, key_and_token_pair[4].first, 1));
+
+        sstable_set::incremental_selector sel = set.make_incremental_selector();
+        check(sel, decorated_keys[0], {0});
+        check(sel, decorated_keys[2], {0});
+        check(sel, decorated_keys[3], {0, 1});
+        check(sel, decorated_keys[4], {0, 1});
+        check(sel, decorated_keys[5], {0});
+        check(sel, decorated_keys[7], {0});
+
+        BOOST_REQUIRE_EQUAL(set.select(dht::partition_range::make_singular(decorated_keys[3])).size(), 2);
+        set.erase(*boost::find_if(*set.all(), [] (auto& sst) { return generation_value(sst->generation()) == 0; }));
+        BOOST_REQUIRE_EQUAL(set.select(dht::partition_range::make_singular(decorated_keys[3])).size(), 1);
+        BOOST_REQUIRE_EQUAL(set.all()->size(), 1);
+    }
+
     return make_ready_future<>();
   });
 }
@@ -2595,6 +2616,82 @@ SEASTAR_TEST_CASE(summary_rebuild_sanity) {
     });
 }
 
+SEASTAR_TEST_CASE(test_reclaim_filter_memory) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        std::vector<mutation> mutations;
+        for (int i = 0; i < 100; i++) {
+            auto m = ss.new_mutation(format("key{}", i));
+            ss.add_row(m, ss.make_ckey(0), "v");
+            mutations.push_back(std::move(m));
+        }
+        std::vector<partition_key> absent_keys;
+        for (int i = 0; i < 10; i++) {
+            absent_keys.push_back(ss.make_pkey(format("absent{}", i)).key());
+        }
+        auto filtered_out = [&] (const shared_sstable& sst) {
+            return std::ranges::any_of(absent_keys, [&] (const partition_key& key) {
+                return !sst->filter_has_key(*s, key);
+            });
+        };
+
+        auto threshold = test_db_config.components_memory_reclaim_threshold();
+        auto restore_threshold = defer([threshold] () mutable {
+            test_db_config.components_memory_reclaim_threshold.set(std::move(threshold));
+        });
+        test_db_config.components_memory_reclaim_threshold.set(0.0);
+
+        auto tmp = tmpdir();
+        auto sst = make_sstable_containing([&] {
+            return env.make_sstable(s, tmp.path().string(), 1);
+        }, mutations);
+        // The filter is dropped at once, and lets all keys through.
+        BOOST_REQUIRE_EQUAL(env.manager().get_reclaimed_sstables_count(), 1);
+        BOOST_REQUIRE_EQUAL(env.manager().get_total_reclaimable_memory(), 0);
+        BOOST_REQUIRE(!filtered_out(sst));
+
+        // And is reloaded once there is room for it.
+        test_db_config.components_memory_reclaim_threshold.set(0.2);
+        REQUIRE_EVENTUALLY_EQUAL(env.manager().get_reclaimed_sstables_count(), 0);
+        BOOST_REQUIRE_GT(env.manager().get_total_reclaimable_memory(), 0);
+        BOOST_REQUIRE(filtered_out(sst));
+    });
+}
+
+SEASTAR_TEST_CASE(test_share_sstable_with_reclaimed_filter) {
+    return test_env::do_with_async([] (test_env& env) {
+        simple_schema ss;
+        auto s = ss.schema();
+        std::vector<mutation> mutations;
+        for (int i = 0; i < 100; i++) {
+            auto m = ss.new_mutation(format("key{}", i));
+            ss.add_row(m, ss.make_ckey(0), "v");
+            mutations.push_back(std::move(m));
+        }
+        auto absent_key = ss.make_pkey("absent").key();
+
+        auto threshold = test_db_config.components_memory_reclaim_threshold();
+        auto restore_threshold = defer([threshold] () mutable {
+            test_db_config.components_memory_reclaim_threshold.set(std::move(threshold));
+        });
+        test_db_config.components_memory_reclaim_threshold.set(0.0);
+
+        auto tmp = tmpdir();
+        auto sst = make_sstable_containing([&] {
+            return env.make_sstable(s, tmp.path().string(), 1);
+        }, mutations);
+        BOOST_REQUIRE_EQUAL(env.manager().get_reclaimed_sstables_count(), 1);
+        BOOST_REQUIRE(sst->filter_has_key(*s, absent_key));
+
+        // Shared components are never changed again, so the filter is loaded
+        // before they are shared, and the sstable is not reclaimable anymore.
+        auto info = sst->get_open_info().get0();
+        BOOST_REQUIRE_EQUAL(env.manager().get_reclaimed_sstables_count(), 0);
+        BOOST_REQUIRE(!sst->filter_has_key(*s, absent_key));
+    });
+}
+
 SEASTAR_TEST_CASE(sstable_partition_estimation_sanity_test) {
     return test_env::do_with_async([] (test_env& env) {
         auto builder = schema_builder("tests", "test")
@@ -11,16 +11,18 @@
 #include "tracing/tracing.hh"
 #include "tracing/trace_state.hh"
 #include "tracing/tracing_backend_registry.hh"
+#include "tracing/trace_ring_buffer_helper.hh"
 #include "utils/class_registrator.hh"
 
 #include "test/lib/cql_test_env.hh"
 
-future<> do_with_tracing_env(std::function<future<>(cql_test_env&)> func, cql_test_config cfg_in = {}) {
-    return do_with_cql_env([func](auto &env) {
+future<> do_with_tracing_env(std::function<future<>(cql_test_env&)> func, cql_test_config cfg_in = {}, sstring backend = "trace_keyspace_helper") {
+    return do_with_cql_env([func, backend](auto &env) {
         // supervisor::notify("creating tracing");
         tracing::backend_registry tracing_backend_registry;
         tracing::register_tracing_keyspace_backend(tracing_backend_registry);
-        tracing::tracing::create_tracing(tracing_backend_registry, "trace_keyspace_helper").get();
+        tracing::register_tracing_ring_buffer_backend(tracing_backend_registry);
+        tracing::tracing::create_tracing(tracing_backend_registry, backend).get();
 
         // supervisor::notify("starting tracing");
         tracing::tracing::start_tracing(env.qp()).get();
@@ -94,3 +96,30 @@ SEASTAR_TEST_CASE(tracing_slow_query_fast_mode) {
         return make_ready_future<>();
     });
 }
+
+SEASTAR_TEST_CASE(tracing_ring_buffer_backend) {
+    return do_with_tracing_env([](auto &e) {
+        tracing::tracing &t = tracing::tracing::get_local_tracing_instance();
+        auto& helper = dynamic_cast<tracing::trace_ring_buffer_helper&>(t.backend_helper());
+        BOOST_REQUIRE(helper.sessions().empty());
+
+        tracing::trace_state_props_set trace_props;
+        trace_props.set(tracing::trace_state_props::full_tracing);
+
+        tracing::trace_state_ptr trace_state = t.create_session(tracing::trace_type::QUERY, trace_props);
+        auto session_id = trace_state->session_id();
+        tracing::begin(trace_state, "begin", gms::inet_address());
+        tracing::trace(trace_state, "trace 1");
+        tracing::stop_foreground(trace_state);
+        trace_state = nullptr;
+        t.write_pending_records();
+
+        BOOST_REQUIRE_EQUAL(helper.sessions().size(), 1);
+        const auto& s = helper.sessions().front();
+        BOOST_REQUIRE_EQUAL(s.session_id, session_id);
+        BOOST_REQUIRE_EQUAL(s.request, "begin");
+        BOOST_REQUIRE(std::any_of(s.events.begin(), s.events.end(), [] (const auto& ev) { return ev.message == "trace 1"; }));
+
+        return make_ready_future<>();
+    }, {}, "trace_ring_buffer_helper");
+}
@@ -8,6 +8,8 @@
 
 #include <seastar/testing/thread_test_case.hh>
 
+#include <zstd.h>
+
 #include "transport/request.hh"
 #include "transport/response.hh"
 
@@ -152,3 +154,35 @@ SEASTAR_THREAD_TEST_CASE(test_response_request_reader) {
     BOOST_CHECK_EQUAL(req.read_short(), 1);
     BOOST_CHECK_EQUAL(req.read_string(), "zed");
 }
+
+SEASTAR_THREAD_TEST_CASE(test_response_zstd_compression) {
+    static constexpr auto version = 4;
+    static constexpr size_t header_size = 9;
+    auto stream_id = tests::random::get_int<int16_t>();
+    auto strings = boost::copy_range<std::vector<sstring>>(
+        boost::irange<int16_t>(0, tests::random::get_int<int16_t>(64) + 64)
+        | boost::adaptors::transformed([] (int) {
+            return tests::random::get_sstring();
+        })
+    );
+    auto make_message = [&] (cql_transport::cql_compression compression) {
+        auto res = cql_transport::response(stream_id, cql_transport::cql_binary_opcode::RESULT, tracing::trace_state_ptr());
+        res.write_string_list(strings);
+        auto msg = res.make_message(version, compression).release();
+        auto total_length = msg.len();
+        auto fbufs = fragmented_temporary_buffer(msg.release(), total_length);
+        return to_bytes(fragmented_temporary_buffer::view(fbufs));
+    };
+
+    auto plain = make_message(cql_transport::cql_compression::none);
+    auto compressed = make_message(cql_transport::cql_compression::zstd);
+    BOOST_CHECK_EQUAL(unsigned(uint8_t(compressed[1])), unsigned(cql_transport::cql_frame_flags::compression));
+
+    auto input = bytes_view(compressed).substr(header_size);
+    BOOST_CHECK_EQUAL(ZSTD_getFrameContentSize(input.data(), input.size()), plain.size() - header_size);
+    bytes output(bytes::initialized_later(), plain.size() - header_size);
+    auto ret = ZSTD_decompress(output.data(), output.size(), input.data(), input.size());
+    BOOST_REQUIRE(!ZSTD_isError(ret));
+    BOOST_CHECK_EQUAL(ret, output.size());
+    BOOST_CHECK_EQUAL(output, bytes_view(plain).substr(header_size));
+}
@@ -22,6 +22,7 @@
 #include "types/map.hh"
 #include "types/list.hh"
 #include "types/set.hh"
+#include "bytes_ostream.hh"
 #include "test/lib/exception_utils.hh"
 
 using namespace std::literals::chrono_literals;
@@ -438,6 +439,18 @@ BOOST_AUTO_TEST_CASE(test_varint) {
 
     BOOST_REQUIRE_EQUAL(from_hex("80000000"), varint_type->decompose(utils::multiprecision_int(-2147483648)));
 
+    // Around the sizes of the int64_t fast path.
+    for (auto [hex, value] : std::initializer_list<std::pair<const char*, const char*>>{
+            {"7fffffffffffffff", "9223372036854775807"},
+            {"8000000000000000", "-9223372036854775808"},
+            {"ffffffffffffffff", "-1"},
+            {"00ffffffffffffffff", "18446744073709551615"},
+            {"ff7fffffffffffffff", "-9223372036854775809"},
+            {"ff00000000000000", "-72057594037927936"},
+            {"00000000000000000001", "1"}}) {
+        BOOST_CHECK_EQUAL(value_cast<utils::multiprecision_int>(varint_type->deserialize(from_hex(hex))), utils::multiprecision_int(value));
+    }
+
     test_parsing_fails(varint_type, "1A");
 }
 
@@ -862,6 +875,22 @@ BOOST_AUTO_TEST_CASE(test_map_to_json) {
     BOOST_REQUIRE_EQUAL(to_json_string(*m, map_v.serialize()), "{\"42\": \"abc\", \"42\": \"abc\"}");
 }
 
+BOOST_AUTO_TEST_CASE(test_write_json) {
+    auto l = list_type_impl::get_instance(utf8_type, true);
+    auto m = map_type_impl::get_instance(int32_type, l, true);
+    auto list_v = make_list_value(l, {data_value("a\"b"), data_value("c")});
+    auto map_v = make_map_value(m, {{data_value(int32_t(1)), list_v}, {data_value(int32_t(2)), make_list_value(l, {})}});
+    auto serialized = map_v.serialize_nonnull();
+    const sstring expected = "{\"1\": [\"a\\\"b\", \"c\"], \"2\": []}";
+    BOOST_REQUIRE_EQUAL(to_json_string(*m, serialized), expected);
+
+    bytes_ostream out;
+    out.write("x", 1);
+    write_json(out, *m, serialized);
+    write_json(out, *int32_type, data_value(int32_t(7)).serialize_nonnull());
+    BOOST_REQUIRE_EQUAL(sstring(to_sstring_view(out.linearize())), sstring("x") + expected + "7");
+}
+
 BOOST_AUTO_TEST_CASE(test_set_to_string) {
     auto m = set_type_impl::get_instance(int32_type, true);
     using native_type = std::vector<data_value>;
@@ -13,6 +13,7 @@
 #include <boost/test/unit_test.hpp>
 #include <random>
 
+#include "utils/ascii.hh"
 #include "utils/utf8.hh"
 #include "utils/fragmented_temporary_buffer.hh"
 
@@ -223,3 +224,40 @@ BOOST_AUTO_TEST_CASE(test_utf8_fragmented) {
         BOOST_REQUIRE(result == bad_pos);
     }
 }
+
+// Sequences starting at every offset around the boundaries of 16 and
+// 32 byte blocks, surrounded by ASCII, which the vectorized paths skip.
+BOOST_AUTO_TEST_CASE(test_utf8_block_boundaries) {
+    auto check = [] (const char* data, size_t len, bool valid) {
+        for (size_t offset = 0; offset < 70; ++offset) {
+            std::vector<uint8_t> buf(offset, 'a');
+            buf.insert(buf.end(), data, data + len);
+            buf.insert(buf.end(), 70, 'b');
+            BOOST_CHECK_EQUAL(utils::utf8::validate(buf.data(), buf.size()), valid);
+        }
+    };
+    for (auto& test : positive) {
+        check(static_cast<const char*>(test.data), test.len, true);
+    }
+    for (auto& test : negative) {
+        check(static_cast<const char*>(test.data), test.len, false);
+    }
+    // Truncated sequences followed by ASCII.
+    for (auto seq : {"\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80"}) {
+        for (size_t len = 1; len < strlen(seq); ++len) {
+            check(seq, len, false);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(test_ascii) {
+    for (size_t len = 0; len < 200; ++len) {
+        std::vector<uint8_t> buf(len, 0x7f);
+        BOOST_CHECK(utils::ascii::validate(buf.data(), buf.size()));
+        for (size_t pos = 0; pos < len; ++pos) {
+            buf[pos] = 0x80;
+            BOOST_CHECK(!utils::ascii::validate(buf.data(), buf.size()));
+            buf[pos] = 0x7f;
+        }
+    }
+}
@@ -166,6 +166,35 @@ SEASTAR_TEST_CASE(test_builder_with_multiple_partitions_of_batch_size_rows) {
     });
 }
 
+// With view_building_concurrency above 1, the view updates of a batch are
+// sent while the following batches are read. All of them must be sent,
+// including those of the last, partial, batch of a step.
+SEASTAR_TEST_CASE(test_builder_with_concurrent_batches) {
+    cql_test_config cfg;
+    cfg.db_config->view_building_concurrency.set(4);
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        const int64_t rows = 5 * db::view::view_builder::batch_size + 7;
+        e.execute_cql("create table cf (p int, c int, v int, primary key (p, c))").get();
+
+        for (auto i = 0; i < rows; ++i) {
+            e.execute_cql(format("insert into cf (p, c, v) values ({:d}, {:d}, 0)", i % 3, i)).get();
+        }
+
+        auto f = e.local_view_builder().wait_until_built("ks", "vcf");
+        e.execute_cql("create materialized view vcf as select * from cf "
+                      "where p is not null and c is not null and v is not null "
+                      "primary key (v, c, p)").get();
+
+        f.get();
+        auto built = db::system_keyspace::load_built_views().get0();
+        BOOST_REQUIRE_EQUAL(built.size(), 1);
+        BOOST_REQUIRE_EQUAL(built[0].second, sstring("vcf"));
+
+        auto msg = e.execute_cql("select count(*) from vcf where v = 0").get0();
+        assert_that(msg).is_rows().with_rows({{{long_type->decompose(rows)}}});
+    }, std::move(cfg));
+}
+
 SEASTAR_TEST_CASE(test_builder_view_added_during_ongoing_build) {
     return do_with_cql_env_thread([] (cql_test_env& e) {
         e.execute_cql("create table cf (p int, c int, v int, primary key (p, c))").get();
@@ -805,56 +834,58 @@ SEASTAR_THREAD_TEST_CASE(test_view_update_generator_buffering) {
     }));
     std::ranges::sort(pkeys, dht::ring_position_less_comparator(*schema));
 
-    for (auto partition_sizes_100kb : partition_size_sets) {
-        testlog.debug("partition_sizes_100kb={}", partition_sizes_100kb);
-        partition_size_map partition_rows{dht::ring_position_less_comparator(*schema)};
-        std::vector<mutation> muts;
-        auto pk = 0;
-        for (auto partition_size_100kb : partition_sizes_100kb) {
-            auto mut_desc = tests::data_model::mutation_description(pkeys.at(pk++).key().explode(*schema));
-            for (auto ck = 0; ck < partition_size_100kb; ++ck) {
-                mut_desc.add_clustered_cell({int32_type->decompose(data_value(ck))}, "v", tests::data_model::mutation_description::value(blob_100kb));
+    for (size_t concurrency : {1, 4}) {
+        for (auto partition_sizes_100kb : partition_size_sets) {
+            testlog.debug("partition_sizes_100kb={} concurrency={}", partition_sizes_100kb, concurrency);
+            partition_size_map partition_rows{dht::ring_position_less_comparator(*schema)};
+            std::vector<mutation> muts;
+            auto pk = 0;
+            for (auto partition_size_100kb : partition_sizes_100kb) {
+                auto mut_desc = tests::data_model::mutation_description(pkeys.at(pk++).key().explode(*schema));
+                for (auto ck = 0; ck < partition_size_100kb; ++ck) {
+                    mut_desc.add_clustered_cell({int32_type->decompose(data_value(ck))}, "v", tests::data_model::mutation_description::value(blob_100kb));
+                }
+                muts.push_back(mut_desc.build(schema));
+                partition_rows.emplace(muts.back().decorated_key(), partition_size_100kb);
             }
-            muts.push_back(mut_desc.build(schema));
-            partition_rows.emplace(muts.back().decorated_key(), partition_size_100kb);
-        }
 
-        std::ranges::sort(muts, [less = dht::ring_position_less_comparator(*schema)] (const mutation& a, const mutation& b) {
-            return less(a.decorated_key(), b.decorated_key());
-        });
+            std::ranges::sort(muts, [less = dht::ring_position_less_comparator(*schema)] (const mutation& a, const mutation& b) {
+                return less(a.decorated_key(), b.decorated_key());
+            });
 
-        auto permit = sem.obtain_permit(schema.get(), get_name(), replica::new_reader_base_cost, db::no_timeout).get0();
+            auto permit = sem.obtain_permit(schema.get(), get_name(), replica::new_reader_base_cost, db::no_timeout).get0();
 
-        auto mt = make_lw_shared<replica::memtable>(schema);
-        for (const auto& mut : muts) {
-            mt->apply(mut);
-        }
+            auto mt = make_lw_shared<replica::memtable>(schema);
+            for (const auto& mut : muts) {
+                mt->apply(mut);
+            }
 
-        auto p = make_manually_paused_evictable_reader_v2(
-                mt->as_data_source(),
-                schema,
-                permit,
-                query::full_partition_range,
-                schema->full_slice(),
-                service::get_local_streaming_priority(),
-                nullptr,
-                ::mutation_reader::forwarding::no);
-        auto& staging_reader = std::get<0>(p);
-        auto& staging_reader_handle = std::get<1>(p);
-        auto close_staging_reader = deferred_close(staging_reader);
-
-        std::vector<mutation> collected_muts;
-        bool ok = true;
-
-        staging_reader.consume_in_thread(db::view::view_updating_consumer(schema, permit, as, staging_reader_handle,
-                    consumer_verifier(schema, sem, partition_rows, collected_muts, ok)));
-
-        BOOST_REQUIRE(ok);
-
-        BOOST_REQUIRE_EQUAL(muts.size(), collected_muts.size());
-        for (size_t i = 0; i < muts.size(); ++i) {
-            testlog.trace("compare mutation {}", i);
-            BOOST_REQUIRE_EQUAL(muts[i], collected_muts[i]);
+            auto p = make_manually_paused_evictable_reader_v2(
+                    mt->as_data_source(),
+                    schema,
+                    permit,
+                    query::full_partition_range,
+                    schema->full_slice(),
+                    service::get_local_streaming_priority(),
+                    nullptr,
+                    ::mutation_reader::forwarding::no);
+            auto& staging_reader = std::get<0>(p);
+            auto& staging_reader_handle = std::get<1>(p);
+            auto close_staging_reader = deferred_close(staging_reader);
+
+            std::vector<mutation> collected_muts;
+            bool ok = true;
+
+            staging_reader.consume_in_thread(db::view::view_updating_consumer(schema, permit, as, staging_reader_handle,
+                        consumer_verifier(schema, sem, partition_rows, collected_muts, ok), concurrency));
+
+            BOOST_REQUIRE(ok);
+
+            BOOST_REQUIRE_EQUAL(muts.size(), collected_muts.size());
+            for (size_t i = 0; i < muts.size(); ++i) {
+                testlog.trace("compare mutation {}", i);
+                BOOST_REQUIRE_EQUAL(muts[i], collected_muts[i]);
+            }
         }
     }
 }
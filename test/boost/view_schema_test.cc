@@ -3161,3 +3161,36 @@ SEASTAR_TEST_CASE(test_mv_allow_some_column_drops) {
         BOOST_REQUIRE_THROW(e.execute_cql("alter table cf2 drop d").get(), exceptions::invalid_request_exception);
     });
 }
+
+// Updates which only write columns that are neither in the view nor
+// restricted by its filter don't generate view updates.
+SEASTAR_TEST_CASE(test_update_of_unselected_columns) {
+    return do_with_cql_env_thread([] (cql_test_env& e) {
+        e.execute_cql("create table cf (p int primary key, a int, b int, c int, d int)").get();
+        e.execute_cql("create materialized view mv as select c from cf where a is not null and p is not null and b = 3 primary key (a, p)").get();
+        auto pushed_updates = [&] {
+            return e.db().map_reduce0([] (replica::database& db) {
+                return db.cf_stats()->total_view_updates_pushed_local + db.cf_stats()->total_view_updates_pushed_remote;
+            }, uint64_t(0), std::plus<uint64_t>()).get0();
+        };
+
+        e.execute_cql("insert into cf (p, a, b, c, d) values (1, 2, 3, 4, 5)").get();
+        eventually([&] {
+            auto res = e.execute_cql("select a, p, c from mv").get0();
+            assert_that(res).is_rows().with_rows({{{int32_type->decompose(2)}, {int32_type->decompose(1)}, {int32_type->decompose(4)}}});
+        });
+        auto pushed = pushed_updates();
+        BOOST_REQUIRE_GT(pushed, 0);
+
+        e.execute_cql("update cf set d = 6 where p = 1").get();
+        BOOST_REQUIRE_EQUAL(pushed_updates(), pushed);
+
+        // A column of the filter isn't selected, but changes the view.
+        e.execute_cql("update cf set b = 7 where p = 1").get();
+        eventually([&] {
+            auto res = e.execute_cql("select a, p, c from mv").get0();
+            assert_that(res).is_rows().is_empty();
+        });
+        BOOST_REQUIRE_GT(pushed_updates(), pushed);
+    });
+}
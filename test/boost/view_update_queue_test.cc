@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <seastar/core/later.hh>
+#include <seastar/core/shared_future.hh>
+#include <seastar/testing/thread_test_case.hh>
+
+#include "db/view/view_update_queue.hh"
+#include "mutation.hh"
+#include "test/lib/simple_schema.hh"
+
+using update = db::view::view_update_queue::update;
+
+static const gms::inet_address target("127.0.0.2");
+
+static update make_update(simple_schema& ss, const mutation& m, db::timeout_semaphore& sem) {
+    return update{
+        .mut = {freeze(m), ss.schema()},
+        .target = target,
+        .view_token = m.token(),
+        .units = seastar::consume_units(sem, 1),
+    };
+}
+
+SEASTAR_THREAD_TEST_CASE(test_view_update_queue_coalescing) {
+    simple_schema ss;
+    db::timeout_semaphore sem(100);
+    shared_promise<> release;
+    std::vector<update> sent;
+    db::view::view_update_queue q([&] (update& u) {
+        return release.get_shared_future().then([&] {
+            sent.push_back(std::move(u));
+        });
+    }, 1);
+
+    auto pk = ss.make_pkey(0);
+    auto other_pk = ss.make_pkey(1);
+    auto make_mutation = [&] (const dht::decorated_key& pk, int ck) {
+        mutation m(ss.schema(), pk);
+        ss.add_row(m, ss.make_ckey(ck), "v");
+        return m;
+    };
+
+    auto m1 = make_mutation(pk, 1);
+    auto m2 = make_mutation(pk, 2);
+
+    // The first update is being sent, so the following ones have to wait.
+    BOOST_REQUIRE(!q.push(make_update(ss, make_mutation(pk, 0), sem)));
+    BOOST_REQUIRE(!q.push(make_update(ss, m1, sem)));
+    BOOST_REQUIRE(!q.push(make_update(ss, make_mutation(other_pk, 0), sem)));
+    BOOST_REQUIRE(q.push(make_update(ss, m2, sem)));
+    BOOST_REQUIRE_EQUAL(q.queued(), 2);
+    BOOST_REQUIRE_EQUAL(q.coalesced(), 1);
+    // Merged updates keep their semaphore units.
+    BOOST_REQUIRE_EQUAL(sem.available_units(), 96);
+
+    release.set_value();
+    while (sent.size() < 3) {
+        yield().get();
+    }
+    BOOST_REQUIRE_EQUAL(q.queued(), 0);
+    BOOST_REQUIRE_EQUAL(sent[1].merged, 2);
+    BOOST_REQUIRE_EQUAL(sent[2].merged, 1);
+    BOOST_REQUIRE_EQUAL(sent[1].mut.fm.unfreeze(ss.schema()), m1 + m2);
+    sent.clear();
+    BOOST_REQUIRE_EQUAL(sem.available_units(), 100);
+}
+
+// Stopping the queue waits for the queued updates to be sent, and
+// rejects new ones meanwhile.
+SEASTAR_THREAD_TEST_CASE(test_view_update_queue_stop) {
+    simple_schema ss;
+    db::timeout_semaphore sem(100);
+    promise<> release;
+    size_t sent = 0;
+    db::view::view_update_queue q([&] (update&) {
+        return release.get_future().then([&] {
+            ++sent;
+        });
+    }, 1);
+
+    mutation m(ss.schema(), ss.make_pkey(0));
+    ss.add_row(m, ss.make_ckey(0), "v");
+    BOOST_REQUIRE(!q.push(make_update(ss, m, sem)));
+
+    auto stopped = q.stop();
+    yield().get();
+    BOOST_REQUIRE(!stopped.available());
+    BOOST_REQUIRE_THROW(q.push(make_update(ss, m, sem)), seastar::gate_closed_exception);
+
+    release.set_value();
+    stopped.get();
+    BOOST_REQUIRE_EQUAL(sent, 1);
+    BOOST_REQUIRE_EQUAL(q.queued(), 0);
+    BOOST_REQUIRE_EQUAL(sem.available_units(), 100);
+
+    // The queue is usable again once stopped.
+    release = promise<>();
+    release.set_value();
+    BOOST_REQUIRE(!q.push(make_update(ss, m, sem)));
+    q.stop().get();
+    BOOST_REQUIRE_EQUAL(sent, 2);
+}
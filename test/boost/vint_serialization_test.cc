@@ -17,6 +17,7 @@
 #include <array>
 #include <cstdint>
 #include <random>
+#include <vector>
 
 using namespace seastar;
 
@@ -137,3 +138,53 @@ BOOST_AUTO_TEST_CASE(sanity_signed_examples) {
 BOOST_AUTO_TEST_CASE(sanity_signed_sweep) {
     check_roundtrip_sweep<signed_vint>(100'000, random_engine());
 }
+
+BOOST_AUTO_TEST_CASE(deserialize_many) {
+    auto& rng = random_engine();
+    // Mostly short vints, with runs long enough for the vectorized path.
+    std::uniform_int_distribution<int> bits_distribution(0, 64);
+    std::uniform_int_distribution<uint64_t> value_distribution;
+
+    std::vector<uint64_t> values;
+    for (int i = 0; i < 10'000; ++i) {
+        auto bits = bits_distribution(rng);
+        auto value = value_distribution(rng);
+        if (bits < 32) {
+            value &= 0x7f;
+        } else if (bits < 64) {
+            value >>= bits;
+        }
+        values.push_back(value);
+    }
+
+    bytes serialized(bytes::initialized_later(), values.size() * max_vint_length);
+    auto out = serialized.begin();
+    std::vector<size_t> ends;
+    for (auto v : values) {
+        out += unsigned_vint::serialize(v, out);
+        ends.push_back(out - serialized.begin());
+    }
+    const size_t total_size = out - serialized.begin();
+
+    std::vector<uint64_t> decoded(values.size());
+    auto in = bytes_view(serialized.data(), total_size);
+    size_t n = 0;
+    while (n < values.size()) {
+        // Use output chunks of varying size.
+        auto chunk = std::min<size_t>(values.size() - n, 1 + n % 100);
+        auto decoded_now = unsigned_vint::deserialize_many(in, std::span(decoded.data() + n, chunk));
+        BOOST_REQUIRE_EQUAL(decoded_now, chunk);
+        n += decoded_now;
+        BOOST_REQUIRE_EQUAL(total_size - in.size(), ends[n - 1]);
+    }
+    BOOST_REQUIRE(in.empty());
+    BOOST_REQUIRE(decoded == values);
+
+    // A vint which is not fully contained in the input is not decoded.
+    for (size_t i = 0; i < 100; ++i) {
+        auto truncated = bytes_view(serialized.data(), ends[i] - 1);
+        auto n = unsigned_vint::deserialize_many(truncated, std::span(decoded.data(), values.size()));
+        BOOST_REQUIRE_EQUAL(n, i);
+        BOOST_REQUIRE_EQUAL(truncated.size(), ends[i] - 1 - (i ? ends[i - 1] : 0));
+    }
+}
@@ -0,0 +1,33 @@
+# Copyright 2026-present ScyllaDB
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+
+#############################################################################
+# Tests for logging in with a password
+#############################################################################
+
+import pytest
+from cassandra.cluster import NoHostAvailable
+from util import cql_session, new_user
+
+def login(cql, username, password):
+    endpoint = cql.hosts[0].endpoint
+    with cql_session(host=endpoint.address, port=endpoint.port, ssl=False, username=username, password=password) as session:
+        session.execute("SELECT * FROM system.local")
+
+# Scylla remembers the passwords which were recently verified, so that
+# reconnecting clients don't hash them over and over. A remembered password
+# must not let in a wrong password, nor the old password once it's changed.
+def test_remembered_password(cql):
+    with new_user(cql) as username:
+        # new_user() sets the password to the user name.
+        for _ in range(3):
+            login(cql, username, username)
+        with pytest.raises(NoHostAvailable, match="password"):
+            login(cql, username, username + 'x')
+        login(cql, username, username)
+
+        cql.execute(f"ALTER ROLE {username} WITH PASSWORD = '{username}2'")
+        with pytest.raises(NoHostAvailable, match="password"):
+            login(cql, username, username)
+        login(cql, username, username + '2')
@@ -123,3 +123,41 @@ def test_grant_revoke_data_permissions(cql, test_keyspace):
                 # Same for DROP
                 cql.execute(f"CREATE TABLE IF NOT EXISTS {keyspace}.{t}(id int primary key)")
                 check_enforced(cql, username, permission='DROP', resource='ALL KEYSPACES', function=drop_table_idempotent)
+
+# Changes of permissions and roles made through a node apply to the next
+# requests to that node, without waiting for the cached permissions to be
+# refreshed. The caches are made to outlive the test, so only invalidation
+# can make the changes visible in time.
+def test_permission_changes_apply_immediately(scylla_only, cql, test_keyspace):
+    def set_config(name, value):
+        cql.execute(f"UPDATE system.config SET value = '{value}' WHERE name = '{name}'")
+    old = {r.name: r.value for r in cql.execute("SELECT name, value FROM system.config WHERE name IN ('permissions_validity_in_ms', 'permissions_update_interval_in_ms')")}
+    set_config('permissions_validity_in_ms', 600000)
+    set_config('permissions_update_interval_in_ms', 600000)
+    try:
+        with new_test_table(cql, test_keyspace, "a int primary key") as table, new_user(cql) as username:
+            with new_session(cql, username) as user_session:
+                select = user_session.prepare(f"SELECT * FROM {table}")
+                with pytest.raises(Unauthorized):
+                    user_session.execute(select)
+                grant(cql, 'SELECT', f'TABLE {table}', username)
+                user_session.execute(select)
+                revoke(cql, 'SELECT', f'TABLE {table}', username)
+                with pytest.raises(Unauthorized):
+                    user_session.execute(select)
+
+                # Permissions inherited from a role.
+                role = unique_name()
+                cql.execute(f"CREATE ROLE {role}")
+                try:
+                    grant(cql, 'SELECT', f'TABLE {table}', role)
+                    cql.execute(f"GRANT {role} TO {username}")
+                    user_session.execute(select)
+                    cql.execute(f"REVOKE {role} FROM {username}")
+                    with pytest.raises(Unauthorized):
+                        user_session.execute(select)
+                finally:
+                    cql.execute(f"DROP ROLE {role}")
+    finally:
+        set_config('permissions_update_interval_in_ms', old['permissions_update_interval_in_ms'])
+        set_config('permissions_validity_in_ms', old['permissions_validity_in_ms'])
@@ -849,3 +849,21 @@ def test_index_quoted_names(cql, test_keyspace):
         cql.execute(f'INSERT INTO {table} (pk, ck, {names}) VALUES (1, 2, {values})')
         for name in quoted_names:
             assert [(1,2)] == list(cql.execute(f'SELECT pk,ck FROM {table} WHERE {name} CONTAINS KEY 3'))
+
+# A local index query reads the base rows with the same indexed value of a
+# partition together. Check that the rows are still returned in the order
+# of the index - by indexed value, then by clustering key - with and without
+# paging, also when the clustering key is in descending order.
+@pytest.mark.parametrize("order", ["ASC", "DESC"])
+def test_local_index_rows_order(scylla_only, cql, test_keyspace, order):
+    schema = 'p int, c int, v int, x int, PRIMARY KEY (p, c)'
+    with new_test_table(cql, test_keyspace, schema, f"WITH CLUSTERING ORDER BY (c {order})") as table:
+        cql.execute(f"CREATE INDEX ON {table}((p), v)")
+        stmt = cql.prepare(f"INSERT INTO {table} (p, c, v, x) VALUES (?, ?, ?, ?)")
+        for c in range(20):
+            cql.execute(stmt, [1, c, c % 3, c * 10])
+            cql.execute(stmt, [2, c, c % 3, c * 10])
+        expected = sorted([(1, c, c * 10) for c in range(20) if c % 3 == 1], key=lambda r: r[1], reverse=(order == "DESC"))
+        for fetch_size in [None, 1, 4]:
+            s = SimpleStatement(f"SELECT p, c, x FROM {table} WHERE p = 1 AND v = 1", fetch_size=fetch_size)
+            assert expected == [(r.p, r.c, r.x) for r in cql.execute(s)]
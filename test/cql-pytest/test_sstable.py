@@ -14,6 +14,7 @@
 import pytest
 from util import unique_name, new_test_table
 import nodetool
+from cassandra.protocol import ConfigurationException
 
 # Reproduces issue #8138, where the sstable reader in a TWCS sstable set
 # had a bug and resulted in no results for queries.
@@ -36,3 +37,23 @@ def test_twcs_optimal_query_path(cql, test_keyspace, scylla_only):
         # in the debug build.
         nodetool.flush(cql, table)
         assert 1 == len(list(cql.execute(f"SELECT * FROM {table} WHERE pk = 0 BYPASS CACHE")))
+
+# Check that crc_check_chance set on a table is kept in the schema, that
+# data read back from the disk is still correct with chunk checksums only
+# sometimes verified, and that values outside [0, 1] are rejected.
+def test_crc_check_chance(cql, test_keyspace, scylla_only):
+    with new_test_table(cql, test_keyspace, "pk int, ck int, v int, PRIMARY KEY (pk, ck)",
+            " WITH crc_check_chance = 0.5") as table:
+        ks, cf = table.split('.')
+        assert list(cql.execute(f"SELECT crc_check_chance FROM system_schema.tables WHERE keyspace_name = '{ks}' AND table_name = '{cf}'"))[0].crc_check_chance == 0.5
+        stmt = cql.prepare(f"INSERT INTO {table} (pk, ck, v) VALUES (0, ?, ?)")
+        for i in range(100):
+            cql.execute(stmt, [i, i])
+        nodetool.flush(cql, table)
+        assert [(r.ck, r.v) for r in cql.execute(f"SELECT ck, v FROM {table} WHERE pk = 0 BYPASS CACHE")] == [(i, i) for i in range(100)]
+
+@pytest.mark.parametrize("chance", [-0.1, 1.1])
+def test_invalid_crc_check_chance(cql, test_keyspace, chance):
+    with pytest.raises(ConfigurationException):
+        with new_test_table(cql, test_keyspace, "a int PRIMARY KEY", f"WITH crc_check_chance = {chance}") as table:
+            pass
@@ -15,6 +15,7 @@ import pytest
 import subprocess
 import tempfile
 import random
+import shutil
 import util
 
 # To run the Scylla tools, we need to run Scylla executable itself, so we
@@ -259,3 +260,64 @@ def test_scylla_sstable_write(cql, test_keyspace, scylla_path, scylla_data_dir,
             actual_json = json.loads(actual_out)["sstables"]["anonymous"]
 
             assert actual_json == original_json
+
+
+@pytest.mark.parametrize("table_factory", [
+        simple_clustering_table,
+        clustering_table_with_collection,
+])
+def test_scylla_sstable_aggregate_stats(cql, test_keyspace, scylla_path, scylla_data_dir, table_factory):
+    with scylla_sstable(table_factory, cql, test_keyspace, scylla_data_dir) as (schema_file, sstables):
+        args = [scylla_path, "sstable", "aggregate-stats", "--schema-file", schema_file]
+        single_shard_stats = json.loads(subprocess.check_output(args + sstables))
+        # Spreading the sstables across shards must not change the result.
+        multi_shard_stats = json.loads(subprocess.check_output(args + ["--smp", "2"] + sstables))
+
+    assert single_shard_stats["sstables"] == len(sstables)
+    assert single_shard_stats["partitions"] > 0
+    assert sum(single_shard_stats["partition_size_histogram"].values()) == single_shard_stats["partitions"]
+    assert "v" in single_shard_stats["column_sizes"]
+    assert multi_shard_stats == single_shard_stats
+
+
+@pytest.mark.parametrize("operation,args", [
+        ("compact", []),
+        ("compact", ["--smp", "2"]),
+        ("recompress", ["--compression", "sstable_compression=ZstdCompressor", "--compression", "chunk_length_in_kb=16"]),
+        ("recompress", ["--compression", "sstable_compression=", "--smp", "2"]),
+])
+def test_scylla_sstable_rewrite(cql, test_keyspace, scylla_path, scylla_data_dir, operation, args):
+    with scylla_sstable(simple_clustering_table, cql, test_keyspace, scylla_data_dir) as (schema_file, sstables):
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            dump_common_args = [scylla_path, "sstable", "dump-data", "--schema-file", schema_file, "--output-format", "json", "--merge"]
+            original_json = json.loads(subprocess.check_output(dump_common_args + sstables))["sstables"]["anonymous"]
+
+            subprocess.check_call([scylla_path, "sstable", operation, "--schema-file", schema_file, "--output-dir", tmp_dir,
+                                   "--generation", str(util.unique_key_int())] + args + sstables)
+
+            new_sstables = glob.glob(os.path.join(tmp_dir, '*-Data.db'))
+            assert new_sstables
+
+            actual_json = json.loads(subprocess.check_output(dump_common_args + new_sstables))["sstables"]["anonymous"]
+
+            assert actual_json == original_json
+
+
+def test_scylla_sstable_set_repaired_at(cql, test_keyspace, scylla_path, scylla_data_dir):
+    with scylla_sstable(simple_clustering_table, cql, test_keyspace, scylla_data_dir) as (schema_file, sstables):
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            # Work on a copy, the original sstable belongs to the running node.
+            prefix = sstables[0][:-len("Data.db")]
+            for component in glob.glob(prefix + "*"):
+                shutil.copy(component, tmp_dir)
+            sstable = os.path.join(tmp_dir, os.path.basename(sstables[0]))
+
+            def repaired_at():
+                out = subprocess.check_output([scylla_path, "sstable", "dump-statistics", "--schema-file", schema_file, sstable])
+                return json.loads(out)["sstables"][sstable]["stats"]["repaired_at"]
+
+            assert repaired_at() == 0
+            subprocess.check_call([scylla_path, "sstable", "set-repaired-at", "--schema-file", schema_file, "--repaired-at", "1234", sstable])
+            assert repaired_at() == 1234
+            subprocess.check_call([scylla_path, "sstable", "set-repaired-at", "--schema-file", schema_file, "--repaired-at", "0", sstable])
+            assert repaired_at() == 0
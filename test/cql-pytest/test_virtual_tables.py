@@ -34,12 +34,56 @@ def test_clients(scylla_only, cql):
         'ssl_enabled',
         'ssl_protocol',
         'username',
+        'requests_for_other_shards',
     ])
     cls = list(cql.execute(f"SELECT {columns} FROM system.clients"))
     for cl in cls:
         assert(cl[0] == '127.0.0.1')
         assert(cl[2] == 'cql')
 
+def _requests_for_other_shards(cql):
+    return sum(r.requests_for_other_shards or 0 for r in cql.execute("SELECT requests_for_other_shards FROM system.clients"))
+
+# Executing prepared statements for partitions of other shards than the one
+# of the connection is counted in system.clients, if enabled. Clearing the
+# statement's routing key indexes stops the driver from sending each request
+# to the connection of the owning shard.
+def test_clients_requests_for_other_shards(scylla_only, cql, test_keyspace):
+    if len({r.shard_id for r in cql.execute("SELECT shard_id FROM system.clients")}) < 2:
+        pytest.skip("needs more than one shard")
+    with util.new_test_table(cql, test_keyspace, 'pk int PRIMARY KEY, v int') as table:
+        insert = cql.prepare(f"INSERT INTO {table} (pk, v) VALUES (?, ?)")
+        insert.routing_key_indexes = None
+        requests = 100
+        try:
+            for enabled in [True, False]:
+                cql.execute(f"UPDATE system.config SET value = '{str(enabled).lower()}' WHERE name = 'count_requests_for_other_shards'")
+                before = _requests_for_other_shards(cql)
+                for pk in range(requests):
+                    cql.execute(insert, [pk, pk])
+                counted = _requests_for_other_shards(cql) - before
+                if enabled:
+                    assert 0 < counted <= requests
+                else:
+                    assert counted == 0
+        finally:
+            cql.execute("UPDATE system.config SET value = 'false' WHERE name = 'count_requests_for_other_shards'")
+
+# Statements which aren't for a single partition, like ones with an IN
+# restriction on the partition key, are never counted.
+def test_clients_requests_for_other_shards_in(scylla_only, cql, test_keyspace):
+    with util.new_test_table(cql, test_keyspace, 'pk int PRIMARY KEY, v int') as table:
+        select = cql.prepare(f"SELECT v FROM {table} WHERE pk IN (?, ?)")
+        select.routing_key_indexes = None
+        try:
+            cql.execute("UPDATE system.config SET value = 'true' WHERE name = 'count_requests_for_other_shards'")
+            before = _requests_for_other_shards(cql)
+            for pk in range(100):
+                cql.execute(select, [pk, pk + 1])
+            assert _requests_for_other_shards(cql) == before
+        finally:
+            cql.execute("UPDATE system.config SET value = 'false' WHERE name = 'count_requests_for_other_shards'")
+
 # We only want to check that the table exists with the listed columns, to assert
 # backwards compatibility.
 def _check_exists(cql, table_name, columns):
@@ -55,6 +99,45 @@ def test_runtime_info(scylla_only, cql):
 def test_versions(scylla_only, cql):
     _check_exists(cql, "versions", ("key", "build_id", "build_mode", "version"))
 
+# A partition read and written over and over is among the top partitions of
+# both kinds. The window is ended early with an error injection, so the
+# test is skipped in release builds.
+def test_hot_partitions(scylla_only, cql, test_keyspace):
+    with util.new_test_table(cql, test_keyspace, 'pk int PRIMARY KEY, v int') as table:
+        ks, tbl = table.split('.')
+        write = cql.prepare(f"UPDATE {table} SET v = ? WHERE pk = 1")
+        read = cql.prepare(f"SELECT v FROM {table} WHERE pk = 1")
+        for i in range(200):
+            cql.execute(write, [i])
+            cql.execute(read)
+        with util.scylla_inject_error(nodetool.rest_api_url(cql), "hot_partitions_end_window", one_shot=True):
+            rows = list(cql.execute("SELECT kind, rank, keyspace_name, table_name, partition_key, count, error FROM system.hot_partitions"))
+        for r in rows:
+            assert r.kind in ('read', 'write', 'large_write')
+            assert r.count >= r.error
+        for kind in ('read', 'write'):
+            assert any(r.kind == kind and r.keyspace_name == ks and r.table_name == tbl and r.partition_key == '1' and r.count > 0 for r in rows)
+
+# A read of a table shows up in system.read_costs once its permit is gone,
+# which for a single partition read is when the read completes. The costs
+# of a table are forgotten when it's dropped. Only reads started while
+# track_read_costs is enabled are counted.
+def test_read_costs(scylla_only, cql, test_keyspace):
+    with util.new_test_table(cql, test_keyspace, 'pk int PRIMARY KEY, v int') as table:
+        cql.execute(f"INSERT INTO {table} (pk, v) VALUES (0, 0)")
+        ks, tbl = table.split('.')
+        cql.execute(f"SELECT * FROM {table} WHERE pk = 0")
+        assert list(cql.execute(f"SELECT reads FROM system.read_costs WHERE keyspace_name = '{ks}' AND table_name = '{tbl}'")) == []
+        try:
+            cql.execute("UPDATE system.config SET value = 'true' WHERE name = 'track_read_costs'")
+            cql.execute(f"SELECT * FROM {table} WHERE pk = 0")
+        finally:
+            cql.execute("UPDATE system.config SET value = 'false' WHERE name = 'track_read_costs'")
+        res = list(cql.execute(f"SELECT reads, disk_reads, disk_bytes_read, sstables_read, active_time_us FROM system.read_costs WHERE keyspace_name = '{ks}' AND table_name = '{tbl}'"))
+        assert len(res) == 1
+        assert res[0].reads >= 1
+    assert list(cql.execute(f"SELECT reads FROM system.read_costs WHERE keyspace_name = '{ks}' AND table_name = '{tbl}'")) == []
+
 # Check reading the system.config table, which should list all configuration
 # parameters. As we noticed in issue #10047, each type of configuration
 # parameter can have a different function for printing it out, and some of
@@ -657,6 +657,9 @@ class single_node_cql_env : public cql_test_env {
                     .available_memory = dbcfg.available_memory,
                     .static_shares = cfg->compaction_static_shares,
                     .throughput_mb_per_sec = cfg->compaction_throughput_mb_per_sec,
+                    .major_compaction_parallelism = cfg->major_compaction_parallelism,
+                    .read_latency_objective_us = cfg->compaction_read_latency_objective_us,
+                    .read_queue_length_objective = cfg->compaction_read_queue_length_objective,
                 };
             });
             cm.start(std::move(get_cm_cfg), std::ref(abort_sources)).get();
@@ -7,10 +7,15 @@
  */
 
 #include "perf.hh"
+#include <cmath>
+#include <fstream>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/classification.hpp>
 #include <seastar/core/reactor.hh>
 #include <seastar/core/memory.hh>
 #include "seastarx.hh"
 #include "reader_concurrency_semaphore.hh"
+#include "release.hh"
 
 
 uint64_t perf_mallocs() {
@@ -85,4 +90,67 @@ reader_permit reader_concurrency_semaphore_wrapper::make_permit() {
     return _semaphore->make_tracking_only_permit(nullptr, "perf", db::no_timeout);
 }
 
+metric_stats compute_stats(std::vector<double> values) {
+    assert(!values.empty());
+    std::sort(values.begin(), values.end());
+    auto median = values[values.size() / 2];
+    std::vector<double> deviations;
+    for (auto v : values) {
+        deviations.push_back(std::abs(v - median));
+    }
+    std::sort(deviations.begin(), deviations.end());
+    return metric_stats{
+        .median = median,
+        .mad = deviations[deviations.size() / 2],
+        .min = values.front(),
+        .max = values.back(),
+    };
+}
+
+json_result::json_result(std::string test_type) {
+    _root["test_properties"]["type"] = std::move(test_type);
+    _root["parameters"]["cpus"] = smp::count;
+
+    // <version>-<release>
+    auto version_components = std::vector<std::string>{};
+    auto sver = scylla_version();
+    boost::algorithm::split(version_components, sver, boost::is_any_of("-"));
+    // <scylla-build>.<date>.<git-hash>
+    auto release_components = std::vector<std::string>{};
+    boost::algorithm::split(release_components, version_components[1], boost::is_any_of("."));
+
+    Json::Value version;
+    version["commit_id"] = release_components[2];
+    version["date"] = release_components[1];
+    version["version"] = version_components[0];
+
+    // It'd be nice to have std::chrono::format(), wouldn't it?
+    auto current_time = std::time(nullptr);
+    char time_str[100];
+    ::tm time_buf;
+    std::strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", ::localtime_r(&current_time, &time_buf));
+    version["run_date_time"] = time_str;
+
+    _root["versions"]["scylla-server"] = std::move(version);
+}
+
+void json_result::add_metric(const std::string& name, std::vector<double> values, better b) {
+    auto st = compute_stats(values);
+    Json::Value m;
+    m["median"] = st.median;
+    m["mad"] = st.mad;
+    m["min"] = st.min;
+    m["max"] = st.max;
+    m["better"] = b == better::higher ? "higher" : "lower";
+    for (auto v : values) {
+        m["values"].append(v);
+    }
+    _root["metrics"][name] = std::move(m);
+}
+
+void json_result::write(const std::string& file) const {
+    auto out = std::ofstream(file);
+    out << _root;
+}
+
 } // namespace perf
@@ -23,6 +23,7 @@
 #include <chrono>
 #include <iosfwd>
 #include <boost/range/irange.hpp>
+#include <json/json.h>
 
 template <typename Func>
 static
@@ -281,4 +282,65 @@ class reader_concurrency_semaphore_wrapper {
     reader_permit make_permit();
 };
 
+// Statistics of a metric over repeated runs of a benchmark.
+struct metric_stats {
+    double median;
+    // Median absolute deviation, a spread measure which, unlike standard
+    // deviation, isn't thrown off by a single outlier run.
+    double mad;
+    double min;
+    double max;
+};
+
+metric_stats compute_stats(std::vector<double> values);
+
+// Which direction of change of a metric is an improvement.
+enum class better { higher, lower };
+
+// Result of a benchmark in the json schema shared by the perf_* tools:
+//
+//   {
+//     "test_properties": {"type": <test>},
+//     "parameters": {<name>: <value>, ...},
+//     "stats": {<name>: <value>, ...},
+//     "metrics": {
+//       <name>: {"median": .., "mad": .., "min": .., "max": .., "better": "higher"|"lower", "values": [..]},
+//       ...
+//     },
+//     "versions": {"scylla-server": {"version": .., "date": .., "commit_id": .., "run_date_time": ..}}
+//   }
+//
+// "metrics" hold all runs, so that results of two builds can be compared
+// with test/perf/perf_compare.py. "stats" are free-form scalars, kept for
+// the consumers of the older, per-tool results.
+class json_result {
+    Json::Value _root;
+public:
+    explicit json_result(std::string test_type);
+
+    Json::Value& parameters() { return _root["parameters"]; }
+    Json::Value& stats() { return _root["stats"]; }
+
+    void add_metric(const std::string& name, std::vector<double> values, better b);
+
+    // Adds throughput and the per operation counts of time_parallel() runs.
+    template <typename Res>
+    requires std::is_base_of_v<perf_result, Res>
+    void add_perf_results(const std::vector<Res>& results) {
+        auto metric = [&] (const char* name, double perf_result::*field, better b) {
+            std::vector<double> values;
+            for (const perf_result& r : results) {
+                values.push_back(r.*field);
+            }
+            add_metric(name, std::move(values), b);
+        };
+        metric("tps", &perf_result::throughput, better::higher);
+        metric("allocs_per_op", &perf_result::mallocs_per_op, better::lower);
+        metric("tasks_per_op", &perf_result::tasks_per_op, better::lower);
+        metric("instructions_per_op", &perf_result::instructions_per_op, better::lower);
+    }
+
+    void write(const std::string& file) const;
+};
+
 } // namespace perf
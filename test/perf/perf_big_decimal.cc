@@ -23,6 +23,10 @@ struct big_decimal_test {
     const sstring neg_data_neg_exponent = "-" + make_random_numeric_string(18) + "E-" + make_random_numeric_string(7);
     const sstring neg_data_fraction_exponent = "-" + make_random_numeric_string(14) + "E" + make_random_numeric_string(6);
     const sstring neg_data_fraction_neg_exponent = "-" + make_random_numeric_string(14) + "E-" + make_random_numeric_string(6);
+
+    const big_decimal price{make_random_numeric_string(6) + "." + make_random_numeric_string(2)};
+    const big_decimal other_price{make_random_numeric_string(6) + "." + make_random_numeric_string(2)};
+    const big_decimal rate{"0." + make_random_numeric_string(6)};
 };
 
 PERF_TEST_F(big_decimal_test, from_string) {
@@ -36,3 +40,18 @@ PERF_TEST_F(big_decimal_test, from_string) {
     perf_tests::do_not_optimize(big_decimal{neg_data_fraction_neg_exponent});
 }
 
+PERF_TEST_F(big_decimal_test, add_same_scale) {
+    perf_tests::do_not_optimize(price + other_price);
+}
+
+PERF_TEST_F(big_decimal_test, add_different_scale) {
+    perf_tests::do_not_optimize(price + rate);
+}
+
+PERF_TEST_F(big_decimal_test, compare_same_scale) {
+    perf_tests::do_not_optimize(price.compare(other_price));
+}
+
+PERF_TEST_F(big_decimal_test, compare_different_scale) {
+    perf_tests::do_not_optimize(price.compare(rate));
+}
@@ -9,10 +9,14 @@
 #include <seastar/core/app-template.hh>
 #include <seastar/core/thread.hh>
 #include <algorithm>
+#include <map>
+#include <optional>
 #include <vector>
 #include <random>
 #include <fmt/core.h>
 #include "perf.hh"
+#include "utils/allocation_strategy.hh"
+#include "utils/logalloc.hh"
 
 using per_key_t = int64_t;
 
@@ -66,11 +70,16 @@ class collection_tester {
     virtual void lower_bound(per_key_t k) = 0;
     virtual void scan(int batch) = 0;
     virtual void erase(per_key_t k) = 0;
+    // Erases the smallest key, the way cache evicts. Returns false when empty.
+    virtual bool erase_first() = 0;
     virtual void drain(int batch) = 0;
     virtual void clear() = 0;
     virtual void clone() = 0;
     virtual void show_stats() = 0;
     virtual void insert_and_erase(per_key_t k) = 0;
+    // Whether all memory of the collection comes from current_allocator(),
+    // so that it can live in an LSA region.
+    virtual bool lsa_compatible() const = 0;
     virtual ~collection_tester() {};
 };
 
@@ -104,6 +113,14 @@ class bptree_tester : public collection_tester {
         scan_collection(_t, batch);
     }
     virtual void erase(per_key_t k) override { _t.erase(k); }
+    virtual bool erase_first() override {
+        auto i = _t.begin();
+        if (i == _t.end()) {
+            return false;
+        }
+        i.erase(key_compare{});
+        return true;
+    }
     virtual void drain(int batch) override {
         int x = 0;
         auto i = _t.begin();
@@ -133,6 +150,7 @@ class bptree_tester : public collection_tester {
         }
         fmt::print("datas:     {}\n", st.datas);
     }
+    virtual bool lsa_compatible() const override { return true; }
     virtual ~bptree_tester() { clear(); }
 };
 
@@ -155,6 +173,13 @@ class radix_tester : public collection_tester {
         scan_collection(_t, batch);
     }
     virtual void erase(per_key_t k) override { _t.erase(k); }
+    virtual bool erase_first() override {
+        if (_t.empty()) {
+            return false;
+        }
+        _t.erase(_t.begin().key());
+        return true;
+    }
     virtual void drain(int batch) override {
         int x = 0;
         while (!_t.empty()) {
@@ -183,6 +208,7 @@ class radix_tester : public collection_tester {
         show_node_stats("inner", st.inners);
         show_node_stats(" leaf", st.leaves);
     }
+    virtual bool lsa_compatible() const override { return true; }
     virtual ~radix_tester() override { clear(); }
 };
 
@@ -230,6 +256,14 @@ class isec_tester : public collection_tester {
         auto i = _t.find(k, compare{});
         _t.erase_and_dispose(i, [] (isec_node* n) { delete n; });
     }
+    virtual bool erase_first() override {
+        auto i = _t.begin();
+        if (i == _t.end()) {
+            return false;
+        }
+        _t.erase_and_dispose(i, [] (isec_node* n) { delete n; });
+        return true;
+    }
     virtual void drain(int batch) override {
         int x = 0;
         while (true) {
@@ -253,25 +287,43 @@ class isec_tester : public collection_tester {
         _t.erase(i);
     }
     virtual void show_stats() override { }
+    virtual bool lsa_compatible() const override { return false; }
     virtual ~isec_tester() { clear(); }
 };
 
 class btree_tester : public collection_tester {
     test_b_tree _t;
     perf_intrusive_key::tri_compare _cmp;
+
+    // Keys are allocated like rows_entry-s are, so that they move with
+    // the tree nodes when it lives in LSA.
+    static alloc_strategy_unique_ptr<perf_intrusive_key> make_key(per_key_t k) {
+        return alloc_strategy_unique_ptr<perf_intrusive_key>(current_allocator().construct<perf_intrusive_key>(k));
+    }
+    static void dispose_key(perf_intrusive_key* k) noexcept {
+        current_allocator().destroy(k);
+    }
 public:
     btree_tester() : _t() {}
-    virtual void insert(per_key_t k) override { _t.insert(std::make_unique<perf_intrusive_key>(k), _cmp); }
+    virtual void insert(per_key_t k) override { _t.insert(make_key(k), _cmp); }
     virtual void lower_bound(per_key_t k) override {
         auto i = _t.lower_bound(k, _cmp);
         assert(i != _t.end());
     }
-    virtual void erase(per_key_t k) override { _t.erase_and_dispose(k, _cmp, [] (perf_intrusive_key* k) noexcept { delete k; }); }
+    virtual void erase(per_key_t k) override { _t.erase_and_dispose(k, _cmp, dispose_key); }
+    virtual bool erase_first() override {
+        auto i = _t.begin();
+        if (i == _t.end()) {
+            return false;
+        }
+        _t.erase_and_dispose(i, dispose_key);
+        return true;
+    }
     virtual void drain(int batch) override {
         int x = 0;
         perf_intrusive_key* k;
         while ((k = _t.unlink_leftmost_without_rebalance()) != nullptr) {
-            delete k;
+            dispose_key(k);
             if (++x % batch == 0) {
                 seastar::thread::yield();
             }
@@ -281,12 +333,12 @@ class btree_tester : public collection_tester {
         scan_collection(_t, batch);
     }
     virtual void clear() override {
-        _t.clear_and_dispose([] (perf_intrusive_key* k) noexcept { delete k; });
+        _t.clear_and_dispose(dispose_key);
     }
     virtual void clone() override { }
     virtual void insert_and_erase(per_key_t k) override {
-        auto i = _t.insert_before(_t.end(), std::make_unique<perf_intrusive_key>(k));
-        _t.erase_and_dispose(i, [] (perf_intrusive_key* k) noexcept { delete k; });
+        auto i = _t.insert_before(_t.end(), make_key(k));
+        _t.erase_and_dispose(i, dispose_key);
     }
     virtual void show_stats() override {
         struct intrusive_b::stats st = _t.get_stats();
@@ -299,6 +351,7 @@ class btree_tester : public collection_tester {
             fmt::print("   {}: {} ({}%)\n", i, st.leaves_filled[i], st.leaves_filled[i] * 100 / st.leaves);
         }
     }
+    virtual bool lsa_compatible() const override { return true; }
     virtual ~btree_tester() {
         _t.clear();
     }
@@ -316,6 +369,13 @@ class set_tester : public collection_tester {
         scan_collection(_s, batch);
     }
     virtual void erase(per_key_t k) override { _s.erase(k); }
+    virtual bool erase_first() override {
+        if (_s.empty()) {
+            return false;
+        }
+        _s.erase(_s.begin());
+        return true;
+    }
     virtual void drain(int batch) override {
         int x = 0;
         auto i = _s.begin();
@@ -334,6 +394,7 @@ class set_tester : public collection_tester {
         _s.erase(i.first);
     }
     virtual void show_stats() override { }
+    virtual bool lsa_compatible() const override { return false; }
     virtual ~set_tester() = default;
 };
 
@@ -349,6 +410,13 @@ class map_tester : public collection_tester {
         scan_collection(_m, batch);
     }
     virtual void erase(per_key_t k) override { _m.erase(k); }
+    virtual bool erase_first() override {
+        if (_m.empty()) {
+            return false;
+        }
+        _m.erase(_m.begin());
+        return true;
+    }
     virtual void drain(int batch) override {
         int x = 0;
         auto i = _m.begin();
@@ -367,9 +435,127 @@ class map_tester : public collection_tester {
         _m.erase(i.first);
     }
     virtual void show_stats() override { }
+    virtual bool lsa_compatible() const override { return false; }
     virtual ~map_tester() = default;
 };
 
+#include "utils/double-decker.hh"
+
+class dd_tester : public collection_tester {
+    // Mimics cache_entry: the token is the outer key, the entry keeps the
+    // bounds flags for the intrusive array.
+    class entry {
+        per_key_t _key;
+        bool _head = false;
+        bool _tail = false;
+        bool _train = false;
+    public:
+        explicit entry(per_key_t k) noexcept : _key(k) {}
+        entry(entry&&) noexcept = default;
+
+        bool is_head() const noexcept { return _head; }
+        void set_head(bool v) noexcept { _head = v; }
+        bool is_tail() const noexcept { return _tail; }
+        void set_tail(bool v) noexcept { _tail = v; }
+        bool with_train() const noexcept { return _train; }
+        void set_train(bool v) noexcept { _train = v; }
+
+        struct compare {
+            key_tri_compare _cmp;
+            std::strong_ordering operator()(per_key_t a, per_key_t b) const noexcept { return _cmp(a, b); }
+            std::strong_ordering operator()(const entry& a, per_key_t b) const noexcept { return _cmp(a._key, b); }
+            std::strong_ordering operator()(per_key_t a, const entry& b) const noexcept { return _cmp(a, b._key); }
+            std::strong_ordering operator()(const entry& a, const entry& b) const noexcept { return _cmp(a._key, b._key); }
+        };
+    };
+
+    using test_tree = double_decker<per_key_t, entry, key_compare, entry::compare, 16, bplus::key_search::linear>;
+
+    test_tree _t;
+public:
+    dd_tester() : _t(key_compare{}) {}
+    virtual void insert(per_key_t k) override { _t.insert(k, entry(k), entry::compare{}); }
+    virtual void lower_bound(per_key_t k) override {
+        auto i = _t.lower_bound(k, entry::compare{});
+        assert(i != _t.end());
+    }
+    virtual void scan(int batch) override {
+        scan_collection(_t, batch);
+    }
+    virtual void erase(per_key_t k) override {
+        auto i = _t.find(k, entry::compare{});
+        i.erase(key_compare{});
+    }
+    virtual bool erase_first() override {
+        auto i = _t.begin();
+        if (i == _t.end()) {
+            return false;
+        }
+        i.erase(key_compare{});
+        return true;
+    }
+    virtual void drain(int batch) override {
+        int x = 0;
+        auto i = _t.begin();
+        while (i != _t.end()) {
+            i = i.erase(key_compare{});
+            if (++x % batch == 0) {
+                seastar::thread::yield();
+            }
+        }
+    }
+    virtual void clear() override { _t.clear(); }
+    virtual void clone() override { }
+    virtual void insert_and_erase(per_key_t k) override {
+        auto i = _t.insert(k, entry(k), entry::compare{});
+        i.erase(key_compare{});
+    }
+    virtual void show_stats() override { }
+    virtual bool lsa_compatible() const override { return true; }
+    virtual ~dd_tester() { clear(); }
+};
+
+// Orders the keys the way they come to the collection: "random" like tokens,
+// "sequential" like appended clustering keys and "clustered" -- runs of
+// consecutive keys in random order, like rows written a partition at a time.
+static void arrange_keys(std::vector<per_key_t>& keys, const std::string& distribution, std::mt19937& g) {
+    std::sort(keys.begin(), keys.end());
+    if (distribution == "random") {
+        std::shuffle(keys.begin(), keys.end(), g);
+    } else if (distribution == "clustered") {
+        constexpr size_t run_length = 64;
+        std::vector<size_t> runs;
+        for (size_t r = 0; r * run_length < keys.size(); r++) {
+            runs.push_back(r);
+        }
+        std::shuffle(runs.begin(), runs.end(), g);
+        std::vector<per_key_t> sorted = std::exchange(keys, {});
+        for (auto r : runs) {
+            auto b = sorted.begin() + r * run_length;
+            keys.insert(keys.end(), b, b + std::min(run_length, size_t(sorted.end() - b)));
+        }
+    }
+}
+
+// Durations of the test phases in ms and bytes per entry, one value per iteration.
+using test_results = std::map<std::string, std::vector<double>>;
+
+static void write_json_result(const std::string& result_file, const std::string& col, const std::string& tst,
+        const std::string& distribution, bool lsa, int count, const test_results& results) {
+    perf::json_result result("collection_" + tst);
+
+    auto& params = result.parameters();
+    params["collection"] = col;
+    params["distribution"] = distribution;
+    params["lsa"] = lsa;
+    params["count"] = count;
+
+    for (const auto& [name, values] : results) {
+        result.add_metric(name, values, perf::better::lower);
+    }
+    result.write(result_file);
+}
+
 int main(int argc, char **argv) {
     namespace bpo = boost::program_options;
     app_template app;
@@ -377,8 +563,11 @@ int main(int argc, char **argv) {
         ("count", bpo::value<int>()->default_value(5000000), "number of keys to fill the tree with")
         ("batch", bpo::value<int>()->default_value(50), "number of operations between deferring points")
         ("iters", bpo::value<int>()->default_value(1), "number of iterations")
-        ("col", bpo::value<std::string>()->default_value("bptree"), "collection to test")
-        ("test", bpo::value<std::string>()->default_value("erase"), "what to test (erase, drain, clear, find, oneshot)")
+        ("col", bpo::value<std::string>()->default_value("bptree"), "collection to test (bptree, btree, radix, dd, set, map, isec)")
+        ("test", bpo::value<std::string>()->default_value("erase"), "what to test (erase, drain, clear, find, scan, clone, oneshot, all, compact, evict)")
+        ("distribution", bpo::value<std::string>()->default_value("random"), "order of the keys (random, sequential, clustered)")
+        ("lsa", bpo::value<bool>()->default_value(false), "allocate the collection in an LSA region")
+        ("json-result", bpo::value<std::string>(), "name of the json result file")
         ("stats", bpo::value<bool>()->default_value(false), "show stats");
 
     return app.run(argc, argv, [&app] {
@@ -387,9 +576,15 @@ int main(int argc, char **argv) {
         auto batch = app.configuration()["batch"].as<int>();
         auto col = app.configuration()["col"].as<std::string>();
         auto tst = app.configuration()["test"].as<std::string>();
+        auto distribution = app.configuration()["distribution"].as<std::string>();
+        auto lsa = app.configuration()["lsa"].as<bool>();
         auto stats = app.configuration()["stats"].as<bool>();
+        std::optional<std::string> json_result;
+        if (app.configuration().contains("json-result")) {
+            json_result = app.configuration()["json-result"].as<std::string>();
+        }
 
-        return seastar::async([count, iters, batch, col, tst, stats] {
+        return seastar::async([count, iters, batch, col, tst, distribution, lsa, stats, json_result] {
             std::unique_ptr<collection_tester> c;
 
             if (col == "bptree") {
@@ -404,11 +599,55 @@ int main(int argc, char **argv) {
                 c = std::make_unique<isec_tester>();
             } else if (col == "radix") {
                 c = std::make_unique<radix_tester>();
+            } else if (col == "dd") {
+                c = std::make_unique<dd_tester>();
             } else {
                 fmt::print("Unknown collection\n");
                 return;
             }
 
+            if (distribution != "random" && distribution != "sequential" && distribution != "clustered") {
+                fmt::print("Unknown distribution\n");
+                return;
+            }
+            if (lsa && !c->lsa_compatible()) {
+                fmt::print("{} cannot live in LSA\n", col);
+                return;
+            }
+            if ((tst == "compact" || tst == "evict") && !lsa) {
+                fmt::print("{} test needs --lsa\n", tst);
+                return;
+            }
+
+            // The collection is only touched with its allocator set as the
+            // current one, nothing else in this thread allocates through it.
+            logalloc::region region;
+            allocation_strategy& alloc = lsa ? region.allocator() : standard_allocator();
+            auto destroy_collection = defer([&] () noexcept {
+                with_allocator(alloc, [&] { c.reset(); });
+            });
+
+            auto used_memory = [&] () -> size_t {
+                return lsa ? region.occupancy().used_space() : memory::stats().allocated_memory();
+            };
+
+            test_results results;
+            auto run = [&] (const char* name, auto&& func) {
+                auto d = duration_in_seconds([&] {
+                    with_allocator(alloc, func);
+                });
+                fmt::print("{}: {:.6f} ms\n", name, d.count() * 1000);
+                results[name].push_back(d.count() * 1000);
+            };
+            auto for_each_key = [&] (const std::vector<per_key_t>& keys, auto&& func) {
+                for (int i = 0; i < count; i++) {
+                    func(keys[i]);
+                    if ((i + 1) % batch == 0) {
+                        seastar::thread::yield();
+                    }
+                }
+            };
+
             std::vector<per_key_t> keys;
 
             for (per_key_t i = 0; i < count; i++) {
@@ -418,95 +657,96 @@ int main(int argc, char **argv) {
             std::random_device rd;
             std::mt19937 g(rd());
 
-            fmt::print("Inserting {:d} k:v pairs into {} {:d} times\n", count, col, iters);
+            fmt::print("Inserting {:d} k:v pairs into {}{} in {} order {:d} times\n", count, col, lsa ? " (LSA)" : "", distribution, iters);
 
             for (auto rep = 0; rep < iters; rep++) {
-                std::shuffle(keys.begin(), keys.end(), g);
+                arrange_keys(keys, distribution, g);
                 seastar::thread::yield();
 
                 if (tst == "oneshot") {
-                    auto d = duration_in_seconds([&] {
-                        for (int i = 0; i < count; i++) {
-                            c->insert_and_erase(keys[i]);
-                            if ((i + 1) % batch == 0) {
-                                seastar::thread::yield();
-                            }
-                        }
+                    run("one-shot", [&] {
+                        for_each_key(keys, [&] (per_key_t k) { c->insert_and_erase(k); });
                     });
-
-                    fmt::print("one-shot: {:.6f} ms\n", d.count() * 1000);
                     continue;
                 }
 
-                auto d = duration_in_seconds([&] {
-                    for (int i = 0; i < count; i++) {
-                        c->insert(keys[i]);
-                        if ((i + 1) % batch == 0) {
-                            seastar::thread::yield();
-                        }
-                    }
-                });
+                auto mem_before = used_memory();
+                {
+                    // Iterators are kept across deferring points, the region
+                    // must not be compacted under them.
+                    logalloc::reclaim_lock rl(region);
+
+                    run("fill", [&] {
+                        for_each_key(keys, [&] (per_key_t k) { c->insert(k); });
+                    });
+                    auto bytes_per_entry = double(used_memory() - mem_before) / count;
+                    fmt::print("memory: {:.1f} bytes per entry\n", bytes_per_entry);
+                    results["bytes_per_entry"].push_back(bytes_per_entry);
 
-                fmt::print("fill: {:.6f} ms\n", d.count() * 1000);
+                    if (stats) {
+                        c->show_stats();
+                    }
 
-                if (stats) {
-                    c->show_stats();
+                    if (tst == "find" || tst == "all") {
+                        arrange_keys(keys, distribution, g);
+                        seastar::thread::yield();
+                        run("find", [&] {
+                            for_each_key(keys, [&] (per_key_t k) { c->lower_bound(k); });
+                        });
+                    }
+                    if (tst == "scan" || tst == "all") {
+                        run("scan", [&] { c->scan(batch); });
+                    }
+                    if (tst == "erase" || tst == "all") {
+                        arrange_keys(keys, distribution, g);
+                        seastar::thread::yield();
+                        run("erase", [&] {
+                            for_each_key(keys, [&] (per_key_t k) { c->erase(k); });
+                        });
+                    } else if (tst == "drain") {
+                        run("drain", [&] { c->drain(batch); });
+                    } else if (tst == "clear") {
+                        run("clear", [&] { c->clear(); });
+                    } else if (tst == "clone") {
+                        run("clone", [&] { c->clone(); });
+                    }
                 }
 
-                if (tst == "erase") {
-                    std::shuffle(keys.begin(), keys.end(), g);
-                    seastar::thread::yield();
-
-                    d = duration_in_seconds([&] {
-                        for (int i = 0; i < count; i++) {
+                if (tst == "compact") {
+                    // Erasing every other key leaves the segments half empty.
+                    with_allocator(alloc, [&] {
+                        for (int i = 0; i < count; i += 2) {
                             c->erase(keys[i]);
-                            if ((i + 1) % batch == 0) {
-                                seastar::thread::yield();
-                            }
                         }
                     });
-
-                    fmt::print("erase: {:.6f} ms\n", d.count() * 1000);
-                } else if (tst == "drain") {
-                    d = duration_in_seconds([&] {
-                        c->drain(batch);
-                    });
-
-                    fmt::print("drain: {:.6f} ms\n", d.count() * 1000);
-                } else if (tst == "clear") {
-                    d = duration_in_seconds([&] {
-                        c->clear();
-                    });
-
-                    fmt::print("clear: {:.6f} ms\n", d.count() * 1000);
-                } else if (tst == "find") {
-                    std::shuffle(keys.begin(), keys.end(), g);
-                    seastar::thread::yield();
-
-                    d = duration_in_seconds([&] {
-                        for (int i = 0; i < count; i++) {
-                            c->lower_bound(keys[i]);
-                            if ((i + 1) % batch == 0) {
-                                seastar::thread::yield();
+                    auto before = region.occupancy();
+                    run("compact", [&] { region.full_compaction(); });
+                    fmt::print("occupancy: {:.1f}% -> {:.1f}%\n", before.used_fraction() * 100, region.occupancy().used_fraction() * 100);
+                } else if (tst == "evict") {
+                    // Evicts from the front like cache does, until half of the
+                    // region's memory is given back to the standard allocator.
+                    size_t evicted = 0;
+                    region.make_evictable([&] {
+                        return with_allocator(alloc, [&] {
+                            if (!c->erase_first()) {
+                                return memory::reclaiming_result::reclaimed_nothing;
                             }
-                        }
+                            evicted++;
+                            return memory::reclaiming_result::reclaimed_something;
+                        });
                     });
-
-                    fmt::print("find: {:.6f} ms\n", d.count() * 1000);
-                } else if (tst == "scan") {
-                    d = duration_in_seconds([&] {
-                        c->scan(batch);
-                    });
-
-                    fmt::print("scan: {:.6f} ms\n", d.count() * 1000);
-                } else if (tst == "clone") {
-                    d = duration_in_seconds([&] {
-                        c->clone();
-                    });
-                    fmt::print("clone: {:.6f} ms\n", d.count() * 1000);
+                    logalloc::shard_tracker().reclaim_all_free_segments();
+                    auto to_reclaim = region.occupancy().total_space() / 2;
+                    run("evict", [&] { logalloc::shard_tracker().reclaim(to_reclaim); });
+                    fmt::print("evicted: {} entries\n", evicted);
+                    region.make_evictable([] { return memory::reclaiming_result::reclaimed_nothing; });
                 }
 
-                c->clear();
+                with_allocator(alloc, [&] { c->clear(); });
+            }
+
+            if (json_result) {
+                write_json_result(*json_result, col, tst, distribution, lsa, count, results);
             }
         });
     });
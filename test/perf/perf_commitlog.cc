@@ -6,12 +6,7 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
-#include <fstream>
-
 #include <boost/range/irange.hpp>
-#include <boost/algorithm/string/split.hpp>
-#include <boost/algorithm/string/classification.hpp>
-#include <json/json.h>
 
 #include <seastar/core/app-template.hh>
 #include <seastar/core/coroutine.hh>
@@ -25,7 +20,6 @@
 
 #include "db/config.hh"
 #include "schema_builder.hh"
-#include "release.hh"
 #include "db/config.hh"
 #include "db/extensions.hh"
 #include "db/commitlog/commitlog.hh"
@@ -45,12 +39,12 @@ struct test_config {
 
 using clperf_result = perf_result_with_aio_writes;
 
-static void write_json_result(std::string result_file, const test_config& cfg, clperf_result median, double mad, double max, double min) {
-    Json::Value results;
+static void write_json_result(std::string result_file, const test_config& cfg, const std::vector<clperf_result>& results,
+        clperf_result median, double mad, double max, double min) {
+    perf::json_result result("commitlog_write");
 
-    Json::Value params;
+    auto& params = result.parameters();
     params["concurrency"] = cfg.concurrency;
-    params["cpus"] = smp::count;
     params["duration"] = cfg.duration_in_seconds;
 
     params["min-data-size"] = cfg.min_data_size;
@@ -59,9 +53,8 @@ static void write_json_result(std::string result_file, const test_config& cfg, c
     params["max-flush-delay-in-ms"] = cfg.max_flush_delay_in_ms;
 
     params["concurrency,cpus,duration"] = fmt::format("{},{},{}", cfg.concurrency, smp::count, cfg.duration_in_seconds);
-    results["parameters"] = std::move(params);
 
-    Json::Value stats;
+    auto& stats = result.stats();
     stats["median tps"] = median.throughput;
     stats["allocs_per_op"] = median.mallocs_per_op;
     stats["tasks_per_op"] = median.tasks_per_op;
@@ -71,35 +64,11 @@ static void write_json_result(std::string result_file, const test_config& cfg, c
     stats["mad tps"] = mad;
     stats["max tps"] = max;
     stats["min tps"] = min;
-    results["stats"] = std::move(stats);
-
-    std::string test_type = "commitlog_write";
-    results["test_properties"]["type"] = test_type;
-
-    // <version>-<release>
-    auto version_components = std::vector<std::string>{};
-    auto sver = scylla_version();
-    boost::algorithm::split(version_components, sver, boost::is_any_of("-"));
-    // <scylla-build>.<date>.<git-hash>
-    auto release_components = std::vector<std::string>{};
-    boost::algorithm::split(release_components, version_components[1], boost::is_any_of("."));
-
-    Json::Value version;
-    version["commit_id"] = release_components[2];
-    version["date"] = release_components[1];
-    version["version"] = version_components[0];
-
-    // It'd be nice to have std::chrono::format(), wouldn't it?
-    auto current_time = std::time(nullptr);
-    char time_str[100];
-    ::tm time_buf;
-    std::strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", ::localtime_r(&current_time, &time_buf));
-    version["run_date_time"] = time_str;
-
-    results["versions"]["scylla-server"] = std::move(version);
-
-    auto out = std::ofstream(result_file);
-    out << results;
+
+    result.add_perf_results(results);
+    result.add_metric("aio_writes_per_op", boost::copy_range<std::vector<double>>(
+            results | boost::adaptors::transformed(std::mem_fn(&clperf_result::aio_writes))), perf::better::lower);
+    result.write(result_file);
 }
 
 struct commitlog_service {
@@ -262,7 +231,7 @@ int main(int argc, char** argv) {
             std::cout << format("\nmedian {}\nmedian absolute deviation: {:.2f}\nmaximum: {:.2f}\nminimum: {:.2f}\n", median_result, mad, max, min);
 
             if (app.configuration().contains("json-result")) {
-                write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, median_result, mad, max, min);
+                write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, results, median_result, mad, max, min);
             }
         } catch (...) {
             ex = std::current_exception();
@@ -0,0 +1,373 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+// Replays a history of flushed sstables through a compaction strategy, using
+// simulated sstables which only carry metadata, and reports the resulting write,
+// space and read amplification over time. No data is read or written, so years
+// of history take seconds to simulate.
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/util/file.hh>
+
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/classification.hpp>
+#include <fmt/format.h>
+
+// hack: sstable_utils falsely depends on Boost.Test, but we can't include it with
+// with statically linked boost
+#define BOOST_REQUIRE(x) (void)(x)
+#define BOOST_CHECK_NO_THROW(x) (void)(x)
+
+#include "compaction/compaction.hh"
+#include "compaction/compaction_strategy.hh"
+#include "compaction/strategy_control.hh"
+#include "compaction/table_state.hh"
+#include "schema_builder.hh"
+#include "utils/rjson.hh"
+#include "test/lib/sstable_utils.hh"
+
+using namespace sstables;
+
+// A flush of the simulated workload.
+struct flush_event {
+    uint64_t data_size;
+    uint64_t partitions;
+    api::timestamp_type min_timestamp;
+    api::timestamp_type max_timestamp;
+    int32_t max_local_deletion_time = std::numeric_limits<int32_t>::max();
+};
+
+// Each sstable created by `scylla-sstable dump-statistics` becomes one flush, in the
+// order of their max timestamps. The statistics don't record keys, so every flush
+// is assumed to span the whole token ring.
+static std::vector<flush_event> load_statistics(const sstring& path) {
+    auto content = seastar::util::read_entire_file_contiguous(std::filesystem::path(path)).get0();
+    auto root = rjson::parse(std::string_view(content));
+    auto* sstables = rjson::find(root, "sstables");
+    if (!sstables || !sstables->IsObject()) {
+        throw std::runtime_error(format("{}: not the output of dump-statistics, no \"sstables\" object", path));
+    }
+    std::vector<flush_event> events;
+    for (auto it = sstables->MemberBegin(); it != sstables->MemberEnd(); ++it) {
+        auto* stats = rjson::find(it->value, "stats");
+        if (!stats) {
+            throw std::runtime_error(format("{}: no stats metadata for {}", path, it->name.GetString()));
+        }
+        flush_event e{};
+        for (const auto& bucket : rjson::get(*stats, "estimated_partition_size").GetArray()) {
+            auto offset = rjson::get(bucket, "offset").GetInt64();
+            auto count = rjson::get(bucket, "value").GetInt64();
+            e.data_size += offset * count;
+            e.partitions += count;
+        }
+        e.min_timestamp = rjson::get(*stats, "min_timestamp").GetInt64();
+        e.max_timestamp = rjson::get(*stats, "max_timestamp").GetInt64();
+        e.max_local_deletion_time = rjson::get(*stats, "max_local_deletion_time").GetInt64();
+        events.push_back(e);
+    }
+    std::sort(events.begin(), events.end(), [] (const flush_event& a, const flush_event& b) {
+        return a.max_timestamp < b.max_timestamp;
+    });
+    return events;
+}
+
+static std::vector<flush_event> make_synthetic_workload(unsigned flushes, uint64_t flush_size, std::chrono::seconds interval) {
+    std::vector<flush_event> events;
+    events.reserve(flushes);
+    auto interval_us = std::chrono::duration_cast<std::chrono::microseconds>(interval).count();
+    auto now = std::chrono::duration_cast<std::chrono::microseconds>(db_clock::now().time_since_epoch()).count();
+    auto ts = now - api::timestamp_type(flushes) * interval_us;
+    for (unsigned i = 0; i < flushes; i++, ts += interval_us) {
+        events.push_back(flush_event{flush_size, flush_size / 1024, ts, ts + interval_us - 1});
+    }
+    return events;
+}
+
+class simulated_table_state : public compaction::table_state {
+    test_env& _env;
+    schema_ptr _schema;
+    mutable compaction_strategy _strategy;
+    sstable_set _main_set;
+    sstable_set _maintenance_set;
+    std::vector<shared_sstable> _compacted_undeleted;
+public:
+    simulated_table_state(test_env& env, schema_ptr s, compaction_strategy strategy)
+        : _env(env)
+        , _schema(std::move(s))
+        , _strategy(std::move(strategy))
+        , _main_set(_strategy.make_sstable_set(_schema))
+        , _maintenance_set(make_partitioned_sstable_set(_schema, false))
+    {}
+    sstable_set& sstables() noexcept {
+        return _main_set;
+    }
+    const schema_ptr& schema() const noexcept override {
+        return _schema;
+    }
+    unsigned min_compaction_threshold() const noexcept override {
+        return _schema->min_compaction_threshold();
+    }
+    bool compaction_enforce_min_threshold() const noexcept override {
+        return true;
+    }
+    const sstable_set& main_sstable_set() const override {
+        return _main_set;
+    }
+    const sstable_set& maintenance_sstable_set() const override {
+        return _maintenance_set;
+    }
+    std::unordered_set<shared_sstable> fully_expired_sstables(const std::vector<shared_sstable>& sstables, gc_clock::time_point query_time) const override {
+        return get_fully_expired_sstables(*this, sstables, query_time);
+    }
+    const std::vector<shared_sstable>& compacted_undeleted_sstables() const noexcept override {
+        return _compacted_undeleted;
+    }
+    compaction_strategy& get_compaction_strategy() const noexcept override {
+        return _strategy;
+    }
+    reader_permit make_compaction_reader_permit() const override {
+        return _env.make_reader_permit();
+    }
+    sstables_manager& get_sstables_manager() noexcept override {
+        return _env.manager();
+    }
+    shared_sstable make_sstable() const override {
+        throw std::logic_error("simulated compaction doesn't write sstables");
+    }
+    shared_sstable make_cold_sstable() const override {
+        throw std::logic_error("simulated compaction doesn't write sstables");
+    }
+    sstable_writer_config configure_writer(sstring origin) const override {
+        return _env.manager().configure_writer(std::move(origin));
+    }
+    api::timestamp_type min_memtable_timestamp() const override {
+        return api::max_timestamp;
+    }
+    future<> update_compaction_history(utils::UUID, sstring, sstring, std::chrono::milliseconds, int64_t, int64_t) override {
+        return make_ready_future<>();
+    }
+    future<> on_compaction_completion(compaction_completion_desc, offstrategy) override {
+        return make_ready_future<>();
+    }
+    bool is_auto_compaction_disabled_by_user() const noexcept override {
+        return false;
+    }
+};
+
+class simulated_strategy_control : public compaction::strategy_control {
+public:
+    bool has_ongoing_compaction(compaction::table_state&) const noexcept override {
+        return false;
+    }
+};
+
+class compaction_simulator {
+    // Simulated sstables span a range of keys of this pool, which is sorted by token.
+    struct key_span {
+        size_t first;
+        size_t last;
+    };
+    struct sstable_info {
+        key_span span;
+        uint64_t partitions;
+    };
+
+    test_env& _env;
+    schema_ptr _schema;
+    simulated_table_state _table_s;
+    simulated_strategy_control _control;
+    std::vector<sstring> _keys;
+    std::unordered_map<shared_sstable, sstable_info> _sstables;
+    unsigned long _generation = 1;
+
+    uint64_t _flushed_bytes = 0;
+    uint64_t _compacted_bytes = 0;
+    uint64_t _live_bytes = 0;
+    uint64_t _compactions = 0;
+    double _max_space_amplification = 1.0;
+    size_t _max_read_amplification = 0;
+private:
+    shared_sstable make_sstable(key_span span, uint64_t data_size, uint64_t partitions, api::timestamp_type min_timestamp, api::timestamp_type max_timestamp,
+            int32_t max_local_deletion_time, uint32_t level, utils::UUID run_identifier) {
+        stats_metadata stats = {};
+        stats.min_timestamp = min_timestamp;
+        stats.max_timestamp = max_timestamp;
+        stats.max_local_deletion_time = max_local_deletion_time;
+        stats.sstable_level = level;
+        stats.estimated_tombstone_drop_time = utils::streaming_histogram(TOMBSTONE_HISTOGRAM_BIN_SIZE);
+
+        auto sst = _env.make_sstable(_schema, "", _generation++);
+        sstables::test(sst).set_values(_keys[span.first], _keys[span.last], std::move(stats));
+        sstables::test(sst).set_data_file_size(data_size);
+        sstables::test(sst).set_data_file_write_time(db_clock::now());
+        sstables::test(sst).set_run_identifier(run_identifier);
+        _sstables.emplace(sst, sstable_info{span, partitions});
+        return sst;
+    }
+
+    void add(shared_sstable sst) {
+        _live_bytes += sst->data_size();
+        _table_s.sstables().insert(std::move(sst));
+    }
+
+    void remove(const shared_sstable& sst) {
+        _live_bytes -= sst->data_size();
+        _table_s.sstables().erase(sst);
+        _sstables.erase(sst);
+    }
+
+    // Data is assumed not to be overwritten, so output holds as much as input. Output is
+    // split into sstables of max_sstable_bytes, which cover disjoint slices of the input span.
+    void compact(const compaction_descriptor& desc) {
+        std::vector<shared_sstable> output;
+        if (!desc.has_only_fully_expired) {
+            uint64_t input_size = 0;
+            uint64_t partitions = 0;
+            auto min_timestamp = api::max_timestamp;
+            api::timestamp_type max_timestamp = api::min_timestamp;
+            auto max_local_deletion_time = std::numeric_limits<int32_t>::min();
+            key_span span{_keys.size() - 1, 0};
+            for (auto& sst : desc.sstables) {
+                const auto& stats = sst->get_stats_metadata();
+                input_size += sst->data_size();
+                auto& info = _sstables.at(sst);
+                partitions += info.partitions;
+                min_timestamp = std::min(min_timestamp, stats.min_timestamp);
+                max_timestamp = std::max(max_timestamp, stats.max_timestamp);
+                max_local_deletion_time = std::max(max_local_deletion_time, stats.max_local_deletion_time);
+                span.first = std::min(span.first, info.span.first);
+                span.last = std::max(span.last, info.span.last);
+            }
+            size_t count = 1;
+            if (desc.max_sstable_bytes != compaction_descriptor::default_max_sstable_bytes) {
+                count = std::max(uint64_t(1), (input_size + desc.max_sstable_bytes - 1) / desc.max_sstable_bytes);
+            }
+            count = std::min(count, span.last - span.first + 1);
+            auto keys_per_sstable = (span.last - span.first + 1) / count;
+            for (size_t i = 0; i < count; i++) {
+                auto first = span.first + i * keys_per_sstable;
+                auto last = i == count - 1 ? span.last : first + keys_per_sstable - 1;
+                output.push_back(make_sstable({first, last}, input_size / count, partitions / count, min_timestamp, max_timestamp,
+                        max_local_deletion_time, desc.level, desc.run_identifier));
+            }
+            _compacted_bytes += input_size;
+            // Input is only deleted once output is sealed.
+            _max_space_amplification = std::max(_max_space_amplification, double(_live_bytes + input_size) / double(_live_bytes));
+        }
+        for (auto& sst : desc.sstables) {
+            remove(sst);
+        }
+        for (auto& sst : output) {
+            add(sst);
+        }
+        _table_s.get_compaction_strategy().notify_completion(desc.sstables, output);
+        _compactions++;
+    }
+
+    // Number of sstables a read of a key has to look into, sampled over the key pool.
+    size_t read_amplification() const {
+        size_t max = 0;
+        for (size_t key = 0; key < _keys.size(); key += std::max(size_t(1), _keys.size() / 64)) {
+            size_t n = 0;
+            for (auto& [sst, info] : _sstables) {
+                n += info.span.first <= key && key <= info.span.last;
+            }
+            max = std::max(max, n);
+        }
+        return max;
+    }
+
+    std::vector<shared_sstable> candidates() const {
+        auto all = _table_s.main_sstable_set().all();
+        return std::vector<shared_sstable>(all->begin(), all->end());
+    }
+public:
+    compaction_simulator(test_env& env, schema_ptr s, compaction_strategy strategy, unsigned key_space)
+        : _env(env)
+        , _schema(s)
+        , _table_s(env, s, std::move(strategy))
+        , _keys(make_local_keys(key_space, s))
+    {}
+
+    void flush(const flush_event& e) {
+        _flushed_bytes += e.data_size;
+        add(make_sstable({0, _keys.size() - 1}, e.data_size, e.partitions, e.min_timestamp, e.max_timestamp, e.max_local_deletion_time,
+                0, utils::make_random_uuid()));
+        auto& cs = _table_s.get_compaction_strategy();
+        // Guards against strategies which never stop proposing jobs.
+        for (unsigned i = 0; i < 1000; i++) {
+            auto desc = cs.get_sstables_for_compaction(_table_s, _control, candidates());
+            if (desc.sstables.empty()) {
+                break;
+            }
+            compact(desc);
+            seastar::thread::maybe_yield();
+        }
+        _max_read_amplification = std::max(_max_read_amplification, read_amplification());
+    }
+
+    void report(std::ostream& os, size_t flushes) const {
+        auto write_amplification = _flushed_bytes ? double(_flushed_bytes + _compacted_bytes) / _flushed_bytes : 0.0;
+        os << fmt::format("flushes={} sstables={} live_mb={} compactions={} write_amp={:.2f} max_space_amp={:.2f} read_amp={} max_read_amp={}\n",
+                flushes, _sstables.size(), _live_bytes >> 20, _compactions, write_amplification, _max_space_amplification,
+                read_amplification(), _max_read_amplification);
+    }
+};
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("compaction-strategy", bpo::value<sstring>()->default_value("SizeTieredCompactionStrategy"), "compaction strategy to simulate")
+        ("strategy-option", bpo::value<std::vector<sstring>>()->default_value({}, ""), "compaction strategy option, as key=value, may be repeated")
+        ("statistics", bpo::value<sstring>(), "replay the sstables in this output of `scylla-sstable dump-statistics`, instead of a synthetic workload")
+        ("flushes", bpo::value<unsigned>()->default_value(1000), "number of flushes of the synthetic workload")
+        ("flush-size-mb", bpo::value<unsigned>()->default_value(64), "size of each flush of the synthetic workload")
+        ("flush-interval-seconds", bpo::value<unsigned>()->default_value(60), "time between flushes of the synthetic workload")
+        ("key-space", bpo::value<unsigned>()->default_value(1024), "number of distinct keys which simulated sstables span")
+        ("report-interval", bpo::value<unsigned>()->default_value(100), "report amplification every this many flushes");
+
+    return app.run(argc, argv, [&app] {
+        return test_env::do_with_async([&app] (test_env& env) {
+            auto& cfg = app.configuration();
+
+            std::map<sstring, sstring> options;
+            for (auto& opt : cfg["strategy-option"].as<std::vector<sstring>>()) {
+                std::vector<sstring> kv;
+                boost::split(kv, opt, boost::is_any_of("="));
+                if (kv.size() != 2) {
+                    throw std::invalid_argument(format("invalid strategy option {}, expected key=value", opt));
+                }
+                options.emplace(kv[0], kv[1]);
+            }
+            auto type = compaction_strategy::type(cfg["compaction-strategy"].as<sstring>());
+            auto strategy = make_compaction_strategy(type, options);
+
+            auto events = cfg.contains("statistics")
+                    ? load_statistics(cfg["statistics"].as<sstring>())
+                    : make_synthetic_workload(cfg["flushes"].as<unsigned>(), uint64_t(cfg["flush-size-mb"].as<unsigned>()) << 20,
+                            std::chrono::seconds(cfg["flush-interval-seconds"].as<unsigned>()));
+
+            auto s = schema_builder("ks", "perf_compaction")
+                    .with_column("pk", utf8_type, column_kind::partition_key)
+                    .with_column("v", utf8_type)
+                    .build();
+            compaction_simulator sim(env, s, std::move(strategy), cfg["key-space"].as<unsigned>());
+
+            auto report_interval = std::max(cfg["report-interval"].as<unsigned>(), 1u);
+            for (size_t i = 0; i < events.size(); i++) {
+                sim.flush(events[i]);
+                if ((i + 1) % report_interval == 0) {
+                    sim.report(std::cout, i + 1);
+                }
+            }
+            sim.report(std::cout, events.size());
+        });
+    });
+}
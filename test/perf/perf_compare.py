@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright (C) 2026-present ScyllaDB
+#
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+
+# Compares results of the perf_* tools written with --json-result by two
+# builds, and flags the metrics which got significantly worse.
+#
+# A metric changed significantly when the Mann-Whitney U test of the runs of
+# both builds rejects that they come from the same distribution, or, when
+# there are too few runs for the test, when the medians are further apart than
+# three (normalized) median absolute deviations. Metrics with a single value
+# in either build have no noise estimate; large changes of them are printed,
+# but aren't counted as regressions. A significant change in the
+# worse direction which is also larger than --threshold is a regression, and
+# makes the script exit with status 1, so it can be used as a gate.
+#
+# Arguments are either two result files, or two directories, in which case
+# files with the same name are compared.
+
+import argparse
+import json
+import math
+import os
+import sys
+
+cmdline_parser = argparse.ArgumentParser(formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+cmdline_parser.add_argument('base', help='result file or directory of the baseline build')
+cmdline_parser.add_argument('new', help='result file or directory of the build under test')
+cmdline_parser.add_argument('--threshold', type=float, default=0.05, help='relative change of the median below which a change is not reported as a regression')
+cmdline_parser.add_argument('--alpha', type=float, default=0.05, help='significance level of the Mann-Whitney U test')
+cmdline_parser.add_argument('--all', action='store_true', help='print all metrics, not only the significantly changed ones')
+
+args = cmdline_parser.parse_args()
+
+# The scale factor making MAD an estimate of the standard deviation of normally distributed values.
+MAD_SCALE = 1.4826
+MIN_RUNS_FOR_U_TEST = 4
+
+
+def mann_whitney_p(a, b):
+    """Two-sided p-value of the Mann-Whitney U test, with the normal approximation."""
+    values = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+    ranks = [0.0] * len(values)
+    i = 0
+    tie_term = 0
+    while i < len(values):
+        j = i
+        while j + 1 < len(values) and values[j + 1][0] == values[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2 + 1
+        t = j - i + 1
+        tie_term += t ** 3 - t
+        i = j + 1
+    n1, n2 = len(a), len(b)
+    r1 = sum(r for r, (_, group) in zip(ranks, values) if group == 0)
+    u1 = r1 - n1 * (n1 + 1) / 2
+    mean = n1 * n2 / 2
+    n = n1 + n2
+    variance = n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1)))
+    if variance == 0:
+        return 1.0
+    z = (abs(u1 - mean) - 0.5) / math.sqrt(variance)
+    return math.erfc(max(z, 0) / math.sqrt(2))
+
+
+def significant(base, new):
+    """Whether the change is significant, or None when a single run of
+       either build doesn't tell how noisy the metric is."""
+    if len(base['values']) < 2 or len(new['values']) < 2:
+        return None
+    if len(base['values']) >= MIN_RUNS_FOR_U_TEST and len(new['values']) >= MIN_RUNS_FOR_U_TEST:
+        return mann_whitney_p(base['values'], new['values']) < args.alpha
+    noise = 3 * MAD_SCALE * max(base['mad'], new['mad'])
+    return abs(new['median'] - base['median']) > noise
+
+
+def compare(name, base_result, new_result):
+    regressions = 0
+    base_metrics = base_result.get('metrics', {})
+    new_metrics = new_result.get('metrics', {})
+    for metric in sorted(base_metrics.keys() & new_metrics.keys()):
+        base = base_metrics[metric]
+        new = new_metrics[metric]
+        if base['median'] == 0:
+            continue
+        change = (new['median'] - base['median']) / abs(base['median'])
+        worse = change < 0 if base['better'] == 'higher' else change > 0
+        sig = significant(base, new)
+        verdict = ''
+        if sig is None:
+            if abs(change) < args.threshold and not args.all:
+                continue
+            verdict = 'single run, noise unknown'
+        elif sig and worse and abs(change) >= args.threshold:
+            verdict = 'REGRESSION'
+            regressions += 1
+        elif sig and not worse and abs(change) >= args.threshold:
+            verdict = 'improvement'
+        elif not args.all:
+            continue
+        print(f'{name}: {metric}: {base["median"]:.6g} -> {new["median"]:.6g} ({change:+.2%}) {verdict}')
+    for metric in sorted(base_metrics.keys() - new_metrics.keys()):
+        print(f'{name}: {metric}: missing in the new results')
+    return regressions
+
+
+def load(path):
+    with open(path) as f:
+        return json.load(f)
+
+
+if os.path.isdir(args.base):
+    pairs = []
+    for file in sorted(os.listdir(args.base)):
+        if file.endswith('.json') and os.path.exists(os.path.join(args.new, file)):
+            pairs.append((file, os.path.join(args.base, file), os.path.join(args.new, file)))
+else:
+    pairs = [(os.path.basename(args.new), args.base, args.new)]
+
+regressions = 0
+for name, base_path, new_path in pairs:
+    regressions += compare(name, load(base_path), load(new_path))
+
+if regressions:
+    print(f'{regressions} regression(s) found')
+    sys.exit(1)
@@ -35,5 +35,18 @@ int main(int argc, char* argv[]) {
         sink += dst[1];
     });
 
+    std::cout << "Timing incremental hash...\n";
+
+    time_it([&] {
+        utils::murmur_hash::hash3_x64_128_state state(seed);
+        auto v = bytes_view(src);
+        state.update(v.substr(0, 2));
+        state.update(v.substr(2, v.size() - 3));
+        state.update(v.substr(v.size() - 1));
+        auto dst = state.finalize();
+        sink += dst[0];
+        sink += dst[1];
+    });
+
     black_hole = sink;
 }
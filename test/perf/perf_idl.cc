@@ -13,6 +13,12 @@
 
 #include "frozen_mutation.hh"
 #include "mutation_partition_view.hh"
+#include "query-request.hh"
+#include "idl/keys.dist.hh"
+#include "idl/range.dist.hh"
+#include "serializer_impl.hh"
+#include "idl/keys.dist.impl.hh"
+#include "idl/range.dist.impl.hh"
 
 namespace tests {
 
@@ -57,4 +63,34 @@ PERF_TEST_F(frozen_mutation, apply_one_small_row)
     perf_tests::do_not_optimize(m);
 }
 
+// Nested non-final IDL objects: each range, its bounds and their keys are all
+// preceded by their sizes.
+class clustering_ranges {
+    std::vector<query::clustering_range> _ranges;
+public:
+    clustering_ranges() {
+        simple_schema s;
+        for (int i = 0; i < 100; ++i) {
+            _ranges.push_back(query::clustering_range::make(
+                    {s.make_ckey(2 * i), true}, {s.make_ckey(2 * i + 1), false}));
+        }
+    }
+    const std::vector<query::clustering_range>& ranges() const { return _ranges; }
+};
+
+PERF_TEST_F(clustering_ranges, serialize_to_bytes_ostream)
+{
+    bytes_ostream out;
+    ser::serialize(out, ranges());
+    perf_tests::do_not_optimize(out);
+    return ranges().size();
+}
+
+PERF_TEST_F(clustering_ranges, serialize_to_buffer)
+{
+    auto buf = ser::serialize_to_buffer<bytes>(ranges());
+    perf_tests::do_not_optimize(buf);
+    return ranges().size();
+}
+
 }
@@ -49,6 +49,19 @@ int main(int argc, char* argv[]) {
             m.set_clustered_cell(c_key, col, make_atomic_cell(col.type, value));
             mt.apply(std::move(m));
         });
+
+        std::cout << "Timing range deletions appended to one partition...\n";
+
+        replica::memtable rt_mt(s);
+        auto rt_key = partition_key::from_exploded(*s, {to_bytes("key2")});
+        int32_t next_ck = 0;
+        time_it([&] {
+            mutation m(s, rt_key);
+            auto start = clustering_key::from_exploded(*s, {int32_type->decompose(next_ck++)});
+            auto end = clustering_key::from_exploded(*s, {int32_type->decompose(next_ck++)});
+            m.partition().apply_delete(*s, range_tombstone(std::move(start), std::move(end), tombstone(1, gc_clock::now())));
+            rt_mt.apply(std::move(m));
+        });
         engine().exit(0);
     });
 }
@@ -6,12 +6,14 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
+#include <seastar/core/circular_buffer.hh>
 #include <seastar/testing/perf_tests.hh>
 
 #include "test/lib/simple_schema.hh"
 #include "test/perf/perf.hh"
 
 #include "mutation_fragment.hh"
+#include "mutation_fragment_v2.hh"
 
 namespace tests {
 
@@ -68,6 +70,14 @@ class clustering_row {
     mutation_fragment make_clustering_row_1M() const {
         return _schema.make_row_from_serialized_value(_permit, _key, _value_1M);
     }
+
+    mutation_fragment_v2 make_clustering_row_v2(const mutation_fragment& mf) const {
+        return mutation_fragment_v2(*schema(), _permit, ::clustering_row(*schema(), mf.as_clustering_row()));
+    }
+
+    mutation_fragment_v2 make_range_tombstone_change_v2() const {
+        return mutation_fragment_v2(*schema(), _permit, range_tombstone_change(position_in_partition::before_key(_key), tombstone(1, gc_clock::now())));
+    }
 };
 
 PERF_TEST_F(clustering_row, make_4)
@@ -106,6 +116,30 @@ PERF_TEST_F(clustering_row, copy_1M)
     perf_tests::do_not_optimize(mf);
 }
 
+// Fragments of a read reuse the storage of the ones destroyed before them,
+// so these should do only the allocations of the row itself.
+PERF_TEST_F(clustering_row, make_v2_4)
+{
+    auto mf = make_clustering_row_v2(clustering_row_4());
+    perf_tests::do_not_optimize(mf);
+}
+
+PERF_TEST_F(clustering_row, make_v2_range_tombstone_change)
+{
+    auto mf = make_range_tombstone_change_v2();
+    perf_tests::do_not_optimize(mf);
+}
+
+PERF_TEST_F(clustering_row, make_v2_buffer)
+{
+    circular_buffer<mutation_fragment_v2> buffer;
+    for (unsigned i = 0; i < 32; ++i) {
+        buffer.emplace_back(make_range_tombstone_change_v2());
+    }
+    perf_tests::do_not_optimize(buffer);
+    return buffer.size();
+}
+
 PERF_TEST_F(clustering_row, hash_4)
 {
     clustering_row_4().mutate_as_clustering_row(*schema(), [&] (::clustering_row& cr) mutable {
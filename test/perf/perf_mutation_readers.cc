@@ -33,12 +33,14 @@ class combined {
     std::vector<std::vector<mutation>> _disjoint_interleaved;
     std::vector<std::vector<mutation>> _disjoint_ranges;
     std::vector<std::vector<mutation>> _overlapping_partitions_disjoint_rows;
+    std::vector<std::vector<mutation>> _overlapping_partitions_interleaved_rows;
 private:
     static std::vector<mutation> create_one_row(simple_schema&, reader_permit);
     static std::vector<mutation> create_single_stream(simple_schema&, reader_permit);
     static std::vector<std::vector<mutation>> create_disjoint_interleaved_streams(simple_schema&, reader_permit);
     static std::vector<std::vector<mutation>> create_disjoint_ranges_streams(simple_schema&, reader_permit);
     static std::vector<std::vector<mutation>> create_overlapping_partitions_disjoint_rows_streams(simple_schema&, reader_permit);
+    static std::vector<std::vector<mutation>> create_overlapping_partitions_interleaved_rows_streams(simple_schema&, reader_permit);
 protected:
     simple_schema& schema() const { return _schema; }
     reader_permit permit() const { return _permit; }
@@ -53,6 +55,9 @@ class combined {
     const std::vector<std::vector<mutation>>& overlapping_partitions_disjoint_rows_streams() const {
         return _overlapping_partitions_disjoint_rows;
     }
+    const std::vector<std::vector<mutation>>& overlapping_partitions_interleaved_rows_streams() const {
+        return _overlapping_partitions_interleaved_rows;
+    }
     future<> consume_all(flat_mutation_reader_v2 mr) const;
 public:
     combined()
@@ -63,6 +68,7 @@ class combined {
         , _disjoint_interleaved(create_disjoint_interleaved_streams(_schema, _permit))
         , _disjoint_ranges(create_disjoint_ranges_streams(_schema, _permit))
         , _overlapping_partitions_disjoint_rows(create_overlapping_partitions_disjoint_rows_streams(_schema, _permit))
+        , _overlapping_partitions_interleaved_rows(create_overlapping_partitions_interleaved_rows_streams(_schema, _permit))
     { }
 };
 
@@ -138,6 +144,27 @@ std::vector<std::vector<mutation>> combined::create_overlapping_partitions_disjo
     return mss;
 }
 
+// Resembles a read of partitions written to many sstables over time, as after
+// size-tiered compaction fell behind.
+std::vector<std::vector<mutation>> combined::create_overlapping_partitions_interleaved_rows_streams(simple_schema& s, reader_permit permit) {
+    const int streams = 24;
+    auto keys = s.make_pkeys(4);
+    std::vector<std::vector<mutation>> mss;
+    for (int i = 0; i < streams; i++) {
+        mss.emplace_back(boost::copy_range<std::vector<mutation>>(
+            keys
+            | boost::adaptors::transformed([&] (auto& dkey) {
+                auto m = mutation(s.schema(), dkey);
+                for (int j = 0; j < 16; j++) {
+                    m.apply(s.make_row(permit, s.make_ckey(streams * j + i), "value"));
+                }
+                return m;
+            })
+        ));
+    }
+    return mss;
+}
+
 future<> combined::consume_all(flat_mutation_reader_v2 mr) const
 {
     return with_closeable(mutation_fragment_v1_stream(std::move(mr)), [] (auto& mr) {
@@ -222,6 +249,18 @@ PERF_TEST_F(combined, overlapping_partitions_disjoint_rows)
     ));
 }
 
+PERF_TEST_F(combined, many_overlapping_partitions_interleaved_rows)
+{
+    return consume_all(make_combined_reader(schema().schema(), permit(),
+        boost::copy_range<std::vector<flat_mutation_reader_v2>>(
+            overlapping_partitions_interleaved_rows_streams()
+            | boost::adaptors::transformed([this] (auto&& ms) {
+                return make_flat_mutation_reader_from_mutations_v2(schema().schema(), permit(), std::move(ms));
+            })
+        )
+    ));
+}
+
 struct mutation_bounds {
     mutation m;
     position_in_partition lower;
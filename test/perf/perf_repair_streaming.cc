@@ -0,0 +1,373 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <boost/range/adaptor/transformed.hpp>
+
+#include <seastar/core/app-template.hh>
+#include <seastar/core/coroutine.hh>
+#include <seastar/core/sharded.hh>
+#include <seastar/core/thread.hh>
+#include <seastar/core/on_internal_error.hh>
+#include <seastar/util/closeable.hh>
+#include <seastar/testing/test_runner.hh>
+
+#include "test/perf/perf.hh"
+#include "test/lib/mutation_source_test.hh"
+#include "test/lib/random_utils.hh"
+
+#include "readers/from_mutations_v2.hh"
+#include "readers/mutation_fragment_v1_stream.hh"
+#include "repair/hash.hh"
+#include "repair/repair.hh"
+#include "repair/row.hh"
+#include "repair/row_level.hh"
+#include "repair/writer.hh"
+#include "frozen_mutation.hh"
+
+// Measures the per-row cost of the repair and streaming data paths, without
+// the network and the sstables on either end.
+//
+// Both modes process the partitions of a randomly generated data set, one
+// partition per operation:
+//
+//  - repair: the partition is read and every row is frozen and hashed, the way
+//    a repair follower reads rows from disk. The rows the master's hash set is
+//    missing are sent to the master, which unfreezes and hashes them again and
+//    flushes them into its repair writer. The master's data diverges from the
+//    follower's by the --divergence share of rows.
+//  - stream: every fragment of the partition is frozen, the way the sender of a
+//    stream serializes it, and unfrozen, the way the receiver does.
+
+struct test_config {
+    enum class run_mode {
+        repair,
+        stream,
+    };
+
+    run_mode mode;
+    unsigned partitions;
+    double divergence;
+    unsigned concurrency;
+    unsigned duration_in_seconds;
+    unsigned operations_per_shard = 0;
+};
+
+// What the operations process on a shard, over all of its partitions.
+struct data_set_stats {
+    uint64_t partitions = 0;
+    // Rows read by the sending side.
+    uint64_t rows = 0;
+    // Size of the frozen rows sent.
+    uint64_t bytes = 0;
+
+    data_set_stats operator+(const data_set_stats& o) const {
+        return {partitions + o.partitions, rows + o.rows, bytes + o.bytes};
+    }
+};
+
+struct rsperf_result : public perf_result {
+    double rows_per_second;
+    double bytes_per_second;
+    double instructions_per_row;
+};
+
+std::ostream& operator<<(std::ostream& os, const rsperf_result& result) {
+    fmt::print(os, "{:.2f} tps ({:5.1f} allocs/op, {:5.1f} tasks/op, {:7.0f} insns/op, {:8} errors, {:.0f} rows/s, {:.0f} bytes/s, {:7.0f} insns/row)",
+            result.throughput, result.mallocs_per_op, result.tasks_per_op, result.instructions_per_op, result.errors,
+            result.rows_per_second, result.bytes_per_second, result.instructions_per_row);
+    return os;
+}
+
+// Drops the fragments the master's repair writer would write to an sstable.
+class discarding_queue_impl : public mutation_fragment_queue::impl {
+public:
+    virtual future<> push(mutation_fragment_v2 mf) override {
+        return make_ready_future();
+    }
+
+    virtual void abort(std::exception_ptr ep) override {}
+
+    virtual void push_end_of_stream() override {}
+};
+
+class discarding_repair_writer_impl : public repair_writer::impl {
+    mutation_fragment_queue _queue;
+public:
+    discarding_repair_writer_impl(schema_ptr s, reader_permit permit)
+        : _queue(std::move(s), std::move(permit), seastar::make_shared<discarding_queue_impl>())
+    {}
+
+    virtual future<> wait_for_writer_done() override {
+        return make_ready_future();
+    }
+
+    virtual mutation_fragment_queue& queue() override {
+        return _queue;
+    }
+
+    virtual void create_writer(lw_shared_ptr<repair_writer> writer) override {}
+};
+
+class replica_pair {
+    test_config _cfg;
+    random_mutation_generator _gen;
+    schema_ptr _schema;
+    perf::reader_concurrency_semaphore_wrapper _semaphore;
+    uint64_t _seed;
+    repair_hasher _hasher;
+    // The follower's partitions.
+    std::vector<mutation> _partitions;
+    // Hashes of the master's rows.
+    repair_hash_set _master_hashes;
+    data_set_stats _stats;
+    size_t _next = 0;
+
+public:
+    explicit replica_pair(test_config cfg)
+        : _cfg(cfg)
+        , _gen(random_mutation_generator::generate_counters::no)
+        , _schema(_gen.schema())
+        , _semaphore(__FILE__)
+        , _seed(tests::random::get_int<uint64_t>())
+        , _hasher(_seed, _schema)
+    {}
+
+    future<> init() {
+        _partitions = _gen(_cfg.partitions);
+        _stats.partitions = _partitions.size();
+        for (const auto& m : _partitions) {
+            auto permit = _semaphore.make_permit();
+            auto reader = mutation_fragment_v1_stream(make_flat_mutation_reader_from_mutations_v2(_schema, permit, m));
+            lw_shared_ptr<const decorated_key_with_hash> dk;
+            while (auto mf = co_await reader()) {
+                if (_cfg.mode == test_config::run_mode::stream) {
+                    _stats.rows++;
+                    _stats.bytes += freeze(*_schema, *mf).representation().size();
+                    continue;
+                }
+                if (!is_repair_row(*mf, dk)) {
+                    continue;
+                }
+                _stats.rows++;
+                if (tests::random::get_real<double>(1) < _cfg.divergence) {
+                    _stats.bytes += freeze(*_schema, *mf).representation().size();
+                } else {
+                    _master_hashes.insert(_hasher.do_hash_for_mf(*dk, *mf));
+                }
+            }
+            co_await reader.close();
+        }
+    }
+
+    future<> stop() {
+        return make_ready_future();
+    }
+
+    data_set_stats stats() const {
+        return _stats;
+    }
+
+    future<> run_one() {
+        const auto& m = _partitions[_next++ % _partitions.size()];
+        switch (_cfg.mode) {
+        case test_config::run_mode::repair:
+            return seastar::async([this, &m] {
+                repair_partition(m);
+            });
+        case test_config::run_mode::stream:
+            return stream_partition(m);
+        }
+        abort();
+    }
+
+private:
+    // Sets dk on partition start. Returns false for fragments repair doesn't
+    // send: partition_end and partition_start without a tombstone.
+    bool is_repair_row(const mutation_fragment& mf, lw_shared_ptr<const decorated_key_with_hash>& dk) const {
+        if (mf.is_partition_start()) {
+            auto& start = mf.as_partition_start();
+            dk = make_lw_shared<const decorated_key_with_hash>(*_schema, start.key(), _seed);
+            return bool(start.partition_tombstone());
+        }
+        return !mf.is_end_of_partition();
+    }
+
+    // Must run inside a seastar thread
+    void repair_partition(const mutation& m) {
+        auto permit = _semaphore.make_permit();
+        auto reader = mutation_fragment_v1_stream(make_flat_mutation_reader_from_mutations_v2(_schema, permit, m));
+        auto close_reader = deferred_close(reader);
+
+        // Follower: read and hash the rows, collect the ones the master lacks.
+        repair_rows_on_wire rows;
+        lw_shared_ptr<const decorated_key_with_hash> dk;
+        while (auto mf = reader().get0()) {
+            if (!is_repair_row(*mf, dk)) {
+                continue;
+            }
+            auto fmf = freeze(*_schema, *mf);
+            if (_master_hashes.contains(_hasher.do_hash_for_mf(*dk, *mf))) {
+                continue;
+            }
+            if (rows.empty()) {
+                rows.push_back(partition_key_and_mutation_fragments(dk->dk.key(), {}));
+            }
+            rows.back().push_mutation_fragment(std::move(fmf));
+        }
+        if (rows.empty()) {
+            return;
+        }
+
+        // Master: apply the rows received from the follower.
+        auto row_diff = to_repair_rows_list(std::move(rows), _schema, _seed, repair_master::yes, permit, _hasher).get0();
+        auto writer = make_lw_shared<repair_writer>(_schema, permit, std::make_unique<discarding_repair_writer_impl>(_schema, permit));
+        flush_rows(_schema, row_diff, writer);
+        writer->wait_for_writer_done().get();
+    }
+
+    future<> stream_partition(const mutation& m) {
+        auto permit = _semaphore.make_permit();
+        auto reader = mutation_fragment_v1_stream(make_flat_mutation_reader_from_mutations_v2(_schema, permit, m));
+        std::exception_ptr ex;
+        try {
+            while (auto mf = co_await reader()) {
+                auto fmf = freeze(*_schema, *mf);
+                auto received = fmf.unfreeze(*_schema, permit);
+            }
+        } catch (...) {
+            ex = std::current_exception();
+        }
+        co_await reader.close();
+        if (ex) {
+            std::rethrow_exception(ex);
+        }
+    }
+};
+
+static void write_json_result(std::string result_file, const test_config& cfg, const std::vector<rsperf_result>& results,
+        rsperf_result median, double mad, double max, double min) {
+    perf::json_result result(cfg.mode == test_config::run_mode::repair ? "repair" : "stream");
+
+    auto& params = result.parameters();
+    params["concurrency"] = cfg.concurrency;
+    params["partitions"] = cfg.partitions;
+    params["divergence"] = cfg.divergence;
+    params["duration"] = cfg.duration_in_seconds;
+    params["concurrency,partitions,cpus,duration"] = fmt::format("{},{},{},{}", cfg.concurrency, cfg.partitions, smp::count, cfg.duration_in_seconds);
+
+    auto& stats = result.stats();
+    stats["median tps"] = median.throughput;
+    stats["allocs_per_op"] = median.mallocs_per_op;
+    stats["tasks_per_op"] = median.tasks_per_op;
+    stats["instructions_per_op"] = median.instructions_per_op;
+    stats["rows_per_second"] = median.rows_per_second;
+    stats["bytes_per_second"] = median.bytes_per_second;
+    stats["instructions_per_row"] = median.instructions_per_row;
+    stats["mad tps"] = mad;
+    stats["max tps"] = max;
+    stats["min tps"] = min;
+
+    result.add_perf_results(results);
+    result.add_metric("rows_per_second", boost::copy_range<std::vector<double>>(
+            results | boost::adaptors::transformed(std::mem_fn(&rsperf_result::rows_per_second))), perf::better::higher);
+    result.add_metric("instructions_per_row", boost::copy_range<std::vector<double>>(
+            results | boost::adaptors::transformed(std::mem_fn(&rsperf_result::instructions_per_row))), perf::better::lower);
+    result.write(result_file);
+}
+
+static std::vector<rsperf_result> do_test(distributed<replica_pair>& replicas, const test_config& cfg, const data_set_stats& stats) {
+    auto rows_per_op = double(stats.rows) / stats.partitions;
+    auto bytes_per_op = double(stats.bytes) / stats.partitions;
+
+    return time_parallel_ex<rsperf_result>([&replicas] {
+        return replicas.local().run_one();
+    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, true, [rows_per_op, bytes_per_op] (rsperf_result& result, const executor_shard_stats&) {
+        result.rows_per_second = result.throughput * rows_per_op;
+        result.bytes_per_second = result.throughput * bytes_per_op;
+        result.instructions_per_row = result.instructions_per_op / rows_per_op;
+    });
+}
+
+int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
+    app_template app;
+    app.add_options()
+        ("random-seed", boost::program_options::value<unsigned>(), "Random number generator seed")
+        ("partitions", bpo::value<unsigned>()->default_value(1000), "number of partitions per shard")
+        ("divergence", bpo::value<double>()->default_value(0.1), "share of the rows the repair master is missing")
+        ("stream", "test the streaming path instead of the repair path")
+        ("duration", bpo::value<unsigned>()->default_value(5), "test duration in seconds")
+        ("concurrency", bpo::value<unsigned>()->default_value(16), "workers per core")
+        ("operations-per-shard", bpo::value<unsigned>(), "run this many operations per shard (overrides duration)")
+        ("json-result", bpo::value<std::string>(), "name of the json result file")
+        ;
+
+    set_abort_on_internal_error(true);
+
+    return app.run(argc, argv, [&app_in = app] () -> future<> {
+        auto& app = app_in;
+        auto conf_seed = app.configuration()["random-seed"];
+        auto seed = conf_seed.empty() ? std::random_device()() : conf_seed.as<unsigned>();
+        std::cout << "random-seed=" << seed << '\n';
+
+        co_await smp::invoke_on_all([seed] {
+            seastar::testing::local_random_engine.seed(seed + this_shard_id());
+        });
+
+        auto cfg = test_config();
+        cfg.mode = app.configuration().contains("stream") ? test_config::run_mode::stream : test_config::run_mode::repair;
+        cfg.partitions = std::max(app.configuration()["partitions"].as<unsigned>(), 1u);
+        cfg.divergence = app.configuration()["divergence"].as<double>();
+        cfg.duration_in_seconds = app.configuration()["duration"].as<unsigned>();
+        cfg.concurrency = app.configuration()["concurrency"].as<unsigned>();
+        if (app.configuration().contains("operations-per-shard")) {
+            cfg.operations_per_shard = app.configuration()["operations-per-shard"].as<unsigned>();
+        }
+
+        distributed<replica_pair> replicas;
+        co_await replicas.start(cfg);
+        std::exception_ptr ex;
+
+        try {
+            co_await replicas.invoke_on_all(std::mem_fn(&replica_pair::init));
+            auto stats = co_await replicas.map_reduce0(std::mem_fn(&replica_pair::stats), data_set_stats(), std::plus<data_set_stats>());
+            std::cout << format("{} partitions, {} rows, {} bytes to send\n", stats.partitions, stats.rows, stats.bytes);
+
+            // test "framework" expects seastar thread
+            auto results = co_await seastar::async([&] {
+                return do_test(replicas, cfg, stats);
+            });
+
+            auto compare_throughput = [] (const rsperf_result& a, const rsperf_result& b) { return a.throughput < b.throughput; };
+            std::sort(results.begin(), results.end(), compare_throughput);
+            auto median_result = results[results.size() / 2];
+            auto median = median_result.throughput;
+            auto min = results[0].throughput;
+            auto max = results[results.size() - 1].throughput;
+            auto absolute_deviations = boost::copy_range<std::vector<double>>(
+                    results
+                    | boost::adaptors::transformed(std::mem_fn(&perf_result::throughput))
+                    | boost::adaptors::transformed([&] (double r) { return abs(r - median); }));
+            std::sort(absolute_deviations.begin(), absolute_deviations.end());
+            auto mad = absolute_deviations[results.size() / 2];
+            std::cout << format("\nmedian {}\nmedian absolute deviation: {:.2f}\nmaximum: {:.2f}\nminimum: {:.2f}\n", median_result, mad, max, min);
+
+            if (app.configuration().contains("json-result")) {
+                write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, results, median_result, mad, max, min);
+            }
+        } catch (...) {
+            ex = std::current_exception();
+        }
+
+        co_await replicas.stop();
+
+        if (ex) {
+            std::rethrow_exception(ex);
+        }
+    });
+}
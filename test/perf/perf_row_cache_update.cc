@@ -28,6 +28,9 @@ static const int update_iterations = 16;
 static const int cell_size = 128;
 static bool cancelled = false;
 
+// Values of the metrics of all scenarios over the update iterations, for --json-result.
+static std::map<sstring, std::vector<double>> metrics;
+
 template<typename MutationGenerator>
 void run_test(const sstring& name, schema_ptr s, MutationGenerator&& gen) {
     tests::reader_concurrency_semaphore_wrapper semaphore;
@@ -59,6 +62,7 @@ void run_test(const sstring& name, schema_ptr s, MutationGenerator&& gen) {
         });
         memtable_slm.stop();
         std::cout << format("Memtable fill took {:.6f} [ms], {}", fill_d.count() * 1000, memtable_slm) << std::endl;
+        metrics[name + ": fill [ms]"].push_back(fill_d.count() * 1000);
 
         std::cout << "Draining..." << std::endl;
         auto drain_d = duration_in_seconds([&] {
@@ -121,6 +125,9 @@ void run_test(const sstring& name, schema_ptr s, MutationGenerator&& gen) {
             tracker.get_stats().rows_processed_from_memtable - prev_rows_processed_from_memtable,
             tracker.get_stats().rows_merged_from_memtable - prev_rows_merged_from_memtable,
             tracker.get_stats().rows_dropped_from_memtable - prev_rows_dropped_from_memtable);
+        metrics[name + ": update [ms]"].push_back(d.count() * 1000);
+        metrics[name + ": update max preemption [ms]"].push_back(std::chrono::duration<double, std::milli>(slm.max()).count());
+        metrics[name + ": update compaction amplification"].push_back(float(compacted) / allocated);
     }
 
     scheduling_latency_measurer invalidate_slm;
@@ -131,6 +138,7 @@ void run_test(const sstring& name, schema_ptr s, MutationGenerator&& gen) {
     invalidate_slm.stop();
 
     std::cout << format("invalidation: {:.6f} [ms], preemption: {}", d.count() * 1000, invalidate_slm) << "\n";
+    metrics[name + ": invalidation [ms]"].push_back(d.count() * 1000);
 }
 
 void test_small_partitions() {
@@ -262,7 +270,10 @@ void test_partition_with_lots_of_range_tombstones_with_residuals() {
 }
 
 int main(int argc, char** argv) {
+    namespace bpo = boost::program_options;
     app_template app;
+    app.add_options()
+        ("json-result", bpo::value<std::string>(), "name of the json result file");
     return app.run(argc, argv, [&app] {
         return seastar::async([&] {
             engine().at_exit([] {
@@ -275,6 +286,14 @@ int main(int argc, char** argv) {
             test_partition_with_lots_of_small_rows();
             test_partition_with_lots_of_range_tombstones();
             test_partition_with_lots_of_range_tombstones_with_residuals();
+
+            if (app.configuration().contains("json-result")) {
+                perf::json_result result("row_cache_update");
+                for (auto& [name, values] : metrics) {
+                    result.add_metric(name, std::move(values), perf::better::lower);
+                }
+                result.write(app.configuration()["json-result"].as<std::string>());
+            }
         });
     });
 }
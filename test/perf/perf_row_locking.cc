@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/testing/perf_tests.hh>
+
+#include "cell_locking.hh"
+#include "db/view/row_locking.hh"
+#include "mutation.hh"
+#include "schema_builder.hh"
+
+// Uncontended lock acquisitions, as done by counter updates (cell_locker)
+// and view updates (row_locker) of distinct rows.
+class locking {
+public:
+    static constexpr size_t count = 100;
+private:
+    schema_ptr _schema;
+    cell_locker_stats _cl_stats;
+    cell_locker _cell_locker;
+    row_locker _row_locker;
+    row_locker::stats _rl_stats;
+    std::vector<mutation> _mutations;
+    db::timeout_clock::time_point _timeout = db::no_timeout;
+public:
+    locking()
+        : _schema(schema_builder("ks", "cf")
+                .with_column("pk", int32_type, column_kind::partition_key)
+                .with_column("ck", int32_type, column_kind::clustering_key)
+                .with_column("v1", int32_type)
+                .with_column("v2", int32_type)
+                .build())
+        , _cell_locker(_schema, _cl_stats)
+        , _row_locker(_schema)
+    {
+        auto& v1 = *_schema->get_column_definition("v1");
+        auto& v2 = *_schema->get_column_definition("v2");
+        for (size_t i = 0; i < count; i++) {
+            auto m = mutation(_schema, partition_key::from_single_value(*_schema, int32_type->decompose(int32_t(i))));
+            auto ck = clustering_key::from_single_value(*_schema, int32_type->decompose(int32_t(i)));
+            m.set_clustered_cell(ck, v1, atomic_cell::make_live(*int32_type, 0, int32_type->decompose(int32_t(1))));
+            m.set_clustered_cell(ck, v2, atomic_cell::make_live(*int32_type, 0, int32_type->decompose(int32_t(2))));
+            _mutations.emplace_back(std::move(m));
+        }
+    }
+
+    const std::vector<mutation>& mutations() const { return _mutations; }
+    cell_locker& cells() { return _cell_locker; }
+    row_locker& rows() { return _row_locker; }
+    row_locker::stats& row_stats() { return _rl_stats; }
+    db::timeout_clock::time_point timeout() const { return _timeout; }
+};
+
+PERF_TEST_F(locking, cell_locker_new_partition) {
+    for (auto& m : mutations()) {
+        auto f = cells().lock_cells(m.decorated_key(), partition_cells_range(m.partition()), timeout());
+        perf_tests::do_not_optimize(f.get0());
+    }
+    return count;
+}
+
+PERF_TEST_F(locking, cell_locker_held_partition) {
+    // Another row of the partition is locked, so the lookup goes through
+    // the existing partition entry.
+    auto& held = mutations().front();
+    auto holder = cells().lock_cells(held.decorated_key(), partition_cells_range(held.partition()), timeout()).get0();
+    auto m = mutation(held.schema(), held.decorated_key());
+    for (auto& other : mutations()) {
+        if (&other == &held) {
+            continue;
+        }
+        m.partition() = mutation_partition(*m.schema(), other.partition());
+        auto f = cells().lock_cells(m.decorated_key(), partition_cells_range(m.partition()), timeout());
+        perf_tests::do_not_optimize(f.get0());
+    }
+    return count - 1;
+}
+
+PERF_TEST_F(locking, row_locker_lock_ck) {
+    for (auto& m : mutations()) {
+        auto& ck = m.partition().clustered_rows().begin()->key();
+        auto f = rows().lock_ck(m.decorated_key(), ck, true, timeout(), row_stats());
+        perf_tests::do_not_optimize(f.get0());
+    }
+    return count;
+}
+
+PERF_TEST_F(locking, row_locker_lock_pk) {
+    for (auto& m : mutations()) {
+        auto f = rows().lock_pk(m.decorated_key(), false, timeout(), row_stats());
+        perf_tests::do_not_optimize(f.get0());
+    }
+    return count;
+}
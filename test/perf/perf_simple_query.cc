@@ -6,22 +6,19 @@
  * SPDX-License-Identifier: AGPL-3.0-or-later
  */
 
-#include <boost/algorithm/string/split.hpp>
-#include <boost/algorithm/string/classification.hpp>
-#include <json/json.h>
-
 #include <boost/range/irange.hpp>
 #include "test/lib/cql_test_env.hh"
 #include "test/lib/alternator_test_env.hh"
 #include "test/perf/perf.hh"
 #include <seastar/core/app-template.hh>
+#include <seastar/core/loop.hh>
 #include <seastar/testing/test_runner.hh>
 #include "test/lib/random_utils.hh"
 
 #include "db/config.hh"
 #include "schema_builder.hh"
-#include "release.hh"
-#include <fstream>
+#include <array>
+#include <cmath>
 #include "service/storage_proxy.hh"
 #include "cql3/query_processor.hh"
 #include "db/config.hh"
@@ -59,8 +56,9 @@ static void execute_counter_update_for_key(cql_test_env& env, const bytes& key)
 };
 
 struct test_config {
-    enum class run_mode { read, write, del };
+    enum class run_mode { read, write, del, workload };
     enum class frontend_type { cql, alternator };
+    enum class key_distribution { uniform, zipfian, latest };
 
     run_mode mode;
     frontend_type frontend;
@@ -74,6 +72,16 @@ struct test_config {
     bool stop_on_error;
     sstring timeout;
     bool bypass_cache;
+
+    // Used by run_mode::workload only. The ratios are relative to their sum.
+    double read_ratio;
+    double update_ratio;
+    double scan_ratio;
+    key_distribution distribution;
+    double zipfian_theta;
+    unsigned rows_per_partition;
+    unsigned row_size;
+    unsigned scan_rows;
 };
 
 std::ostream& operator<<(std::ostream& os, const test_config::run_mode& m) {
@@ -81,6 +89,16 @@ std::ostream& operator<<(std::ostream& os, const test_config::run_mode& m) {
         case test_config::run_mode::write: return os << "write";
         case test_config::run_mode::read: return os << "read";
         case test_config::run_mode::del: return os << "delete";
+        case test_config::run_mode::workload: return os << "workload";
+    }
+    abort();
+}
+
+std::ostream& operator<<(std::ostream& os, const test_config::key_distribution& d) {
+    switch (d) {
+        case test_config::key_distribution::uniform: return os << "uniform";
+        case test_config::key_distribution::zipfian: return os << "zipfian";
+        case test_config::key_distribution::latest: return os << "latest";
     }
     abort();
 }
@@ -94,13 +112,23 @@ std::ostream& operator<<(std::ostream& os, const test_config::frontend_type& f)
 }
 
 std::ostream& operator<<(std::ostream& os, const test_config& cfg) {
-    return os << "{partitions=" << cfg.partitions
-           << ", concurrency=" << cfg.concurrency
-           << ", mode=" << cfg.mode
-           << ", frontend=" << cfg.frontend
-           << ", query_single_key=" << (cfg.query_single_key ? "yes" : "no")
-           << ", counters=" << (cfg.counters ? "yes" : "no")
-           << "}";
+    os << "{partitions=" << cfg.partitions
+       << ", concurrency=" << cfg.concurrency
+       << ", mode=" << cfg.mode
+       << ", frontend=" << cfg.frontend
+       << ", query_single_key=" << (cfg.query_single_key ? "yes" : "no")
+       << ", counters=" << (cfg.counters ? "yes" : "no");
+    if (cfg.mode == test_config::run_mode::workload) {
+        os << ", read_ratio=" << cfg.read_ratio
+           << ", update_ratio=" << cfg.update_ratio
+           << ", scan_ratio=" << cfg.scan_ratio
+           << ", key_distribution=" << cfg.distribution
+           << ", zipfian_theta=" << cfg.zipfian_theta
+           << ", rows_per_partition=" << cfg.rows_per_partition
+           << ", row_size=" << cfg.row_size
+           << ", scan_rows=" << cfg.scan_rows;
+    }
+    return os << "}";
 }
 
 static void create_partitions(cql_test_env& env, test_config& cfg) {
@@ -195,6 +223,222 @@ static std::vector<perf_result> test_counter_update(cql_test_env& env, test_conf
         }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error);
 }
 
+// Generates ranks in [0, n) with a zipfian distribution, rank 0 being the
+// most popular, following "Quickly Generating Billion-Record Synthetic
+// Databases" (Gray et al.), like YCSB does.
+class zipfian_generator {
+    uint64_t _n;
+    double _theta;
+    double _alpha;
+    double _zetan;
+    double _eta;
+private:
+    static double zeta(uint64_t n, double theta) {
+        double sum = 0;
+        for (uint64_t i = 1; i <= n; ++i) {
+            sum += 1 / std::pow(double(i), theta);
+        }
+        return sum;
+    }
+public:
+    zipfian_generator(uint64_t n, double theta)
+        : _n(n)
+        , _theta(theta)
+        , _alpha(1 / (1 - theta))
+        , _zetan(zeta(n, theta))
+        , _eta((1 - std::pow(2.0 / n, 1 - theta)) / (1 - zeta(2, theta) / _zetan))
+    { }
+    uint64_t operator()() const {
+        const auto u = tests::random::get_real<double>(0, 1);
+        const auto uz = u * _zetan;
+        if (uz < 1) {
+            return 0;
+        }
+        if (uz < 1 + std::pow(0.5, _theta)) {
+            return 1;
+        }
+        return std::min(_n - 1, uint64_t(_n * std::pow(_eta * u - _eta + 1, _alpha)));
+    }
+};
+
+// Picks the partitions accessed by the workload. With the latest
+// distribution, the partitions populated last are the most popular.
+class workload_key_generator {
+    test_config::key_distribution _distribution;
+    uint64_t _partitions;
+    std::optional<zipfian_generator> _zipfian;
+public:
+    explicit workload_key_generator(const test_config& cfg)
+        : _distribution(cfg.distribution)
+        , _partitions(cfg.partitions)
+    {
+        if (_distribution != test_config::key_distribution::uniform) {
+            _zipfian.emplace(_partitions, cfg.zipfian_theta);
+        }
+    }
+    int64_t operator()() const {
+        switch (_distribution) {
+        case test_config::key_distribution::uniform:
+            return tests::random::get_int<uint64_t>(_partitions - 1);
+        case test_config::key_distribution::zipfian:
+            return (*_zipfian)();
+        case test_config::key_distribution::latest:
+            return _partitions - 1 - (*_zipfian)();
+        }
+        abort();
+    }
+};
+
+enum class workload_op { read, update, scan };
+static constexpr size_t workload_ops = 3;
+
+static const char* to_string(workload_op op) {
+    switch (op) {
+        case workload_op::read: return "read";
+        case workload_op::update: return "update";
+        case workload_op::scan: return "scan";
+    }
+    abort();
+}
+
+using workload_latencies = std::array<utils::estimated_histogram, workload_ops>;
+
+// Latencies of the operations executed on this shard in the current
+// iteration, in microseconds.
+static thread_local workload_latencies shard_workload_latencies;
+
+// Latencies of the operations of each iteration, merged over all shards.
+static std::vector<workload_latencies> workload_iteration_latencies;
+
+// Merges the latencies of all shards, and resets them for the next iteration.
+static workload_latencies collect_workload_latencies() {
+    auto latencies = map_reduce(boost::irange(0u, smp::count), [] (unsigned shard) {
+        return smp::submit_to(shard, [] {
+            return std::exchange(shard_workload_latencies, workload_latencies{});
+        });
+    }, workload_latencies{}, [] (workload_latencies a, const workload_latencies& b) {
+        for (size_t i = 0; i < workload_ops; ++i) {
+            a[i].merge(b[i]);
+        }
+        return a;
+    }).get0();
+    return latencies;
+}
+
+static schema_ptr make_workload_schema(std::string_view ks_name) {
+    return schema_builder(ks_name, "cf")
+            .with_column("pk", long_type, column_kind::partition_key)
+            .with_column("ck", long_type, column_kind::clustering_key)
+            .with_column("v", bytes_type)
+            .build();
+}
+
+static std::vector<perf_result> test_workload(cql_test_env& env, test_config& cfg) {
+    const auto total_ratio = cfg.read_ratio + cfg.update_ratio + cfg.scan_ratio;
+    if (total_ratio <= 0) {
+        throw std::invalid_argument("the workload needs a positive read, update or scan ratio");
+    }
+    if (cfg.partitions < 2 || cfg.rows_per_partition < 1) {
+        throw std::invalid_argument("the workload needs at least two partitions and a row per partition");
+    }
+    if (cfg.distribution != test_config::key_distribution::uniform && (cfg.zipfian_theta <= 0 || cfg.zipfian_theta >= 1)) {
+        throw std::invalid_argument("zipfian theta has to be in (0, 1)");
+    }
+
+    auto update_id = env.prepare("UPDATE cf SET v = ? WHERE pk = ? AND ck = ?").get0();
+    auto read_id = env.prepare(format("SELECT v FROM cf WHERE pk = ? AND ck = ?{}", cfg.bypass_cache ? " BYPASS CACHE" : "")).get0();
+    auto scan_id = env.prepare(format("SELECT v FROM cf WHERE pk = ? AND ck >= ? LIMIT {}{}", cfg.scan_rows, cfg.bypass_cache ? " BYPASS CACHE" : "")).get0();
+    const auto value = tests::random::get_bytes(cfg.row_size);
+
+    auto make_values = [] (int64_t pk, int64_t ck) {
+        return std::vector<cql3::raw_value>{
+            cql3::raw_value::make_value(long_type->decompose(pk)),
+            cql3::raw_value::make_value(long_type->decompose(ck)),
+        };
+    };
+    auto make_update_values = [&value, make_values] (int64_t pk, int64_t ck) {
+        auto values = make_values(pk, ck);
+        values.insert(values.begin(), cql3::raw_value::make_value(value));
+        return values;
+    };
+
+    std::cout << "Creating " << cfg.partitions << " partitions of " << cfg.rows_per_partition << " rows..." << std::endl;
+    max_concurrent_for_each(boost::irange<int64_t>(0, int64_t(cfg.partitions) * cfg.rows_per_partition), cfg.concurrency, [&] (int64_t i) {
+        return env.execute_prepared(update_id, make_update_values(i / cfg.rows_per_partition, i % cfg.rows_per_partition)).discard_result();
+    }).get();
+    if (cfg.flush_memtables) {
+        std::cout << "Flushing partitions..." << std::endl;
+        env.db().invoke_on_all(&replica::database::flush_all_memtables).get();
+    }
+
+    smp::invoke_on_all([] {
+        shard_workload_latencies = {};
+    }).get();
+    workload_iteration_latencies.clear();
+
+    return time_parallel_ex<perf_result>([&env, &cfg, update_id, read_id, scan_id, total_ratio, make_values, make_update_values, keys = workload_key_generator(cfg)] {
+        const auto pk = keys();
+        const auto ck = tests::random::get_int<int64_t>(cfg.rows_per_partition - 1);
+        const auto x = tests::random::get_real<double>(0, total_ratio);
+        future<> f = make_ready_future<>();
+        workload_op op;
+        if (x < cfg.read_ratio) {
+            op = workload_op::read;
+            f = env.execute_prepared(read_id, make_values(pk, ck)).discard_result();
+        } else if (x < cfg.read_ratio + cfg.update_ratio) {
+            op = workload_op::update;
+            f = env.execute_prepared(update_id, make_update_values(pk, ck)).discard_result();
+        } else {
+            op = workload_op::scan;
+            f = env.execute_prepared(scan_id, make_values(pk, ck)).discard_result();
+        }
+        return f.then([op, start = std::chrono::steady_clock::now()] {
+            const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+            shard_workload_latencies[size_t(op)].add(latency.count());
+        });
+    }, cfg.concurrency, cfg.duration_in_seconds, cfg.operations_per_shard, cfg.stop_on_error, [] (perf_result&, const executor_shard_stats&) {
+        workload_iteration_latencies.push_back(collect_workload_latencies());
+    });
+}
+
+static std::map<std::string, double> latency_percentiles(const workload_latencies& latencies) {
+    std::map<std::string, double> stats;
+    for (size_t i = 0; i < workload_ops; ++i) {
+        const auto& h = latencies[i];
+        if (!h.count()) {
+            continue;
+        }
+        const auto name = to_string(workload_op(i));
+        stats[format("{} p50 latency", name)] = h.percentile(0.5);
+        stats[format("{} p99 latency", name)] = h.percentile(0.99);
+        stats[format("{} p999 latency", name)] = h.percentile(0.999);
+    }
+    return stats;
+}
+
+// Prints the percentiles of the latencies of all iterations. Returns the
+// percentiles of each iteration, keyed by their name in the json result.
+static std::vector<std::map<std::string, double>> report_workload_latencies() {
+    workload_latencies total;
+    std::vector<std::map<std::string, double>> iterations;
+    for (const auto& latencies : workload_iteration_latencies) {
+        for (size_t i = 0; i < workload_ops; ++i) {
+            total[i].merge(latencies[i]);
+        }
+        iterations.push_back(latency_percentiles(latencies));
+    }
+
+    std::cout << "\nlatencies [us]:\n";
+    for (size_t i = 0; i < workload_ops; ++i) {
+        const auto& h = total[i];
+        if (!h.count()) {
+            continue;
+        }
+        std::cout << format("{}: count {}, p50 {}, p99 {}, p999 {}\n", to_string(workload_op(i)), h.count(), h.percentile(0.5), h.percentile(0.99), h.percentile(0.999));
+    }
+    return iterations;
+}
+
 static schema_ptr make_counter_schema(std::string_view ks_name) {
     return schema_builder(ks_name, "cf")
             .with_column("KEY", bytes_type, column_kind::partition_key)
@@ -416,6 +660,9 @@ static std::vector<perf_result> do_cql_test(cql_test_env& env, test_config& cfg)
         if (cfg.counters) {
             return *make_counter_schema(ks_name);
         }
+        if (cfg.mode == test_config::run_mode::workload) {
+            return *make_workload_schema(ks_name);
+        }
         return *schema_builder(ks_name, "cf")
                 .with_column("KEY", bytes_type, column_kind::partition_key)
                 .with_column("C0", bytes_type)
@@ -437,22 +684,33 @@ static std::vector<perf_result> do_cql_test(cql_test_env& env, test_config& cfg)
         }
     case test_config::run_mode::del:
         return test_delete(env, cfg);
+    case test_config::run_mode::workload:
+        return test_workload(env, cfg);
     };
     abort();
 }
 
-void write_json_result(std::string result_file, const test_config& cfg, perf_result median, double mad, double max, double min) {
-    Json::Value results;
+void write_json_result(std::string result_file, const test_config& cfg, const std::vector<perf_result>& results,
+        perf_result median, double mad, double max, double min, const std::vector<std::map<std::string, double>>& latency_stats) {
+    std::string test_type;
+    switch (cfg.mode) {
+    case test_config::run_mode::read: test_type = "read"; break;
+    case test_config::run_mode::write: test_type = "write"; break;
+    case test_config::run_mode::del: test_type = "delete"; break;
+    case test_config::run_mode::workload: test_type = "workload"; break;
+    }
+    if (cfg.counters) {
+        test_type += "_counters";
+    }
+    perf::json_result result(test_type);
 
-    Json::Value params;
+    auto& params = result.parameters();
     params["concurrency"] = cfg.concurrency;
     params["partitions"] = cfg.partitions;
-    params["cpus"] = smp::count;
     params["duration"] = cfg.duration_in_seconds;
     params["concurrency,partitions,cpus,duration"] = fmt::format("{},{},{},{}", cfg.concurrency, cfg.partitions, smp::count, cfg.duration_in_seconds);
-    results["parameters"] = std::move(params);
 
-    Json::Value stats;
+    auto& stats = result.stats();
     stats["median tps"] = median.throughput;
     stats["allocs_per_op"] = median.mallocs_per_op;
     stats["tasks_per_op"] = median.tasks_per_op;
@@ -460,43 +718,23 @@ void write_json_result(std::string result_file, const test_config& cfg, perf_res
     stats["mad tps"] = mad;
     stats["max tps"] = max;
     stats["min tps"] = min;
-    results["stats"] = std::move(stats);
-
-    std::string test_type;
-    switch (cfg.mode) {
-    case test_config::run_mode::read: test_type = "read"; break;
-    case test_config::run_mode::write: test_type = "write"; break;
-    case test_config::run_mode::del: test_type = "delete"; break;
+    // One sample per iteration, so that the comparison can tell noise from
+    // a change. The stats keep the median of the iterations.
+    std::map<std::string, std::vector<double>> latency_samples;
+    for (const auto& iteration : latency_stats) {
+        for (const auto& [name, value] : iteration) {
+            latency_samples[name].push_back(value);
+        }
     }
-    if (cfg.counters) {
-        test_type += "_counters";
+    for (auto& [name, values] : latency_samples) {
+        auto sorted = values;
+        std::sort(sorted.begin(), sorted.end());
+        stats[name] = sorted[sorted.size() / 2];
+        result.add_metric(name, std::move(values), perf::better::lower);
     }
-    results["test_properties"]["type"] = test_type;
-
-    // <version>-<release>
-    auto version_components = std::vector<std::string>{};
-    auto sver = scylla_version();
-    boost::algorithm::split(version_components, sver, boost::is_any_of("-"));
-    // <scylla-build>.<date>.<git-hash>
-    auto release_components = std::vector<std::string>{};
-    boost::algorithm::split(release_components, version_components[1], boost::is_any_of("."));
-
-    Json::Value version;
-    version["commit_id"] = release_components[2];
-    version["date"] = release_components[1];
-    version["version"] = version_components[0];
-
-    // It'd be nice to have std::chrono::format(), wouldn't it?
-    auto current_time = std::time(nullptr);
-    char time_str[100];
-    ::tm time_buf;
-    std::strftime(time_str, sizeof(time_str), "%Y-%m-%d %H:%M:%S", ::localtime_r(&current_time, &time_buf));
-    version["run_date_time"] = time_str;
-
-    results["versions"]["scylla-server"] = std::move(version);
-
-    auto out = std::ofstream(result_file);
-    out << results;
+
+    result.add_perf_results(results);
+    result.write(result_file);
 }
 
 int main(int argc, char** argv) {
@@ -519,6 +757,15 @@ int main(int argc, char** argv) {
         ("stop-on-error", bpo::value<bool>()->default_value(true), "stop after encountering the first error")
         ("timeout", bpo::value<std::string>()->default_value(""), "use timeout")
         ("bypass-cache", "use bypass cache when querying")
+        ("workload", "run a mix of reads, updates and scans of a table with clustering rows, instead of reads or writes, see the workload-* options")
+        ("workload-read-ratio", bpo::value<double>()->default_value(0.5), "ratio of single row reads in the workload")
+        ("workload-update-ratio", bpo::value<double>()->default_value(0.5), "ratio of single row updates in the workload")
+        ("workload-scan-ratio", bpo::value<double>()->default_value(0), "ratio of scans of consecutive rows of a partition in the workload")
+        ("workload-key-distribution", bpo::value<std::string>()->default_value("zipfian"), "distribution of the partitions accessed by the workload: uniform, zipfian, or latest (zipfian favoring the partitions created last)")
+        ("workload-zipfian-theta", bpo::value<double>()->default_value(0.99), "skew of the zipfian and latest distributions, in (0, 1)")
+        ("workload-rows-per-partition", bpo::value<unsigned>()->default_value(1), "number of rows of each partition, more than one makes wide partitions")
+        ("workload-row-size", bpo::value<unsigned>()->default_value(100), "size of the value of a row, in bytes")
+        ("workload-scan-rows", bpo::value<unsigned>()->default_value(10), "number of rows read by a scan")
         ;
 
     set_abort_on_internal_error(true);
@@ -551,6 +798,8 @@ int main(int argc, char** argv) {
                 cfg.mode = test_config::run_mode::write;
             } else if (app.configuration().contains("delete")) {
                 cfg.mode = test_config::run_mode::del;
+            } else if (app.configuration().contains("workload")) {
+                cfg.mode = test_config::run_mode::workload;
             } else {
                 cfg.mode = test_config::run_mode::read;
             };
@@ -565,6 +814,26 @@ int main(int argc, char** argv) {
             cfg.stop_on_error = app.configuration()["stop-on-error"].as<bool>();
             cfg.timeout = app.configuration()["timeout"].as<std::string>();
             cfg.bypass_cache = app.configuration().contains("bypass-cache");
+            cfg.read_ratio = app.configuration()["workload-read-ratio"].as<double>();
+            cfg.update_ratio = app.configuration()["workload-update-ratio"].as<double>();
+            cfg.scan_ratio = app.configuration()["workload-scan-ratio"].as<double>();
+            const auto distribution = app.configuration()["workload-key-distribution"].as<std::string>();
+            if (distribution == "uniform") {
+                cfg.distribution = test_config::key_distribution::uniform;
+            } else if (distribution == "zipfian") {
+                cfg.distribution = test_config::key_distribution::zipfian;
+            } else if (distribution == "latest") {
+                cfg.distribution = test_config::key_distribution::latest;
+            } else {
+                throw std::invalid_argument(format("unknown key distribution {}", distribution));
+            }
+            cfg.zipfian_theta = app.configuration()["workload-zipfian-theta"].as<double>();
+            cfg.rows_per_partition = app.configuration()["workload-rows-per-partition"].as<unsigned>();
+            cfg.row_size = app.configuration()["workload-row-size"].as<unsigned>();
+            cfg.scan_rows = app.configuration()["workload-scan-rows"].as<unsigned>();
+            if (cfg.mode == test_config::run_mode::workload && (cfg.counters || cfg.frontend != test_config::frontend_type::cql)) {
+                throw std::invalid_argument("the workload runs over CQL, without counters");
+            }
             auto results = cfg.frontend == test_config::frontend_type::cql
                     ? do_cql_test(env, cfg)
                     : do_alternator_test(app.configuration()["alternator"].as<std::string>(),
@@ -584,8 +853,13 @@ int main(int argc, char** argv) {
             auto mad = absolute_deviations[results.size() / 2];
             std::cout << format("\nmedian {}\nmedian absolute deviation: {:.2f}\nmaximum: {:.2f}\nminimum: {:.2f}\n", median_result, mad, max, min);
 
+            std::vector<std::map<std::string, double>> latency_stats;
+            if (cfg.mode == test_config::run_mode::workload) {
+                latency_stats = report_workload_latencies();
+            }
+
             if (app.configuration().contains("json-result")) {
-                write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, median_result, mad, max, min);
+                write_json_result(app.configuration()["json-result"].as<std::string>(), cfg, results, median_result, mad, max, min, latency_stats);
             }
           }, std::move(cfg));
         });
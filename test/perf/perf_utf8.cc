@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/testing/perf_tests.hh>
+#include <seastar/testing/test_runner.hh>
+
+#include <random>
+
+#include "utils/ascii.hh"
+#include "utils/utf8.hh"
+#include "utils/fragmented_temporary_buffer.hh"
+
+class text {
+public:
+    static constexpr size_t size = 4096;
+    static constexpr size_t fragment_size = 1000;
+private:
+    bytes _ascii;
+    bytes _mixed;
+    fragmented_temporary_buffer _mixed_fragmented;
+private:
+    static fragmented_temporary_buffer fragmentize(bytes_view v) {
+        std::vector<temporary_buffer<char>> frags;
+        for (size_t pos = 0; pos < v.size(); pos += fragment_size) {
+            auto len = std::min(fragment_size, v.size() - pos);
+            frags.emplace_back(reinterpret_cast<const char*>(v.data() + pos), len);
+        }
+        return fragmented_temporary_buffer(std::move(frags), v.size());
+    }
+public:
+    text()
+        : _ascii(bytes::initialized_later{}, size)
+    {
+        auto eng = seastar::testing::local_random_engine;
+        auto letters = std::uniform_int_distribution<int>('a', 'z');
+        std::generate(_ascii.begin(), _ascii.end(), [&] { return letters(eng); });
+
+        // Latin text with some accented letters and an occasional symbol.
+        auto kind = std::uniform_int_distribution<int>(0, 15);
+        std::string mixed;
+        while (mixed.size() < size) {
+            switch (kind(eng)) {
+            case 0: mixed += "\xc3\xa9"; break;
+            case 1: mixed += "\xe2\x82\xac"; break;
+            default: mixed += char(letters(eng)); break;
+            }
+        }
+        _mixed = to_bytes(mixed);
+        _mixed_fragmented = fragmentize(_mixed);
+    }
+
+    bytes_view ascii() const { return _ascii; }
+    bytes_view mixed() const { return _mixed; }
+    fragmented_temporary_buffer::view mixed_fragmented() const { return fragmented_temporary_buffer::view(_mixed_fragmented); }
+};
+
+PERF_TEST_F(text, utf8_ascii) {
+    perf_tests::do_not_optimize(utils::utf8::validate(ascii()));
+    return ascii().size();
+}
+
+PERF_TEST_F(text, utf8_mixed) {
+    perf_tests::do_not_optimize(utils::utf8::validate(mixed()));
+    return mixed().size();
+}
+
+PERF_TEST_F(text, utf8_mixed_fragmented) {
+    perf_tests::do_not_optimize(utils::utf8::validate_with_error_position_fragmented(mixed_fragmented()));
+    return mixed().size();
+}
+
+PERF_TEST_F(text, ascii) {
+    perf_tests::do_not_optimize(utils::ascii::validate(ascii()));
+    return ascii().size();
+}
@@ -9,6 +9,7 @@
 #include <seastar/testing/perf_tests.hh>
 #include <seastar/testing/test_runner.hh>
 
+#include <limits>
 #include <random>
 
 #include "vint-serialization.hh"
@@ -19,13 +20,14 @@ class vint {
 private:
     std::vector<uint64_t> _integers;
     bytes _serialized;
+    size_t _serialized_size = 0;
 public:
-    vint()
+    explicit vint(uint64_t max_value = std::numeric_limits<uint64_t>::max())
         : _integers(count)
         , _serialized(bytes::initialized_later{}, count * max_vint_length)
     {
         auto eng = seastar::testing::local_random_engine;
-        auto dist = std::uniform_int_distribution<uint64_t>{};
+        auto dist = std::uniform_int_distribution<uint64_t>{0, max_value};
         std::generate_n(_integers.begin(), count, [&] { return dist(eng); });
 
         auto dst = _serialized.data();
@@ -33,10 +35,17 @@ class vint {
             auto len = unsigned_vint::serialize(v, dst);
             dst += len;
         }
+        _serialized_size = dst - _serialized.data();
     }
 
     const std::vector<uint64_t>& integers() const { return _integers; }
-    bytes_view serialized() const { return bytes_view(_serialized.data()); }
+    bytes_view serialized() const { return bytes_view(_serialized.data(), _serialized_size); }
+};
+
+// Mostly single-byte vints, like column index deltas.
+class short_vint : public vint {
+public:
+    short_vint() : vint(200) { }
 };
 
 PERF_TEST_F(vint, serialize) {
@@ -58,3 +67,29 @@ PERF_TEST_F(vint, deserialize) {
     }
     return count;
 }
+
+PERF_TEST_F(vint, deserialize_many) {
+    std::array<uint64_t, count> output;
+    auto src = serialized();
+    perf_tests::do_not_optimize(unsigned_vint::deserialize_many(src, output));
+    perf_tests::do_not_optimize(output);
+    return count;
+}
+
+PERF_TEST_F(short_vint, deserialize) {
+    auto src = serialized();
+    for (auto i = 0u; i < count; i++) {
+        auto len = unsigned_vint::serialized_size_from_first_byte(src.front());
+        perf_tests::do_not_optimize(unsigned_vint::deserialize(src));
+        src.remove_prefix(len);
+    }
+    return count;
+}
+
+PERF_TEST_F(short_vint, deserialize_many) {
+    std::array<uint64_t, count> output;
+    auto src = serialized();
+    perf_tests::do_not_optimize(unsigned_vint::deserialize_many(src, output));
+    perf_tests::do_not_optimize(output);
+    return count;
+}
@@ -151,3 +151,17 @@ def test_hexists(redis_host, redis_port):
     assert r.hexists(key, field) == 0
     assert r.hset(key, field, random_string(10)) == 1
     assert r.hexists(key, field) == 1
+
+def test_hmget(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+    field = random_string(10)
+    field2 = random_string(10)
+    val = random_string(10)
+
+    with pytest.raises(redis.exceptions.ResponseError):
+        r.execute_command("HMGET", key)
+    assert r.hmget(key, field, field2) == [None, None]
+    assert r.hset(key, field, val) == 1
+    assert r.hmget(key, field2, field, field) == [None, val, val]
+    assert r.delete(key) == 1
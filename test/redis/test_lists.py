@@ -0,0 +1,37 @@
+#
+# Copyright (C) 2026-present ScyllaDB
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+
+import pytest
+import redis
+import logging
+from util import random_string, connect
+
+logger = logging.getLogger('redis-test')
+
+def test_lpush_rpush_lrange(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key = random_string(10)
+
+    with pytest.raises(redis.exceptions.ResponseError) as excinfo:
+        r.execute_command("LPUSH testkey")
+    assert "wrong number of arguments for 'lpush' command" in str(excinfo.value)
+
+    assert r.lrange(key, 0, -1) == []
+
+    assert r.rpush(key, 'c', 'd') == 2
+    assert r.lpush(key, 'b', 'a') == 4
+    assert r.rpush(key, 'e') == 5
+    assert r.lrange(key, 0, -1) == ['a', 'b', 'c', 'd', 'e']
+    assert r.lrange(key, 1, 2) == ['b', 'c']
+    assert r.lrange(key, 3, 100) == ['d', 'e']
+    assert r.lrange(key, -2, -1) == ['d', 'e']
+    assert r.lrange(key, -100, -4) == ['a', 'b']
+    assert r.lrange(key, -4, 2) == ['b', 'c']
+    assert r.lrange(key, 2, 1) == []
+    assert r.lrange(key, -1, -2) == []
+
+    assert r.delete(key) == 1
+    assert r.lrange(key, 0, -1) == []
@@ -231,3 +231,38 @@ def test_strlen_wrongtype(redis_host, redis_port):
         r.strlen(key1)
     except redis.exceptions.ResponseError as ex:
         assert str(ex) == 'WRONGTYPE Operation against a key holding the wrong kind of value'
+
+def test_mset_mget(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    key1 = random_string(10)
+    key2 = random_string(10)
+    key3 = random_string(10)
+
+    with pytest.raises(redis.exceptions.ResponseError):
+        r.execute_command("MSET", key1)
+    assert r.mget(key1, key2) == [None, None]
+    # The last value of a repeated key is the one set.
+    assert r.execute_command("MSET", key1, "a", key2, "b", key1, "c") == True
+    assert r.mget(key1, key3, key2, key1) == ["c", None, "b", "c"]
+    assert r.delete(key1, key2) == 2
+
+def test_pipeline(redis_host, redis_port):
+    r = connect(redis_host, redis_port)
+    keys = [random_string(10) for _ in range(20)]
+
+    # The commands of a pipeline run concurrently, but the ones using the same
+    # key see each other's writes, and the replies come in order.
+    p = r.pipeline(transaction=False)
+    for i, key in enumerate(keys):
+        p.set(key, str(i))
+        p.get(key)
+        p.set(key, str(i + 1))
+        p.get(key)
+        p.ping()
+    p.mget(keys)
+    p.delete(*keys)
+    p.exists(*keys)
+    results = p.execute()
+    for i in range(len(keys)):
+        assert results[5*i:5*i + 5] == [True, str(i), True, str(i + 1), True]
+    assert results[-3:] == [[str(i + 1) for i in range(len(keys))], len(keys), 0]
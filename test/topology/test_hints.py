@@ -0,0 +1,71 @@
+#
+# Copyright (C) 2026-present ScyllaDB
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+import asyncio
+import pytest
+from cassandra.query import SimpleStatement                              # type: ignore
+from cassandra.cluster import ConsistencyLevel                           # type: ignore
+from pylib.util import unique_name                                       # type: ignore
+from util import enable_injection, disable_injection, get_metric
+
+
+async def wait_for_metric(hosts, name, value, timeout=60):
+    for _ in range(timeout * 10):
+        total = sum(get_metric(host, name) for host in hosts)
+        if total >= value:
+            return total
+        await asyncio.sleep(0.1)
+    pytest.fail(f"{name} didn't reach {value}, it is {total}")
+
+
+# Hints of a partition which is written to repeatedly while a replica
+# doesn't answer are merged when they are replayed, and the replica ends
+# up with the last write. One node drops the writes it receives, so that
+# coordinators time out and hint them, and replay is paused until all of
+# them are hinted, so that they are replayed from the same files.
+@pytest.mark.asyncio
+async def test_hints_of_a_partition_are_merged(cql):
+    hosts = [h.address for h in cql.cluster.metadata.all_hosts()]
+    dropping = hosts[0]
+    writes = 20
+    ks = unique_name()
+    await cql.run_async(f"CREATE KEYSPACE {ks} WITH REPLICATION = {{ 'class' : 'SimpleStrategy', 'replication_factor' : 3 }}")
+    try:
+        await cql.run_async(f"CREATE TABLE {ks}.t (pk int PRIMARY KEY, v int)")
+        try:
+            for host in hosts:
+                enable_injection(host, 'hinted_handoff_pause_hint_replay')
+            enable_injection(dropping, 'storage_proxy_drop_mutation')
+            written = sum(get_metric(host, 'scylla_hints_manager_written') for host in hosts)
+            merged = sum(get_metric(host, 'scylla_hints_manager_merged') for host in hosts)
+            sent = sum(get_metric(host, 'scylla_hints_manager_sent') for host in hosts)
+
+            write = SimpleStatement(f"UPDATE {ks}.t SET v = %s WHERE pk = 0", consistency_level=ConsistencyLevel.ONE)
+            for v in range(writes):
+                await cql.run_async(write, [v])
+            # Writes coordinated by the dropping node itself are applied
+            # there, and not hinted.
+            await wait_for_metric(hosts, 'scylla_hints_manager_written', written + 1)
+            await asyncio.sleep(3)
+            hinted = sum(get_metric(host, 'scylla_hints_manager_written') for host in hosts) - written
+
+            disable_injection(dropping, 'storage_proxy_drop_mutation')
+            for host in hosts:
+                disable_injection(host, 'hinted_handoff_pause_hint_replay')
+            # Hints are stored by the coordinator shards of the two other
+            # nodes, 4 of them with --smp 2. With more hints than that, one
+            # of them has several hints of the partition to merge.
+            if hinted > 4:
+                await wait_for_metric(hosts, 'scylla_hints_manager_merged', merged + 1)
+            await wait_for_metric(hosts, 'scylla_hints_manager_sent', sent + hinted)
+        finally:
+            for host in hosts:
+                disable_injection(host, 'hinted_handoff_pause_hint_replay')
+            disable_injection(dropping, 'storage_proxy_drop_mutation')
+
+        read = SimpleStatement(f"SELECT v FROM {ks}.t WHERE pk = 0", consistency_level=ConsistencyLevel.ALL)
+        assert list(await cql.run_async(read)) == [(writes - 1,)]
+    finally:
+        await cql.run_async(f"DROP KEYSPACE {ks}")
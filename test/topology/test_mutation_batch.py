@@ -0,0 +1,58 @@
+#
+# Copyright (C) 2026-present ScyllaDB
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+import pytest
+from cassandra.query import BatchStatement, BatchType, SimpleStatement  # type: ignore
+from cassandra.cluster import ConsistencyLevel                           # type: ignore
+from pylib.util import unique_name                                       # type: ignore
+from util import get_metric
+
+
+async def set_write_batching(cql, enabled):
+    for host in cql.cluster.metadata.all_hosts():
+        await cql.run_async(f"UPDATE system.config SET value = '{str(enabled).lower()}' WHERE name = 'coordinator_write_batching'",
+                            host=host)
+
+
+# The partitions of an unlogged batch are sent to each replica in a single
+# MUTATION_BATCH message when coordinator_write_batching is enabled, and in
+# MUTATION messages of their own otherwise. Either way every write must be
+# acknowledged by every replica, which CL=ALL requires.
+@pytest.mark.asyncio
+@pytest.mark.parametrize("enabled", [True, False])
+async def test_unlogged_batch_is_sent_as_mutation_batch(cql, enabled):
+    hosts = [h.address for h in cql.cluster.metadata.all_hosts()]
+    partitions = 20
+    ks = unique_name()
+    await cql.run_async(f"CREATE KEYSPACE {ks} WITH REPLICATION = {{ 'class' : 'SimpleStrategy', 'replication_factor' : 3 }}")
+    try:
+        await cql.run_async(f"CREATE TABLE {ks}.t (pk int PRIMARY KEY, v int)")
+        await set_write_batching(cql, enabled)
+        try:
+            sent = sum(get_metric(host, 'scylla_storage_proxy_coordinator_mutation_batches') for host in hosts)
+            received = sum(get_metric(host, 'scylla_storage_proxy_replica_mutation_batches') for host in hosts)
+
+            insert = cql.prepare(f"INSERT INTO {ks}.t (pk, v) VALUES (?, ?)")
+            batch = BatchStatement(batch_type=BatchType.UNLOGGED, consistency_level=ConsistencyLevel.ALL)
+            for pk in range(partitions):
+                batch.add(insert, [pk, pk])
+            await cql.run_async(batch)
+
+            sent = sum(get_metric(host, 'scylla_storage_proxy_coordinator_mutation_batches') for host in hosts) - sent
+            received = sum(get_metric(host, 'scylla_storage_proxy_replica_mutation_batches') for host in hosts) - received
+            if enabled:
+                # One message to each of the two other replicas.
+                assert sent > 0
+                assert received > 0
+            else:
+                assert sent == 0
+                assert received == 0
+        finally:
+            await set_write_batching(cql, False)
+
+        read = SimpleStatement(f"SELECT pk, v FROM {ks}.t", consistency_level=ConsistencyLevel.ALL)
+        assert sorted(await cql.run_async(read)) == [(pk, pk) for pk in range(partitions)]
+    finally:
+        await cql.run_async(f"DROP KEYSPACE {ks}")
@@ -0,0 +1,35 @@
+#
+# Copyright (C) 2026-present ScyllaDB
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+import pytest
+from pylib.util import unique_name                                       # type: ignore
+from util import get_metric
+
+
+# A statement is prepared by the shard which gets the PREPARE request, and
+# by the other shards of the node when they first execute it. The driver
+# routes each execution to the shard owning the partition, so executing
+# the statement for many partitions makes the other shards prepare it.
+@pytest.mark.asyncio
+async def test_statement_prepared_on_first_execution(cql):
+    hosts = [h.address for h in cql.cluster.metadata.all_hosts()]
+    metric = 'scylla_query_processor_statements_prepared_on_first_execution'
+    partitions = 100
+    ks = unique_name()
+    await cql.run_async(f"CREATE KEYSPACE {ks} WITH REPLICATION = {{ 'class' : 'SimpleStrategy', 'replication_factor' : 3 }}")
+    try:
+        await cql.run_async(f"CREATE TABLE {ks}.t (pk int PRIMARY KEY, v int)")
+        before = sum(get_metric(host, metric) for host in hosts)
+
+        insert = cql.prepare(f"INSERT INTO {ks}.t (pk, v) VALUES (?, ?)")
+        for pk in range(partitions):
+            await cql.run_async(insert, [pk, pk])
+        select = cql.prepare(f"SELECT v FROM {ks}.t WHERE pk = ?")
+        for pk in range(partitions):
+            assert list(await cql.run_async(select, [pk])) == [(pk,)]
+
+        assert sum(get_metric(host, metric) for host in hosts) > before
+    finally:
+        await cql.run_async(f"DROP KEYSPACE {ks}")
@@ -0,0 +1,52 @@
+#
+# Copyright (C) 2026-present ScyllaDB
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+import pytest
+from pylib.util import unique_name                                       # type: ignore
+from util import get_metric
+
+
+async def set_read_batching(cql, enabled):
+    for host in cql.cluster.metadata.all_hosts():
+        await cql.run_async(f"UPDATE system.config SET value = '{str(enabled).lower()}' WHERE name = 'coordinator_read_batching'",
+                            host=host)
+
+
+# The partitions of an IN query are read concurrently. With
+# coordinator_read_batching enabled, the data reads which go to the same
+# replica are sent in a single READ_DATA_BATCH message. With RF=1, most
+# partitions are owned by other nodes than the coordinator.
+@pytest.mark.asyncio
+@pytest.mark.parametrize("enabled", [True, False])
+async def test_in_query_reads_are_sent_as_batch(cql, enabled):
+    hosts = [h.address for h in cql.cluster.metadata.all_hosts()]
+    partitions = 20
+    ks = unique_name()
+    await cql.run_async(f"CREATE KEYSPACE {ks} WITH REPLICATION = {{ 'class' : 'SimpleStrategy', 'replication_factor' : 1 }}")
+    try:
+        await cql.run_async(f"CREATE TABLE {ks}.t (pk int PRIMARY KEY, v int)")
+        for pk in range(partitions):
+            await cql.run_async(f"INSERT INTO {ks}.t (pk, v) VALUES ({pk}, {pk})")
+        await set_read_batching(cql, enabled)
+        try:
+            sent = sum(get_metric(host, 'scylla_storage_proxy_coordinator_data_read_batches') for host in hosts)
+            received = sum(get_metric(host, 'scylla_storage_proxy_replica_read_batches') for host in hosts)
+
+            keys = ', '.join(str(pk) for pk in range(partitions))
+            rows = await cql.run_async(f"SELECT pk, v FROM {ks}.t WHERE pk IN ({keys})")
+            assert sorted(rows) == [(pk, pk) for pk in range(partitions)]
+
+            sent = sum(get_metric(host, 'scylla_storage_proxy_coordinator_data_read_batches') for host in hosts) - sent
+            received = sum(get_metric(host, 'scylla_storage_proxy_replica_read_batches') for host in hosts) - received
+            if enabled:
+                assert sent > 0
+                assert received > 0
+            else:
+                assert sent == 0
+                assert received == 0
+        finally:
+            await set_read_batching(cql, False)
+    finally:
+        await cql.run_async(f"DROP KEYSPACE {ks}")
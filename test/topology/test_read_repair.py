@@ -0,0 +1,51 @@
+#
+# Copyright (C) 2026-present ScyllaDB
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+import asyncio
+import pytest
+from cassandra.query import SimpleStatement                              # type: ignore
+from cassandra.cluster import ConsistencyLevel                           # type: ignore
+from pylib.util import unique_name                                       # type: ignore
+from util import enable_injection, disable_injection, get_metric
+
+
+# Concurrent reads of a partition which all find the same digest mismatch
+# start a single background read repair per coordinator shard; the others
+# are counted as coalesced. Replicas answer digest reads with a corrupted
+# digest, so that every read finds a mismatch, and background repairs are
+# delayed, so that the concurrent reads find the repair still in progress.
+@pytest.mark.asyncio
+async def test_coalesced_background_read_repairs(cql):
+    hosts = [h.address for h in cql.cluster.metadata.all_hosts()]
+    metric = 'scylla_storage_proxy_coordinator_coalesced_background_read_repairs'
+    injections = ['storage_proxy_corrupt_read_digest', 'storage_proxy_delay_background_read_repair']
+    ks = unique_name()
+    await cql.run_async(f"CREATE KEYSPACE {ks} WITH REPLICATION = {{ 'class' : 'SimpleStrategy', 'replication_factor' : 3 }}")
+    try:
+        await cql.run_async(f"CREATE TABLE {ks}.t (pk int PRIMARY KEY, v int) WITH read_repair_chance = 1")
+        await cql.run_async(f"INSERT INTO {ks}.t (pk, v) VALUES (1, 1)")
+        try:
+            for host in hosts:
+                for name in injections:
+                    enable_injection(host, name)
+            before = sum(get_metric(host, metric) for host in hosts)
+            read = SimpleStatement(f"SELECT * FROM {ks}.t WHERE pk = 1", consistency_level=ConsistencyLevel.ONE)
+            # More reads than there are coordinator shards, so that some
+            # of them must find a repair in progress.
+            results = await asyncio.gather(*[cql.run_async(read) for _ in range(20)])
+            assert all(list(r) == [(1, 1)] for r in results)
+            # The digests are compared after the reads return, at CL=ONE.
+            for _ in range(100):
+                after = sum(get_metric(host, metric) for host in hosts)
+                if after > before:
+                    break
+                await asyncio.sleep(0.1)
+            assert after > before
+        finally:
+            for host in hosts:
+                for name in injections:
+                    disable_injection(host, name)
+    finally:
+        await cql.run_async(f"DROP KEYSPACE {ks}")
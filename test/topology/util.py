@@ -0,0 +1,31 @@
+#
+# Copyright (C) 2026-present ScyllaDB
+#
+# SPDX-License-Identifier: AGPL-3.0-or-later
+#
+# Helpers for tests which need to look at or act on a specific node of the
+# cluster, through its REST API and metrics.
+import pytest
+import requests
+
+
+def enable_injection(host, name):
+    """Enables the named error injection on all shards of the node, and
+       skips the test if error injections aren't compiled in."""
+    requests.post(f'http://{host}:10000/v2/error_injection/injection/{name}?one_shot=False')
+    enabled = requests.get(f'http://{host}:10000/v2/error_injection/injection').json()
+    if name not in enabled:
+        pytest.skip("Error injection not enabled in Scylla - try compiling in dev/debug/sanitize mode")
+
+
+def disable_injection(host, name):
+    requests.delete(f'http://{host}:10000/v2/error_injection/injection/{name}')
+
+
+def get_metric(host, name):
+    """Returns the sum of the named metric over all its label values."""
+    total = 0
+    for line in requests.get(f'http://{host}:9180/metrics').text.splitlines():
+        if line.startswith(name + '{') or line.startswith(name + ' '):
+            total += float(line.split()[-1])
+    return total
@@ -8,14 +8,21 @@
 
 #include <boost/algorithm/string.hpp>
 #include <boost/algorithm/string/join.hpp>
+#include <boost/range/irange.hpp>
 #include <filesystem>
 #include <source_location>
 #include <fmt/chrono.h>
 #include <seastar/core/app-template.hh>
+#include <seastar/core/bitops.hh>
 #include <seastar/core/coroutine.hh>
+#include <seastar/core/smp.hh>
 #include <seastar/util/closeable.hh>
+#include <seastar/util/noncopyable_function.hh>
 
 #include "compaction/compaction.hh"
+#include "compaction/compaction_strategy.hh"
+#include "compaction/table_state.hh"
+#include "compress.hh"
 #include "db/config.hh"
 #include "db/large_data_handler.hh"
 #include "gms/feature_service.hh"
@@ -45,8 +52,6 @@ const auto app_name = "scylla-sstable";
 
 logging::logger sst_log(app_name);
 
-db::nop_large_data_handler large_data_handler;
-
 struct decorated_key_hash {
     std::size_t operator()(const dht::decorated_key& dk) const {
         return dht::token::to_int64(dk.token());
@@ -154,6 +159,216 @@ const std::vector<sstables::shared_sstable> load_sstables(schema_ptr schema, sst
     return sstables;
 }
 
+schema_ptr load_schema(const bpo::variables_map& app_config) {
+    if (auto it = app_config.find("system-schema"); it != app_config.end()) {
+        std::vector<sstring> comps;
+        boost::split(comps, it->second.as<sstring>(), boost::is_any_of("."));
+        return tools::load_system_schema(comps.at(0), comps.at(1));
+    }
+    return tools::load_one_schema_from_file(std::filesystem::path(app_config["schema-file"].as<sstring>())).get();
+}
+
+using sstables_env_func = noncopyable_function<void(schema_ptr, reader_permit, const std::vector<sstables::shared_sstable>&, sstables::sstables_manager&)>;
+
+// Sets up what is needed to read sstables on the current shard, loads the
+// sstables and calls func with them.
+void with_sstables_env(schema_ptr schema, const std::vector<sstring>& sstable_names, sstables_env_func func) {
+    db::nop_large_data_handler large_data_handler;
+    db::config dbcfg;
+    gms::feature_service feature_service(gms::feature_config_from_db_config(dbcfg));
+    cache_tracker tracker;
+    dbcfg.host_id = ::utils::make_random_uuid();
+    sstables::sstables_manager sst_man(large_data_handler, dbcfg, feature_service, tracker);
+    auto close_sst_man = deferred_close(sst_man);
+
+    std::vector<sstables::shared_sstable> sstables;
+    if (!sstable_names.empty()) {
+        sstables = load_sstables(schema, sst_man, sstable_names);
+    }
+
+    reader_concurrency_semaphore rcs_sem(reader_concurrency_semaphore::no_limits{}, app_name);
+    auto stop_semaphore = deferred_stop(rcs_sem);
+
+    const auto permit = rcs_sem.make_tracking_only_permit(schema.get(), app_name, db::no_timeout);
+
+    func(schema, permit, sstables, sst_man);
+}
+
+using shard_sstables_func = std::function<void(schema_ptr, reader_permit, const std::vector<sstables::shared_sstable>&, sstables::sstables_manager&)>;
+using all_sstables_on_each_shard = bool_class<class all_sstables_on_each_shard_tag>;
+
+// Spreads the sstables round-robin across all shards, or gives all of them to
+// every shard, and calls func on each shard with the ones assigned to it,
+// concurrently. The other shards load their own schema and sstables. With a
+// single shard, the default (see --smp), this is just a call to func with all
+// sstables.
+// func is shared between the shards, so it has to be safe to call
+// concurrently from all of them.
+void for_each_shard(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables, sstables::sstables_manager& sst_man,
+        const bpo::variables_map& vm, const shard_sstables_func& func, all_sstables_on_each_shard all_on_each = all_sstables_on_each_shard::no) {
+    std::vector<sstables::shared_sstable> local_sstables;
+    std::vector<std::vector<sstring>> sstable_names(smp::count);
+    for (size_t i = 0; i < sstables.size(); ++i) {
+        for (unsigned shard = 0; shard < smp::count; ++shard) {
+            if (!all_on_each && shard != i % smp::count) {
+                continue;
+            }
+            if (shard == this_shard_id()) {
+                local_sstables.push_back(sstables[i]);
+            } else {
+                sstable_names[shard].push_back(sstables[i]->get_filename());
+            }
+        }
+    }
+
+    auto other_shards = parallel_for_each(boost::irange(0u, smp::count), [&] (unsigned shard) {
+        if (shard == this_shard_id() || sstable_names[shard].empty()) {
+            return make_ready_future<>();
+        }
+        return smp::submit_to(shard, [&vm, &func, &names = sstable_names[shard]] {
+            return async([&] {
+                with_sstables_env(load_schema(vm), names, [&func] (schema_ptr schema, reader_permit permit,
+                        const std::vector<sstables::shared_sstable>& sstables, sstables::sstables_manager& sst_man) {
+                    func(std::move(schema), std::move(permit), sstables, sst_man);
+                });
+            });
+        });
+    });
+
+    std::exception_ptr ex;
+    try {
+        func(std::move(schema), std::move(permit), local_sstables, sst_man);
+    } catch (...) {
+        ex = std::current_exception();
+    }
+    other_shards.get();
+    if (ex) {
+        std::rethrow_exception(std::move(ex));
+    }
+}
+
+// The table of the sstables compacted by the tool. Tombstones are never
+// purged, as the tool doesn't see the other sstables of the table, which may
+// hold data shadowed by them.
+class offline_table_state final : public compaction::table_state {
+    schema_ptr _schema;
+    reader_permit _permit;
+    sstables::sstables_manager& _sst_man;
+    mutable sstables::compaction_strategy _strategy;
+    sstables::sstable_set _main_set;
+    sstables::sstable_set _maintenance_set;
+    std::vector<sstables::shared_sstable> _compacted_undeleted;
+    sstring _output_dir;
+    // Generations of the sstables written by this shard, the shards'
+    // generations are interleaved so they don't collide.
+    mutable int64_t _next_generation;
+
+public:
+    offline_table_state(schema_ptr schema, reader_permit permit, sstables::sstables_manager& sst_man, sstring output_dir, int64_t first_generation)
+        : _schema(std::move(schema))
+        , _permit(std::move(permit))
+        , _sst_man(sst_man)
+        , _strategy(sstables::make_compaction_strategy(_schema->compaction_strategy(), _schema->compaction_strategy_options()))
+        , _main_set(_strategy.make_sstable_set(_schema))
+        , _maintenance_set(sstables::make_partitioned_sstable_set(_schema, false))
+        , _output_dir(std::move(output_dir))
+        , _next_generation(first_generation + this_shard_id())
+    { }
+    virtual const schema_ptr& schema() const noexcept override {
+        return _schema;
+    }
+    virtual unsigned min_compaction_threshold() const noexcept override {
+        return _schema->min_compaction_threshold();
+    }
+    virtual bool compaction_enforce_min_threshold() const noexcept override {
+        return true;
+    }
+    virtual const sstables::sstable_set& main_sstable_set() const override {
+        return _main_set;
+    }
+    virtual const sstables::sstable_set& maintenance_sstable_set() const override {
+        return _maintenance_set;
+    }
+    virtual std::unordered_set<sstables::shared_sstable> fully_expired_sstables(const std::vector<sstables::shared_sstable>&, gc_clock::time_point) const override {
+        return {};
+    }
+    virtual const std::vector<sstables::shared_sstable>& compacted_undeleted_sstables() const noexcept override {
+        return _compacted_undeleted;
+    }
+    virtual sstables::compaction_strategy& get_compaction_strategy() const noexcept override {
+        return _strategy;
+    }
+    virtual reader_permit make_compaction_reader_permit() const override {
+        return _permit;
+    }
+    virtual sstables::sstables_manager& get_sstables_manager() noexcept override {
+        return _sst_man;
+    }
+    virtual sstables::shared_sstable make_sstable() const override {
+        auto generation = sstables::generation_type(std::exchange(_next_generation, _next_generation + smp::count));
+        return _sst_man.make_sstable(_schema, _output_dir, generation, sstables::get_highest_sstable_version(), sstables::sstable_format_types::big);
+    }
+    virtual sstables::shared_sstable make_cold_sstable() const override {
+        throw std::logic_error("scylla-sstable doesn't write sstables to cold storage");
+    }
+    virtual sstables::sstable_writer_config configure_writer(sstring origin) const override {
+        return _sst_man.configure_writer(std::move(origin));
+    }
+    virtual api::timestamp_type min_memtable_timestamp() const override {
+        return api::max_timestamp;
+    }
+    virtual future<> update_compaction_history(utils::UUID, sstring, sstring, std::chrono::milliseconds, int64_t, int64_t) override {
+        return make_ready_future<>();
+    }
+    virtual future<> on_compaction_completion(sstables::compaction_completion_desc, sstables::offstrategy) override {
+        return make_ready_future<>();
+    }
+    virtual bool is_auto_compaction_disabled_by_user() const noexcept override {
+        return false;
+    }
+};
+
+// Compacts the sstables, or the part of them in range, into new sstables in
+// the table's output directory, at the given level and split at the given size.
+// The input sstables are left untouched.
+std::vector<sstables::shared_sstable> compact_offline(offline_table_state& table_s, std::vector<sstables::shared_sstable> sstables,
+        std::optional<dht::partition_range> range, int level, uint64_t max_sstable_bytes) {
+    sstables::compaction_descriptor descriptor(std::move(sstables), default_priority_class(), level, max_sstable_bytes);
+    descriptor.creator = [&table_s] (shard_id) {
+        return table_s.make_sstable();
+    };
+    descriptor.replacer = [] (sstables::compaction_completion_desc) { };
+    descriptor.partition_range = std::move(range);
+    sstables::compaction_data cdata;
+    return sstables::compact_sstables(std::move(descriptor), cdata, table_s).get().new_sstables;
+}
+
+// The schema to write the output sstables with: the table's schema, with its
+// compression replaced by the one given with --compression, if any.
+schema_ptr get_output_schema(schema_ptr schema, const bpo::variables_map& vm) {
+    if (!vm.count("compression")) {
+        return schema;
+    }
+    std::map<sstring, sstring> options;
+    for (const auto& opt : vm["compression"].as<std::vector<sstring>>()) {
+        const auto pos = opt.find('=');
+        if (pos == sstring::npos) {
+            throw std::invalid_argument(fmt::format("error: invalid compression option {}, expected key=value", opt));
+        }
+        options.emplace(opt.substr(0, pos), opt.substr(pos + 1));
+    }
+    compression_parameters cp(options);
+    cp.validate();
+    return schema_builder(schema).set_compressor_params(cp).build();
+}
+
+int64_t get_first_output_generation(const bpo::variables_map& vm) {
+    if (!vm.count("generation")) {
+        throw std::invalid_argument("error: missing required option '--generation'");
+    }
+    return vm["generation"].as<int64_t>();
+}
+
 // stop_iteration::no -> continue consuming sstable content
 class sstable_consumer {
 public:
@@ -766,6 +981,137 @@ class writetime_histogram_collecting_consumer : public sstable_consumer {
     }
 };
 
+// Statistics of the content of sstables. Columns are identified by name,
+// so statistics collected with the schema loaded on another shard can be
+// merged.
+struct aggregate_stats {
+    // Histograms with power of two buckets, keyed by the lower bound of the bucket.
+    using histogram = std::map<uint64_t, uint64_t>;
+
+    uint64_t sstables = 0;
+    uint64_t partitions = 0;
+    uint64_t rows = 0;
+    uint64_t live_cells = 0;
+    uint64_t dead_cells = 0;
+    uint64_t expiring_cells = 0;
+    uint64_t partition_tombstones = 0;
+    uint64_t row_tombstones = 0;
+    uint64_t range_tombstone_changes = 0;
+    histogram partition_sizes;
+    histogram ttls;
+    std::map<std::string, uint64_t> column_sizes;
+
+    static void add_to_histogram(histogram& h, uint64_t value) {
+        ++h[value ? uint64_t(1) << log2floor(value) : 0];
+    }
+
+    void merge(const aggregate_stats& o) {
+        sstables += o.sstables;
+        partitions += o.partitions;
+        rows += o.rows;
+        live_cells += o.live_cells;
+        dead_cells += o.dead_cells;
+        expiring_cells += o.expiring_cells;
+        partition_tombstones += o.partition_tombstones;
+        row_tombstones += o.row_tombstones;
+        range_tombstone_changes += o.range_tombstone_changes;
+        for (const auto& [k, v] : o.partition_sizes) {
+            partition_sizes[k] += v;
+        }
+        for (const auto& [k, v] : o.ttls) {
+            ttls[k] += v;
+        }
+        for (const auto& [k, v] : o.column_sizes) {
+            column_sizes[k] += v;
+        }
+    }
+};
+
+class aggregate_stats_collecting_consumer : public sstable_consumer {
+    schema_ptr _schema;
+    aggregate_stats& _stats;
+    // The logical size of the current partition: the size of its keys and
+    // cell values, excluding the overhead of the sstable format.
+    uint64_t _partition_size = 0;
+
+private:
+    void collect_cell(atomic_cell_view cell, const column_definition& cdef) {
+        if (!cell.is_live()) {
+            ++_stats.dead_cells;
+            return;
+        }
+        ++_stats.live_cells;
+        if (cell.is_live_and_has_ttl()) {
+            ++_stats.expiring_cells;
+            aggregate_stats::add_to_histogram(_stats.ttls, cell.ttl().count());
+        }
+        const auto size = cell.value_size();
+        _partition_size += size;
+        _stats.column_sizes[cdef.name_as_text()] += size;
+    }
+    void collect_row(const row& r, column_kind kind) {
+        ++_stats.rows;
+        r.for_each_cell([this, kind] (column_id id, const atomic_cell_or_collection& cell) {
+            const auto& cdef = _schema->column_at(kind, id);
+            if (cdef.is_atomic()) {
+                collect_cell(cell.as_atomic_cell(cdef), cdef);
+            } else {
+                cell.as_collection_mutation().with_deserialized(*cdef.type, [&, this] (collection_mutation_view_description mv) {
+                    for (auto&& c : mv.cells) {
+                        _partition_size += c.first.size();
+                        collect_cell(c.second, cdef);
+                    }
+                });
+            }
+        });
+    }
+
+public:
+    aggregate_stats_collecting_consumer(schema_ptr s, aggregate_stats& stats) : _schema(std::move(s)), _stats(stats) {
+    }
+    virtual future<> on_start_of_stream() override {
+        return make_ready_future<>();
+    }
+    virtual future<stop_iteration> on_new_sstable(const sstables::sstable* const sst) override {
+        ++_stats.sstables;
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(partition_start&& ps) override {
+        ++_stats.partitions;
+        if (ps.partition_tombstone()) {
+            ++_stats.partition_tombstones;
+        }
+        _partition_size = ps.key().key().representation().size();
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(static_row&& sr) override {
+        collect_row(sr.cells(), column_kind::static_column);
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(clustering_row&& cr) override {
+        if (cr.tomb() != row_tombstone{}) {
+            ++_stats.row_tombstones;
+        }
+        _partition_size += cr.key().representation().size();
+        collect_row(cr.cells(), column_kind::regular_column);
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(range_tombstone_change&& rtc) override {
+        ++_stats.range_tombstone_changes;
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> consume(partition_end&& pe) override {
+        aggregate_stats::add_to_histogram(_stats.partition_sizes, _partition_size);
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<stop_iteration> on_end_of_sstable() override {
+        return make_ready_future<stop_iteration>(stop_iteration::no);
+    }
+    virtual future<> on_end_of_stream() override {
+        return make_ready_future<>();
+    }
+};
+
 // scribble here, then call with --operation=custom
 class custom_consumer : public sstable_consumer {
     schema_ptr _schema;
@@ -908,15 +1254,22 @@ void validate_operation(schema_ptr schema, reader_permit permit, const std::vect
         throw std::runtime_error("error: no sstables specified on the command line");
     }
     const auto merge = vm.count("merge");
-    sstables::compaction_data info;
-    consume_sstables(schema, permit, sstables, merge, true, [&info] (flat_mutation_reader_v2& rd, sstables::sstable* sst) {
-        if (sst) {
-            sst_log.info("validating {}", sst->get_filename());
-        }
-        const auto errors = sstables::scrub_validate_mode_validate_reader(std::move(rd), info).get();
-        sst_log.info("validated {}: {}", sst ? sst->get_filename() : "the stream", errors == 0 ? "valid" : "invalid");
-        return stop_iteration::no;
-    });
+    auto validate = [merge] (schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables, sstables::sstables_manager&) {
+        sstables::compaction_data info;
+        consume_sstables(schema, permit, sstables, merge, true, [&info] (flat_mutation_reader_v2& rd, sstables::sstable* sst) {
+            if (sst) {
+                sst_log.info("validating {}", sst->get_filename());
+            }
+            const auto errors = sstables::scrub_validate_mode_validate_reader(std::move(rd), info).get();
+            sst_log.info("validated {}: {}", sst ? sst->get_filename() : "the stream", errors == 0 ? "valid" : "invalid");
+            return stop_iteration::no;
+        });
+    };
+    if (merge) {
+        validate(std::move(schema), std::move(permit), sstables, sst_man);
+    } else {
+        for_each_shard(std::move(schema), std::move(permit), sstables, sst_man, vm, validate);
+    }
 }
 
 void dump_index_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
@@ -1458,15 +1811,134 @@ void dump_scylla_metadata_operation(schema_ptr schema, reader_permit permit, con
 }
 
 void validate_checksums_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
-        sstables::sstables_manager& sst_man, const bpo::variables_map&) {
+        sstables::sstables_manager& sst_man, const bpo::variables_map& vm) {
     if (sstables.empty()) {
         throw std::runtime_error("error: no sstables specified on the command line");
     }
 
-    for (auto& sst : sstables) {
-        const auto valid = sstables::validate_checksums(sst, permit, default_priority_class()).get();
-        sst_log.info("validated the checksums of {}: {}", sst->get_filename(), valid ? "valid" : "invalid");
+    for_each_shard(std::move(schema), std::move(permit), sstables, sst_man, vm, [] (schema_ptr, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+            sstables::sstables_manager&) {
+        for (auto& sst : sstables) {
+            const auto valid = sstables::validate_checksums(sst, permit, default_priority_class()).get();
+            sst_log.info("validated the checksums of {}: {}", sst->get_filename(), valid ? "valid" : "invalid");
+        }
+    });
+}
+
+void aggregate_stats_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+        sstables::sstables_manager& sst_man, const bpo::variables_map& vm) {
+    if (sstables.empty()) {
+        throw std::runtime_error("error: no sstables specified on the command line");
+    }
+
+    // Each shard writes only its own element.
+    std::vector<aggregate_stats> shard_stats(smp::count);
+    for_each_shard(std::move(schema), std::move(permit), sstables, sst_man, vm, [&shard_stats] (schema_ptr schema, reader_permit permit,
+            const std::vector<sstables::shared_sstable>& sstables, sstables::sstables_manager&) {
+        aggregate_stats stats;
+        aggregate_stats_collecting_consumer consumer(schema, stats);
+        const partition_set no_partitions(0, {}, decorated_key_equal(*schema));
+        consume_sstables(schema, permit, sstables, false, true, [&] (flat_mutation_reader_v2& rd, sstables::sstable* sst) {
+            sst_log.debug("collecting statistics of {}", sst->get_filename());
+            return consume_reader(std::move(rd), consumer, sst, no_partitions, false);
+        });
+        shard_stats[this_shard_id()] = std::move(stats);
+    });
+
+    aggregate_stats stats;
+    for (const auto& s : shard_stats) {
+        stats.merge(s);
+    }
+
+    auto write_histogram = [] (json_writer& writer, std::string_view name, const aggregate_stats::histogram& h) {
+        writer.Key(name);
+        writer.StartObject();
+        for (const auto& [bucket, count] : h) {
+            writer.Key(fmt::to_string(bucket));
+            writer.Uint64(count);
+        }
+        writer.EndObject();
+    };
+
+    const auto tombstones = stats.partition_tombstones + stats.row_tombstones + stats.range_tombstone_changes + stats.dead_cells;
+    const auto objects = stats.partitions + stats.rows + stats.range_tombstone_changes + stats.live_cells + stats.dead_cells;
+
+    json_writer writer;
+    writer.StartObject();
+    writer.Key("sstables");
+    writer.Uint64(stats.sstables);
+    writer.Key("partitions");
+    writer.Uint64(stats.partitions);
+    writer.Key("rows");
+    writer.Uint64(stats.rows);
+    writer.Key("live_cells");
+    writer.Uint64(stats.live_cells);
+    writer.Key("expiring_cells");
+    writer.Uint64(stats.expiring_cells);
+    writer.Key("dead_cells");
+    writer.Uint64(stats.dead_cells);
+    writer.Key("partition_tombstones");
+    writer.Uint64(stats.partition_tombstones);
+    writer.Key("row_tombstones");
+    writer.Uint64(stats.row_tombstones);
+    writer.Key("range_tombstone_changes");
+    writer.Uint64(stats.range_tombstone_changes);
+    writer.Key("tombstone_ratio");
+    writer.Double(objects ? double(tombstones) / objects : 0.0);
+    write_histogram(writer, "partition_size_histogram", stats.partition_sizes);
+    write_histogram(writer, "ttl_histogram", stats.ttls);
+    writer.Key("column_sizes");
+    writer.StartObject();
+    for (const auto& [name, size] : stats.column_sizes) {
+        writer.Key(name);
+        writer.Uint64(size);
+    }
+    writer.EndObject();
+    writer.EndObject();
+}
+
+void compact_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+        sstables::sstables_manager& sst_man, const bpo::variables_map& vm) {
+    if (sstables.empty()) {
+        throw std::runtime_error("error: no sstables specified on the command line");
+    }
+    const auto output_dir = vm["output-dir"].as<std::string>();
+    const auto first_generation = get_first_output_generation(vm);
+    // Validate the options before starting any shard.
+    get_output_schema(schema, vm);
+
+    // Every shard compacts all sstables, restricted to its own part of the token ring.
+    for_each_shard(std::move(schema), std::move(permit), sstables, sst_man, vm, [&] (schema_ptr schema, reader_permit permit,
+            const std::vector<sstables::shared_sstable>& sstables, sstables::sstables_manager& sst_man) {
+        offline_table_state table_s(get_output_schema(schema, vm), permit, sst_man, output_dir, first_generation);
+        const auto range = sstables::split_token_ring(smp::count).at(this_shard_id());
+        // The strategy decides the level and size of the output, as for a major compaction.
+        const auto job = table_s.get_compaction_strategy().get_major_compaction_job(table_s, sstables);
+        for (const auto& sst : compact_offline(table_s, sstables, range, job.level, job.max_sstable_bytes)) {
+            sst_log.info("written {}", sst->get_filename());
+        }
+    }, all_sstables_on_each_shard::yes);
+}
+
+void recompress_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+        sstables::sstables_manager& sst_man, const bpo::variables_map& vm) {
+    if (sstables.empty()) {
+        throw std::runtime_error("error: no sstables specified on the command line");
     }
+    const auto output_dir = vm["output-dir"].as<std::string>();
+    const auto first_generation = get_first_output_generation(vm);
+    get_output_schema(schema, vm);
+
+    for_each_shard(std::move(schema), std::move(permit), sstables, sst_man, vm, [&] (schema_ptr schema, reader_permit permit,
+            const std::vector<sstables::shared_sstable>& sstables, sstables::sstables_manager& sst_man) {
+        offline_table_state table_s(get_output_schema(schema, vm), permit, sst_man, output_dir, first_generation);
+        for (const auto& sst : sstables) {
+            for (const auto& new_sst : compact_offline(table_s, {sst}, std::nullopt, sst->get_sstable_level(),
+                    sstables::compaction_descriptor::default_max_sstable_bytes)) {
+                sst_log.info("rewritten {} as {}", sst->get_filename(), new_sst->get_filename());
+            }
+        }
+    });
 }
 
 void decompress_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
@@ -1504,6 +1976,22 @@ void decompress_operation(schema_ptr schema, reader_permit permit, const std::ve
     }
 }
 
+void set_repaired_at_operation(schema_ptr schema, reader_permit permit, const std::vector<sstables::shared_sstable>& sstables,
+        sstables::sstables_manager& sst_man, const bpo::variables_map& vm) {
+    if (sstables.empty()) {
+        throw std::runtime_error("error: no sstables specified on the command line");
+    }
+    if (!vm.count("repaired-at")) {
+        throw std::invalid_argument("error: missing required option '--repaired-at'");
+    }
+    const auto repaired_at = vm["repaired-at"].as<uint64_t>();
+
+    for (const auto& sst : sstables) {
+        sst->mutate_repaired_at(repaired_at).get();
+        sst_log.info("Set repaired_at of {} to {}", sst->get_filename(), repaired_at);
+    }
+}
+
 class json_mutation_stream_parser {
     using reader = rapidjson::GenericReader<rjson::encoding, rjson::encoding, rjson::allocator>;
     class stream {
@@ -2493,8 +2981,10 @@ const std::vector<option> all_options {
     typed_option<std::string>("output-format", "json", "the output-format, one of (text, json)"),
     typed_option<std::string>("input-file", "the file containing the input"),
     typed_option<std::string>("output-dir", ".", "directory to place the output files to"),
-    typed_option<int64_t>("generation", "generation of generated sstable"),
+    typed_option<int64_t>("generation", "generation of the (first) generated sstable"),
+    typed_option<std::vector<sstring>>("compression", "compression option of the output sstables, as key=value, can be given multiple times"),
     typed_option<std::string>("validation-level", "clustering_key", "degree of validation on the output, one of (partition_region, token, partition_key, clustering_key)"),
+    typed_option<uint64_t>("repaired-at", "time of the repair, in milliseconds since the epoch; 0 marks the sstable(s) as unrepaired"),
 };
 
 const std::vector<operation> operations{
@@ -2969,6 +3459,88 @@ The content is dumped in JSON, using the following schema:
 
 )",
             validate_checksums_operation},
+    {"aggregate-stats",
+            "Collect statistics of the content of the sstable(s)",
+R"(
+Crawl over the content of all the sstables and produce statistics of it as a
+whole. Useful to characterize the data of a table, e.g. for capacity planning
+or for choosing a compaction strategy, from the sstables of its nodes.
+The statistics are:
+* the number of partitions, rows and cells (live, expiring and dead);
+* the number of tombstones of each kind, and the ratio of tombstones (including
+  dead cells) to all objects;
+* a histogram of the logical size of partitions, that is the size of their
+  keys and cell values, without the overhead of the sstable format;
+* a histogram of the TTL of expiring cells, in seconds;
+* the size of the values of each column, summed over all sstables.
+
+Histograms have power of two buckets, keyed by the lower bound of the bucket.
+Data of the same partition in different sstables is counted separately.
+
+The sstables are spread across shards (see `Parallel processing` in the general
+help).
+
+The statistics are dumped in JSON, using the following schema:
+
+$ROOT := {
+    "sstables": Uint64,
+    "partitions": Uint64,
+    "rows": Uint64,
+    "live_cells": Uint64,
+    "expiring_cells": Uint64,
+    "dead_cells": Uint64,
+    "partition_tombstones": Uint64,
+    "row_tombstones": Uint64,
+    "range_tombstone_changes": Uint64,
+    "tombstone_ratio": Double,
+    "partition_size_histogram": {"$bucket": Uint64, ...},
+    "ttl_histogram": {"$bucket": Uint64, ...},
+    "column_sizes": {"$column_name": Uint64, ...}
+}
+)",
+            aggregate_stats_operation},
+/* compact */
+    {"compact",
+            "Compact the sstable(s) into new sstable(s)",
+R"(
+Compact all the sstables together, with the compaction strategy of the table
+(as defined in the schema) deciding the layout of the output sstables, like
+the size and level of sstables for LeveledCompactionStrategy. The output is
+written to --output-dir, with generations starting at --generation. The input
+sstables are left untouched.
+
+Tombstones are not purged, as the tool cannot know about data they shadow in
+other sstables of the table, on this or other nodes.
+
+The output is written with the compression of the schema, unless replaced
+with --compression, see the recompress operation.
+
+Each shard compacts all the sstables, restricted to its own part of the token
+ring, so the output of each shard is separate (see `Parallel processing` in the
+general help).
+)",
+            {"output-dir", "generation", "compression"},
+            compact_operation},
+/* recompress */
+    {"recompress",
+            "Rewrite the sstable(s) with different compression",
+R"(
+Rewrite each sstable into a new sstable, with the compression given by the
+--compression options. The options are those of the `compression` property of
+a table, given as key=value, one option per --compression argument, e.g.:
+
+    --compression sstable_compression=ZstdCompressor --compression chunk_length_in_kb=16
+
+Without --compression, the compression of the schema is used. The output is
+written to --output-dir, with generations starting at --generation. The input
+sstables are left untouched. The content of the sstables is not changed,
+tombstones are not purged.
+
+The sstables are spread across shards (see `Parallel processing` in the general
+help).
+)",
+            {"output-dir", "generation", "compression"},
+            recompress_operation},
     {"decompress",
             "Decompress sstable(s)",
 R"(
@@ -2982,6 +3554,21 @@ the output will be:
     md-12311-big-Data.db.decompressed
 )",
             decompress_operation},
+/* set-repaired-at */
+    {"set-repaired-at",
+            "Mark sstable(s) as repaired or unrepaired",
+R"(
+Set the repaired_at field of the statistics component of each sstable to
+--repaired-at, rewriting the component in place. An sstable whose repaired_at
+is not 0 is repaired, and compacting it with other repaired sstables keeps it
+repaired, as of the oldest repair of the input. --repaired-at 0 marks the
+sstables as unrepaired.
+
+Only use this on sstables which are not in use by a running node, and only mark
+as repaired data which is known to be consistent across all replicas.
+)",
+            {"repaired-at"},
+            set_repaired_at_operation},
     {"write",
             "Write an sstable",
 R"(
@@ -3075,6 +3662,16 @@ path to the data component of the sstables (*-Data.db) even if you want
 to examine another component.
 NOTE: currently you have to prefix dir local paths with `./`.
 
+# Parallel processing
+
+By default, the tool runs on a single shard. When started with more
+shards (`--smp`), the validate (without `--merge`), validate-checksums,
+aggregate-stats and recompress operations spread the sstables across
+the shards, each processing its share concurrently with the others.
+The compact operation splits the token ring between the shards
+instead. Memory is divided between the shards, so mind the memory
+consumption of the sstables processed by each.
+
 # Schema
 
 To be able to interpret the sstables, their schema is required. There
@@ -3174,40 +3771,23 @@ Validate the specified sstables:
             const auto& operation = *found_op;
 
             schema_ptr schema;
-            std::string schema_source_opt;
+            const std::string schema_source_opt = app_config.count("system-schema") ? "system-schema" : "schema-file";
             try {
-                if (auto it = app_config.find("system-schema"); it != app_config.end()) {
-                    schema_source_opt = "system-schema";
-                    std::vector<sstring> comps;
-                    boost::split(comps, app_config["system-schema"].as<sstring>(), boost::is_any_of("."));
-                    schema = tools::load_system_schema(comps.at(0), comps.at(1));
-                } else {
-                    schema_source_opt = "schema-file";
-                    schema = tools::load_one_schema_from_file(std::filesystem::path(app_config["schema-file"].as<sstring>())).get();
-                }
+                schema = load_schema(app_config);
             } catch (...) {
                 fmt::print(std::cerr, "error: could not load {} '{}': {}\n", schema_source_opt, app_config[schema_source_opt].as<sstring>(), std::current_exception());
                 return 1;
             }
 
-            db::config dbcfg;
-            gms::feature_service feature_service(gms::feature_config_from_db_config(dbcfg));
-            cache_tracker tracker;
-            dbcfg.host_id = ::utils::make_random_uuid();
-            sstables::sstables_manager sst_man(large_data_handler, dbcfg, feature_service, tracker);
-            auto close_sst_man = deferred_close(sst_man);
-
-            std::vector<sstables::shared_sstable> sstables;
+            std::vector<sstring> sstable_names;
             if (app_config.count("sstables")) {
-                sstables = load_sstables(schema, sst_man, app_config["sstables"].as<std::vector<sstring>>());
+                sstable_names = app_config["sstables"].as<std::vector<sstring>>();
             }
 
-            reader_concurrency_semaphore rcs_sem(reader_concurrency_semaphore::no_limits{}, app_name);
-            auto stop_semaphore = deferred_stop(rcs_sem);
-
-            const auto permit = rcs_sem.make_tracking_only_permit(schema.get(), app_name, db::no_timeout);
-
-            operation(schema, permit, sstables, sst_man, app_config);
+            with_sstables_env(schema, sstable_names, [&] (schema_ptr schema, reader_permit permit,
+                    const std::vector<sstables::shared_sstable>& sstables, sstables::sstables_manager& sst_man) {
+                operation(std::move(schema), std::move(permit), sstables, sst_man, app_config);
+            });
 
             return 0;
         });
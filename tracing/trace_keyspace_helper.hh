@@ -153,6 +153,7 @@ class trace_keyspace_helper final : public i_tracing_backend_helper {
      */
     std::vector<cql3::raw_value> make_event_mutation_data(one_session_records& session_records, const event_record& record);
 
+public:
     /**
      * Converts a @param elapsed to an int32_t value of microseconds.
      *
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+#include <seastar/core/metrics.hh>
+#include "tracing/trace_ring_buffer_helper.hh"
+#include "tracing/trace_keyspace_helper.hh"
+#include "tracing/tracing_backend_registry.hh"
+
+namespace tracing {
+
+// Events of a session which isn't finished yet. They are moved to the ring
+// buffer together with the session record.
+struct trace_ring_buffer_session_state final : public backend_session_state_base {
+    std::vector<trace_ring_buffer_helper::event> events;
+    virtual ~trace_ring_buffer_session_state() {}
+};
+
+trace_ring_buffer_helper::trace_ring_buffer_helper(tracing& tr)
+        : i_tracing_backend_helper(tr)
+        , _sessions(max_sessions) {
+    namespace sm = seastar::metrics;
+
+    _metrics.add_group("tracing_ring_buffer_helper", {
+        sm::make_counter("recorded_sessions", [this] { return _stats.recorded_sessions; },
+                        sm::description("Counts the number of tracing sessions recorded in the ring buffer.")),
+
+        sm::make_counter("dropped_events", [this] { return _stats.dropped_events; },
+                        sm::description("Counts the number of tracing events dropped because their session had too many of them.")),
+    });
+}
+
+void trace_ring_buffer_helper::write_records_bulk(records_bulk& bulk) {
+    for (auto& records : bulk) {
+        write_one_session_records(*records);
+    }
+}
+
+void trace_ring_buffer_helper::write_one_session_records(one_session_records& records) {
+    auto num_records = records.size();
+    auto& state = static_cast<trace_ring_buffer_session_state&>(*records.backend_state_ptr);
+
+    for (auto& e : records.events_recs) {
+        if (state.events.size() >= max_events_per_session) {
+            ++_stats.dropped_events;
+            continue;
+        }
+        state.events.push_back(event{trace_keyspace_helper::elapsed_to_micros(e.elapsed), std::move(e.message)});
+    }
+    records.events_recs.clear();
+
+    // Check readiness before data_consumed() marks the session record as consumed.
+    bool session_record_is_ready = records.session_rec.ready();
+    records.data_consumed();
+
+    if (session_record_is_ready) {
+        const session_record& rec = records.session_rec;
+        _sessions.push_back(session{
+            .session_id = records.session_id,
+            .parent_id = records.parent_id,
+            .my_span_id = records.my_span_id,
+            .command = rec.command,
+            .client = rec.client,
+            .started_at = rec.started_at,
+            .duration_us = trace_keyspace_helper::elapsed_to_micros(rec.elapsed),
+            .request = rec.request,
+            .events = std::exchange(state.events, {}),
+        });
+        ++_stats.recorded_sessions;
+    }
+
+    _local_tracing.write_complete(num_records);
+}
+
+std::unique_ptr<backend_session_state_base> trace_ring_buffer_helper::allocate_session_state() const {
+    return std::make_unique<trace_ring_buffer_session_state>();
+}
+
+void register_tracing_ring_buffer_backend(backend_registry& tbr) {
+    tbr.register_backend<trace_ring_buffer_helper>("trace_ring_buffer_helper");
+}
+
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+#pragma once
+
+#include <boost/circular_buffer.hpp>
+#include <seastar/core/metrics_registration.hh>
+#include "tracing/tracing.hh"
+
+namespace tracing {
+
+/// \class trace_ring_buffer_helper
+/// \brief A tracing backend keeping the most recent sessions in memory.
+///
+/// Finished sessions are kept, with their events, in a per-shard ring buffer
+/// of a fixed size, overwriting the oldest ones. Nothing is written to disk or
+/// to other nodes, which makes it cheap enough to trace a sample of requests
+/// all the time. The sessions are read through the REST API.
+class trace_ring_buffer_helper final : public i_tracing_backend_helper {
+public:
+    // Number of finished sessions kept per shard.
+    static constexpr size_t max_sessions = 1000;
+    // Events of a session above this number are dropped.
+    static constexpr size_t max_events_per_session = 100;
+
+    struct event {
+        int32_t elapsed_us;
+        sstring message;
+    };
+
+    struct session {
+        utils::UUID session_id;
+        span_id parent_id;
+        span_id my_span_id;
+        trace_type command;
+        gms::inet_address client;
+        std::chrono::system_clock::time_point started_at;
+        int32_t duration_us;
+        sstring request;
+        std::vector<event> events;
+    };
+
+private:
+    boost::circular_buffer<session> _sessions;
+
+    struct stats {
+        uint64_t recorded_sessions = 0;
+        uint64_t dropped_events = 0;
+    } _stats;
+
+    seastar::metrics::metric_groups _metrics;
+
+public:
+    trace_ring_buffer_helper(tracing& tr);
+
+    virtual future<> start(cql3::query_processor& qp) override {
+        return make_ready_future<>();
+    }
+
+    virtual future<> stop() override {
+        return make_ready_future<>();
+    }
+
+    virtual void write_records_bulk(records_bulk& bulk) override;
+    virtual std::unique_ptr<backend_session_state_base> allocate_session_state() const override;
+
+    // The recorded sessions, oldest first.
+    const boost::circular_buffer<session>& sessions() const {
+        return _sessions;
+    }
+
+private:
+    void write_one_session_records(one_session_records& records);
+};
+
+}
@@ -47,5 +47,6 @@ void backend_registry::register_backend(sstring name) {
 }
 
 void register_tracing_keyspace_backend(backend_registry&);
+void register_tracing_ring_buffer_backend(backend_registry&);
 
 }
@@ -16,11 +16,14 @@
 
 #include "cql3/statements/batch_statement.hh"
 #include "cql3/statements/modification_statement.hh"
+#include "cql3/statements/select_statement.hh"
+#include "cql3/restrictions/statement_restrictions.hh"
 #include "types/collection.hh"
 #include "types/list.hh"
 #include "types/set.hh"
 #include "types/map.hh"
 #include "dht/token-sharding.hh"
+#include "sstables/key.hh"
 #include "service/migration_manager.hh"
 #include "service/memory_limiter.hh"
 #include "service/storage_proxy.hh"
@@ -45,6 +48,7 @@
 #include "exceptions/exceptions.hh"
 #include "client_data.hh"
 #include "cql3/query_processor.hh"
+#include "cql3/prepared_statement_slots.hh"
 #include "auth/authenticator.hh"
 
 #include <cassert>
@@ -52,6 +56,7 @@
 
 #include <snappy-c.h>
 #include <lz4.h>
+#include <zstd.h>
 
 #include "response.hh"
 #include "request.hh"
@@ -153,7 +158,10 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
     , _config(config)
     , _max_request_size(config.max_request_size)
     , _max_concurrent_requests(db_cfg.max_concurrent_requests_per_shard)
+    , _count_requests_for_other_shards(db_cfg.count_requests_for_other_shards)
     , _memory_available(ml.get_semaphore())
+    , _large_requests_memory_limit(_max_request_size / 2)
+    , _large_requests_memory(_large_requests_memory_limit)
     , _notifier(std::make_unique<event_notifier>(*this))
     , _auth_service(auth_service)
     , _sl_controller(sl_controller)
@@ -206,6 +214,14 @@ cql_server::cql_server(distributed<cql3::query_processor>& qp, auth::service& au
                         sm::description(
                             seastar::format("Holds an incrementing counter with the requests that ever blocked due to reaching the memory quota limit ({}B). "
                                             "The first derivative of this value shows how often we block due to memory exhaustion in the \"CQL transport\" component.", _max_request_size))),
+        sm::make_counter("requests_blocked_large", _stats.requests_blocked_large,
+                        sm::description(
+                            seastar::format("Holds an incrementing counter with the requests with a memory estimate above {}B which blocked "
+                                            "because other large requests were using the memory reserved for them.", large_request_threshold()))),
+        sm::make_counter("responses_coalesced", _stats.responses_coalesced,
+                        sm::description("Holds an incrementing counter with the responses which were written together with the responses queued behind them.")),
+        sm::make_counter("response_flushes", _stats.response_flushes,
+                        sm::description("Holds an incrementing counter with the flushes of responses to client connections.")),
         sm::make_counter("requests_shed", _stats.requests_shed,
                         sm::description("Holds an incrementing counter with the requests that were shed due to overload (threshold configured via max_concurrent_requests_per_shard). "
                                             "The first derivative of this value shows how often we shed requests due to overload in the \"CQL transport\" component.")),
@@ -548,6 +564,7 @@ client_data cql_server::connection::make_client_data() const {
     cd.protocol_version = _version;
     cd.driver_name = _client_state.get_driver_name();
     cd.driver_version = _client_state.get_driver_version();
+    cd.requests_for_other_shards = _requests_for_other_shards;
     if (const auto user_ptr = _client_state.user(); user_ptr) {
         cd.username = user_ptr->name;
     }
@@ -628,9 +645,22 @@ future<> cql_server::connection::process_request() {
             });
         }
 
+        // Large requests first take their share of the memory reserved for them,
+        // so that they wait apart from the small requests of all connections
+        // instead of queueing ahead of them on the shared memory semaphore.
+        auto large_permit_fut = make_ready_future<semaphore_units<>>();
+        if (mem_estimate > _server.large_request_threshold()) {
+            auto units = std::min<size_t>(mem_estimate, _server._large_requests_memory_limit);
+            if (_server._large_requests_memory.waiters() || _server._large_requests_memory.current() < units) {
+                ++_server._stats.requests_blocked_large;
+            }
+            large_permit_fut = get_units(_server._large_requests_memory, units);
+        }
+
+        return large_permit_fut.then([this, allow_shedding, mem_estimate, length = f.length, flags = f.flags, op, stream, tracing_requested] (semaphore_units<> large_permit) {
         const auto shedding_timeout = std::chrono::milliseconds(50);
         auto fut = allow_shedding
-                ? get_units(_server._memory_available, mem_estimate, shedding_timeout).then_wrapped([this, length = f.length] (auto f) {
+                ? get_units(_server._memory_available, mem_estimate, shedding_timeout).then_wrapped([this, length] (auto f) {
                     try {
                         return make_ready_future<semaphore_units<>>(f.get0());
                     } catch (semaphore_timed_out sto) {
@@ -651,14 +681,14 @@ future<> cql_server::connection::process_request() {
             ++_server._stats.requests_blocked_memory;
         }
 
-        return fut.then_wrapped([this, length = f.length, flags = f.flags, op, stream, tracing_requested] (auto mem_permit_fut) {
+        return fut.then_wrapped([this, length, flags, op, stream, tracing_requested, large_permit = std::move(large_permit)] (auto mem_permit_fut) mutable {
           if (mem_permit_fut.failed()) {
               // Ignore semaphore errors - they are expected if load shedding took place
               mem_permit_fut.ignore_ready_future();
               return make_ready_future<>();
           }
           semaphore_units<> mem_permit = mem_permit_fut.get0();
-          return this->read_and_decompress_frame(length, flags).then([this, op, stream, tracing_requested, mem_permit = make_service_permit(std::move(mem_permit))] (fragmented_temporary_buffer buf) mutable {
+          return this->read_and_decompress_frame(length, flags).then([this, op, stream, tracing_requested, mem_permit = make_service_permit(std::move(mem_permit)), large_permit = std::move(large_permit)] (fragmented_temporary_buffer buf) mutable {
 
             ++_server._stats.requests_served;
             ++_server._stats.requests_serving;
@@ -671,8 +701,11 @@ future<> cql_server::connection::process_request() {
             });
             auto istream = buf.get_istream();
             (void)_process_request_stage(this, istream, op, stream, seastar::ref(_client_state), tracing_requested, mem_permit)
-                    .then_wrapped([this, buf = std::move(buf), mem_permit, leave = std::move(leave)] (future<foreign_ptr<std::unique_ptr<cql_server::response>>> response_f) mutable {
+                    .then_wrapped([this, buf = std::move(buf), mem_permit, large_permit = std::move(large_permit), leave = std::move(leave)] (future<foreign_ptr<std::unique_ptr<cql_server::response>>> response_f) mutable {
                 try {
+                    // The response is built by now, so the large request's memory
+                    // is accounted for by mem_permit alone while it's being written.
+                    large_permit.return_all();
                     write_response(response_f.get0(), std::move(mem_permit), _compression);
                     _ready_to_respond = _ready_to_respond.finally([leave = std::move(leave)] {});
                 } catch (...) {
@@ -683,6 +716,7 @@ future<> cql_server::connection::process_request() {
             return make_ready_future<>();
           });
         });
+        });
     });
 }
 
@@ -703,6 +737,46 @@ void on_compression_buffer_use() {
     }
 }
 
+// Frames are compressed with a fast level, they are on the path of every request.
+static constexpr int zstd_compression_level = 1;
+
+struct zstd_cctx_deleter {
+    void operator()(ZSTD_CCtx* cctx) const {
+        ZSTD_freeCCtx(cctx);
+    }
+};
+
+struct zstd_dctx_deleter {
+    void operator()(ZSTD_DCtx* dctx) const {
+        ZSTD_freeDCtx(dctx);
+    }
+};
+
+// Contexts are shared by the connections of the shard, since setting up
+// one costs more than compressing a typical frame.
+static thread_local std::unique_ptr<ZSTD_CCtx, zstd_cctx_deleter> zstd_cctx;
+static thread_local std::unique_ptr<ZSTD_DCtx, zstd_dctx_deleter> zstd_dctx;
+
+ZSTD_CCtx* get_zstd_cctx() {
+    if (!zstd_cctx) {
+        zstd_cctx.reset(ZSTD_createCCtx());
+        if (!zstd_cctx) {
+            throw std::bad_alloc();
+        }
+    }
+    return zstd_cctx.get();
+}
+
+ZSTD_DCtx* get_zstd_dctx() {
+    if (!zstd_dctx) {
+        zstd_dctx.reset(ZSTD_createDCtx());
+        if (!zstd_dctx) {
+            throw std::bad_alloc();
+        }
+    }
+    return zstd_dctx.get();
+}
+
 }
 
 future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_frame(size_t length, uint8_t flags)
@@ -752,6 +826,30 @@ future<fragmented_temporary_buffer> cql_server::connection::read_and_decompress_
                 on_compression_buffer_use();
                 return uncomp;
             });
+        } else if (_compression == cql_compression::zstd) {
+            // The body is a single zstd frame, whose header holds the uncompressed size.
+            return _buffer_reader.read_exactly(_read_buf, length).then([this] (fragmented_temporary_buffer buf) {
+                auto in = input_buffer.get_linearized_view(fragmented_temporary_buffer::view(buf));
+                auto uncomp_len = ZSTD_getFrameContentSize(in.data(), in.size());
+                if (uncomp_len == ZSTD_CONTENTSIZE_UNKNOWN || uncomp_len == ZSTD_CONTENTSIZE_ERROR) {
+                    throw std::runtime_error("CQL frame zstd uncompressed size is unknown");
+                }
+                if (uncomp_len > size_t(std::numeric_limits<int32_t>::max())) {
+                    throw std::runtime_error(fmt::format("CQL frame zstd uncompressed size is too large: {}", uncomp_len));
+                }
+                auto uncomp = output_buffer.make_fragmented_temporary_buffer(uncomp_len, fragmented_temporary_buffer::default_fragment_size, [&] (bytes_mutable_view out) {
+                    auto ret = ZSTD_decompressDCtx(get_zstd_dctx(), out.data(), out.size(), in.data(), in.size());
+                    if (ZSTD_isError(ret)) {
+                        throw std::runtime_error(fmt::format("CQL frame zstd uncompression failure: {}", ZSTD_getErrorName(ret)));
+                    }
+                    if (ret != out.size()) {
+                        throw std::runtime_error("Malformed CQL frame - provided uncompressed size different than real uncompressed size");
+                    }
+                    return ret;
+                });
+                on_compression_buffer_use();
+                return uncomp;
+            });
         } else {
             throw exceptions::protocol_exception(format("Unknown compression algorithm"));
         }
@@ -771,6 +869,8 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_st
              _compression = cql_compression::lz4;
          } else if (compression == "snappy") {
              _compression = cql_compression::snappy;
+         } else if (compression == "zstd") {
+             _compression = cql_compression::zstd;
          } else {
              throw exceptions::protocol_exception(format("Unknown compression algorithm: {}", compression));
          }
@@ -940,45 +1040,112 @@ future<std::unique_ptr<cql_server::response>> cql_server::connection::process_pr
     tracing::add_query(trace_state, query);
     tracing::begin(trace_state, "Preparing CQL3 query", client_state.get_client_address());
 
-    auto cpu_id = this_shard_id();
-    auto cpus = boost::irange(0u, smp::count);
-    return parallel_for_each(cpus.begin(), cpus.end(), [this, query, cpu_id, &client_state] (unsigned int c) mutable {
-        if (c != cpu_id) {
-            return smp::submit_to(c, [this, query, &client_state] () mutable {
-                return _server._query_processor.local().prepare(std::move(query), client_state, false).discard_result();
-            });
-        } else {
-            return make_ready_future<>();
-        }
-    }).then([this, query, stream, &client_state, trace_state] () mutable {
-        tracing::trace(trace_state, "Done preparing on remote shards");
-        return _server._query_processor.local().prepare(std::move(query), client_state, false).then([this, stream, &client_state, trace_state] (auto msg) {
-            tracing::trace(trace_state, "Done preparing on a local shard - preparing a result. ID is [{}]", seastar::value_of([&msg] {
-                return messages::result_message::prepared::cql::get_id(msg);
-            }));
+    // The statement is only prepared on this shard. The other shards prepare it when
+    // it's first executed there, see query_processor::prepare_noted().
+    auto keyspace = client_state.get_raw_keyspace();
+    return _server._query_processor.local().prepare(query, client_state, false).then([this, query, keyspace, stream, trace_state] (auto msg) mutable {
+        tracing::trace(trace_state, "Done preparing on a local shard - preparing a result. ID is [{}]", seastar::value_of([&msg] {
+            return messages::result_message::prepared::cql::get_id(msg);
+        }));
+        auto key = cql3::query_processor::compute_id(query, keyspace);
+        return _server._query_processor.invoke_on_others([key, query, keyspace] (cql3::query_processor& qp) {
+            qp.note_prepared_elsewhere(key, query, keyspace);
+        }).then([this, stream, msg, trace_state] {
+            tracing::trace(trace_state, "Done noting the statement on remote shards");
             return make_result(stream, *msg, trace_state, _version);
         });
     });
 }
 
+// Whether the statement reads or writes a single partition, all of whose key
+// columns are restricted by equality. With an IN restriction the statement
+// spans several partitions, and a bound value is not a partition key.
+static bool restricts_single_partition(const cql3::cql_statement& stmt) {
+    const cql3::restrictions::statement_restrictions* restrictions = nullptr;
+    if (auto select = dynamic_cast<const cql3::statements::select_statement*>(&stmt)) {
+        restrictions = select->get_restrictions().get();
+    } else if (auto modification = dynamic_cast<const cql3::statements::modification_statement*>(&stmt)) {
+        restrictions = &modification->restrictions();
+    }
+    return restrictions && !restrictions->has_partition_key_unrestricted_components()
+            && restrictions->partition_key_restrictions_is_all_eq();
+}
+
+// The shard owning the partition a prepared statement is executed for, computed
+// the way a token-aware driver routes it: from the bound values of all partition
+// key columns. Disengaged if they aren't all bound, or the statement isn't for a
+// single partition.
+static std::optional<unsigned> get_owner_shard(data_dictionary::database db, const cql3::statements::prepared_statement& prepared,
+        const cql3::query_options& options) {
+    const auto& indices = prepared.partition_key_bind_indices;
+    if (indices.empty() || !restricts_single_partition(*prepared.statement)) {
+        return std::nullopt;
+    }
+    const auto& spec = *prepared.bound_names[indices.front()];
+    auto table = db.try_find_table(spec.ks_name, spec.cf_name);
+    if (!table) {
+        return std::nullopt;
+    }
+    const auto& schema = *table->schema();
+    if (indices.size() == 1) {
+        // The legacy form of a single column key, which the token is computed
+        // from, is the value alone, so it is hashed in place.
+        auto value = options.get_value_at(indices.front());
+        if (value.is_null() || value.is_unset_value()) {
+            return std::nullopt;
+        }
+        return value.with_linearized([&] (bytes_view v) {
+            return schema.get_sharder().shard_of(schema.get_partitioner().get_token(sstables::key_view(v)));
+        });
+    }
+    std::vector<bytes> components;
+    components.reserve(indices.size());
+    for (auto idx : indices) {
+        auto value = options.get_value_at(idx);
+        if (value.is_null() || value.is_unset_value()) {
+            return std::nullopt;
+        }
+        components.push_back(to_bytes(value));
+    }
+    auto key = partition_key::from_exploded(schema, components);
+    return schema.get_sharder().shard_of(dht::get_token(schema, key));
+}
+
 static future<process_fn_return_type>
 process_execute_internal(service::client_state& client_state, distributed<cql3::query_processor>& qp, request_reader in,
         uint16_t stream, cql_protocol_version_type version, cql_serialization_format serialization_format,
-        service_permit permit, tracing::trace_state_ptr trace_state, bool init_trace, cql3::computed_function_values cached_pk_fn_calls) {
+        service_permit permit, tracing::trace_state_ptr trace_state, bool init_trace, cql3::computed_function_values cached_pk_fn_calls,
+        cql3::prepared_statement_slots* slots, uint64_t* requests_for_other_shards) {
+    auto request = in;
     cql3::prepared_cache_key_type cache_key(in.read_short_bytes());
     auto& id = cql3::prepared_cache_key_type::cql_id(cache_key);
     bool needs_authorization = false;
+    cql3::statements::prepared_statement::checked_weak_ptr prepared;
 
-    // First, try to lookup in the cache of already authorized statements. If the corresponding entry is not found there
-    // look for the prepared statement and then authorize it.
-    auto prepared = qp.local().get_prepared(client_state.user(), cache_key);
-    if (!prepared) {
-        needs_authorization = true;
-        prepared = qp.local().get_prepared(cache_key);
+    if (slots) {
+        auto r = slots->get_prepared(qp.local(), client_state.user(), cache_key);
+        prepared = std::move(r.statement);
+        needs_authorization = r.needs_authorization;
+    } else {
+        // First, try to lookup in the cache of already authorized statements. If the corresponding entry is not found there
+        // look for the prepared statement and then authorize it.
+        prepared = qp.local().get_prepared(client_state.user(), cache_key);
+        if (!prepared) {
+            needs_authorization = true;
+            prepared = qp.local().get_prepared(cache_key);
+        }
     }
 
     if (!prepared) {
-        throw exceptions::prepared_query_not_found_exception(id);
+        return qp.local().prepare_noted(cache_key).then([&client_state, &qp, request, stream, version, serialization_format, permit = std::move(permit),
+                trace_state = std::move(trace_state), init_trace, cached_pk_fn_calls = std::move(cached_pk_fn_calls), slots, requests_for_other_shards,
+                cache_key] (bool prepared) mutable {
+            if (!prepared) {
+                throw exceptions::prepared_query_not_found_exception(cql3::prepared_cache_key_type::cql_id(cache_key));
+            }
+            return process_execute_internal(client_state, qp, request, stream, version, serialization_format, std::move(permit), std::move(trace_state),
+                    init_trace, std::move(cached_pk_fn_calls), slots, requests_for_other_shards);
+        });
     }
 
     auto q_state = std::make_unique<cql_query_state>(client_state, trace_state, std::move(permit));
@@ -1021,6 +1188,12 @@ process_execute_internal(service::client_state& client_state, distributed<cql3::
 
     options.prepare(prepared->bound_names);
 
+    if (requests_for_other_shards) {
+        if (auto shard = get_owner_shard(qp.local().db(), *prepared, options); shard && *shard != this_shard_id()) {
+            ++*requests_for_other_shards;
+        }
+    }
+
     if (init_trace) {
         tracing::add_prepared_query_options(trace_state, options);
     }
@@ -1042,7 +1215,19 @@ process_execute_internal(service::client_state& client_state, distributed<cql3::
 future<cql_server::result_with_foreign_response_ptr> cql_server::connection::process_execute(uint16_t stream, request_reader in,
         service::client_state& client_state, service_permit permit, tracing::trace_state_ptr trace_state) {
     ++_server._stats.execute_requests;
-    return process(stream, in, client_state, std::move(permit), std::move(trace_state), process_execute_internal);
+    if (!_prepared_slots) {
+        _prepared_slots = std::make_unique<cql3::prepared_statement_slots>();
+    }
+    // The slots and the counter can't be used if the request bounces to another shard.
+    auto requests_for_other_shards = _server._count_requests_for_other_shards() ? &_requests_for_other_shards : nullptr;
+    return process(stream, in, client_state, std::move(permit), std::move(trace_state),
+            [slots = _prepared_slots.get(), requests_for_other_shards, shard = this_shard_id()] (service::client_state& client_state, distributed<cql3::query_processor>& qp, request_reader in,
+                    uint16_t stream, cql_protocol_version_type version, cql_serialization_format serialization_format,
+                    service_permit permit, tracing::trace_state_ptr trace_state, bool init_trace, cql3::computed_function_values cached_pk_fn_calls) {
+        return process_execute_internal(client_state, qp, in, stream, version, serialization_format, std::move(permit), std::move(trace_state),
+                init_trace, std::move(cached_pk_fn_calls), this_shard_id() == shard ? slots : nullptr,
+                this_shard_id() == shard ? requests_for_other_shards : nullptr);
+    });
 }
 
 static future<process_fn_return_type>
@@ -1052,6 +1237,7 @@ process_batch_internal(service::client_state& client_state, distributed<cql3::qu
     if (version == 1) {
         throw exceptions::protocol_exception("BATCH messages are not support in version 1 of the protocol");
     }
+    auto request = in;
 
     const auto type = in.read_byte();
     const unsigned n = in.read_short();
@@ -1086,7 +1272,6 @@ process_batch_internal(service::client_state& client_state, distributed<cql3::qu
         }
         case 1: {
             cql3::prepared_cache_key_type cache_key(in.read_short_bytes());
-            auto& id = cql3::prepared_cache_key_type::cql_id(cache_key);
 
             // First, try to lookup in the cache of already authorized statements. If the corresponding entry is not found there
             // look for the prepared statement and then authorize it.
@@ -1094,7 +1279,16 @@ process_batch_internal(service::client_state& client_state, distributed<cql3::qu
             if (!ps) {
                 ps = qp.local().get_prepared(cache_key);
                 if (!ps) {
-                    throw exceptions::prepared_query_not_found_exception(id);
+                    // Start over once the statement is prepared, if it was prepared by another shard.
+                    return qp.local().prepare_noted(cache_key).then([&client_state, &qp, request, stream, version, serialization_format, permit = std::move(permit),
+                            trace_state = std::move(trace_state), init_trace, cached_pk_fn_calls = std::move(cached_pk_fn_calls),
+                            cache_key] (bool prepared) mutable {
+                        if (!prepared) {
+                            throw exceptions::prepared_query_not_found_exception(cql3::prepared_cache_key_type::cql_id(cache_key));
+                        }
+                        return process_batch_internal(client_state, qp, request, stream, version, serialization_format, std::move(permit),
+                                std::move(trace_state), init_trace, std::move(cached_pk_fn_calls));
+                    });
                 }
                 // authorize a particular prepared statement only once
                 needs_authorization = pending_authorization_entries.emplace(std::move(cache_key), ps->checked_weak_from_this()).second;
@@ -1334,6 +1528,7 @@ std::unique_ptr<cql_server::response> cql_server::connection::make_supported(int
     opts.insert({"CQL_VERSION", cql3::query_processor::CQL_VERSION});
     opts.insert({"COMPRESSION", "lz4"});
     opts.insert({"COMPRESSION", "snappy"});
+    opts.insert({"COMPRESSION", "zstd"});
     if (_server._config.allow_shard_aware_drivers) {
         opts.insert({"SCYLLA_SHARD", format("{:d}", this_shard_id())});
         opts.insert({"SCYLLA_NR_SHARDS", format("{:d}", smp::count)});
@@ -1480,10 +1675,19 @@ cql_server::connection::make_schema_change_event(const event::schema_change& eve
 
 void cql_server::connection::write_response(foreign_ptr<std::unique_ptr<cql_server::response>>&& response, service_permit permit, cql_compression compression)
 {
+    ++_responses_queued;
     _ready_to_respond = _ready_to_respond.then([this, compression, response = std::move(response), permit = std::move(permit)] () mutable {
         auto message = response->make_message(_version, compression);
         message.on_delete([response = std::move(response)] { });
         return _write_buf.write(std::move(message)).then([this] {
+            // Responses which became ready while this one was being written are
+            // queued behind it. Leave them in the buffer and flush them all
+            // together with the last one, so that they go out in a single writev.
+            if (--_responses_queued) {
+                ++_server._stats.responses_coalesced;
+                return make_ready_future<>();
+            }
+            ++_server._stats.response_flushes;
             return _write_buf.flush();
         });
     });
@@ -1511,6 +1715,9 @@ void cql_server::response::compress(cql_compression compression)
     case cql_compression::snappy:
         compress_snappy();
         break;
+    case cql_compression::zstd:
+        compress_zstd();
+        break;
     default:
         throw std::invalid_argument("Invalid CQL compression algorithm");
     }
@@ -1562,6 +1769,24 @@ void cql_server::response::compress_snappy()
     on_compression_buffer_use();
 }
 
+void cql_server::response::compress_zstd()
+{
+    using namespace compression_buffers;
+    auto view = input_buffer.get_linearized_view(_body);
+    const char* input = reinterpret_cast<const char*>(view.data());
+    size_t input_len = view.size();
+
+    size_t output_len = ZSTD_compressBound(input_len);
+    _body = output_buffer.make_buffer(output_len, [&] (bytes_mutable_view output_view) {
+        auto ret = ZSTD_compressCCtx(get_zstd_cctx(), output_view.data(), output_view.size(), input, input_len, zstd_compression_level);
+        if (ZSTD_isError(ret)) {
+            throw std::runtime_error(fmt::format("CQL frame zstd compression failure: {}", ZSTD_getErrorName(ret)));
+        }
+        return ret;
+    });
+    on_compression_buffer_use();
+}
+
 void cql_server::response::serialize(const event::schema_change& event, uint8_t version)
 {
     if (version >= 3) {
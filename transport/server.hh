@@ -36,6 +36,7 @@
 namespace cql3 {
 
 class query_processor;
+class prepared_statement_slots;
 
 }
 
@@ -69,6 +70,7 @@ enum class cql_compression {
     none,
     lz4,
     snappy,
+    zstd,
 };
 
 enum cql_frame_flags {
@@ -133,6 +135,9 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         uint32_t requests_serving;
         uint64_t requests_blocked_memory;
         uint64_t requests_shed;
+        uint64_t requests_blocked_large;
+        uint64_t responses_coalesced;
+        uint64_t response_flushes;
 
         // cql message stats
         uint64_t startups;
@@ -155,7 +160,12 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
     cql_server_config _config;
     size_t _max_request_size;
     utils::updateable_value<uint32_t> _max_concurrent_requests;
+    utils::updateable_value<bool> _count_requests_for_other_shards;
     semaphore& _memory_available;
+    // Large requests may together use at most this much of the memory available to requests,
+    // so that a few of them don't make all the small ones wait.
+    size_t _large_requests_memory_limit;
+    semaphore _large_requests_memory;
     seastar::metrics::metric_groups _metrics;
     std::unique_ptr<event_notifier> _notifier;
 private:
@@ -196,6 +206,13 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
         unsigned _request_cpu = 0;
         bool _ready = false;
         bool _authenticating = false;
+        // Responses waiting to be written, they are flushed together once the last one is.
+        size_t _responses_queued = 0;
+        // Allocated by the first EXECUTE on the connection.
+        std::unique_ptr<cql3::prepared_statement_slots> _prepared_slots;
+        // EXECUTE requests for a partition owned by another shard than the
+        // connection's, i.e. which a shard-aware driver would have sent elsewhere.
+        uint64_t _requests_for_other_shards = 0;
 
         enum class tracing_request_type : uint8_t {
             not_requested,
@@ -284,6 +301,9 @@ class cql_server : public seastar::peering_sharded_service<cql_server>, public g
     future<> unadvertise_connection(shared_ptr<generic_server::connection> conn) override;
 
     const ::timeout_config& timeout_config() { return _config.timeout_config; }
+
+    // Requests whose memory estimate exceeds this take memory from _large_requests_memory too.
+    size_t large_request_threshold() const { return _max_request_size / 64; }
 };
 
 class cql_server::event_notifier : public service::migration_listener,
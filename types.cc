@@ -1612,11 +1612,8 @@ struct validate_visitor {
         }
     }
     void operator()(const ascii_type_impl&) {
-        // ASCII can be validated independently for each fragment
-        for (bytes_view frag : fragment_range(v)) {
-            if (!utils::ascii::validate(frag)) {
-                throw marshal_exception("Validation failed - non-ASCII character in an ASCII string");
-            }
+        if (!utils::ascii::validate(v)) {
+            throw marshal_exception("Validation failed - non-ASCII character in an ASCII string");
         }
     }
     void operator()(const utf8_type_impl&) {
@@ -2032,6 +2029,18 @@ data_value deserialize_aux(const tuple_type_impl& t, View v) {
 template<FragmentedView View>
 utils::multiprecision_int deserialize_value(const varint_type_impl&, View v) {
     bool negative = v.current_fragment().front() < 0;
+    if (v.size_bytes() <= sizeof(int64_t)) {
+        // Most values fit in an int64_t, and building a cpp_int from one is much
+        // cheaper than shifting the bytes into it one by one.
+        uint64_t x = negative ? ~uint64_t(0) : 0;
+        while (v.size_bytes()) {
+            for (uint8_t b : v.current_fragment()) {
+                x = (x << 8) | b;
+            }
+            v.remove_current();
+        }
+        return utils::multiprecision_int(int64_t(x));
+    }
     utils::multiprecision_int num;
   while (v.size_bytes()) {
     for (uint8_t b : v.current_fragment()) {
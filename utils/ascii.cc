@@ -11,14 +11,41 @@
 #include "ascii.hh"
 #include <seastar/core/byteorder.hh>
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define arch_target(name) [[gnu::target(name)]]
+#else
+#define arch_target(name)
+#endif
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace utils {
 
 namespace ascii {
 
-bool validate(const uint8_t *data, size_t len) {
+arch_target("default") bool validate_impl(const uint8_t *data, size_t len) {
     // OR all bytes
     uint8_t orall = 0;
 
+#if defined(__aarch64__)
+    if (len >= 32) {
+        uint8x16_t or1 = vdupq_n_u8(0), or2 = vdupq_n_u8(0);
+
+        do {
+            or1 = vorrq_u8(or1, vld1q_u8(data));
+            or2 = vorrq_u8(or2, vld1q_u8(data + 16));
+
+            data += 32;
+            len -= 32;
+        } while (len >= 32);
+
+        orall = vmaxvq_u8(vorrq_u8(or1, or2));
+    }
+#endif
+
     // Fast OR by 8-bytes and two independent streams
     if (len >= 16) {
         uint64_t or1 = 0, or2 = 0;
@@ -46,6 +73,43 @@ bool validate(const uint8_t *data, size_t len) {
     return orall < 0x80;
 }
 
+#if defined(__x86_64__)
+
+// OR 64 bytes per iteration, the sign bits of the result tell whether
+// any byte had the 7-th bit set.
+arch_target("avx2") bool validate_impl(const uint8_t *data, size_t len) {
+    __m256i or1 = _mm256_setzero_si256(), or2 = _mm256_setzero_si256();
+
+    while (len >= 64) {
+        or1 = _mm256_or_si256(or1, _mm256_loadu_si256((const __m256i *)data));
+        or2 = _mm256_or_si256(or2, _mm256_loadu_si256((const __m256i *)(data + 32)));
+
+        data += 64;
+        len -= 64;
+    }
+    if (len >= 32) {
+        or1 = _mm256_or_si256(or1, _mm256_loadu_si256((const __m256i *)data));
+
+        data += 32;
+        len -= 32;
+    }
+    if (_mm256_movemask_epi8(_mm256_or_si256(or1, or2))) {
+        return false;
+    }
+
+    uint8_t orall = 0;
+    while (len--) {
+        orall |= *data++;
+    }
+    return orall < 0x80;
+}
+
+#endif
+
+bool validate(const uint8_t *data, size_t len) {
+    return validate_impl(data, len);
+}
+
 } // namespace ascii
 
 } // namespace utils
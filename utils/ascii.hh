@@ -12,6 +12,7 @@
 
 #include <cstdint>
 #include "bytes.hh"
+#include "fragment_range.hh"
 
 namespace utils {
 
@@ -26,6 +27,16 @@ inline bool validate(bytes_view string) {
     return validate(data, len);
 }
 
+// ASCII is validated byte by byte, so fragments are validated separately.
+inline bool validate(FragmentedView auto fv) {
+    for (bytes_view frag : fragment_range(fv)) {
+        if (!validate(frag)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 } // namespace ascii
 
 } // namespace utils
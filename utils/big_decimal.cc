@@ -7,6 +7,7 @@
  */
 
 #include "big_decimal.hh"
+#include <array>
 #include <cassert>
 #include "marshal_exception.hh"
 #include <seastar/core/print.hh>
@@ -38,6 +39,27 @@ uint64_t from_varint_to_integer(const utils::multiprecision_int& varint) {
     return static_cast<uint64_t>(~static_cast<uint64_t>(0) & boost::multiprecision::cpp_int(varint));
 }
 
+// Multiplies v by 10^n. Powers that fit in a uint64_t are multiplied in
+// directly, instead of building 10^n as a cpp_int first.
+static void rescale(boost::multiprecision::cpp_int& v, uint32_t n) {
+    static constexpr auto powers_of_ten = [] {
+        std::array<uint64_t, 20> p{1};
+        for (size_t i = 1; i < p.size(); ++i) {
+            p[i] = p[i - 1] * 10;
+        }
+        return p;
+    }();
+    if (n < powers_of_ten.size()) {
+        v *= powers_of_ten[n];
+    } else {
+        v *= boost::multiprecision::pow(boost::multiprecision::cpp_int(10), n);
+    }
+}
+
+static uint32_t scale_difference(int32_t larger, int32_t smaller) {
+    return uint32_t(int64_t(larger) - int64_t(smaller));
+}
+
 big_decimal::big_decimal() : big_decimal(0, 0) {}
 big_decimal::big_decimal(int32_t scale, boost::multiprecision::cpp_int unscaled_value)
     : _scale(scale), _unscaled_value(std::move(unscaled_value)) {}
@@ -137,24 +159,40 @@ sstring big_decimal::to_string() const
 
 std::strong_ordering big_decimal::compare(const big_decimal& other) const
 {
-    auto max_scale = std::max(_scale, other._scale);
-    boost::multiprecision::cpp_int rescale(10);
-    boost::multiprecision::cpp_int x = _unscaled_value * boost::multiprecision::pow(rescale, max_scale - _scale);
-    boost::multiprecision::cpp_int y = other._unscaled_value * boost::multiprecision::pow(rescale, max_scale - other._scale);
-    return x == y ? std::strong_ordering::equal : x < y ? std::strong_ordering::less : std::strong_ordering::greater;
+    // Only the value with the smaller scale needs rescaling, and none does
+    // when the scales are equal, as they are for values of a column that were
+    // all written with the same precision.
+    auto tri_compare = [] (const boost::multiprecision::cpp_int& x, const boost::multiprecision::cpp_int& y) {
+        return x.compare(y) <=> 0;
+    };
+    if (_scale == other._scale) {
+        return tri_compare(_unscaled_value, other._unscaled_value);
+    }
+    if (_unscaled_value.sign() != other._unscaled_value.sign()) {
+        return _unscaled_value.sign() <=> other._unscaled_value.sign();
+    }
+    if (_scale < other._scale) {
+        boost::multiprecision::cpp_int x = _unscaled_value;
+        rescale(x, scale_difference(other._scale, _scale));
+        return tri_compare(x, other._unscaled_value);
+    }
+    boost::multiprecision::cpp_int y = other._unscaled_value;
+    rescale(y, scale_difference(_scale, other._scale));
+    return tri_compare(_unscaled_value, y);
 }
 
 big_decimal& big_decimal::operator+=(const big_decimal& other)
 {
     if (_scale == other._scale) {
         _unscaled_value += other._unscaled_value;
+    } else if (_scale < other._scale) {
+        rescale(_unscaled_value, scale_difference(other._scale, _scale));
+        _unscaled_value += other._unscaled_value;
+        _scale = other._scale;
     } else {
-        boost::multiprecision::cpp_int rescale(10);
-        auto max_scale = std::max(_scale, other._scale);
-        boost::multiprecision::cpp_int u = _unscaled_value * boost::multiprecision::pow(rescale,  max_scale - _scale);
-        boost::multiprecision::cpp_int v = other._unscaled_value * boost::multiprecision::pow(rescale, max_scale - other._scale);
-        _unscaled_value = u + v;
-        _scale = max_scale;
+        boost::multiprecision::cpp_int v = other._unscaled_value;
+        rescale(v, scale_difference(_scale, other._scale));
+        _unscaled_value += v;
     }
     return *this;
 }
@@ -162,13 +200,14 @@ big_decimal& big_decimal::operator+=(const big_decimal& other)
 big_decimal& big_decimal::operator-=(const big_decimal& other) {
     if (_scale == other._scale) {
         _unscaled_value -= other._unscaled_value;
+    } else if (_scale < other._scale) {
+        rescale(_unscaled_value, scale_difference(other._scale, _scale));
+        _unscaled_value -= other._unscaled_value;
+        _scale = other._scale;
     } else {
-        boost::multiprecision::cpp_int rescale(10);
-        auto max_scale = std::max(_scale, other._scale);
-        boost::multiprecision::cpp_int u = _unscaled_value * boost::multiprecision::pow(rescale,  max_scale - _scale);
-        boost::multiprecision::cpp_int v = other._unscaled_value * boost::multiprecision::pow(rescale, max_scale - other._scale);
-        _unscaled_value = u - v;
-        _scale = max_scale;
+        boost::multiprecision::cpp_int v = other._unscaled_value;
+        rescale(v, scale_difference(_scale, other._scale));
+        _unscaled_value -= v;
     }
     return *this;
 }
@@ -15,6 +15,7 @@
 #include "tracing/trace_state.hh"
 
 #include <seastar/core/file.hh>
+#include <seastar/core/shared_future.hh>
 #include <seastar/core/coroutine.hh>
 #include <seastar/coroutine/maybe_yield.hh>
 
@@ -51,6 +52,7 @@ class cached_file {
         uint64_t page_misses = 0;
         uint64_t page_evictions = 0;
         uint64_t page_populations = 0;
+        uint64_t page_concurrent_misses = 0; // misses which waited for a read of the page already in progress
         uint64_t cached_bytes = 0;
         uint64_t bytes_in_std = 0; // memory used by active temporary_buffer:s
     };
@@ -68,7 +70,7 @@ class cached_file {
                 if (--cp->_use_count == 0) {
                     cp->parent->_metrics.bytes_in_std -= cp->_buf.size();
                     cp->_buf = {};
-                    cp->parent->_lru.add(*cp);
+                    cp->parent->_lru.touch(*cp);
                 }
             }
         };
@@ -149,28 +151,60 @@ class cached_file {
     using cache_type = bplus::tree<page_idx_type, cached_page, page_idx_less_comparator, 12, bplus::key_search::linear>;
     cache_type _cache;
 
+    struct page_load {
+        page_count_type count = 0;
+        shared_promise<> done;
+    };
+    // Reads in progress, by the index of their first page. Concurrent misses
+    // on pages which are already being read wait for that read instead of
+    // issuing their own I/O for the same pages.
+    std::map<page_idx_type, lw_shared_ptr<page_load>> _loads;
+
     const offset_type _size;
     offset_type _cached_bytes = 0;
 
     offset_type _last_page_size;
     page_idx_type _last_page;
 private:
+    // A lookup which waited for a read in progress is retried with `retry` set,
+    // so that each lookup is counted once, as a hit or as a miss.
     future<cached_page::ptr_type> get_page_ptr(page_idx_type idx,
             page_count_type read_ahead,
             const io_priority_class& pc,
-            tracing::trace_state_ptr trace_state) {
+            tracing::trace_state_ptr trace_state,
+            bool retry = false) {
         auto i = _cache.lower_bound(idx);
         if (i != _cache.end() && i->idx == idx) {
-            ++_metrics.page_hits;
+            if (!retry) {
+                ++_metrics.page_hits;
+            }
             tracing::trace(trace_state, "page cache hit: file={}, page={}", _file_name, idx);
             cached_page& cp = *i;
             return make_ready_future<cached_page::ptr_type>(cp.share());
         }
+        if (!retry) {
+            ++_metrics.page_misses;
+        }
+        if (auto li = _loads.upper_bound(idx); li != _loads.begin()) {
+            --li;
+            if (idx < li->first + li->second->count) {
+                tracing::trace(trace_state, "page cache miss: file={}, page={}, waiting for read in progress", _file_name, idx);
+                if (!retry) {
+                    ++_metrics.page_concurrent_misses;
+                }
+                return li->second->done.get_shared_future().then([this, idx, read_ahead, pc, trace_state = std::move(trace_state)] () mutable {
+                    // The page may have been evicted already, in which case it is read again.
+                    return get_page_ptr(idx, read_ahead, pc, std::move(trace_state), true);
+                });
+            }
+        }
         tracing::trace(trace_state, "page cache miss: file={}, page={}, readahead={}", _file_name, idx, read_ahead);
-        ++_metrics.page_misses;
         size_t size = (idx + read_ahead) > _last_page
                 ? (_last_page_size + (_last_page - idx) * page_size)
                 : read_ahead * page_size;
+        auto load = make_lw_shared<page_load>();
+        load->count = div_ceil(size, page_size);
+        _loads.emplace(idx, load);
         return _file.dma_read_exactly<char>(idx * page_size, size, pc)
             .then([this, idx] (temporary_buffer<char>&& buf) mutable {
                 cached_page::ptr_type first_page;
@@ -196,6 +230,17 @@ class cached_file {
                     }
                 }
                 return first_page;
+            })
+            .then_wrapped([this, idx, load] (future<cached_page::ptr_type> f) {
+                // Resolved only after the pages were inserted, so that waiters find them.
+                _loads.erase(idx);
+                if (f.failed()) {
+                    auto ex = f.get_exception();
+                    load->done.set_exception(ex);
+                    return make_exception_future<cached_page::ptr_type>(std::move(ex));
+                }
+                load->done.set_value();
+                return f;
             });
     }
     future<temporary_buffer<char>> get_page(page_idx_type idx,
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <algorithm>
+
+#include <seastar/core/later.hh>
+
+#include "utils/coalescing_file.hh"
+
+coalescing_file_impl::coalescing_file_impl(file f, config cfg, stats& s)
+    : file_impl(*get_file_impl(f))
+    , _file(std::move(f))
+    , _cfg(cfg)
+    , _stats(s)
+{}
+
+future<temporary_buffer<uint8_t>> coalescing_file_impl::dma_read_bulk(uint64_t offset, size_t range_size, const io_priority_class& pc) {
+    ++_stats.requests;
+    if (_gate.is_closed()) {
+        return make_exception_future<temporary_buffer<uint8_t>>(gate_closed_exception());
+    }
+    if (_queue.empty()) {
+        // Let the other readers which are ready to run queue their requests before submitting.
+        (void)with_gate(_gate, [this] {
+            return yield().then([this] {
+                submit();
+            });
+        });
+    }
+    _queue.push_back(request{offset, range_size, pc, {}});
+    return _queue.back().pr.get_future();
+}
+
+void coalescing_file_impl::submit() {
+    auto queue = std::exchange(_queue, {});
+    std::sort(queue.begin(), queue.end(), [] (const request& a, const request& b) {
+        return std::make_pair(a.pc.id(), a.offset) < std::make_pair(b.pc.id(), b.offset);
+    });
+    auto group_begin = queue.begin();
+    while (group_begin != queue.end()) {
+        auto group_start = group_begin->offset;
+        auto group_end = group_begin->offset + group_begin->size;
+        auto group_pc = group_begin->pc.id();
+        auto i = std::next(group_begin);
+        while (i != queue.end()
+                && i->pc.id() == group_pc
+                && i->offset <= group_end + _cfg.max_gap
+                && std::max(group_end, i->offset + i->size) - group_start <= _cfg.max_read_size) {
+            group_end = std::max(group_end, i->offset + i->size);
+            ++i;
+        }
+        submit_group(group_begin, i);
+        group_begin = i;
+    }
+}
+
+void coalescing_file_impl::submit_group(std::vector<request>::iterator begin, std::vector<request>::iterator end) {
+    auto start = begin->offset;
+    uint64_t group_end = start;
+    std::vector<request> requests;
+    requests.reserve(end - begin);
+    for (auto i = begin; i != end; ++i) {
+        group_end = std::max(group_end, i->offset + i->size);
+        requests.push_back(std::move(*i));
+    }
+    ++_stats.reads;
+    auto pc = requests.front().pc;
+    (void)with_gate(_gate, [this, start, size = group_end - start, pc, requests = std::move(requests)] () mutable {
+        return futurize_invoke([&] {
+            return get_file_impl(_file)->dma_read_bulk(start, size, pc);
+        }).then_wrapped([start, requests = std::move(requests)] (future<temporary_buffer<uint8_t>> f) mutable {
+            if (f.failed()) {
+                auto ex = f.get_exception();
+                for (auto& r : requests) {
+                    r.pr.set_exception(ex);
+                }
+                return;
+            }
+            auto buf = f.get0();
+            for (auto& r : requests) {
+                // The merged read may be short if it reached the end of file.
+                auto pos = std::min<uint64_t>(r.offset - start, buf.size());
+                auto len = std::min<uint64_t>(r.size, buf.size() - pos);
+                r.pr.set_value(buf.share(pos, len));
+            }
+        });
+    });
+}
+
+future<> coalescing_file_impl::close() {
+    return _gate.close().then([this] {
+        return get_file_impl(_file)->close();
+    });
+}
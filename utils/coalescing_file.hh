@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <seastar/core/file.hh>
+#include <seastar/core/gate.hh>
+
+#include "seastarx.hh"
+
+/// \brief A file wrapper which merges concurrent bulk reads of nearby ranges.
+///
+/// Concurrent readers of the same file, e.g. many point reads hitting the same
+/// sstable, each issue their own small dma_read_bulk(). On storage which is
+/// IOPS-bound, one larger read is cheaper than several small ones.
+///
+/// dma_read_bulk() calls are queued instead of being submitted right away.
+/// The queue is submitted at the next scheduling point, after sorting the
+/// requests by offset and merging those of the same priority class which
+/// overlap or are separated by at most max_gap bytes. Each request is then
+/// served with a view into the buffer of the merged read.
+///
+/// Other operations are forwarded to the underlying file as they are.
+class coalescing_file_impl : public file_impl {
+public:
+    struct config {
+        // Requests separated by at most this many bytes are merged.
+        size_t max_gap = 4096;
+        // Requests are not merged into reads larger than this.
+        size_t max_read_size = 128 * 1024;
+    };
+
+    struct stats {
+        uint64_t requests = 0; // Number of dma_read_bulk() calls
+        uint64_t reads = 0; // Number of reads issued to the underlying file
+    };
+private:
+    struct request {
+        uint64_t offset;
+        size_t size;
+        io_priority_class pc;
+        promise<temporary_buffer<uint8_t>> pr;
+    };
+
+    file _file;
+    config _cfg;
+    stats& _stats;
+    std::vector<request> _queue;
+    gate _gate;
+private:
+    void submit();
+    void submit_group(std::vector<request>::iterator begin, std::vector<request>::iterator end);
+public:
+    coalescing_file_impl(file f, config cfg, stats& s);
+
+    virtual future<size_t> write_dma(uint64_t pos, const void* buffer, size_t len, const io_priority_class& pc) override {
+        return get_file_impl(_file)->write_dma(pos, buffer, len, pc);
+    }
+
+    virtual future<size_t> write_dma(uint64_t pos, std::vector<iovec> iov, const io_priority_class& pc) override {
+        return get_file_impl(_file)->write_dma(pos, std::move(iov), pc);
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, void* buffer, size_t len, const io_priority_class& pc) override {
+        return get_file_impl(_file)->read_dma(pos, buffer, len, pc);
+    }
+
+    virtual future<size_t> read_dma(uint64_t pos, std::vector<iovec> iov, const io_priority_class& pc) override {
+        return get_file_impl(_file)->read_dma(pos, std::move(iov), pc);
+    }
+
+    virtual future<> flush(void) override {
+        return get_file_impl(_file)->flush();
+    }
+
+    virtual future<struct stat> stat(void) override {
+        return get_file_impl(_file)->stat();
+    }
+
+    virtual future<> truncate(uint64_t length) override {
+        return get_file_impl(_file)->truncate(length);
+    }
+
+    virtual future<> discard(uint64_t offset, uint64_t length) override {
+        return get_file_impl(_file)->discard(offset, length);
+    }
+
+    virtual future<> allocate(uint64_t position, uint64_t length) override {
+        return get_file_impl(_file)->allocate(position, length);
+    }
+
+    virtual future<uint64_t> size(void) override {
+        return get_file_impl(_file)->size();
+    }
+
+    // Waits for queued reads before closing the underlying file.
+    virtual future<> close() override;
+
+    virtual std::unique_ptr<seastar::file_handle_impl> dup() override {
+        return get_file_impl(_file)->dup();
+    }
+
+    virtual subscription<directory_entry> list_directory(std::function<future<> (directory_entry de)> next) override {
+        return get_file_impl(_file)->list_directory(std::move(next));
+    }
+
+    virtual future<temporary_buffer<uint8_t>> dma_read_bulk(uint64_t offset, size_t range_size, const io_priority_class& pc) override;
+};
+
+inline file make_coalescing_file(file f, coalescing_file_impl::config cfg, coalescing_file_impl::stats& stats) {
+    return file(::make_shared<coalescing_file_impl>(std::move(f), cfg, stats));
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <seastar/core/metrics.hh>
+#include <seastar/core/reactor.hh>
+#include <seastar/util/backtrace.hh>
+#include "utils/code_region.hh"
+#include "utils/histogram_metrics_helper.hh"
+#include "log.hh"
+
+static logging::logger crlog("code_region");
+
+namespace utils {
+
+const char* to_string(code_region r) noexcept {
+    switch (r) {
+    case code_region::cache_update: return "cache_update";
+    case code_region::memtable_flush: return "memtable_flush";
+    case code_region::compaction: return "compaction";
+    case code_region::view_update: return "view_update";
+    }
+    std::abort();
+}
+
+code_region_stats& code_region_stats::local() noexcept {
+    static thread_local code_region_stats stats;
+    return stats;
+}
+
+code_region_stats::site& code_region_stats::get_site(code_region r, scheduling_group sg) {
+    for (auto& s : _sites) {
+        if (s->region == r && s->sg == sg) {
+            return *s;
+        }
+    }
+
+    auto& s = *_sites.emplace_back(std::make_unique<site>(site{.region = r, .sg = sg}));
+
+    namespace sm = seastar::metrics;
+    static const sm::label region_label("region");
+    static const sm::label scheduling_group_label("scheduling_group_name");
+    std::vector<sm::label_instance> labels{region_label(to_string(r)), scheduling_group_label(sg.name())};
+
+    _metrics.add_group("code_region", {
+        sm::make_histogram("runtime", [&s] { return to_metrics_histogram(s.runtime); },
+                sm::description("Histogram of the runtime, in microseconds, of the runs of a code region without yielding."), labels),
+
+        sm::make_counter("stalls", [&s] { return s.stalls; },
+                sm::description("Counts the runs of a code region which were longer than the reactor's blocked notification threshold."), labels),
+    });
+
+    return s;
+}
+
+void code_region_stats::record(code_region r, scheduling_group sg, clock::duration runtime) noexcept {
+    try {
+        auto& s = get_site(r, sg);
+        s.runtime.add(runtime);
+        ++s.runs;
+        s.max_runtime = std::max(s.max_runtime, runtime);
+
+        if (runtime >= engine().get_blocked_reactor_notify_ms()) {
+            ++s.stalls;
+            static thread_local logger::rate_limit rate_limit(std::chrono::seconds(10));
+            crlog.log(log_level::warn, rate_limit, "Stall of {} ms in {} in scheduling group {}, at {}",
+                    std::chrono::duration_cast<std::chrono::milliseconds>(runtime).count(), to_string(r), sg.name(), current_backtrace());
+        }
+    } catch (...) {
+        // A new site couldn't be created; the run is not accounted.
+    }
+}
+
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/metrics_registration.hh>
+#include "seastarx.hh"
+#include "utils/estimated_histogram.hh"
+
+namespace utils {
+
+// Named regions of code which run long stretches without yielding and are
+// known sources of reactor stalls.
+enum class code_region : uint8_t {
+    cache_update,
+    memtable_flush,
+    compaction,
+    view_update,
+};
+
+const char* to_string(code_region r) noexcept;
+
+/// \brief Per-shard statistics of the time spent in code regions.
+///
+/// Time is accounted per (code region, scheduling group) pair, a "site".
+/// Runs of a site longer than the reactor's blocked notification threshold
+/// (--blocked-reactor-notify-ms) are counted as stalls and logged with
+/// their site, which the reactor's own stall report doesn't tell.
+class code_region_stats {
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct site {
+        code_region region;
+        scheduling_group sg;
+        time_estimated_histogram runtime;
+        uint64_t runs = 0;
+        uint64_t stalls = 0;
+        clock::duration max_runtime = clock::duration::zero();
+    };
+private:
+    // Few sites are ever created, so they're looked up linearly.
+    std::vector<std::unique_ptr<site>> _sites;
+    seastar::metrics::metric_groups _metrics;
+private:
+    site& get_site(code_region r, scheduling_group sg);
+public:
+    void record(code_region r, scheduling_group sg, clock::duration runtime) noexcept;
+
+    const std::vector<std::unique_ptr<site>>& sites() const noexcept {
+        return _sites;
+    }
+
+    static code_region_stats& local() noexcept;
+};
+
+/// \brief Accounts the time until its destruction to a code region.
+///
+/// The time is accounted to the scheduling group current at construction.
+/// The timer is meant to cover a stretch of code which doesn't yield, so that
+/// what it measures is the runtime of a single task; when kept across a
+/// preemption point it measures wall time instead.
+class code_region_timer {
+    code_region _region;
+    scheduling_group _sg;
+    code_region_stats::clock::time_point _start;
+public:
+    explicit code_region_timer(code_region r) noexcept
+        : _region(r)
+        , _sg(current_scheduling_group())
+        , _start(code_region_stats::clock::now())
+    { }
+
+    code_region_timer(const code_region_timer&) = delete;
+    code_region_timer& operator=(const code_region_timer&) = delete;
+
+    ~code_region_timer() {
+        code_region_stats::local().record(_region, _sg, code_region_stats::clock::now() - _start);
+    }
+};
+
+}
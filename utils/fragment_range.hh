@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <array>
 #include <concepts>
 #include <compare>
 #include <boost/range/algorithm/copy.hpp>
@@ -116,6 +117,32 @@ static_assert(FragmentRange<empty_fragment_range>);
 static_assert(FragmentRange<single_fragment_range<mutable_view::no>>);
 static_assert(FragmentRange<single_fragment_range<mutable_view::yes>>);
 
+namespace utils {
+
+// Counts the buffers with_linearized() has to allocate because a value is
+// fragmented. Values small enough to be linearized on the stack aren't counted.
+struct linearization_stats {
+    uint64_t linearizations = 0;
+    uint64_t linearized_bytes = 0;
+};
+
+inline linearization_stats& get_linearization_stats() noexcept {
+    static thread_local linearization_stats stats;
+    return stats;
+}
+
+inline void account_linearization(size_t size) noexcept {
+    auto& stats = get_linearization_stats();
+    ++stats.linearizations;
+    stats.linearized_bytes += size;
+}
+
+}
+
+// Fragmented values up to this size are linearized by with_linearized() into
+// a buffer on the stack rather than into a newly allocated one.
+constexpr size_t max_stack_linearization_size = 256;
+
 template<typename FragmentedBuffer>
 requires FragmentRange<FragmentedBuffer>
 bytes linearized(const FragmentedBuffer& buffer)
@@ -138,7 +165,15 @@ decltype(auto) with_linearized(const FragmentedBuffer& buffer, Function&& fn)
     bytes_view bv;
     if (__builtin_expect(!buffer.empty() && std::next(buffer.begin()) == buffer.end(), true)) {
         bv = *buffer.begin();
-    } else if (!buffer.empty()) {
+    } else if (buffer.size_bytes() <= max_stack_linearization_size) {
+        std::array<bytes_view::value_type, max_stack_linearization_size> stack_buffer;
+        auto dst = stack_buffer.begin();
+        for (bytes_view fragment : buffer) {
+            dst = std::copy(fragment.begin(), fragment.end(), dst);
+        }
+        return fn(bytes_view(stack_buffer.data(), buffer.size_bytes()));
+    } else {
+        utils::account_linearization(buffer.size_bytes());
         b = linearized(buffer);
         bv = b;
     }
@@ -228,7 +263,15 @@ decltype(auto) with_linearized(const View& v, Function&& fn)
 {
     if (v.size_bytes() == v.current_fragment().size()) [[likely]] {
         return fn(v.current_fragment());
+    } else if (v.size_bytes() <= max_stack_linearization_size) {
+        std::array<bytes_view::value_type, max_stack_linearization_size> stack_buffer;
+        auto out = stack_buffer.begin();
+        for (View rest = v; rest.size_bytes(); rest.remove_current()) {
+            out = std::copy(rest.current_fragment().begin(), rest.current_fragment().end(), out);
+        }
+        return fn(bytes_view(stack_buffer.data(), v.size_bytes()));
     } else {
+        utils::account_linearization(v.size_bytes());
         return fn(linearized(v));
     }
 }
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2022-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+#include "utils/chunked_vector.hh"
+
+namespace utils {
+
+// A count-min sketch of 4-bit counters estimating how often keys were recently seen,
+// as used by the TinyLFU cache admission policy.
+//
+// Each key is counted in 4 counters picked by independent hashes and its estimate is
+// the minimum of them, so collisions may only overestimate. Once as many increments
+// as 10 times the number of counters were recorded, all counters are halved, so that
+// the estimate reflects recent history and keys which stopped being used age out.
+class frequency_sketch {
+    static constexpr unsigned hashes = 4;
+    static constexpr unsigned counters_per_word = 16;
+    static constexpr uint64_t max_count = 15;
+
+    utils::chunked_vector<uint64_t> _table;
+    uint64_t _counter_mask;
+    uint64_t _sample_size;
+    uint64_t _additions = 0;
+private:
+    static uint64_t mix(uint64_t x) noexcept {
+        // splitmix64 finalizer
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        x ^= x >> 31;
+        return x;
+    }
+
+    uint64_t counter_index(uint64_t hash, unsigned i) const noexcept {
+        return mix(hash + i * 0x9e3779b97f4a7c15ull) & _counter_mask;
+    }
+
+    uint64_t get(uint64_t idx) const noexcept {
+        return (_table[idx / counters_per_word] >> (idx % counters_per_word * 4)) & max_count;
+    }
+
+    void reset() noexcept {
+        for (auto& w : _table) {
+            w = (w >> 1) & 0x7777777777777777ull;
+        }
+        _additions /= 2;
+    }
+public:
+    // Sized to count about `expected_keys` distinct keys.
+    explicit frequency_sketch(size_t expected_keys)
+        : _counter_mask(std::bit_ceil(std::max<uint64_t>(expected_keys, counters_per_word)) - 1)
+        , _sample_size((_counter_mask + 1) * 10)
+    {
+        _table.resize((_counter_mask + 1) / counters_per_word);
+    }
+
+    // Records an occurrence of the key with the given hash and returns the new estimate.
+    unsigned increment(uint64_t hash) noexcept {
+        uint64_t estimate = max_count;
+        for (unsigned i = 0; i < hashes; ++i) {
+            auto idx = counter_index(hash, i);
+            auto shift = idx % counters_per_word * 4;
+            auto& w = _table[idx / counters_per_word];
+            auto c = (w >> shift) & max_count;
+            if (c < max_count) {
+                w += uint64_t(1) << shift;
+                ++c;
+            }
+            estimate = std::min(estimate, c);
+        }
+        if (++_additions == _sample_size) {
+            reset();
+        }
+        return estimate;
+    }
+
+    unsigned estimate(uint64_t hash) const noexcept {
+        uint64_t estimate = max_count;
+        for (unsigned i = 0; i < hashes; ++i) {
+            estimate = std::min(estimate, get(counter_index(hash, i)));
+        }
+        return estimate;
+    }
+
+    size_t memory_usage() const noexcept {
+        return _table.size() * sizeof(uint64_t);
+    }
+};
+
+}
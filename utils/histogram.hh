@@ -9,9 +9,12 @@
 #pragma once
 
 #include <boost/circular_buffer.hpp>
+#include <boost/intrusive/list.hpp>
 #include "latency.hh"
 #include <cmath>
 #include <seastar/core/timer.hh>
+#include <seastar/core/later.hh>
+#include <seastar/core/preempt.hh>
 #include <iosfwd>
 #include "seastarx.hh"
 #include "estimated_histogram.hh"
@@ -206,20 +209,115 @@ using ihistogram = basic_ihistogram<std::chrono::microseconds>;
  *
  * To make an object use a timer, include an instance of this
  * class and set a handler at its constructor.
+ *
+ * All meters of a shard are driven by a single periodic timer, so that
+ * objects which are instantiated many times, like the statistics of every
+ * table, don't each add timers to the reactor. The timer's task yields
+ * when preempted, so that ticking many meters doesn't stall the reactor.
  */
-class meter_timer {
+class meter_timer : public boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
+    struct ticker;
+    static ticker& local_ticker() noexcept;
+
+    struct cursor_tag {};
+    explicit meter_timer(cursor_tag) noexcept {}
+
     std::function<void()> _fun;
-    timer<> _timer;
 public:
     static constexpr latency_counter::duration tick_interval() {
         return std::chrono::seconds(10);
     }
 
-    meter_timer(std::function<void()>&& fun) : _fun(std::move(fun)), _timer(_fun) {
-        _timer.arm_periodic(tick_interval());
+    meter_timer(std::function<void()>&& fun);
+    meter_timer(meter_timer&& o) noexcept : meter_timer(std::move(o._fun)) {}
+    meter_timer(const meter_timer&) = delete;
+    meter_timer& operator=(const meter_timer&) = delete;
+    ~meter_timer();
+
+    // The number of meters of this shard.
+    static size_t registered() noexcept;
+    // Whether the timer of this shard's meters is armed.
+    static bool armed() noexcept;
+    // Calls the handlers of all meters of this shard, as the timer does.
+    // Resolves immediately if a tick is already in progress.
+    static future<> tick();
+};
+
+struct meter_timer::ticker {
+    using list_type = boost::intrusive::list<meter_timer, boost::intrusive::constant_time_size<false>>;
+    list_type meters;
+    bool ticking = false;
+    timer<> tick_timer{[this] {
+        (void)tick();
+    }};
+    // Linked in front of the next meter to tick while a tick is preempted,
+    // so that meters may be added and removed meanwhile. Declared last, so
+    // that it is destroyed while the list and the timer still exist.
+    meter_timer cursor{cursor_tag{}};
+
+    future<> tick() {
+        if (ticking) {
+            return make_ready_future<>();
+        }
+        ticking = true;
+        return run(meters.begin()).finally([this] {
+            ticking = false;
+        });
+    }
+
+    future<> run(list_type::iterator it) {
+        while (it != meters.end()) {
+            auto& m = *it++;
+            if (m._fun) {
+                m._fun();
+            }
+            if (it != meters.end() && need_preempt()) {
+                meters.insert(it, cursor);
+                return seastar::yield().then([this] {
+                    auto it = std::next(meters.iterator_to(cursor));
+                    cursor.unlink();
+                    return run(it);
+                });
+            }
+        }
+        return make_ready_future<>();
     }
 };
 
+inline meter_timer::ticker& meter_timer::local_ticker() noexcept {
+    static thread_local ticker t;
+    return t;
+}
+
+inline meter_timer::meter_timer(std::function<void()>&& fun) : _fun(std::move(fun)) {
+    auto& t = local_ticker();
+    t.meters.push_back(*this);
+    if (!t.tick_timer.armed()) {
+        t.tick_timer.arm_periodic(tick_interval());
+    }
+}
+
+inline meter_timer::~meter_timer() {
+    unlink();
+    auto& t = local_ticker();
+    if (t.meters.empty() || (t.cursor.is_linked() && t.meters.size() == 1)) {
+        t.tick_timer.cancel();
+    }
+}
+
+inline size_t meter_timer::registered() noexcept {
+    auto& t = local_ticker();
+    return t.meters.size() - t.cursor.is_linked();
+}
+
+inline bool meter_timer::armed() noexcept {
+    return local_ticker().tick_timer.armed();
+}
+
+inline future<> meter_timer::tick() {
+    return local_ticker().tick();
+}
+
 struct rate_moving_average {
     uint64_t count = 0;
     double rates[3] = {0};
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <cerrno>
+#include <mutex>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#include <seastar/core/metrics.hh>
+#include "utils/hw_counters.hh"
+#include "log.hh"
+
+static logging::logger hwlog("hw_counters");
+
+namespace utils {
+
+// The reactor uses the first few real-time signals for its timers and the
+// stall detector.
+static int sample_signal() {
+    return SIGRTMIN + 8;
+}
+
+static thread_local hw_counter_sampler* local_sampler = nullptr;
+
+static const char* counter_name(hw_counter_sampler::counter c) {
+    switch (c) {
+    case hw_counter_sampler::counter::cycles: return "cycles";
+    case hw_counter_sampler::counter::instructions: return "instructions";
+    case hw_counter_sampler::counter::cache_misses: return "cache_misses";
+    case hw_counter_sampler::counter::branch_misses: return "branch_misses";
+    }
+    std::abort();
+}
+
+static int open_event(uint64_t config, uint64_t sample_period, int group_fd) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group_fd == -1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    if (sample_period) {
+        attr.sample_period = sample_period;
+        attr.wakeup_events = 1;
+    }
+    return ::syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+}
+
+hw_counter_sampler::hw_counter_sampler(uint64_t sample_cycles)
+        : _sample_cycles(sample_cycles)
+        , _register_timer([this] { register_metrics(); }) {
+    _fds.fill(-1);
+}
+
+hw_counter_sampler::~hw_counter_sampler() {
+    assert(!_enabled);
+}
+
+future<> hw_counter_sampler::start() {
+    static std::once_flag install_handler;
+    std::call_once(install_handler, [] {
+        struct sigaction sa{};
+        sa.sa_sigaction = &hw_counter_sampler::on_signal;
+        sa.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&sa.sa_mask);
+        ::sigaction(sample_signal(), &sa, nullptr);
+    });
+
+    static constexpr std::array<uint64_t, nr_counters> configs = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES,
+    };
+    for (size_t i = 0; i < nr_counters; ++i) {
+        _fds[i] = open_event(configs[i], i == 0 ? _sample_cycles : 0, i == 0 ? -1 : _fds[0]);
+        if (_fds[i] == -1) {
+            hwlog.warn("Cannot open the {} perf event, hardware counters won't be sampled: {}", counter_name(counter(i)), strerror(errno));
+            for (auto& fd : _fds) {
+                if (fd != -1) {
+                    ::close(fd);
+                    fd = -1;
+                }
+            }
+            return make_ready_future<>();
+        }
+    }
+
+    // Overflows of the leader are signalled to this thread only.
+    f_owner_ex owner{F_OWNER_TID, static_cast<pid_t>(::syscall(SYS_gettid))};
+    ::fcntl(_fds[0], F_SETFL, ::fcntl(_fds[0], F_GETFL) | O_ASYNC);
+    ::fcntl(_fds[0], F_SETSIG, sample_signal());
+    ::fcntl(_fds[0], F_SETOWN_EX, &owner);
+
+    local_sampler = this;
+    _enabled = true;
+
+    // Seastar blocks all signals it doesn't handle itself in reactor
+    // threads, so the sample signal has to be unblocked on each shard.
+    sigset_t mask;
+    sigemptyset(&mask);
+    sigaddset(&mask, sample_signal());
+    ::pthread_sigmask(SIG_UNBLOCK, &mask, nullptr);
+
+    // Without a ring buffer, the kernel only signals an overflow when it
+    // disables the leader after the last overflow it was refreshed for.
+    // Arm a single overflow here; sample() arms the next one each time.
+    ::ioctl(_fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(_fds[0], PERF_EVENT_IOC_REFRESH, 1);
+
+    register_metrics();
+    _register_timer.arm_periodic(std::chrono::seconds(10));
+    return make_ready_future<>();
+}
+
+future<> hw_counter_sampler::stop() {
+    _register_timer.cancel();
+    if (_enabled) {
+        ::ioctl(_fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        sigset_t mask;
+        sigemptyset(&mask);
+        sigaddset(&mask, sample_signal());
+        ::pthread_sigmask(SIG_BLOCK, &mask, nullptr);
+        local_sampler = nullptr;
+        _enabled = false;
+        for (auto& fd : _fds) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    return make_ready_future<>();
+}
+
+void hw_counter_sampler::on_signal(int, siginfo_t*, void*) noexcept {
+    // The signal may interrupt code between a failed call and its check of errno,
+    // which the read() and ioctl() of sample() would overwrite.
+    const int saved_errno = errno;
+    if (local_sampler) {
+        local_sampler->sample();
+    }
+    errno = saved_errno;
+}
+
+// Runs in the signal handler, so only async signal safe calls are allowed.
+void hw_counter_sampler::sample() noexcept {
+    struct {
+        uint64_t nr;
+        uint64_t values[nr_counters];
+    } data;
+    if (::read(_fds[0], &data, sizeof(data)) == sizeof(data)) {
+        auto& counts = _counts[internal::scheduling_group_index(current_scheduling_group())];
+        for (size_t i = 0; i < nr_counters; ++i) {
+            counts[i].fetch_add(data.values[i] - _last[i], std::memory_order_relaxed);
+            _last[i] = data.values[i];
+        }
+    }
+    // The leader was disabled by the overflow which raised the signal;
+    // re-enable it for the next one.
+    ::ioctl(_fds[0], PERF_EVENT_IOC_REFRESH, 1);
+    _samples.fetch_add(1, std::memory_order_relaxed);
+}
+
+hw_counter_sampler::counts hw_counter_sampler::get(scheduling_group sg) const noexcept {
+    counts ret;
+    auto& c = _counts[internal::scheduling_group_index(sg)];
+    for (size_t i = 0; i < nr_counters; ++i) {
+        ret[i] = c[i].load(std::memory_order_relaxed);
+    }
+    return ret;
+}
+
+// Scheduling groups can be created at any time, and only get metrics once
+// they have been sampled.
+void hw_counter_sampler::register_metrics() {
+    namespace sm = seastar::metrics;
+    static const sm::label scheduling_group_label("scheduling_group_name");
+
+    for (unsigned idx = 0; idx < max_scheduling_groups(); ++idx) {
+        if (_registered[idx] || !_counts[idx][size_t(counter::cycles)].load(std::memory_order_relaxed)) {
+            continue;
+        }
+        _registered[idx] = true;
+        auto sg = internal::scheduling_group_from_index(idx);
+        std::vector<sm::label_instance> labels{scheduling_group_label(sg.name())};
+        auto make = [&] (counter c, const char* description) {
+            return sm::make_counter(counter_name(c), [this, idx, c] { return _counts[idx][size_t(c)].load(std::memory_order_relaxed); },
+                    sm::description(description), labels);
+        };
+        _metrics.add_group("hw_counters", {
+            make(counter::cycles, "Sampled user space CPU cycles spent in the scheduling group."),
+            make(counter::instructions, "Sampled user space instructions retired in the scheduling group."),
+            make(counter::cache_misses, "Sampled last level cache misses in the scheduling group."),
+            make(counter::branch_misses, "Sampled mispredicted branches in the scheduling group."),
+        });
+    }
+}
+
+}
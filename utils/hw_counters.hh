@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <csignal>
+#include <seastar/core/future.hh>
+#include <seastar/core/scheduling.hh>
+#include <seastar/core/timer.hh>
+#include <seastar/core/lowres_clock.hh>
+#include <seastar/core/metrics_registration.hh>
+#include "seastarx.hh"
+
+namespace utils {
+
+/// \brief Samples hardware performance counters per scheduling group.
+///
+/// A group of perf events counts the user space cycles, instructions, cache
+/// misses and branch misses of the shard's thread. Every sample_cycles cycles
+/// the cycles counter overflows and the kernel signals the thread. The signal
+/// handler reads the counters and adds what was counted since the previous
+/// sample to the scheduling group which is running at that moment. With a
+/// period well below the task quota, most of what a sample is attributed to
+/// a group was indeed counted while that group ran.
+///
+/// The counts are exported as metrics labeled with the scheduling group, so
+/// that e.g. cache misses of the statement group can be compared to those of
+/// compaction.
+///
+/// Opening perf events may be forbidden by kernel.perf_event_paranoid or
+/// unsupported in virtual machines, in which case start() logs a warning and
+/// the sampler stays idle.
+class hw_counter_sampler {
+public:
+    enum class counter : uint8_t {
+        cycles,
+        instructions,
+        cache_misses,
+        branch_misses,
+    };
+    static constexpr size_t nr_counters = 4;
+    using counts = std::array<uint64_t, nr_counters>;
+private:
+    uint64_t _sample_cycles;
+    // File descriptors of the events, the cycles counter leading the group.
+    std::array<int, nr_counters> _fds;
+    bool _enabled = false;
+    // Written by the signal handler, read by metrics.
+    std::array<std::array<std::atomic<uint64_t>, nr_counters>, max_scheduling_groups()> _counts = {};
+    counts _last = {};
+    std::atomic<uint64_t> _samples = 0;
+    std::array<bool, max_scheduling_groups()> _registered = {};
+    timer<lowres_clock> _register_timer;
+    seastar::metrics::metric_groups _metrics;
+private:
+    void sample() noexcept;
+    void register_metrics();
+    static void on_signal(int, siginfo_t*, void*) noexcept;
+public:
+    explicit hw_counter_sampler(uint64_t sample_cycles);
+    ~hw_counter_sampler();
+
+    // Opens the events and starts sampling on the current shard.
+    future<> start();
+    future<> stop();
+
+    counts get(scheduling_group sg) const noexcept;
+
+    // Whether the events could be opened by start().
+    bool enabled() const noexcept { return _enabled; }
+    // Number of overflow signals handled so far.
+    uint64_t samples() const noexcept { return _samples.load(std::memory_order_relaxed); }
+};
+
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2026-present ScyllaDB
+ */
+
+/*
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <seastar/core/shared_ptr.hh>
+#include "seastarx.hh"
+
+namespace utils {
+
+/// \brief Batches of concurrent operations which later operations may join.
+///
+/// An operation looks for a batch it can join with find(). If there is none,
+/// it starts one with add(), and holds the returned registration for as long
+/// as other operations may join the batch. Releasing or destroying the
+/// registration removes the batch from the set, e.g. once it is executed.
+///
+/// Batches are looked up by key, e.g. the token of the partition, and then
+/// matched with a predicate, so batches which can't be joined together may
+/// share a key.
+template <typename Key, typename Batch, typename Hash = std::hash<Key>>
+class joinable_batches {
+    std::unordered_multimap<Key, lw_shared_ptr<Batch>, Hash> _batches;
+public:
+    class registration {
+        joinable_batches* _batches = nullptr;
+        std::optional<Key> _key;
+        const Batch* _batch = nullptr;
+    public:
+        registration() = default;
+        registration(joinable_batches& batches, Key key, const Batch& batch) noexcept
+            : _batches(&batches), _key(std::move(key)), _batch(&batch) {}
+        registration(registration&& o) noexcept
+            : _batches(std::exchange(o._batches, nullptr)), _key(std::move(o._key)), _batch(o._batch) {}
+        registration& operator=(registration&& o) noexcept {
+            if (this != &o) {
+                release();
+                _batches = std::exchange(o._batches, nullptr);
+                _key = std::move(o._key);
+                _batch = o._batch;
+            }
+            return *this;
+        }
+        ~registration() {
+            release();
+        }
+        // Stops the batch from being joined.
+        void release() noexcept {
+            if (auto batches = std::exchange(_batches, nullptr)) {
+                batches->remove(*_key, _batch);
+            }
+        }
+    };
+
+    // Returns the batch of the key for which pred returns true, if any.
+    template <typename Pred>
+    lw_shared_ptr<Batch> find(const Key& key, Pred&& pred) const {
+        auto [begin, end] = _batches.equal_range(key);
+        for (auto it = begin; it != end; ++it) {
+            if (pred(*it->second)) {
+                return it->second;
+            }
+        }
+        return nullptr;
+    }
+
+    [[nodiscard]] registration add(Key key, lw_shared_ptr<Batch> batch) {
+        auto& b = *batch;
+        _batches.emplace(key, std::move(batch));
+        return registration(*this, std::move(key), b);
+    }
+
+    size_t size() const noexcept {
+        return _batches.size();
+    }
+private:
+    void remove(const Key& key, const Batch* batch) noexcept {
+        auto [begin, end] = _batches.equal_range(key);
+        for (auto it = begin; it != end; ++it) {
+            if (it->second.get() == batch) {
+                _batches.erase(it);
+                return;
+            }
+        }
+    }
+};
+
+}
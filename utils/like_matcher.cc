@@ -13,6 +13,8 @@
 #include <boost/regex/icu.hpp>
 #include <boost/locale/encoding.hpp>
 #include <string>
+#include <cstring>
+#include "utils/utf8.hh"
 
 namespace {
 
@@ -75,33 +77,100 @@ wstring regex_from_pattern(bytes_view pattern) {
     return re;
 }
 
+/// Splits a pattern without unescaped '_' into the literals between its unescaped '%'s, with escapes
+/// removed.  Returns nullopt if the pattern has an unescaped '_'.
+///
+/// Works on bytes rather than code points: neither '\', '%' nor '_' can be a part of a multi-byte
+/// UTF-8 sequence, and escaping the first byte of a sequence has the same effect as escaping the code
+/// point.
+std::optional<std::vector<bytes>> segments_from_pattern(bytes_view pattern) {
+    std::vector<bytes> segments(1);
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        auto c = pattern[i];
+        if (c == '\\') {
+            // A trailing backslash matches itself.
+            if (i + 1 < pattern.size()) {
+                c = pattern[++i];
+            }
+        } else if (c == '%') {
+            segments.emplace_back();
+            continue;
+        } else if (c == '_') {
+            return std::nullopt;
+        }
+        segments.back().append(&c, 1);
+    }
+    return segments;
+}
+
+/// Whether text matches a LIKE pattern consisting of the given literals separated by '%'.
+bool match_segments(const std::vector<bytes>& segments, bytes_view text) {
+    const bytes& first = segments.front();
+    if (segments.size() == 1) {
+        return text == first;
+    }
+    const bytes& last = segments.back();
+    if (text.size() < first.size() + last.size()
+            || text.substr(0, first.size()) != first
+            || text.substr(text.size() - last.size()) != last) {
+        return false;
+    }
+    // The middle literals can be matched greedily: taking the leftmost occurrence of each leaves the
+    // most room for the ones after it.
+    auto rest = text.substr(first.size(), text.size() - first.size() - last.size());
+    for (size_t i = 1; i < segments.size() - 1; ++i) {
+        const bytes& s = segments[i];
+        if (s.empty()) {
+            continue;
+        }
+        auto found = static_cast<const int8_t*>(::memmem(rest.data(), rest.size(), s.data(), s.size()));
+        if (!found) {
+            return false;
+        }
+        rest.remove_prefix(found - rest.data() + s.size());
+    }
+    return true;
+}
+
 } // anonymous namespace
 
 class like_matcher::impl {
     bytes _pattern;
+    // Set if the pattern has no '_' wildcard, in which case it's matched by looking for the literals
+    // between its '%'s, which is much cheaper than running the regex.
+    std::optional<std::vector<bytes>> _segments;
     boost::u32regex _re; // Performs pattern matching.
   public:
     explicit impl(bytes_view pattern);
     bool operator()(bytes_view text) const;
     void reset(bytes_view pattern);
   private:
-    void init_re() {
-        _re = boost::make_u32regex(regex_from_pattern(_pattern), boost::u32regex::basic | boost::u32regex::optimize);
+    void init() {
+        // An invalid pattern is rejected by the regex conversion.
+        _segments = utils::utf8::validate(_pattern) ? segments_from_pattern(_pattern) : std::nullopt;
+        if (_segments) {
+            _re = boost::u32regex();
+        } else {
+            _re = boost::make_u32regex(regex_from_pattern(_pattern), boost::u32regex::basic | boost::u32regex::optimize);
+        }
     }
 };
 
 like_matcher::impl::impl(bytes_view pattern) : _pattern(pattern) {
-    init_re();
+    init();
 }
 
 bool like_matcher::impl::operator()(bytes_view text) const {
+    if (_segments) {
+        return match_segments(*_segments, text);
+    }
     return boost::u32regex_match(text.begin(), text.end(), _re);
 }
 
 void like_matcher::impl::reset(bytes_view pattern) {
     if (pattern != _pattern) {
         _pattern = bytes(pattern);
-        init_re();
+        init();
     }
 }
 
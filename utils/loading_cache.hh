@@ -398,6 +398,23 @@ class loading_cache {
         });
     }
 
+    // Like remove_if() above, but the predicate is given the key of each value too.
+    // Values whose loading is still in progress are all removed, whatever their key.
+    template <typename Pred>
+    requires std::is_invocable_r_v<bool, Pred, const Key&, const value_type&>
+    void remove_if(Pred&& pred) {
+        auto cond_pred = [&pred] (const ts_value_lru_entry& v) {
+            return pred(v.key(), v.timestamped_value().value());
+        };
+        auto value_destroyer = [] (ts_value_lru_entry* p) {
+            loading_cache::destroy_ts_value(p);
+        };
+
+        _unprivileged_lru_list.remove_and_dispose_if(cond_pred, value_destroyer);
+        _lru_list.remove_and_dispose_if(cond_pred, value_destroyer);
+        _loading_values.remove_if([] (const timestamped_val&) { return false; });
+    }
+
     // Removes a given key from the cache.
     // The key is removed immediately.
     // After this, get_ptr() is guaranteed to reload the value before returning it.
@@ -718,6 +735,19 @@ class loading_cache<Key, Tp, SectionHitThreshold, ReloadEnabled, EntrySize, Hash
     value_type& operator*() const noexcept { return _ts_val_ptr->value(); }
     value_type* operator->() const noexcept { return &_ts_val_ptr->value(); }
 
+    /// \brief Whether the value is still in the cache.
+    ///
+    /// A value_ptr keeps the value alive after it is evicted or removed from the cache,
+    /// this tells whether that happened since the value_ptr was obtained.
+    bool cached() const noexcept { return _ts_val_ptr && _ts_val_ptr->ready(); }
+
+    /// \brief Marks the value as read, as a cache lookup would.
+    void touch() const noexcept {
+        if (_ts_val_ptr) {
+            _ts_val_ptr->touch();
+        }
+    }
+
     friend std::ostream& operator<<(std::ostream& os, const value_ptr& vp) {
         return os << vp._ts_val_ptr;
     }
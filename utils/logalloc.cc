@@ -37,6 +37,7 @@
 
 #include <random>
 #include <chrono>
+#include <sys/mman.h>
 
 using namespace std::chrono_literals;
 
@@ -364,18 +365,31 @@ using clock = std::chrono::steady_clock;
 class background_reclaimer {
     scheduling_group _sg;
     noncopyable_function<void (size_t target)> _reclaim;
+    noncopyable_function<bool ()> _defragment;
     timer<lowres_clock> _adjust_shares_timer;
     // If engaged, main loop is not running, set_value() to wake it.
     promise<>* _main_loop_wait = nullptr;
     future<> _done;
     bool _stopping = false;
+    bool _defragmenting = false;
     static constexpr size_t free_memory_threshold = 60'000'000;
+    // Below this much free memory, segments are compacted in advance of reclaim becoming necessary,
+    // so that reclaim on the allocation path finds free segments rather than having to compact them.
+    static constexpr size_t defragment_free_memory_threshold = 2 * free_memory_threshold;
+    static constexpr unsigned defragment_shares = 10;
 private:
     bool have_work() const {
 #ifndef SEASTAR_DEFAULT_ALLOCATOR
         return memory::stats().free_memory() < free_memory_threshold;
 #else
         return false;
+#endif
+    }
+    bool want_defragment() const {
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+        return _defragment && memory::stats().free_memory() < defragment_free_memory_threshold;
+#else
+        return false;
 #endif
     }
     void main_loop_wake() {
@@ -388,7 +402,7 @@ class background_reclaimer {
     future<> main_loop() {
         llogger.debug("background_reclaimer::main_loop: entry");
         while (true) {
-            while (!_stopping && !have_work()) {
+            while (!_stopping && !have_work() && !_defragmenting) {
                 promise<> wait;
                 _main_loop_wait = &wait;
                 llogger.trace("background_reclaimer::main_loop: sleep");
@@ -399,7 +413,12 @@ class background_reclaimer {
             if (_stopping) {
                 break;
             }
-            _reclaim(free_memory_threshold - memory::stats().free_memory());
+            if (have_work()) {
+                _reclaim(free_memory_threshold - memory::stats().free_memory());
+            } else if (!want_defragment() || !_defragment()) {
+                // Wait for the next adjustment, rather than spin, when there's no sparse segment left.
+                _defragmenting = false;
+            }
             co_await coroutine::maybe_yield();
         }
         llogger.debug("background_reclaimer::main_loop: exit");
@@ -412,12 +431,22 @@ class background_reclaimer {
             if (_main_loop_wait) {
                 main_loop_wake();
             }
+        } else if (want_defragment()) {
+            _sg.set_shares(defragment_shares);
+            _defragmenting = true;
+            if (_main_loop_wait) {
+                main_loop_wake();
+            }
         }
     }
 public:
-    explicit background_reclaimer(scheduling_group sg, noncopyable_function<void (size_t target)> reclaim)
+    // If `defragment` is given, it is called when free memory is getting low, but not yet
+    // low enough for reclaim, to compact sparse segments. It returns false when it found none.
+    explicit background_reclaimer(scheduling_group sg, noncopyable_function<void (size_t target)> reclaim,
+            noncopyable_function<bool ()> defragment = {})
             : _sg(sg)
             , _reclaim(std::move(reclaim))
+            , _defragment(std::move(defragment))
             , _adjust_shares_timer(default_scheduling_group(), [this] { adjust_shares(); })
             , _done(with_scheduling_group(_sg, [this] { return main_loop(); })) {
         if (sg != default_scheduling_group()) {
@@ -476,6 +505,10 @@ class tracker::impl {
     // Compacts one segment at a time from sparsest segment to least sparse until work_waiting_on_reactor returns true
     // or there are no more segments to compact.
     idle_cpu_handler_result compact_on_idle(work_waiting_on_reactor check_for_work);
+    // Compacts segments whose occupancy is at most max_defragment_occupancy, sparsest first, until
+    // preempted. Cheaper than compaction on the allocation path, since each compacted segment
+    // frees more than half a segment. Returns false if there were no such segments.
+    bool defragment();
     // Releases whole segments back to the segment pool.
     // After the call, if there is enough evictable memory, the amount of free segments in the pool
     // will be at least reserve_segments + div_ceil(bytes, segment::size).
@@ -492,11 +525,15 @@ class tracker::impl {
     // Abort on allocation failure from LSA
     void enable_abort_on_bad_alloc() noexcept { _abort_on_bad_alloc = true; }
     bool should_abort_on_bad_alloc() const noexcept { return _abort_on_bad_alloc; }
-    void setup_background_reclaim(scheduling_group sg) {
+    void setup_background_reclaim(scheduling_group sg, bool defragment) {
         assert(!_background_reclaimer);
+        noncopyable_function<bool ()> defragment_fn;
+        if (defragment) {
+            defragment_fn = [this] { return this->defragment(); };
+        }
         _background_reclaimer.emplace(sg, [this] (size_t target) {
             reclaim(target, is_preemptible::yes);
-        });
+        }, std::move(defragment_fn));
     }
 private:
     // Like compact_and_evict() but assumes that reclaim_lock is held around the operation.
@@ -546,6 +583,10 @@ void tracker::full_compaction() {
     return _impl->full_compaction();
 }
 
+bool tracker::defragment() {
+    return _impl->defragment();
+}
+
 void tracker::reclaim_all_free_segments() {
     return _impl->reclaim_all_free_segments();
 }
@@ -587,6 +628,9 @@ struct alignas(segment_size) segment {
 static constexpr size_t max_managed_object_size = segment_size * 0.1;
 static constexpr auto max_used_space_ratio_for_compaction = 0.85;
 static constexpr size_t max_used_space_for_compaction = segment_size * max_used_space_ratio_for_compaction;
+// Background defragmentation only compacts segments at most this full, so that it frees
+// at least half a segment for each segment it copies.
+static constexpr float max_defragment_occupancy = 0.5;
 static constexpr size_t min_free_space_for_compaction = segment_size - max_used_space_for_compaction;
 
 struct [[gnu::packed]] non_lsa_object_cookie {
@@ -781,6 +825,8 @@ class segment_pool {
     size_t _emergency_reserve_max = 30;
     bool _allocation_failure_flag = false;
     bool _allocation_enabled = true;
+    // Huge pages already advised for LSA memory, by index of the huge page in the segment store.
+    std::optional<utils::dynamic_bitset> _advised_huge_pages;
 
     struct allocation_lock {
         segment_pool& _pool;
@@ -831,8 +877,13 @@ class segment_pool {
         return _allocation_enabled && _store.can_allocate_more_segments();
     }
     bool compact_segment(segment* seg);
+    void advise_huge_page(segment* seg) noexcept;
 public:
     segment_pool();
+    // Asks the kernel to back LSA memory with transparent huge pages, which reduces TLB misses of
+    // walks over data structures spanning many segments, like the row cache. Applies to segments
+    // which are already LSA-owned and to those allocated later.
+    void enable_huge_pages();
     void prime(size_t available_memory, size_t min_free_memory);
     segment* new_segment(region::impl* r);
     const segment_descriptor& descriptor(const segment* seg) const noexcept {
@@ -1111,6 +1162,7 @@ segment* segment_pool::allocate_segment(size_t reserve)
             poison(seg, sizeof(segment));
             auto idx = _store.new_idx_for_segment(seg);
             _lsa_owned_segments_bitmap.set(idx);
+            advise_huge_page(seg);
             return seg;
         }
     } while (shard_tracker().get_impl().compact_and_evict(reserve, shard_tracker().reclamation_step() * segment::size, is_preemptible::no));
@@ -1195,6 +1247,36 @@ segment_pool::segment_pool()
 {
 }
 
+static constexpr size_t huge_page_size = 2 << 20;
+static constexpr size_t segments_per_huge_page = std::max<size_t>(huge_page_size / segment::size, 1);
+
+void segment_pool::enable_huge_pages() {
+    _advised_huge_pages.emplace(max_segments() / segments_per_huge_page + 2);
+    for (auto idx = _lsa_owned_segments_bitmap.find_first_set(); idx != utils::dynamic_bitset::npos;
+            idx = _lsa_owned_segments_bitmap.find_next_set(idx)) {
+        advise_huge_page(segment_from_idx(idx));
+    }
+}
+
+void segment_pool::advise_huge_page(segment* seg) noexcept {
+#ifndef SEASTAR_DEFAULT_ALLOCATOR
+    if (!_advised_huge_pages) {
+        return;
+    }
+    auto start = align_down(reinterpret_cast<uintptr_t>(seg), uintptr_t(huge_page_size));
+    auto base = align_down(reinterpret_cast<uintptr_t>(segment_from_idx(0)), uintptr_t(huge_page_size));
+    auto page = (start - base) / huge_page_size;
+    if (_advised_huge_pages->test(page)) {
+        return;
+    }
+    _advised_huge_pages->set(page);
+    // Only advisory, so failure is not an error. The page may also be already backed by hugetlbfs.
+    if (::madvise(reinterpret_cast<void*>(start), huge_page_size, MADV_HUGEPAGE)) {
+        llogger.debug("madvise(MADV_HUGEPAGE) failed for {:#x}: {}", start, errno);
+    }
+#endif
+}
+
 void segment_pool::prime(size_t available_memory, size_t min_free_memory) {
     auto old_emergency_reserve = std::exchange(_emergency_reserve_max, std::numeric_limits<size_t>::max());
     try {
@@ -2136,7 +2218,10 @@ void tracker::configure(const config& cfg) {
     if (cfg.abort_on_lsa_bad_alloc) {
         _impl->enable_abort_on_bad_alloc();
     }
-    _impl->setup_background_reclaim(cfg.background_reclaim_sched_group);
+    _impl->setup_background_reclaim(cfg.background_reclaim_sched_group, cfg.background_defragmentation);
+    if (cfg.huge_pages) {
+        shard_segment_pool.enable_huge_pages();
+    }
     s_sanitizer_report_backtrace = cfg.sanitizer_report_backtrace;
 }
 
@@ -2390,6 +2475,36 @@ idle_cpu_handler_result tracker::impl::compact_on_idle(work_waiting_on_reactor c
     return idle_cpu_handler_result::interrupted_by_higher_priority_task;
 }
 
+bool tracker::impl::defragment() {
+    if (_reclaiming_disabled_depth) {
+        return false;
+    }
+    reclaiming_lock rl(*this);
+    segment_pool::reservation_goal open_emergency_pool(shard_segment_pool, 0);
+
+    auto is_sparse = [] (region::impl* r) {
+        return r->is_compactible() && r->min_occupancy().used_fraction() <= max_defragment_occupancy;
+    };
+    bool found = false;
+    while (true) {
+        region::impl* sparsest = nullptr;
+        for (auto r : _regions) {
+            if (is_sparse(r) && (!sparsest || r->min_occupancy() < sparsest->min_occupancy())) {
+                sparsest = r;
+            }
+        }
+        if (!sparsest) {
+            break;
+        }
+        found = true;
+        sparsest->compact();
+        if (need_preempt()) {
+            break;
+        }
+    }
+    return found;
+}
+
 size_t tracker::impl::reclaim(size_t memory_to_release, is_preemptible preempt) {
     if (_reclaiming_disabled_depth) {
         return 0;
@@ -63,6 +63,10 @@ class tracker {
         bool sanitizer_report_backtrace = false; // Better reports but slower
         size_t lsa_reclamation_step;
         scheduling_group background_reclaim_sched_group;
+        // Compact sparse segments in background_reclaim_sched_group when free memory gets low,
+        // before reclaim has to compact on the allocation path.
+        bool background_defragmentation = false;
+        bool huge_pages = false;
     };
 
     void configure(const config& cfg);
@@ -94,6 +98,11 @@ class tracker {
     // Invalidates references to objects in all compactible and evictable regions.
     void full_compaction();
 
+    // Compacts segments of compactible regions which are at most half full, sparsest
+    // first, until preempted. Returns false if there were no such segments.
+    // Invalidates references to objects in all compactible and evictable regions.
+    bool defragment();
+
     void reclaim_all_free_segments();
 
     // Returns aggregate statistics for all pools.
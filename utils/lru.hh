@@ -9,8 +9,11 @@
 #pragma once
 
 #include <boost/intrusive/list.hpp>
+#include <memory>
 #include <seastar/core/memory.hh>
 
+#include "utils/frequency_sketch.hh"
+
 class evictable {
     friend class lru;
     using lru_link_type = boost::intrusive::list_member_hook<
@@ -39,42 +42,140 @@ class evictable {
     }
 };
 
+// LRU of evictable entries.
+//
+// By default a plain LRU. With enable_frequency_admission() it becomes a segmented LRU
+// resistant to scans: entries are added to a probation segment and are promoted to a
+// protected segment once a frequency sketch estimates they were touched often enough.
+// On eviction, the least recently used entry of probation is only admitted to the
+// protected segment, at the expense of the least recently used protected entry, when
+// it is estimated to be used more frequently. Entries read once by a scan thus never
+// push out frequently used ones.
+//
+// The sketch ages its counts, so entries which stopped being used fall below the
+// promotion threshold. The least recently used protected entry is moved back to
+// probation once it does, which bounds the protected segment to the entries the
+// sketch currently counts as frequent; otherwise a shifting hot set would keep
+// growing it, leaving no room for new entries in probation.
+//
+// Entries are identified in the sketch by their address, so an entry moved by LSA
+// compaction starts being counted from scratch. Since the sketch only guides the
+// order of eviction, that is harmless.
 class lru {
 private:
     friend class evictable;
     using lru_type = boost::intrusive::list<evictable,
         boost::intrusive::member_hook<evictable, evictable::lru_link_type, &evictable::_lru_link>,
         boost::intrusive::constant_time_size<false>>; // we need this to have bi::auto_unlink on hooks.
-    lru_type _list;
+    lru_type _list; // probation segment, the only segment when frequency admission is disabled
+    lru_type _protected;
+    std::unique_ptr<utils::frequency_sketch> _sketch;
+    unsigned _promotion_threshold = 0;
+    uint64_t _admissions = 0;
+    uint64_t _demotions = 0;
+private:
+    static uint64_t key_of(const evictable& e) noexcept {
+        return reinterpret_cast<uintptr_t>(&e);
+    }
+
+    static void dispose(lru_type& list) noexcept {
+        list.clear_and_dispose([] (evictable* e) {
+            e->on_evicted();
+        });
+    }
+
+    // Moves the least recently used protected entry back to probation if it's no
+    // longer estimated to be used frequently.
+    void maybe_demote() noexcept {
+        if (_protected.empty()) {
+            return;
+        }
+        evictable& e = _protected.front();
+        if (_sketch->estimate(key_of(e)) < _promotion_threshold) {
+            e.unlink_from_lru();
+            _list.push_back(e);
+            ++_demotions;
+        }
+    }
+
+    evictable& victim() noexcept {
+        if (_sketch) {
+            maybe_demote();
+        }
+        if (_protected.empty()) {
+            return _list.front();
+        }
+        if (_list.empty()) {
+            return _protected.front();
+        }
+        evictable& candidate = _list.front();
+        evictable& victim = _protected.front();
+        if (_sketch->estimate(key_of(candidate)) > _sketch->estimate(key_of(victim))) {
+            candidate.unlink_from_lru();
+            _protected.push_back(candidate);
+            ++_admissions;
+            return victim;
+        }
+        return candidate;
+    }
 public:
     using reclaiming_result = seastar::memory::reclaiming_result;
 
     ~lru() {
-        _list.clear_and_dispose([] (evictable* e) {
-            e->on_evicted();
-        });
+        dispose(_list);
+        dispose(_protected);
+    }
+
+    // Switches to segmented LRU with frequency based admission, see above.
+    // The sketch is sized for `expected_entries`. Entries are promoted to the
+    // protected segment once touched `promotion_threshold` times recently.
+    void enable_frequency_admission(size_t expected_entries, unsigned promotion_threshold = 2) {
+        _sketch = std::make_unique<utils::frequency_sketch>(expected_entries);
+        _promotion_threshold = promotion_threshold;
+    }
+
+    bool frequency_admission_enabled() const noexcept {
+        return bool(_sketch);
+    }
+
+    // Number of probation entries which replaced protected entries.
+    uint64_t admissions() const noexcept {
+        return _admissions;
+    }
+
+    // Number of protected entries moved back to probation.
+    uint64_t demotions() const noexcept {
+        return _demotions;
     }
 
     void remove(evictable& e) noexcept {
-        _list.erase(_list.iterator_to(e));
+        e.unlink_from_lru();
     }
 
+    // Links an entry which is not linked.
     void add(evictable& e) noexcept {
         _list.push_back(e);
     }
 
+    // Records an access of the entry, which doesn't need to be linked,
+    // and makes it the most recently used one.
     void touch(evictable& e) noexcept {
         remove(e);
-        add(e);
+        if (_sketch && _sketch->increment(key_of(e)) >= _promotion_threshold) {
+            maybe_demote();
+            _protected.push_back(e);
+        } else {
+            add(e);
+        }
     }
 
     // Evicts a single element from the LRU
     reclaiming_result evict() noexcept {
-        if (_list.empty()) {
+        if (_list.empty() && _protected.empty()) {
             return reclaiming_result::reclaimed_nothing;
         }
-        evictable& e = _list.front();
-        _list.pop_front();
+        evictable& e = victim();
+        e.unlink_from_lru();
         e.on_evicted();
         return reclaiming_result::reclaimed_something;
     }
@@ -358,7 +358,15 @@ class managed_bytes {
         }
         if (start) {
             return func(bytes_view(start, size));
+        } else if (_u.ptr->size <= max_stack_linearization_size) {
+            std::array<bytes_view::value_type, max_stack_linearization_size> stack_buffer;
+            auto e = stack_buffer.begin();
+            for (auto b = _u.ptr; b; b = b->next) {
+                e = std::copy_n(b->data, b->frag_size, e);
+            }
+            return func(bytes_view(stack_buffer.data(), _u.ptr->size));
         } else {
+            utils::account_linearization(_u.ptr->size);
             auto data = do_linearize_pure();
             return func(bytes_view(data.get(), _u.ptr->size));
         }
@@ -142,40 +142,28 @@ static inline uint64_t getblock(bytes_view key, uint32_t index)
             | (uint64_t(p[7]) << 56);
 }
 
-void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t,2> &result)
-{
-    uint32_t length = key.size();
-    const uint32_t nblocks = length >> 4; // Process as 128-bit blocks.
-
-    uint64_t h1 = seed;
-    uint64_t h2 = seed;
-
-    uint64_t c1 = 0x87c37b91114253d5L;
-    uint64_t c2 = 0x4cf5ad432745937fL;
-
-    //----------
-    // body
-
-    for(uint32_t i = 0; i < nblocks; i++)
-    {
-        uint64_t k1 = getblock(key, i*2+0);
-        uint64_t k2 = getblock(key, i*2+1);
+static constexpr uint64_t c1 = 0x87c37b91114253d5L;
+static constexpr uint64_t c2 = 0x4cf5ad432745937fL;
 
-        k1 *= c1; k1 = rotl64(k1,31); k1 *= c2; h1 ^= k1;
+// Mixes the 16 bytes at the start of block into the state.
+static inline void hash3_block(bytes_view block, uint64_t& h1, uint64_t& h2)
+{
+    uint64_t k1 = getblock(block, 0);
+    uint64_t k2 = getblock(block, 1);
 
-        h1 = rotl64(h1,27); h1 += h2; h1 = h1*5+0x52dce729;
+    k1 *= c1; k1 = rotl64(k1,31); k1 *= c2; h1 ^= k1;
 
-        k2 *= c2; k2  = rotl64(k2,33); k2 *= c1; h2 ^= k2;
+    h1 = rotl64(h1,27); h1 += h2; h1 = h1*5+0x52dce729;
 
-        h2 = rotl64(h2,31); h2 += h1; h2 = h2*5+0x38495ab5;
-    }
+    k2 *= c2; k2  = rotl64(k2,33); k2 *= c1; h2 ^= k2;
 
-    //----------
-    // tail
-
-    // Advance offset to the unprocessed tail of the data.
-    key.remove_prefix(nblocks * 16);
+    h2 = rotl64(h2,31); h2 += h1; h2 = h2*5+0x38495ab5;
+}
 
+// Mixes the unprocessed tail of the data, its last length & 15 bytes, and the
+// length into the state, and returns the hash.
+static inline std::array<uint64_t,2> hash3_finalize(bytes_view key, uint32_t length, uint64_t h1, uint64_t h2)
+{
     uint64_t k1 = 0;
     uint64_t k2 = 0;
 
@@ -214,8 +202,57 @@ void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t,2> &result
     h1 += h2;
     h2 += h1;
 
-    result[0] = h1;
-    result[1] = h2;
+    return {h1, h2};
+}
+
+void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t,2> &result)
+{
+    uint32_t length = key.size();
+    const uint32_t nblocks = length >> 4; // Process as 128-bit blocks.
+
+    uint64_t h1 = seed;
+    uint64_t h2 = seed;
+
+    //----------
+    // body
+
+    for(uint32_t i = 0; i < nblocks; i++)
+    {
+        hash3_block(key.substr(i * 16), h1, h2);
+    }
+
+    //----------
+    // tail
+
+    // Advance offset to the unprocessed tail of the data.
+    key.remove_prefix(nblocks * 16);
+
+    result = hash3_finalize(key, length, h1, h2);
+}
+
+void hash3_x64_128_state::update(bytes_view data)
+{
+    auto buffered = _length & 15;
+    _length += data.size();
+    if (buffered) {
+        auto n = std::min<size_t>(16 - buffered, data.size());
+        std::copy_n(data.begin(), n, _tail + buffered);
+        data.remove_prefix(n);
+        if (buffered + n < 16) {
+            return;
+        }
+        hash3_block(bytes_view(_tail, 16), _h1, _h2);
+    }
+    while (data.size() >= 16) {
+        hash3_block(data, _h1, _h2);
+        data.remove_prefix(16);
+    }
+    std::copy(data.begin(), data.end(), _tail);
+}
+
+std::array<uint64_t,2> hash3_x64_128_state::finalize() const
+{
+    return hash3_finalize(bytes_view(_tail, _length & 15), _length, _h1, _h2);
 }
 
 } // namespace murmur_hash
@@ -139,6 +139,19 @@ void hash3_x64_128(InputIterator in, uint32_t length, uint64_t seed, std::array<
 
 void hash3_x64_128(bytes_view key, uint64_t seed, std::array<uint64_t, 2>& result);
 
+// Computes hash3_x64_128() of data which is passed in pieces. The pieces can
+// be of any size, the result is the hash of their concatenation.
+class hash3_x64_128_state {
+    uint64_t _h1;
+    uint64_t _h2;
+    uint32_t _length = 0;
+    int8_t _tail[16];
+public:
+    explicit hash3_x64_128_state(uint64_t seed) : _h1(seed), _h2(seed) { }
+    void update(bytes_view data);
+    std::array<uint64_t, 2> finalize() const;
+};
+
 } // namespace murmur_hash
 
 } // namespace utils
@@ -352,7 +352,9 @@ internal::validate_partial(const uint8_t *data, size_t len) {
 } // namespace utils
 
 #elif defined(__x86_64__)
-#include <smmintrin.h>
+#include <immintrin.h>
+
+#define arch_target(name) [[gnu::target(name)]]
 
 namespace utils {
 
@@ -413,8 +415,9 @@ alignas(16) static const int8_t s_ef_fe_tbl[] = {
 };
 
 // 5x faster than naive method
+static inline
 partial_validation_results
-internal::validate_partial(const uint8_t *data, size_t len) {
+validate_partial_sse(const uint8_t *data, size_t len) {
     if (len >= 16) {
         __m128i prev_input = _mm_set1_epi8(0);
         __m128i prev_first_len = _mm_set1_epi8(0);
@@ -540,6 +543,129 @@ internal::validate_partial(const uint8_t *data, size_t len) {
     return validate_partial_naive(data, len);
 }
 
+arch_target("default")
+partial_validation_results
+validate_partial_impl(const uint8_t *data, size_t len) {
+    return validate_partial_sse(data, len);
+}
+
+// Shifts the 64 byte concatenation of (input, prev) left by N bytes and
+// returns the upper 32, i.e. the last N bytes of prev followed by input.
+// _mm256_alignr_epi8() works within 128 bit lanes, so the lane crossing
+// bytes are brought in by a permute first.
+template <int N>
+arch_target("avx2")
+static inline __m256i shift_in(__m256i input, __m256i prev) {
+    return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+}
+
+// The range algorithm above on 32 bytes at a time. Blocks of ASCII which
+// don't continue a sequence started in the previous block skip the range
+// checks, text columns are mostly ASCII.
+arch_target("avx2")
+partial_validation_results
+validate_partial_impl(const uint8_t *data, size_t len) {
+    if (len >= 32) {
+        __m256i prev_input = _mm256_setzero_si256();
+        __m256i prev_first_len = _mm256_setzero_si256();
+
+        // Cached tables, the same in both lanes as shuffles don't cross lanes
+        const __m256i first_len_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_first_len_tbl));
+        const __m256i first_range_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_first_range_tbl));
+        const __m256i range_min_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_range_min_tbl));
+        const __m256i range_max_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_range_max_tbl));
+        const __m256i df_ee_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_df_ee_tbl));
+        const __m256i ef_fe_tbl = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i *)s_ef_fe_tbl));
+
+        __m256i error = _mm256_setzero_si256();
+
+        while (len >= 32) {
+            const __m256i input = _mm256_loadu_si256((const __m256i *)data);
+
+            // No byte with the high bit set, and no sequence left open by
+            // the last three bytes of the previous block.
+            const uint32_t open_tail = uint32_t(_mm256_movemask_epi8(_mm256_cmpgt_epi8(prev_first_len, _mm256_setzero_si256()))) >> 29;
+            if (!_mm256_movemask_epi8(input) && !open_tail) {
+                prev_input = input;
+                prev_first_len = _mm256_setzero_si256();
+                data += 32;
+                len -= 32;
+                continue;
+            }
+
+            const __m256i high_nibbles =
+                _mm256_and_si256(_mm256_srli_epi16(input, 4), _mm256_set1_epi8(0x0F));
+
+            __m256i first_len = _mm256_shuffle_epi8(first_len_tbl, high_nibbles);
+
+            __m256i range = _mm256_shuffle_epi8(first_range_tbl, high_nibbles);
+
+            // Second Byte
+            range = _mm256_or_si256(range, shift_in<1>(first_len, prev_first_len));
+
+            // Third Byte
+            __m256i tmp1, tmp2;
+            tmp1 = _mm256_subs_epu8(first_len, _mm256_set1_epi8(1));
+            tmp2 = _mm256_subs_epu8(prev_first_len, _mm256_set1_epi8(1));
+            range = _mm256_or_si256(range, shift_in<2>(tmp1, tmp2));
+
+            // Fourth Byte
+            tmp1 = _mm256_subs_epu8(first_len, _mm256_set1_epi8(2));
+            tmp2 = _mm256_subs_epu8(prev_first_len, _mm256_set1_epi8(2));
+            range = _mm256_or_si256(range, shift_in<3>(tmp1, tmp2));
+
+            // Adjust Second Byte range for special First Bytes(E0,ED,F0,F4)
+            __m256i shift1, pos, range2;
+            shift1 = shift_in<1>(input, prev_input);
+            pos = _mm256_sub_epi8(shift1, _mm256_set1_epi8(0xEF));
+            tmp1 = _mm256_subs_epu8(pos, _mm256_set1_epi8(char(240)));
+            range2 = _mm256_shuffle_epi8(df_ee_tbl, tmp1);
+            tmp2 = _mm256_adds_epu8(pos, _mm256_set1_epi8(112));
+            range2 = _mm256_add_epi8(range2, _mm256_shuffle_epi8(ef_fe_tbl, tmp2));
+
+            range = _mm256_add_epi8(range, range2);
+
+            __m256i minv = _mm256_shuffle_epi8(range_min_tbl, range);
+            __m256i maxv = _mm256_shuffle_epi8(range_max_tbl, range);
+
+            // Check value range, input < minv || input > maxv
+            error = _mm256_or_si256(error, _mm256_cmpgt_epi8(minv, input));
+            error = _mm256_or_si256(error, _mm256_cmpgt_epi8(input, maxv));
+
+            prev_input = input;
+            prev_first_len = first_len;
+
+            data += 32;
+            len -= 32;
+        }
+
+        if (!_mm256_testz_si256(error, error)) {
+            return partial_validation_results{.error = true};
+        }
+
+        // Find previous token (not 80~BF)
+        int32_t token4 = _mm256_extract_epi32(prev_input, 7);
+        const int8_t *token = (const int8_t *)&token4;
+        int lookahead = 0;
+        if (token[3] > (int8_t)0xBF) {
+            lookahead = 1;
+        } else if (token[2] > (int8_t)0xBF) {
+            lookahead = 2;
+        } else if (token[1] > (int8_t)0xBF) {
+            lookahead = 3;
+        }
+        data -= lookahead;
+        len += lookahead;
+    }
+
+    return validate_partial_sse(data, len);
+}
+
+partial_validation_results
+internal::validate_partial(const uint8_t *data, size_t len) {
+    return validate_partial_impl(data, len);
+}
+
 } // namespace utf8
 
 } // namespace utils
@@ -23,6 +23,9 @@ class view_info final {
     // The following fields are used to select base table rows.
     mutable shared_ptr<cql3::statements::select_statement> _select_statement;
     mutable std::optional<query::partition_slice> _partition_slice;
+    // Computed for the base schema version in _affecting_columns_version.
+    mutable std::vector<bool> _affecting_columns;
+    mutable utils::UUID _affecting_columns_version;
     db::view::base_info_ptr _base_info;
 public:
     view_info(const schema& schema, const raw_view_info& raw_view_info);
@@ -52,6 +55,10 @@ class view_info final {
     const column_definition* view_column(const schema& base, column_id base_id) const;
     const column_definition* view_column(const column_definition& base_def) const;
     bool has_base_non_pk_columns_in_view_pk() const;
+    // Regular columns of the base table whose changes may change the view, by
+    // their id: the columns in the view, including virtual ones, and the
+    // columns restricted by its filter.
+    const std::vector<bool>& regular_columns_affecting_view(const schema& base) const;
 
     /// Returns a pointer to the base_dependent_view_info which matches the current
     /// schema of the base table.
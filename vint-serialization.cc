@@ -17,6 +17,13 @@
 #include <limits>
 #include <type_traits>
 
+#ifdef __x86_64__
+#include <x86intrin.h>
+#define arch_target(name) [[gnu::target(name)]]
+#else
+#define arch_target(name)
+#endif
+
 static_assert(-1 == ~0, "Not a twos-complement architecture");
 
 // Accounts for the case that all bits are zero.
@@ -145,3 +152,83 @@ vint_size_type unsigned_vint::serialized_size_from_first_byte(bytes::value_type
     int8_t first_byte_casted = first_byte;
     return 1 + (first_byte_casted >= 0 ? 0 : count_extra_bytes(first_byte_casted));
 }
+
+// Returns the number of decoded values and sets `consumed` to the number of decoded bytes.
+arch_target("default") size_t deserialize_many_impl(const int8_t* src, size_t len, uint64_t* out, size_t n, size_t& consumed) {
+    size_t pos = 0;
+    size_t i = 0;
+    while (i < n && pos < len) {
+        const auto size = unsigned_vint::serialized_size_from_first_byte(src[pos]);
+        if (len - pos < size) {
+            break;
+        }
+        out[i++] = unsigned_vint::deserialize(bytes_view(src + pos, len - pos));
+        pos += size;
+    }
+    consumed = pos;
+    return i;
+}
+
+#ifdef __x86_64__
+
+// Runs of single-byte vints, which are common for small deltas, are found
+// with a vector compare and widened four at a time. Longer vints are decoded
+// with a single unaligned load when there are enough bytes left.
+arch_target("avx2,bmi2") size_t deserialize_many_impl(const int8_t* src, size_t len, uint64_t* out, size_t n, size_t& consumed) {
+    size_t pos = 0;
+    size_t i = 0;
+    while (i < n && pos < len) {
+        if (len - pos >= 32) {
+            // Bits are set for bytes with the most significant bit set, i.e. first bytes of longer vints.
+            const uint32_t long_vints = _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + pos)));
+            const size_t run = std::min<size_t>(long_vints ? __builtin_ctz(long_vints) : 32, n - i);
+            size_t j = 0;
+            for (; j + 4 <= run; j += 4) {
+                int32_t bytes4;
+                std::copy_n(src + pos + j, sizeof(bytes4), reinterpret_cast<int8_t*>(&bytes4));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + j), _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(bytes4)));
+            }
+            for (; j < run; ++j) {
+                out[i + j] = uint8_t(src[pos + j]);
+            }
+            i += run;
+            pos += run;
+            if (run == 32 || i == n) {
+                continue;
+            }
+        }
+
+        const int8_t first_byte = src[pos];
+        if (first_byte >= 0) {
+            out[i++] = uint64_t(first_byte);
+            ++pos;
+            continue;
+        }
+        const auto extra_bytes_size = count_extra_bytes(first_byte);
+        if (len - pos < extra_bytes_size + 1) {
+            break;
+        }
+        if (len - pos < sizeof(uint64_t) + 1) {
+            out[i++] = unsigned_vint::deserialize(bytes_view(src + pos, len - pos));
+        } else {
+            uint64_t value;
+            std::copy_n(src + pos + 1, sizeof(uint64_t), reinterpret_cast<int8_t*>(&value));
+            value = be_to_cpu(value) >> (64 - extra_bytes_size * 8);
+            // The first byte contributes its bits below the length prefix, which is none for 9-byte vints.
+            const uint64_t high = _bzhi_u64(uint8_t(first_byte), 8 - extra_bytes_size);
+            out[i++] = (high << ((extra_bytes_size * 8) % 64)) | value;
+        }
+        pos += extra_bytes_size + 1;
+    }
+    consumed = pos;
+    return i;
+}
+
+#endif
+
+size_t unsigned_vint::deserialize_many(bytes_view& v, std::span<uint64_t> out) {
+    size_t consumed;
+    auto n = deserialize_many_impl(v.data(), v.size(), out.data(), out.size(), consumed);
+    v.remove_prefix(consumed);
+    return n;
+}
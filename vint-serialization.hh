@@ -35,6 +35,7 @@
 #include "bytes.hh"
 
 #include <cstdint>
+#include <span>
 
 using vint_size_type = bytes::size_type;
 
@@ -49,6 +50,11 @@ struct unsigned_vint final {
 
     static value_type deserialize(bytes_view v);
 
+    // Decodes consecutive vints from the front of `v` into `out`, stopping when `out` is full
+    // or at the first vint which is not entirely contained in `v`. The decoded bytes are
+    // removed from `v`. Returns the number of decoded values.
+    static size_t deserialize_many(bytes_view& v, std::span<value_type> out);
+
     static vint_size_type serialized_size_from_first_byte(bytes::value_type first_byte);
 };
 
@@ -85,7 +85,7 @@ zstd_processor::zstd_processor(const opt_getter& opts)
     auto dctx_size = ZSTD_estimateDCtxSize();
     _dctx_raw = allocate_aligned_buffer<char>(dctx_size, 8);
     _dctx = ZSTD_initStaticDCtx(_dctx_raw.get(), dctx_size);
-    if (!_cctx) {
+    if (!_dctx) {
         throw std::runtime_error("Unable to initialize ZSTD decompression context");
     }
 }